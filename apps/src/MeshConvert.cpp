@@ -49,6 +49,7 @@ OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "GenericMeshReader.hpp"
 #include "DistributedTetrahedralMesh.hpp"
 #include "TrianglesMeshWriter.hpp"
+#include "MappedMeshWriter.hpp"
 #include "FileFinder.hpp"
 #include "FibreConverter.hpp"
 
@@ -62,7 +63,7 @@ int main(int argc, char *argv[])
     {
         if (argc<2)
         {
-            ExecutableSupport::PrintError("Usage: MeshConvert mesh_3d_file_base_name", true);
+            ExecutableSupport::PrintError("Usage: MeshConvert mesh_3d_file_base_name [--mapped]", true);
             exit_code = ExecutableSupport::EXIT_BAD_ARGUMENTS;
         }
         else
@@ -77,9 +78,6 @@ int main(int argc, char *argv[])
             ExecutableSupport::Print("Opening "+base+" mesh file(s).");
 
             std::auto_ptr<AbstractMeshReader<3,3> > p_mesh_reader = GenericMeshReader<3,3>(argv[1]);
-            //We have to make a mesh so that we can get the node connectivity list back
-            DistributedTetrahedralMesh<3,3> mesh;
-            mesh.ConstructFromMeshReader(*p_mesh_reader);
 
             //Find a dot
             std::string base_for_output=base;
@@ -89,11 +87,27 @@ int main(int argc, char *argv[])
                 //If dot found, then make the string smaller
                 base_for_output.resize(pos);
             }
-            base_for_output = base_for_output + "_bin";
-            TrianglesMeshWriter<3,3> mesh_writer("", base_for_output);
-            ExecutableSupport::Print("Writing  " + base_for_output + ".node etc. mesh file in " + mesh_writer.GetOutputDirectory());
-            mesh_writer.SetWriteFilesAsBinary();
-            mesh_writer.WriteFilesUsingMesh(mesh);
+
+            if (argc > 2 && std::string(argv[2]) == "--mapped")
+            {
+                //The mapped writer builds the node connectivity list itself, so no mesh is needed
+                base_for_output = base_for_output + "_mapped";
+                MappedMeshWriter<3,3> mesh_writer("", base_for_output);
+                ExecutableSupport::Print("Writing  " + base_for_output + ".cmesh mesh file in " + mesh_writer.GetOutputDirectory());
+                mesh_writer.WriteFilesUsingMeshReader(*p_mesh_reader);
+            }
+            else
+            {
+                //We have to make a mesh so that we can get the node connectivity list back
+                DistributedTetrahedralMesh<3,3> mesh;
+                mesh.ConstructFromMeshReader(*p_mesh_reader);
+
+                base_for_output = base_for_output + "_bin";
+                TrianglesMeshWriter<3,3> mesh_writer("", base_for_output);
+                ExecutableSupport::Print("Writing  " + base_for_output + ".node etc. mesh file in " + mesh_writer.GetOutputDirectory());
+                mesh_writer.SetWriteFilesAsBinary();
+                mesh_writer.WriteFilesUsingMesh(mesh);
+            }
             // Convert fibres if present
             FibreConverter fibre_converter;
             FileFinder mesh_file(argv[1], RelativeTo::AbsoluteOrCwd);
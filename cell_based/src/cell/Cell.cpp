@@ -35,8 +35,11 @@ OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include "Cell.hpp"
 
+#include <boost/make_shared.hpp>
+
 #include "ApoptoticCellProperty.hpp"
 #include "CellAncestor.hpp"
+#include "CellBasedObjectPool.hpp"
 #include "CellId.hpp"
 #include "CellLabel.hpp"
 #include "DefaultCellProliferativeType.hpp"
@@ -49,6 +52,8 @@ Cell::Cell(boost::shared_ptr<AbstractCellProperty> pMutationState,
            bool archiving,
            CellPropertyCollection cellPropertyCollection)
     : mCanDivide(false),
+      mLocationMapId(0),
+      mLocationMapSlot(UNSIGNED_UNSET),
       mCellPropertyCollection(cellPropertyCollection),
       mpCellCycleModel(pCellCycleModel),
       mpSrnModel(pSrnModel),
@@ -482,7 +487,8 @@ CellPtr Cell::Divide()
     daughter_property_collection.RemoveProperty(p_cell_data);
 
     // Create a new cell data object using the copy constructor and add this to the daughter cell
-    MAKE_PTR_ARGS(CellData, p_daughter_cell_data, (*p_cell_data));
+    boost::shared_ptr<CellData> p_daughter_cell_data =
+        boost::allocate_shared<CellData>(CellBasedPoolAllocator<CellData, CellBasedEventHandler::CELL_DATA_OBJECTS>(), *p_cell_data);
     daughter_property_collection.AddProperty(p_daughter_cell_data);
 
     // Copy all cell Vec data (note we create a new object not just copying the pointer)
@@ -493,12 +499,15 @@ CellPtr Cell::Divide()
         daughter_property_collection.RemoveProperty(p_cell_vec_data);
 
         // Create a new cell data object using the copy constructor and add this to the daughter cell
-        MAKE_PTR_ARGS(CellVecData, p_daughter_cell_vec_data, (*p_cell_vec_data));
+        boost::shared_ptr<CellVecData> p_daughter_cell_vec_data =
+            boost::allocate_shared<CellVecData>(CellBasedPoolAllocator<CellVecData, CellBasedEventHandler::CELL_DATA_OBJECTS>(), *p_cell_vec_data);
         daughter_property_collection.AddProperty(p_daughter_cell_vec_data);
     }
 
-    // Create daughter cell with modified cell property collection
-    CellPtr p_new_cell(new Cell(GetMutationState(), mpCellCycleModel->CreateCellCycleModel(), mpSrnModel->CreateSrnModel(), false, daughter_property_collection));
+    // Create daughter cell with modified cell property collection, pooling the cell and its reference count together
+    CellPtr p_new_cell = boost::allocate_shared<Cell>(CellBasedPoolAllocator<Cell, CellBasedEventHandler::CELL_OBJECTS>(),
+                                                      GetMutationState(), mpCellCycleModel->CreateCellCycleModel(),
+                                                      mpSrnModel->CreateSrnModel(), false, daughter_property_collection);
 
     // Initialise properties of daughter cell
     p_new_cell->GetCellCycleModel()->InitialiseDaughterCell();
@@ -54,6 +54,7 @@ OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 class AbstractCellCycleModel; // Circular definition (cells need to know about cycle models and vice-versa).
 class AbstractSrnModel; // Circular definition (cells need to know about subcellular reaction network models and vice-versa).
+class CellLocationIndexMap;
 class Cell;
 
 /** Cells shouldn't be copied - it doesn't make sense.  So all access is via this pointer type. */
@@ -93,6 +94,19 @@ private:
     /** Caches the result of ReadyToDivide() so Divide() can look at it. */
     bool mCanDivide;
 
+    /**
+     * The identifier of the CellLocationIndexMap that last attached this cell
+     * (0 if none). Together with mLocationMapSlot this forms the handle used by
+     * the map for O(1) lookup; it is not archived.
+     */
+    unsigned mLocationMapId;
+
+    /** The slot this cell occupied when last attached to a CellLocationIndexMap. */
+    unsigned mLocationMapSlot;
+
+    /** The location map maintains the handle above. */
+    friend class CellLocationIndexMap;
+
     /** Needed for serialization. */
     friend class boost::serialization::access;
     /**
@@ -0,0 +1,161 @@
+/*
+
+Copyright (c) 2005-2017, University of Oxford.
+All rights reserved.
+
+University of Oxford means the Chancellor, Masters and Scholars of the
+University of Oxford, having an administrative office at Wellington
+Square, Oxford OX1 2JD, UK.
+
+This file is part of Chaste.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+ * Redistributions of source code must retain the above copyright notice,
+   this list of conditions and the following disclaimer.
+ * Redistributions in binary form must reproduce the above copyright notice,
+   this list of conditions and the following disclaimer in the documentation
+   and/or other materials provided with the distribution.
+ * Neither the name of the University of Oxford nor the names of its
+   contributors may be used to endorse or promote products derived from this
+   software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+*/
+
+
+#include "CellBasedObjectPool.hpp"
+
+#include <cassert>
+
+CellBasedObjectPool* CellBasedObjectPool::mpInstances[4] = { NULL, NULL, NULL, NULL };
+
+CellBasedObjectPool* CellBasedObjectPool::Instance(unsigned objectType)
+{
+    assert(objectType < 4);
+    if (mpInstances[objectType] == NULL)
+    {
+        mpInstances[objectType] = new CellBasedObjectPool(objectType);
+    }
+    return mpInstances[objectType];
+}
+
+CellBasedObjectPool::CellBasedObjectPool(unsigned objectType)
+    : mObjectType(objectType)
+{
+}
+
+unsigned CellBasedObjectPool::GetSizeClass(std::size_t size)
+{
+    // Zero-sized requests still need a distinct address
+    return (size == 0) ? 1 : (size + GRANULARITY - 1)/GRANULARITY;
+}
+
+void* CellBasedObjectPool::Allocate(std::size_t size)
+{
+    if (size > MAX_POOLED_SIZE)
+    {
+        CellBasedEventHandler::CountAllocation(mObjectType, false);
+        return ::operator new(size);
+    }
+
+    unsigned size_class = GetSizeClass(size);
+    if (size_class >= mSizeClasses.size())
+    {
+        SizeClass empty_class = {NULL, NULL, NULL};
+        mSizeClasses.resize(size_class + 1, empty_class);
+    }
+    SizeClass& r_class = mSizeClasses[size_class];
+
+    // Reuse a freed object if there is one
+    if (r_class.mpFreeList != NULL)
+    {
+        void* p_object = r_class.mpFreeList;
+        r_class.mpFreeList = *static_cast<void**>(p_object);
+        CellBasedEventHandler::CountAllocation(mObjectType, true);
+        return p_object;
+    }
+
+    // Otherwise take the next object from the current block, starting a new block if necessary
+    std::size_t rounded_size = size_class*GRANULARITY;
+    if (r_class.mpBlockNext == r_class.mpBlockEnd)
+    {
+        r_class.mpBlockNext = static_cast<char*>(::operator new(rounded_size*OBJECTS_PER_BLOCK));
+        r_class.mpBlockEnd = r_class.mpBlockNext + rounded_size*OBJECTS_PER_BLOCK;
+        mBlockSizeClasses[r_class.mpBlockNext] = size_class;
+    }
+    void* p_object = r_class.mpBlockNext;
+    r_class.mpBlockNext += rounded_size;
+    CellBasedEventHandler::CountAllocation(mObjectType, false);
+    return p_object;
+}
+
+void CellBasedObjectPool::Deallocate(void* pObject, std::size_t size)
+{
+    if (pObject == NULL)
+    {
+        return;
+    }
+    CellBasedEventHandler::CountDeallocation(mObjectType);
+
+    if (size > MAX_POOLED_SIZE)
+    {
+        ::operator delete(pObject);
+        return;
+    }
+
+    // Putting foreign memory, or memory of another size, on a free list would corrupt the pool
+    assert(OwnsObject(pObject, size));
+    SizeClass& r_class = mSizeClasses[GetSizeClass(size)];
+
+    *static_cast<void**>(pObject) = r_class.mpFreeList;
+    r_class.mpFreeList = pObject;
+}
+
+bool CellBasedObjectPool::OwnsObject(const void* pObject, std::size_t size) const
+{
+    if (size > MAX_POOLED_SIZE || mBlockSizeClasses.empty())
+    {
+        return false;
+    }
+
+    // Find the last block starting at or before the object
+    const char* p_object = static_cast<const char*>(pObject);
+    std::map<const char*, unsigned>::const_iterator it = mBlockSizeClasses.upper_bound(p_object);
+    if (it == mBlockSizeClasses.begin())
+    {
+        return false;
+    }
+    --it;
+
+    unsigned size_class = GetSizeClass(size);
+    std::size_t rounded_size = size_class*GRANULARITY;
+    std::size_t offset = p_object - it->first;
+    return (it->second == size_class)
+           && (offset < rounded_size*OBJECTS_PER_BLOCK)
+           && (offset%rounded_size == 0);
+}
+
+unsigned CellBasedObjectPool::GetNumFreeObjects(std::size_t size) const
+{
+    unsigned size_class = GetSizeClass(size);
+    unsigned num_free = 0;
+    if (size_class < mSizeClasses.size())
+    {
+        for (void* p_object = mSizeClasses[size_class].mpFreeList; p_object != NULL; p_object = *static_cast<void**>(p_object))
+        {
+            num_free++;
+        }
+    }
+    return num_free;
+}
@@ -0,0 +1,301 @@
+/*
+
+Copyright (c) 2005-2017, University of Oxford.
+All rights reserved.
+
+University of Oxford means the Chancellor, Masters and Scholars of the
+University of Oxford, having an administrative office at Wellington
+Square, Oxford OX1 2JD, UK.
+
+This file is part of Chaste.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+ * Redistributions of source code must retain the above copyright notice,
+   this list of conditions and the following disclaimer.
+ * Redistributions in binary form must reproduce the above copyright notice,
+   this list of conditions and the following disclaimer in the documentation
+   and/or other materials provided with the distribution.
+ * Neither the name of the University of Oxford nor the names of its
+   contributors may be used to endorse or promote products derived from this
+   software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+*/
+
+
+#ifndef CELLBASEDOBJECTPOOL_HPP_
+#define CELLBASEDOBJECTPOOL_HPP_
+
+#include <cstddef>
+#include <map>
+#include <new>
+#include <vector>
+
+#include "CellBasedEventHandler.hpp"
+
+/**
+ * A free-list allocator for the objects that are created and destroyed every
+ * time a cell divides or dies: cells, cell-cycle models, SRN models and cell
+ * data. There is one pool for each CellBasedEventHandler::CellBasedObjectType.
+ *
+ * Requests are rounded up to a multiple of a fixed granularity, and each
+ * rounded size is served from its own free list. When a free list is empty,
+ * memory is carved out of blocks holding many objects of that size, so that
+ * objects of the same type end up close together in memory. Freed memory is
+ * kept on the free list for reuse and is never returned to the system.
+ * Requests larger than a fixed maximum are passed through to the global
+ * operator new.
+ *
+ * Memory may only be returned to the pool that allocated it, with the size it
+ * was allocated with; this is checked by an assertion in Deallocate().
+ *
+ * Every allocation and deallocation is recorded by CellBasedEventHandler.
+ *
+ * Cells are created and destroyed by the main thread only, so the pools are
+ * not thread-safe.
+ */
+class CellBasedObjectPool
+{
+public:
+
+    /**
+     * @return the pool for a given type of object.
+     *
+     * @param objectType the type of object (a CellBasedEventHandler::CellBasedObjectType)
+     */
+    static CellBasedObjectPool* Instance(unsigned objectType);
+
+    /**
+     * @return memory for an object.
+     *
+     * @param size the size of the object in bytes
+     */
+    void* Allocate(std::size_t size);
+
+    /**
+     * Return memory obtained from Allocate() on this pool to the pool.
+     *
+     * @param pObject the memory to return
+     * @param size the size of the object in bytes, as passed to Allocate()
+     */
+    void Deallocate(void* pObject, std::size_t size);
+
+    /**
+     * @return whether some memory lies at the start of an object of the given size
+     * in one of the blocks of this pool. Memory for requests larger than the pooled
+     * maximum comes from the global operator new and is not owned by the pool.
+     *
+     * @param pObject the memory
+     * @param size the size of the object in bytes
+     */
+    bool OwnsObject(const void* pObject, std::size_t size) const;
+
+    /**
+     * @return the number of objects of a given size waiting on the free list.
+     *
+     * @param size the size of the object in bytes
+     */
+    unsigned GetNumFreeObjects(std::size_t size) const;
+
+private:
+
+    /** The size granularity, which is also the alignment of pooled objects. */
+    static const std::size_t GRANULARITY = 16;
+
+    /** The largest object size served from the pool. */
+    static const std::size_t MAX_POOLED_SIZE = 2048;
+
+    /** The number of objects carved out of each block. */
+    static const unsigned OBJECTS_PER_BLOCK = 64;
+
+    /** The free list and the unused part of the current block for one object size. */
+    struct SizeClass
+    {
+        /** The first free object (each free object stores a pointer to the next). */
+        void* mpFreeList;
+
+        /** The next unused object in the current block. */
+        char* mpBlockNext;
+
+        /** The end of the current block. */
+        char* mpBlockEnd;
+    };
+
+    /**
+     * @return the index of the size class serving objects of a given size.
+     *
+     * @param size the size of the object in bytes
+     */
+    static unsigned GetSizeClass(std::size_t size);
+
+    /**
+     * Constructor.
+     *
+     * @param objectType the type of object served by this pool
+     */
+    CellBasedObjectPool(unsigned objectType);
+
+    /**
+     * Copy constructor.
+     */
+    CellBasedObjectPool(const CellBasedObjectPool&);
+
+    /**
+     * Overloaded assignment operator.
+     * @return reference by convention
+     */
+    CellBasedObjectPool& operator= (const CellBasedObjectPool&);
+
+    /** The type of object served by this pool. */
+    unsigned mObjectType;
+
+    /** The size classes, indexed by rounded size divided by GRANULARITY. */
+    std::vector<SizeClass> mSizeClasses;
+
+    /** The start of each block allocated by the pool, mapped to the size class it serves. */
+    std::map<const char*, unsigned> mBlockSizeClasses;
+
+    /**
+     * The pools, one for each type of object. They are never deleted, since
+     * objects may be freed during static destruction.
+     */
+    static CellBasedObjectPool* mpInstances[4];
+};
+
+/**
+ * A standard allocator drawing memory from a CellBasedObjectPool. It can be
+ * passed to boost::allocate_shared() so that both an object and its reference
+ * count are pooled.
+ */
+template<class T, unsigned OBJECT_TYPE>
+class CellBasedPoolAllocator
+{
+public:
+
+    /** Type of the allocated objects. */
+    typedef T value_type;
+    /** Pointer type. */
+    typedef T* pointer;
+    /** Const pointer type. */
+    typedef const T* const_pointer;
+    /** Reference type. */
+    typedef T& reference;
+    /** Const reference type. */
+    typedef const T& const_reference;
+    /** Size type. */
+    typedef std::size_t size_type;
+    /** Difference type. */
+    typedef std::ptrdiff_t difference_type;
+
+    /** The allocator for objects of another type, drawing from the same pool. */
+    template<class U>
+    struct rebind
+    {
+        /** The allocator type. */
+        typedef CellBasedPoolAllocator<U, OBJECT_TYPE> other;
+    };
+
+    /** Default constructor. */
+    CellBasedPoolAllocator()
+    {
+    }
+
+    /** Conversion from an allocator for another type. */
+    template<class U>
+    CellBasedPoolAllocator(const CellBasedPoolAllocator<U, OBJECT_TYPE>&)
+    {
+    }
+
+    /**
+     * @return the address of an object.
+     * @param rObject the object
+     */
+    pointer address(reference rObject) const
+    {
+        return &rObject;
+    }
+
+    /**
+     * @return the address of an object.
+     * @param rObject the object
+     */
+    const_pointer address(const_reference rObject) const
+    {
+        return &rObject;
+    }
+
+    /**
+     * @return memory for a number of objects.
+     * @param num the number of objects
+     */
+    pointer allocate(size_type num, const void* = 0)
+    {
+        return static_cast<pointer>(CellBasedObjectPool::Instance(OBJECT_TYPE)->Allocate(num*sizeof(T)));
+    }
+
+    /**
+     * Return memory for a number of objects to the pool.
+     * @param pObjects the memory
+     * @param num the number of objects
+     */
+    void deallocate(pointer pObjects, size_type num)
+    {
+        CellBasedObjectPool::Instance(OBJECT_TYPE)->Deallocate(pObjects, num*sizeof(T));
+    }
+
+    /**
+     * Copy-construct an object in allocated memory.
+     * @param pObject the memory
+     * @param rValue the object to copy
+     */
+    void construct(pointer pObject, const_reference rValue)
+    {
+        ::new(static_cast<void*>(pObject)) T(rValue);
+    }
+
+    /**
+     * Destroy an object without freeing its memory.
+     * @param pObject the object
+     */
+    void destroy(pointer pObject)
+    {
+        pObject->~T();
+    }
+
+    /** @return the largest number of objects that can be requested. */
+    size_type max_size() const
+    {
+        return size_type(-1)/sizeof(T);
+    }
+};
+
+/**
+ * @return true, as all allocators of a given object type share a pool.
+ */
+template<class T, class U, unsigned OBJECT_TYPE>
+inline bool operator==(const CellBasedPoolAllocator<T, OBJECT_TYPE>&, const CellBasedPoolAllocator<U, OBJECT_TYPE>&)
+{
+    return true;
+}
+
+/**
+ * @return false, as all allocators of a given object type share a pool.
+ */
+template<class T, class U, unsigned OBJECT_TYPE>
+inline bool operator!=(const CellBasedPoolAllocator<T, OBJECT_TYPE>&, const CellBasedPoolAllocator<U, OBJECT_TYPE>&)
+{
+    return false;
+}
+
+#endif /* CELLBASEDOBJECTPOOL_HPP_ */
@@ -46,6 +46,16 @@ AbstractCellCycleModel::~AbstractCellCycleModel()
 {
 }
 
+void* AbstractCellCycleModel::operator new(std::size_t size)
+{
+    return CellBasedObjectPool::Instance(CellBasedEventHandler::CELL_CYCLE_MODEL_OBJECTS)->Allocate(size);
+}
+
+void AbstractCellCycleModel::operator delete(void* pModel, std::size_t size)
+{
+    CellBasedObjectPool::Instance(CellBasedEventHandler::CELL_CYCLE_MODEL_OBJECTS)->Deallocate(pModel, size);
+}
+
 AbstractCellCycleModel::AbstractCellCycleModel(const AbstractCellCycleModel& rModel)
     : mBirthTime(rModel.mBirthTime),
       mReadyToDivide(rModel.mReadyToDivide),
@@ -48,6 +48,7 @@ OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "CellCyclePhases.hpp"
 #include "SimulationTime.hpp"
 #include "Cell.hpp"
+#include "CellBasedObjectPool.hpp"
 
 class Cell; // Circular definition (cells need to know about cycle models and vice-versa)
 typedef boost::shared_ptr<Cell> CellPtr;
@@ -144,6 +145,23 @@ public:
      */
     virtual ~AbstractCellCycleModel();
 
+    /**
+     * Allocate memory for a cell-cycle model from a CellBasedObjectPool, so that the
+     * models of dividing cells reuse the memory of those of dead cells.
+     *
+     * @param size the size of the (concrete) model in bytes
+     * @return the memory
+     */
+    static void* operator new(std::size_t size);
+
+    /**
+     * Return the memory of a cell-cycle model to its CellBasedObjectPool.
+     *
+     * @param pModel the memory
+     * @param size the size of the (concrete) model in bytes
+     */
+    static void operator delete(void* pModel, std::size_t size);
+
     /**
      * Gives the cell-cycle model a pointer to its host cell.
      *
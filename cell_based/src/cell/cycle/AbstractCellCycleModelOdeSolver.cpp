@@ -109,6 +109,11 @@ void AbstractCellCycleModelOdeSolver::SetTolerances(double relTol, double absTol
 #endif //CHASTE_CVODE
 }
 
+const boost::shared_ptr<AbstractIvpOdeSolver> AbstractCellCycleModelOdeSolver::GetIvpOdeSolver() const
+{
+    return mpOdeSolver;
+}
+
 bool AbstractCellCycleModelOdeSolver::IsAdaptive()
 {
     bool adaptive = false;
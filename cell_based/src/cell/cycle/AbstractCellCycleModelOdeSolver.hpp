@@ -186,6 +186,11 @@ public:
      * The base class version just returns true iff the solver is the CvodeAdaptor class.
      */
     virtual bool IsAdaptive();
+
+    /**
+     * @return the underlying ODE solver.
+     */
+    const boost::shared_ptr<AbstractIvpOdeSolver> GetIvpOdeSolver() const;
 };
 
 #endif /*ABSTRACTCELLCYCLEMODELODESOLVER_HPP_*/
@@ -35,6 +35,12 @@ OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include "CellCycleModelOdeHandler.hpp"
 
+#include <typeinfo>
+
+#include "AbstractBatchableOdeSystem.hpp"
+#include "EulerIvpOdeSolver.hpp"
+#include "RungeKutta4IvpOdeSolver.hpp"
+
 CellCycleModelOdeHandler::CellCycleModelOdeHandler(double lastTime,
                                                    boost::shared_ptr<AbstractCellCycleModelOdeSolver> pOdeSolver)
     : mDt(DOUBLE_UNSET),
@@ -129,6 +135,11 @@ void CellCycleModelOdeHandler::SetLastTime(double lastTime)
     mLastTime = lastTime;
 }
 
+double CellCycleModelOdeHandler::GetLastTime() const
+{
+    return mLastTime;
+}
+
 void CellCycleModelOdeHandler::SetStateVariables(const std::vector<double>& rStateVariables)
 {
     assert(mpOdeSystem);
@@ -148,3 +159,76 @@ void CellCycleModelOdeHandler::SetProteinConcentrationsForTestsOnly(double lastT
     mLastTime = lastTime;
     mpOdeSystem->SetStateVariables(proteinConcentrations);
 }
+
+bool CellCycleModelOdeHandler::CanSolveOdesInBatch() const
+{
+    if (mFinishedRunningOdes || !mpOdeSolver || !dynamic_cast<AbstractBatchableOdeSystem*>(mpOdeSystem))
+    {
+        return false;
+    }
+
+    // Only fixed-step explicit solvers without stopping events can be reproduced exactly
+    AbstractIvpOdeSolver* p_solver = mpOdeSolver->GetIvpOdeSolver().get();
+    return (p_solver != NULL)
+           && (typeid(*p_solver) == typeid(RungeKutta4IvpOdeSolver) || typeid(*p_solver) == typeid(EulerIvpOdeSolver));
+}
+
+void CellCycleModelOdeHandler::SolveOdesToTimeInBatch(const std::vector<CellCycleModelOdeHandler*>& rHandlers,
+                                                      double currentTime,
+                                                      BatchedCellOdeSolver& rSolver)
+{
+    // Group the handlers that need solving into batches that can be advanced together
+    std::vector<std::vector<CellCycleModelOdeHandler*> > batches;
+    for (unsigned i=0; i<rHandlers.size(); i++)
+    {
+        CellCycleModelOdeHandler* p_handler = rHandlers[i];
+        assert(p_handler->CanSolveOdesInBatch());
+
+        if (p_handler->mLastTime < currentTime)
+        {
+            p_handler->AdjustOdeParameters(currentTime);
+
+            const AbstractIvpOdeSolver& r_solver = *(p_handler->mpOdeSolver->GetIvpOdeSolver());
+            double dt = p_handler->GetDt();
+
+            unsigned batch_index = 0;
+            for ( ; batch_index<batches.size(); batch_index++)
+            {
+                CellCycleModelOdeHandler* p_first = batches[batch_index][0];
+                if (typeid(*(p_first->mpOdeSystem)) == typeid(*(p_handler->mpOdeSystem))
+                    && typeid(*(p_first->mpOdeSolver->GetIvpOdeSolver())) == typeid(r_solver)
+                    && p_first->mLastTime == p_handler->mLastTime
+                    && p_first->GetDt() == dt)
+                {
+                    break;
+                }
+            }
+            if (batch_index == batches.size())
+            {
+                batches.push_back(std::vector<CellCycleModelOdeHandler*>());
+            }
+            batches[batch_index].push_back(p_handler);
+        }
+    }
+
+    std::vector<AbstractOdeSystem*> systems;
+    for (unsigned batch_index=0; batch_index<batches.size(); batch_index++)
+    {
+        const std::vector<CellCycleModelOdeHandler*>& r_batch = batches[batch_index];
+        CellCycleModelOdeHandler* p_first = r_batch[0];
+
+        systems.clear();
+        for (unsigned i=0; i<r_batch.size(); i++)
+        {
+            systems.push_back(r_batch[i]->mpOdeSystem);
+        }
+
+        bool use_runge_kutta_4 = (typeid(*(p_first->mpOdeSolver->GetIvpOdeSolver())) == typeid(RungeKutta4IvpOdeSolver));
+        rSolver.Solve(systems, use_runge_kutta_4, p_first->mLastTime, currentTime, p_first->GetDt());
+
+        for (unsigned i=0; i<r_batch.size(); i++)
+        {
+            r_batch[i]->mLastTime = currentTime;
+        }
+    }
+}
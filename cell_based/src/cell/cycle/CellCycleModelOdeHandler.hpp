@@ -42,6 +42,7 @@ OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "ChasteSerialization.hpp"
 #include "AbstractOdeSystem.hpp"
 #include "AbstractCellCycleModelOdeSolver.hpp"
+#include "BatchedCellOdeSolver.hpp"
 #include "SimulationTime.hpp"
 
 /**
@@ -167,6 +168,11 @@ public:
      */
     void SetLastTime(double lastTime);
 
+    /**
+     * @return #mLastTime.
+     */
+    double GetLastTime() const;
+
     /**
      * @return #mDt.  This sets it to a default value if it hasn't
      * been set by calling SetDt.
@@ -203,6 +209,31 @@ public:
      *
      */
     void SetProteinConcentrationsForTestsOnly(double lastTime, std::vector<double> proteinConcentrations);
+
+    /**
+     * @return whether this handler's ODEs may be solved together with those of
+     * other handlers by SolveOdesToTimeInBatch(). This requires that the ODE system
+     * inherits from AbstractBatchableOdeSystem, that the ODE solver is exactly a
+     * RungeKutta4IvpOdeSolver or EulerIvpOdeSolver, and that the model has not
+     * finished running its ODEs.
+     */
+    bool CanSolveOdesInBatch() const;
+
+    /**
+     * Solve the ODE systems of several handlers to a given time, as SolveOdeToTime()
+     * would for each one separately.
+     *
+     * Handlers whose ODE systems are of the same type, and which use the same solver,
+     * time step and last time, are gathered and solved together by rSolver.
+     * AdjustOdeParameters() is called on each handler before solving.
+     *
+     * @param rHandlers the handlers, for each of which CanSolveOdesInBatch() must be true
+     * @param currentTime the current time
+     * @param rSolver the batched solver to use
+     */
+    static void SolveOdesToTimeInBatch(const std::vector<CellCycleModelOdeHandler*>& rHandlers,
+                                       double currentTime,
+                                       BatchedCellOdeSolver& rSolver);
 };
 
 #endif /*CELLCYCLEMODELODEHANDLER_HPP_*/
@@ -33,47 +33,55 @@ OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 */
 
+#include <algorithm>
+
 #include "CellData.hpp"
 
+CellData::CellData()
+    : AbstractCellProperty(),
+      mNumItems(0)
+{
+}
+
 CellData::~CellData()
 {
 }
 
 void CellData::SetItem(const std::string& rVariableName, double data)
 {
-    mCellData[rVariableName] = data;
+    SetItem(CellDataItemRegistry::Instance()->GetSlot(rVariableName), data);
 }
 
 double CellData::GetItem(const std::string& rVariableName) const
 {
-    /*
-     * Note that mCellData[rVariableName] is not const. If rVariableName is not
-     * a key, then mCellData[rVariableName] will create a new item in the map
-     * and increase the size by one.  Using a const_iterator ensures that the
-     * map remains const.
-     */
-    std::map<std::string, double>::const_iterator it = mCellData.find(rVariableName);
-    if (it == mCellData.end())
+    // Look the name up without registering it, so that queries for absent items leave the registry unchanged
+    unsigned slot = CellDataItemRegistry::Instance()->FindSlot(rVariableName);
+    if (slot >= mValues.size() || !mIsStored[slot])
     {
         EXCEPTION("The item " << rVariableName << " is not stored");
     }
-    return(it->second);
+    return mValues[slot];
 }
 
 unsigned CellData::GetNumItems() const
 {
-    return mCellData.size();
+    return mNumItems;
 }
 
 std::vector<std::string> CellData::GetKeys() const
 {
     std::vector<std::string> keys;
-    for (std::map<std::string, double>::const_iterator it = mCellData.begin(); it != mCellData.end(); ++it)
+    CellDataItemRegistry* p_registry = CellDataItemRegistry::Instance();
+    for (unsigned slot=0; slot<mValues.size(); slot++)
     {
-        keys.push_back(it->first);
+        if (mIsStored[slot])
+        {
+            keys.push_back(p_registry->rGetName(slot));
+        }
     }
 
-    // From STL documentation we assume that the iterator is returning sorted keys sort(keys.begin(), keys.end());
+    // Slots are assigned in order of registration, so sort to return keys in alphabetical order
+    std::sort(keys.begin(), keys.end());
     return keys;
 }
 
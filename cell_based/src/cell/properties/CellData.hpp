@@ -45,6 +45,8 @@ OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "ChasteSerialization.hpp"
 #include <boost/serialization/base_object.hpp>
 #include <boost/serialization/map.hpp>
+#include <boost/serialization/split_member.hpp>
+#include "CellDataItemRegistry.hpp"
 #include "Exception.hpp"
 
 /**
@@ -56,33 +58,88 @@ OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
  *
  * Within the Cell constructor, an empty CellData object is created and passed to the Cell
  * (unless there is already a CellData object present in mCellPropertyCollection).
+ *
+ * Items are stored in a flat array indexed by the slots handed out by the
+ * CellDataItemRegistry. Code that accesses the same item for every cell on every
+ * time step should look up the slot once and use the slot-based overloads of
+ * GetItem() and SetItem(); the string-based methods are thin wrappers around these.
  */
 class CellData : public AbstractCellProperty
 {
 private:
 
     /**
-     * The cell data.
+     * The cell data, indexed by the slots assigned by CellDataItemRegistry.
+     */
+    std::vector<double> mValues;
+
+    /**
+     * Whether each slot in mValues holds an item stored in this object.
      */
-    std::map<std::string, double> mCellData;
+    std::vector<bool> mIsStored;
+
+    /**
+     * The number of items stored.
+     */
+    unsigned mNumItems;
 
     /** Needed for serialization. */
     friend class boost::serialization::access;
     /**
-     * Archive the member variables.
+     * Save the member variables. Items are archived as a map from name to value,
+     * so that archives do not depend on the order in which slots were registered.
+     *
+     * @param archive the archive
+     * @param version the current version of this class
+     */
+    template<class Archive>
+    void save(Archive & archive, const unsigned int version) const
+    {
+        archive & boost::serialization::base_object<AbstractCellProperty>(*this);
+
+        std::map<std::string, double> cell_data;
+        CellDataItemRegistry* p_registry = CellDataItemRegistry::Instance();
+        for (unsigned slot=0; slot<mValues.size(); slot++)
+        {
+            if (mIsStored[slot])
+            {
+                cell_data[p_registry->rGetName(slot)] = mValues[slot];
+            }
+        }
+        archive & cell_data;
+    }
+
+    /**
+     * Load the member variables.
      *
      * @param archive the archive
      * @param version the current version of this class
      */
     template<class Archive>
-    void serialize(Archive & archive, const unsigned int version)
+    void load(Archive & archive, const unsigned int version)
     {
         archive & boost::serialization::base_object<AbstractCellProperty>(*this);
-        archive & mCellData;
+
+        std::map<std::string, double> cell_data;
+        archive & cell_data;
+
+        mValues.clear();
+        mIsStored.clear();
+        mNumItems = 0;
+        for (std::map<std::string, double>::const_iterator it = cell_data.begin(); it != cell_data.end(); ++it)
+        {
+            SetItem(it->first, it->second);
+        }
     }
+    BOOST_SERIALIZATION_SPLIT_MEMBER()
 
 public:
 
+    /**
+     * Default constructor.
+     */
+    CellData();
+
     /**
      * We need the empty virtual destructor in this class to ensure Boost
      * serialization works correctly with static libraries.
@@ -105,6 +162,22 @@ public:
      */
     double GetItem(const std::string& rVariableName) const;
 
+    /**
+     * This assigns the cell data.
+     *
+     * @param slot the slot of the data to be set, as given by CellDataItemRegistry::GetSlot().
+     * @param data the value to set it to.
+     */
+    inline void SetItem(unsigned slot, double data);
+
+    /**
+     * @return data.
+     *
+     * @param slot the slot of the data required, as given by CellDataItemRegistry::GetSlot().
+     * throws if nothing has been stored in this slot
+     */
+    inline double GetItem(unsigned slot) const;
+
     /**
      * @return number of data items
      */
@@ -118,6 +191,30 @@ public:
     std::vector<std::string> GetKeys() const;
 };
 
+void CellData::SetItem(unsigned slot, double data)
+{
+    if (slot >= mValues.size())
+    {
+        mValues.resize(slot+1, 0.0);
+        mIsStored.resize(slot+1, false);
+    }
+    if (!mIsStored[slot])
+    {
+        mIsStored[slot] = true;
+        mNumItems++;
+    }
+    mValues[slot] = data;
+}
+
+double CellData::GetItem(unsigned slot) const
+{
+    if (slot >= mValues.size() || !mIsStored[slot])
+    {
+        EXCEPTION("The item " << CellDataItemRegistry::Instance()->rGetName(slot) << " is not stored");
+    }
+    return mValues[slot];
+}
+
 #include "SerializationExportWrapper.hpp"
 // Declare identifier for the serializer
 CHASTE_CLASS_EXPORT(CellData)
@@ -0,0 +1,124 @@
+/*
+
+Copyright (c) 2005-2017, University of Oxford.
+All rights reserved.
+
+University of Oxford means the Chancellor, Masters and Scholars of the
+University of Oxford, having an administrative office at Wellington
+Square, Oxford OX1 2JD, UK.
+
+This file is part of Chaste.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+ * Redistributions of source code must retain the above copyright notice,
+   this list of conditions and the following disclaimer.
+ * Redistributions in binary form must reproduce the above copyright notice,
+   this list of conditions and the following disclaimer in the documentation
+   and/or other materials provided with the distribution.
+ * Neither the name of the University of Oxford nor the names of its
+   contributors may be used to endorse or promote products derived from this
+   software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+*/
+
+#ifndef CELLDATAITEMREGISTRY_HPP_
+#define CELLDATAITEMREGISTRY_HPP_
+
+#include <map>
+#include <string>
+#include <vector>
+
+/**
+ * A singleton registry interning the names of items stored in CellData.
+ *
+ * Each distinct item name is assigned a small integer slot the first time it
+ * is seen. Classes that read or write cell data every time step (forces,
+ * modifiers, populations) should look up the slot once, at setup, and then
+ * use the slot-based CellData::GetItem() and CellData::SetItem() overloads,
+ * which avoid a string comparison per cell per access.
+ *
+ * Slots are never removed or reassigned during the lifetime of the process,
+ * so a cached slot remains valid for as long as the program runs. Since
+ * CellData archives its items by name, the registry itself is not archived.
+ */
+class CellDataItemRegistry
+{
+public:
+
+    /**
+     * @return the single instance of the registry.
+     */
+    static CellDataItemRegistry* Instance();
+
+    /**
+     * @return the slot associated with a given item name, registering the
+     * name if it has not been seen before.
+     *
+     * @param rItemName the name of the cell data item
+     */
+    unsigned GetSlot(const std::string& rItemName);
+
+    /**
+     * @return the slot associated with a given item name, or UNSIGNED_UNSET if
+     * the name has not been registered. Unlike GetSlot(), this never registers
+     * the name.
+     *
+     * @param rItemName the name of the cell data item
+     */
+    unsigned FindSlot(const std::string& rItemName) const;
+
+    /**
+     * @return the name of the cell data item associated with a given slot.
+     *
+     * @param slot the slot of the cell data item
+     */
+    const std::string& rGetName(unsigned slot) const;
+
+    /**
+     * @return the number of slots registered so far.
+     */
+    unsigned GetNumSlots() const;
+
+private:
+
+    /**
+     * Default constructor.
+     */
+    CellDataItemRegistry();
+
+    /**
+     * Copy constructor.
+     */
+    CellDataItemRegistry(const CellDataItemRegistry&);
+
+    /**
+     * Overloaded assignment operator.
+     * @return reference by convention
+     */
+    CellDataItemRegistry& operator= (const CellDataItemRegistry&);
+
+    /**
+     * A pointer to the singleton instance of this class.
+     */
+    static CellDataItemRegistry* mpInstance;
+
+    /** Map from item name to slot. */
+    std::map<std::string, unsigned> mSlots;
+
+    /** The item names, indexed by slot. */
+    std::vector<std::string> mNames;
+};
+
+#endif /* CELLDATAITEMREGISTRY_HPP_ */
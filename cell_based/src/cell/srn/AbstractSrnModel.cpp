@@ -44,6 +44,16 @@ AbstractSrnModel::~AbstractSrnModel()
 {
 }
 
+void* AbstractSrnModel::operator new(std::size_t size)
+{
+    return CellBasedObjectPool::Instance(CellBasedEventHandler::SRN_MODEL_OBJECTS)->Allocate(size);
+}
+
+void AbstractSrnModel::operator delete(void* pModel, std::size_t size)
+{
+    CellBasedObjectPool::Instance(CellBasedEventHandler::SRN_MODEL_OBJECTS)->Deallocate(pModel, size);
+}
+
 void AbstractSrnModel::Initialise()
 {
 }
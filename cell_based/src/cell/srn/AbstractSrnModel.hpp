@@ -47,6 +47,7 @@ OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "OutputFileHandler.hpp"
 #include "SimulationTime.hpp"
 #include "Cell.hpp"
+#include "CellBasedObjectPool.hpp"
 
 class Cell; // Circular definition (cells need to know about SRN models and vice-versa)
 typedef boost::shared_ptr<Cell> CellPtr;
@@ -132,6 +133,23 @@ public:
      */
     virtual ~AbstractSrnModel();
 
+    /**
+     * Allocate memory for a SRN model from a CellBasedObjectPool, so that the
+     * models of dividing cells reuse the memory of those of dead cells.
+     *
+     * @param size the size of the (concrete) model in bytes
+     * @return the memory
+     */
+    static void* operator new(std::size_t size);
+
+    /**
+     * Return the memory of a SRN model to its CellBasedObjectPool.
+     *
+     * @param pModel the memory
+     * @param size the size of the (concrete) model in bytes
+     */
+    static void operator delete(void* pModel, std::size_t size);
+
     /**
      * Gives the SRN model a pointer to its host cell.
      *
@@ -89,6 +89,11 @@ void DeltaNotchSrnModel::SimulateToCurrentTime()
     AbstractOdeSrnModel::SimulateToCurrentTime();
 }
 
+void DeltaNotchSrnModel::AdjustOdeParameters(double currentTime)
+{
+    UpdateDeltaNotch();
+}
+
 void DeltaNotchSrnModel::Initialise()
 {
     AbstractOdeSrnModel::Initialise(new DeltaNotchOdeSystem);
@@ -80,6 +80,16 @@ protected:
      */
     DeltaNotchSrnModel(const DeltaNotchSrnModel& rModel);
 
+    /**
+     * Overridden AdjustOdeParameters() method.
+     *
+     * Calls UpdateDeltaNotch(), so that the mean neighbouring Delta is also
+     * up to date when the ODEs are solved in a batch with those of other cells.
+     *
+     * @param currentTime  the time up to which the system will be solved.
+     */
+    void AdjustOdeParameters(double currentTime);
+
 public:
 
     /**
@@ -0,0 +1,81 @@
+/*
+
+Copyright (c) 2005-2017, University of Oxford.
+All rights reserved.
+
+University of Oxford means the Chancellor, Masters and Scholars of the
+University of Oxford, having an administrative office at Wellington
+Square, Oxford OX1 2JD, UK.
+
+This file is part of Chaste.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+ * Redistributions of source code must retain the above copyright notice,
+   this list of conditions and the following disclaimer.
+ * Redistributions in binary form must reproduce the above copyright notice,
+   this list of conditions and the following disclaimer in the documentation
+   and/or other materials provided with the distribution.
+ * Neither the name of the University of Oxford nor the names of its
+   contributors may be used to endorse or promote products derived from this
+   software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+*/
+
+
+#ifndef ABSTRACTBATCHABLEODESYSTEM_HPP_
+#define ABSTRACTBATCHABLEODESYSTEM_HPP_
+
+/**
+ * An interface for ODE systems whose right-hand side can be evaluated for many
+ * instances of the same system at once, as used by BatchedCellOdeSolver to
+ * integrate the ODEs of a whole cell population in a single pass.
+ *
+ * The state variables and parameters of the instances are passed in
+ * structure-of-arrays layout: state variable i of instance s is stored at
+ * pY[i*numSystems + s], and parameter j of instance s at
+ * pParameters[j*numSystems + s].
+ *
+ * Since instances are advanced together with a fixed time step, systems
+ * implementing this interface must not define stopping events.
+ */
+class AbstractBatchableOdeSystem
+{
+public:
+
+    /**
+     * Virtual destructor.
+     */
+    virtual ~AbstractBatchableOdeSystem()
+    {
+    }
+
+    /**
+     * Compute the RHS of the ODE system for numSystems instances at once.
+     *
+     * @param time the time at which to evaluate the RHS
+     * @param numSystems the number of instances
+     * @param pY the state variables of the instances, in structure-of-arrays layout
+     * @param pParameters the parameters of the instances, in structure-of-arrays
+     *     layout (NULL if the system has no parameters)
+     * @param pDY filled in with the derivatives of the instances, in structure-of-arrays layout
+     */
+    virtual void EvaluateYDerivativesBatch(double time,
+                                           unsigned numSystems,
+                                           const double* pY,
+                                           const double* pParameters,
+                                           double* pDY) const=0;
+};
+
+#endif /*ABSTRACTBATCHABLEODESYSTEM_HPP_*/
@@ -0,0 +1,170 @@
+/*
+
+Copyright (c) 2005-2017, University of Oxford.
+All rights reserved.
+
+University of Oxford means the Chancellor, Masters and Scholars of the
+University of Oxford, having an administrative office at Wellington
+Square, Oxford OX1 2JD, UK.
+
+This file is part of Chaste.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+ * Redistributions of source code must retain the above copyright notice,
+   this list of conditions and the following disclaimer.
+ * Redistributions in binary form must reproduce the above copyright notice,
+   this list of conditions and the following disclaimer in the documentation
+   and/or other materials provided with the distribution.
+ * Neither the name of the University of Oxford nor the names of its
+   contributors may be used to endorse or promote products derived from this
+   software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+*/
+
+
+#include "BatchedCellOdeSolver.hpp"
+
+#include <cassert>
+#include <typeinfo>
+
+#include "TimeStepper.hpp"
+#include "Exception.hpp"
+
+void BatchedCellOdeSolver::TakeEulerStep(const AbstractBatchableOdeSystem& rSystem, unsigned numSystems, double time, double timeStep)
+{
+    const unsigned size = mY.size();
+    const double* p_parameters = mParameters.empty() ? NULL : &mParameters[0];
+
+    rSystem.EvaluateYDerivativesBatch(time, numSystems, &mY[0], p_parameters, &mDY[0]);
+    for (unsigned i=0; i<size; i++)
+    {
+        mY[i] += timeStep*mDY[i];
+    }
+}
+
+void BatchedCellOdeSolver::TakeRungeKutta4Step(const AbstractBatchableOdeSystem& rSystem, unsigned numSystems, double time, double timeStep)
+{
+    // The arithmetic here mirrors RungeKutta4IvpOdeSolver::CalculateNextYValue() exactly
+    const unsigned size = mY.size();
+    const double* p_parameters = mParameters.empty() ? NULL : &mParameters[0];
+
+    rSystem.EvaluateYDerivativesBatch(time, numSystems, &mY[0], p_parameters, &mDY[0]);
+    for (unsigned i=0; i<size; i++)
+    {
+        mK1[i] = timeStep*mDY[i];
+        mYki[i] = mY[i] + 0.5*mK1[i];
+    }
+
+    rSystem.EvaluateYDerivativesBatch(time+0.5*timeStep, numSystems, &mYki[0], p_parameters, &mDY[0]);
+    for (unsigned i=0; i<size; i++)
+    {
+        mK2[i] = timeStep*mDY[i];
+        mYki[i] = mY[i] + 0.5*mK2[i];
+    }
+
+    rSystem.EvaluateYDerivativesBatch(time+0.5*timeStep, numSystems, &mYki[0], p_parameters, &mDY[0]);
+    for (unsigned i=0; i<size; i++)
+    {
+        mK3[i] = timeStep*mDY[i];
+        mYki[i] = mY[i] + mK3[i];
+    }
+
+    rSystem.EvaluateYDerivativesBatch(time+timeStep, numSystems, &mYki[0], p_parameters, &mDY[0]);
+    for (unsigned i=0; i<size; i++)
+    {
+        double k4 = timeStep*mDY[i];
+        mY[i] = mY[i] + (mK1[i]+2*mK2[i]+2*mK3[i]+k4)/6.0;
+    }
+}
+
+void BatchedCellOdeSolver::Solve(const std::vector<AbstractOdeSystem*>& rSystems,
+                                 bool useRungeKutta4,
+                                 double startTime,
+                                 double endTime,
+                                 double timeStep)
+{
+    assert(endTime > startTime);
+    assert(timeStep > 0.0);
+
+    if (rSystems.empty())
+    {
+        return;
+    }
+
+    const AbstractBatchableOdeSystem* p_batchable = dynamic_cast<AbstractBatchableOdeSystem*>(rSystems[0]);
+    if (p_batchable == NULL)
+    {
+        EXCEPTION("The ODE system does not support batched evaluation.");
+    }
+
+    const unsigned num_systems = rSystems.size();
+    const unsigned num_variables = rSystems[0]->GetNumberOfStateVariables();
+    const unsigned num_parameters = rSystems[0]->GetNumberOfParameters();
+
+    mY.resize(num_variables*num_systems);
+    mDY.resize(num_variables*num_systems);
+    mParameters.resize(num_parameters*num_systems);
+    if (useRungeKutta4)
+    {
+        mK1.resize(num_variables*num_systems);
+        mK2.resize(num_variables*num_systems);
+        mK3.resize(num_variables*num_systems);
+        mYki.resize(num_variables*num_systems);
+    }
+
+    // Gather the state variables and parameters of each system
+    for (unsigned s=0; s<num_systems; s++)
+    {
+        assert(typeid(*(rSystems[s])) == typeid(*(rSystems[0])));
+        const std::vector<double>& r_y = rSystems[s]->rGetStateVariables();
+        if (r_y.size() != num_variables)
+        {
+            EXCEPTION("The state variable vector in the ODE system is not set up");
+        }
+        for (unsigned i=0; i<num_variables; i++)
+        {
+            mY[i*num_systems + s] = r_y[i];
+        }
+        for (unsigned j=0; j<num_parameters; j++)
+        {
+            mParameters[j*num_systems + s] = rSystems[s]->GetParameter(j);
+        }
+    }
+
+    // Advance all systems together, with the same steps AbstractOneStepIvpOdeSolver would take
+    TimeStepper stepper(startTime, endTime, timeStep);
+    while (!stepper.IsTimeAtEnd())
+    {
+        if (useRungeKutta4)
+        {
+            TakeRungeKutta4Step(*p_batchable, num_systems, stepper.GetTime(), stepper.GetNextTimeStep());
+        }
+        else
+        {
+            TakeEulerStep(*p_batchable, num_systems, stepper.GetTime(), stepper.GetNextTimeStep());
+        }
+        stepper.AdvanceOneTimeStep();
+    }
+
+    // Scatter the results back
+    for (unsigned s=0; s<num_systems; s++)
+    {
+        std::vector<double>& r_y = rSystems[s]->rGetStateVariables();
+        for (unsigned i=0; i<num_variables; i++)
+        {
+            r_y[i] = mY[i*num_systems + s];
+        }
+    }
+}
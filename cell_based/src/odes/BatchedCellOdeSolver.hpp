@@ -0,0 +1,127 @@
+/*
+
+Copyright (c) 2005-2017, University of Oxford.
+All rights reserved.
+
+University of Oxford means the Chancellor, Masters and Scholars of the
+University of Oxford, having an administrative office at Wellington
+Square, Oxford OX1 2JD, UK.
+
+This file is part of Chaste.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+ * Redistributions of source code must retain the above copyright notice,
+   this list of conditions and the following disclaimer.
+ * Redistributions in binary form must reproduce the above copyright notice,
+   this list of conditions and the following disclaimer in the documentation
+   and/or other materials provided with the distribution.
+ * Neither the name of the University of Oxford nor the names of its
+   contributors may be used to endorse or promote products derived from this
+   software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+*/
+
+
+#ifndef BATCHEDCELLODESOLVER_HPP_
+#define BATCHEDCELLODESOLVER_HPP_
+
+#include <vector>
+
+#include "AbstractOdeSystem.hpp"
+#include "AbstractBatchableOdeSystem.hpp"
+
+/**
+ * Solves many instances of the same ODE system, such as the SRN ODEs of every
+ * cell in a population, together using a fixed-step explicit method.
+ *
+ * The state variables and parameters of all instances are gathered into
+ * contiguous blocks in structure-of-arrays layout (see AbstractBatchableOdeSystem),
+ * advanced with forward Euler or classical fourth-order Runge-Kutta, and then
+ * scattered back into the individual ODE systems. The arithmetic performed for
+ * each instance is exactly that of EulerIvpOdeSolver or RungeKutta4IvpOdeSolver,
+ * so the results are identical to solving each system separately.
+ *
+ * Working memory is kept between calls, so a single solver object should be
+ * reused from one time step to the next.
+ */
+class BatchedCellOdeSolver
+{
+private:
+
+    /** The state variables of all instances. */
+    std::vector<double> mY;
+
+    /** The parameters of all instances. */
+    std::vector<double> mParameters;
+
+    /** The derivatives of all instances. */
+    std::vector<double> mDY;
+
+    /** Working memory for the first Runge-Kutta stage. */
+    std::vector<double> mK1;
+
+    /** Working memory for the second Runge-Kutta stage. */
+    std::vector<double> mK2;
+
+    /** Working memory for the third Runge-Kutta stage. */
+    std::vector<double> mK3;
+
+    /** Working memory for the intermediate Runge-Kutta state. */
+    std::vector<double> mYki;
+
+    /**
+     * Advance the gathered state variables by one forward Euler step.
+     *
+     * @param rSystem the system used to evaluate the RHS
+     * @param numSystems the number of instances
+     * @param time the time at the start of the step
+     * @param timeStep the size of the step
+     */
+    void TakeEulerStep(const AbstractBatchableOdeSystem& rSystem, unsigned numSystems, double time, double timeStep);
+
+    /**
+     * Advance the gathered state variables by one fourth-order Runge-Kutta step.
+     *
+     * @param rSystem the system used to evaluate the RHS
+     * @param numSystems the number of instances
+     * @param time the time at the start of the step
+     * @param timeStep the size of the step
+     */
+    void TakeRungeKutta4Step(const AbstractBatchableOdeSystem& rSystem, unsigned numSystems, double time, double timeStep);
+
+public:
+
+    /**
+     * Solve a batch of ODE systems from startTime to endTime, updating the state
+     * variables of each system.
+     *
+     * All the systems must be of the same type, which must inherit from
+     * AbstractBatchableOdeSystem, and must share the same number of state variables
+     * and parameters.
+     *
+     * @param rSystems the ODE systems to solve
+     * @param useRungeKutta4 whether to use fourth-order Runge-Kutta rather than forward Euler
+     * @param startTime the time at which to start
+     * @param endTime the time at which to stop
+     * @param timeStep the time step to use
+     */
+    void Solve(const std::vector<AbstractOdeSystem*>& rSystems,
+               bool useRungeKutta4,
+               double startTime,
+               double endTime,
+               double timeStep);
+};
+
+#endif /*BATCHEDCELLODESOLVER_HPP_*/
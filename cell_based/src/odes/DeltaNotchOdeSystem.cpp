@@ -68,13 +68,26 @@ DeltaNotchOdeSystem::~DeltaNotchOdeSystem()
 
 void DeltaNotchOdeSystem::EvaluateYDerivatives(double time, const std::vector<double>& rY, std::vector<double>& rDY)
 {
-    double notch = rY[0];
-    double delta = rY[1];
-    double mean_delta = this->mParameters[0]; // Shorthand for "this->mParameter("Mean Delta");"
+    // Evaluate as a batch of one, so that both code paths give identical results
+    EvaluateYDerivativesBatch(time, 1, &rY[0], &(this->mParameters[0]), &rDY[0]);
+}
+
+void DeltaNotchOdeSystem::EvaluateYDerivativesBatch(double time, unsigned numSystems, const double* pY, const double* pParameters, double* pDY) const
+{
+    const double* p_notch = pY;
+    const double* p_delta = pY + numSystems;
+    const double* p_mean_delta = pParameters; // "Mean Delta" is the first parameter
 
-    // The next two lines define the ODE system by Collier et al. (1996)
-    rDY[0] = mean_delta*mean_delta/(0.01 + mean_delta*mean_delta) - notch;  // d[Notch]/dt
-    rDY[1] = 1.0/(1.0 + 100.0*notch*notch) - delta;                   // d[Delta]/dt
+    for (unsigned s=0; s<numSystems; s++)
+    {
+        double notch = p_notch[s];
+        double delta = p_delta[s];
+        double mean_delta = p_mean_delta[s];
+
+        // The next two lines define the ODE system by Collier et al. (1996)
+        pDY[s] = mean_delta*mean_delta/(0.01 + mean_delta*mean_delta) - notch;  // d[Notch]/dt
+        pDY[numSystems + s] = 1.0/(1.0 + 100.0*notch*notch) - delta;           // d[Delta]/dt
+    }
 }
 
 template<>
@@ -89,7 +102,7 @@ void CellwiseOdeSystemInformation<DeltaNotchOdeSystem>::Initialise()
     this->mInitialConditions.push_back(0.0); // will be filled in later
 
     // If this is ever not the first parameter change the line
-    // double mean_delta = this->mParameters[0]; in EvaluateYDerivatives().
+    // double mean_delta = p_mean_delta[s]; in EvaluateYDerivativesBatch().
     this->mParameterNames.push_back("Mean Delta");
     this->mParameterUnits.push_back("non-dim");
 
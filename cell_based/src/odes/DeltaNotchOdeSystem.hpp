@@ -43,6 +43,7 @@ OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <iostream>
 
 #include "AbstractOdeSystem.hpp"
+#include "AbstractBatchableOdeSystem.hpp"
 
 /**
  * Represents the Delta-Notch ODE system described by Collier et al,
@@ -50,7 +51,7 @@ OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
  * model of delta-notch intercellular signalling" (Journal of Theoretical
  * Biology 183:429-446, 1996).
  */
-class DeltaNotchOdeSystem : public AbstractOdeSystem
+class DeltaNotchOdeSystem : public AbstractOdeSystem, public AbstractBatchableOdeSystem
 {
 private:
 
@@ -94,6 +95,20 @@ public:
      * @param rDY filled in with the resulting derivatives (using  Collier et al. system of equations).
      */
     void EvaluateYDerivatives(double time, const std::vector<double>& rY, std::vector<double>& rDY);
+
+    /**
+     * Overridden EvaluateYDerivativesBatch() method.
+     *
+     * Evaluates the same equations as EvaluateYDerivatives() for numSystems
+     * instances of this system at once.
+     *
+     * @param time used to evaluate the RHS.
+     * @param numSystems the number of instances
+     * @param pY the state variables of the instances, in structure-of-arrays layout
+     * @param pParameters the parameters of the instances, in structure-of-arrays layout
+     * @param pDY filled in with the derivatives of the instances, in structure-of-arrays layout
+     */
+    void EvaluateYDerivativesBatch(double time, unsigned numSystems, const double* pY, const double* pParameters, double* pDY) const;
 };
 
 // Declare identifier for the serializer
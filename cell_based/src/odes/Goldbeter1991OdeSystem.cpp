@@ -65,32 +65,41 @@ Goldbeter1991OdeSystem::~Goldbeter1991OdeSystem()
 
 void Goldbeter1991OdeSystem::EvaluateYDerivatives(double time, const std::vector<double>& rY, std::vector<double>& rDY)
 {
-    // state values
-    double C = rY[0]; // cyclin
-    double M = rY[1]; // kinase
-    double X = rY[2]; // protease
+    // Evaluate as a batch of one, so that both code paths give identical results
+    EvaluateYDerivativesBatch(time, 1, &rY[0], NULL, &rDY[0]);
+}
 
+void Goldbeter1991OdeSystem::EvaluateYDerivativesBatch(double time, unsigned numSystems, const double* pY, const double* pParameters, double* pDY) const
+{
     // consts
     const double cell = 1;
     const double VM1 = 3;
     const double VM3 = 1;
     const double Kc = 0.5;
 
-    // calculations
-    double reaction1 = cell * 0.025;
-    double reaction2 = C * cell * 0.01;
-    double reaction3 = C * cell * 0.25 * X * pow(C + 0.02, -1);
-    double reaction5 = cell * M * 1.5 * pow(0.005 + M, -1);
-    double reaction7 = cell * 0.5 * X * pow(0.005 + X, -1);
-    double V3 = M * VM3;
-    double V1 = C * VM1 * pow(C + Kc, -1);
-    double reaction6 = cell * V3 * (1 + -1 * X) * pow(0.005 + -1 * X + 1, -1);
-    double reaction4 = cell * (1 + -1 * M) * V1 * pow(0.005 + -1 * M + 1, -1);
-
-    // ODEs
-    rDY[0] = (reaction1 - reaction2 - reaction3) / cell; // dC/dt
-    rDY[1] = (reaction4 - reaction5) / cell; // dM/dt
-    rDY[2] = (reaction6 - reaction7) / cell; // dX/dt
+    for (unsigned s=0; s<numSystems; s++)
+    {
+        // state values
+        double C = pY[s]; // cyclin
+        double M = pY[numSystems + s]; // kinase
+        double X = pY[2*numSystems + s]; // protease
+
+        // calculations
+        double reaction1 = cell * 0.025;
+        double reaction2 = C * cell * 0.01;
+        double reaction3 = C * cell * 0.25 * X * pow(C + 0.02, -1);
+        double reaction5 = cell * M * 1.5 * pow(0.005 + M, -1);
+        double reaction7 = cell * 0.5 * X * pow(0.005 + X, -1);
+        double V3 = M * VM3;
+        double V1 = C * VM1 * pow(C + Kc, -1);
+        double reaction6 = cell * V3 * (1 + -1 * X) * pow(0.005 + -1 * X + 1, -1);
+        double reaction4 = cell * (1 + -1 * M) * V1 * pow(0.005 + -1 * M + 1, -1);
+
+        // ODEs
+        pDY[s] = (reaction1 - reaction2 - reaction3) / cell; // dC/dt
+        pDY[numSystems + s] = (reaction4 - reaction5) / cell; // dM/dt
+        pDY[2*numSystems + s] = (reaction6 - reaction7) / cell; // dX/dt
+    }
 }
 
 template<>
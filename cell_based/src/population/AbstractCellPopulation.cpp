@@ -43,6 +43,7 @@ OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "SmartPointers.hpp"
 #include "CellAncestor.hpp"
 #include "ApoptoticCellProperty.hpp"
+#include "CellTrajectoryHdf5Writer.hpp"
 
 // Cell writers
 #include "BoundaryNodeWriter.hpp"
@@ -72,7 +73,8 @@ AbstractCellPopulation<ELEMENT_DIM, SPACE_DIM>::AbstractCellPopulation( Abstract
       mCells(rCells.begin(), rCells.end()),
       mCentroid(zero_vector<double>(SPACE_DIM)),
       mpCellPropertyRegistry(CellPropertyRegistry::Instance()->TakeOwnership()),
-      mOutputResultsForChasteVisualizer(true)
+      mOutputResultsForChasteVisualizer(true),
+      mOutputCellWritersInHdf5(false)
 {
     /*
      * To avoid double-counting problems, clear the passed-in cells vector.
@@ -91,8 +93,7 @@ AbstractCellPopulation<ELEMENT_DIM, SPACE_DIM>::AbstractCellPopulation( Abstract
     }
 
     // Set up the map between location indices and cells
-    mLocationCellMap.clear();
-    mCellLocationMap.clear();
+    mCellLocationIndexMap.Clear();
 
     std::list<CellPtr>::iterator it = mCells.begin();
     for (unsigned i=0; it != mCells.end(); ++it, ++i)
@@ -104,7 +105,8 @@ AbstractCellPopulation<ELEMENT_DIM, SPACE_DIM>::AbstractCellPopulation( Abstract
 
 template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
 AbstractCellPopulation<ELEMENT_DIM, SPACE_DIM>::AbstractCellPopulation(AbstractMesh<ELEMENT_DIM, SPACE_DIM>& rMesh)
-    : mrMesh(rMesh)
+    : mrMesh(rMesh),
+      mOutputCellWritersInHdf5(false)
 {
 }
 
@@ -172,7 +174,7 @@ void AbstractCellPopulation<ELEMENT_DIM, SPACE_DIM>::SetCellAncestorsToLocationI
 {
     for (typename AbstractCellPopulation<ELEMENT_DIM, SPACE_DIM>::Iterator cell_iter=this->Begin(); cell_iter!=this->End(); ++cell_iter)
     {
-        MAKE_PTR_ARGS(CellAncestor, p_cell_ancestor, (mCellLocationMap[(*cell_iter).get()]));
+        MAKE_PTR_ARGS(CellAncestor, p_cell_ancestor, (mCellLocationIndexMap.GetLocationIndex((*cell_iter).get())));
         cell_iter->SetAncestor(p_cell_ancestor);
     }
 }
@@ -319,15 +321,15 @@ std::vector<unsigned> AbstractCellPopulation<ELEMENT_DIM, SPACE_DIM>::GetCellCyc
 template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
 CellPtr AbstractCellPopulation<ELEMENT_DIM, SPACE_DIM>::GetCellUsingLocationIndex(unsigned index)
 {
-    // Get the set of pointers to cells corresponding to this location index
-    std::set<CellPtr> cells = mLocationCellMap[index];
+    // Get the first slot in the map corresponding to this location index
+    unsigned slot = mCellLocationIndexMap.GetFirstSlot(index);
 
     // If there is only one cell attached return the cell. Note currently only one cell per index.
-    if (cells.size() == 1)
+    if (slot != UNSIGNED_UNSET && mCellLocationIndexMap.GetNextSlot(slot) == UNSIGNED_UNSET)
     {
-        return *(cells.begin());
+        return mCellLocationIndexMap.rGetCellInSlot(slot);
     }
-    if (cells.empty())
+    if (slot == UNSIGNED_UNSET)
     {
         EXCEPTION("Location index input argument does not correspond to a Cell");
     }
@@ -341,17 +343,14 @@ template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
 std::set<CellPtr> AbstractCellPopulation<ELEMENT_DIM, SPACE_DIM>::GetCellsUsingLocationIndex(unsigned index)
 {
     // Return the set of pointers to cells corresponding to this location index, note the set may be empty.
-    return mLocationCellMap[index];
+    return mCellLocationIndexMap.GetCellsAtLocation(index);
 }
 
 template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
 bool AbstractCellPopulation<ELEMENT_DIM, SPACE_DIM>::IsCellAttachedToLocationIndex(unsigned index)
 {
-    // Get the set of pointers to cells corresponding to this location index
-    std::set<CellPtr> cells = mLocationCellMap[index];
-
     // Return whether there is a cell attached to the location index
-    return !(cells.empty());
+    return mCellLocationIndexMap.GetFirstSlot(index) != UNSIGNED_UNSET;
 }
 
 template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
@@ -362,38 +361,23 @@ void AbstractCellPopulation<ELEMENT_DIM, SPACE_DIM>::WriteDataToVisualizerSetupF
 template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
 void AbstractCellPopulation<ELEMENT_DIM, SPACE_DIM>::SetCellUsingLocationIndex(unsigned index, CellPtr pCell)
 {
-    // Clear the maps
-    mLocationCellMap[index].clear();
-    mCellLocationMap.erase(pCell.get());
-
-    // Replace with new cell
-    mLocationCellMap[index].insert(pCell);
-
-    // Do other half of the map
-    mCellLocationMap[pCell.get()] = index;
+    // Replace any cells attached to this location index with the new cell
+    mCellLocationIndexMap.SetCell(index, pCell);
 }
 
 template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
 void AbstractCellPopulation<ELEMENT_DIM, SPACE_DIM>::AddCellUsingLocationIndex(unsigned index, CellPtr pCell)
 {
-    mLocationCellMap[index].insert(pCell);
-    mCellLocationMap[pCell.get()] = index;
+    mCellLocationIndexMap.AddCell(index, pCell);
 }
 
 template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
 void AbstractCellPopulation<ELEMENT_DIM, SPACE_DIM>::RemoveCellUsingLocationIndex(unsigned index, CellPtr pCell)
 {
-    std::set<CellPtr>::iterator cell_iter = mLocationCellMap[index].find(pCell);
-
-    if (cell_iter == mLocationCellMap[index].end())
+    if (!mCellLocationIndexMap.RemoveCell(index, pCell))
     {
         EXCEPTION("Tried to remove a cell which is not attached to the given location index");
     }
-    else
-    {
-        mLocationCellMap[index].erase(cell_iter);
-        mCellLocationMap.erase(pCell.get());
-    }
 }
 
 template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
@@ -409,10 +393,12 @@ void AbstractCellPopulation<ELEMENT_DIM, SPACE_DIM>::MoveCellInLocationMap(CellP
 template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
 unsigned AbstractCellPopulation<ELEMENT_DIM, SPACE_DIM>::GetLocationIndexUsingCell(CellPtr pCell)
 {
+    unsigned index = mCellLocationIndexMap.GetLocationIndex(pCell.get());
+
     // Check the cell is in the map
-    assert(this->mCellLocationMap.find(pCell.get()) != this->mCellLocationMap.end());
+    assert(index != UNSIGNED_UNSET);
 
-    return mCellLocationMap[pCell.get()];
+    return index;
 }
 
 template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
@@ -466,9 +452,12 @@ template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
 void AbstractCellPopulation<ELEMENT_DIM, SPACE_DIM>::CloseRoundRobinWritersFiles()
 {
     typedef AbstractCellWriter<ELEMENT_DIM, SPACE_DIM> cell_writer_t;
-    BOOST_FOREACH(boost::shared_ptr<cell_writer_t> p_cell_writer, mCellWriters)
+    if (!mOutputCellWritersInHdf5)
     {
-        p_cell_writer->CloseFile();
+        BOOST_FOREACH(boost::shared_ptr<cell_writer_t> p_cell_writer, mCellWriters)
+        {
+            p_cell_writer->CloseFile();
+        }
     }
 
     typedef AbstractCellPopulationWriter<ELEMENT_DIM, SPACE_DIM> pop_writer_t;
@@ -482,9 +471,17 @@ template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
 void AbstractCellPopulation<ELEMENT_DIM, SPACE_DIM>::CloseWritersFiles()
 {
     typedef AbstractCellWriter<ELEMENT_DIM, SPACE_DIM> cell_writer_t;
-    BOOST_FOREACH(boost::shared_ptr<cell_writer_t> p_cell_writer, mCellWriters)
+    if (mpCellTrajectoryWriter)
     {
-        p_cell_writer->CloseFile();
+        mpCellTrajectoryWriter->Close();
+        mpCellTrajectoryWriter.reset();
+    }
+    else
+    {
+        BOOST_FOREACH(boost::shared_ptr<cell_writer_t> p_cell_writer, mCellWriters)
+        {
+            p_cell_writer->CloseFile();
+        }
     }
 
     typedef AbstractCellPopulationWriter<ELEMENT_DIM, SPACE_DIM> pop_writer_t;
@@ -528,9 +525,17 @@ void AbstractCellPopulation<ELEMENT_DIM, SPACE_DIM>::OpenWritersFiles(OutputFile
 
     // Open output files for any cell writers
     typedef AbstractCellWriter<ELEMENT_DIM, SPACE_DIM> cell_writer_t;
-    BOOST_FOREACH(boost::shared_ptr<cell_writer_t> p_cell_writer, mCellWriters)
+    if (mOutputCellWritersInHdf5)
+    {
+        // All cell writers share one HDF5 file, which stays open until CloseWritersFiles() is called
+        mpCellTrajectoryWriter.reset(new CellTrajectoryHdf5Writer<ELEMENT_DIM, SPACE_DIM>(rOutputFileHandler, "cell_trajectories.h5", mCellWriters));
+    }
+    else
     {
-        p_cell_writer->OpenOutputFile(rOutputFileHandler);
+        BOOST_FOREACH(boost::shared_ptr<cell_writer_t> p_cell_writer, mCellWriters)
+        {
+            p_cell_writer->OpenOutputFile(rOutputFileHandler);
+        }
     }
 
     // Open output files and write headers for any population writers
@@ -555,9 +560,12 @@ void AbstractCellPopulation<ELEMENT_DIM, SPACE_DIM>::OpenRoundRobinWritersFilesF
 {
     typedef AbstractCellWriter<ELEMENT_DIM, SPACE_DIM> cell_writer_t;
     typedef AbstractCellPopulationWriter<ELEMENT_DIM, SPACE_DIM> pop_writer_t;
-    BOOST_FOREACH(boost::shared_ptr<cell_writer_t> p_cell_writer, mCellWriters)
+    if (!mOutputCellWritersInHdf5)
     {
-        p_cell_writer->OpenOutputFileForAppend(rOutputFileHandler);
+        BOOST_FOREACH(boost::shared_ptr<cell_writer_t> p_cell_writer, mCellWriters)
+        {
+            p_cell_writer->OpenOutputFileForAppend(rOutputFileHandler);
+        }
     }
     BOOST_FOREACH(boost::shared_ptr<pop_writer_t> p_pop_writer, mCellPopulationWriters)
     {
@@ -584,9 +592,12 @@ void AbstractCellPopulation<ELEMENT_DIM, SPACE_DIM>::WriteResultsToFiles(const s
             // The master process writes time stamps
             if (PetscTools::AmMaster())
             {
-                BOOST_FOREACH(boost::shared_ptr<cell_writer_t> p_cell_writer, mCellWriters)
+                if (!mOutputCellWritersInHdf5)
                 {
-                    p_cell_writer->WriteTimeStamp();
+                    BOOST_FOREACH(boost::shared_ptr<cell_writer_t> p_cell_writer, mCellWriters)
+                    {
+                        p_cell_writer->WriteTimeStamp();
+                    }
                 }
                 BOOST_FOREACH(boost::shared_ptr<pop_writer_t> p_pop_writer, mCellPopulationWriters)
                 {
@@ -601,14 +612,20 @@ void AbstractCellPopulation<ELEMENT_DIM, SPACE_DIM>::WriteResultsToFiles(const s
                 AcceptPopulationWriter(*pop_writer_iter);
             }
 
-            AcceptCellWritersAcrossPopulation();
+            if (!mOutputCellWritersInHdf5)
+            {
+                AcceptCellWritersAcrossPopulation();
+            }
 
             // The top-most process adds a newline
             if (PetscTools::AmTopMost())
             {
-                BOOST_FOREACH(boost::shared_ptr<cell_writer_t> p_cell_writer, mCellWriters)
+                if (!mOutputCellWritersInHdf5)
                 {
-                    p_cell_writer->WriteNewline();
+                    BOOST_FOREACH(boost::shared_ptr<cell_writer_t> p_cell_writer, mCellWriters)
+                    {
+                        p_cell_writer->WriteNewline();
+                    }
                 }
                 BOOST_FOREACH(boost::shared_ptr<pop_writer_t> p_pop_writer, mCellPopulationWriters)
                 {
@@ -619,6 +636,13 @@ void AbstractCellPopulation<ELEMENT_DIM, SPACE_DIM>::WriteResultsToFiles(const s
         }
         PetscTools::EndRoundRobin();
 
+        if (mOutputCellWritersInHdf5 && !mCellWriters.empty())
+        {
+            // All processes write their cells to the HDF5 file at the same time
+            assert(mpCellTrajectoryWriter);
+            mpCellTrajectoryWriter->WriteTimeStep(this, mCellWriters);
+        }
+
         // Outside the round robin, deal with population count writers
         typedef AbstractCellPopulationCountWriter<ELEMENT_DIM, SPACE_DIM> count_writer_t;
 
@@ -767,6 +791,18 @@ void AbstractCellPopulation<ELEMENT_DIM, SPACE_DIM>::SetOutputResultsForChasteVi
     mOutputResultsForChasteVisualizer = outputResultsForChasteVisualizer;
 }
 
+template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+bool AbstractCellPopulation<ELEMENT_DIM, SPACE_DIM>::GetOutputCellWritersInHdf5()
+{
+    return mOutputCellWritersInHdf5;
+}
+
+template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+void AbstractCellPopulation<ELEMENT_DIM, SPACE_DIM>::SetOutputCellWritersInHdf5(bool outputCellWritersInHdf5)
+{
+    mOutputCellWritersInHdf5 = outputCellWritersInHdf5;
+}
+
 template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
 bool AbstractCellPopulation<ELEMENT_DIM, SPACE_DIM>::IsRoomToDivide(CellPtr pCell)
 {
@@ -52,20 +52,26 @@ OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <boost/serialization/map.hpp>
 #include <boost/serialization/set.hpp>
 #include <boost/serialization/shared_ptr.hpp>
+#include <boost/serialization/split_member.hpp>
 
 #include <boost/foreach.hpp>
 
 #include "AbstractMesh.hpp"
 #include "TetrahedralMesh.hpp"
 #include "CellPropertyRegistry.hpp"
+#include "CellLocationIndexMap.hpp"
 #include "Identifiable.hpp"
 #include "AbstractCellPopulationCountWriter.hpp"
 #include "AbstractCellPopulationWriter.hpp"
 #include "AbstractCellWriter.hpp"
+#include "ChasteSerializationVersion.hpp"
 
 // Forward declaration prevents circular include chain
 template<unsigned ELEMENT_DIM, unsigned SPACE_DIM> class AbstractCellBasedSimulation;
 
+// Forward declaration keeps HDF5 headers out of every file using a cell population
+template<unsigned ELEMENT_DIM, unsigned SPACE_DIM> class CellTrajectoryHdf5Writer;
+
 /**
  * An abstract facade class encapsulating a cell population.
  *
@@ -80,26 +86,86 @@ private:
     friend class boost::serialization::access;
 
     /**
-     * Serialize the object and its member variables.
+     * Save the object and its member variables.
+     *
+     * The cell location map is archived as the pair of std::maps it replaced,
+     * so that the archive format is unchanged.
      *
      * @param archive the archive
      * @param version the current version of this class
      */
     template<class Archive>
-    void serialize(Archive & archive, const unsigned int version)
+    void save(Archive & archive, const unsigned int version) const
     {
+        std::map<unsigned, std::set<CellPtr> > location_cell_map;
+        std::map<Cell*, unsigned> cell_location_map;
+        for (unsigned slot=0; slot<mCellLocationIndexMap.GetNumCells(); slot++)
+        {
+            const CellPtr& p_cell = mCellLocationIndexMap.rGetCellInSlot(slot);
+            unsigned index = mCellLocationIndexMap.GetLocationIndexInSlot(slot);
+            location_cell_map[index].insert(p_cell);
+            cell_location_map[p_cell.get()] = index;
+        }
+
         archive & mCells;
-        archive & mLocationCellMap;
-        archive & mCellLocationMap;
+        archive & location_cell_map;
+        archive & cell_location_map;
         archive & mpCellPropertyRegistry;
         archive & mOutputResultsForChasteVisualizer;
         archive & mCellWriters;
         archive & mCellPopulationWriters;
         archive & mCellPopulationCountWriters;
+        archive & mOutputCellWritersInHdf5;
     }
 
+    /**
+     * Load the object and its member variables.
+     *
+     * @param archive the archive
+     * @param version the current version of this class
+     */
+    template<class Archive>
+    void load(Archive & archive, const unsigned int version)
+    {
+        std::map<unsigned, std::set<CellPtr> > location_cell_map;
+        std::map<Cell*, unsigned> cell_location_map;
+
+        archive & mCells;
+        archive & location_cell_map;
+        archive & cell_location_map;
+        archive & mpCellPropertyRegistry;
+        archive & mOutputResultsForChasteVisualizer;
+        archive & mCellWriters;
+        archive & mCellPopulationWriters;
+        archive & mCellPopulationCountWriters;
+        if (version > 0)
+        {
+            archive & mOutputCellWritersInHdf5;
+        }
+
+        // Only keep the associations on which both halves of the archived map agree
+        mCellLocationIndexMap.Clear();
+        for (std::map<unsigned, std::set<CellPtr> >::iterator map_iter = location_cell_map.begin();
+             map_iter != location_cell_map.end();
+             ++map_iter)
+        {
+            for (std::set<CellPtr>::iterator cell_iter = map_iter->second.begin();
+                 cell_iter != map_iter->second.end();
+                 ++cell_iter)
+            {
+                std::map<Cell*, unsigned>::iterator index_iter = cell_location_map.find(cell_iter->get());
+                if (index_iter != cell_location_map.end() && index_iter->second == map_iter->first)
+                {
+                    mCellLocationIndexMap.AddCell(map_iter->first, *cell_iter);
+                }
+            }
+        }
+    }
+    BOOST_SERIALIZATION_SPLIT_MEMBER()
+
     /**
      * Open all files in mCellPopulationWriters and mCellWriters in append mode for writing.
+     * If mOutputCellWritersInHdf5 is true, the files of mCellWriters are not opened.
      *
      * Files in mCellPopulationCountWriters are NOT opened in this call since they are not written in
      * a round-robin fashion.
@@ -119,11 +185,8 @@ private:
 
 protected:
 
-    /** Map location (node or VertexElement) indices back to cells. */
-    std::map<unsigned, std::set<CellPtr> > mLocationCellMap;
-
-    /** Map cells to location (node or VertexElement) indices. */
-    std::map<Cell*, unsigned> mCellLocationMap;
+    /** Map between cells and location (node, VertexElement or lattice site) indices. */
+    CellLocationIndexMap mCellLocationIndexMap;
 
     /** Reference to the mesh. */
     AbstractMesh<ELEMENT_DIM, SPACE_DIM>& mrMesh;
@@ -152,6 +215,15 @@ protected:
     /** A list of cell population count writers. */
     std::vector<boost::shared_ptr<AbstractCellPopulationCountWriter<ELEMENT_DIM, SPACE_DIM> > > mCellPopulationCountWriters;
 
+    /**
+     * Whether to write the output of mCellWriters to a single HDF5 file, using
+     * mpCellTrajectoryWriter, rather than to one text file per writer (defaults to false).
+     */
+    bool mOutputCellWritersInHdf5;
+
+    /** The writer used for the output of mCellWriters if mOutputCellWritersInHdf5 is true. */
+    boost::shared_ptr<CellTrajectoryHdf5Writer<ELEMENT_DIM, SPACE_DIM> > mpCellTrajectoryWriter;
+
     /**
      * Check consistency of our internal data structures.
      *
@@ -505,7 +577,7 @@ public:
     virtual void RemoveCellUsingLocationIndex(unsigned index, CellPtr pCell);
 
     /**
-     * Change the location index of a cell in mLocationCellMap and mCellLocationMap
+     * Change the location index of a cell in mCellLocationIndexMap
      *
      * @param pCell the cell to move
      * @param old_index the old location index
@@ -806,6 +878,23 @@ public:
      */
     void SetOutputResultsForChasteVisualizer(bool outputResultsForChasteVisualizer);
 
+    /**
+     * @return mOutputCellWritersInHdf5
+     */
+    bool GetOutputCellWritersInHdf5();
+
+    /**
+     * Set mOutputCellWritersInHdf5.
+     *
+     * If true, the output of all cell writers is written in parallel to the columns of a
+     * single HDF5 file, "cell_trajectories.h5", which stays open for the whole simulation,
+     * instead of each process taking its turn to append to one text file per writer.
+     * CellTrajectoryHdf5Reader converts this file to text or VTK output.
+     *
+     * @param outputCellWritersInHdf5 the new value of mOutputCellWritersInHdf5
+     */
+    void SetOutputCellWritersInHdf5(bool outputCellWritersInHdf5);
+
     /**
      * @return The width (maximum distance to centroid) of the cell population
      *     in each dimension
@@ -917,6 +1006,23 @@ public:
 
 TEMPLATED_CLASS_IS_ABSTRACT_1_UNSIGNED(AbstractCellPopulation)
 
+namespace boost {
+namespace serialization {
+/**
+ * Specify a version number for archive backwards compatibility.
+ *
+ * This is how to do BOOST_CLASS_VERSION(AbstractCellPopulation, 1)
+ * with a templated class.
+ */
+template <unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+struct version<AbstractCellPopulation<ELEMENT_DIM, SPACE_DIM> >
+{
+    ///Macro to set the version number of templated archive in known versions of Boost
+    CHASTE_VERSION_CONTENT(1);
+};
+} // namespace serialization
+} // namespace boost
+
 //////////////////////////////////////////////////////////////////////////////
 //         Iterator class implementation - most methods are inlined         //
 //////////////////////////////////////////////////////////////////////////////
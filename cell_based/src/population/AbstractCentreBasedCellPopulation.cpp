@@ -116,7 +116,6 @@ CellPtr AbstractCentreBasedCellPopulation<ELEMENT_DIM, SPACE_DIM>::AddCell(CellP
 
     // Update mappings between cells and location indices
     this->SetCellUsingLocationIndex(new_node_index, pNewCell);
-    this->mCellLocationMap[pNewCell.get()] = new_node_index;
 
     return pNewCell;
 }
@@ -43,7 +43,8 @@ AbstractOnLatticeCellPopulation<DIM>::AbstractOnLatticeCellPopulation(AbstractMe
     : AbstractCellPopulation<DIM>(rMesh, rCells, locationIndices),
       mDeleteMesh(deleteMesh),
       mUpdateNodesInRandomOrder(true),
-      mIterateRandomlyOverUpdateRuleCollection(false)
+      mIterateRandomlyOverUpdateRuleCollection(false),
+      mNumCheckerboardPartitions(0)
 {
     std::list<CellPtr>::iterator it = this->mCells.begin();
     for (unsigned i=0; it != this->mCells.end(); ++it, ++i)
@@ -58,7 +59,8 @@ AbstractOnLatticeCellPopulation<DIM>::AbstractOnLatticeCellPopulation(AbstractMe
     : AbstractCellPopulation<DIM>(rMesh),
       mDeleteMesh(true),
       mUpdateNodesInRandomOrder(true),
-      mIterateRandomlyOverUpdateRuleCollection(false)
+      mIterateRandomlyOverUpdateRuleCollection(false),
+      mNumCheckerboardPartitions(0)
 {
 }
 
@@ -91,6 +93,18 @@ bool AbstractOnLatticeCellPopulation<DIM>::GetIterateRandomlyOverUpdateRuleColle
     return mIterateRandomlyOverUpdateRuleCollection;
 }
 
+template<unsigned DIM>
+void AbstractOnLatticeCellPopulation<DIM>::SetNumCheckerboardPartitions(unsigned numPartitions)
+{
+    mNumCheckerboardPartitions = numPartitions;
+}
+
+template<unsigned DIM>
+unsigned AbstractOnLatticeCellPopulation<DIM>::GetNumCheckerboardPartitions() const
+{
+    return mNumCheckerboardPartitions;
+}
+
 template<unsigned DIM>
 void AbstractOnLatticeCellPopulation<DIM>::SetNode(unsigned nodeIndex, ChastePoint<DIM>& rNewLocation)
 {
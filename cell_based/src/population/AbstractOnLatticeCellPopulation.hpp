@@ -90,6 +90,14 @@ protected:
      */
     bool mIterateRandomlyOverUpdateRuleCollection;
 
+    /**
+     * The number of partitions of each colour of the lattice checkerboard used to update
+     * cell locations in parallel (see LatticeCheckerboard), or zero to update them serially.
+     * Initialized to zero in the constructor.  Not archived, so must be set again by the
+     * caller after a restart.
+     */
+    unsigned mNumCheckerboardPartitions;
+
     /**
      * Constructor that just takes in a mesh.
      *
@@ -154,6 +162,24 @@ public:
      */
     bool GetIterateRandomlyOverUpdateRuleCollection();
 
+    /**
+     * Set mNumCheckerboardPartitions.
+     *
+     * With a non-zero number of partitions, the lattice is coloured as a checkerboard and
+     * the sites of each colour are updated concurrently, one thread per partition, with
+     * each partition drawing from its own reproducibly seeded random number stream.
+     * Results depend on the number of partitions but not on the number of threads.
+     * Threads are only used if Chaste is built with OpenMP support.
+     *
+     * @param numPartitions the number of partitions, or zero to update cell locations serially
+     */
+    void SetNumCheckerboardPartitions(unsigned numPartitions);
+
+    /**
+     * @return mNumCheckerboardPartitions.
+     */
+    unsigned GetNumCheckerboardPartitions() const;
+
     /**
      * Overridden SetNode() method.
      *
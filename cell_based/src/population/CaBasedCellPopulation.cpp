@@ -40,6 +40,7 @@ OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "AbstractCaUpdateRule.hpp"
 #include "AbstractCaSwitchingUpdateRule.hpp"
 #include "RandomNumberGenerator.hpp"
+#include "RandomNumberStream.hpp"
 #include "CellLocationIndexWriter.hpp"
 #include "ExclusionCaBasedDivisionRule.hpp"
 #include "NodesOnlyMesh.hpp"
@@ -64,7 +65,8 @@ CaBasedCellPopulation<DIM>::CaBasedCellPopulation(PottsMesh<DIM>& rMesh,
                                                         bool deleteMesh,
                                                         bool validate)
     : AbstractOnLatticeCellPopulation<DIM>(rMesh, rCells, locationIndices, deleteMesh),
-      mLatticeCarryingCapacity(latticeCarryingCapacity)
+      mLatticeCarryingCapacity(latticeCarryingCapacity),
+      mpCheckerboard(NULL)
 {
     mAvailableSpaces = std::vector<unsigned>(this->GetNumNodes(), latticeCarryingCapacity);
     mpCaBasedDivisionRule.reset(new ExclusionCaBasedDivisionRule<DIM>());
@@ -99,13 +101,16 @@ CaBasedCellPopulation<DIM>::CaBasedCellPopulation(PottsMesh<DIM>& rMesh,
 
 template<unsigned DIM>
 CaBasedCellPopulation<DIM>::CaBasedCellPopulation(PottsMesh<DIM>& rMesh)
-    : AbstractOnLatticeCellPopulation<DIM>(rMesh)
+    : AbstractOnLatticeCellPopulation<DIM>(rMesh),
+      mpCheckerboard(NULL)
 {
 }
 
 template<unsigned DIM>
 CaBasedCellPopulation<DIM>::~CaBasedCellPopulation()
 {
+    delete mpCheckerboard;
+
     if (this->mDeleteMesh)
     {
         delete &this->mrMesh;
@@ -279,6 +284,157 @@ unsigned CaBasedCellPopulation<DIM>::RemoveDeadCells()
     return num_removed;
 }
 
+template<unsigned DIM>
+void CaBasedCellPopulation<DIM>::CalculateMovePropensities(CellPtr pCell,
+                                                           unsigned nodeIndex,
+                                                           double dt,
+                                                           std::vector<unsigned>& rNeighbourIndices,
+                                                           std::vector<double>& rPropensities)
+{
+    std::set<unsigned> neighbouring_node_indices = static_cast<PottsMesh<DIM>& >((this->mrMesh)).GetMooreNeighbouringNodeIndices(nodeIndex);
+
+    // Each node in the mesh must have at least one neighbour
+    if (neighbouring_node_indices.empty())
+    {
+        NEVER_REACHED;
+    }
+
+    rNeighbourIndices.assign(neighbouring_node_indices.begin(), neighbouring_node_indices.end());
+    rPropensities.clear();
+
+    double probability_of_not_moving = 1.0;
+    for (unsigned i=0; i<rNeighbourIndices.size(); i++)
+    {
+        double probability_of_moving = 0.0;
+
+        if (IsSiteAvailable(rNeighbourIndices[i], pCell))
+        {
+            // Iterating over the update rule
+            for (typename std::vector<boost::shared_ptr<AbstractUpdateRule<DIM> > >::iterator iter_rule = this->mUpdateRuleCollection.begin();
+                 iter_rule != this->mUpdateRuleCollection.end();
+                 ++iter_rule)
+            {
+                // This static cast is fine, since we assert the update rule must be a CA update rule in AddUpdateRule()
+                double p = (boost::static_pointer_cast<AbstractCaUpdateRule<DIM> >(*iter_rule))->EvaluateProbability(nodeIndex, rNeighbourIndices[i], *this, dt, 1, pCell);
+                probability_of_moving += p;
+                if (probability_of_moving < 0)
+                {
+                    EXCEPTION("The probability of cellular movement is smaller than zero. In order to prevent it from happening you should change your time step and parameters");
+                }
+
+                if (probability_of_moving > 1)
+                {
+                    EXCEPTION("The probability of the cellular movement is bigger than one. In order to prevent it from happening you should change your time step and parameters");
+                }
+            }
+
+            probability_of_not_moving -= probability_of_moving;
+        }
+        rPropensities.push_back(probability_of_moving);
+    }
+    if (probability_of_not_moving < 0)
+    {
+        EXCEPTION("The probability of the cell not moving is smaller than zero. In order to prevent it from happening you should change your time step and parameters");
+    }
+}
+
+template<unsigned DIM>
+void CaBasedCellPopulation<DIM>::UpdateCellLocationsOnCheckerboard(double dt)
+{
+    if (mLatticeCarryingCapacity != 1)
+    {
+        EXCEPTION("Checkerboard updates of a CaBasedCellPopulation require a lattice carrying capacity of 1.");
+    }
+
+    unsigned num_nodes = this->mrMesh.GetNumNodes();
+    unsigned num_partitions = this->mNumCheckerboardPartitions;
+    if ((mpCheckerboard == NULL)
+        || (mpCheckerboard->GetNumSites() != num_nodes)
+        || (mpCheckerboard->GetNumPartitions() != num_partitions))
+    {
+        delete mpCheckerboard;
+        mpCheckerboard = new LatticeCheckerboard<DIM>(static_cast<PottsMesh<DIM>& >(this->mrMesh), 2, num_partitions);
+    }
+    mpCheckerboard->SeedStreams();
+
+    // Look up the cell on each site once, so that threads don't query the location maps
+    std::vector<CellPtr> site_cells(num_nodes);
+    for (std::list<CellPtr>::iterator cell_iter = this->mCells.begin();
+         cell_iter != this->mCells.end();
+         ++cell_iter)
+    {
+        site_cells[this->GetLocationIndexUsingCell(*cell_iter)] = *cell_iter;
+    }
+
+    // Sites whose cell has already moved this time step
+    std::vector<bool> site_moved_into(num_nodes, false);
+
+    std::vector<std::vector<std::pair<unsigned, unsigned> > > partition_moves(num_partitions);
+    for (unsigned colour=0; colour<mpCheckerboard->GetNumColours(); colour++)
+    {
+        // Exceptions can't propagate out of a parallel region, so are captured per partition
+        std::vector<boost::shared_ptr<Exception> > partition_exceptions(num_partitions);
+#ifdef CHASTE_OPENMP
+#pragma omp parallel for schedule(static, 1)
+#endif // CHASTE_OPENMP
+        for (int partition=0; partition<(int)num_partitions; partition++)
+        {
+            try
+            {
+                RandomNumberStream& r_stream = mpCheckerboard->rGetStream(partition);
+                const std::vector<unsigned>& r_sites = mpCheckerboard->rGetSites(colour, partition);
+                std::vector<std::pair<unsigned, unsigned> >& r_moves = partition_moves[partition];
+                r_moves.clear();
+
+                std::vector<double> neighbouring_node_propensities;
+                std::vector<unsigned> neighbouring_node_indices_vector;
+                for (unsigned i=0; i<r_sites.size(); i++)
+                {
+                    unsigned node_index = r_sites[i];
+                    if (site_cells[node_index] && !site_moved_into[node_index])
+                    {
+                        CalculateMovePropensities(site_cells[node_index], node_index, dt, neighbouring_node_indices_vector, neighbouring_node_propensities);
+
+                        double random_number = r_stream.ranf();
+                        double total_probability = 0.0;
+                        for (unsigned counter=0; counter<neighbouring_node_indices_vector.size(); counter++)
+                        {
+                            total_probability += neighbouring_node_propensities[counter];
+                            if (total_probability >= random_number)
+                            {
+                                r_moves.push_back(std::make_pair(node_index, neighbouring_node_indices_vector[counter]));
+                                break;
+                            }
+                        }
+                    }
+                }
+            }
+            catch (Exception& e)
+            {
+                partition_exceptions[partition].reset(new Exception(e));
+            }
+        }
+
+        for (unsigned partition=0; partition<num_partitions; partition++)
+        {
+            if (partition_exceptions[partition])
+            {
+                throw *(partition_exceptions[partition]);
+            }
+            for (unsigned move=0; move<partition_moves[partition].size(); move++)
+            {
+                unsigned old_index = partition_moves[partition][move].first;
+                unsigned new_index = partition_moves[partition][move].second;
+                this->MoveCellInLocationMap(site_cells[old_index], old_index, new_index);
+
+                site_cells[new_index] = site_cells[old_index];
+                site_cells[old_index].reset();
+                site_moved_into[new_index] = true;
+            }
+        }
+    }
+}
+
 template<unsigned DIM>
 void CaBasedCellPopulation<DIM>::UpdateCellLocations(double dt)
 {
@@ -286,7 +442,11 @@ void CaBasedCellPopulation<DIM>::UpdateCellLocations(double dt)
      * Here we loop over the nodes and calculate the probability of moving
      * and then select the node to move to.
      */
-    if (!(this->mUpdateRuleCollection.empty()))
+    if (!(this->mUpdateRuleCollection.empty()) && (this->mNumCheckerboardPartitions > 0))
+    {
+        UpdateCellLocationsOnCheckerboard(dt);
+    }
+    else if (!(this->mUpdateRuleCollection.empty()))
     {
         // Iterate over cells
         ///\todo make this sweep random
@@ -297,81 +457,27 @@ void CaBasedCellPopulation<DIM>::UpdateCellLocations(double dt)
             // Loop over neighbours and calculate probability of moving (make sure all probabilities are <1)
             unsigned node_index = this->GetLocationIndexUsingCell(*cell_iter);
 
-            // Find a random available neighbouring node to overwrite current site
-            std::set<unsigned> neighbouring_node_indices = static_cast<PottsMesh<DIM>& >((this->mrMesh)).GetMooreNeighbouringNodeIndices(node_index);
             std::vector<double> neighbouring_node_propensities;
             std::vector<unsigned> neighbouring_node_indices_vector;
+            CalculateMovePropensities(*cell_iter, node_index, dt, neighbouring_node_indices_vector, neighbouring_node_propensities);
 
-            if (!neighbouring_node_indices.empty())
-            {
-                unsigned num_neighbours = neighbouring_node_indices.size();
-                double probability_of_not_moving = 1.0;
-
-                for (std::set<unsigned>::iterator iter = neighbouring_node_indices.begin();
-                     iter != neighbouring_node_indices.end();
-                     ++iter)
-                {
-                    double probability_of_moving = 0.0;
-
-                    neighbouring_node_indices_vector.push_back(*iter);
+            // Sample random number to specify which move to make
+            RandomNumberGenerator* p_gen = RandomNumberGenerator::Instance();
+            double random_number = p_gen->ranf();
 
-                    if (IsSiteAvailable(*iter, *cell_iter))
-                    {
-                        // Iterating over the update rule
-                        for (typename std::vector<boost::shared_ptr<AbstractUpdateRule<DIM> > >::iterator iter_rule = this->mUpdateRuleCollection.begin();
-                             iter_rule != this->mUpdateRuleCollection.end();
-                             ++iter_rule)
-                        {
-                            // This static cast is fine, since we assert the update rule must be a CA update rule in AddUpdateRule()
-                            double p = (boost::static_pointer_cast<AbstractCaUpdateRule<DIM> >(*iter_rule))->EvaluateProbability(node_index, *iter, *this, dt, 1, *cell_iter);
-                            probability_of_moving += p;
-                            if (probability_of_moving < 0)
-                            {
-                                EXCEPTION("The probability of cellular movement is smaller than zero. In order to prevent it from happening you should change your time step and parameters");
-                            }
-
-                            if (probability_of_moving > 1)
-                            {
-                                EXCEPTION("The probability of the cellular movement is bigger than one. In order to prevent it from happening you should change your time step and parameters");
-                            }
-                        }
-
-                        probability_of_not_moving -= probability_of_moving;
-                        neighbouring_node_propensities.push_back(probability_of_moving);
-                    }
-                    else
-                    {
-                        neighbouring_node_propensities.push_back(0.0);
-                    }
-                }
-                if (probability_of_not_moving < 0)
-                {
-                    EXCEPTION("The probability of the cell not moving is smaller than zero. In order to prevent it from happening you should change your time step and parameters");
-                }
-
-                // Sample random number to specify which move to make
-                RandomNumberGenerator* p_gen = RandomNumberGenerator::Instance();
-                double random_number = p_gen->ranf();
-
-                double total_probability = 0.0;
-                for (unsigned counter=0; counter<num_neighbours; counter++)
+            double total_probability = 0.0;
+            for (unsigned counter=0; counter<neighbouring_node_indices_vector.size(); counter++)
+            {
+                total_probability += neighbouring_node_propensities[counter];
+                if (total_probability >= random_number)
                 {
-                    total_probability += neighbouring_node_propensities[counter];
-                    if (total_probability >= random_number)
-                    {
-                        // Move the cell to this neighbour location
-                        unsigned chosen_neighbour_location_index = neighbouring_node_indices_vector[counter];
-                        this->MoveCellInLocationMap((*cell_iter), node_index, chosen_neighbour_location_index);
-                        break;
-                    }
+                    // Move the cell to this neighbour location
+                    unsigned chosen_neighbour_location_index = neighbouring_node_indices_vector[counter];
+                    this->MoveCellInLocationMap((*cell_iter), node_index, chosen_neighbour_location_index);
+                    break;
                 }
-                // If loop completes with total_probability < random_number then stay in the same location
-            }
-            else
-            {
-                // Each node in the mesh must have at least one neighbour
-                NEVER_REACHED;
             }
+            // If loop completes with total_probability < random_number then stay in the same location
         }
     }
 
@@ -38,6 +38,7 @@ OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include "AbstractOnLatticeCellPopulation.hpp"
 #include "PottsMesh.hpp"
+#include "LatticeCheckerboard.hpp"
 #include "VertexMesh.hpp"
 #include "AbstractUpdateRule.hpp"
 #include "AbstractCaBasedDivisionRule.hpp"
@@ -83,6 +84,12 @@ private:
      * This is a specialisation for CA models. */
     boost::shared_ptr<AbstractCaBasedDivisionRule<DIM> > mpCaBasedDivisionRule;
 
+    /**
+     * The checkerboard used for parallel updates if the number of checkerboard
+     * partitions is non-zero.  Created on first use and owned by this class.
+     */
+    LatticeCheckerboard<DIM>* mpCheckerboard;
+
     /**
      * Set the empty sites by taking in a set of which nodes indices are empty sites.
      *
@@ -128,6 +135,36 @@ private:
      */
     virtual void WriteVtkResultsToFile(const std::string& rDirectory);
 
+    /**
+     * Calculate the probabilities of a cell moving to each of the neighbours of its site,
+     * using the update rules.
+     *
+     * @param pCell  the cell
+     * @param nodeIndex  the index of the site of the cell
+     * @param dt  the time step
+     * @param rNeighbourIndices  filled with the Moore neighbours of the site, in increasing index order
+     * @param rPropensities  filled with the probability of moving to each neighbour
+     */
+    void CalculateMovePropensities(CellPtr pCell,
+                                   unsigned nodeIndex,
+                                   double dt,
+                                   std::vector<unsigned>& rNeighbourIndices,
+                                   std::vector<double>& rPropensities);
+
+    /**
+     * Move cells using the update rules in parallel over a checkerboard of the lattice
+     * (see SetNumCheckerboardPartitions()).
+     *
+     * Sites are coloured so that no two sites of a colour share a neighbour, so the moves
+     * of the cells on the sites of a colour can't conflict.  Moves are proposed concurrently
+     * for each colour and then applied.  Each cell attempts one move per time step, as in
+     * the serial update, but cells are visited by site colour rather than in list order.
+     * Only a lattice carrying capacity of 1 is supported.
+     *
+     * @param dt  the time step
+     */
+    void UpdateCellLocationsOnCheckerboard(double dt);
+
 public:
 
     /**
@@ -0,0 +1,217 @@
+/*
+
+Copyright (c) 2005-2017, University of Oxford.
+All rights reserved.
+
+University of Oxford means the Chancellor, Masters and Scholars of the
+University of Oxford, having an administrative office at Wellington
+Square, Oxford OX1 2JD, UK.
+
+This file is part of Chaste.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+ * Redistributions of source code must retain the above copyright notice,
+   this list of conditions and the following disclaimer.
+ * Redistributions in binary form must reproduce the above copyright notice,
+   this list of conditions and the following disclaimer in the documentation
+   and/or other materials provided with the distribution.
+ * Neither the name of the University of Oxford nor the names of its
+   contributors may be used to endorse or promote products derived from this
+   software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+*/
+
+
+#include "CellLocationIndexMap.hpp"
+
+unsigned CellLocationIndexMap::msNextId = 1;
+
+CellLocationIndexMap::CellLocationIndexMap()
+    : mId(msNextId++)
+{
+}
+
+unsigned CellLocationIndexMap::GetSlot(const Cell* pCell) const
+{
+    if (pCell->mLocationMapId == mId)
+    {
+        // The handle was issued by this map, so it is valid if the cell still occupies its slot
+        unsigned slot = pCell->mLocationMapSlot;
+        if (slot < mCells.size() && mCells[slot].get() == pCell)
+        {
+            return slot;
+        }
+    }
+    else if (pCell->mLocationMapId != 0)
+    {
+        // The cell has since been attached to another map, so it may still be in this one
+        for (unsigned slot=0; slot<mCells.size(); slot++)
+        {
+            if (mCells[slot].get() == pCell)
+            {
+                return slot;
+            }
+        }
+    }
+    return UNSIGNED_UNSET;
+}
+
+void CellLocationIndexMap::Link(unsigned slot)
+{
+    unsigned index = mLocationIndices[slot];
+    if (index >= mFirstSlots.size())
+    {
+        mFirstSlots.resize(index + 1, UNSIGNED_UNSET);
+    }
+
+    unsigned next_slot = mFirstSlots[index];
+    mNextSlots[slot] = next_slot;
+    mPreviousSlots[slot] = UNSIGNED_UNSET;
+    if (next_slot != UNSIGNED_UNSET)
+    {
+        mPreviousSlots[next_slot] = slot;
+    }
+    mFirstSlots[index] = slot;
+}
+
+void CellLocationIndexMap::Unlink(unsigned slot)
+{
+    unsigned next_slot = mNextSlots[slot];
+    unsigned previous_slot = mPreviousSlots[slot];
+
+    if (previous_slot != UNSIGNED_UNSET)
+    {
+        mNextSlots[previous_slot] = next_slot;
+    }
+    else
+    {
+        mFirstSlots[mLocationIndices[slot]] = next_slot;
+    }
+    if (next_slot != UNSIGNED_UNSET)
+    {
+        mPreviousSlots[next_slot] = previous_slot;
+    }
+}
+
+void CellLocationIndexMap::Attach(unsigned index, CellPtr pCell)
+{
+    unsigned slot = mCells.size();
+    mCells.push_back(pCell);
+    mLocationIndices.push_back(index);
+    mNextSlots.push_back(UNSIGNED_UNSET);
+    mPreviousSlots.push_back(UNSIGNED_UNSET);
+    Link(slot);
+
+    pCell->mLocationMapId = mId;
+    pCell->mLocationMapSlot = slot;
+}
+
+void CellLocationIndexMap::Detach(unsigned slot)
+{
+    Unlink(slot);
+
+    // The cell keeps its handle, which is no longer valid since it does not occupy the slot
+    unsigned last_slot = mCells.size() - 1;
+    if (slot != last_slot)
+    {
+        // Move the cell in the last slot into the vacated slot
+        Unlink(last_slot);
+        mCells[slot] = mCells[last_slot];
+        mLocationIndices[slot] = mLocationIndices[last_slot];
+        Link(slot);
+
+        Cell* p_moved_cell = mCells[slot].get();
+        if (p_moved_cell->mLocationMapId == mId)
+        {
+            p_moved_cell->mLocationMapSlot = slot;
+        }
+    }
+
+    mCells.pop_back();
+    mLocationIndices.pop_back();
+    mNextSlots.pop_back();
+    mPreviousSlots.pop_back();
+}
+
+void CellLocationIndexMap::Clear()
+{
+    mCells.clear();
+    mLocationIndices.clear();
+    mNextSlots.clear();
+    mPreviousSlots.clear();
+    mFirstSlots.clear();
+}
+
+void CellLocationIndexMap::AddCell(unsigned index, CellPtr pCell)
+{
+    unsigned slot = GetSlot(pCell.get());
+    if (slot != UNSIGNED_UNSET)
+    {
+        if (mLocationIndices[slot] == index)
+        {
+            return;
+        }
+        Detach(slot);
+    }
+    Attach(index, pCell);
+}
+
+void CellLocationIndexMap::SetCell(unsigned index, CellPtr pCell)
+{
+    unsigned slot = GetFirstSlot(index);
+    while (slot != UNSIGNED_UNSET)
+    {
+        Detach(slot);
+        slot = GetFirstSlot(index);
+    }
+
+    slot = GetSlot(pCell.get());
+    if (slot != UNSIGNED_UNSET)
+    {
+        Detach(slot);
+    }
+    Attach(index, pCell);
+}
+
+bool CellLocationIndexMap::RemoveCell(unsigned index, CellPtr pCell)
+{
+    unsigned slot = GetSlot(pCell.get());
+    if (slot == UNSIGNED_UNSET || mLocationIndices[slot] != index)
+    {
+        return false;
+    }
+    Detach(slot);
+    return true;
+}
+
+unsigned CellLocationIndexMap::GetNumCellsAtLocation(unsigned index) const
+{
+    unsigned num_cells = 0;
+    for (unsigned slot = GetFirstSlot(index); slot != UNSIGNED_UNSET; slot = mNextSlots[slot])
+    {
+        num_cells++;
+    }
+    return num_cells;
+}
+
+std::set<CellPtr> CellLocationIndexMap::GetCellsAtLocation(unsigned index) const
+{
+    std::set<CellPtr> cells;
+    for (unsigned slot = GetFirstSlot(index); slot != UNSIGNED_UNSET; slot = mNextSlots[slot])
+    {
+        cells.insert(mCells[slot]);
+    }
+    return cells;
+}
@@ -0,0 +1,294 @@
+/*
+
+Copyright (c) 2005-2017, University of Oxford.
+All rights reserved.
+
+University of Oxford means the Chancellor, Masters and Scholars of the
+University of Oxford, having an administrative office at Wellington
+Square, Oxford OX1 2JD, UK.
+
+This file is part of Chaste.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+ * Redistributions of source code must retain the above copyright notice,
+   this list of conditions and the following disclaimer.
+ * Redistributions in binary form must reproduce the above copyright notice,
+   this list of conditions and the following disclaimer in the documentation
+   and/or other materials provided with the distribution.
+ * Neither the name of the University of Oxford nor the names of its
+   contributors may be used to endorse or promote products derived from this
+   software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+*/
+
+
+#ifndef CELLLOCATIONINDEXMAP_HPP_
+#define CELLLOCATIONINDEXMAP_HPP_
+
+#include <cassert>
+#include <set>
+#include <vector>
+
+#include "Cell.hpp"
+#include "Exception.hpp"
+
+/**
+ * Dense bookkeeping of the association between cells and location indices
+ * (node, element or lattice site indices) used by AbstractCellPopulation.
+ *
+ * Attached cells are stored contiguously in slots. Each slot records the
+ * location index of its cell, and the slots attached to the same location
+ * index are threaded together in a doubly linked list whose head is stored in
+ * an array indexed by location index. Removing a cell moves the cell in the
+ * last slot into the vacated slot, so the slots remain contiguous.
+ *
+ * Each cell carries a handle into the map consisting of the identifier of the
+ * map that last attached it and its slot within that map. Map identifiers are
+ * never reused, so a handle issued by another (possibly destroyed) map is
+ * never mistaken for one issued by this map. All lookups, insertions and
+ * removals are therefore O(1), except for the (unusual) case of a cell that
+ * is attached to more than one map at once, which is resolved by a search.
+ */
+class CellLocationIndexMap
+{
+private:
+
+    /** The identifier of this map, stored in the handles of its cells. */
+    unsigned mId;
+
+    /** The attached cells, one per slot. */
+    std::vector<CellPtr> mCells;
+
+    /** The location index of the cell in each slot. */
+    std::vector<unsigned> mLocationIndices;
+
+    /** The next slot attached to the same location index, or UNSIGNED_UNSET. */
+    std::vector<unsigned> mNextSlots;
+
+    /** The previous slot attached to the same location index, or UNSIGNED_UNSET. */
+    std::vector<unsigned> mPreviousSlots;
+
+    /** The first slot attached to each location index, or UNSIGNED_UNSET. */
+    std::vector<unsigned> mFirstSlots;
+
+    /** The identifier to give to the next map that is constructed. */
+    static unsigned msNextId;
+
+    /**
+     * @return the slot of a given cell, or UNSIGNED_UNSET if the cell is not
+     * attached to this map.
+     *
+     * @param pCell the cell
+     */
+    unsigned GetSlot(const Cell* pCell) const;
+
+    /**
+     * Attach a cell, which must not currently be attached, to a location index.
+     *
+     * @param index the location index
+     * @param pCell the cell
+     */
+    void Attach(unsigned index, CellPtr pCell);
+
+    /**
+     * Detach the cell in a given slot from its location index and fill the
+     * slot with the cell in the last slot.
+     *
+     * @param slot the slot
+     */
+    void Detach(unsigned slot);
+
+    /**
+     * Thread a slot onto the front of the list of slots attached to its
+     * location index.
+     *
+     * @param slot the slot
+     */
+    void Link(unsigned slot);
+
+    /**
+     * Remove a slot from the list of slots attached to its location index.
+     *
+     * @param slot the slot
+     */
+    void Unlink(unsigned slot);
+
+    /**
+     * Copy constructor. Not implemented, since cell handles refer to a single map.
+     */
+    CellLocationIndexMap(const CellLocationIndexMap&);
+
+    /**
+     * Overloaded assignment operator. Not implemented, since cell handles refer to a single map.
+     * @return reference by convention
+     */
+    CellLocationIndexMap& operator= (const CellLocationIndexMap&);
+
+public:
+
+    /**
+     * Default constructor.
+     */
+    CellLocationIndexMap();
+
+    /**
+     * Detach all cells.
+     */
+    void Clear();
+
+    /**
+     * Attach a cell to a location index, in addition to any cells already
+     * attached to it. If the cell is attached to another location index, it is
+     * first detached from it.
+     *
+     * @param index the location index
+     * @param pCell the cell
+     */
+    void AddCell(unsigned index, CellPtr pCell);
+
+    /**
+     * Attach a cell to a location index, first detaching any cells already
+     * attached to the location index and detaching the cell from any other
+     * location index.
+     *
+     * @param index the location index
+     * @param pCell the cell
+     */
+    void SetCell(unsigned index, CellPtr pCell);
+
+    /**
+     * Detach a cell from a location index.
+     *
+     * @param index the location index
+     * @param pCell the cell
+     * @return false (and do nothing) if the cell is not attached to this location index.
+     */
+    bool RemoveCell(unsigned index, CellPtr pCell);
+
+    /**
+     * @return whether a cell is attached to any location index.
+     *
+     * @param pCell the cell
+     */
+    bool IsCellAttached(const Cell* pCell) const
+    {
+        return GetSlot(pCell) != UNSIGNED_UNSET;
+    }
+
+    /**
+     * @return the location index of a cell, or UNSIGNED_UNSET if the cell is
+     * not attached.
+     *
+     * @param pCell the cell
+     */
+    unsigned GetLocationIndex(const Cell* pCell) const
+    {
+        unsigned slot = GetSlot(pCell);
+        return (slot == UNSIGNED_UNSET) ? UNSIGNED_UNSET : mLocationIndices[slot];
+    }
+
+    /**
+     * @return the first slot attached to a location index, or UNSIGNED_UNSET
+     * if no cell is attached to it. Further slots are obtained from GetNextSlot().
+     *
+     * @param index the location index
+     */
+    unsigned GetFirstSlot(unsigned index) const
+    {
+        return (index < mFirstSlots.size()) ? mFirstSlots[index] : UNSIGNED_UNSET;
+    }
+
+    /**
+     * @return the next slot attached to the same location index as a given
+     * slot, or UNSIGNED_UNSET if there is none.
+     *
+     * @param slot the slot
+     */
+    unsigned GetNextSlot(unsigned slot) const
+    {
+        assert(slot < mNextSlots.size());
+        return mNextSlots[slot];
+    }
+
+    /**
+     * @return the cell in a given slot.
+     *
+     * @param slot the slot
+     */
+    const CellPtr& rGetCellInSlot(unsigned slot) const
+    {
+        assert(slot < mCells.size());
+        return mCells[slot];
+    }
+
+    /**
+     * @return the location index of the cell in a given slot.
+     *
+     * @param slot the slot
+     */
+    unsigned GetLocationIndexInSlot(unsigned slot) const
+    {
+        assert(slot < mLocationIndices.size());
+        return mLocationIndices[slot];
+    }
+
+    /**
+     * @return the number of cells attached to a location index.
+     *
+     * @param index the location index
+     */
+    unsigned GetNumCellsAtLocation(unsigned index) const;
+
+    /**
+     * @return the set of cells attached to a location index (which may be empty).
+     *
+     * @param index the location index
+     */
+    std::set<CellPtr> GetCellsAtLocation(unsigned index) const;
+
+    /**
+     * @return the number of attached cells, which is also the number of slots.
+     */
+    unsigned GetNumCells() const
+    {
+        return mCells.size();
+    }
+
+    /**
+     * Replace the location index of every attached cell following a remesh.
+     * The cells keep their slots; only the lists of slots per location index
+     * are rebuilt.
+     *
+     * The index map type must provide IsDeleted() and GetNewIndex(), as do
+     * NodeMap and VertexElementMap.
+     *
+     * @param rIndexMap the map from old to new location indices
+     */
+    template<class INDEX_MAP>
+    void UpdateLocationIndices(INDEX_MAP& rIndexMap)
+    {
+        mFirstSlots.clear();
+        for (unsigned slot=0; slot<mCells.size(); slot++)
+        {
+            // This shouldn't ever happen, as only living cells are attached
+            assert(!rIndexMap.IsDeleted(mLocationIndices[slot]));
+
+            mLocationIndices[slot] = rIndexMap.GetNewIndex(mLocationIndices[slot]);
+            Link(slot);
+        }
+    }
+};
+
+#endif /* CELLLOCATIONINDEXMAP_HPP_ */
@@ -0,0 +1,150 @@
+/*
+
+Copyright (c) 2005-2017, University of Oxford.
+All rights reserved.
+
+University of Oxford means the Chancellor, Masters and Scholars of the
+University of Oxford, having an administrative office at Wellington
+Square, Oxford OX1 2JD, UK.
+
+This file is part of Chaste.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+ * Redistributions of source code must retain the above copyright notice,
+   this list of conditions and the following disclaimer.
+ * Redistributions in binary form must reproduce the above copyright notice,
+   this list of conditions and the following disclaimer in the documentation
+   and/or other materials provided with the distribution.
+ * Neither the name of the University of Oxford nor the names of its
+   contributors may be used to endorse or promote products derived from this
+   software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+*/
+
+
+#include <algorithm>
+
+#include "LatticeCheckerboard.hpp"
+#include "Exception.hpp"
+
+template<unsigned DIM>
+LatticeCheckerboard<DIM>::LatticeCheckerboard(PottsMesh<DIM>& rMesh, unsigned separation, unsigned numPartitions)
+    : mNumColours(0),
+      mNumPartitions(numPartitions),
+      mNumSites(rMesh.GetNumNodes())
+{
+    if (separation != 1u && separation != 2u)
+    {
+        EXCEPTION("The separation of a lattice checkerboard must be 1 or 2.");
+    }
+    if (numPartitions == 0u)
+    {
+        EXCEPTION("A lattice checkerboard must have at least one partition.");
+    }
+
+    // Greedily colour the sites in index order, avoiding the colours of any nearby site
+    std::vector<unsigned> site_colours(mNumSites, UNSIGNED_UNSET);
+    for (unsigned site_index=0; site_index<mNumSites; site_index++)
+    {
+        std::set<unsigned> nearby_sites = rMesh.GetMooreNeighbouringNodeIndices(site_index);
+        if (separation == 2u)
+        {
+            std::set<unsigned> neighbours = nearby_sites;
+            for (std::set<unsigned>::iterator iter = neighbours.begin(); iter != neighbours.end(); ++iter)
+            {
+                std::set<unsigned> next_neighbours = rMesh.GetMooreNeighbouringNodeIndices(*iter);
+                nearby_sites.insert(next_neighbours.begin(), next_neighbours.end());
+            }
+            nearby_sites.erase(site_index);
+        }
+
+        std::vector<bool> colour_used(mNumColours + 1, false);
+        for (std::set<unsigned>::iterator iter = nearby_sites.begin(); iter != nearby_sites.end(); ++iter)
+        {
+            if (site_colours[*iter] != UNSIGNED_UNSET)
+            {
+                colour_used[site_colours[*iter]] = true;
+            }
+        }
+
+        unsigned colour = 0;
+        while (colour_used[colour])
+        {
+            colour++;
+        }
+        site_colours[site_index] = colour;
+        mNumColours = std::max(mNumColours, colour + 1);
+    }
+
+    // Split each colour into partitions of contiguous site indices
+    mSites.resize(mNumColours*mNumPartitions);
+    for (unsigned site_index=0; site_index<mNumSites; site_index++)
+    {
+        unsigned partition = (site_index*mNumPartitions)/mNumSites;
+        mSites[site_colours[site_index]*mNumPartitions + partition].push_back(site_index);
+    }
+
+    for (unsigned partition=0; partition<mNumPartitions; partition++)
+    {
+        mStreams.push_back(boost::shared_ptr<RandomNumberStream>(new RandomNumberStream(partition)));
+    }
+}
+
+template<unsigned DIM>
+unsigned LatticeCheckerboard<DIM>::GetNumColours() const
+{
+    return mNumColours;
+}
+
+template<unsigned DIM>
+unsigned LatticeCheckerboard<DIM>::GetNumPartitions() const
+{
+    return mNumPartitions;
+}
+
+template<unsigned DIM>
+unsigned LatticeCheckerboard<DIM>::GetNumSites() const
+{
+    return mNumSites;
+}
+
+template<unsigned DIM>
+const std::vector<unsigned>& LatticeCheckerboard<DIM>::rGetSites(unsigned colour, unsigned partition) const
+{
+    assert(colour < mNumColours);
+    assert(partition < mNumPartitions);
+    return mSites[colour*mNumPartitions + partition];
+}
+
+template<unsigned DIM>
+RandomNumberStream& LatticeCheckerboard<DIM>::rGetStream(unsigned partition)
+{
+    assert(partition < mNumPartitions);
+    return *(mStreams[partition]);
+}
+
+template<unsigned DIM>
+void LatticeCheckerboard<DIM>::SeedStreams()
+{
+    for (unsigned partition=0; partition<mNumPartitions; partition++)
+    {
+        mStreams[partition]->SeedFromGlobalGenerator();
+    }
+}
+
+// Explicit instantiation
+template class LatticeCheckerboard<1>;
+template class LatticeCheckerboard<2>;
+template class LatticeCheckerboard<3>;
@@ -0,0 +1,132 @@
+/*
+
+Copyright (c) 2005-2017, University of Oxford.
+All rights reserved.
+
+University of Oxford means the Chancellor, Masters and Scholars of the
+University of Oxford, having an administrative office at Wellington
+Square, Oxford OX1 2JD, UK.
+
+This file is part of Chaste.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+ * Redistributions of source code must retain the above copyright notice,
+   this list of conditions and the following disclaimer.
+ * Redistributions in binary form must reproduce the above copyright notice,
+   this list of conditions and the following disclaimer in the documentation
+   and/or other materials provided with the distribution.
+ * Neither the name of the University of Oxford nor the names of its
+   contributors may be used to endorse or promote products derived from this
+   software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+*/
+
+
+#ifndef LATTICECHECKERBOARD_HPP_
+#define LATTICECHECKERBOARD_HPP_
+
+#include <vector>
+#include <boost/shared_ptr.hpp>
+#include <boost/utility.hpp>
+
+#include "PottsMesh.hpp"
+#include "RandomNumberStream.hpp"
+
+/**
+ * A checkerboard decomposition of the sites of a PottsMesh, for updating
+ * on-lattice cell populations in parallel.
+ *
+ * The sites are coloured so that sites of the same colour are far enough apart
+ * to be updated independently: with a separation of 1 no two sites of a colour
+ * are Moore neighbours, and with a separation of 2 no two sites of a colour share
+ * a Moore neighbour either.  The colouring is computed greedily from the neighbour
+ * sets of the mesh, so works for any PottsMesh (e.g. periodic ones); on a regular
+ * 2D lattice it gives 4 colours for a separation of 1 and 9 for a separation of 2.
+ *
+ * The sites of each colour are further split into partitions of contiguous site
+ * indices (i.e. strips of the lattice), and each partition has its own
+ * RandomNumberStream.  Partitions rather than threads own the streams, so results
+ * depend on the number of partitions but not on the number of threads used.
+ */
+template<unsigned DIM>
+class LatticeCheckerboard : private boost::noncopyable
+{
+private:
+
+    /** The number of colours used. */
+    unsigned mNumColours;
+
+    /** The number of partitions of each colour. */
+    unsigned mNumPartitions;
+
+    /** The number of sites in the mesh. */
+    unsigned mNumSites;
+
+    /** The sites of each colour and partition, indexed by colour*mNumPartitions + partition. */
+    std::vector<std::vector<unsigned> > mSites;
+
+    /** The random number stream of each partition. */
+    std::vector<boost::shared_ptr<RandomNumberStream> > mStreams;
+
+public:
+
+    /**
+     * Constructor.
+     *
+     * @param rMesh  the mesh whose sites to colour
+     * @param separation  the minimum number of Moore steps between two sites of the same colour
+     *                    minus one; must be 1 or 2
+     * @param numPartitions  the number of partitions of each colour
+     */
+    LatticeCheckerboard(PottsMesh<DIM>& rMesh, unsigned separation, unsigned numPartitions);
+
+    /**
+     * @return the number of colours.
+     */
+    unsigned GetNumColours() const;
+
+    /**
+     * @return the number of partitions of each colour.
+     */
+    unsigned GetNumPartitions() const;
+
+    /**
+     * @return the number of sites the checkerboard was built for.
+     */
+    unsigned GetNumSites() const;
+
+    /**
+     * @return the sites of a colour in a partition, in increasing index order.
+     *
+     * @param colour  the colour
+     * @param partition  the partition
+     */
+    const std::vector<unsigned>& rGetSites(unsigned colour, unsigned partition) const;
+
+    /**
+     * @return the random number stream of a partition.
+     *
+     * @param partition  the partition
+     */
+    RandomNumberStream& rGetStream(unsigned partition);
+
+    /**
+     * Seed the random number stream of each partition from the RandomNumberGenerator,
+     * in partition order.
+     */
+    void SeedStreams();
+};
+
+#endif /*LATTICECHECKERBOARD_HPP_*/
@@ -327,22 +327,14 @@ void MeshBasedCellPopulation<ELEMENT_DIM,SPACE_DIM>::Update(bool hasHadBirthsOrD
     {
         UpdateGhostNodesAfterReMesh(node_map);
 
-        // Update the mappings between cells and location indices
-        std::map<Cell*, unsigned> old_cell_location_map = this->mCellLocationMap;
-
-        // Remove any dead pointers from the maps (needed to avoid archiving errors)
-        this->mLocationCellMap.clear();
-        this->mCellLocationMap.clear();
-
         for (std::list<CellPtr>::iterator it = this->mCells.begin(); it != this->mCells.end(); ++it)
         {
-            unsigned old_node_index = old_cell_location_map[(*it).get()];
+            unsigned old_node_index = this->GetLocationIndexUsingCell(*it);
 
             // This shouldn't ever happen, as the cell vector only contains living cells
             assert(!node_map.IsDeleted(old_node_index));
 
             unsigned new_node_index = node_map.GetNewIndex(old_node_index);
-            this->SetCellUsingLocationIndex(new_node_index,*it);
 
             if (old_node_radius_map[old_node_index] > 0.0)
             {
@@ -354,15 +346,18 @@ void MeshBasedCellPopulation<ELEMENT_DIM,SPACE_DIM>::Update(bool hasHadBirthsOrD
             }
         }
 
+        // Update the mappings between cells and location indices
+        this->mCellLocationIndexMap.UpdateLocationIndices(node_map);
+
         this->Validate();
     }
     else
     {
-        if (old_node_radius_map[this->mCellLocationMap[(*(this->mCells.begin())).get()]] > 0.0)
+        if (old_node_radius_map[this->GetLocationIndexUsingCell(*(this->mCells.begin()))] > 0.0)
         {
             for (std::list<CellPtr>::iterator it = this->mCells.begin(); it != this->mCells.end(); ++it)
             {
-                unsigned node_index = this->mCellLocationMap[(*it).get()];
+                unsigned node_index = this->GetLocationIndexUsingCell(*it);
                 this->GetNode(node_index)->SetRadius(old_node_radius_map[node_index]);
             }
         }
@@ -370,7 +365,7 @@ void MeshBasedCellPopulation<ELEMENT_DIM,SPACE_DIM>::Update(bool hasHadBirthsOrD
         {
             for (std::list<CellPtr>::iterator it = this->mCells.begin(); it != this->mCells.end(); ++it)
             {
-                unsigned node_index = this->mCellLocationMap[(*it).get()];
+                unsigned node_index = this->GetLocationIndexUsingCell(*it);
                 this->GetNode(node_index)->AddAppliedForceContribution(old_node_applied_force_map[node_index]);
             }
         }
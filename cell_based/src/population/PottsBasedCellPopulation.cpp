@@ -81,7 +81,10 @@ PottsBasedCellPopulation<DIM>::PottsBasedCellPopulation(PottsMesh<DIM>& rMesh,
       mpElementTessellation(NULL),
       mpMutableMesh(NULL),
       mTemperature(0.1),
-      mNumSweepsPerTimestep(1)
+      mNumSweepsPerTimestep(1),
+      mUseLatticeEngine(false),
+      mpLatticeEngine(NULL),
+      mpCheckerboard(NULL)
 {
     mpPottsMesh = static_cast<PottsMesh<DIM>* >(&(this->mrMesh));
     // Check each element has only one cell associated with it
@@ -97,7 +100,10 @@ PottsBasedCellPopulation<DIM>::PottsBasedCellPopulation(PottsMesh<DIM>& rMesh)
       mpElementTessellation(NULL),
       mpMutableMesh(NULL),
       mTemperature(0.1),
-      mNumSweepsPerTimestep(1)
+      mNumSweepsPerTimestep(1),
+      mUseLatticeEngine(false),
+      mpLatticeEngine(NULL),
+      mpCheckerboard(NULL)
 {
     mpPottsMesh = static_cast<PottsMesh<DIM>* >(&(this->mrMesh));
 }
@@ -109,6 +115,10 @@ PottsBasedCellPopulation<DIM>::~PottsBasedCellPopulation()
 
     delete mpMutableMesh;
 
+    delete mpLatticeEngine;
+
+    delete mpCheckerboard;
+
     if (this->mDeleteMesh)
     {
         delete &this->mrMesh;
@@ -224,6 +234,7 @@ unsigned PottsBasedCellPopulation<DIM>::RemoveDeadCells()
             mpPottsMesh->DeleteElement(location_index);
 
             // Erase cell and update counter
+            this->RemoveCellUsingLocationIndex(location_index, (*cell_iter));
             cell_iter = this->mCells.erase(cell_iter);
             num_removed++;
         }
@@ -260,6 +271,18 @@ void PottsBasedCellPopulation<DIM>::UpdateCellLocations(double dt)
         p_gen->Shuffle(this->mUpdateRuleCollection);
     }
 
+    if (this->mNumCheckerboardPartitions > 0)
+    {
+        UpdateCellLocationsOnCheckerboard();
+        return;
+    }
+
+    if (mUseLatticeEngine)
+    {
+        UpdateCellLocationsOnLattice();
+        return;
+    }
+
     for (unsigned i=0; i<num_nodes*mNumSweepsPerTimestep; i++)
     {
         unsigned node_index;
@@ -346,6 +369,185 @@ void PottsBasedCellPopulation<DIM>::UpdateCellLocations(double dt)
     }
 }
 
+template<unsigned DIM>
+void PottsBasedCellPopulation<DIM>::SetUpLatticeEngine()
+{
+    // The mesh may have changed (e.g. by cell division or death) since the last sweep
+    if (mpLatticeEngine == NULL)
+    {
+        mpLatticeEngine = new PottsLatticeEngine<DIM>(*mpPottsMesh);
+    }
+    else
+    {
+        mpLatticeEngine->SetUp();
+    }
+}
+
+template<unsigned DIM>
+void PottsBasedCellPopulation<DIM>::UpdateCellLocationsOnLattice()
+{
+    SetUpLatticeEngine();
+
+    RandomNumberGenerator* p_gen = RandomNumberGenerator::Instance();
+    unsigned num_nodes = this->mrMesh.GetNumNodes();
+
+    for (unsigned i=0; i<num_nodes*mNumSweepsPerTimestep; i++)
+    {
+        unsigned node_index;
+
+        if (this->mUpdateNodesInRandomOrder)
+        {
+            node_index = p_gen->randMod(num_nodes);
+        }
+        else
+        {
+            // Loop over nodes in index order.
+            node_index = i%num_nodes;
+        }
+
+        // Find a random available neighbouring node to overwrite current site
+        unsigned num_neighbours = mpLatticeEngine->GetNumMooreNeighbours(node_index);
+        if (num_neighbours > 0)
+        {
+            unsigned neighbour_location_index = mpLatticeEngine->GetMooreNeighbour(node_index, p_gen->randMod(num_neighbours));
+
+            // Only calculate Hamiltonian and update elements if the nodes are from different elements, or one is from the medium
+            unsigned neighbour_owner = mpLatticeEngine->GetSiteOwner(neighbour_location_index);
+            if (mpLatticeEngine->GetSiteOwner(node_index) != neighbour_owner)
+            {
+                double delta_H = 0.0; // This is H_1-H_0.
+
+                // Now add contributions to the Hamiltonian from each AbstractPottsUpdateRule
+                for (typename std::vector<boost::shared_ptr<AbstractUpdateRule<DIM> > >::iterator iter = this->mUpdateRuleCollection.begin();
+                     iter != this->mUpdateRuleCollection.end();
+                     ++iter)
+                {
+                    // This static cast is fine, since we assert the update rule must be a Potts update rule in AddUpdateRule()
+                    delta_H += (boost::static_pointer_cast<AbstractPottsUpdateRule<DIM> >(*iter))->EvaluateHamiltonianContributionOnLattice(neighbour_location_index, node_index, *this, *mpLatticeEngine);
+                }
+
+                // Generate a uniform random number to do the random motion
+                double random_number = p_gen->ranf();
+
+                double p = exp(-delta_H/mTemperature);
+                if (delta_H <= 0 || random_number < p)
+                {
+                    // Do swap, which also updates the elements of the mesh
+                    mpLatticeEngine->MoveSite(node_index, neighbour_owner);
+                }
+            }
+        }
+    }
+}
+
+template<unsigned DIM>
+void PottsBasedCellPopulation<DIM>::UpdateCellLocationsOnCheckerboard()
+{
+    SetUpLatticeEngine();
+
+    unsigned num_partitions = this->mNumCheckerboardPartitions;
+    if ((mpCheckerboard == NULL)
+        || (mpCheckerboard->GetNumSites() != this->mrMesh.GetNumNodes())
+        || (mpCheckerboard->GetNumPartitions() != num_partitions))
+    {
+        delete mpCheckerboard;
+        mpCheckerboard = new LatticeCheckerboard<DIM>(*mpPottsMesh, 1, num_partitions);
+    }
+    mpCheckerboard->SeedStreams();
+
+    RandomNumberGenerator* p_gen = RandomNumberGenerator::Instance();
+    unsigned num_colours = mpCheckerboard->GetNumColours();
+    std::vector<unsigned> colour_order(num_colours);
+    for (unsigned colour=0; colour<num_colours; colour++)
+    {
+        colour_order[colour] = colour;
+    }
+
+    std::vector<std::vector<std::pair<unsigned, unsigned> > > partition_moves(num_partitions);
+    for (unsigned sweep=0; sweep<mNumSweepsPerTimestep; sweep++)
+    {
+        if (this->mUpdateNodesInRandomOrder)
+        {
+            p_gen->Shuffle(num_colours, colour_order);
+        }
+
+        for (unsigned i=0; i<num_colours; i++)
+        {
+            // Exceptions can't propagate out of a parallel region, so are captured per partition
+            std::vector<boost::shared_ptr<Exception> > partition_exceptions(num_partitions);
+#ifdef CHASTE_OPENMP
+#pragma omp parallel for schedule(static, 1)
+#endif // CHASTE_OPENMP
+            for (int partition=0; partition<(int)num_partitions; partition++)
+            {
+                try
+                {
+                    ProposeCheckerboardMoves(colour_order[i], partition, partition_moves[partition]);
+                }
+                catch (Exception& e)
+                {
+                    partition_exceptions[partition].reset(new Exception(e));
+                }
+            }
+
+            // Apply the accepted flips, which also updates the elements of the mesh
+            for (unsigned partition=0; partition<num_partitions; partition++)
+            {
+                if (partition_exceptions[partition])
+                {
+                    throw *(partition_exceptions[partition]);
+                }
+                for (unsigned move=0; move<partition_moves[partition].size(); move++)
+                {
+                    mpLatticeEngine->MoveSite(partition_moves[partition][move].first, partition_moves[partition][move].second);
+                }
+            }
+        }
+    }
+}
+
+template<unsigned DIM>
+void PottsBasedCellPopulation<DIM>::ProposeCheckerboardMoves(unsigned colour, unsigned partition, std::vector<std::pair<unsigned, unsigned> >& rMoves)
+{
+    RandomNumberStream& r_stream = mpCheckerboard->rGetStream(partition);
+    const std::vector<unsigned>& r_sites = mpCheckerboard->rGetSites(colour, partition);
+
+    rMoves.clear();
+    for (unsigned i=0; i<r_sites.size(); i++)
+    {
+        unsigned node_index = r_sites[i];
+
+        // Find a random available neighbouring node to overwrite current site
+        unsigned num_neighbours = mpLatticeEngine->GetNumMooreNeighbours(node_index);
+        if (num_neighbours > 0)
+        {
+            unsigned neighbour_location_index = mpLatticeEngine->GetMooreNeighbour(node_index, r_stream.randMod(num_neighbours));
+
+            // Only calculate Hamiltonian if the nodes are from different elements, or one is from the medium
+            unsigned neighbour_owner = mpLatticeEngine->GetSiteOwner(neighbour_location_index);
+            if (mpLatticeEngine->GetSiteOwner(node_index) != neighbour_owner)
+            {
+                double delta_H = 0.0; // This is H_1-H_0.
+                for (typename std::vector<boost::shared_ptr<AbstractUpdateRule<DIM> > >::iterator iter = this->mUpdateRuleCollection.begin();
+                     iter != this->mUpdateRuleCollection.end();
+                     ++iter)
+                {
+                    // This static cast is fine, since we assert the update rule must be a Potts update rule in AddUpdateRule()
+                    delta_H += (boost::static_pointer_cast<AbstractPottsUpdateRule<DIM> >(*iter))->EvaluateHamiltonianContributionOnLattice(neighbour_location_index, node_index, *this, *mpLatticeEngine);
+                }
+
+                double random_number = r_stream.ranf();
+
+                double p = exp(-delta_H/mTemperature);
+                if (delta_H <= 0 || random_number < p)
+                {
+                    rMoves.push_back(std::make_pair(node_index, neighbour_owner));
+                }
+            }
+        }
+    }
+}
+
 template<unsigned DIM>
 bool PottsBasedCellPopulation<DIM>::IsCellAssociatedWithADeletedLocation(CellPtr pCell)
 {
@@ -509,6 +711,18 @@ unsigned PottsBasedCellPopulation<DIM>::GetNumSweepsPerTimestep()
     return mNumSweepsPerTimestep;
 }
 
+template<unsigned DIM>
+void PottsBasedCellPopulation<DIM>::SetUseLatticeEngine(bool useLatticeEngine)
+{
+    mUseLatticeEngine = useLatticeEngine;
+}
+
+template<unsigned DIM>
+bool PottsBasedCellPopulation<DIM>::GetUseLatticeEngine() const
+{
+    return mUseLatticeEngine;
+}
+
 template<unsigned DIM>
 void PottsBasedCellPopulation<DIM>::WriteVtkResultsToFile(const std::string& rDirectory)
 {
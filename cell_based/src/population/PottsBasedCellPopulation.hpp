@@ -38,6 +38,8 @@ OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include "AbstractOnLatticeCellPopulation.hpp"
 #include "PottsMesh.hpp"
+#include "PottsLatticeEngine.hpp"
+#include "LatticeCheckerboard.hpp"
 #include "VertexMesh.hpp"
 #include "AbstractUpdateRule.hpp"
 #include "MutableMesh.hpp"
@@ -91,6 +93,25 @@ private:
      */
     unsigned mNumSweepsPerTimestep;
 
+    /**
+     * Whether to perform Monte Carlo sweeps using a PottsLatticeEngine rather than by
+     * querying the mesh directly.  Initialised to false in the constructor.  This is
+     * a performance option that does not change the results, so is not archived.
+     */
+    bool mUseLatticeEngine;
+
+    /**
+     * The lattice engine used for Monte Carlo sweeps if mUseLatticeEngine is true.
+     * Created on first use and owned by this class.
+     */
+    PottsLatticeEngine<DIM>* mpLatticeEngine;
+
+    /**
+     * The checkerboard used for parallel Monte Carlo sweeps if the number of checkerboard
+     * partitions is non-zero.  Created on first use and owned by this class.
+     */
+    LatticeCheckerboard<DIM>* mpCheckerboard;
+
     friend class boost::serialization::access;
     /**
      * Serialize the object and its member variables.
@@ -136,6 +157,43 @@ private:
      */
     virtual void WriteVtkResultsToFile(const std::string& rDirectory);
 
+    /**
+     * Perform the Monte Carlo sweeps of UpdateCellLocations() using the lattice engine.
+     *
+     * This makes the same random choices as the sweep over the mesh, and so gives
+     * identical results, but reads site owners, neighbours, volumes and surface areas
+     * from the flat arrays of the engine.
+     */
+    void UpdateCellLocationsOnLattice();
+
+    /**
+     * Create the lattice engine, or bring it up to date with the mesh.
+     */
+    void SetUpLatticeEngine();
+
+    /**
+     * Perform the Monte Carlo sweeps of UpdateCellLocations() in parallel over a checkerboard
+     * of the lattice (see SetNumCheckerboardPartitions()).
+     *
+     * Each sweep visits every site once, a colour at a time.  Flips are proposed concurrently
+     * for all sites of a colour, using the lattice as it was at the start of that colour, and
+     * accepted flips are then applied in site order.  Since no two sites of a colour are
+     * neighbours, the only approximation relative to a serial sweep is that element volumes
+     * and surface areas are not updated between flips of the same colour.  If nodes are to be
+     * updated in random order, the colours are visited in a random order each sweep.
+     */
+    void UpdateCellLocationsOnCheckerboard();
+
+    /**
+     * Propose Monte Carlo flips for the sites of one colour and partition of the checkerboard.
+     * Does not change the cell population, so may be called concurrently for different partitions.
+     *
+     * @param colour  the colour of the checkerboard
+     * @param partition  the partition of the checkerboard
+     * @param rMoves  filled with the (site, new owner) pairs of the accepted flips
+     */
+    void ProposeCheckerboardMoves(unsigned colour, unsigned partition, std::vector<std::pair<unsigned, unsigned> >& rMoves);
+
 public:
 
     /**
@@ -386,6 +444,18 @@ public:
      */
     unsigned GetNumSweepsPerTimestep();
 
+    /**
+     * Set mUseLatticeEngine.
+     *
+     * @param useLatticeEngine whether to perform Monte Carlo sweeps using a PottsLatticeEngine
+     */
+    void SetUseLatticeEngine(bool useLatticeEngine=true);
+
+    /**
+     * @return mUseLatticeEngine
+     */
+    bool GetUseLatticeEngine() const;
+
     /**
      * Create a Element tessellation of the mesh for use in visualising the mesh.
      */
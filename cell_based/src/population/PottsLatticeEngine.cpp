@@ -0,0 +1,146 @@
+/*
+
+Copyright (c) 2005-2017, University of Oxford.
+All rights reserved.
+
+University of Oxford means the Chancellor, Masters and Scholars of the
+University of Oxford, having an administrative office at Wellington
+Square, Oxford OX1 2JD, UK.
+
+This file is part of Chaste.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+ * Redistributions of source code must retain the above copyright notice,
+   this list of conditions and the following disclaimer.
+ * Redistributions in binary form must reproduce the above copyright notice,
+   this list of conditions and the following disclaimer in the documentation
+   and/or other materials provided with the distribution.
+ * Neither the name of the University of Oxford nor the names of its
+   contributors may be used to endorse or promote products derived from this
+   software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+*/
+
+
+#include "PottsLatticeEngine.hpp"
+
+template<unsigned DIM>
+PottsLatticeEngine<DIM>::PottsLatticeEngine(PottsMesh<DIM>& rMesh)
+    : mrMesh(rMesh)
+{
+    SetUp();
+}
+
+template<unsigned DIM>
+void PottsLatticeEngine<DIM>::SetUpNeighbours()
+{
+    unsigned num_sites = mrMesh.GetNumNodes();
+
+    mMooreNeighbourStarts.resize(num_sites + 1);
+    mVonNeumannNeighbourStarts.resize(num_sites + 1);
+    mMooreNeighbours.clear();
+    mVonNeumannNeighbours.clear();
+    mMooreNeighbourStarts[0] = 0;
+    mVonNeumannNeighbourStarts[0] = 0;
+
+    for (unsigned site_index=0; site_index<num_sites; site_index++)
+    {
+        // Sets iterate in increasing order
+        std::set<unsigned> moore_neighbours = mrMesh.GetMooreNeighbouringNodeIndices(site_index);
+        mMooreNeighbours.insert(mMooreNeighbours.end(), moore_neighbours.begin(), moore_neighbours.end());
+        mMooreNeighbourStarts[site_index+1] = mMooreNeighbours.size();
+
+        std::set<unsigned> von_neumann_neighbours = mrMesh.GetVonNeumannNeighbouringNodeIndices(site_index);
+        mVonNeumannNeighbours.insert(mVonNeumannNeighbours.end(), von_neumann_neighbours.begin(), von_neumann_neighbours.end());
+        mVonNeumannNeighbourStarts[site_index+1] = mVonNeumannNeighbours.size();
+    }
+}
+
+template<unsigned DIM>
+void PottsLatticeEngine<DIM>::SetUp()
+{
+    unsigned num_sites = mrMesh.GetNumNodes();
+    if (mMooreNeighbourStarts.size() != num_sites + 1)
+    {
+        SetUpNeighbours();
+    }
+
+    // Site owners
+    mSiteOwners.assign(num_sites, UNSIGNED_UNSET);
+    unsigned num_elements = mrMesh.GetNumAllElements();
+    for (unsigned elem_index=0; elem_index<num_elements; elem_index++)
+    {
+        PottsElement<DIM>* p_element = mrMesh.GetElement(elem_index);
+        if (!p_element->IsDeleted())
+        {
+            for (unsigned local_index=0; local_index<p_element->GetNumNodes(); local_index++)
+            {
+                unsigned site_index = p_element->GetNodeGlobalIndex(local_index);
+                // Each node must be in at most one element
+                assert(mSiteOwners[site_index] == UNSIGNED_UNSET);
+                mSiteOwners[site_index] = elem_index;
+            }
+        }
+    }
+
+    // Element volumes and surface areas: each site contributes the faces it
+    // doesn't share with another site of its element
+    mElementVolumes.assign(num_elements, 0.0);
+    mElementSurfaceAreas.assign(num_elements, 0.0);
+    for (unsigned site_index=0; site_index<num_sites; site_index++)
+    {
+        unsigned owner = mSiteOwners[site_index];
+        if (owner != UNSIGNED_UNSET)
+        {
+            mElementVolumes[owner] += 1.0;
+            mElementSurfaceAreas[owner] += 2.0*DIM - CountVonNeumannNeighboursOwnedBy(site_index, owner);
+        }
+    }
+}
+
+template<unsigned DIM>
+void PottsLatticeEngine<DIM>::MoveSite(unsigned siteIndex, unsigned newOwner)
+{
+    unsigned old_owner = mSiteOwners[siteIndex];
+    assert(old_owner != newOwner);
+
+    /*
+     * Removing a site from an element loses its 2*DIM-n exposed faces but exposes the
+     * n faces of its neighbours in that element; adding it does the reverse.
+     */
+    if (old_owner != UNSIGNED_UNSET)
+    {
+        unsigned num_neighbours_in_old = CountVonNeumannNeighboursOwnedBy(siteIndex, old_owner);
+        mElementVolumes[old_owner] -= 1.0;
+        mElementSurfaceAreas[old_owner] += 2.0*num_neighbours_in_old - 2.0*DIM;
+
+        PottsElement<DIM>* p_element = mrMesh.GetElement(old_owner);
+        p_element->DeleteNode(p_element->GetNodeLocalIndex(siteIndex));
+    }
+    if (newOwner != UNSIGNED_UNSET)
+    {
+        unsigned num_neighbours_in_new = CountVonNeumannNeighboursOwnedBy(siteIndex, newOwner);
+        mElementVolumes[newOwner] += 1.0;
+        mElementSurfaceAreas[newOwner] += 2.0*DIM - 2.0*num_neighbours_in_new;
+
+        mrMesh.GetElement(newOwner)->AddNode(mrMesh.GetNode(siteIndex));
+    }
+    mSiteOwners[siteIndex] = newOwner;
+}
+
+// Explicit instantiation
+template class PottsLatticeEngine<1>;
+template class PottsLatticeEngine<2>;
+template class PottsLatticeEngine<3>;
@@ -0,0 +1,221 @@
+/*
+
+Copyright (c) 2005-2017, University of Oxford.
+All rights reserved.
+
+University of Oxford means the Chancellor, Masters and Scholars of the
+University of Oxford, having an administrative office at Wellington
+Square, Oxford OX1 2JD, UK.
+
+This file is part of Chaste.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+ * Redistributions of source code must retain the above copyright notice,
+   this list of conditions and the following disclaimer.
+ * Redistributions in binary form must reproduce the above copyright notice,
+   this list of conditions and the following disclaimer in the documentation
+   and/or other materials provided with the distribution.
+ * Neither the name of the University of Oxford nor the names of its
+   contributors may be used to endorse or promote products derived from this
+   software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+*/
+
+
+#ifndef POTTSLATTICEENGINE_HPP_
+#define POTTSLATTICEENGINE_HPP_
+
+#include <vector>
+#include <boost/utility.hpp>
+
+#include "PottsMesh.hpp"
+#include "Exception.hpp"
+
+/**
+ * A flat, lattice-structured view of a PottsMesh for fast Monte Carlo sweeps.
+ *
+ * The owning element of each lattice site (node) is held in a flat array, the
+ * Moore and von Neumann neighbours of each site are held in flat (compressed row)
+ * arrays, and the volume and surface area of each element are cached and updated
+ * incrementally as sites change owner.  This avoids the std::set copies made when
+ * querying the PottsMesh directly.
+ *
+ * Neighbour lists are stored in increasing index order, i.e. the order of the
+ * neighbour sets held by the mesh, so that sweeps using this class make the same
+ * random choices as those querying the mesh.
+ *
+ * The mesh is kept in step with the lattice: MoveSite() updates the elements of
+ * the mesh as well as the cached data.  Any other change to the mesh (e.g. a cell
+ * division) requires SetUp() to be called again.
+ */
+template<unsigned DIM>
+class PottsLatticeEngine : private boost::noncopyable
+{
+private:
+
+    /** The mesh viewed by this lattice. */
+    PottsMesh<DIM>& mrMesh;
+
+    /** The index of the element owning each site, or UNSIGNED_UNSET if the site is medium. */
+    std::vector<unsigned> mSiteOwners;
+
+    /** Offsets into #mMooreNeighbours for each site, plus one past the end. */
+    std::vector<unsigned> mMooreNeighbourStarts;
+
+    /** The Moore neighbours of each site, in increasing index order. */
+    std::vector<unsigned> mMooreNeighbours;
+
+    /** Offsets into #mVonNeumannNeighbours for each site, plus one past the end. */
+    std::vector<unsigned> mVonNeumannNeighbourStarts;
+
+    /** The von Neumann neighbours of each site, in increasing index order. */
+    std::vector<unsigned> mVonNeumannNeighbours;
+
+    /** The volume (number of sites) of each element. */
+    std::vector<double> mElementVolumes;
+
+    /** The surface area of each element, as computed by PottsMesh::GetSurfaceAreaOfElement(). */
+    std::vector<double> mElementSurfaceAreas;
+
+    /**
+     * Build the flat neighbour lists from the mesh.
+     */
+    void SetUpNeighbours();
+
+public:
+
+    /**
+     * Constructor.  Calls SetUp().
+     *
+     * @param rMesh  the mesh to view
+     */
+    PottsLatticeEngine(PottsMesh<DIM>& rMesh);
+
+    /**
+     * (Re)build the site owners and cached element volumes and surface areas from the mesh,
+     * and the neighbour lists if the number of sites has changed.
+     */
+    void SetUp();
+
+    /**
+     * @return the number of lattice sites.
+     */
+    unsigned GetNumSites() const
+    {
+        return mSiteOwners.size();
+    }
+
+    /**
+     * @return the index of the element owning a site, or UNSIGNED_UNSET if the site is medium.
+     *
+     * @param siteIndex  the site (node) index
+     */
+    unsigned GetSiteOwner(unsigned siteIndex) const
+    {
+        return mSiteOwners[siteIndex];
+    }
+
+    /**
+     * @return the number of Moore neighbours of a site.
+     *
+     * @param siteIndex  the site (node) index
+     */
+    unsigned GetNumMooreNeighbours(unsigned siteIndex) const
+    {
+        return mMooreNeighbourStarts[siteIndex+1] - mMooreNeighbourStarts[siteIndex];
+    }
+
+    /**
+     * @return the i-th Moore neighbour of a site, in increasing index order.
+     *
+     * @param siteIndex  the site (node) index
+     * @param i  which neighbour
+     */
+    unsigned GetMooreNeighbour(unsigned siteIndex, unsigned i) const
+    {
+        return mMooreNeighbours[mMooreNeighbourStarts[siteIndex] + i];
+    }
+
+    /**
+     * @return the number of von Neumann neighbours of a site.
+     *
+     * @param siteIndex  the site (node) index
+     */
+    unsigned GetNumVonNeumannNeighbours(unsigned siteIndex) const
+    {
+        return mVonNeumannNeighbourStarts[siteIndex+1] - mVonNeumannNeighbourStarts[siteIndex];
+    }
+
+    /**
+     * @return the i-th von Neumann neighbour of a site, in increasing index order.
+     *
+     * @param siteIndex  the site (node) index
+     * @param i  which neighbour
+     */
+    unsigned GetVonNeumannNeighbour(unsigned siteIndex, unsigned i) const
+    {
+        return mVonNeumannNeighbours[mVonNeumannNeighbourStarts[siteIndex] + i];
+    }
+
+    /**
+     * @return the number of von Neumann neighbours of a site owned by the given element.
+     *
+     * @param siteIndex  the site (node) index
+     * @param owner  the element index (or UNSIGNED_UNSET for medium)
+     */
+    unsigned CountVonNeumannNeighboursOwnedBy(unsigned siteIndex, unsigned owner) const
+    {
+        unsigned count = 0;
+        for (unsigned i=mVonNeumannNeighbourStarts[siteIndex]; i<mVonNeumannNeighbourStarts[siteIndex+1]; i++)
+        {
+            if (mSiteOwners[mVonNeumannNeighbours[i]] == owner)
+            {
+                count++;
+            }
+        }
+        return count;
+    }
+
+    /**
+     * @return the cached volume of an element.
+     *
+     * @param elementIndex  the element index
+     */
+    double GetElementVolume(unsigned elementIndex) const
+    {
+        return mElementVolumes[elementIndex];
+    }
+
+    /**
+     * @return the cached surface area of an element.
+     *
+     * @param elementIndex  the element index
+     */
+    double GetElementSurfaceArea(unsigned elementIndex) const
+    {
+        return mElementSurfaceAreas[elementIndex];
+    }
+
+    /**
+     * Move a site to a new owner, updating the cached element volumes and surface areas
+     * and the elements of the mesh.
+     *
+     * @param siteIndex  the site (node) index
+     * @param newOwner  the index of the new owning element, or UNSIGNED_UNSET for medium
+     */
+    void MoveSite(unsigned siteIndex, unsigned newOwner);
+};
+
+#endif /*POTTSLATTICEENGINE_HPP_*/
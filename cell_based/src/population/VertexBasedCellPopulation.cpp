@@ -156,7 +156,7 @@ unsigned VertexBasedCellPopulation<DIM>::GetNumNodes()
 template<unsigned DIM>
 c_vector<double, DIM> VertexBasedCellPopulation<DIM>::GetLocationOfCellCentre(CellPtr pCell)
 {
-    return mpMutableVertexMesh->GetCentroidOfElement(this->mCellLocationMap[pCell.get()]);
+    return mpMutableVertexMesh->GetCentroidOfElement(this->GetLocationIndexUsingCell(pCell));
 }
 
 template<unsigned DIM>
@@ -214,7 +214,6 @@ CellPtr VertexBasedCellPopulation<DIM>::AddCell(CellPtr pNewCell, CellPtr pParen
     // Update location cell map
     CellPtr p_created_cell = this->mCells.back();
     this->SetCellUsingLocationIndex(new_element_index,p_created_cell);
-    this->mCellLocationMap[p_created_cell.get()] = new_element_index;
 
     return p_created_cell;
 }
@@ -235,15 +234,17 @@ unsigned VertexBasedCellPopulation<DIM>::RemoveDeadCells()
 
             // Remove the element from the mesh if it is not deleted yet
             ///\todo (#2489) this should cause an error - we should fix this!
-            if (!(this->GetElement(this->GetLocationIndexUsingCell((*it)))->IsDeleted()))
+            unsigned location_index = this->GetLocationIndexUsingCell((*it));
+            if (!(this->GetElement(location_index)->IsDeleted()))
             {
                 // This warning relies on the fact that there is only one other possibility for
                 // vertex elements to be marked as deleted: a T2 swap
                 WARN_ONCE_ONLY("A Cell is removed without performing a T2 swap. This could leave a void in the mesh.");
-                mpMutableVertexMesh->DeleteElementPriorToReMesh(this->GetLocationIndexUsingCell((*it)));
+                mpMutableVertexMesh->DeleteElementPriorToReMesh(location_index);
             }
 
             // Delete the cell
+            this->RemoveCellUsingLocationIndex(location_index, (*it));
             it = this->mCells.erase(it);
         }
         else
@@ -288,23 +289,7 @@ void VertexBasedCellPopulation<DIM>::Update(bool hasHadBirthsOrDeaths)
     if (!element_map.IsIdentityMap())
     {
         // Fix up the mappings between CellPtrs and VertexElements
-        ///\todo We want to make these maps private, so we need a better way of doing the code below.
-        std::map<Cell*, unsigned> old_map = this->mCellLocationMap;
-
-        this->mCellLocationMap.clear();
-        this->mLocationCellMap.clear();
-
-        for (std::list<CellPtr>::iterator cell_iter = this->mCells.begin();
-             cell_iter != this->mCells.end();
-             ++cell_iter)
-        {
-            // The cell vector should only ever contain living cells
-            unsigned old_elem_index = old_map[(*cell_iter).get()];
-            assert(!element_map.IsDeleted(old_elem_index));
-
-            unsigned new_elem_index = element_map.GetNewIndex(old_elem_index);
-            this->SetCellUsingLocationIndex(new_elem_index, *cell_iter);
-        }
+        this->mCellLocationIndexMap.UpdateLocationIndices(element_map);
 
         // Check that each VertexElement has only one CellPtr associated with it in the updated cell population
         Validate();
@@ -39,7 +39,9 @@ template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
 AbstractTwoBodyInteractionForce<ELEMENT_DIM,SPACE_DIM>::AbstractTwoBodyInteractionForce()
    : AbstractForce<ELEMENT_DIM,SPACE_DIM>(),
      mUseCutOffLength(false),
-     mMechanicsCutOffLength(DBL_MAX)
+     mMechanicsCutOffLength(DBL_MAX),
+     mUseBatchedForceCalculation(false),
+     mNumBatchThreads(1)
 {
 }
 
@@ -63,6 +65,55 @@ double AbstractTwoBodyInteractionForce<ELEMENT_DIM,SPACE_DIM>::GetCutOffLength()
     return mMechanicsCutOffLength;
 }
 
+template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+void AbstractTwoBodyInteractionForce<ELEMENT_DIM,SPACE_DIM>::SetUseBatchedForceCalculation(bool useBatchedForceCalculation)
+{
+    mUseBatchedForceCalculation = useBatchedForceCalculation;
+}
+
+template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+bool AbstractTwoBodyInteractionForce<ELEMENT_DIM,SPACE_DIM>::GetUseBatchedForceCalculation() const
+{
+    return mUseBatchedForceCalculation;
+}
+
+template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+void AbstractTwoBodyInteractionForce<ELEMENT_DIM,SPACE_DIM>::SetNumBatchThreads(unsigned numBatchThreads)
+{
+    if (numBatchThreads == 0)
+    {
+        EXCEPTION("The number of batch threads must be at least one.");
+    }
+    mNumBatchThreads = numBatchThreads;
+}
+
+template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+unsigned AbstractTwoBodyInteractionForce<ELEMENT_DIM,SPACE_DIM>::GetNumBatchThreads() const
+{
+    return mNumBatchThreads;
+}
+
+template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+void AbstractTwoBodyInteractionForce<ELEMENT_DIM,SPACE_DIM>::CalculateForcesOnBatch(TwoBodyInteractionBatch<ELEMENT_DIM,SPACE_DIM>& rBatch,
+                                                                                   AbstractCellPopulation<ELEMENT_DIM,SPACE_DIM>& rCellPopulation)
+{
+    std::vector<double>& r_forces = rBatch.rGetForces();
+    for (unsigned pair_index=0; pair_index<rBatch.GetNumPairs(); pair_index++)
+    {
+        if (rBatch.IsPairActive(pair_index))
+        {
+            unsigned node_a_index = rBatch.GetNode(rBatch.GetPairNodeA(pair_index))->GetIndex();
+            unsigned node_b_index = rBatch.GetNode(rBatch.GetPairNodeB(pair_index))->GetIndex();
+
+            c_vector<double, SPACE_DIM> force = CalculateForceBetweenNodes(node_a_index, node_b_index, rCellPopulation);
+            for (unsigned i=0; i<SPACE_DIM; i++)
+            {
+                r_forces[SPACE_DIM*pair_index + i] = force[i];
+            }
+        }
+    }
+}
+
 template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
 void AbstractTwoBodyInteractionForce<ELEMENT_DIM,SPACE_DIM>::AddForceContribution(AbstractCellPopulation<ELEMENT_DIM,SPACE_DIM>& rCellPopulation)
 {
@@ -72,8 +123,15 @@ void AbstractTwoBodyInteractionForce<ELEMENT_DIM,SPACE_DIM>::AddForceContributio
         EXCEPTION("Subclasses of AbstractTwoBodyInteractionForce are to be used with subclasses of AbstractCentreBasedCellPopulation only");
     }
 
+    if (mUseBatchedForceCalculation)
+    {
+        TwoBodyInteractionBatch<ELEMENT_DIM,SPACE_DIM> batch(mNumBatchThreads);
+        batch.SetUp(*static_cast<AbstractCentreBasedCellPopulation<ELEMENT_DIM,SPACE_DIM>*>(&rCellPopulation));
+        CalculateForcesOnBatch(batch, rCellPopulation);
+        batch.AddForcesToNodes();
+    }
     ///\todo this could be tidied by using the rGetNodePairs for all populations and moving the below calculation into the MutableMesh.
-    if (bool(dynamic_cast<MeshBasedCellPopulation<ELEMENT_DIM,SPACE_DIM>*>(&rCellPopulation)))
+    else if (bool(dynamic_cast<MeshBasedCellPopulation<ELEMENT_DIM,SPACE_DIM>*>(&rCellPopulation)))
     {
         MeshBasedCellPopulation<ELEMENT_DIM,SPACE_DIM>* p_static_cast_cell_population = static_cast<MeshBasedCellPopulation<ELEMENT_DIM,SPACE_DIM>*>(&rCellPopulation);
 
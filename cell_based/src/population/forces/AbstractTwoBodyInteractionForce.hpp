@@ -39,6 +39,8 @@ OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "AbstractForce.hpp"
 #include "MeshBasedCellPopulation.hpp"
 #include "NodeBasedCellPopulation.hpp"
+#include "TwoBodyInteractionBatch.hpp"
+
 /**
  * An abstract class for two-body force laws.
  */
@@ -71,6 +73,34 @@ protected:
     /** Mechanics cut off length. */
     double mMechanicsCutOffLength;
 
+    /**
+     * Whether AddForceContribution() calculates the pair forces in a batch,
+     * using CalculateForcesOnBatch(). Defaults to false. Not archived.
+     */
+    bool mUseBatchedForceCalculation;
+
+    /**
+     * The number of threads over which the pairs of a batch are split.
+     * Defaults to 1. Not archived.
+     */
+    unsigned mNumBatchThreads;
+
+    /**
+     * Calculate the force between the nodes of each active pair in a batch,
+     * filling in rBatch.rGetForces(). Called by AddForceContribution() when
+     * batched force calculation is switched on.
+     *
+     * This default implementation calls CalculateForceBetweenNodes() for each
+     * pair. Subclasses may override it with a kernel working on the batch
+     * arrays directly; such a subclass must be overridden again by any of its
+     * own subclasses that change the force law.
+     *
+     * @param rBatch the gathered node pairs
+     * @param rCellPopulation the cell population
+     */
+    virtual void CalculateForcesOnBatch(TwoBodyInteractionBatch<ELEMENT_DIM,SPACE_DIM>& rBatch,
+                                        AbstractCellPopulation<ELEMENT_DIM,SPACE_DIM>& rCellPopulation);
+
 public:
 
     /**
@@ -100,6 +130,37 @@ public:
      */
     double GetCutOffLength();
 
+    /**
+     * Set whether to calculate the pair forces in a batch. The node and cell
+     * data of all interacting pairs are then gathered once into contiguous
+     * arrays, the forces are calculated by CalculateForcesOnBatch() and the
+     * results are reduced back onto the nodes.
+     *
+     * @param useBatchedForceCalculation whether to use batched force calculation (defaults to true)
+     */
+    void SetUseBatchedForceCalculation(bool useBatchedForceCalculation=true);
+
+    /**
+     * @return mUseBatchedForceCalculation
+     */
+    bool GetUseBatchedForceCalculation() const;
+
+    /**
+     * Set the number of threads over which to split the pairs when using
+     * batched force calculation. The forces are the same for any number of
+     * threads, but their sums on each node may differ in the last bits
+     * between different numbers of threads. Threads are only used if Chaste
+     * is built with OpenMP.
+     *
+     * @param numBatchThreads the number of threads (must be at least 1)
+     */
+    void SetNumBatchThreads(unsigned numBatchThreads);
+
+    /**
+     * @return mNumBatchThreads
+     */
+    unsigned GetNumBatchThreads() const;
+
     /**
      * Calculates the force between two nodes.
      *
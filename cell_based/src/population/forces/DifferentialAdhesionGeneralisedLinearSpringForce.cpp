@@ -86,6 +86,44 @@ double DifferentialAdhesionGeneralisedLinearSpringForce<ELEMENT_DIM, SPACE_DIM>:
     }
 }
 
+template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+void DifferentialAdhesionGeneralisedLinearSpringForce<ELEMENT_DIM, SPACE_DIM>::CalculateSpringConstantMultiplicationFactors(
+    TwoBodyInteractionBatch<ELEMENT_DIM, SPACE_DIM>& rBatch,
+    const std::vector<double>& rOverlaps,
+    std::vector<double>& rFactors,
+    AbstractCellPopulation<ELEMENT_DIM, SPACE_DIM>& rCellPopulation)
+{
+    // Determine which of the cells in the batch are labelled
+    std::vector<bool> is_labelled(rBatch.GetNumNodes());
+    for (unsigned local_index=0; local_index<rBatch.GetNumNodes(); local_index++)
+    {
+        is_labelled[local_index] = rBatch.GetCell(local_index)->template HasCellProperty<CellLabel>();
+    }
+
+    for (unsigned pair_index=0; pair_index<rBatch.GetNumPairs(); pair_index++)
+    {
+        bool cell_A_is_labelled = is_labelled[rBatch.GetPairNodeA(pair_index)];
+        bool cell_B_is_labelled = is_labelled[rBatch.GetPairNodeB(pair_index)];
+
+        if (rOverlaps[pair_index] <= 0)
+        {
+            rFactors[pair_index] = 1.0;
+        }
+        else if (cell_A_is_labelled != cell_B_is_labelled)
+        {
+            rFactors[pair_index] = mHeterotypicSpringConstantMultiplier;
+        }
+        else if (cell_A_is_labelled)
+        {
+            rFactors[pair_index] = mHomotypicLabelledSpringConstantMultiplier;
+        }
+        else
+        {
+            rFactors[pair_index] = 1.0;
+        }
+    }
+}
+
 template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
 double DifferentialAdhesionGeneralisedLinearSpringForce<ELEMENT_DIM, SPACE_DIM>::GetHomotypicLabelledSpringConstantMultiplier()
 {
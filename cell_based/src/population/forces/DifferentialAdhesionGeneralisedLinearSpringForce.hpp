@@ -92,6 +92,24 @@ private :
         archive & mHeterotypicSpringConstantMultiplier;
     }
 
+protected :
+
+    /**
+     * Overridden CalculateSpringConstantMultiplicationFactors() method.
+     *
+     * Looks up whether each cell in the batch is labelled once, rather than
+     * once for each of its springs.
+     *
+     * @param rBatch the gathered node pairs
+     * @param rOverlaps the overlap (distance minus rest length) of each pair
+     * @param rFactors the multiplication factor of each pair, to be filled in
+     * @param rCellPopulation the cell population
+     */
+    void CalculateSpringConstantMultiplicationFactors(TwoBodyInteractionBatch<ELEMENT_DIM,SPACE_DIM>& rBatch,
+                                                      const std::vector<double>& rOverlaps,
+                                                      std::vector<double>& rFactors,
+                                                      AbstractCellPopulation<ELEMENT_DIM,SPACE_DIM>& rCellPopulation);
+
 public :
 
     /**
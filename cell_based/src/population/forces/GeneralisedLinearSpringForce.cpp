@@ -116,6 +116,33 @@ c_vector<double, SPACE_DIM> GeneralisedLinearSpringForce<ELEMENT_DIM,SPACE_DIM>:
         }
     }
 
+    CellPtr p_cell_A = rCellPopulation.GetCellUsingLocationIndex(nodeAGlobalIndex);
+    CellPtr p_cell_B = rCellPopulation.GetCellUsingLocationIndex(nodeBGlobalIndex);
+
+    double rest_length_final;
+    double rest_length = CalculateRestLength(nodeAGlobalIndex, nodeBGlobalIndex, node_a_radius, node_b_radius,
+                                             p_cell_A, p_cell_B, rCellPopulation, rest_length_final);
+
+    // Although in this class the 'spring constant' is a constant parameter, in
+    // subclasses it can depend on properties of each of the cells
+    double overlap = distance_between_nodes - rest_length;
+    bool is_closer_than_rest_length = (overlap <= 0);
+    double multiplication_factor = VariableSpringConstantMultiplicationFactor(nodeAGlobalIndex, nodeBGlobalIndex, rCellPopulation, is_closer_than_rest_length);
+
+    bool is_mesh_based = bool(dynamic_cast<MeshBasedCellPopulation<ELEMENT_DIM,SPACE_DIM>*>(&rCellPopulation));
+    return CalculateForceFromOverlap(unit_difference, overlap, rest_length_final, multiplication_factor, is_mesh_based);
+}
+
+template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+double GeneralisedLinearSpringForce<ELEMENT_DIM,SPACE_DIM>::CalculateRestLength(unsigned nodeAGlobalIndex,
+                                                                               unsigned nodeBGlobalIndex,
+                                                                               double nodeARadius,
+                                                                               double nodeBRadius,
+                                                                               CellPtr pCellA,
+                                                                               CellPtr pCellB,
+                                                                               AbstractCellPopulation<ELEMENT_DIM,SPACE_DIM>& rCellPopulation,
+                                                                               double& rRestLengthFinal)
+{
     /*
      * Calculate the rest length of the spring connecting the two nodes with a default
      * value of 1.0.
@@ -128,17 +155,14 @@ c_vector<double, SPACE_DIM> GeneralisedLinearSpringForce<ELEMENT_DIM,SPACE_DIM>:
     }
     else if (bool(dynamic_cast<NodeBasedCellPopulation<SPACE_DIM>*>(&rCellPopulation)))
     {
-        assert(node_a_radius > 0 && node_b_radius > 0);
-        rest_length_final = node_a_radius+node_b_radius;
+        assert(nodeARadius > 0 && nodeBRadius > 0);
+        rest_length_final = nodeARadius+nodeBRadius;
     }
 
     double rest_length = rest_length_final;
 
-    CellPtr p_cell_A = rCellPopulation.GetCellUsingLocationIndex(nodeAGlobalIndex);
-    CellPtr p_cell_B = rCellPopulation.GetCellUsingLocationIndex(nodeBGlobalIndex);
-
-    double ageA = p_cell_A->GetAge();
-    double ageB = p_cell_B->GetAge();
+    double ageA = pCellA->GetAge();
+    double ageB = pCellB->GetAge();
 
     assert(!std::isnan(ageA));
     assert(!std::isnan(ageB));
@@ -151,7 +175,7 @@ c_vector<double, SPACE_DIM> GeneralisedLinearSpringForce<ELEMENT_DIM,SPACE_DIM>:
     {
         AbstractCentreBasedCellPopulation<ELEMENT_DIM,SPACE_DIM>* p_static_cast_cell_population = static_cast<AbstractCentreBasedCellPopulation<ELEMENT_DIM,SPACE_DIM>*>(&rCellPopulation);
 
-        std::pair<CellPtr,CellPtr> cell_pair = p_static_cast_cell_population->CreateCellPair(p_cell_A, p_cell_B);
+        std::pair<CellPtr,CellPtr> cell_pair = p_static_cast_cell_population->CreateCellPair(pCellA, pCellB);
 
         if (p_static_cast_cell_population->IsMarkedSpring(cell_pair))
         {
@@ -174,59 +198,162 @@ c_vector<double, SPACE_DIM> GeneralisedLinearSpringForce<ELEMENT_DIM,SPACE_DIM>:
 
     if (bool(dynamic_cast<NodeBasedCellPopulation<SPACE_DIM>*>(&rCellPopulation)))
     {
-        assert(node_a_radius > 0 && node_b_radius > 0);
-        a_rest_length = (node_a_radius/(node_a_radius+node_b_radius))*rest_length;
-        b_rest_length = (node_b_radius/(node_a_radius+node_b_radius))*rest_length;
+        assert(nodeARadius > 0 && nodeBRadius > 0);
+        a_rest_length = (nodeARadius/(nodeARadius+nodeBRadius))*rest_length;
+        b_rest_length = (nodeBRadius/(nodeARadius+nodeBRadius))*rest_length;
     }
 
     /*
      * If either of the cells has begun apoptosis, then the length of the spring
      * connecting them decreases linearly with time.
      */
-    if (p_cell_A->HasApoptosisBegun())
+    if (pCellA->HasApoptosisBegun())
     {
-        double time_until_death_a = p_cell_A->GetTimeUntilDeath();
-        a_rest_length = a_rest_length * time_until_death_a / p_cell_A->GetApoptosisTime();
+        double time_until_death_a = pCellA->GetTimeUntilDeath();
+        a_rest_length = a_rest_length * time_until_death_a / pCellA->GetApoptosisTime();
     }
-    if (p_cell_B->HasApoptosisBegun())
+    if (pCellB->HasApoptosisBegun())
     {
-        double time_until_death_b = p_cell_B->GetTimeUntilDeath();
-        b_rest_length = b_rest_length * time_until_death_b / p_cell_B->GetApoptosisTime();
+        double time_until_death_b = pCellB->GetTimeUntilDeath();
+        b_rest_length = b_rest_length * time_until_death_b / pCellB->GetApoptosisTime();
     }
 
     rest_length = a_rest_length + b_rest_length;
     //assert(rest_length <= 1.0+1e-12); ///\todo #1884 Magic number: would "<= 1.0" do?
 
-    // Although in this class the 'spring constant' is a constant parameter, in
-    // subclasses it can depend on properties of each of the cells
-    double overlap = distance_between_nodes - rest_length;
-    bool is_closer_than_rest_length = (overlap <= 0);
-    double multiplication_factor = VariableSpringConstantMultiplicationFactor(nodeAGlobalIndex, nodeBGlobalIndex, rCellPopulation, is_closer_than_rest_length);
+    rRestLengthFinal = rest_length_final;
+    return rest_length;
+}
+
+template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+c_vector<double, SPACE_DIM> GeneralisedLinearSpringForce<ELEMENT_DIM,SPACE_DIM>::CalculateForceFromOverlap(const c_vector<double, SPACE_DIM>& rUnitDifference,
+                                                                                                          double overlap,
+                                                                                                          double restLengthFinal,
+                                                                                                          double multiplicationFactor,
+                                                                                                          bool isMeshBased) const
+{
     double spring_stiffness = mMeinekeSpringStiffness;
 
-    if (bool(dynamic_cast<MeshBasedCellPopulation<ELEMENT_DIM,SPACE_DIM>*>(&rCellPopulation)))
+    if (isMeshBased)
     {
-        return multiplication_factor * spring_stiffness * unit_difference * overlap;
+        return multiplicationFactor * spring_stiffness * rUnitDifference * overlap;
     }
     else
     {
         // A reasonably stable simple force law
-        if (is_closer_than_rest_length) //overlap is negative
+        if (overlap <= 0) //overlap is negative
         {
             //log(x+1) is undefined for x<=-1
-            assert(overlap > -rest_length_final);
-            c_vector<double, SPACE_DIM> temp = multiplication_factor*spring_stiffness * unit_difference * rest_length_final* log(1.0 + overlap/rest_length_final);
+            assert(overlap > -restLengthFinal);
+            c_vector<double, SPACE_DIM> temp = multiplicationFactor*spring_stiffness * rUnitDifference * restLengthFinal* log(1.0 + overlap/restLengthFinal);
             return temp;
         }
         else
         {
             double alpha = 5.0;
-            c_vector<double, SPACE_DIM> temp = multiplication_factor*spring_stiffness * unit_difference * overlap * exp(-alpha * overlap/rest_length_final);
+            c_vector<double, SPACE_DIM> temp = multiplicationFactor*spring_stiffness * rUnitDifference * overlap * exp(-alpha * overlap/restLengthFinal);
             return temp;
         }
     }
 }
 
+template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+void GeneralisedLinearSpringForce<ELEMENT_DIM,SPACE_DIM>::CalculateSpringConstantMultiplicationFactors(TwoBodyInteractionBatch<ELEMENT_DIM,SPACE_DIM>& rBatch,
+                                                                                                      const std::vector<double>& rOverlaps,
+                                                                                                      std::vector<double>& rFactors,
+                                                                                                      AbstractCellPopulation<ELEMENT_DIM,SPACE_DIM>& rCellPopulation)
+{
+    for (unsigned pair_index=0; pair_index<rBatch.GetNumPairs(); pair_index++)
+    {
+        if (rBatch.IsPairActive(pair_index))
+        {
+            unsigned node_a_index = rBatch.GetNode(rBatch.GetPairNodeA(pair_index))->GetIndex();
+            unsigned node_b_index = rBatch.GetNode(rBatch.GetPairNodeB(pair_index))->GetIndex();
+            bool is_closer_than_rest_length = (rOverlaps[pair_index] <= 0);
+
+            rFactors[pair_index] = VariableSpringConstantMultiplicationFactor(node_a_index, node_b_index, rCellPopulation, is_closer_than_rest_length);
+        }
+    }
+}
+
+template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+void GeneralisedLinearSpringForce<ELEMENT_DIM,SPACE_DIM>::CalculateForcesOnBatch(TwoBodyInteractionBatch<ELEMENT_DIM,SPACE_DIM>& rBatch,
+                                                                                AbstractCellPopulation<ELEMENT_DIM,SPACE_DIM>& rCellPopulation)
+{
+    bool is_mesh_based = bool(dynamic_cast<MeshBasedCellPopulation<ELEMENT_DIM,SPACE_DIM>*>(&rCellPopulation));
+    bool is_node_based = bool(dynamic_cast<NodeBasedCellPopulation<SPACE_DIM>*>(&rCellPopulation));
+
+    unsigned num_pairs = rBatch.GetNumPairs();
+    const std::vector<double>& r_distances = rBatch.rGetDistances();
+    std::vector<double> rest_lengths_final(num_pairs, 1.0);
+    std::vector<double> overlaps(num_pairs, 0.0);
+
+    /*
+     * First pass: find the rest length of each spring with the same method as
+     * CalculateForceBetweenNodes(). This marks and unmarks springs between newly
+     * divided cells, so is done pair by pair on one thread.
+     */
+    for (unsigned pair_index=0; pair_index<num_pairs; pair_index++)
+    {
+        if (!rBatch.IsPairActive(pair_index))
+        {
+            continue;
+        }
+
+        double distance_between_nodes = r_distances[pair_index];
+        assert(distance_between_nodes > 0);
+        assert(!std::isnan(distance_between_nodes));
+
+        if (this->mUseCutOffLength && distance_between_nodes >= this->GetCutOffLength())
+        {
+            rBatch.DeactivatePair(pair_index);
+            continue;
+        }
+
+        unsigned node_a = rBatch.GetPairNodeA(pair_index);
+        unsigned node_b = rBatch.GetPairNodeB(pair_index);
+        double node_a_radius = is_node_based ? rBatch.GetRadius(node_a) : 0.0;
+        double node_b_radius = is_node_based ? rBatch.GetRadius(node_b) : 0.0;
+
+        double rest_length = CalculateRestLength(rBatch.GetNode(node_a)->GetIndex(), rBatch.GetNode(node_b)->GetIndex(),
+                                                 node_a_radius, node_b_radius, rBatch.GetCell(node_a), rBatch.GetCell(node_b),
+                                                 rCellPopulation, rest_lengths_final[pair_index]);
+        overlaps[pair_index] = distance_between_nodes - rest_length;
+    }
+
+    std::vector<double> factors(num_pairs, 1.0);
+    CalculateSpringConstantMultiplicationFactors(rBatch, overlaps, factors, rCellPopulation);
+
+    // Second pass: evaluate the force law over the contiguous arrays, one chunk of pairs per thread
+    const std::vector<double>& r_displacements = rBatch.rGetDisplacements();
+    std::vector<double>& r_forces = rBatch.rGetForces();
+    unsigned num_threads = rBatch.GetNumThreads();
+#ifdef CHASTE_OPENMP
+#pragma omp parallel for schedule(static, 1) num_threads(num_threads)
+#endif // CHASTE_OPENMP
+    for (int chunk=0; chunk<(int)num_threads; chunk++)
+    {
+        c_vector<double, SPACE_DIM> unit_difference;
+        for (unsigned pair_index=rBatch.GetPairChunkStart(chunk); pair_index<rBatch.GetPairChunkStart(chunk+1); pair_index++)
+        {
+            if (!rBatch.IsPairActive(pair_index))
+            {
+                continue;
+            }
+            for (unsigned i=0; i<SPACE_DIM; i++)
+            {
+                unit_difference[i] = r_displacements[SPACE_DIM*pair_index + i]/r_distances[pair_index];
+            }
+            c_vector<double, SPACE_DIM> force = CalculateForceFromOverlap(unit_difference, overlaps[pair_index], rest_lengths_final[pair_index],
+                                                                          factors[pair_index], is_mesh_based);
+            for (unsigned i=0; i<SPACE_DIM; i++)
+            {
+                r_forces[SPACE_DIM*pair_index + i] = force[i];
+            }
+        }
+    }
+}
+
 template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
 double GeneralisedLinearSpringForce<ELEMENT_DIM,SPACE_DIM>::GetMeinekeSpringStiffness()
 {
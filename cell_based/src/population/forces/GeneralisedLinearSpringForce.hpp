@@ -113,6 +113,82 @@ protected:
      */
     double mMeinekeSpringGrowthDuration;
 
+    /**
+     * Calculate the current rest length of the spring between two nodes, allowing for
+     * the growth of springs between newly divided cells and the shrinkage of springs
+     * to apoptotic cells. Springs between newly divided cells are unmarked once they
+     * are fully grown. Used by CalculateForceBetweenNodes() and CalculateForcesOnBatch().
+     *
+     * @param nodeAGlobalIndex index of one neighbouring node
+     * @param nodeBGlobalIndex index of the other neighbouring node
+     * @param nodeARadius the radius of node A (only used for a NodeBasedCellPopulation)
+     * @param nodeBRadius the radius of node B (only used for a NodeBasedCellPopulation)
+     * @param pCellA the cell associated with node A
+     * @param pCellB the cell associated with node B
+     * @param rCellPopulation the cell population
+     * @param rRestLengthFinal filled in with the rest length of the fully grown spring
+     * @return the rest length
+     */
+    double CalculateRestLength(unsigned nodeAGlobalIndex,
+                               unsigned nodeBGlobalIndex,
+                               double nodeARadius,
+                               double nodeBRadius,
+                               CellPtr pCellA,
+                               CellPtr pCellB,
+                               AbstractCellPopulation<ELEMENT_DIM,SPACE_DIM>& rCellPopulation,
+                               double& rRestLengthFinal);
+
+    /**
+     * Evaluate the force law for a spring. Used by CalculateForceBetweenNodes() and
+     * CalculateForcesOnBatch(); safe to call from several threads at once.
+     *
+     * @param rUnitDifference the unit vector from node A to node B
+     * @param overlap the distance between the nodes minus the rest length
+     * @param restLengthFinal the rest length of the fully grown spring
+     * @param multiplicationFactor the multiplication factor for the spring constant
+     * @param isMeshBased whether the cell population is a MeshBasedCellPopulation
+     * @return the force exerted on node A by node B
+     */
+    c_vector<double, SPACE_DIM> CalculateForceFromOverlap(const c_vector<double, SPACE_DIM>& rUnitDifference,
+                                                          double overlap,
+                                                          double restLengthFinal,
+                                                          double multiplicationFactor,
+                                                          bool isMeshBased) const;
+
+    /**
+     * Calculate the spring constant multiplication factor of each active pair
+     * in a batch. Called by CalculateForcesOnBatch().
+     *
+     * This default implementation calls VariableSpringConstantMultiplicationFactor()
+     * for each pair, so subclasses overriding only that method remain correct.
+     * Subclasses may override it to work on the batch directly.
+     *
+     * @param rBatch the gathered node pairs
+     * @param rOverlaps the overlap (distance minus rest length) of each pair
+     * @param rFactors the multiplication factor of each pair, to be filled in
+     * @param rCellPopulation the cell population
+     */
+    virtual void CalculateSpringConstantMultiplicationFactors(TwoBodyInteractionBatch<ELEMENT_DIM,SPACE_DIM>& rBatch,
+                                                              const std::vector<double>& rOverlaps,
+                                                              std::vector<double>& rFactors,
+                                                              AbstractCellPopulation<ELEMENT_DIM,SPACE_DIM>& rCellPopulation);
+
+    /**
+     * Overridden CalculateForcesOnBatch() method.
+     *
+     * Calculates the same forces as CalculateForceBetweenNodes(), using the same
+     * CalculateRestLength() and CalculateForceFromOverlap() methods, with the rest
+     * lengths found in a first pass over the pairs and the force law then
+     * evaluated over the contiguous batch arrays. Subclasses which override
+     * CalculateForceBetweenNodes() must also override this method, or not use
+     * batched force calculation.
+     *
+     * @param rBatch the gathered node pairs
+     * @param rCellPopulation the cell population
+     */
+    virtual void CalculateForcesOnBatch(TwoBodyInteractionBatch<ELEMENT_DIM,SPACE_DIM>& rBatch,
+                                        AbstractCellPopulation<ELEMENT_DIM,SPACE_DIM>& rCellPopulation);
+
 public:
 
     /**
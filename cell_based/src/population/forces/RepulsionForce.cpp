@@ -50,6 +50,26 @@ void RepulsionForce<DIM>::AddForceContribution(AbstractCellPopulation<DIM>& rCel
         EXCEPTION("RepulsionForce is to be used with a NodeBasedCellPopulation only");
     }
 
+    if (this->mUseBatchedForceCalculation)
+    {
+        TwoBodyInteractionBatch<DIM> batch(this->mNumBatchThreads);
+        batch.SetUp(*static_cast<NodeBasedCellPopulation<DIM>*>(&rCellPopulation));
+
+        // Only overlapping cells repel each other
+        for (unsigned pair_index=0; pair_index<batch.GetNumPairs(); pair_index++)
+        {
+            double rest_length = batch.GetRadius(batch.GetPairNodeA(pair_index)) + batch.GetRadius(batch.GetPairNodeB(pair_index));
+            if (batch.GetDistance(pair_index) >= rest_length)
+            {
+                batch.DeactivatePair(pair_index);
+            }
+        }
+
+        this->CalculateForcesOnBatch(batch, rCellPopulation);
+        batch.AddForcesToNodes();
+        return;
+    }
+
     std::vector< std::pair<Node<DIM>*, Node<DIM>* > >& r_node_pairs = (static_cast<NodeBasedCellPopulation<DIM>*>(&rCellPopulation))->rGetNodePairs();
 
     for (typename std::vector< std::pair<Node<DIM>*, Node<DIM>* > >::iterator iter = r_node_pairs.begin();
@@ -76,6 +76,9 @@ public :
     /**
      * Overridden AddForceContribution() method.
      *
+     * If batched force calculation is switched on, pairs of non-overlapping
+     * cells are deactivated before the batch is passed to CalculateForcesOnBatch().
+     *
      * @param rCellPopulation reference to the CellPopulation
      */
     void AddForceContribution(AbstractCellPopulation<DIM>& rCellPopulation);
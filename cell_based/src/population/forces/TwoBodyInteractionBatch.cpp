@@ -0,0 +1,323 @@
+/*
+
+Copyright (c) 2005-2017, University of Oxford.
+All rights reserved.
+
+University of Oxford means the Chancellor, Masters and Scholars of the
+University of Oxford, having an administrative office at Wellington
+Square, Oxford OX1 2JD, UK.
+
+This file is part of Chaste.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+ * Redistributions of source code must retain the above copyright notice,
+   this list of conditions and the following disclaimer.
+ * Redistributions in binary form must reproduce the above copyright notice,
+   this list of conditions and the following disclaimer in the documentation
+   and/or other materials provided with the distribution.
+ * Neither the name of the University of Oxford nor the names of its
+   contributors may be used to endorse or promote products derived from this
+   software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+*/
+
+#include "TwoBodyInteractionBatch.hpp"
+#include "MeshBasedCellPopulation.hpp"
+
+template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+TwoBodyInteractionBatch<ELEMENT_DIM,SPACE_DIM>::TwoBodyInteractionBatch(unsigned numThreads)
+    : mNumThreads(numThreads)
+{
+    assert(mNumThreads > 0);
+}
+
+template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+unsigned TwoBodyInteractionBatch<ELEMENT_DIM,SPACE_DIM>::GetNumThreads() const
+{
+    return mNumThreads;
+}
+
+template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+unsigned TwoBodyInteractionBatch<ELEMENT_DIM,SPACE_DIM>::GetPairChunkStart(unsigned chunk) const
+{
+    assert(chunk <= mNumThreads);
+    return (chunk*GetNumPairs())/mNumThreads;
+}
+
+template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+unsigned TwoBodyInteractionBatch<ELEMENT_DIM,SPACE_DIM>::AddNode(Node<SPACE_DIM>* pNode,
+                                                                 std::vector<unsigned>& rLocalIndices,
+                                                                 AbstractCellPopulation<ELEMENT_DIM,SPACE_DIM>& rCellPopulation)
+{
+    unsigned global_index = pNode->GetIndex();
+    if (global_index >= rLocalIndices.size())
+    {
+        rLocalIndices.resize(2*global_index + 1, UNSIGNED_UNSET);
+    }
+
+    if (rLocalIndices[global_index] == UNSIGNED_UNSET)
+    {
+        rLocalIndices[global_index] = mNodes.size();
+
+        mNodes.push_back(pNode);
+        mCells.push_back(rCellPopulation.GetCellUsingLocationIndex(global_index));
+        mRadii.push_back(pNode->GetRadius());
+    }
+    return rLocalIndices[global_index];
+}
+
+template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+void TwoBodyInteractionBatch<ELEMENT_DIM,SPACE_DIM>::SetUp(AbstractCentreBasedCellPopulation<ELEMENT_DIM,SPACE_DIM>& rCellPopulation)
+{
+    mNodes.clear();
+    mCells.clear();
+    mRadii.clear();
+    mPairNodes.clear();
+
+    // Collect the interacting pairs
+    std::vector<std::pair<Node<SPACE_DIM>*, Node<SPACE_DIM>*> > mesh_springs;
+    std::vector<std::pair<Node<SPACE_DIM>*, Node<SPACE_DIM>*> >* p_pairs = &mesh_springs;
+
+    if (bool(dynamic_cast<MeshBasedCellPopulation<ELEMENT_DIM,SPACE_DIM>*>(&rCellPopulation)))
+    {
+        MeshBasedCellPopulation<ELEMENT_DIM,SPACE_DIM>* p_mesh_population = static_cast<MeshBasedCellPopulation<ELEMENT_DIM,SPACE_DIM>*>(&rCellPopulation);
+
+        for (typename MeshBasedCellPopulation<ELEMENT_DIM,SPACE_DIM>::SpringIterator spring_iterator = p_mesh_population->SpringsBegin();
+             spring_iterator != p_mesh_population->SpringsEnd();
+             ++spring_iterator)
+        {
+            mesh_springs.push_back(std::make_pair(spring_iterator.GetNodeA(), spring_iterator.GetNodeB()));
+        }
+    }
+    else
+    {
+        p_pairs = &(rCellPopulation.rGetNodePairs());
+    }
+
+    unsigned num_pairs = p_pairs->size();
+    mPairNodes.reserve(2*num_pairs);
+    mDisplacements.resize(SPACE_DIM*num_pairs);
+    mDistances.resize(num_pairs);
+    mIsPairActive.assign(num_pairs, true);
+    mForces.assign(SPACE_DIM*num_pairs, 0.0);
+
+    // Gather each node and its cell once
+    std::vector<unsigned> local_indices;
+    for (unsigned pair_index=0; pair_index<num_pairs; pair_index++)
+    {
+        mPairNodes.push_back(AddNode((*p_pairs)[pair_index].first, local_indices, rCellPopulation));
+        mPairNodes.push_back(AddNode((*p_pairs)[pair_index].second, local_indices, rCellPopulation));
+    }
+
+    // Find the displacement of each pair, one chunk of pairs per thread
+#ifdef CHASTE_OPENMP
+#pragma omp parallel for schedule(static, 1) num_threads(mNumThreads)
+#endif // CHASTE_OPENMP
+    for (int chunk=0; chunk<(int)mNumThreads; chunk++)
+    {
+        for (unsigned pair_index=GetPairChunkStart(chunk); pair_index<GetPairChunkStart(chunk+1); pair_index++)
+        {
+            // GetVectorFromAtoB() is used so that periodic meshes are handled correctly
+            c_vector<double, SPACE_DIM> displacement = rCellPopulation.rGetMesh().GetVectorFromAtoB(mNodes[mPairNodes[2*pair_index]]->rGetLocation(),
+                                                                                                    mNodes[mPairNodes[2*pair_index + 1]]->rGetLocation());
+            for (unsigned i=0; i<SPACE_DIM; i++)
+            {
+                mDisplacements[SPACE_DIM*pair_index + i] = displacement[i];
+            }
+            mDistances[pair_index] = norm_2(displacement);
+        }
+    }
+}
+
+template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+unsigned TwoBodyInteractionBatch<ELEMENT_DIM,SPACE_DIM>::GetNumNodes() const
+{
+    return mNodes.size();
+}
+
+template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+unsigned TwoBodyInteractionBatch<ELEMENT_DIM,SPACE_DIM>::GetNumPairs() const
+{
+    return mDistances.size();
+}
+
+template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+Node<SPACE_DIM>* TwoBodyInteractionBatch<ELEMENT_DIM,SPACE_DIM>::GetNode(unsigned localIndex) const
+{
+    assert(localIndex < mNodes.size());
+    return mNodes[localIndex];
+}
+
+template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+CellPtr TwoBodyInteractionBatch<ELEMENT_DIM,SPACE_DIM>::GetCell(unsigned localIndex) const
+{
+    assert(localIndex < mCells.size());
+    return mCells[localIndex];
+}
+
+template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+double TwoBodyInteractionBatch<ELEMENT_DIM,SPACE_DIM>::GetRadius(unsigned localIndex) const
+{
+    assert(localIndex < mRadii.size());
+    return mRadii[localIndex];
+}
+
+template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+unsigned TwoBodyInteractionBatch<ELEMENT_DIM,SPACE_DIM>::GetPairNodeA(unsigned pairIndex) const
+{
+    assert(pairIndex < GetNumPairs());
+    return mPairNodes[2*pairIndex];
+}
+
+template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+unsigned TwoBodyInteractionBatch<ELEMENT_DIM,SPACE_DIM>::GetPairNodeB(unsigned pairIndex) const
+{
+    assert(pairIndex < GetNumPairs());
+    return mPairNodes[2*pairIndex + 1];
+}
+
+template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+double TwoBodyInteractionBatch<ELEMENT_DIM,SPACE_DIM>::GetDistance(unsigned pairIndex) const
+{
+    assert(pairIndex < GetNumPairs());
+    return mDistances[pairIndex];
+}
+
+template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+const std::vector<double>& TwoBodyInteractionBatch<ELEMENT_DIM,SPACE_DIM>::rGetDistances() const
+{
+    return mDistances;
+}
+
+template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+const std::vector<double>& TwoBodyInteractionBatch<ELEMENT_DIM,SPACE_DIM>::rGetDisplacements() const
+{
+    return mDisplacements;
+}
+
+template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+bool TwoBodyInteractionBatch<ELEMENT_DIM,SPACE_DIM>::IsPairActive(unsigned pairIndex) const
+{
+    assert(pairIndex < GetNumPairs());
+    return mIsPairActive[pairIndex];
+}
+
+template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+void TwoBodyInteractionBatch<ELEMENT_DIM,SPACE_DIM>::DeactivatePair(unsigned pairIndex)
+{
+    assert(pairIndex < GetNumPairs());
+    mIsPairActive[pairIndex] = false;
+}
+
+template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+std::vector<double>& TwoBodyInteractionBatch<ELEMENT_DIM,SPACE_DIM>::rGetForces()
+{
+    return mForces;
+}
+
+template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+void TwoBodyInteractionBatch<ELEMENT_DIM,SPACE_DIM>::AddForcesToNodes()
+{
+    unsigned num_nodes = mNodes.size();
+
+    // Start from the force already applied to each node
+    std::vector<double> node_forces(SPACE_DIM*num_nodes);
+    for (unsigned local_index=0; local_index<num_nodes; local_index++)
+    {
+        const c_vector<double, SPACE_DIM>& r_applied_force = mNodes[local_index]->rGetAppliedForce();
+        for (unsigned i=0; i<SPACE_DIM; i++)
+        {
+            node_forces[SPACE_DIM*local_index + i] = r_applied_force[i];
+        }
+    }
+
+    if (mNumThreads == 1)
+    {
+        // Reduce the pair forces onto the nodes in pair order
+        for (unsigned pair_index=0; pair_index<GetNumPairs(); pair_index++)
+        {
+            if (mIsPairActive[pair_index])
+            {
+                unsigned offset_a = SPACE_DIM*mPairNodes[2*pair_index];
+                unsigned offset_b = SPACE_DIM*mPairNodes[2*pair_index + 1];
+                for (unsigned i=0; i<SPACE_DIM; i++)
+                {
+                    double force = mForces[SPACE_DIM*pair_index + i];
+                    assert(!std::isnan(force));
+                    node_forces[offset_a + i] += force;
+                    node_forces[offset_b + i] += -force;
+                }
+            }
+        }
+    }
+    else
+    {
+        // Reduce each chunk of pairs into its own buffer
+        std::vector<std::vector<double> > chunk_forces(mNumThreads);
+#ifdef CHASTE_OPENMP
+#pragma omp parallel for schedule(static, 1) num_threads(mNumThreads)
+#endif // CHASTE_OPENMP
+        for (int chunk=0; chunk<(int)mNumThreads; chunk++)
+        {
+            std::vector<double>& r_chunk_forces = chunk_forces[chunk];
+            r_chunk_forces.assign(SPACE_DIM*num_nodes, 0.0);
+
+            for (unsigned pair_index=GetPairChunkStart(chunk); pair_index<GetPairChunkStart(chunk+1); pair_index++)
+            {
+                if (mIsPairActive[pair_index])
+                {
+                    unsigned offset_a = SPACE_DIM*mPairNodes[2*pair_index];
+                    unsigned offset_b = SPACE_DIM*mPairNodes[2*pair_index + 1];
+                    for (unsigned i=0; i<SPACE_DIM; i++)
+                    {
+                        double force = mForces[SPACE_DIM*pair_index + i];
+                        assert(!std::isnan(force));
+                        r_chunk_forces[offset_a + i] += force;
+                        r_chunk_forces[offset_b + i] += -force;
+                    }
+                }
+            }
+        }
+
+        // Add the buffers to the nodes in chunk order
+        for (unsigned chunk=0; chunk<mNumThreads; chunk++)
+        {
+            for (unsigned j=0; j<SPACE_DIM*num_nodes; j++)
+            {
+                node_forces[j] += chunk_forces[chunk][j];
+            }
+        }
+    }
+
+    // Write the totals back
+    for (unsigned local_index=0; local_index<num_nodes; local_index++)
+    {
+        c_vector<double, SPACE_DIM> force;
+        for (unsigned i=0; i<SPACE_DIM; i++)
+        {
+            force[i] = node_forces[SPACE_DIM*local_index + i];
+        }
+        mNodes[local_index]->ClearAppliedForce();
+        mNodes[local_index]->AddAppliedForceContribution(force);
+    }
+}
+
+// Explicit instantiation
+template class TwoBodyInteractionBatch<1,1>;
+template class TwoBodyInteractionBatch<1,2>;
+template class TwoBodyInteractionBatch<2,2>;
+template class TwoBodyInteractionBatch<1,3>;
+template class TwoBodyInteractionBatch<2,3>;
+template class TwoBodyInteractionBatch<3,3>;
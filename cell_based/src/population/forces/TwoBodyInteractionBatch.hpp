@@ -0,0 +1,226 @@
+/*
+
+Copyright (c) 2005-2017, University of Oxford.
+All rights reserved.
+
+University of Oxford means the Chancellor, Masters and Scholars of the
+University of Oxford, having an administrative office at Wellington
+Square, Oxford OX1 2JD, UK.
+
+This file is part of Chaste.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+ * Redistributions of source code must retain the above copyright notice,
+   this list of conditions and the following disclaimer.
+ * Redistributions in binary form must reproduce the above copyright notice,
+   this list of conditions and the following disclaimer in the documentation
+   and/or other materials provided with the distribution.
+ * Neither the name of the University of Oxford nor the names of its
+   contributors may be used to endorse or promote products derived from this
+   software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+*/
+
+#ifndef TWOBODYINTERACTIONBATCH_HPP_
+#define TWOBODYINTERACTIONBATCH_HPP_
+
+#include <vector>
+#include <boost/utility.hpp>
+
+#include "AbstractCentreBasedCellPopulation.hpp"
+
+/**
+ * A structure-of-arrays copy of the interacting node pairs of a centre-based
+ * cell population, used by AbstractTwoBodyInteractionForce to calculate pair
+ * forces in a batch.
+ *
+ * SetUp() gathers each node taking part in an interaction once, together with
+ * its radius and the data of its cell, into contiguous arrays, and records each
+ * pair by the local (batch) indices of its nodes and its displacement. A force
+ * then fills in the force exerted on node A of each pair by node B, and
+ * AddForcesToNodes() reduces these back onto the nodes.
+ *
+ * The pairs may be split into contiguous chunks, one per thread. Since
+ * rGetNodePairs() lists the pairs of a NodeBasedCellPopulation box by box,
+ * each chunk covers a run of neighbouring boxes.
+ */
+template<unsigned ELEMENT_DIM, unsigned SPACE_DIM=ELEMENT_DIM>
+class TwoBodyInteractionBatch : private boost::noncopyable
+{
+private:
+
+    /** The number of threads over which the pairs are split. */
+    unsigned mNumThreads;
+
+    /** The nodes in the batch, indexed by local index. */
+    std::vector<Node<SPACE_DIM>*> mNodes;
+
+    /** The cells associated with the nodes in the batch, indexed by local index. */
+    std::vector<CellPtr> mCells;
+
+    /** The radii of the nodes in the batch, indexed by local index. */
+    std::vector<double> mRadii;
+
+    /** The local indices of the two nodes of each pair, stored consecutively. */
+    std::vector<unsigned> mPairNodes;
+
+    /** The displacement from node A to node B of each pair, SPACE_DIM entries per pair. */
+    std::vector<double> mDisplacements;
+
+    /** The distance between the nodes of each pair. */
+    std::vector<double> mDistances;
+
+    /** Whether each pair contributes to the node forces. */
+    std::vector<bool> mIsPairActive;
+
+    /** The force exerted on node A by node B of each pair, SPACE_DIM entries per pair. */
+    std::vector<double> mForces;
+
+    /**
+     * Add a node to the batch, if it is not already present.
+     *
+     * @param pNode the node
+     * @param rLocalIndices map from global node index to local index, updated as nodes are added
+     * @param rCellPopulation the cell population
+     *
+     * @return the local index of the node
+     */
+    unsigned AddNode(Node<SPACE_DIM>* pNode,
+                     std::vector<unsigned>& rLocalIndices,
+                     AbstractCellPopulation<ELEMENT_DIM,SPACE_DIM>& rCellPopulation);
+
+public:
+
+    /**
+     * Constructor. The batch is empty until SetUp() is called.
+     *
+     * @param numThreads the number of threads over which to split the pairs (defaults to 1)
+     */
+    TwoBodyInteractionBatch(unsigned numThreads=1);
+
+    /**
+     * @return the number of threads over which the pairs are split
+     */
+    unsigned GetNumThreads() const;
+
+    /**
+     * Get the index of the first pair in a chunk. The pairs of chunk c are
+     * those from GetPairChunkStart(c) up to, but excluding, GetPairChunkStart(c+1).
+     *
+     * @param chunk the chunk, from 0 to GetNumThreads() inclusive
+     * @return the index of the first pair in the chunk
+     */
+    unsigned GetPairChunkStart(unsigned chunk) const;
+
+    /**
+     * Gather the interacting node pairs of a cell population. For a
+     * MeshBasedCellPopulation these are the springs of the mesh; for other
+     * populations they are given by rGetNodePairs(). Any previous contents
+     * of the batch are discarded and every pair is active.
+     *
+     * @param rCellPopulation the cell population
+     */
+    void SetUp(AbstractCentreBasedCellPopulation<ELEMENT_DIM,SPACE_DIM>& rCellPopulation);
+
+    /**
+     * @return the number of distinct nodes in the batch
+     */
+    unsigned GetNumNodes() const;
+
+    /**
+     * @return the number of pairs in the batch
+     */
+    unsigned GetNumPairs() const;
+
+    /**
+     * @param localIndex the local index of a node
+     * @return the node
+     */
+    Node<SPACE_DIM>* GetNode(unsigned localIndex) const;
+
+    /**
+     * @param localIndex the local index of a node
+     * @return the cell associated with the node
+     */
+    CellPtr GetCell(unsigned localIndex) const;
+
+    /**
+     * @param localIndex the local index of a node
+     * @return the radius of the node
+     */
+    double GetRadius(unsigned localIndex) const;
+
+    /**
+     * @param pairIndex the index of a pair
+     * @return the local index of node A of the pair
+     */
+    unsigned GetPairNodeA(unsigned pairIndex) const;
+
+    /**
+     * @param pairIndex the index of a pair
+     * @return the local index of node B of the pair
+     */
+    unsigned GetPairNodeB(unsigned pairIndex) const;
+
+    /**
+     * @param pairIndex the index of a pair
+     * @return the distance between the nodes of the pair
+     */
+    double GetDistance(unsigned pairIndex) const;
+
+    /**
+     * @return the distances between the nodes of all pairs
+     */
+    const std::vector<double>& rGetDistances() const;
+
+    /**
+     * @return the displacements from node A to node B of all pairs, SPACE_DIM entries per pair
+     */
+    const std::vector<double>& rGetDisplacements() const;
+
+    /**
+     * @param pairIndex the index of a pair
+     * @return whether the pair contributes to the node forces
+     */
+    bool IsPairActive(unsigned pairIndex) const;
+
+    /**
+     * Exclude a pair from the reduction in AddForcesToNodes().
+     *
+     * @param pairIndex the index of a pair
+     */
+    void DeactivatePair(unsigned pairIndex);
+
+    /**
+     * @return the forces exerted on node A by node B of all pairs, SPACE_DIM
+     * entries per pair, to be filled in by a force
+     */
+    std::vector<double>& rGetForces();
+
+    /**
+     * Add the force of each active pair to its node A, and its negative to
+     * its node B.
+     *
+     * With one thread, contributions are summed in pair order, starting from
+     * the force already applied to each node, so the result is the same as
+     * calling Node::AddAppliedForceContribution() pair by pair. With more
+     * threads, each chunk of pairs is summed into its own buffer and the
+     * buffers are then added to each node in chunk order, so the result
+     * depends only on the number of threads.
+     */
+    void AddForcesToNodes();
+};
+
+#endif /*TWOBODYINTERACTIONBATCH_HPP_*/
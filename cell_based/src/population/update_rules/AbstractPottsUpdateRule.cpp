@@ -46,6 +46,15 @@ AbstractPottsUpdateRule<DIM>::~AbstractPottsUpdateRule()
 {
 }
 
+template<unsigned DIM>
+double AbstractPottsUpdateRule<DIM>::EvaluateHamiltonianContributionOnLattice(unsigned currentNodeIndex,
+                                                                             unsigned targetNodeIndex,
+                                                                             PottsBasedCellPopulation<DIM>& rCellPopulation,
+                                                                             const PottsLatticeEngine<DIM>& rLattice)
+{
+    return EvaluateHamiltonianContribution(currentNodeIndex, targetNodeIndex, rCellPopulation);
+}
+
 template<unsigned DIM>
 void AbstractPottsUpdateRule<DIM>::OutputUpdateRuleParameters(out_stream& rParamsFile)
 {
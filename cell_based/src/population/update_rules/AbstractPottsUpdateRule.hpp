@@ -38,6 +38,7 @@ OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include "AbstractUpdateRule.hpp"
 #include "PottsBasedCellPopulation.hpp"
+#include "PottsLatticeEngine.hpp"
 
 template<unsigned DIM>
 class PottsBasedCellPopulation; // Circular definition
@@ -92,6 +93,28 @@ public:
                                                    unsigned targetNodeIndex,
                                                    PottsBasedCellPopulation<DIM>& rCellPopulation)=0;
 
+    /**
+     * Calculate the contribution to the Hamiltonian using the flat lattice data held by a
+     * PottsLatticeEngine.  This is called instead of EvaluateHamiltonianContribution() when
+     * the cell population uses its lattice engine (see PottsBasedCellPopulation::SetUseLatticeEngine()).
+     *
+     * The default implementation just calls EvaluateHamiltonianContribution(), which is correct
+     * since the engine keeps the mesh up to date; subclasses may override it to use the cached
+     * site owners, neighbours, volumes and surface areas instead of querying the mesh.
+     *
+     * @param currentNodeIndex The index of the current node/lattice site
+     * @param targetNodeIndex The index of the target node/lattice site
+     * @param rCellPopulation The cell population
+     * @param rLattice The lattice engine of the cell population
+     *
+     * @return The difference in the Hamiltonian with the configuration of the target node
+     * having the same spin as the current node with the current configuration. i.e H_1-H_0
+     */
+    virtual double EvaluateHamiltonianContributionOnLattice(unsigned currentNodeIndex,
+                                                            unsigned targetNodeIndex,
+                                                            PottsBasedCellPopulation<DIM>& rCellPopulation,
+                                                            const PottsLatticeEngine<DIM>& rLattice);
+
     /**
      * Overridden OutputUpdateRuleParameters() method.
      *
@@ -151,6 +151,74 @@ double AdhesionPottsUpdateRule<DIM>::EvaluateHamiltonianContribution(unsigned cu
     return delta_H;
 }
 
+template<unsigned DIM>
+double AdhesionPottsUpdateRule<DIM>::EvaluateHamiltonianContributionOnLattice(unsigned currentNodeIndex,
+                                                                             unsigned targetNodeIndex,
+                                                                             PottsBasedCellPopulation<DIM>& rCellPopulation,
+                                                                             const PottsLatticeEngine<DIM>& rLattice)
+{
+    unsigned current_element = rLattice.GetSiteOwner(currentNodeIndex);
+    unsigned target_element = rLattice.GetSiteOwner(targetNodeIndex);
+
+    bool current_node_contained = (current_element != UNSIGNED_UNSET);
+    bool target_node_contained = (target_element != UNSIGNED_UNSET);
+
+    if (!current_node_contained && !target_node_contained)
+    {
+        EXCEPTION("At least one of the current node or target node must be in an element.");
+    }
+
+    if (current_element == target_element)
+    {
+        EXCEPTION("The current node and target node must not be in the same element.");
+    }
+
+    // Iterate over nodes neighbouring the target node to work out the contact energy contribution
+    double delta_H = 0.0;
+    unsigned num_neighbours = rLattice.GetNumVonNeumannNeighbours(targetNodeIndex);
+    for (unsigned i=0; i<num_neighbours; i++)
+    {
+        unsigned neighbour_element = rLattice.GetSiteOwner(rLattice.GetVonNeumannNeighbour(targetNodeIndex, i));
+        bool neighbouring_node_contained = (neighbour_element != UNSIGNED_UNSET);
+
+        // Contribution before the move (H_0), as in EvaluateHamiltonianContribution()
+        if (neighbouring_node_contained && target_node_contained)
+        {
+            if (target_element != neighbour_element)
+            {
+                delta_H -= GetCellCellAdhesionEnergy(rCellPopulation.GetCellUsingLocationIndex(target_element), rCellPopulation.GetCellUsingLocationIndex(neighbour_element));
+            }
+        }
+        else if (neighbouring_node_contained && !target_node_contained)
+        {
+            delta_H -= GetCellBoundaryAdhesionEnergy(rCellPopulation.GetCellUsingLocationIndex(neighbour_element));
+        }
+        else if (!neighbouring_node_contained && target_node_contained)
+        {
+            delta_H -= GetCellBoundaryAdhesionEnergy(rCellPopulation.GetCellUsingLocationIndex(target_element));
+        }
+
+        // Contribution after the move (H_1)
+        if (neighbouring_node_contained && current_node_contained)
+        {
+            if (current_element != neighbour_element)
+            {
+                delta_H += GetCellCellAdhesionEnergy(rCellPopulation.GetCellUsingLocationIndex(current_element), rCellPopulation.GetCellUsingLocationIndex(neighbour_element));
+            }
+        }
+        else if (neighbouring_node_contained && !current_node_contained)
+        {
+            delta_H += GetCellBoundaryAdhesionEnergy(rCellPopulation.GetCellUsingLocationIndex(neighbour_element));
+        }
+        else if (!neighbouring_node_contained && current_node_contained)
+        {
+            delta_H += GetCellBoundaryAdhesionEnergy(rCellPopulation.GetCellUsingLocationIndex(current_element));
+        }
+    }
+
+    return delta_H;
+}
+
 template<unsigned DIM>
 double AdhesionPottsUpdateRule<DIM>::GetCellCellAdhesionEnergy(CellPtr pCellA, CellPtr pCellB)
 {
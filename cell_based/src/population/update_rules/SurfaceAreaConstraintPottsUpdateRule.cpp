@@ -172,6 +172,62 @@ double SurfaceAreaConstraintPottsUpdateRule<DIM>::EvaluateHamiltonianContributio
     return delta_H;
 }
 
+template<unsigned DIM>
+double SurfaceAreaConstraintPottsUpdateRule<DIM>::EvaluateHamiltonianContributionOnLattice(unsigned currentNodeIndex,
+                                                                                          unsigned targetNodeIndex,
+                                                                                          PottsBasedCellPopulation<DIM>& rCellPopulation,
+                                                                                          const PottsLatticeEngine<DIM>& rLattice)
+{
+    double delta_H = 0.0;
+
+    // This method only works in 2D and 3D at present
+    assert(DIM == 2 || DIM == 3); // LCOV_EXCL_LINE
+
+    unsigned current_element = rLattice.GetSiteOwner(currentNodeIndex);
+    unsigned target_element = rLattice.GetSiteOwner(targetNodeIndex);
+
+    bool current_node_contained = (current_element != UNSIGNED_UNSET);
+    bool target_node_contained = (target_element != UNSIGNED_UNSET);
+
+    if (!current_node_contained && !target_node_contained)
+    {
+        EXCEPTION("At least one of the current node or target node must be in an element.");
+    }
+
+    if (current_element == target_element)
+    {
+        EXCEPTION("The current node and target node must not be in the same element.");
+    }
+
+    /*
+     * Each face of the target site shared with the current element stops being part of
+     * its surface, and each face shared with the target element becomes part of it,
+     * so the changes are 2*DIM-2n and 2n-2*DIM as in EvaluateHamiltonianContribution().
+     */
+    if (current_node_contained) // current node is in an element
+    {
+        unsigned neighbours_in_same_element_as_current_node = rLattice.CountVonNeumannNeighboursOwnedBy(targetNodeIndex, current_element);
+        assert(neighbours_in_same_element_as_current_node <= 2*DIM);
+
+        double current_surface_area_difference = rLattice.GetElementSurfaceArea(current_element) - mMatureCellTargetSurfaceArea;
+        double current_surface_area_difference_after_switch = current_surface_area_difference + (2.0*DIM - 2.0*neighbours_in_same_element_as_current_node);
+
+        delta_H += mDeformationEnergyParameter*(current_surface_area_difference_after_switch*current_surface_area_difference_after_switch - current_surface_area_difference*current_surface_area_difference);
+    }
+    if (target_node_contained) // target node is in an element
+    {
+        unsigned neighbours_in_same_element_as_target_node = rLattice.CountVonNeumannNeighboursOwnedBy(targetNodeIndex, target_element);
+        assert(neighbours_in_same_element_as_target_node <= 2*DIM);
+
+        double target_surface_area_difference = rLattice.GetElementSurfaceArea(target_element) - mMatureCellTargetSurfaceArea;
+        double target_surface_area_difference_after_switch = target_surface_area_difference - (2.0*DIM - 2.0*neighbours_in_same_element_as_target_node);
+
+        delta_H += mDeformationEnergyParameter*(target_surface_area_difference_after_switch*target_surface_area_difference_after_switch - target_surface_area_difference*target_surface_area_difference);
+    }
+
+    return delta_H;
+}
+
 template<unsigned DIM>
 double SurfaceAreaConstraintPottsUpdateRule<DIM>::GetDeformationEnergyParameter()
 {
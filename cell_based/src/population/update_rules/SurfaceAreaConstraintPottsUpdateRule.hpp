@@ -114,6 +114,25 @@ public:
                                            unsigned targetNodeIndex,
                                            PottsBasedCellPopulation<DIM>& rCellPopulation);
 
+    /**
+     * Overridden EvaluateHamiltonianContributionOnLattice() method.
+     *
+     * Gives the same result as EvaluateHamiltonianContribution(), but uses the site owners, neighbours and element surface areas
+     * cached by the lattice engine rather than querying the mesh.
+     *
+     * @param currentNodeIndex The index of the current node/lattice site
+     * @param targetNodeIndex The index of the target node/lattice site
+     * @param rCellPopulation The cell population
+     * @param rLattice The lattice engine of the cell population
+     *
+     * @return The difference in the Hamiltonian with the configuration of the target node
+     * having the same spin as the current node with the current configuration. i.e H_1-H_0
+     */
+    double EvaluateHamiltonianContributionOnLattice(unsigned currentNodeIndex,
+                                                    unsigned targetNodeIndex,
+                                                    PottsBasedCellPopulation<DIM>& rCellPopulation,
+                                                    const PottsLatticeEngine<DIM>& rLattice);
+
     /**
      * @return mDeformationEnergyParameter
      */
@@ -98,6 +98,46 @@ double VolumeConstraintPottsUpdateRule<DIM>::EvaluateHamiltonianContribution(uns
     return delta_H;
 }
 
+template<unsigned DIM>
+double VolumeConstraintPottsUpdateRule<DIM>::EvaluateHamiltonianContributionOnLattice(unsigned currentNodeIndex,
+                                                                                     unsigned targetNodeIndex,
+                                                                                     PottsBasedCellPopulation<DIM>& rCellPopulation,
+                                                                                     const PottsLatticeEngine<DIM>& rLattice)
+{
+    double delta_H = 0.0;
+
+    unsigned current_element = rLattice.GetSiteOwner(currentNodeIndex);
+    unsigned target_element = rLattice.GetSiteOwner(targetNodeIndex);
+
+    bool current_node_contained = (current_element != UNSIGNED_UNSET);
+    bool target_node_contained = (target_element != UNSIGNED_UNSET);
+
+    if (!current_node_contained && !target_node_contained)
+    {
+        EXCEPTION("At least one of the current node or target node must be in an element.");
+    }
+
+    if (current_element == target_element)
+    {
+        EXCEPTION("The current node and target node must not be in the same element.");
+    }
+
+    if (current_node_contained) // current node is in an element
+    {
+        double current_volume_difference = rLattice.GetElementVolume(current_element) - mMatureCellTargetVolume;
+
+        delta_H += mDeformationEnergyParameter*((current_volume_difference + 1.0)*(current_volume_difference + 1.0) - current_volume_difference*current_volume_difference);
+    }
+    if (target_node_contained) // target node is in an element
+    {
+        double target_volume_difference = rLattice.GetElementVolume(target_element) - mMatureCellTargetVolume;
+
+        delta_H += mDeformationEnergyParameter*((target_volume_difference - 1.0)*(target_volume_difference - 1.0) - target_volume_difference*target_volume_difference);
+    }
+
+    return delta_H;
+}
+
 template<unsigned DIM>
 double VolumeConstraintPottsUpdateRule<DIM>::GetDeformationEnergyParameter()
 {
@@ -103,6 +103,12 @@ protected:
     /** The numerical method to use in this simulation. Defaults to the explicit forward Euler method. */
     boost::shared_ptr<AbstractNumericalMethod<ELEMENT_DIM, SPACE_DIM> > mpNumericalMethod;
 
+    /**
+     * The number of threads used to update node positions.
+     * Defaults to 1. Not archived.
+     */
+    unsigned mNumThreads;
+
     /**
      * Overridden UpdateCellLocationsAndTopology() method.
      *
@@ -127,6 +133,10 @@ protected:
 
     /**
      * Overridden SetupSolve() method to clear the forces applied to the nodes.
+     *
+     * Also passes the number of threads to the numerical method and, if it is
+     * more than one, switches on threaded batched force calculation for each
+     * two-body interaction force.
      */
     virtual void SetupSolve();
 
@@ -186,6 +196,24 @@ public:
      */
     const boost::shared_ptr<AbstractNumericalMethod<ELEMENT_DIM, SPACE_DIM> > GetNumericalMethod() const;
 
+    /**
+     * Set the number of threads used to update node positions.
+     *
+     * With more than one thread, the nodes are moved in contiguous chunks, one
+     * per thread. Forces are not changed: a two-body interaction force may be
+     * split over threads too, with its own SetUseBatchedForceCalculation() and
+     * SetNumBatchThreads() methods. Threads are only used if Chaste is built
+     * with OpenMP.
+     *
+     * @param numThreads the number of threads (must be at least 1)
+     */
+    void SetNumThreads(unsigned numThreads);
+
+    /**
+     * @return the number of threads used to update node positions.
+     */
+    unsigned GetNumThreads() const;
+
     /**
      * Overridden OutputAdditionalSimulationSetup() method.
      *
@@ -0,0 +1,115 @@
+/*
+
+Copyright (c) 2005-2017, University of Oxford.
+All rights reserved.
+
+University of Oxford means the Chancellor, Masters and Scholars of the
+University of Oxford, having an administrative office at Wellington
+Square, Oxford OX1 2JD, UK.
+
+This file is part of Chaste.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+ * Redistributions of source code must retain the above copyright notice,
+   this list of conditions and the following disclaimer.
+ * Redistributions in binary form must reproduce the above copyright notice,
+   this list of conditions and the following disclaimer in the documentation
+   and/or other materials provided with the distribution.
+ * Neither the name of the University of Oxford nor the names of its
+   contributors may be used to endorse or promote products derived from this
+   software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+*/
+
+
+#include "BatchedSrnOdeSolverModifier.hpp"
+#include "AbstractOdeSrnModel.hpp"
+#include "ApoptoticCellProperty.hpp"
+
+template<unsigned DIM>
+BatchedSrnOdeSolverModifier<DIM>::BatchedSrnOdeSolverModifier()
+    : AbstractCellBasedSimulationModifier<DIM>()
+{
+}
+
+template<unsigned DIM>
+BatchedSrnOdeSolverModifier<DIM>::~BatchedSrnOdeSolverModifier()
+{
+}
+
+template<unsigned DIM>
+void BatchedSrnOdeSolverModifier<DIM>::UpdateAtEndOfTimeStep(AbstractCellPopulation<DIM,DIM>& rCellPopulation)
+{
+    SolveSrnOdes(rCellPopulation);
+}
+
+template<unsigned DIM>
+void BatchedSrnOdeSolverModifier<DIM>::SetupSolve(AbstractCellPopulation<DIM,DIM>& rCellPopulation, std::string outputDirectory)
+{
+    // The SRN models are up to date at the start of the simulation, so there is nothing to do here
+}
+
+template<unsigned DIM>
+void BatchedSrnOdeSolverModifier<DIM>::SolveSrnOdes(AbstractCellPopulation<DIM,DIM>& rCellPopulation)
+{
+    double current_time = SimulationTime::Instance()->GetTime();
+
+    // Collect the SRN models that can be solved together
+    std::vector<AbstractOdeSrnModel*> srn_models;
+    std::vector<CellCycleModelOdeHandler*> handlers;
+    for (typename AbstractCellPopulation<DIM>::Iterator cell_iter = rCellPopulation.Begin();
+         cell_iter != rCellPopulation.End();
+         ++cell_iter)
+    {
+        // Skip cells whose SRN the simulation would not run (see AbstractCellBasedSimulation::DoCellBirth())
+        if ((cell_iter->GetAge() <= 0.0)
+            || cell_iter->HasApoptosisBegun()
+            || cell_iter->template HasCellProperty<ApoptoticCellProperty>())
+        {
+            continue;
+        }
+
+        AbstractOdeSrnModel* p_model = dynamic_cast<AbstractOdeSrnModel*>(cell_iter->GetSrnModel());
+        if (p_model && p_model->CanSolveOdesInBatch())
+        {
+            srn_models.push_back(p_model);
+            handlers.push_back(p_model);
+        }
+    }
+
+    CellCycleModelOdeHandler::SolveOdesToTimeInBatch(handlers, current_time, mSolver);
+
+    // Update the SimulatedToTime value, as AbstractOdeSrnModel::SimulateToCurrentTime() would
+    for (unsigned i=0; i<srn_models.size(); i++)
+    {
+        srn_models[i]->SetSimulatedToTime(current_time);
+    }
+}
+
+template<unsigned DIM>
+void BatchedSrnOdeSolverModifier<DIM>::OutputSimulationModifierParameters(out_stream& rParamsFile)
+{
+    // No parameters to output, so just call method on direct parent class
+    AbstractCellBasedSimulationModifier<DIM>::OutputSimulationModifierParameters(rParamsFile);
+}
+
+// Explicit instantiation
+template class BatchedSrnOdeSolverModifier<1>;
+template class BatchedSrnOdeSolverModifier<2>;
+template class BatchedSrnOdeSolverModifier<3>;
+
+// Serialization for Boost >= 1.36
+#include "SerializationExportWrapperForCpp.hpp"
+EXPORT_TEMPLATE_CLASS_SAME_DIMS(BatchedSrnOdeSolverModifier)
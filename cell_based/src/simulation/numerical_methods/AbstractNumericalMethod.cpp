@@ -34,7 +34,6 @@ OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 */
 
 #include "AbstractNumericalMethod.hpp"
-#include "StepSizeException.hpp"
 #include "Warnings.hpp"
 #include "AbstractCentreBasedCellPopulation.hpp"
 #include "NodeBasedCellPopulationWithBuskeUpdate.hpp"
@@ -47,7 +46,8 @@ AbstractNumericalMethod<ELEMENT_DIM,SPACE_DIM>::AbstractNumericalMethod()
       mpForceCollection(NULL),
       mUseAdaptiveTimestep(false),
       mUseUpdateNodeLocation(false),
-      mGhostNodeForcesEnabled(true)
+      mGhostNodeForcesEnabled(true),
+      mNumThreads(1)
 {
     // mpCellPopulation and mpForceCollection are initialized by the OffLatticeSimulation constructor
 }
@@ -97,6 +97,22 @@ bool AbstractNumericalMethod<ELEMENT_DIM,SPACE_DIM>::HasAdaptiveTimestep()
     return mUseAdaptiveTimestep;
 }
 
+template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+void AbstractNumericalMethod<ELEMENT_DIM,SPACE_DIM>::SetNumThreads(unsigned numThreads)
+{
+    if (numThreads == 0)
+    {
+        EXCEPTION("The number of threads must be at least one.");
+    }
+    mNumThreads = numThreads;
+}
+
+template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+unsigned AbstractNumericalMethod<ELEMENT_DIM,SPACE_DIM>::GetNumThreads() const
+{
+    return mNumThreads;
+}
+
 template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
 std::vector<c_vector<double, SPACE_DIM> > AbstractNumericalMethod<ELEMENT_DIM,SPACE_DIM>::ComputeForcesIncludingDamping()
 {
@@ -173,22 +189,28 @@ void AbstractNumericalMethod<ELEMENT_DIM,SPACE_DIM>::DetectStepSizeExceptions(un
     }
     catch (StepSizeException& e)
     {
-        if (!(e.IsTerminal()) && (mUseAdaptiveTimestep==false))
-        {
-            /*
-             * If adaptivity is turned off but the simulation can continue, just produce a warning.
-             * Only the case for vertex-based cell populations, which can alter node displacement directly
-             * to avoid cell rearrangement problems.
-             */
-            WARN_ONCE_ONLY(e.what());
-        }
-        else
-        {
-            throw e;
-        }
+        HandleStepSizeException(e);
     }   
 }
 
+template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+void AbstractNumericalMethod<ELEMENT_DIM,SPACE_DIM>::HandleStepSizeException(StepSizeException& rException)
+{
+    if (!(rException.IsTerminal()) && (mUseAdaptiveTimestep==false))
+    {
+        /*
+         * If adaptivity is turned off but the simulation can continue, just produce a warning.
+         * Only the case for vertex-based cell populations, which can alter node displacement directly
+         * to avoid cell rearrangement problems.
+         */
+        WARN_ONCE_ONLY(rException.what());
+    }
+    else
+    {
+        throw rException;
+    }
+}
+
 template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
 void AbstractNumericalMethod<ELEMENT_DIM,SPACE_DIM>::SetUseUpdateNodeLocation(bool useUpdateNodeLocation)
 {
@@ -43,6 +43,7 @@ OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include "AbstractOffLatticeCellPopulation.hpp"
 #include "AbstractForce.hpp"
+#include "StepSizeException.hpp"
 
 /**
  * An abstract class representing a numerical method for off lattice cell based simulations.
@@ -106,6 +107,12 @@ protected:
      */
     bool mGhostNodeForcesEnabled;
 
+    /**
+     * The number of threads used to update node positions. Defaults to 1.
+     * Not archived; set by OffLatticeSimulation::SetupSolve().
+     */
+    unsigned mNumThreads;
+
     /**
      * Computes and returns the force on each node, including the damping factor
      * @return A vector of applied forces
@@ -137,6 +144,15 @@ protected:
      */
     void DetectStepSizeExceptions(unsigned nodeIndex, c_vector<double,SPACE_DIM>& displacement, double dt);
 
+    /**
+     * Deal with a step size exception raised by the cell population. If adaptivity
+     * is turned off and the exception is not terminal a warning is produced,
+     * otherwise the exception is re-thrown.
+     *
+     * @param rException the step size exception
+     */
+    void HandleStepSizeException(StepSizeException& rException);
+
 public:
 
     /**
@@ -192,6 +208,18 @@ public:
      */
     bool HasAdaptiveTimestep();
 
+    /**
+     * Set the number of threads used to update node positions.
+     *
+     * @param numThreads the number of threads (must be at least 1)
+     */
+    void SetNumThreads(unsigned numThreads);
+
+    /**
+     * @return the number of threads used to update node positions.
+     */
+    unsigned GetNumThreads() const;
+
     /**
      * Updates node positions according to Newton's 2nd law with overdamping.
      *
@@ -54,20 +54,81 @@ void ForwardEulerNumericalMethod<ELEMENT_DIM,SPACE_DIM>::UpdateAllNodePositions(
         // Apply forces to each cell, and save a vector of net forces F
         std::vector<c_vector<double, SPACE_DIM> > forces = this->ComputeForcesIncludingDamping();
 
-        unsigned index = 0;
-        for (typename AbstractMesh<ELEMENT_DIM, SPACE_DIM>::NodeIterator node_iter = this->mpCellPopulation->rGetMesh().GetNodeIteratorBegin();
-             node_iter != this->mpCellPopulation->rGetMesh().GetNodeIteratorEnd();
-             ++node_iter, ++index)
+        if (this->mNumThreads == 1)
         {
-            // Get the current node location and calculate the new location according to the forward Euler method
-            const c_vector<double, SPACE_DIM>& r_old_location = node_iter->rGetLocation();
-            c_vector<double, SPACE_DIM> displacement = dt * forces[index];
-
-            // In the vertex-based case, the displacement may be scaled if the cell rearrangement threshold is exceeded
-            this->DetectStepSizeExceptions(node_iter->GetIndex(), displacement, dt);
-
-            c_vector<double, SPACE_DIM> new_location = r_old_location + displacement;
-            this->SafeNodePositionUpdate(node_iter->GetIndex(), new_location);
+            unsigned index = 0;
+            for (typename AbstractMesh<ELEMENT_DIM, SPACE_DIM>::NodeIterator node_iter = this->mpCellPopulation->rGetMesh().GetNodeIteratorBegin();
+                 node_iter != this->mpCellPopulation->rGetMesh().GetNodeIteratorEnd();
+                 ++node_iter, ++index)
+            {
+                // Get the current node location and calculate the new location according to the forward Euler method
+                const c_vector<double, SPACE_DIM>& r_old_location = node_iter->rGetLocation();
+                c_vector<double, SPACE_DIM> displacement = dt * forces[index];
+
+                // In the vertex-based case, the displacement may be scaled if the cell rearrangement threshold is exceeded
+                this->DetectStepSizeExceptions(node_iter->GetIndex(), displacement, dt);
+
+                c_vector<double, SPACE_DIM> new_location = r_old_location + displacement;
+                this->SafeNodePositionUpdate(node_iter->GetIndex(), new_location);
+            }
+        }
+        else
+        {
+            // Gather the nodes in iteration order, so they can be split into contiguous chunks
+            std::vector<Node<SPACE_DIM>*> nodes;
+            nodes.reserve(forces.size());
+            for (typename AbstractMesh<ELEMENT_DIM, SPACE_DIM>::NodeIterator node_iter = this->mpCellPopulation->rGetMesh().GetNodeIteratorBegin();
+                 node_iter != this->mpCellPopulation->rGetMesh().GetNodeIteratorEnd();
+                 ++node_iter)
+            {
+                nodes.push_back(&(*node_iter));
+            }
+
+            unsigned num_nodes = nodes.size();
+            unsigned num_threads = this->mNumThreads;
+            std::vector<c_vector<double, SPACE_DIM> > displacements(num_nodes);
+
+            // Exceptions can't propagate out of a parallel region, so are captured per node
+            std::vector<boost::shared_ptr<StepSizeException> > step_size_exceptions(num_nodes);
+#ifdef CHASTE_OPENMP
+#pragma omp parallel for schedule(static, 1) num_threads(num_threads)
+#endif // CHASTE_OPENMP
+            for (int chunk=0; chunk<(int)num_threads; chunk++)
+            {
+                for (unsigned index=(chunk*num_nodes)/num_threads; index<((chunk+1)*num_nodes)/num_threads; index++)
+                {
+                    displacements[index] = dt * forces[index];
+                    try
+                    {
+                        this->mpCellPopulation->CheckForStepSizeException(nodes[index]->GetIndex(), displacements[index], dt);
+                    }
+                    catch (StepSizeException& e)
+                    {
+                        step_size_exceptions[index].reset(new StepSizeException(e));
+                    }
+                }
+            }
+
+            for (unsigned index=0; index<num_nodes; index++)
+            {
+                if (step_size_exceptions[index])
+                {
+                    this->HandleStepSizeException(*(step_size_exceptions[index]));
+                }
+            }
+
+            // Move the nodes
+#ifdef CHASTE_OPENMP
+#pragma omp parallel for schedule(static, 1) num_threads(num_threads)
+#endif // CHASTE_OPENMP
+            for (int chunk=0; chunk<(int)num_threads; chunk++)
+            {
+                for (unsigned index=(chunk*num_nodes)/num_threads; index<((chunk+1)*num_nodes)/num_threads; index++)
+                {
+                    c_vector<double, SPACE_DIM> new_location = nodes[index]->rGetLocation() + displacements[index];
+                    this->SafeNodePositionUpdate(nodes[index]->GetIndex(), new_location);
+                }
+            }
         }
     }
     else
@@ -84,6 +84,10 @@ public:
     /**
      * Overridden UpdateAllNodePositions() method.
      *
+     * If more than one thread is used, the displacements are found and checked,
+     * and the nodes moved, in contiguous chunks of nodes, one per thread. Any
+     * step size exceptions are dealt with in node order before any node is moved.
+     *
      * @param dt Time step size
      */
     void UpdateAllNodePositions(double dt);
@@ -0,0 +1,378 @@
+/*
+
+Copyright (c) 2005-2017, University of Oxford.
+All rights reserved.
+
+University of Oxford means the Chancellor, Masters and Scholars of the
+University of Oxford, having an administrative office at Wellington
+Square, Oxford OX1 2JD, UK.
+
+This file is part of Chaste.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+ * Redistributions of source code must retain the above copyright notice,
+   this list of conditions and the following disclaimer.
+ * Redistributions in binary form must reproduce the above copyright notice,
+   this list of conditions and the following disclaimer in the documentation
+   and/or other materials provided with the distribution.
+ * Neither the name of the University of Oxford nor the names of its
+   contributors may be used to endorse or promote products derived from this
+   software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+*/
+
+#include <algorithm>
+#include <cfloat>
+#include <sstream>
+#include <boost/scoped_array.hpp>
+
+#include "CellTrajectoryHdf5Reader.hpp"
+#include "AbstractHdf5Access.hpp"
+#include "Exception.hpp"
+#include "NodesOnlyMesh.hpp"
+#include "PetscTools.hpp"
+#include "VtkMeshWriter.hpp"
+
+CellTrajectoryHdf5Reader::CellTrajectoryHdf5Reader(const FileFinder& rFile)
+{
+    if (!rFile.Exists())
+    {
+        EXCEPTION("CellTrajectoryHdf5Reader could not find " << rFile.GetAbsolutePath());
+    }
+
+    mFileId = H5Fopen(rFile.GetAbsolutePath().c_str(), H5F_ACC_RDONLY, H5P_DEFAULT);
+    if (mFileId < 0)
+    {
+        EXCEPTION("CellTrajectoryHdf5Reader could not open " << rFile.GetAbsolutePath());
+    }
+
+    // Read the time and row count of each sampling step
+    hid_t time_dataset_id = H5Dopen(mFileId, "Time", H5P_DEFAULT);
+    hid_t time_dataspace = H5Dget_space(time_dataset_id);
+    hsize_t num_time_steps;
+    H5Sget_simple_extent_dims(time_dataspace, &num_time_steps, NULL);
+    H5Sclose(time_dataspace);
+
+    mTimes.resize(num_time_steps);
+    mNumRows.resize(num_time_steps);
+    if (num_time_steps > 0)
+    {
+        H5Dread(time_dataset_id, H5T_NATIVE_DOUBLE, H5S_ALL, H5S_ALL, H5P_DEFAULT, &mTimes[0]);
+
+        hid_t num_rows_dataset_id = H5Dopen(mFileId, "Number of rows", H5P_DEFAULT);
+        H5Dread(num_rows_dataset_id, H5T_NATIVE_ULLONG, H5S_ALL, H5S_ALL, H5P_DEFAULT, &mNumRows[0]);
+        H5Dclose(num_rows_dataset_id);
+    }
+
+    mFirstRows.resize(num_time_steps);
+    unsigned long long first_row = 0;
+    for (unsigned i=0; i<num_time_steps; i++)
+    {
+        mFirstRows[i] = first_row;
+        first_row += mNumRows[i];
+    }
+
+    // Read the description of the columns
+    mValueColumnNames = ReadStringAttribute(time_dataset_id, "Value columns");
+    mFileNames = ReadStringAttribute(time_dataset_id, "File names");
+
+    mHasStandardTextLayout.resize(mValueColumnNames.size());
+    if (!mValueColumnNames.empty())
+    {
+        std::vector<unsigned> standard_text_layouts(mValueColumnNames.size());
+        hid_t layout_attribute_id = H5Aopen_name(time_dataset_id, "Standard text layout");
+        H5Aread(layout_attribute_id, H5T_NATIVE_UINT, &standard_text_layouts[0]);
+        H5Aclose(layout_attribute_id);
+        for (unsigned i=0; i<standard_text_layouts.size(); i++)
+        {
+            mHasStandardTextLayout[i] = (standard_text_layouts[i] != 0);
+        }
+    }
+
+    hid_t attribute_id = H5Aopen_name(time_dataset_id, "Space dimension");
+    H5Aread(attribute_id, H5T_NATIVE_UINT, &mSpaceDimension);
+    H5Aclose(attribute_id);
+
+    H5Dclose(time_dataset_id);
+}
+
+CellTrajectoryHdf5Reader::~CellTrajectoryHdf5Reader()
+{
+    H5Fclose(mFileId);
+}
+
+std::vector<std::string> CellTrajectoryHdf5Reader::ReadStringAttribute(hid_t datasetId, const std::string& rName)
+{
+    hid_t attribute_id = H5Aopen_name(datasetId, rName.c_str());
+    hid_t attribute_type = H5Aget_type(attribute_id);
+    hid_t attribute_space = H5Aget_space(attribute_id);
+
+    std::vector<std::string> values;
+    unsigned num_values = H5Sget_simple_extent_npoints(attribute_space);
+    if (num_values > 0)
+    {
+        boost::scoped_array<char> string_array(new char[num_values*MAX_STRING_SIZE]);
+        H5Aread(attribute_id, attribute_type, string_array.get());
+        for (unsigned i=0; i<num_values; i++)
+        {
+            values.push_back(std::string(&string_array[i*MAX_STRING_SIZE]));
+        }
+    }
+
+    H5Tclose(attribute_type);
+    H5Sclose(attribute_space);
+    H5Aclose(attribute_id);
+    return values;
+}
+
+void CellTrajectoryHdf5Reader::ReadRows(const std::string& rColumnName, hid_t type, unsigned timeStep, void* pData)
+{
+    hsize_t count[1] = {mNumRows[timeStep]};
+    if (count[0] == 0)
+    {
+        return;
+    }
+
+    hid_t dataset_id = H5Dopen(mFileId, rColumnName.c_str(), H5P_DEFAULT);
+
+    hid_t memspace = H5Screate_simple(1, count, NULL);
+    hsize_t offset[1] = {mFirstRows[timeStep]};
+    hid_t hyperslab_space = H5Dget_space(dataset_id);
+    H5Sselect_hyperslab(hyperslab_space, H5S_SELECT_SET, offset, NULL, count, NULL);
+
+    H5Dread(dataset_id, type, memspace, hyperslab_space, H5P_DEFAULT, pData);
+
+    H5Sclose(hyperslab_space);
+    H5Sclose(memspace);
+    H5Dclose(dataset_id);
+}
+
+unsigned CellTrajectoryHdf5Reader::GetNumTimeSteps() const
+{
+    return mTimes.size();
+}
+
+unsigned CellTrajectoryHdf5Reader::GetSpaceDimension() const
+{
+    return mSpaceDimension;
+}
+
+const std::vector<double>& CellTrajectoryHdf5Reader::rGetTimes() const
+{
+    return mTimes;
+}
+
+const std::vector<std::string>& CellTrajectoryHdf5Reader::rGetValueColumnNames() const
+{
+    return mValueColumnNames;
+}
+
+unsigned CellTrajectoryHdf5Reader::GetNumCells(unsigned timeStep) const
+{
+    if (timeStep >= mTimes.size())
+    {
+        EXCEPTION("Sampling step " << timeStep << " is not stored; there are " << mTimes.size() << " sampling steps.");
+    }
+    return mNumRows[timeStep];
+}
+
+std::vector<unsigned> CellTrajectoryHdf5Reader::GetLocationIndices(unsigned timeStep)
+{
+    std::vector<unsigned> location_indices(GetNumCells(timeStep));
+    ReadRows("Location index", H5T_NATIVE_UINT, timeStep, location_indices.empty() ? NULL : &location_indices[0]);
+    return location_indices;
+}
+
+std::vector<unsigned> CellTrajectoryHdf5Reader::GetCellIds(unsigned timeStep)
+{
+    std::vector<unsigned> cell_ids(GetNumCells(timeStep));
+    ReadRows("Cell id", H5T_NATIVE_UINT, timeStep, cell_ids.empty() ? NULL : &cell_ids[0]);
+    return cell_ids;
+}
+
+std::vector<double> CellTrajectoryHdf5Reader::GetColumn(const std::string& rColumnName, unsigned timeStep)
+{
+    const std::string location_names[3] = {"x", "y", "z"};
+    bool is_stored = (std::find(mValueColumnNames.begin(), mValueColumnNames.end(), rColumnName) != mValueColumnNames.end());
+    for (unsigned i=0; i<mSpaceDimension; i++)
+    {
+        is_stored = is_stored || (rColumnName == location_names[i]);
+    }
+    if (!is_stored)
+    {
+        EXCEPTION("The column " << rColumnName << " is not stored");
+    }
+
+    std::vector<double> values(GetNumCells(timeStep));
+    ReadRows(rColumnName, H5T_NATIVE_DOUBLE, timeStep, values.empty() ? NULL : &values[0]);
+    return values;
+}
+
+void CellTrajectoryHdf5Reader::WriteTextFiles(OutputFileHandler& rOutputFileHandler)
+{
+    for (unsigned i=0; i<mValueColumnNames.size(); i++)
+    {
+        if (!mHasStandardTextLayout[i])
+        {
+            EXCEPTION("Cannot convert the column " << mValueColumnNames[i] << " to text: the text output of its cell writer"
+                      << " is not the location index, cell ID, coordinates and value of each cell.");
+        }
+    }
+
+    // Every process can read the file, but only the master writes the text files
+    if (!PetscTools::AmMaster())
+    {
+        return;
+    }
+
+    const std::string location_names[3] = {"x", "y", "z"};
+
+    for (unsigned i=0; i<mValueColumnNames.size(); i++)
+    {
+        out_stream p_file = rOutputFileHandler.OpenOutputFile(mFileNames[i]);
+
+        for (unsigned step=0; step<mTimes.size(); step++)
+        {
+            std::vector<unsigned> location_indices = GetLocationIndices(step);
+            std::vector<unsigned> cell_ids = GetCellIds(step);
+            std::vector<std::vector<double> > locations;
+            for (unsigned j=0; j<mSpaceDimension; j++)
+            {
+                locations.push_back(GetColumn(location_names[j], step));
+            }
+            std::vector<double> values = GetColumn(mValueColumnNames[i], step);
+
+            *p_file << mTimes[step] << "\t";
+            for (unsigned row=0; row<values.size(); row++)
+            {
+                *p_file << location_indices[row] << " " << cell_ids[row] << " ";
+                for (unsigned j=0; j<mSpaceDimension; j++)
+                {
+                    *p_file << locations[j][row] << " ";
+                }
+                *p_file << values[row] << " ";
+            }
+            *p_file << "\n";
+        }
+
+        p_file->close();
+    }
+}
+
+void CellTrajectoryHdf5Reader::WriteVtkFiles(OutputFileHandler& rOutputFileHandler)
+{
+    if (!PetscTools::IsSequential())
+    {
+        EXCEPTION("CellTrajectoryHdf5Reader can only write VTK output when running sequentially");
+    }
+
+    switch (mSpaceDimension)
+    {
+        case 2:
+            WriteVtkFilesForDimension<2>(rOutputFileHandler);
+            break;
+        case 3:
+            WriteVtkFilesForDimension<3>(rOutputFileHandler);
+            break;
+        default:
+            EXCEPTION("VTK output can only be written in 2 or 3 dimensions");
+    }
+}
+
+template<unsigned DIM>
+void CellTrajectoryHdf5Reader::WriteVtkFilesForDimension(OutputFileHandler& rOutputFileHandler)
+{
+#ifdef CHASTE_VTK
+    const std::string location_names[3] = {"x", "y", "z"};
+
+    out_stream p_vtk_meta_file = rOutputFileHandler.OpenOutputFile("results.pvd");
+    *p_vtk_meta_file << "<?xml version=\"1.0\"?>\n";
+    *p_vtk_meta_file << "<VTKFile type=\"Collection\" version=\"0.1\" byte_order=\"LittleEndian\" compressor=\"vtkZLibDataCompressor\">\n";
+    *p_vtk_meta_file << "    <Collection>\n";
+
+    for (unsigned step=0; step<mTimes.size(); step++)
+    {
+        unsigned num_cells = GetNumCells(step);
+        if (num_cells == 0)
+        {
+            continue;
+        }
+
+        // Make a point cloud of cell centres
+        std::vector<std::vector<double> > locations;
+        for (unsigned j=0; j<DIM; j++)
+        {
+            locations.push_back(GetColumn(location_names[j], step));
+        }
+
+        std::vector<Node<DIM>*> nodes;
+        c_vector<double, DIM> min_location = scalar_vector<double>(DIM, DBL_MAX);
+        c_vector<double, DIM> max_location = scalar_vector<double>(DIM, -DBL_MAX);
+        for (unsigned row=0; row<num_cells; row++)
+        {
+            c_vector<double, DIM> location;
+            for (unsigned j=0; j<DIM; j++)
+            {
+                location[j] = locations[j][row];
+                min_location[j] = std::min(min_location[j], location[j]);
+                max_location[j] = std::max(max_location[j], location[j]);
+            }
+            nodes.push_back(new Node<DIM>(row, location));
+        }
+
+        // The interaction distance only sizes the boxes of the mesh, so use a few large boxes
+        double max_extent = 1.0 + norm_inf(max_location - min_location);
+        NodesOnlyMesh<DIM> mesh;
+        mesh.ConstructNodesWithoutMesh(nodes, max_extent);
+
+        std::stringstream base_name;
+        base_name << "results_" << step;
+        VtkMeshWriter<DIM, DIM> mesh_writer(rOutputFileHandler.GetRelativePath(), base_name.str(), false);
+
+        std::vector<unsigned> cell_ids = GetCellIds(step);
+        std::vector<double> vtk_cell_ids(num_cells);
+        for (unsigned row=0; row<num_cells; row++)
+        {
+            vtk_cell_ids[mesh.SolveNodeMapping(row)] = cell_ids[row];
+        }
+        mesh_writer.AddPointData("Cell id", vtk_cell_ids);
+
+        for (unsigned i=0; i<mValueColumnNames.size(); i++)
+        {
+            std::vector<double> values = GetColumn(mValueColumnNames[i], step);
+            std::vector<double> vtk_values(num_cells);
+            for (unsigned row=0; row<num_cells; row++)
+            {
+                vtk_values[mesh.SolveNodeMapping(row)] = values[row];
+            }
+            mesh_writer.AddPointData(mValueColumnNames[i], vtk_values);
+        }
+
+        mesh_writer.WriteFilesUsingMesh(mesh);
+
+        for (unsigned row=0; row<nodes.size(); row++)
+        {
+            delete nodes[row];
+        }
+
+        *p_vtk_meta_file << "        <DataSet timestep=\"" << mTimes[step];
+        *p_vtk_meta_file << "\" group=\"\" part=\"0\" file=\"" << base_name.str() << ".vtu\"/>\n";
+    }
+
+    *p_vtk_meta_file << "    </Collection>\n";
+    *p_vtk_meta_file << "</VTKFile>\n";
+    p_vtk_meta_file->close();
+#endif //CHASTE_VTK
+}
@@ -0,0 +1,197 @@
+/*
+
+Copyright (c) 2005-2017, University of Oxford.
+All rights reserved.
+
+University of Oxford means the Chancellor, Masters and Scholars of the
+University of Oxford, having an administrative office at Wellington
+Square, Oxford OX1 2JD, UK.
+
+This file is part of Chaste.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+ * Redistributions of source code must retain the above copyright notice,
+   this list of conditions and the following disclaimer.
+ * Redistributions in binary form must reproduce the above copyright notice,
+   this list of conditions and the following disclaimer in the documentation
+   and/or other materials provided with the distribution.
+ * Neither the name of the University of Oxford nor the names of its
+   contributors may be used to endorse or promote products derived from this
+   software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+*/
+
+#ifndef CELLTRAJECTORYHDF5READER_HPP_
+#define CELLTRAJECTORYHDF5READER_HPP_
+
+#include <hdf5.h>
+#include <string>
+#include <vector>
+
+#include "FileFinder.hpp"
+#include "OutputFileHandler.hpp"
+
+/**
+ * Reads the columnar cell output written by CellTrajectoryHdf5Writer, and converts
+ * it to text or VTK output for post-processing.
+ *
+ * The reader only reads the file, so it may be used on any number of processes,
+ * but VTK conversion is only available when running sequentially.
+ */
+class CellTrajectoryHdf5Reader
+{
+private:
+
+    /** The HDF5 file. */
+    hid_t mFileId;
+
+    /** The spatial dimension of the cell population. */
+    unsigned mSpaceDimension;
+
+    /** The time of each sampling step. */
+    std::vector<double> mTimes;
+
+    /** The first row of the per-cell datasets belonging to each sampling step. */
+    std::vector<unsigned long long> mFirstRows;
+
+    /** The number of rows of the per-cell datasets belonging to each sampling step. */
+    std::vector<unsigned long long> mNumRows;
+
+    /** The names of the datasets holding the values of cell writers. */
+    std::vector<std::string> mValueColumnNames;
+
+    /** The name of the text file written by each cell writer. */
+    std::vector<std::string> mFileNames;
+
+    /**
+     * Whether the text output of each cell writer can be recreated from the stored columns
+     * (see AbstractCellWriter::HasStandardTextLayout()).
+     */
+    std::vector<bool> mHasStandardTextLayout;
+
+    /**
+     * Read an array of fixed-length strings stored as an attribute of the "Time" dataset.
+     *
+     * @param datasetId the "Time" dataset
+     * @param rName the name of the attribute
+     * @return the strings
+     */
+    std::vector<std::string> ReadStringAttribute(hid_t datasetId, const std::string& rName);
+
+    /**
+     * Read the rows of a per-cell dataset belonging to a sampling step.
+     *
+     * @param rColumnName the name of the dataset
+     * @param type the HDF5 type of the data in memory
+     * @param timeStep the index of the sampling step
+     * @param pData where to store the rows, which must have room for GetNumCells(timeStep) entries
+     */
+    void ReadRows(const std::string& rColumnName, hid_t type, unsigned timeStep, void* pData);
+
+    /**
+     * Helper method for WriteVtkFiles().
+     *
+     * @param rOutputFileHandler handler for the directory in which to write the files
+     */
+    template<unsigned DIM>
+    void WriteVtkFilesForDimension(OutputFileHandler& rOutputFileHandler);
+
+public:
+
+    /**
+     * Constructor. Opens the file and reads the time of each sampling step.
+     *
+     * @param rFile the file written by CellTrajectoryHdf5Writer
+     */
+    CellTrajectoryHdf5Reader(const FileFinder& rFile);
+
+    /**
+     * Destructor. Closes the file.
+     */
+    ~CellTrajectoryHdf5Reader();
+
+    /**
+     * @return the number of sampling steps stored.
+     */
+    unsigned GetNumTimeSteps() const;
+
+    /**
+     * @return the spatial dimension of the cell population.
+     */
+    unsigned GetSpaceDimension() const;
+
+    /**
+     * @return the time of each sampling step.
+     */
+    const std::vector<double>& rGetTimes() const;
+
+    /**
+     * @return the names of the columns holding the values of cell writers.
+     */
+    const std::vector<std::string>& rGetValueColumnNames() const;
+
+    /**
+     * @return the number of cells stored for a sampling step.
+     *
+     * @param timeStep the index of the sampling step
+     */
+    unsigned GetNumCells(unsigned timeStep) const;
+
+    /**
+     * @return the location index of each cell stored for a sampling step.
+     *
+     * @param timeStep the index of the sampling step
+     */
+    std::vector<unsigned> GetLocationIndices(unsigned timeStep);
+
+    /**
+     * @return the ID of each cell stored for a sampling step.
+     *
+     * @param timeStep the index of the sampling step
+     */
+    std::vector<unsigned> GetCellIds(unsigned timeStep);
+
+    /**
+     * @return the value of a column for each cell stored for a sampling step.
+     *
+     * @param rColumnName a coordinate ("x", "y" or "z") or one of rGetValueColumnNames()
+     * @param timeStep the index of the sampling step
+     */
+    std::vector<double> GetColumn(const std::string& rColumnName, unsigned timeStep);
+
+    /**
+     * Write one text file per cell writer, named as the cell writer's own output file.
+     *
+     * Each line holds the time of a sampling step followed by a tab, then, for each
+     * cell, its location index, cell ID, centre coordinates and value, separated by
+     * spaces. This is the layout used by cell writers such as CellDataItemWriter; an
+     * exception is thrown, before any file is written, if the output of another writer
+     * is stored, since its text files cannot be recreated.
+     *
+     * @param rOutputFileHandler handler for the directory in which to write the files
+     */
+    void WriteTextFiles(OutputFileHandler& rOutputFileHandler);
+
+    /**
+     * Write one VTK point cloud per sampling step, with the value of each cell writer
+     * and the cell ID as point data, and a "results.pvd" file collecting them.
+     * Only available in 2 or 3 dimensions and when Chaste is built with VTK.
+     *
+     * @param rOutputFileHandler handler for the directory in which to write the files
+     */
+    void WriteVtkFiles(OutputFileHandler& rOutputFileHandler);
+};
+
+#endif /*CELLTRAJECTORYHDF5READER_HPP_*/
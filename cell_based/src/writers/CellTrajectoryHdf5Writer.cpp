@@ -0,0 +1,336 @@
+/*
+
+Copyright (c) 2005-2017, University of Oxford.
+All rights reserved.
+
+University of Oxford means the Chancellor, Masters and Scholars of the
+University of Oxford, having an administrative office at Wellington
+Square, Oxford OX1 2JD, UK.
+
+This file is part of Chaste.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+ * Redistributions of source code must retain the above copyright notice,
+   this list of conditions and the following disclaimer.
+ * Redistributions in binary form must reproduce the above copyright notice,
+   this list of conditions and the following disclaimer in the documentation
+   and/or other materials provided with the distribution.
+ * Neither the name of the University of Oxford nor the names of its
+   contributors may be used to endorse or promote products derived from this
+   software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+*/
+
+#include <cstring>
+#include <set>
+#include <boost/scoped_array.hpp>
+
+#include "CellTrajectoryHdf5Writer.hpp"
+#include "AbstractCellPopulation.hpp"
+#include "AbstractHdf5Access.hpp"
+#include "Exception.hpp"
+#include "PetscTools.hpp"
+#include "SimulationTime.hpp"
+
+template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+CellTrajectoryHdf5Writer<ELEMENT_DIM, SPACE_DIM>::CellTrajectoryHdf5Writer(OutputFileHandler& rOutputFileHandler,
+                                                                          const std::string& rFileName,
+                                                                          const std::vector<boost::shared_ptr<AbstractCellWriter<ELEMENT_DIM, SPACE_DIM> > >& rCellWriters)
+    : mNumTimeSteps(0),
+      mNumRows(0),
+      mIsClosed(false)
+{
+    // Work out the names of the columns, which must be distinct as they name datasets
+    const std::string location_names[3] = {"x", "y", "z"};
+    std::set<std::string> column_names;
+    column_names.insert("Time");
+    column_names.insert("Number of rows");
+    column_names.insert("Location index");
+    column_names.insert("Cell id");
+    for (unsigned i=0; i<SPACE_DIM; i++)
+    {
+        column_names.insert(location_names[i]);
+    }
+
+    std::vector<std::string> value_names;
+    std::vector<std::string> file_names;
+    std::vector<unsigned> standard_text_layouts;
+    for (unsigned i=0; i<rCellWriters.size(); i++)
+    {
+        std::string name = rCellWriters[i]->GetVtkCellDataName();
+        if (!column_names.insert(name).second)
+        {
+            EXCEPTION("Cannot write cell writer output to HDF5: the column name '" << name << "' is used more than once.");
+        }
+        value_names.push_back(name);
+        file_names.push_back(rCellWriters[i]->GetFileName());
+        standard_text_layouts.push_back(rCellWriters[i]->HasStandardTextLayout() ? 1u : 0u);
+
+        if (name.length() >= MAX_STRING_SIZE || file_names.back().length() >= MAX_STRING_SIZE)
+        {
+            EXCEPTION("Cannot write cell writer output to HDF5: the column and file names of each writer must be shorter than "
+                      << MAX_STRING_SIZE << " characters.");
+        }
+    }
+
+    // Open the file for parallel access
+    std::string file_name = rOutputFileHandler.GetOutputDirectoryFullPath() + rFileName;
+    hid_t fapl = H5Pcreate(H5P_FILE_ACCESS);
+    H5Pset_fapl_mpio(fapl, PETSC_COMM_WORLD, MPI_INFO_NULL);
+    mFileId = H5Fcreate(file_name.c_str(), H5F_ACC_TRUNC, H5P_DEFAULT, fapl);
+    H5Pclose(fapl);
+
+    if (mFileId < 0)
+    {
+        EXCEPTION("Hdf5 error in CellTrajectoryHdf5Writer: failed to create file " << file_name);
+    }
+
+    // There is one entry per sampling step in these datasets, so use small chunks
+    mTimeDatasetId = CreateDataset("Time", H5T_NATIVE_DOUBLE, 128u);
+    mNumRowsDatasetId = CreateDataset("Number of rows", H5T_NATIVE_ULLONG, 128u);
+
+    // ...and one entry per cell per sampling step in these
+    mLocationIndexDatasetId = CreateDataset("Location index", H5T_NATIVE_UINT, CHUNK_SIZE);
+    mCellIdDatasetId = CreateDataset("Cell id", H5T_NATIVE_UINT, CHUNK_SIZE);
+    for (unsigned i=0; i<SPACE_DIM; i++)
+    {
+        mLocationDatasetIds.push_back(CreateDataset(location_names[i], H5T_NATIVE_DOUBLE, CHUNK_SIZE));
+    }
+    for (unsigned i=0; i<value_names.size(); i++)
+    {
+        mValueDatasetIds.push_back(CreateDataset(value_names[i], H5T_NATIVE_DOUBLE, CHUNK_SIZE));
+    }
+
+    // Record which datasets hold cell writer values, and the text files they correspond to
+    WriteStringAttribute("Value columns", value_names);
+    WriteStringAttribute("File names", file_names);
+    WriteUnsignedAttribute("Standard text layout", standard_text_layouts);
+
+    hid_t scalar_space = H5Screate(H5S_SCALAR);
+    hid_t attr = H5Acreate(mTimeDatasetId, "Space dimension", H5T_NATIVE_UINT, scalar_space, H5P_DEFAULT, H5P_DEFAULT);
+    unsigned space_dim = SPACE_DIM;
+    H5Awrite(attr, H5T_NATIVE_UINT, &space_dim);
+    H5Aclose(attr);
+    H5Sclose(scalar_space);
+}
+
+template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+CellTrajectoryHdf5Writer<ELEMENT_DIM, SPACE_DIM>::~CellTrajectoryHdf5Writer()
+{
+    Close();
+}
+
+template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+hid_t CellTrajectoryHdf5Writer<ELEMENT_DIM, SPACE_DIM>::CreateDataset(const std::string& rName, hid_t type, hsize_t chunkSize)
+{
+    hsize_t dims[1] = {0u};
+    hsize_t max_dims[1] = {H5S_UNLIMITED};
+    hsize_t chunk_dims[1] = {chunkSize};
+
+    hid_t cparms = H5Pcreate(H5P_DATASET_CREATE);
+    H5Pset_chunk(cparms, 1, chunk_dims);
+
+    hid_t filespace = H5Screate_simple(1, dims, max_dims);
+    hid_t dataset_id = H5Dcreate(mFileId, rName.c_str(), type, filespace, H5P_DEFAULT, cparms, H5P_DEFAULT);
+
+    H5Sclose(filespace);
+    H5Pclose(cparms);
+    return dataset_id;
+}
+
+template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+void CellTrajectoryHdf5Writer<ELEMENT_DIM, SPACE_DIM>::ExtendAndWrite(hid_t datasetId, hid_t type, hsize_t newSize,
+                                                                     hsize_t offset, hsize_t count, const void* pData)
+{
+    // Extending a dataset is collective, so all processes must agree on newSize
+    hsize_t new_dims[1] = {newSize};
+    H5Dset_extent(datasetId, new_dims);
+
+    hid_t memspace, hyperslab_space;
+    if (count != 0)
+    {
+        hsize_t v_size[1] = {count};
+        memspace = H5Screate_simple(1, v_size, NULL);
+
+        hsize_t offset_dims[1] = {offset};
+        hyperslab_space = H5Dget_space(datasetId);
+        H5Sselect_hyperslab(hyperslab_space, H5S_SELECT_SET, offset_dims, NULL, v_size, NULL);
+    }
+    else
+    {
+        memspace = H5Screate(H5S_NULL);
+        hyperslab_space = H5Screate(H5S_NULL);
+    }
+
+    // Create property list for collective dataset
+    hid_t property_list_id = H5Pcreate(H5P_DATASET_XFER);
+    H5Pset_dxpl_mpio(property_list_id, H5FD_MPIO_COLLECTIVE);
+
+    H5Dwrite(datasetId, type, memspace, hyperslab_space, property_list_id, pData);
+
+    H5Pclose(property_list_id);
+    H5Sclose(hyperslab_space);
+    H5Sclose(memspace);
+}
+
+template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+void CellTrajectoryHdf5Writer<ELEMENT_DIM, SPACE_DIM>::WriteStringAttribute(const std::string& rName, const std::vector<std::string>& rValues)
+{
+    hsize_t columns[1] = {rValues.size()};
+    hid_t colspace = rValues.empty() ? H5Screate(H5S_NULL) : H5Screate_simple(1, columns, NULL);
+
+    // Copy the strings into a contiguous array of fixed-length strings
+    boost::scoped_array<char> string_array(new char[rValues.size()*MAX_STRING_SIZE + 1]);
+    memset(string_array.get(), 0, rValues.size()*MAX_STRING_SIZE + 1);
+    for (unsigned i=0; i<rValues.size(); i++)
+    {
+        assert(rValues[i].length() < MAX_STRING_SIZE);
+        strcpy(&string_array[i*MAX_STRING_SIZE], rValues[i].c_str());
+    }
+
+    hid_t string_type = H5Tcopy(H5T_C_S1);
+    H5Tset_size(string_type, MAX_STRING_SIZE);
+    hid_t attr = H5Acreate(mTimeDatasetId, rName.c_str(), string_type, colspace, H5P_DEFAULT, H5P_DEFAULT);
+    if (!rValues.empty())
+    {
+        H5Awrite(attr, string_type, string_array.get());
+    }
+
+    H5Aclose(attr);
+    H5Tclose(string_type);
+    H5Sclose(colspace);
+}
+
+template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+void CellTrajectoryHdf5Writer<ELEMENT_DIM, SPACE_DIM>::WriteUnsignedAttribute(const std::string& rName, const std::vector<unsigned>& rValues)
+{
+    hsize_t columns[1] = {rValues.size()};
+    hid_t colspace = rValues.empty() ? H5Screate(H5S_NULL) : H5Screate_simple(1, columns, NULL);
+
+    hid_t attr = H5Acreate(mTimeDatasetId, rName.c_str(), H5T_NATIVE_UINT, colspace, H5P_DEFAULT, H5P_DEFAULT);
+    if (!rValues.empty())
+    {
+        H5Awrite(attr, H5T_NATIVE_UINT, &rValues[0]);
+    }
+
+    H5Aclose(attr);
+    H5Sclose(colspace);
+}
+
+template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+void CellTrajectoryHdf5Writer<ELEMENT_DIM, SPACE_DIM>::WriteTimeStep(AbstractCellPopulation<ELEMENT_DIM, SPACE_DIM>* pCellPopulation,
+                                                                    const std::vector<boost::shared_ptr<AbstractCellWriter<ELEMENT_DIM, SPACE_DIM> > >& rCellWriters)
+{
+    assert(!mIsClosed);
+    assert(rCellWriters.size() == mValueDatasetIds.size());
+
+    // Gather the columns for the cells owned by this process
+    std::vector<unsigned> location_indices;
+    std::vector<unsigned> cell_ids;
+    std::vector<std::vector<double> > locations(SPACE_DIM);
+    std::vector<std::vector<double> > values(rCellWriters.size());
+
+    for (typename AbstractCellPopulation<ELEMENT_DIM, SPACE_DIM>::Iterator cell_iter = pCellPopulation->Begin();
+         cell_iter != pCellPopulation->End();
+         ++cell_iter)
+    {
+        location_indices.push_back(pCellPopulation->GetLocationIndexUsingCell(*cell_iter));
+        cell_ids.push_back(cell_iter->GetCellId());
+
+        c_vector<double, SPACE_DIM> centre_location = pCellPopulation->GetLocationOfCellCentre(*cell_iter);
+        for (unsigned i=0; i<SPACE_DIM; i++)
+        {
+            locations[i].push_back(centre_location[i]);
+        }
+
+        for (unsigned i=0; i<rCellWriters.size(); i++)
+        {
+            values[i].push_back(rCellWriters[i]->GetCellDataForVtkOutput(*cell_iter, pCellPopulation));
+        }
+    }
+
+    // Work out where this process's rows go
+    unsigned long long num_local_rows = location_indices.size();
+    unsigned long long num_rows_up_to_me = 0;
+    unsigned long long num_new_rows = 0;
+    MPI_Scan(&num_local_rows, &num_rows_up_to_me, 1, MPI_UNSIGNED_LONG_LONG, MPI_SUM, PETSC_COMM_WORLD);
+    MPI_Allreduce(&num_local_rows, &num_new_rows, 1, MPI_UNSIGNED_LONG_LONG, MPI_SUM, PETSC_COMM_WORLD);
+
+    hsize_t new_size = mNumRows + num_new_rows;
+    hsize_t offset = mNumRows + num_rows_up_to_me - num_local_rows;
+
+    // All processes write their rows at the same time
+    ExtendAndWrite(mLocationIndexDatasetId, H5T_NATIVE_UINT, new_size, offset, num_local_rows,
+                   num_local_rows > 0 ? &location_indices[0] : NULL);
+    ExtendAndWrite(mCellIdDatasetId, H5T_NATIVE_UINT, new_size, offset, num_local_rows,
+                   num_local_rows > 0 ? &cell_ids[0] : NULL);
+    for (unsigned i=0; i<SPACE_DIM; i++)
+    {
+        ExtendAndWrite(mLocationDatasetIds[i], H5T_NATIVE_DOUBLE, new_size, offset, num_local_rows,
+                       num_local_rows > 0 ? &locations[i][0] : NULL);
+    }
+    for (unsigned i=0; i<rCellWriters.size(); i++)
+    {
+        ExtendAndWrite(mValueDatasetIds[i], H5T_NATIVE_DOUBLE, new_size, offset, num_local_rows,
+                       num_local_rows > 0 ? &values[i][0] : NULL);
+    }
+
+    // The master process writes the time and row count of this sampling step
+    double time = SimulationTime::Instance()->GetTime();
+    hsize_t num_master_entries = PetscTools::AmMaster() ? 1u : 0u;
+    ExtendAndWrite(mTimeDatasetId, H5T_NATIVE_DOUBLE, mNumTimeSteps+1, mNumTimeSteps, num_master_entries, &time);
+    ExtendAndWrite(mNumRowsDatasetId, H5T_NATIVE_ULLONG, mNumTimeSteps+1, mNumTimeSteps, num_master_entries, &num_new_rows);
+
+    mNumRows = new_size;
+    mNumTimeSteps++;
+}
+
+template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+void CellTrajectoryHdf5Writer<ELEMENT_DIM, SPACE_DIM>::Close()
+{
+    if (mIsClosed)
+    {
+        return;
+    }
+
+    H5Dclose(mTimeDatasetId);
+    H5Dclose(mNumRowsDatasetId);
+    H5Dclose(mLocationIndexDatasetId);
+    H5Dclose(mCellIdDatasetId);
+    for (unsigned i=0; i<mLocationDatasetIds.size(); i++)
+    {
+        H5Dclose(mLocationDatasetIds[i]);
+    }
+    for (unsigned i=0; i<mValueDatasetIds.size(); i++)
+    {
+        H5Dclose(mValueDatasetIds[i]);
+    }
+    H5Fclose(mFileId);
+    mIsClosed = true;
+}
+
+template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+unsigned CellTrajectoryHdf5Writer<ELEMENT_DIM, SPACE_DIM>::GetNumTimeSteps() const
+{
+    return mNumTimeSteps;
+}
+
+// Explicit instantiation
+template class CellTrajectoryHdf5Writer<1,1>;
+template class CellTrajectoryHdf5Writer<1,2>;
+template class CellTrajectoryHdf5Writer<2,2>;
+template class CellTrajectoryHdf5Writer<1,3>;
+template class CellTrajectoryHdf5Writer<2,3>;
+template class CellTrajectoryHdf5Writer<3,3>;
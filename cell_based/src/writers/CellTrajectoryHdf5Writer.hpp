@@ -0,0 +1,184 @@
+/*
+
+Copyright (c) 2005-2017, University of Oxford.
+All rights reserved.
+
+University of Oxford means the Chancellor, Masters and Scholars of the
+University of Oxford, having an administrative office at Wellington
+Square, Oxford OX1 2JD, UK.
+
+This file is part of Chaste.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+ * Redistributions of source code must retain the above copyright notice,
+   this list of conditions and the following disclaimer.
+ * Redistributions in binary form must reproduce the above copyright notice,
+   this list of conditions and the following disclaimer in the documentation
+   and/or other materials provided with the distribution.
+ * Neither the name of the University of Oxford nor the names of its
+   contributors may be used to endorse or promote products derived from this
+   software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+*/
+
+#ifndef CELLTRAJECTORYHDF5WRITER_HPP_
+#define CELLTRAJECTORYHDF5WRITER_HPP_
+
+#include <hdf5.h>
+#include <string>
+#include <vector>
+#include <boost/shared_ptr.hpp>
+
+#include "AbstractCellWriter.hpp"
+#include "OutputFileHandler.hpp"
+
+// Forward declaration prevents circular include chain
+template<unsigned ELEMENT_DIM, unsigned SPACE_DIM> class AbstractCellPopulation;
+
+/**
+ * A columnar binary alternative to the text output of cell writers.
+ *
+ * Each time WriteTimeStep() is called, one row per cell is appended to a set of
+ * extendable one-dimensional HDF5 datasets: "Location index", "Cell id", one dataset
+ * per spatial coordinate ("x", "y", "z"), and one dataset per cell writer, named after
+ * the writer's VTK cell data name and holding the value returned by
+ * AbstractCellWriter::GetCellDataForVtkOutput(). The "Time" and "Number of rows"
+ * datasets record the time of each sampling step and how many rows it added. Attributes
+ * of "Time" record the text file of each writer and whether its text output can be
+ * recreated from these columns (see AbstractCellWriter::HasStandardTextLayout()).
+ *
+ * The file is opened once, when the writer is constructed, and kept open until Close()
+ * is called. All processes write their own cells at the same time using collective
+ * MPI-IO, so no round robin is needed. CellTrajectoryHdf5Reader reads the file back
+ * and converts it to text or VTK output.
+ */
+template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+class CellTrajectoryHdf5Writer
+{
+private:
+
+    /** The number of rows in each chunk of the per-cell datasets. */
+    static const hsize_t CHUNK_SIZE = 4096u;
+
+    /** The HDF5 file. */
+    hid_t mFileId;
+
+    /** The "Time" dataset. */
+    hid_t mTimeDatasetId;
+
+    /** The "Number of rows" dataset. */
+    hid_t mNumRowsDatasetId;
+
+    /** The "Location index" dataset. */
+    hid_t mLocationIndexDatasetId;
+
+    /** The "Cell id" dataset. */
+    hid_t mCellIdDatasetId;
+
+    /** The datasets holding the coordinates of each cell centre. */
+    std::vector<hid_t> mLocationDatasetIds;
+
+    /** The datasets holding the value of each cell writer. */
+    std::vector<hid_t> mValueDatasetIds;
+
+    /** The number of sampling steps written so far. */
+    hsize_t mNumTimeSteps;
+
+    /** The number of rows in each per-cell dataset written so far. */
+    hsize_t mNumRows;
+
+    /** Whether the file has been closed. */
+    bool mIsClosed;
+
+    /**
+     * Create an empty, extendable, chunked one-dimensional dataset.
+     *
+     * @param rName the name of the dataset
+     * @param type the HDF5 type of the data
+     * @param chunkSize the number of entries in each chunk
+     * @return the dataset
+     */
+    hid_t CreateDataset(const std::string& rName, hid_t type, hsize_t chunkSize);
+
+    /**
+     * Extend a dataset to a new size and write a contiguous block of entries collectively.
+     * Every process must call this method, even if it has no entries to write.
+     *
+     * @param datasetId the dataset
+     * @param type the HDF5 type of the data in memory
+     * @param newSize the new size of the dataset
+     * @param offset the position of the first entry written by this process
+     * @param count the number of entries written by this process
+     * @param pData the entries written by this process
+     */
+    void ExtendAndWrite(hid_t datasetId, hid_t type, hsize_t newSize, hsize_t offset, hsize_t count, const void* pData);
+
+    /**
+     * Write an array of fixed-length strings as an attribute of the "Time" dataset.
+     *
+     * @param rName the name of the attribute
+     * @param rValues the strings to write
+     */
+    void WriteStringAttribute(const std::string& rName, const std::vector<std::string>& rValues);
+
+    /**
+     * Write an array of unsigned integers as an attribute of the "Time" dataset.
+     *
+     * @param rName the name of the attribute
+     * @param rValues the values to write
+     */
+    void WriteUnsignedAttribute(const std::string& rName, const std::vector<unsigned>& rValues);
+
+public:
+
+    /**
+     * Constructor. Creates the file, overwriting any existing file of the same name.
+     * This method is collective.
+     *
+     * @param rOutputFileHandler handler for the directory in which to create the file
+     * @param rFileName the name of the file
+     * @param rCellWriters the cell writers whose values will be written
+     */
+    CellTrajectoryHdf5Writer(OutputFileHandler& rOutputFileHandler,
+                             const std::string& rFileName,
+                             const std::vector<boost::shared_ptr<AbstractCellWriter<ELEMENT_DIM, SPACE_DIM> > >& rCellWriters);
+
+    /**
+     * Destructor. Closes the file if Close() has not been called.
+     */
+    ~CellTrajectoryHdf5Writer();
+
+    /**
+     * Append the data for every cell in a population at the current time.
+     * This method is collective.
+     *
+     * @param pCellPopulation the cell population
+     * @param rCellWriters the cell writers passed to the constructor
+     */
+    void WriteTimeStep(AbstractCellPopulation<ELEMENT_DIM, SPACE_DIM>* pCellPopulation,
+                       const std::vector<boost::shared_ptr<AbstractCellWriter<ELEMENT_DIM, SPACE_DIM> > >& rCellWriters);
+
+    /**
+     * Close the file. This method is collective.
+     */
+    void Close();
+
+    /**
+     * @return the number of sampling steps written so far.
+     */
+    unsigned GetNumTimeSteps() const;
+};
+
+#endif /*CELLTRAJECTORYHDF5WRITER_HPP_*/
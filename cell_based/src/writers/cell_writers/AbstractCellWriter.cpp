@@ -53,6 +53,12 @@ std::string AbstractCellWriter<ELEMENT_DIM, SPACE_DIM>::GetVtkCellDataName()
     return mVtkCellDataName;
 }
 
+template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+bool AbstractCellWriter<ELEMENT_DIM, SPACE_DIM>::HasStandardTextLayout()
+{
+    return false;
+}
+
 // Explicit instantiation
 template class AbstractCellWriter<1,1>;
 template class AbstractCellWriter<1,2>;
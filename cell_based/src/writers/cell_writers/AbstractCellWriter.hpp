@@ -106,6 +106,14 @@ public:
      */
     virtual void VisitCell(CellPtr pCell, AbstractCellPopulation<ELEMENT_DIM, SPACE_DIM>* pCellPopulation)=0;
 
+    /**
+     * @return whether VisitCell() writes, for each cell, its location index, cell ID,
+     * centre coordinates and the value returned by GetCellDataForVtkOutput(), in that
+     * order. Only then can CellTrajectoryHdf5Reader recreate this writer's text output
+     * from HDF5 output. Defaults to false; subclasses using this layout override it.
+     */
+    virtual bool HasStandardTextLayout();
+
     /**
      * Set the name of the cell data used in VTK output.
      * This method allows the user to change mVtkCellDataName from
@@ -51,6 +51,12 @@ double CellDataItemWriter<ELEMENT_DIM, SPACE_DIM>::GetCellDataForVtkOutput(CellP
     return value;
 }
 
+template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+bool CellDataItemWriter<ELEMENT_DIM, SPACE_DIM>::HasStandardTextLayout()
+{
+    return true;
+}
+
 template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
 void CellDataItemWriter<ELEMENT_DIM, SPACE_DIM>::VisitCell(CellPtr pCell, AbstractCellPopulation<ELEMENT_DIM, SPACE_DIM>* pCellPopulation)
 {
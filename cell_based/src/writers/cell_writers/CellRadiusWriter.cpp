@@ -55,6 +55,12 @@ double CellRadiusWriter<ELEMENT_DIM, SPACE_DIM>::GetCellDataForVtkOutput(CellPtr
     return cell_radius;
 }
 
+template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+bool CellRadiusWriter<ELEMENT_DIM, SPACE_DIM>::HasStandardTextLayout()
+{
+    return true;
+}
+
 template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
 void CellRadiusWriter<ELEMENT_DIM, SPACE_DIM>::VisitCell(CellPtr pCell, AbstractCellPopulation<ELEMENT_DIM, SPACE_DIM>* pCellPopulation)
 {
@@ -61,6 +61,12 @@ double CellRosetteRankWriter<ELEMENT_DIM, SPACE_DIM>::GetCellDataForVtkOutput(Ce
     return double(rosette_rank);
 }
 
+template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+bool CellRosetteRankWriter<ELEMENT_DIM, SPACE_DIM>::HasStandardTextLayout()
+{
+    return true;
+}
+
 template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
 void CellRosetteRankWriter<ELEMENT_DIM, SPACE_DIM>::VisitCell(CellPtr pCell, AbstractCellPopulation<ELEMENT_DIM, SPACE_DIM>* pCellPopulation)
 {
@@ -85,6 +85,13 @@ public:
      */
     double GetCellDataForVtkOutput(CellPtr pCell, AbstractCellPopulation<ELEMENT_DIM, SPACE_DIM>* pCellPopulation);
 
+    /**
+     * Overridden HasStandardTextLayout() method.
+     *
+     * @return true, as VisitCell() writes the location index, cell ID, coordinates and value of each cell
+     */
+    bool HasStandardTextLayout();
+
     /**
      * Overridden VisitCell() method.
      *
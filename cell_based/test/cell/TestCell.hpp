@@ -63,6 +63,8 @@ OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "DifferentiatedCellProliferativeType.hpp"
 #include "ApoptoticCellProperty.hpp"
 #include "CellAncestor.hpp"
+#include "CellBasedObjectPool.hpp"
+#include "CellBasedEventHandler.hpp"
 
 #include "AbstractCellBasedTestSuite.hpp"
 #include "FakePetscSetup.hpp"
@@ -437,6 +439,82 @@ public:
         TS_ASSERT_EQUALS(p_daughter_cell->ReadyToDivide(), true);
     }
 
+    void TestPooledAllocationOnDivision()
+    {
+        SimulationTime* p_simulation_time = SimulationTime::Instance();
+        p_simulation_time->SetEndTimeAndNumberOfTimeSteps(30.0, 5);
+
+        boost::shared_ptr<AbstractCellProperty> p_healthy_state(CellPropertyRegistry::Instance()->Get<WildTypeCellMutationState>());
+        boost::shared_ptr<AbstractCellProperty> p_type(CellPropertyRegistry::Instance()->Get<StemCellProliferativeType>());
+
+        // Create two stem cells, which will be ready to divide at t=30
+        std::vector<CellPtr> cells;
+        for (unsigned i=0; i<2; i++)
+        {
+            CellPtr p_cell(new Cell(p_healthy_state, new FixedG1GenerationalCellCycleModel()));
+            p_cell->SetCellProliferativeType(p_type);
+            p_cell->InitialiseCellCycleModel();
+            cells.push_back(p_cell);
+        }
+        for (unsigned i=0; i<5; i++)
+        {
+            p_simulation_time->IncrementTimeOneStep();
+        }
+
+        CellBasedEventHandler::ResetAllocationCounts();
+
+        // The daughter cell, its models and its cell data are each drawn from a pool
+        TS_ASSERT_EQUALS(cells[0]->ReadyToDivide(), true);
+        CellPtr p_daughter_cell = cells[0]->Divide();
+        TS_ASSERT_EQUALS(CellBasedEventHandler::GetNumAllocations(CellBasedEventHandler::CELL_OBJECTS), 1u);
+        TS_ASSERT_EQUALS(CellBasedEventHandler::GetNumAllocations(CellBasedEventHandler::CELL_CYCLE_MODEL_OBJECTS), 1u);
+        TS_ASSERT_EQUALS(CellBasedEventHandler::GetNumAllocations(CellBasedEventHandler::SRN_MODEL_OBJECTS), 1u);
+        TS_ASSERT_EQUALS(CellBasedEventHandler::GetNumAllocations(CellBasedEventHandler::CELL_DATA_OBJECTS), 1u);
+
+        // The pools get the memory back when the daughter cell is destroyed...
+        p_daughter_cell.reset();
+        TS_ASSERT_EQUALS(CellBasedEventHandler::GetNumDeallocations(CellBasedEventHandler::CELL_OBJECTS), 1u);
+        TS_ASSERT_EQUALS(CellBasedEventHandler::GetNumDeallocations(CellBasedEventHandler::CELL_CYCLE_MODEL_OBJECTS), 1u);
+        TS_ASSERT_EQUALS(CellBasedEventHandler::GetNumDeallocations(CellBasedEventHandler::SRN_MODEL_OBJECTS), 1u);
+        TS_ASSERT_EQUALS(CellBasedEventHandler::GetNumDeallocations(CellBasedEventHandler::CELL_DATA_OBJECTS), 1u);
+        TS_ASSERT_LESS_THAN(0u, CellBasedObjectPool::Instance(CellBasedEventHandler::CELL_CYCLE_MODEL_OBJECTS)->GetNumFreeObjects(sizeof(FixedG1GenerationalCellCycleModel)));
+
+        // ...and reuse it for the next division
+        TS_ASSERT_EQUALS(cells[1]->ReadyToDivide(), true);
+        p_daughter_cell = cells[1]->Divide();
+        TS_ASSERT_EQUALS(CellBasedEventHandler::GetNumReusedAllocations(CellBasedEventHandler::CELL_OBJECTS), 1u);
+        TS_ASSERT_EQUALS(CellBasedEventHandler::GetNumReusedAllocations(CellBasedEventHandler::CELL_CYCLE_MODEL_OBJECTS), 1u);
+        TS_ASSERT_EQUALS(CellBasedEventHandler::GetNumReusedAllocations(CellBasedEventHandler::SRN_MODEL_OBJECTS), 1u);
+        TS_ASSERT_EQUALS(CellBasedEventHandler::GetNumReusedAllocations(CellBasedEventHandler::CELL_DATA_OBJECTS), 1u);
+        TS_ASSERT_EQUALS(p_daughter_cell->GetCellProliferativeType()->IsType<TransitCellProliferativeType>(), true);
+        TS_ASSERT_EQUALS(p_daughter_cell->GetCellData()->GetNumItems(), 0u);
+    }
+
+    void TestObjectPoolOwnership()
+    {
+        CellBasedObjectPool* p_pool = CellBasedObjectPool::Instance(CellBasedEventHandler::CELL_DATA_OBJECTS);
+
+        // Pooled objects are owned by the pool, for the size they were allocated with only
+        void* p_small = p_pool->Allocate(24);
+        TS_ASSERT_EQUALS(p_pool->OwnsObject(p_small, 24), true);
+        TS_ASSERT_EQUALS(p_pool->OwnsObject(p_small, 100), false);
+        TS_ASSERT_EQUALS(p_pool->OwnsObject(static_cast<char*>(p_small) + 8, 24), false);
+
+        // ...and not by the other pools
+        TS_ASSERT_EQUALS(CellBasedObjectPool::Instance(CellBasedEventHandler::CELL_OBJECTS)->OwnsObject(p_small, 24), false);
+
+        // Memory from elsewhere is never owned
+        double on_stack;
+        TS_ASSERT_EQUALS(p_pool->OwnsObject(&on_stack, sizeof(double)), false);
+        void* p_large = p_pool->Allocate(4096);
+        TS_ASSERT_EQUALS(p_pool->OwnsObject(p_large, 4096), false);
+
+        unsigned num_free = p_pool->GetNumFreeObjects(24);
+        p_pool->Deallocate(p_small, 24);
+        p_pool->Deallocate(p_large, 4096);
+        TS_ASSERT_EQUALS(p_pool->GetNumFreeObjects(24), num_free + 1);
+    }
+
     void Test0DBucket()
     {
         double end_time = 61.0;
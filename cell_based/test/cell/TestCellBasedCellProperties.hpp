@@ -42,6 +42,7 @@ OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include "CellId.hpp"
 #include "CellData.hpp"
+#include "CellDataItemRegistry.hpp"
 
 #include "CellPropertyRegistry.hpp"
 
@@ -140,6 +141,68 @@ public:
         TS_ASSERT_EQUALS(p_cell_data->GetNumItems(), 3u);
     }
 
+    void TestCellDataItemRegistry() throw(Exception)
+    {
+        CellDataItemRegistry* p_registry = CellDataItemRegistry::Instance();
+        TS_ASSERT_EQUALS(p_registry, CellDataItemRegistry::Instance());
+
+        // Slots are assigned once per name and never change
+        unsigned num_slots = p_registry->GetNumSlots();
+        unsigned slot = p_registry->GetSlot("a registry test item");
+        TS_ASSERT_EQUALS(slot, num_slots);
+        TS_ASSERT_EQUALS(p_registry->GetNumSlots(), num_slots + 1);
+        TS_ASSERT_EQUALS(p_registry->GetSlot("a registry test item"), slot);
+        TS_ASSERT_EQUALS(p_registry->GetNumSlots(), num_slots + 1);
+        TS_ASSERT_EQUALS(p_registry->rGetName(slot), "a registry test item");
+
+        TS_ASSERT_THROWS_CONTAINS(p_registry->rGetName(num_slots + 1),
+                                  "No cell data item has been registered in slot");
+
+        // Looking up a name does not register it
+        TS_ASSERT_EQUALS(p_registry->FindSlot("a registry test item"), slot);
+        TS_ASSERT_EQUALS(p_registry->FindSlot("an unregistered item"), UNSIGNED_UNSET);
+        TS_ASSERT_EQUALS(p_registry->GetNumSlots(), num_slots + 1);
+
+        // Nor does asking a CellData object for an absent item
+        MAKE_PTR(CellData, p_cell_data);
+        TS_ASSERT_THROWS_THIS(p_cell_data->GetItem("an unregistered item"), "The item an unregistered item is not stored");
+        TS_ASSERT_EQUALS(p_registry->GetNumSlots(), num_slots + 1);
+    }
+
+    void TestCellDataSlotMethods() throw(Exception)
+    {
+        CellDataItemRegistry* p_registry = CellDataItemRegistry::Instance();
+        unsigned zebra_slot = p_registry->GetSlot("zebra");
+        unsigned aardvark_slot = p_registry->GetSlot("aardvark");
+
+        MAKE_PTR(CellData, p_cell_data);
+        TS_ASSERT_THROWS_THIS(p_cell_data->GetItem(zebra_slot), "The item zebra is not stored");
+
+        // The slot-based and name-based methods address the same items
+        p_cell_data->SetItem(zebra_slot, 1.0);
+        p_cell_data->SetItem("aardvark", 2.0);
+        TS_ASSERT_DELTA(p_cell_data->GetItem("zebra"), 1.0, 1e-8);
+        TS_ASSERT_DELTA(p_cell_data->GetItem(aardvark_slot), 2.0, 1e-8);
+        TS_ASSERT_EQUALS(p_cell_data->GetNumItems(), 2u);
+
+        // Overwriting an item does not change the number of items
+        p_cell_data->SetItem(zebra_slot, 3.0);
+        TS_ASSERT_DELTA(p_cell_data->GetItem("zebra"), 3.0, 1e-8);
+        TS_ASSERT_EQUALS(p_cell_data->GetNumItems(), 2u);
+
+        // Keys are returned in alphabetical order, regardless of slot order
+        std::vector<std::string> keys = p_cell_data->GetKeys();
+        TS_ASSERT_EQUALS(keys.size(), 2u);
+        TS_ASSERT_EQUALS(keys[0], "aardvark");
+        TS_ASSERT_EQUALS(keys[1], "zebra");
+
+        // A copy has its own values
+        CellData cell_data_copy(*p_cell_data);
+        cell_data_copy.SetItem(aardvark_slot, 4.0);
+        TS_ASSERT_DELTA(cell_data_copy.GetItem(aardvark_slot), 4.0, 1e-8);
+        TS_ASSERT_DELTA(p_cell_data->GetItem(aardvark_slot), 2.0, 1e-8);
+    }
+
     void TestArchiveCellData() throw(Exception)
     {
         OutputFileHandler handler("archive", false);
@@ -181,6 +244,7 @@ public:
 
             TS_ASSERT_DELTA(p_real_cell_data->GetItem("thing1"), 1.0, 1e-8);
             TS_ASSERT_DELTA(p_real_cell_data->GetItem("thing2"), 2.0, 1e-8);
+            TS_ASSERT_EQUALS(p_real_cell_data->GetNumItems(), 2u);
 
             // Tidy up
             delete p_cell_data;
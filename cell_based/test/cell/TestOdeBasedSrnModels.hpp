@@ -56,6 +56,8 @@ OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "DifferentiatedCellProliferativeType.hpp"
 #include "SmartPointers.hpp"
 #include "FileComparison.hpp"
+#include "RungeKutta4IvpOdeSolver.hpp"
+#include "BatchedCellOdeSolver.hpp"
 
 // This test is always run sequentially (never in parallel)
 #include "FakePetscSetup.hpp"
@@ -328,6 +330,98 @@ public:
         }
     }
 
+    void TestBatchedSolveOfSrnOdes() throw(Exception)
+    {
+        // The default Delta-Notch solver may be CVODE, so use RK4 explicitly
+        boost::shared_ptr<AbstractCellCycleModelOdeSolver> p_solver(CellCycleModelOdeSolver<DeltaNotchSrnModel, RungeKutta4IvpOdeSolver>::Instance());
+        p_solver->Initialise();
+
+        // An SRN model without an ODE system cannot be batched
+        Goldbeter1991SrnModel uninitialised_model;
+        TS_ASSERT_EQUALS(uninitialised_model.CanSolveOdesInBatch(), false);
+
+        MAKE_PTR(WildTypeCellMutationState, p_healthy_state);
+        MAKE_PTR(DifferentiatedCellProliferativeType, p_diff_type);
+
+        // Create identical pairs of cells, one of each pair to be solved alone and the other in a batch
+        std::vector<CellPtr> cells;
+        std::vector<AbstractOdeSrnModel*> single_models;
+        std::vector<AbstractOdeSrnModel*> batched_models;
+        for (unsigned i=0; i<8; i++)
+        {
+            AbstractOdeSrnModel* p_srn_model;
+            std::vector<double> starter_conditions;
+            if (i%4 < 3)
+            {
+                p_srn_model = new DeltaNotchSrnModel(p_solver);
+                p_srn_model->SetDt(0.001);
+                starter_conditions.push_back(0.1 + 0.2*(i%4));
+                starter_conditions.push_back(0.8 - 0.2*(i%4));
+            }
+            else
+            {
+                p_srn_model = new Goldbeter1991SrnModel();
+                starter_conditions.push_back(0.5);
+                starter_conditions.push_back(0.6);
+                starter_conditions.push_back(0.7);
+            }
+            p_srn_model->SetInitialConditions(starter_conditions);
+
+            CellPtr p_cell(new Cell(p_healthy_state, new UniformG1GenerationalCellCycleModel(), p_srn_model, false, CellPropertyCollection()));
+            p_cell->SetCellProliferativeType(p_diff_type);
+            p_cell->GetCellData()->SetItem("mean delta", 0.3*(i%4));
+            p_cell->InitialiseCellCycleModel();
+            p_cell->InitialiseSrnModel();
+            cells.push_back(p_cell);
+
+            TS_ASSERT_EQUALS(p_srn_model->CanSolveOdesInBatch(), true);
+            if (i < 4)
+            {
+                single_models.push_back(p_srn_model);
+            }
+            else
+            {
+                batched_models.push_back(p_srn_model);
+            }
+        }
+
+        std::vector<CellCycleModelOdeHandler*> handlers(batched_models.begin(), batched_models.end());
+        BatchedCellOdeSolver batched_solver;
+
+        SimulationTime* p_simulation_time = SimulationTime::Instance();
+        p_simulation_time->SetEndTimeAndNumberOfTimeSteps(2.0, 20);
+        while (!p_simulation_time->IsFinished())
+        {
+            p_simulation_time->IncrementTimeOneStep();
+            double current_time = p_simulation_time->GetTime();
+
+            for (unsigned i=0; i<single_models.size(); i++)
+            {
+                single_models[i]->SimulateToCurrentTime();
+            }
+            CellCycleModelOdeHandler::SolveOdesToTimeInBatch(handlers, current_time, batched_solver);
+
+            // The batched path takes exactly the same steps as the per-cell path
+            for (unsigned i=0; i<batched_models.size(); i++)
+            {
+                TS_ASSERT_DELTA(batched_models[i]->GetLastTime(), current_time, 1e-12);
+                std::vector<double> single = single_models[i]->GetProteinConcentrations();
+                std::vector<double> batched = batched_models[i]->GetProteinConcentrations();
+                for (unsigned j=0; j<single.size(); j++)
+                {
+                    TS_ASSERT_DELTA(batched[j], single[j], 1e-12);
+                }
+            }
+
+            // Running the per-cell path afterwards should have nothing left to do
+            batched_models[0]->SimulateToCurrentTime();
+            TS_ASSERT_DELTA(batched_models[0]->GetProteinConcentrations()[0], single_models[0]->GetProteinConcentrations()[0], 1e-12);
+        }
+
+        // The mean neighbouring Delta was updated before solving
+        TS_ASSERT_DELTA(static_cast<DeltaNotchSrnModel*>(batched_models[2])->GetMeanNeighbouringDelta(), 0.6, 1e-12);
+    }
+
     void TestSrnModelOutputParameters()
     {
         std::string output_directory = "TestSrnModelOutputParameters";
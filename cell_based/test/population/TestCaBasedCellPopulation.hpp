@@ -56,6 +56,7 @@ OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "SmartPointers.hpp"
 #include "CellLabel.hpp"
 #include "FileComparison.hpp"
+#include "RandomNumberGenerator.hpp"
 
 // Cell writers
 #include "CellAgesWriter.hpp"
@@ -733,6 +734,93 @@ public:
         TS_ASSERT(neighbours_of_cell_0 == expected_neighbours_of_cell_0);
     }
 
+    void TestUpdateCellLocationsOnCheckerboard()
+    {
+        // Run the same checkerboard updates twice from the same seed
+        std::vector<std::vector<unsigned> > final_locations(2);
+        for (unsigned run=0; run<2; run++)
+        {
+            RandomNumberGenerator::Instance()->Reseed(0);
+
+            PottsMeshGenerator<2> generator(10, 0, 0, 10, 0, 0);
+            PottsMesh<2>* p_mesh = generator.GetMesh();
+
+            std::vector<CellPtr> cells;
+            CellsGenerator<FixedG1GenerationalCellCycleModel, 2> cells_generator;
+            cells_generator.GenerateBasic(cells, 20);
+
+            std::vector<unsigned> location_indices;
+            for (unsigned i=0; i<20; i++)
+            {
+                location_indices.push_back(5*i);
+            }
+
+            CaBasedCellPopulation<2u> cell_population(*p_mesh, cells, location_indices);
+            TS_ASSERT_EQUALS(cell_population.GetNumCheckerboardPartitions(), 0u);
+            cell_population.SetNumCheckerboardPartitions(3);
+            TS_ASSERT_EQUALS(cell_population.GetNumCheckerboardPartitions(), 3u);
+
+            MAKE_PTR(DiffusionCaUpdateRule<2u>, p_diffusion_update_rule);
+            p_diffusion_update_rule->SetDiffusionParameter(1.0);
+            cell_population.AddUpdateRule(p_diffusion_update_rule);
+
+            // Exceptions thrown while proposing moves are passed on
+            TS_ASSERT_THROWS_THIS(cell_population.UpdateCellLocations(-1.0),
+                "The probability of cellular movement is smaller than zero. In order to prevent it from happening you should change your time step and parameters");
+
+            for (unsigned step=0; step<10; step++)
+            {
+                cell_population.UpdateCellLocations(0.1);
+            }
+
+            // No cells are lost and no site holds more than one cell
+            TS_ASSERT_EQUALS(cell_population.GetNumRealCells(), 20u);
+            std::set<unsigned> occupied_sites;
+            for (AbstractCellPopulation<2>::Iterator cell_iter = cell_population.Begin();
+                 cell_iter != cell_population.End();
+                 ++cell_iter)
+            {
+                unsigned location_index = cell_population.GetLocationIndexUsingCell(*cell_iter);
+                final_locations[run].push_back(location_index);
+                occupied_sites.insert(location_index);
+                TS_ASSERT_EQUALS(cell_population.rGetAvailableSpaces()[location_index], 0u);
+            }
+            TS_ASSERT_EQUALS(occupied_sites.size(), 20u);
+        }
+
+        // The cells are listed in their original order, so we can check that some have moved
+        TS_ASSERT(final_locations[0] == final_locations[1]);
+        unsigned num_moved = 0;
+        for (unsigned i=0; i<20; i++)
+        {
+            if (final_locations[0][i] != 5*i)
+            {
+                num_moved++;
+            }
+        }
+        TS_ASSERT_LESS_THAN(0u, num_moved);
+    }
+
+    void TestUpdateCellLocationsOnCheckerboardExceptions()
+    {
+        PottsMeshGenerator<2> generator(5, 0, 0, 5, 0, 0);
+        PottsMesh<2>* p_mesh = generator.GetMesh();
+
+        std::vector<CellPtr> cells;
+        CellsGenerator<FixedG1GenerationalCellCycleModel, 2> cells_generator;
+        cells_generator.GenerateBasic(cells, 1);
+
+        std::vector<unsigned> location_indices(1, 12);
+        CaBasedCellPopulation<2u> cell_population(*p_mesh, cells, location_indices, 2);
+        cell_population.SetNumCheckerboardPartitions(2);
+
+        MAKE_PTR(DiffusionCaUpdateRule<2u>, p_diffusion_update_rule);
+        cell_population.AddUpdateRule(p_diffusion_update_rule);
+
+        TS_ASSERT_THROWS_THIS(cell_population.UpdateCellLocations(0.1),
+            "Checkerboard updates of a CaBasedCellPopulation require a lattice carrying capacity of 1.");
+    }
+
     void TestUpdateCellLocationsRandomlyExceptions()
     {
         // Create a simple 2D PottsMesh with two cells
@@ -0,0 +1,336 @@
+/*
+
+Copyright (c) 2005-2017, University of Oxford.
+All rights reserved.
+
+University of Oxford means the Chancellor, Masters and Scholars of the
+University of Oxford, having an administrative office at Wellington
+Square, Oxford OX1 2JD, UK.
+
+This file is part of Chaste.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+ * Redistributions of source code must retain the above copyright notice,
+   this list of conditions and the following disclaimer.
+ * Redistributions in binary form must reproduce the above copyright notice,
+   this list of conditions and the following disclaimer in the documentation
+   and/or other materials provided with the distribution.
+ * Neither the name of the University of Oxford nor the names of its
+   contributors may be used to endorse or promote products derived from this
+   software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+*/
+
+#ifndef TESTCELLLOCATIONINDEXMAP_HPP_
+#define TESTCELLLOCATIONINDEXMAP_HPP_
+
+#include <cxxtest/TestSuite.h>
+
+#include <map>
+#include <set>
+
+#include "CellsGenerator.hpp"
+#include "CellLocationIndexMap.hpp"
+#include "NodeMap.hpp"
+#include "MeshBasedCellPopulation.hpp"
+#include "VertexBasedCellPopulation.hpp"
+#include "PottsBasedCellPopulation.hpp"
+#include "HoneycombMeshGenerator.hpp"
+#include "HoneycombVertexMeshGenerator.hpp"
+#include "PottsMeshGenerator.hpp"
+#include "FixedCentreBasedDivisionRule.hpp"
+#include "FixedG1GenerationalCellCycleModel.hpp"
+#include "WildTypeCellMutationState.hpp"
+#include "StemCellProliferativeType.hpp"
+#include "AbstractCellBasedTestSuite.hpp"
+#include "SmartPointers.hpp"
+#include "Warnings.hpp"
+#include "FakePetscSetup.hpp"
+
+class TestCellLocationIndexMap : public AbstractCellBasedTestSuite
+{
+private:
+
+    /**
+     * Check that every cell in a population is attached to its own location
+     * index, and that looking the cell up by that location index finds it again.
+     *
+     * @param rCellPopulation the cell population
+     */
+    template<class POPULATION>
+    void CheckCellLocationsAreConsistent(POPULATION& rCellPopulation)
+    {
+        std::set<unsigned> location_indices;
+        for (std::list<CellPtr>::iterator cell_iter = rCellPopulation.rGetCells().begin();
+             cell_iter != rCellPopulation.rGetCells().end();
+             ++cell_iter)
+        {
+            unsigned location_index = rCellPopulation.GetLocationIndexUsingCell(*cell_iter);
+            TS_ASSERT_EQUALS(location_indices.count(location_index), 0u);
+            location_indices.insert(location_index);
+
+            TS_ASSERT_EQUALS(rCellPopulation.IsCellAttachedToLocationIndex(location_index), true);
+            TS_ASSERT_EQUALS(rCellPopulation.GetCellUsingLocationIndex(location_index), *cell_iter);
+            TS_ASSERT_EQUALS(rCellPopulation.GetCellsUsingLocationIndex(location_index).size(), 1u);
+        }
+        TS_ASSERT_EQUALS(location_indices.size(), rCellPopulation.rGetCells().size());
+    }
+
+    /**
+     * @return a new stem cell, ready to be added to a population.
+     */
+    CellPtr CreateNewCell()
+    {
+        MAKE_PTR(WildTypeCellMutationState, p_state);
+        MAKE_PTR(StemCellProliferativeType, p_stem_type);
+        FixedG1GenerationalCellCycleModel* p_model = new FixedG1GenerationalCellCycleModel();
+        CellPtr p_cell(new Cell(p_state, p_model));
+        p_cell->SetCellProliferativeType(p_stem_type);
+        p_cell->SetBirthTime(-1.0);
+        return p_cell;
+    }
+
+public:
+
+    void TestMapMethods() throw (Exception)
+    {
+        std::vector<CellPtr> cells;
+        CellsGenerator<FixedG1GenerationalCellCycleModel, 2> cells_generator;
+        cells_generator.GenerateBasic(cells, 4);
+
+        CellLocationIndexMap map;
+        TS_ASSERT_EQUALS(map.GetNumCells(), 0u);
+        TS_ASSERT_EQUALS(map.IsCellAttached(cells[0].get()), false);
+        TS_ASSERT_EQUALS(map.GetLocationIndex(cells[0].get()), UNSIGNED_UNSET);
+        TS_ASSERT_EQUALS(map.GetFirstSlot(100), UNSIGNED_UNSET);
+
+        // Attach two cells to location 3 and one to location 7
+        map.AddCell(3, cells[0]);
+        map.AddCell(3, cells[1]);
+        map.AddCell(7, cells[2]);
+        TS_ASSERT_EQUALS(map.GetNumCells(), 3u);
+        TS_ASSERT_EQUALS(map.GetNumCellsAtLocation(3), 2u);
+        TS_ASSERT_EQUALS(map.GetNumCellsAtLocation(7), 1u);
+        TS_ASSERT_EQUALS(map.GetNumCellsAtLocation(5), 0u);
+        TS_ASSERT_EQUALS(map.GetLocationIndex(cells[1].get()), 3u);
+        TS_ASSERT_EQUALS(map.GetCellsAtLocation(3).count(cells[0]), 1u);
+        TS_ASSERT_EQUALS(map.GetCellsAtLocation(3).count(cells[1]), 1u);
+
+        // Adding a cell to a new location detaches it from its old one
+        map.AddCell(7, cells[0]);
+        TS_ASSERT_EQUALS(map.GetNumCells(), 3u);
+        TS_ASSERT_EQUALS(map.GetNumCellsAtLocation(3), 1u);
+        TS_ASSERT_EQUALS(map.GetNumCellsAtLocation(7), 2u);
+        TS_ASSERT_EQUALS(map.GetLocationIndex(cells[0].get()), 7u);
+
+        // Removing a cell keeps the slots contiguous and the remaining handles valid
+        TS_ASSERT_EQUALS(map.RemoveCell(3, cells[0]), false);
+        TS_ASSERT_EQUALS(map.RemoveCell(3, cells[1]), true);
+        TS_ASSERT_EQUALS(map.GetNumCells(), 2u);
+        TS_ASSERT_EQUALS(map.IsCellAttached(cells[1].get()), false);
+        TS_ASSERT_EQUALS(map.GetFirstSlot(3), UNSIGNED_UNSET);
+        TS_ASSERT_EQUALS(map.GetLocationIndex(cells[0].get()), 7u);
+        TS_ASSERT_EQUALS(map.GetLocationIndex(cells[2].get()), 7u);
+
+        // Setting a cell replaces any cells attached to the location
+        map.SetCell(7, cells[3]);
+        TS_ASSERT_EQUALS(map.GetNumCells(), 1u);
+        TS_ASSERT_EQUALS(map.IsCellAttached(cells[0].get()), false);
+        TS_ASSERT_EQUALS(map.IsCellAttached(cells[2].get()), false);
+        unsigned slot = map.GetFirstSlot(7);
+        TS_ASSERT_EQUALS(map.rGetCellInSlot(slot), cells[3]);
+        TS_ASSERT_EQUALS(map.GetNextSlot(slot), UNSIGNED_UNSET);
+
+        // Renumber the locations, as happens after a remesh
+        map.AddCell(2, cells[0]);
+        NodeMap node_map(8);
+        node_map.SetNewIndex(2, 5);
+        node_map.SetNewIndex(7, 1);
+        map.UpdateLocationIndices(node_map);
+        TS_ASSERT_EQUALS(map.GetLocationIndex(cells[0].get()), 5u);
+        TS_ASSERT_EQUALS(map.GetLocationIndex(cells[3].get()), 1u);
+        TS_ASSERT_EQUALS(map.GetFirstSlot(7), UNSIGNED_UNSET);
+        TS_ASSERT_EQUALS(map.GetNumCellsAtLocation(5), 1u);
+
+        // A cell attached to a second map is still found in the first
+        CellLocationIndexMap other_map;
+        other_map.AddCell(0, cells[3]);
+        TS_ASSERT_EQUALS(other_map.GetLocationIndex(cells[3].get()), 0u);
+        TS_ASSERT_EQUALS(map.GetLocationIndex(cells[3].get()), 1u);
+        TS_ASSERT_EQUALS(map.GetLocationIndex(cells[1].get()), UNSIGNED_UNSET);
+
+        map.Clear();
+        TS_ASSERT_EQUALS(map.GetNumCells(), 0u);
+        TS_ASSERT_EQUALS(map.IsCellAttached(cells[0].get()), false);
+    }
+
+    void TestMeshBasedBirthsDeathsAndRemesh() throw (Exception)
+    {
+        // Create a mesh with 16 nodes
+        HoneycombMeshGenerator generator(4, 4, 0);
+        MutableMesh<2,2>* p_mesh = generator.GetMesh();
+
+        std::vector<CellPtr> cells;
+        CellsGenerator<FixedG1GenerationalCellCycleModel, 2> cells_generator;
+        cells_generator.GenerateBasic(cells, p_mesh->GetNumNodes());
+
+        MeshBasedCellPopulation<2> cell_population(*p_mesh, cells);
+        CheckCellLocationsAreConsistent(cell_population);
+
+        // A birth attaches the new cell to a new node
+        c_vector<double,2> daughter_location;
+        daughter_location[0] = 1.25;
+        daughter_location[1] = 0.5;
+        typedef FixedCentreBasedDivisionRule<2,2> FixedRule;
+        MAKE_PTR_ARGS(FixedRule, p_div_rule, (daughter_location));
+        cell_population.SetCentreBasedDivisionRule(p_div_rule);
+
+        CellPtr p_new_cell = cell_population.AddCell(CreateNewCell(), cell_population.GetCellUsingLocationIndex(5));
+        TS_ASSERT_EQUALS(cell_population.GetLocationIndexUsingCell(p_new_cell), 16u);
+        CheckCellLocationsAreConsistent(cell_population);
+
+        // A death detaches the cell from its node
+        cell_population.GetCellUsingLocationIndex(1)->Kill();
+        TS_ASSERT_EQUALS(cell_population.RemoveDeadCells(), 1u);
+        TS_ASSERT_EQUALS(cell_population.IsCellAttachedToLocationIndex(1), false);
+        TS_ASSERT_EQUALS(cell_population.rGetCells().size(), 16u);
+        CheckCellLocationsAreConsistent(cell_population);
+
+        // The remesh renumbers the nodes, and each cell must follow its node
+        std::map<CellPtr, c_vector<double,2> > old_locations;
+        for (std::list<CellPtr>::iterator cell_iter = cell_population.rGetCells().begin();
+             cell_iter != cell_population.rGetCells().end();
+             ++cell_iter)
+        {
+            old_locations[*cell_iter] = cell_population.GetLocationOfCellCentre(*cell_iter);
+        }
+
+        cell_population.Update();
+        TS_ASSERT_EQUALS(p_mesh->GetNumAllNodes(), 16u);
+        CheckCellLocationsAreConsistent(cell_population);
+
+        for (std::list<CellPtr>::iterator cell_iter = cell_population.rGetCells().begin();
+             cell_iter != cell_population.rGetCells().end();
+             ++cell_iter)
+        {
+            TS_ASSERT_LESS_THAN(cell_population.GetLocationIndexUsingCell(*cell_iter), 16u);
+            c_vector<double,2> new_location = cell_population.GetLocationOfCellCentre(*cell_iter);
+            TS_ASSERT_DELTA(new_location[0], old_locations[*cell_iter][0], 1e-12);
+            TS_ASSERT_DELTA(new_location[1], old_locations[*cell_iter][1], 1e-12);
+        }
+    }
+
+    void TestVertexBasedBirthsDeathsAndRemesh() throw (Exception)
+    {
+        // Create a mesh with 12 elements
+        HoneycombVertexMeshGenerator generator(4, 3);
+        MutableVertexMesh<2,2>* p_mesh = generator.GetMesh();
+
+        std::vector<CellPtr> cells;
+        CellsGenerator<FixedG1GenerationalCellCycleModel, 2> cells_generator;
+        cells_generator.GenerateBasic(cells, p_mesh->GetNumElements());
+
+        VertexBasedCellPopulation<2> cell_population(*p_mesh, cells);
+        CheckCellLocationsAreConsistent(cell_population);
+
+        // A birth divides the parent element and attaches the new cell to the new element
+        CellPtr p_new_cell = cell_population.AddCell(CreateNewCell(), cell_population.GetCellUsingLocationIndex(5));
+        TS_ASSERT_EQUALS(cell_population.GetLocationIndexUsingCell(p_new_cell), 12u);
+        CheckCellLocationsAreConsistent(cell_population);
+
+        // A death detaches the cell from its element
+        cell_population.GetCellUsingLocationIndex(1)->Kill();
+        TS_ASSERT_EQUALS(cell_population.RemoveDeadCells(), 1u);
+        TS_ASSERT_EQUALS(cell_population.IsCellAttachedToLocationIndex(1), false);
+        TS_ASSERT_EQUALS(cell_population.rGetCells().size(), 12u);
+        CheckCellLocationsAreConsistent(cell_population);
+
+        TS_ASSERT_EQUALS(Warnings::Instance()->GetNumWarnings(), 1u);
+        TS_ASSERT_EQUALS(Warnings::Instance()->GetNextWarningMessage(), "A Cell is removed without performing a T2 swap. This could leave a void in the mesh.");
+        Warnings::QuietDestroy();
+
+        // The remesh renumbers the elements, and each cell must follow its element
+        std::map<CellPtr, c_vector<double,2> > old_centroids;
+        for (std::list<CellPtr>::iterator cell_iter = cell_population.rGetCells().begin();
+             cell_iter != cell_population.rGetCells().end();
+             ++cell_iter)
+        {
+            old_centroids[*cell_iter] = cell_population.GetLocationOfCellCentre(*cell_iter);
+        }
+
+        cell_population.Update();
+        TS_ASSERT_EQUALS(p_mesh->GetNumAllElements(), 12u);
+        CheckCellLocationsAreConsistent(cell_population);
+
+        for (std::list<CellPtr>::iterator cell_iter = cell_population.rGetCells().begin();
+             cell_iter != cell_population.rGetCells().end();
+             ++cell_iter)
+        {
+            TS_ASSERT_LESS_THAN(cell_population.GetLocationIndexUsingCell(*cell_iter), 12u);
+            c_vector<double,2> new_centroid = cell_population.GetLocationOfCellCentre(*cell_iter);
+            TS_ASSERT_DELTA(new_centroid[0], old_centroids[*cell_iter][0], 1e-12);
+            TS_ASSERT_DELTA(new_centroid[1], old_centroids[*cell_iter][1], 1e-12);
+        }
+    }
+
+    void TestPottsBasedBirthsDeathsAndRemesh() throw (Exception)
+    {
+        // Create a mesh with 4 elements
+        PottsMeshGenerator<2> generator(4, 2, 2, 4, 2, 2);
+        PottsMesh<2>* p_mesh = generator.GetMesh();
+
+        std::vector<CellPtr> cells;
+        CellsGenerator<FixedG1GenerationalCellCycleModel, 2> cells_generator;
+        cells_generator.GenerateBasic(cells, p_mesh->GetNumElements());
+
+        PottsBasedCellPopulation<2> cell_population(*p_mesh, cells);
+        CheckCellLocationsAreConsistent(cell_population);
+
+        // A death detaches the cell from its element
+        CellPtr p_dead_cell = cell_population.GetCellUsingLocationIndex(1);
+        p_dead_cell->Kill();
+        TS_ASSERT_EQUALS(cell_population.RemoveDeadCells(), 1u);
+        TS_ASSERT_EQUALS(cell_population.IsCellAttachedToLocationIndex(1), false);
+        TS_ASSERT_EQUALS(cell_population.rGetCells().size(), 3u);
+        CheckCellLocationsAreConsistent(cell_population);
+
+        // A birth reuses the deleted element, which must now hold only the new cell
+        CellPtr p_new_cell = cell_population.AddCell(CreateNewCell(), cell_population.GetCellUsingLocationIndex(2));
+        TS_ASSERT_EQUALS(cell_population.GetLocationIndexUsingCell(p_new_cell), 1u);
+        TS_ASSERT_EQUALS(cell_population.GetCellUsingLocationIndex(1), p_new_cell);
+        CheckCellLocationsAreConsistent(cell_population);
+
+        // Potts meshes are never remeshed, so the location indices are unchanged by an update
+        std::map<CellPtr, unsigned> old_location_indices;
+        for (std::list<CellPtr>::iterator cell_iter = cell_population.rGetCells().begin();
+             cell_iter != cell_population.rGetCells().end();
+             ++cell_iter)
+        {
+            old_location_indices[*cell_iter] = cell_population.GetLocationIndexUsingCell(*cell_iter);
+        }
+
+        cell_population.Update();
+        CheckCellLocationsAreConsistent(cell_population);
+
+        for (std::list<CellPtr>::iterator cell_iter = cell_population.rGetCells().begin();
+             cell_iter != cell_population.rGetCells().end();
+             ++cell_iter)
+        {
+            TS_ASSERT_EQUALS(cell_population.GetLocationIndexUsingCell(*cell_iter), old_location_indices[*cell_iter]);
+        }
+    }
+};
+
+#endif /*TESTCELLLOCATIONINDEXMAP_HPP_*/
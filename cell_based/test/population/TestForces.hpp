@@ -521,6 +521,132 @@ public:
         TS_ASSERT_DELTA(cell_population.GetNode(60)->rGetAppliedForce()[1], 0.0, 1e-4);
     }
 
+    void TestBatchedTwoBodyInteractionForces() throw (Exception)
+    {
+        EXIT_IF_PARALLEL;    // HoneycombMeshGenerator doesn't work in parallel.
+
+        SimulationTime::Instance()->SetEndTimeAndNumberOfTimeSteps(1.0,1);
+
+        // Create a mesh-based cell population with some displaced nodes and labelled cells
+        HoneycombMeshGenerator generator(7, 5, 3);
+        MutableMesh<2,2>* p_mesh = generator.GetMesh();
+        std::vector<unsigned> location_indices = generator.GetCellLocationIndices();
+
+        std::vector<CellPtr> cells;
+        CellsGenerator<FixedG1GenerationalCellCycleModel, 2> cells_generator;
+        cells_generator.GenerateBasic(cells, location_indices.size(), location_indices);
+
+        MeshBasedCellPopulationWithGhostNodes<2> mesh_population(*p_mesh, cells, location_indices);
+
+        ChastePoint<2> new_point;
+        new_point.rGetLocation()[0] = p_mesh->GetNode(59)->rGetLocation()[0] + 0.5;
+        new_point.rGetLocation()[1] = p_mesh->GetNode(59)->rGetLocation()[1];
+        p_mesh->SetNode(59, new_point, false);
+        new_point.rGetLocation()[0] = p_mesh->GetNode(45)->rGetLocation()[0] - 0.2;
+        new_point.rGetLocation()[1] = p_mesh->GetNode(45)->rGetLocation()[1] + 0.1;
+        p_mesh->SetNode(45, new_point, false);
+
+        boost::shared_ptr<AbstractCellProperty> p_label(mesh_population.GetCellPropertyRegistry()->Get<CellLabel>());
+        mesh_population.GetCellUsingLocationIndex(59)->AddCellProperty(p_label);
+        mesh_population.GetCellUsingLocationIndex(60)->AddCellProperty(p_label);
+
+        // Create a node-based cell population with some overlapping and some distant cells
+        std::vector<Node<2>*> nodes;
+        for (unsigned i=0; i<16; i++)
+        {
+            double x = 0.8*(i%4) + 0.05*(i%3);
+            double y = 0.9*(i/4) - 0.07*(i%5);
+            nodes.push_back(new Node<2>(i, true, x, y));
+        }
+        NodesOnlyMesh<2> nodes_only_mesh;
+        nodes_only_mesh.ConstructNodesWithoutMesh(nodes, 1.5);
+
+        std::vector<CellPtr> node_cells;
+        CellsGenerator<FixedG1GenerationalCellCycleModel, 2> node_cells_generator;
+        node_cells_generator.GenerateBasic(node_cells, nodes_only_mesh.GetNumNodes());
+
+        NodeBasedCellPopulation<2> node_population(nodes_only_mesh, node_cells);
+        node_population.Update();
+        for (unsigned i=0; i<node_population.GetNumNodes(); i+=3)
+        {
+            node_population.GetCellUsingLocationIndex(i)->AddCellProperty(p_label);
+        }
+
+        // Create the forces to compare
+        std::vector<boost::shared_ptr<AbstractTwoBodyInteractionForce<2> > > forces;
+        forces.push_back(boost::shared_ptr<AbstractTwoBodyInteractionForce<2> >(new GeneralisedLinearSpringForce<2>()));
+        forces.push_back(boost::shared_ptr<AbstractTwoBodyInteractionForce<2> >(new GeneralisedLinearSpringForce<2>()));
+        forces[1]->SetCutOffLength(1.2);
+
+        DifferentialAdhesionGeneralisedLinearSpringForce<2>* p_adhesion_force = new DifferentialAdhesionGeneralisedLinearSpringForce<2>();
+        p_adhesion_force->SetHomotypicLabelledSpringConstantMultiplier(2.0);
+        p_adhesion_force->SetHeterotypicSpringConstantMultiplier(4.0);
+        forces.push_back(boost::shared_ptr<AbstractTwoBodyInteractionForce<2> >(p_adhesion_force));
+
+        TS_ASSERT_EQUALS(forces[0]->GetUseBatchedForceCalculation(), false);
+
+        // The batched forces should match those calculated pair by pair, for both populations
+        std::vector<AbstractCentreBasedCellPopulation<2>*> populations;
+        populations.push_back(&mesh_population);
+        populations.push_back(&node_population);
+
+        for (unsigned pop_index=0; pop_index<populations.size(); pop_index++)
+        {
+            AbstractCentreBasedCellPopulation<2>& r_population = *(populations[pop_index]);
+
+            if (pop_index == 1)
+            {
+                forces.push_back(boost::shared_ptr<AbstractTwoBodyInteractionForce<2> >(new RepulsionForce<2>()));
+            }
+
+            for (unsigned force_index=0; force_index<forces.size(); force_index++)
+            {
+                std::vector<c_vector<double,2> > expected_forces;
+
+                forces[force_index]->SetUseBatchedForceCalculation(false);
+                for (unsigned i=0; i<r_population.GetNumNodes(); i++)
+                {
+                    r_population.GetNode(i)->ClearAppliedForce();
+                }
+                forces[force_index]->AddForceContribution(r_population);
+                for (unsigned i=0; i<r_population.GetNumNodes(); i++)
+                {
+                    expected_forces.push_back(r_population.GetNode(i)->rGetAppliedForce());
+                }
+
+                forces[force_index]->SetUseBatchedForceCalculation();
+                TS_ASSERT_EQUALS(forces[force_index]->GetUseBatchedForceCalculation(), true);
+                for (unsigned i=0; i<r_population.GetNumNodes(); i++)
+                {
+                    r_population.GetNode(i)->ClearAppliedForce();
+                }
+                forces[force_index]->AddForceContribution(r_population);
+                for (unsigned i=0; i<r_population.GetNumNodes(); i++)
+                {
+                    TS_ASSERT_DELTA(r_population.GetNode(i)->rGetAppliedForce()[0], expected_forces[i][0], 1e-12);
+                    TS_ASSERT_DELTA(r_population.GetNode(i)->rGetAppliedForce()[1], expected_forces[i][1], 1e-12);
+                }
+            }
+        }
+
+        // Check that the batch gathers each pair once
+        TwoBodyInteractionBatch<2> batch;
+        batch.SetUp(node_population);
+        TS_ASSERT_EQUALS(batch.GetNumPairs(), node_population.rGetNodePairs().size());
+        TS_ASSERT_EQUALS(batch.GetNumNodes(), node_population.GetNumNodes());
+        for (unsigned pair_index=0; pair_index<batch.GetNumPairs(); pair_index++)
+        {
+            TS_ASSERT_EQUALS(batch.GetNode(batch.GetPairNodeA(pair_index)), node_population.rGetNodePairs()[pair_index].first);
+            TS_ASSERT_EQUALS(batch.GetNode(batch.GetPairNodeB(pair_index)), node_population.rGetNodePairs()[pair_index].second);
+            TS_ASSERT_EQUALS(batch.IsPairActive(pair_index), true);
+        }
+
+        for (unsigned i=0; i<nodes.size(); i++)
+        {
+            delete nodes[i];
+        }
+    }
+
     void TestForceOutputParameters()
     {
         EXIT_IF_PARALLEL;
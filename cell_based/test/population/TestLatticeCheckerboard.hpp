@@ -0,0 +1,147 @@
+/*
+
+Copyright (c) 2005-2017, University of Oxford.
+All rights reserved.
+
+University of Oxford means the Chancellor, Masters and Scholars of the
+University of Oxford, having an administrative office at Wellington
+Square, Oxford OX1 2JD, UK.
+
+This file is part of Chaste.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+ * Redistributions of source code must retain the above copyright notice,
+   this list of conditions and the following disclaimer.
+ * Redistributions in binary form must reproduce the above copyright notice,
+   this list of conditions and the following disclaimer in the documentation
+   and/or other materials provided with the distribution.
+ * Neither the name of the University of Oxford nor the names of its
+   contributors may be used to endorse or promote products derived from this
+   software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+*/
+
+
+#ifndef TESTLATTICECHECKERBOARD_HPP_
+#define TESTLATTICECHECKERBOARD_HPP_
+
+#include <cxxtest/TestSuite.h>
+
+#include "LatticeCheckerboard.hpp"
+#include "PottsMeshGenerator.hpp"
+#include "RandomNumberGenerator.hpp"
+#include "AbstractCellBasedTestSuite.hpp"
+
+//This test is always run sequentially (never in parallel)
+#include "FakePetscSetup.hpp"
+
+class TestLatticeCheckerboard : public AbstractCellBasedTestSuite
+{
+private:
+
+    /**
+     * Check that every site is in exactly one colour and partition, and that
+     * sites of the same colour are not too close.
+     */
+    void CheckColouring(PottsMesh<2>& rMesh, LatticeCheckerboard<2>& rCheckerboard, unsigned separation)
+    {
+        std::vector<unsigned> site_colours(rMesh.GetNumNodes(), UNSIGNED_UNSET);
+        for (unsigned colour=0; colour<rCheckerboard.GetNumColours(); colour++)
+        {
+            for (unsigned partition=0; partition<rCheckerboard.GetNumPartitions(); partition++)
+            {
+                const std::vector<unsigned>& r_sites = rCheckerboard.rGetSites(colour, partition);
+                for (unsigned i=0; i<r_sites.size(); i++)
+                {
+                    TS_ASSERT_EQUALS(site_colours[r_sites[i]], UNSIGNED_UNSET);
+                    site_colours[r_sites[i]] = colour;
+                }
+            }
+        }
+
+        for (unsigned site=0; site<rMesh.GetNumNodes(); site++)
+        {
+            TS_ASSERT_DIFFERS(site_colours[site], UNSIGNED_UNSET);
+            std::set<unsigned> neighbours = rMesh.GetMooreNeighbouringNodeIndices(site);
+            for (std::set<unsigned>::iterator iter = neighbours.begin(); iter != neighbours.end(); ++iter)
+            {
+                TS_ASSERT_DIFFERS(site_colours[*iter], site_colours[site]);
+                if (separation == 2)
+                {
+                    std::set<unsigned> next_neighbours = rMesh.GetMooreNeighbouringNodeIndices(*iter);
+                    for (std::set<unsigned>::iterator next_iter = next_neighbours.begin(); next_iter != next_neighbours.end(); ++next_iter)
+                    {
+                        TS_ASSERT((*next_iter == site) || (site_colours[*next_iter] != site_colours[site]));
+                    }
+                }
+            }
+        }
+    }
+
+public:
+
+    void TestColouring() throw(Exception)
+    {
+        PottsMeshGenerator<2> generator(10, 0, 0, 10, 0, 0);
+        PottsMesh<2>* p_mesh = generator.GetMesh();
+
+        LatticeCheckerboard<2> checkerboard(*p_mesh, 1, 3);
+        TS_ASSERT_EQUALS(checkerboard.GetNumSites(), 100u);
+        TS_ASSERT_EQUALS(checkerboard.GetNumColours(), 4u);
+        TS_ASSERT_EQUALS(checkerboard.GetNumPartitions(), 3u);
+        CheckColouring(*p_mesh, checkerboard, 1);
+
+        // Partitions are strips of contiguous site indices
+        TS_ASSERT_EQUALS(checkerboard.rGetSites(0, 0)[0], 0u);
+        TS_ASSERT_LESS_THAN(checkerboard.rGetSites(0, 0).back(), checkerboard.rGetSites(0, 1)[0]);
+
+        LatticeCheckerboard<2> wide_checkerboard(*p_mesh, 2, 2);
+        TS_ASSERT_EQUALS(wide_checkerboard.GetNumColours(), 9u);
+        CheckColouring(*p_mesh, wide_checkerboard, 2);
+
+        // Periodic meshes may need more colours, but the colouring is still valid
+        PottsMeshGenerator<2> periodic_generator(5, 0, 0, 5, 0, 0, 1, 0, 1, false, true, true);
+        PottsMesh<2>* p_periodic_mesh = periodic_generator.GetMesh();
+        LatticeCheckerboard<2> periodic_checkerboard(*p_periodic_mesh, 1, 1);
+        TS_ASSERT_LESS_THAN(4u, periodic_checkerboard.GetNumColours());
+        CheckColouring(*p_periodic_mesh, periodic_checkerboard, 1);
+
+        TS_ASSERT_THROWS_THIS(LatticeCheckerboard<2>(*p_mesh, 3, 1),
+            "The separation of a lattice checkerboard must be 1 or 2.");
+        TS_ASSERT_THROWS_THIS(LatticeCheckerboard<2>(*p_mesh, 1, 0),
+            "A lattice checkerboard must have at least one partition.");
+    }
+
+    void TestStreams() throw(Exception)
+    {
+        PottsMeshGenerator<2> generator(4, 0, 0, 4, 0, 0);
+        PottsMesh<2>* p_mesh = generator.GetMesh();
+        LatticeCheckerboard<2> checkerboard(*p_mesh, 1, 2);
+
+        // Streams are seeded reproducibly from the global generator
+        RandomNumberGenerator::Instance()->Reseed(1);
+        checkerboard.SeedStreams();
+        double first = checkerboard.rGetStream(0).ranf();
+        double second = checkerboard.rGetStream(1).ranf();
+        TS_ASSERT_DIFFERS(first, second);
+
+        RandomNumberGenerator::Instance()->Reseed(1);
+        checkerboard.SeedStreams();
+        TS_ASSERT_EQUALS(checkerboard.rGetStream(1).ranf(), second);
+        TS_ASSERT_EQUALS(checkerboard.rGetStream(0).ranf(), first);
+    }
+};
+
+#endif /*TESTLATTICECHECKERBOARD_HPP_*/
@@ -44,6 +44,10 @@ OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "CellsGenerator.hpp"
 #include "PottsBasedCellPopulation.hpp"
 #include "VolumeConstraintPottsUpdateRule.hpp"
+#include "SurfaceAreaConstraintPottsUpdateRule.hpp"
+#include "AdhesionPottsUpdateRule.hpp"
+#include "PottsLatticeEngine.hpp"
+#include "RandomNumberGenerator.hpp"
 #include "PottsMeshGenerator.hpp"
 #include "FixedG1GenerationalCellCycleModel.hpp"
 #include "AbstractCellBasedTestSuite.hpp"
@@ -421,6 +425,160 @@ public:
         TS_ASSERT_EQUALS(cell_population.rGetMesh().GetElement(1)->GetNumNodes(), 4u);
     }
 
+    void TestUpdateCellLocationsUsingLatticeEngine()
+    {
+        // Run the same Monte Carlo sweeps with and without the lattice engine
+        std::vector<std::vector<std::set<unsigned> > > element_node_indices(2);
+        for (unsigned use_engine=0; use_engine<2; use_engine++)
+        {
+            RandomNumberGenerator::Instance()->Reseed(0);
+
+            PottsMeshGenerator<2> generator(12, 2, 4, 12, 2, 4);
+            PottsMesh<2>* p_mesh = generator.GetMesh();
+
+            std::vector<CellPtr> cells;
+            CellsGenerator<FixedG1GenerationalCellCycleModel, 2> cells_generator;
+            cells_generator.GenerateBasic(cells, p_mesh->GetNumElements());
+
+            PottsBasedCellPopulation<2> cell_population(*p_mesh, cells);
+            TS_ASSERT_EQUALS(cell_population.GetUseLatticeEngine(), false);
+            cell_population.SetUseLatticeEngine(use_engine == 1);
+            TS_ASSERT_EQUALS(cell_population.GetUseLatticeEngine(), use_engine == 1);
+            cell_population.SetTemperature(1.0);
+
+            MAKE_PTR(VolumeConstraintPottsUpdateRule<2>, p_volume_constraint_update_rule);
+            cell_population.AddUpdateRule(p_volume_constraint_update_rule);
+            MAKE_PTR(SurfaceAreaConstraintPottsUpdateRule<2>, p_surface_area_constraint_update_rule);
+            cell_population.AddUpdateRule(p_surface_area_constraint_update_rule);
+            MAKE_PTR(AdhesionPottsUpdateRule<2>, p_adhesion_update_rule);
+            cell_population.AddUpdateRule(p_adhesion_update_rule);
+
+            for (unsigned step=0; step<5; step++)
+            {
+                cell_population.UpdateCellLocations(1.0);
+            }
+
+            for (unsigned elem_index=0; elem_index<p_mesh->GetNumElements(); elem_index++)
+            {
+                std::set<unsigned> node_indices;
+                PottsElement<2>* p_element = p_mesh->GetElement(elem_index);
+                for (unsigned local_index=0; local_index<p_element->GetNumNodes(); local_index++)
+                {
+                    node_indices.insert(p_element->GetNodeGlobalIndex(local_index));
+                }
+                element_node_indices[use_engine].push_back(node_indices);
+            }
+
+            // The cached volumes and surface areas must agree with the mesh
+            PottsLatticeEngine<2> lattice(*p_mesh);
+            TS_ASSERT_EQUALS(lattice.GetNumSites(), 144u);
+            for (unsigned elem_index=0; elem_index<p_mesh->GetNumElements(); elem_index++)
+            {
+                TS_ASSERT_DELTA(lattice.GetElementVolume(elem_index), p_mesh->GetVolumeOfElement(elem_index), 1e-12);
+                TS_ASSERT_DELTA(lattice.GetElementSurfaceArea(elem_index), p_mesh->GetSurfaceAreaOfElement(elem_index), 1e-12);
+            }
+        }
+
+        // The sweeps must have moved some sites, identically in both cases
+        TS_ASSERT_EQUALS(element_node_indices[0].size(), 4u);
+        bool any_moved = false;
+        for (unsigned elem_index=0; elem_index<element_node_indices[0].size(); elem_index++)
+        {
+            TS_ASSERT(element_node_indices[0][elem_index] == element_node_indices[1][elem_index]);
+            any_moved = any_moved || (element_node_indices[0][elem_index].size() != 16u);
+        }
+        TS_ASSERT(any_moved);
+    }
+
+    void TestUpdateCellLocationsOnCheckerboard()
+    {
+        // Run the same checkerboard sweeps twice from the same seed
+        std::vector<std::vector<std::set<unsigned> > > element_node_indices(2);
+        for (unsigned run=0; run<2; run++)
+        {
+            RandomNumberGenerator::Instance()->Reseed(0);
+
+            PottsMeshGenerator<2> generator(12, 2, 4, 12, 2, 4);
+            PottsMesh<2>* p_mesh = generator.GetMesh();
+
+            std::vector<CellPtr> cells;
+            CellsGenerator<FixedG1GenerationalCellCycleModel, 2> cells_generator;
+            cells_generator.GenerateBasic(cells, p_mesh->GetNumElements());
+
+            PottsBasedCellPopulation<2> cell_population(*p_mesh, cells);
+            TS_ASSERT_EQUALS(cell_population.GetNumCheckerboardPartitions(), 0u);
+            cell_population.SetNumCheckerboardPartitions(3);
+            cell_population.SetNumSweepsPerTimestep(2);
+            cell_population.SetTemperature(1.0);
+
+            MAKE_PTR(VolumeConstraintPottsUpdateRule<2>, p_volume_constraint_update_rule);
+            cell_population.AddUpdateRule(p_volume_constraint_update_rule);
+            MAKE_PTR(SurfaceAreaConstraintPottsUpdateRule<2>, p_surface_area_constraint_update_rule);
+            cell_population.AddUpdateRule(p_surface_area_constraint_update_rule);
+            MAKE_PTR(AdhesionPottsUpdateRule<2>, p_adhesion_update_rule);
+            cell_population.AddUpdateRule(p_adhesion_update_rule);
+
+            for (unsigned step=0; step<5; step++)
+            {
+                cell_population.UpdateCellLocations(1.0);
+            }
+
+            // Each node is in at most one element, and the mesh agrees with the lattice engine
+            PottsLatticeEngine<2> lattice(*p_mesh);
+            for (unsigned elem_index=0; elem_index<p_mesh->GetNumElements(); elem_index++)
+            {
+                std::set<unsigned> node_indices;
+                PottsElement<2>* p_element = p_mesh->GetElement(elem_index);
+                for (unsigned local_index=0; local_index<p_element->GetNumNodes(); local_index++)
+                {
+                    unsigned node_index = p_element->GetNodeGlobalIndex(local_index);
+                    node_indices.insert(node_index);
+                    TS_ASSERT_EQUALS(p_mesh->GetNode(node_index)->GetNumContainingElements(), 1u);
+                }
+                element_node_indices[run].push_back(node_indices);
+                TS_ASSERT_DELTA(lattice.GetElementSurfaceArea(elem_index), p_mesh->GetSurfaceAreaOfElement(elem_index), 1e-12);
+            }
+        }
+
+        bool any_moved = false;
+        for (unsigned elem_index=0; elem_index<element_node_indices[0].size(); elem_index++)
+        {
+            TS_ASSERT(element_node_indices[0][elem_index] == element_node_indices[1][elem_index]);
+            any_moved = any_moved || (element_node_indices[0][elem_index].size() != 16u);
+        }
+        TS_ASSERT(any_moved);
+    }
+
+    void TestPottsLatticeEngineMoveSite()
+    {
+        PottsMeshGenerator<2> generator(4, 2, 2, 2, 1, 2);
+        PottsMesh<2>* p_mesh = generator.GetMesh();
+
+        PottsLatticeEngine<2> lattice(*p_mesh);
+        TS_ASSERT_EQUALS(lattice.GetSiteOwner(0), 0u);
+        TS_ASSERT_EQUALS(lattice.GetSiteOwner(2), 1u);
+        TS_ASSERT_EQUALS(lattice.GetNumMooreNeighbours(0), 3u);
+        TS_ASSERT_EQUALS(lattice.GetMooreNeighbour(0, 0), 1u);
+        TS_ASSERT_EQUALS(lattice.GetNumVonNeumannNeighbours(0), 2u);
+        TS_ASSERT_EQUALS(lattice.CountVonNeumannNeighboursOwnedBy(1, 0), 2u);
+        TS_ASSERT_DELTA(lattice.GetElementVolume(0), 4.0, 1e-12);
+        TS_ASSERT_DELTA(lattice.GetElementSurfaceArea(0), 8.0, 1e-12);
+
+        // Move a site to the other element, then to the medium
+        lattice.MoveSite(1, 1);
+        TS_ASSERT_EQUALS(lattice.GetSiteOwner(1), 1u);
+        TS_ASSERT_EQUALS(p_mesh->GetNode(1)->rGetContainingElementIndices().count(1), 1u);
+        lattice.MoveSite(2, UNSIGNED_UNSET);
+        TS_ASSERT_EQUALS(lattice.GetSiteOwner(2), UNSIGNED_UNSET);
+        TS_ASSERT(p_mesh->GetNode(2)->rGetContainingElementIndices().empty());
+
+        for (unsigned elem_index=0; elem_index<2; elem_index++)
+        {
+            TS_ASSERT_DELTA(lattice.GetElementVolume(elem_index), p_mesh->GetVolumeOfElement(elem_index), 1e-12);
+            TS_ASSERT_DELTA(lattice.GetElementSurfaceArea(elem_index), p_mesh->GetSurfaceAreaOfElement(elem_index), 1e-12);
+        }
+    }
+
     ///\todo implement this test (#1666)
 //    void TestVoronoiMethods()
 //    {
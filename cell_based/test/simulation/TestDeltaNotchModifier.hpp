@@ -57,6 +57,7 @@ OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "PottsBasedCellPopulation.hpp"
 #include "OnLatticeSimulation.hpp"
 #include "DeltaNotchTrackingModifier.hpp"
+#include "BatchedSrnOdeSolverModifier.hpp"
 #include "AbstractCellBasedWithTimingsTestSuite.hpp"
 #include "WildTypeCellMutationState.hpp"
 #include "DifferentiatedCellProliferativeType.hpp"
@@ -716,6 +717,85 @@ public:
         Warnings::QuietDestroy();
     }
 
+    void TestBatchedSrnOdeSolverModifier() throw(Exception)
+    {
+        EXIT_IF_PARALLEL;
+
+        // Use RK4 so that the Delta-Notch ODEs can be solved in a batch
+        boost::shared_ptr<AbstractCellCycleModelOdeSolver> p_solver(CellCycleModelOdeSolver<DeltaNotchSrnModel, RungeKutta4IvpOdeSolver>::Instance());
+        p_solver->Initialise();
+
+        MAKE_PTR(WildTypeCellMutationState, p_state);
+        MAKE_PTR(DifferentiatedCellProliferativeType, p_diff_type);
+
+        // Run the same simulation with and without batched SRN solves
+        std::vector<std::vector<double> > final_levels[2];
+        for (unsigned batched=0; batched<2; batched++)
+        {
+            SimulationTime::Destroy();
+            SimulationTime::Instance()->SetStartTime(0.0);
+
+            HoneycombMeshGenerator generator(2, 2, 0);
+            MutableMesh<2,2>* p_generating_mesh = generator.GetMesh();
+            NodesOnlyMesh<2> mesh;
+            mesh.ConstructNodesWithoutMesh(*p_generating_mesh, 1.5);
+
+            std::vector<CellPtr> cells;
+            for (unsigned i=0; i<mesh.GetNumNodes(); i++)
+            {
+                std::vector<double> initial_conditions;
+                initial_conditions.push_back(0.2 + 0.2*i);
+                initial_conditions.push_back(1.0 - 0.2*i);
+
+                UniformCellCycleModel* p_cc_model = new UniformCellCycleModel();
+                p_cc_model->SetDimension(2);
+
+                DeltaNotchSrnModel* p_srn_model = new DeltaNotchSrnModel(p_solver);
+                p_srn_model->SetDt(0.001);
+                p_srn_model->SetInitialConditions(initial_conditions);
+                CellPtr p_cell(new Cell(p_state, p_cc_model, p_srn_model));
+                p_cell->SetCellProliferativeType(p_diff_type);
+                p_cell->SetBirthTime(-1.0);
+                cells.push_back(p_cell);
+            }
+
+            NodeBasedCellPopulation<2> cell_population(mesh, cells);
+
+            OffLatticeSimulation<2> simulator(cell_population);
+            simulator.SetOutputDirectory("TestBatchedSrnOdeSolverModifier");
+            simulator.SetEndTime(0.1);
+
+            MAKE_PTR(DeltaNotchTrackingModifier<2>, p_modifier);
+            simulator.AddSimulationModifier(p_modifier);
+            if (batched == 1)
+            {
+                // Must come after the tracking modifier, which updates the mean Delta used by the ODEs
+                MAKE_PTR(BatchedSrnOdeSolverModifier<2>, p_batched_modifier);
+                TS_ASSERT_EQUALS(p_batched_modifier->GetIdentifier(), "BatchedSrnOdeSolverModifier-2");
+                simulator.AddSimulationModifier(p_batched_modifier);
+            }
+
+            simulator.Solve();
+
+            for (AbstractCellPopulation<2>::Iterator cell_iter = cell_population.Begin();
+                 cell_iter != cell_population.End();
+                 ++cell_iter)
+            {
+                DeltaNotchSrnModel* p_model = static_cast<DeltaNotchSrnModel*>(cell_iter->GetSrnModel());
+                TS_ASSERT_DELTA(p_model->GetLastTime(), 0.1, 1e-12);
+                final_levels[batched].push_back(p_model->GetProteinConcentrations());
+            }
+        }
+
+        // The batched solves give the same results as solving each cell separately
+        TS_ASSERT_EQUALS(final_levels[0].size(), final_levels[1].size());
+        for (unsigned i=0; i<final_levels[0].size(); i++)
+        {
+            TS_ASSERT_DELTA(final_levels[1][i][0], final_levels[0][i][0], 1e-12);
+            TS_ASSERT_DELTA(final_levels[1][i][1], final_levels[0][i][1], 1e-12);
+        }
+    }
+
     void TestDeltaNotchModifierOutputParameters()
     {
         EXIT_IF_PARALLEL;
@@ -53,6 +53,7 @@ OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "AbstractCellBasedWithTimingsTestSuite.hpp"
 #include "LogFile.hpp"
 #include "WildTypeCellMutationState.hpp"
+#include "DifferentiatedCellProliferativeType.hpp"
 #include "PlaneBoundaryCondition.hpp"
 #include "SmartPointers.hpp"
 #include "CellVolumesWriter.hpp"
@@ -134,6 +135,170 @@ public:
         TS_ASSERT(min_distance_between_cells > 0.999);
     }
 
+    /**
+     * Run the simulation in TestSimpleMonolayer() with one and with two threads, and
+     * check that the results agree and that the threaded run is repeatable.
+     */
+    void TestSimpleMonolayerWithMultipleThreads() throw (Exception)
+    {
+        EXIT_IF_PARALLEL;    // HoneycombMeshGenereator does not work in parallel.
+
+        HoneycombMeshGenerator generator(5, 5, 0);
+        TetrahedralMesh<2,2>* p_generating_mesh = generator.GetMesh();
+
+        unsigned num_threads[3] = {1, 2, 2};
+        std::vector<std::vector<c_vector<double, 2> > > final_locations(3);
+
+        for (unsigned run=0; run<3; run++)
+        {
+            // Reset the singletons
+            SimulationTime::Instance()->Destroy();
+            SimulationTime::Instance()->SetStartTime(0.0);
+            RandomNumberGenerator::Instance()->Reseed(0);
+
+            NodesOnlyMesh<2> mesh;
+            mesh.ConstructNodesWithoutMesh(*p_generating_mesh, 1.5);
+
+            std::vector<CellPtr> cells;
+            CellsGenerator<FixedG1GenerationalCellCycleModel, 2> cells_generator;
+            cells_generator.GenerateBasicRandom(cells, mesh.GetNumNodes());
+
+            NodeBasedCellPopulation<2> node_based_cell_population(mesh, cells);
+
+            OffLatticeSimulation<2> simulator(node_based_cell_population);
+            simulator.SetOutputDirectory("TestOffLatticeSimulationWithNodeBasedCellPopulationThreaded");
+            simulator.SetEndTime(0.5);
+
+            TS_ASSERT_EQUALS(simulator.GetNumThreads(), 1u);
+            TS_ASSERT_THROWS_THIS(simulator.SetNumThreads(0), "The number of threads must be at least one.");
+            simulator.SetNumThreads(num_threads[run]);
+            TS_ASSERT_EQUALS(simulator.GetNumThreads(), num_threads[run]);
+
+            // The force is only split over threads if asked
+            MAKE_PTR(GeneralisedLinearSpringForce<2>, p_linear_force);
+            p_linear_force->SetCutOffLength(1.5);
+            if (num_threads[run] > 1)
+            {
+                p_linear_force->SetUseBatchedForceCalculation();
+                p_linear_force->SetNumBatchThreads(num_threads[run]);
+            }
+            simulator.AddForce(p_linear_force);
+
+            // This force is left alone by the simulation
+            MAKE_PTR(GeneralisedLinearSpringForce<2>, p_untouched_force);
+            p_untouched_force->SetCutOffLength(1e-6); // so that it has no effect
+            simulator.AddForce(p_untouched_force);
+
+            simulator.Solve();
+
+            TS_ASSERT_EQUALS(p_linear_force->GetUseBatchedForceCalculation(), num_threads[run] > 1);
+            TS_ASSERT_EQUALS(p_untouched_force->GetUseBatchedForceCalculation(), false);
+            TS_ASSERT_EQUALS(p_untouched_force->GetNumBatchThreads(), 1u);
+            TS_ASSERT_EQUALS(simulator.GetNumericalMethod()->GetNumThreads(), num_threads[run]);
+
+            for (unsigned i=0; i<simulator.rGetCellPopulation().GetNumNodes(); i++)
+            {
+                final_locations[run].push_back(simulator.rGetCellPopulation().GetNode(i)->rGetLocation());
+            }
+        }
+
+        // Sums of forces may differ in the last bits between thread counts, but not between runs
+        TS_ASSERT_EQUALS(final_locations[1].size(), final_locations[0].size());
+        for (unsigned i=0; i<final_locations[0].size(); i++)
+        {
+            for (unsigned dim=0; dim<2; dim++)
+            {
+                TS_ASSERT_DELTA(final_locations[1][i][dim], final_locations[0][i][dim], 1e-10);
+                TS_ASSERT_EQUALS(final_locations[2][i][dim], final_locations[1][i][dim]);
+            }
+        }
+    }
+
+    /**
+     * Relax a randomly scattered cluster of cells with and without Verlet lists, where the
+     * cut-off of the force equals the maximum interaction distance of the mesh, and check
+     * that the cells move in the same way at every time step.
+     */
+    void TestRandomMonolayerWithVerletLists() throw (Exception)
+    {
+        EXIT_IF_PARALLEL;    // Verlet lists are only reused without halo boxes.
+
+        unsigned num_steps = 30;
+        std::vector<std::vector<std::vector<c_vector<double, 2> > > > locations(2);
+
+        for (unsigned run=0; run<2; run++)
+        {
+            // Reset the singletons
+            SimulationTime::Instance()->Destroy();
+            SimulationTime::Instance()->SetStartTime(0.0);
+            RandomNumberGenerator* p_gen = RandomNumberGenerator::Instance();
+            p_gen->Reseed(0);
+
+            // Pack the cells tightly so that pairs move in and out of range as the cluster spreads
+            std::vector<Node<2>*> nodes;
+            for (unsigned i=0; i<60; i++)
+            {
+                nodes.push_back(new Node<2>(i, false, 5.0*p_gen->ranf(), 5.0*p_gen->ranf()));
+            }
+
+            NodesOnlyMesh<2> mesh;
+            mesh.ConstructNodesWithoutMesh(nodes, 1.5);
+            if (run == 1)
+            {
+                mesh.SetUseCellLists(true);
+                TS_ASSERT_THROWS_THIS(mesh.SetVerletSkin(-0.3), "The Verlet skin must be non-negative.");
+                mesh.SetVerletSkin(0.3);
+                TS_ASSERT_DELTA(mesh.GetVerletSkin(), 0.3, 1e-12);
+            }
+
+            std::vector<CellPtr> cells;
+            MAKE_PTR(DifferentiatedCellProliferativeType, p_diff_type);
+            CellsGenerator<FixedG1GenerationalCellCycleModel, 2> cells_generator;
+            cells_generator.GenerateBasicRandom(cells, mesh.GetNumNodes(), p_diff_type);
+
+            NodeBasedCellPopulation<2> node_based_cell_population(mesh, cells);
+
+            OffLatticeSimulation<2> simulator(node_based_cell_population);
+            simulator.SetOutputDirectory("TestOffLatticeSimulationWithVerletLists");
+
+            MAKE_PTR(GeneralisedLinearSpringForce<2>, p_linear_force);
+            p_linear_force->SetCutOffLength(1.5);
+            simulator.AddForce(p_linear_force);
+
+            // Run one time step at a time, recording the locations after each
+            for (unsigned step=1; step<=num_steps; step++)
+            {
+                simulator.SetEndTime(step*simulator.GetDt());
+                simulator.Solve();
+
+                std::vector<c_vector<double, 2> > step_locations;
+                for (unsigned i=0; i<simulator.rGetCellPopulation().GetNumNodes(); i++)
+                {
+                    step_locations.push_back(simulator.rGetCellPopulation().GetNode(i)->rGetLocation());
+                }
+                locations[run].push_back(step_locations);
+            }
+
+            for (unsigned i=0; i<nodes.size(); i++)
+            {
+                delete nodes[i];
+            }
+        }
+
+        // Only the order in which the forces are summed differs between the two runs
+        for (unsigned step=0; step<num_steps; step++)
+        {
+            TS_ASSERT_EQUALS(locations[1][step].size(), locations[0][step].size());
+            for (unsigned i=0; i<locations[0][step].size(); i++)
+            {
+                for (unsigned dim=0; dim<2; dim++)
+                {
+                    TS_ASSERT_DELTA(locations[1][step][i][dim], locations[0][step][i][dim], 1e-10);
+                }
+            }
+        }
+    }
+
     /**
      * Create a simulation of a NodeBasedCellPopulation with a Cylindrical2dNodesOnlyMesh
      * to test periodicity.
@@ -0,0 +1,280 @@
+/*
+
+Copyright (c) 2005-2017, University of Oxford.
+All rights reserved.
+
+University of Oxford means the Chancellor, Masters and Scholars of the
+University of Oxford, having an administrative office at Wellington
+Square, Oxford OX1 2JD, UK.
+
+This file is part of Chaste.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+ * Redistributions of source code must retain the above copyright notice,
+   this list of conditions and the following disclaimer.
+ * Redistributions in binary form must reproduce the above copyright notice,
+   this list of conditions and the following disclaimer in the documentation
+   and/or other materials provided with the distribution.
+ * Neither the name of the University of Oxford nor the names of its
+   contributors may be used to endorse or promote products derived from this
+   software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+*/
+
+#ifndef TESTCELLTRAJECTORYHDF5WRITER_HPP_
+#define TESTCELLTRAJECTORYHDF5WRITER_HPP_
+
+#include <cxxtest/TestSuite.h>
+
+#include <fstream>
+
+#include "AbstractCellBasedTestSuite.hpp"
+#include "FileComparison.hpp"
+#include "CellsGenerator.hpp"
+#include "FixedG1GenerationalCellCycleModel.hpp"
+#include "NodeBasedCellPopulation.hpp"
+#include "TrianglesMeshReader.hpp"
+#include "VtkMeshReader.hpp"
+#include "SimulationTime.hpp"
+#include "SmartPointers.hpp"
+#include "CellTrajectoryHdf5Reader.hpp"
+
+// Cell writers
+#include "CellAgesWriter.hpp"
+#include "CellAncestorWriter.hpp"
+#include "CellDataItemWriter.hpp"
+#include "CellIdWriter.hpp"
+#include "CellLabelWriter.hpp"
+#include "CellLocationIndexWriter.hpp"
+#include "CellMutationStatesWriter.hpp"
+#include "CellProliferativePhasesWriter.hpp"
+#include "CellProliferativeTypesWriter.hpp"
+#include "CellVolumesWriter.hpp"
+#include "CellRosetteRankWriter.hpp"
+#include "CellRadiusWriter.hpp"
+
+#include "PetscSetupAndFinalize.hpp"
+
+class TestCellTrajectoryHdf5Writer : public AbstractCellBasedTestSuite
+{
+private:
+
+    /**
+     * Write two sampling steps of the output of a population's cell writers.
+     *
+     * @param rCellPopulation the cell population
+     * @param rOutputDirectory the directory to write to
+     */
+    void WriteTwoSamplingSteps(NodeBasedCellPopulation<2>& rCellPopulation, const std::string& rOutputDirectory)
+    {
+        OutputFileHandler output_file_handler(rOutputDirectory, false);
+
+        rCellPopulation.OpenWritersFiles(output_file_handler);
+        rCellPopulation.WriteResultsToFiles(rOutputDirectory);
+        SimulationTime::Instance()->IncrementTimeOneStep();
+        rCellPopulation.WriteResultsToFiles(rOutputDirectory);
+        rCellPopulation.CloseWritersFiles();
+    }
+
+public:
+
+    void TestStandardTextLayouts() throw (Exception)
+    {
+        typedef boost::shared_ptr<AbstractCellWriter<2,2> > writer_ptr_t;
+
+        // Only writers whose text output is the location index, cell ID, coordinates and value can be recreated
+        std::vector<writer_ptr_t> standard_writers;
+        standard_writers.push_back(writer_ptr_t(new CellDataItemWriter<2,2>("item")));
+        standard_writers.push_back(writer_ptr_t(new CellRadiusWriter<2,2>));
+        standard_writers.push_back(writer_ptr_t(new CellRosetteRankWriter<2,2>));
+        for (unsigned i=0; i<standard_writers.size(); i++)
+        {
+            TS_ASSERT_EQUALS(standard_writers[i]->HasStandardTextLayout(), true);
+        }
+
+        std::vector<writer_ptr_t> other_writers;
+        other_writers.push_back(writer_ptr_t(new CellAgesWriter<2,2>));
+        other_writers.push_back(writer_ptr_t(new CellAncestorWriter<2,2>));
+        other_writers.push_back(writer_ptr_t(new CellIdWriter<2,2>));
+        other_writers.push_back(writer_ptr_t(new CellLabelWriter<2,2>));
+        other_writers.push_back(writer_ptr_t(new CellLocationIndexWriter<2,2>));
+        other_writers.push_back(writer_ptr_t(new CellMutationStatesWriter<2,2>));
+        other_writers.push_back(writer_ptr_t(new CellProliferativePhasesWriter<2,2>));
+        other_writers.push_back(writer_ptr_t(new CellProliferativeTypesWriter<2,2>));
+        other_writers.push_back(writer_ptr_t(new CellVolumesWriter<2,2>));
+        for (unsigned i=0; i<other_writers.size(); i++)
+        {
+            TS_ASSERT_EQUALS(other_writers[i]->HasStandardTextLayout(), false);
+        }
+    }
+
+    void TestWriteAndReadColumns() throw (Exception)
+    {
+        EXIT_IF_PARALLEL;    // Conversion to VTK output is sequential
+
+        SimulationTime::Instance()->SetEndTimeAndNumberOfTimeSteps(1.0, 2);
+
+        // Create a simple mesh
+        TrianglesMeshReader<2,2> mesh_reader("mesh/test/data/square_2_elements");
+        TetrahedralMesh<2,2> generating_mesh;
+        generating_mesh.ConstructFromMeshReader(mesh_reader);
+
+        // Convert this to a NodesOnlyMesh
+        NodesOnlyMesh<2> mesh;
+        mesh.ConstructNodesWithoutMesh(generating_mesh, 1.5);
+
+        // Create cells
+        std::vector<CellPtr> cells;
+        CellsGenerator<FixedG1GenerationalCellCycleModel, 2> cells_generator;
+        cells_generator.GenerateBasic(cells, mesh.GetNumNodes());
+
+        // Create a cell population which writes its cell writers' output to HDF5
+        NodeBasedCellPopulation<2> cell_population(mesh, cells);
+        cell_population.SetOutputResultsForChasteVisualizer(false);
+        cell_population.AddCellWriter<CellAgesWriter>();
+        cell_population.AddCellWriter<CellIdWriter>();
+
+        TS_ASSERT_EQUALS(cell_population.GetOutputCellWritersInHdf5(), false);
+        cell_population.SetOutputCellWritersInHdf5(true);
+        TS_ASSERT_EQUALS(cell_population.GetOutputCellWritersInHdf5(), true);
+
+        std::string output_directory = "TestCellTrajectoryHdf5WriterColumns";
+        WriteTwoSamplingSteps(cell_population, output_directory);
+
+        // No text files are written for the cell writers
+        OutputFileHandler output_file_handler(output_directory, false);
+        TS_ASSERT(!output_file_handler.FindFile("cellages.dat").Exists());
+
+        // Read the output back
+        CellTrajectoryHdf5Reader reader(output_file_handler.FindFile("cell_trajectories.h5"));
+        TS_ASSERT_EQUALS(reader.GetNumTimeSteps(), 2u);
+        TS_ASSERT_EQUALS(reader.GetSpaceDimension(), 2u);
+        TS_ASSERT_DELTA(reader.rGetTimes()[0], 0.0, 1e-12);
+        TS_ASSERT_DELTA(reader.rGetTimes()[1], 0.5, 1e-12);
+        TS_ASSERT_EQUALS(reader.rGetValueColumnNames().size(), 2u);
+        TS_ASSERT_EQUALS(reader.rGetValueColumnNames()[0], "Ages");
+        TS_ASSERT_EQUALS(reader.rGetValueColumnNames()[1], "Cell IDs");
+
+        for (unsigned step=0; step<2; step++)
+        {
+            TS_ASSERT_EQUALS(reader.GetNumCells(step), 4u);
+
+            std::vector<unsigned> location_indices = reader.GetLocationIndices(step);
+            std::vector<unsigned> cell_ids = reader.GetCellIds(step);
+            std::vector<double> x = reader.GetColumn("x", step);
+            std::vector<double> y = reader.GetColumn("y", step);
+            std::vector<double> ages = reader.GetColumn("Ages", step);
+            TS_ASSERT_EQUALS(ages.size(), 4u);
+
+            for (unsigned row=0; row<4; row++)
+            {
+                CellPtr p_cell = cell_population.GetCellUsingLocationIndex(location_indices[row]);
+                TS_ASSERT_EQUALS(cell_ids[row], p_cell->GetCellId());
+
+                c_vector<double, 2> location = cell_population.GetLocationOfCellCentre(p_cell);
+                TS_ASSERT_DELTA(x[row], location[0], 1e-12);
+                TS_ASSERT_DELTA(y[row], location[1], 1e-12);
+
+                // The cells have aged since this sampling step
+                TS_ASSERT_DELTA(ages[row], p_cell->GetAge() - 0.5 + reader.rGetTimes()[step], 1e-9);
+            }
+        }
+
+        TS_ASSERT_THROWS_THIS(reader.GetColumn("z", 0), "The column z is not stored");
+        TS_ASSERT_THROWS_THIS(reader.GetNumCells(2), "Sampling step 2 is not stored; there are 2 sampling steps.");
+
+        // Neither writer's text output can be recreated, so no text files are written
+        OutputFileHandler conversion_handler(output_directory + "/converted", true);
+        TS_ASSERT_THROWS_THIS(reader.WriteTextFiles(conversion_handler),
+                              "Cannot convert the column Ages to text: the text output of its cell writer"
+                              " is not the location index, cell ID, coordinates and value of each cell.");
+        TS_ASSERT(!conversion_handler.FindFile("cellages.dat").Exists());
+
+#ifdef CHASTE_VTK
+        // The output can still be converted to VTK
+        reader.WriteVtkFiles(conversion_handler);
+        TS_ASSERT(conversion_handler.FindFile("results.pvd").Exists());
+
+        VtkMeshReader<2,2> vtk_reader(conversion_handler.GetOutputDirectoryFullPath() + "results_1.vtu");
+        std::vector<double> ages_data;
+        vtk_reader.GetPointData("Ages", ages_data);
+        TS_ASSERT_EQUALS(ages_data.size(), 4u);
+#endif
+    }
+
+    void TestTextFilesMatchCellWriterOutput() throw (Exception)
+    {
+        EXIT_IF_PARALLEL;
+
+        SimulationTime::Instance()->SetEndTimeAndNumberOfTimeSteps(1.0, 2);
+
+        TrianglesMeshReader<2,2> mesh_reader("mesh/test/data/square_4_elements");
+        TetrahedralMesh<2,2> generating_mesh;
+        generating_mesh.ConstructFromMeshReader(mesh_reader);
+
+        NodesOnlyMesh<2> mesh;
+        mesh.ConstructNodesWithoutMesh(generating_mesh, 1.5);
+
+        std::vector<CellPtr> cells;
+        CellsGenerator<FixedG1GenerationalCellCycleModel, 2> cells_generator;
+        cells_generator.GenerateBasic(cells, mesh.GetNumNodes());
+        for (unsigned i=0; i<cells.size(); i++)
+        {
+            cells[i]->GetCellData()->SetItem("item", 0.25*i + 1.0/3.0);
+        }
+
+        NodeBasedCellPopulation<2> cell_population(mesh, cells);
+
+        // Give the cells different radii
+        for (unsigned i=0; i<cell_population.GetNumNodes(); i++)
+        {
+            cell_population.GetNode(i)->SetRadius(0.5 + 0.1*i);
+        }
+        cell_population.SetOutputResultsForChasteVisualizer(false);
+        cell_population.AddCellWriter<CellRadiusWriter>();
+        boost::shared_ptr<CellDataItemWriter<2,2> > p_item_writer(new CellDataItemWriter<2,2>("item"));
+        cell_population.AddCellWriter(p_item_writer);
+
+        // Write the usual text output...
+        std::string text_directory = "TestCellTrajectoryHdf5WriterText";
+        WriteTwoSamplingSteps(cell_population, text_directory);
+
+        // ...then the same sampling steps in HDF5
+        SimulationTime::Destroy();
+        SimulationTime::Instance()->SetStartTime(0.0);
+        SimulationTime::Instance()->SetEndTimeAndNumberOfTimeSteps(1.0, 2);
+
+        std::string hdf5_directory = "TestCellTrajectoryHdf5WriterHdf5";
+        cell_population.SetOutputCellWritersInHdf5(true);
+        WriteTwoSamplingSteps(cell_population, hdf5_directory);
+
+        // Converting the HDF5 output to text recreates the text output
+        OutputFileHandler text_handler(text_directory, false);
+        OutputFileHandler hdf5_handler(hdf5_directory, false);
+        CellTrajectoryHdf5Reader reader(hdf5_handler.FindFile("cell_trajectories.h5"));
+
+        OutputFileHandler conversion_handler(hdf5_directory + "/converted", true);
+        reader.WriteTextFiles(conversion_handler);
+
+        std::string file_names[2] = {"cellradii.dat", "celldata_item.dat"};
+        for (unsigned i=0; i<2; i++)
+        {
+            FileComparison comparer(conversion_handler.FindFile(file_names[i]), text_handler.FindFile(file_names[i]));
+            TS_ASSERT(comparer.CompareFiles());
+        }
+    }
+};
+
+#endif /*TESTCELLTRAJECTORYHDF5WRITER_HPP_*/
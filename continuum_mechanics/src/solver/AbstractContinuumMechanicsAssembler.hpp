@@ -48,6 +48,11 @@ OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "PetscVecTools.hpp"
 #include "PetscMatTools.hpp"
 #include "GaussianQuadratureRule.hpp"
+#include "Exception.hpp"
+
+#include <algorithm>
+#include <vector>
+#include <boost/shared_ptr.hpp>
 
 
 /**
@@ -112,6 +117,21 @@ protected:
     /** Quadrature rule for volume integrals */
     GaussianQuadratureRule<DIM>* mpQuadRule;
 
+    /** Whether to take element geometry from the mesh's element geometry cache.  False by default. */
+    bool mUseElementGeometryCache;
+
+    /** The mesh's element geometry cache, while it is being used in DoAssemble(), otherwise NULL. */
+    const ElementGeometryCache<DIM,DIM>* mpElementGeometryCache;
+
+    /** The position (in element iterator order) of the element currently being assembled in DoAssemble(). */
+    unsigned mElementGeometryCachePosition;
+
+    /** The number of threads used to compute element contributions in DoAssemble().  1 by default. */
+    unsigned mNumAssemblyThreads;
+
+    /** The number of elements per thread in each block of elements assembled concurrently. */
+    static const unsigned ELEMENTS_PER_THREAD_BLOCK = 64u;
+
     /**
      * The main assembly method. Protected, should only be called through Assemble(),
      * AssembleMatrix() or AssembleVector() which set mAssembleMatrix, mAssembleVector
@@ -120,6 +140,32 @@ protected:
      */
     void DoAssemble();
 
+    /**
+     * Get the global indices of the rows and columns of the elemental matrix and vector.
+     * See comments about ordering above.
+     *
+     * @param rElement The element
+     * @param pIndices Filled in with the STENCIL_SIZE global indices
+     */
+    void GetElementGlobalIndices(Element<DIM, DIM>& rElement, unsigned* pIndices);
+
+    /**
+     * The element loop of DoAssemble() when assembling with more than one thread.  Each thread
+     * computes the contributions of part of a block of elements into a buffer, and the buffer is
+     * then added to the matrix and vector in element order, as in the serial loop.
+     */
+    void DoAssembleWithThreads();
+
+    /**
+     * @return true if the contributions of different elements may be computed concurrently, i.e. if
+     * the Compute...Term() methods of the concrete class only read member variables.  Returns false
+     * here, so concrete classes must override this to allow assembly with more than one thread.
+     */
+    virtual bool CanAssembleElementsConcurrently()
+    {
+        return false;
+    }
+
 
     /**
      *  For a continuum mechanics problem in mixed form (displacement-pressure or velocity-pressure), the matrix
@@ -287,13 +333,32 @@ protected:
                            c_matrix<double, STENCIL_SIZE, STENCIL_SIZE >& rAElem,
                            c_vector<double, STENCIL_SIZE>& rBElem);
 
+    /**
+     * Calculate the contribution of a single element to the linear system (see AssembleOnElement()).
+     * This uses no member variables that change during assembly, so may be called concurrently
+     * for different elements if CanAssembleElementsConcurrently() is true.
+     *
+     * @param rElement The element to assemble on.
+     * @param cachePosition The position of the element in the element geometry cache, if it is in use.
+     * @param rAElem The element's contribution to the LHS matrix.
+     * @param rBElem The element's contribution to the RHS vector.
+     */
+    void AssembleOnElementAtPosition(Element<DIM, DIM>& rElement,
+                                     unsigned cachePosition,
+                                     c_matrix<double, STENCIL_SIZE, STENCIL_SIZE >& rAElem,
+                                     c_vector<double, STENCIL_SIZE>& rBElem);
+
 public:
     /** Constructor
      *  @param pMesh Pointer to the mesh
      */
     AbstractContinuumMechanicsAssembler(AbstractTetrahedralMesh<DIM, DIM>* pMesh)
         : AbstractFeAssemblerInterface<CAN_ASSEMBLE_VECTOR,CAN_ASSEMBLE_MATRIX>(),
-          mpMesh(pMesh)
+          mpMesh(pMesh),
+          mUseElementGeometryCache(false),
+          mpElementGeometryCache(NULL),
+          mElementGeometryCachePosition(0),
+          mNumAssemblyThreads(1u)
     {
         assert(pMesh);
 
@@ -313,6 +378,37 @@ public:
 
 //    void SetCurrentSolution(Vec currentSolution);
 
+    /**
+     * Set whether to use the mesh's element geometry cache (see
+     * AbstractTetrahedralMesh::rGetElementGeometryCache()) for the Jacobian
+     * determinants, inverse Jacobians and linear basis function gradients,
+     * instead of computing them for each element on every assembly.
+     *
+     * @param useCache  whether to use the cache
+     */
+    void SetUseElementGeometryCache(bool useCache=true)
+    {
+        mUseElementGeometryCache = useCache;
+    }
+
+    /**
+     * Set the number of threads used to compute the element contributions on each process.
+     * This only has an effect if the concrete class allows it (see CanAssembleElementsConcurrently()),
+     * otherwise elements are assembled one at a time.  Threads are only used if Chaste is built
+     * with OpenMP (Chaste_USE_OPENMP); otherwise elements are assembled one at a time whatever
+     * this is set to.
+     *
+     * @param numThreads  the number of threads
+     */
+    void SetNumberOfAssemblyThreads(unsigned numThreads)
+    {
+        if (numThreads == 0u)
+        {
+            EXCEPTION("The number of assembly threads must be at least 1.");
+        }
+        mNumAssemblyThreads = numThreads;
+    }
+
     /**
      * Destructor.
      */
@@ -385,11 +481,24 @@ void AbstractContinuumMechanicsAssembler<DIM,CAN_ASSEMBLE_VECTOR,CAN_ASSEMBLE_MA
     c_matrix<double, STENCIL_SIZE, STENCIL_SIZE> a_elem = zero_matrix<double>(STENCIL_SIZE,STENCIL_SIZE);
     c_vector<double, STENCIL_SIZE> b_elem = zero_vector<double>(STENCIL_SIZE);
 
+    mpElementGeometryCache = NULL;
+    if (mUseElementGeometryCache)
+    {
+        mpElementGeometryCache = &(mpMesh->rGetElementGeometryCache());
+    }
+    mElementGeometryCachePosition = 0;
+
+    if (mNumAssemblyThreads > 1u && CanAssembleElementsConcurrently())
+    {
+        DoAssembleWithThreads();
+        mpElementGeometryCache = NULL;
+        return;
+    }
 
     // Loop over elements
     for (typename AbstractTetrahedralMesh<DIM, DIM>::ElementIterator iter = mpMesh->GetElementIteratorBegin();
          iter != mpMesh->GetElementIteratorEnd();
-         ++iter)
+         ++iter, ++mElementGeometryCachePosition)
     {
         Element<DIM, DIM>& r_element = *iter;
 
@@ -406,33 +515,108 @@ void AbstractContinuumMechanicsAssembler<DIM,CAN_ASSEMBLE_VECTOR,CAN_ASSEMBLE_MA
 
             AssembleOnElement(r_element, a_elem, b_elem);
 
-            // Note that a different ordering is used for the elemental matrix compared to the global matrix.
-            // See comments about ordering above.
             unsigned p_indices[STENCIL_SIZE];
-            // Work out the mapping for spatial terms
-            for (unsigned i=0; i<NUM_NODES_PER_ELEMENT; i++)
+            GetElementGlobalIndices(r_element, p_indices);
+
+            if (this->mAssembleMatrix)
             {
-                for (unsigned j=0; j<DIM; j++)
-                {
-                    // DIM+1 on the right-hand side here is the problem dimension
-                    p_indices[DIM*i+j] = (DIM+1)*r_element.GetNodeGlobalIndex(i) + j;
-                }
+                PetscMatTools::AddMultipleValues<STENCIL_SIZE>(this->mMatrixToAssemble, p_indices, a_elem);
+            }
+
+            if (this->mAssembleVector)
+            {
+                PetscVecTools::AddMultipleValues<STENCIL_SIZE>(this->mVectorToAssemble, p_indices, b_elem);
             }
-            // Work out the mapping for pressure terms
-            for (unsigned i=0; i<NUM_VERTICES_PER_ELEMENT; i++)
+        }
+    }
+    mpElementGeometryCache = NULL;
+}
+
+template<unsigned DIM, bool CAN_ASSEMBLE_VECTOR, bool CAN_ASSEMBLE_MATRIX>
+void AbstractContinuumMechanicsAssembler<DIM,CAN_ASSEMBLE_VECTOR,CAN_ASSEMBLE_MATRIX>::GetElementGlobalIndices(Element<DIM, DIM>& rElement,
+                                                                                                               unsigned* pIndices)
+{
+    // Note that a different ordering is used for the elemental matrix compared to the global matrix.
+    // See comments about ordering above.
+    // Work out the mapping for spatial terms
+    for (unsigned i=0; i<NUM_NODES_PER_ELEMENT; i++)
+    {
+        for (unsigned j=0; j<DIM; j++)
+        {
+            // DIM+1 on the right-hand side here is the problem dimension
+            pIndices[DIM*i+j] = (DIM+1)*rElement.GetNodeGlobalIndex(i) + j;
+        }
+    }
+    // Work out the mapping for pressure terms
+    for (unsigned i=0; i<NUM_VERTICES_PER_ELEMENT; i++)
+    {
+        pIndices[DIM*NUM_NODES_PER_ELEMENT + i] = (DIM+1)*rElement.GetNodeGlobalIndex(i)+DIM;
+    }
+}
+
+template<unsigned DIM, bool CAN_ASSEMBLE_VECTOR, bool CAN_ASSEMBLE_MATRIX>
+void AbstractContinuumMechanicsAssembler<DIM,CAN_ASSEMBLE_VECTOR,CAN_ASSEMBLE_MATRIX>::DoAssembleWithThreads()
+{
+    // Gather the elements to be assembled first
+    std::vector<Element<DIM, DIM>*> elements;
+    std::vector<unsigned> cache_positions;
+    unsigned position = 0;
+    for (typename AbstractTetrahedralMesh<DIM, DIM>::ElementIterator iter = mpMesh->GetElementIteratorBegin();
+         iter != mpMesh->GetElementIteratorEnd();
+         ++iter, ++position)
+    {
+        if (iter->GetOwnership() == true)
+        {
+            elements.push_back(&(*iter));
+            cache_positions.push_back(position);
+        }
+    }
+
+    const unsigned num_elements = elements.size();
+    const unsigned block_size = std::min(ELEMENTS_PER_THREAD_BLOCK*mNumAssemblyThreads, num_elements);
+    std::vector<c_matrix<double, STENCIL_SIZE, STENCIL_SIZE> > a_elems(block_size);
+    std::vector<c_vector<double, STENCIL_SIZE> > b_elems(block_size);
+    std::vector<boost::shared_ptr<Exception> > element_exceptions(block_size);
+
+    for (unsigned block_start=0; block_start<num_elements; block_start+=block_size)
+    {
+        const unsigned num_in_block = std::min(block_size, num_elements-block_start);
+
+        // Exceptions can't propagate out of a parallel region, so they are captured per element
+#ifdef CHASTE_OPENMP
+#pragma omp parallel for schedule(static) num_threads(mNumAssemblyThreads)
+#endif // CHASTE_OPENMP
+        for (int i=0; i<(int)num_in_block; i++)
+        {
+            try
+            {
+                AssembleOnElementAtPosition(*elements[block_start+i], cache_positions[block_start+i], a_elems[i], b_elems[i]);
+            }
+            catch (Exception& e)
             {
-                p_indices[DIM*NUM_NODES_PER_ELEMENT + i] = (DIM+1)*r_element.GetNodeGlobalIndex(i)+DIM;
+                element_exceptions[i].reset(new Exception(e));
             }
+        }
 
+        // Add the contributions in element order, as in the serial loop
+        for (unsigned i=0; i<num_in_block; i++)
+        {
+            if (element_exceptions[i])
+            {
+                throw *(element_exceptions[i]);
+            }
+
+            unsigned p_indices[STENCIL_SIZE];
+            GetElementGlobalIndices(*elements[block_start+i], p_indices);
 
             if (this->mAssembleMatrix)
             {
-                PetscMatTools::AddMultipleValues<STENCIL_SIZE>(this->mMatrixToAssemble, p_indices, a_elem);
+                PetscMatTools::AddMultipleValues<STENCIL_SIZE>(this->mMatrixToAssemble, p_indices, a_elems[i]);
             }
 
             if (this->mAssembleVector)
             {
-                PetscVecTools::AddMultipleValues<STENCIL_SIZE>(this->mVectorToAssemble, p_indices, b_elem);
+                PetscVecTools::AddMultipleValues<STENCIL_SIZE>(this->mVectorToAssemble, p_indices, b_elems[i]);
             }
         }
     }
@@ -443,11 +627,40 @@ void AbstractContinuumMechanicsAssembler<DIM,CAN_ASSEMBLE_VECTOR,CAN_ASSEMBLE_MA
                                                                                                          c_matrix<double, STENCIL_SIZE, STENCIL_SIZE >& rAElem,
                                                                                                          c_vector<double, STENCIL_SIZE>& rBElem)
 {
-    static c_matrix<double,DIM,DIM> jacobian;
-    static c_matrix<double,DIM,DIM> inverse_jacobian;
+    AssembleOnElementAtPosition(rElement, mElementGeometryCachePosition, rAElem, rBElem);
+}
+
+template<unsigned DIM, bool CAN_ASSEMBLE_VECTOR, bool CAN_ASSEMBLE_MATRIX>
+void AbstractContinuumMechanicsAssembler<DIM,CAN_ASSEMBLE_VECTOR,CAN_ASSEMBLE_MATRIX>::AssembleOnElementAtPosition(Element<DIM, DIM>& rElement,
+                                                                                                                   unsigned cachePosition,
+                                                                                                                   c_matrix<double, STENCIL_SIZE, STENCIL_SIZE >& rAElem,
+                                                                                                                   c_vector<double, STENCIL_SIZE>& rBElem)
+{
+    // Local rather than static, so that elements can be assembled concurrently
+    c_matrix<double,DIM,DIM> jacobian;
+    c_matrix<double,DIM,DIM> inverse_jacobian;
     double jacobian_determinant;
 
-    mpMesh->GetInverseJacobianForElement(rElement.GetIndex(), jacobian, jacobian_determinant, inverse_jacobian);
+    // Allocate memory for the basis functions values and derivative values
+    c_vector<double, NUM_VERTICES_PER_ELEMENT> linear_phi;
+    c_vector<double, NUM_NODES_PER_ELEMENT> quad_phi;
+    c_matrix<double, DIM, NUM_NODES_PER_ELEMENT> grad_quad_phi;
+    c_matrix<double, DIM, NUM_VERTICES_PER_ELEMENT> grad_linear_phi;
+
+    // Elements are straight-sided, so the linear basis function gradients are constant
+    // on the element and can be taken from the cache if it is in use
+    bool use_cache = (mpElementGeometryCache != NULL);
+    if (use_cache)
+    {
+        assert(mpElementGeometryCache->GetElementIndex(cachePosition) == rElement.GetIndex());
+        jacobian_determinant = mpElementGeometryCache->GetJacobianDeterminant(cachePosition);
+        mpElementGeometryCache->GetInverseJacobian(cachePosition, inverse_jacobian);
+        mpElementGeometryCache->GetLinearBasisGradients(cachePosition, grad_linear_phi);
+    }
+    else
+    {
+        mpMesh->GetInverseJacobianForElement(rElement.GetIndex(), jacobian, jacobian_determinant, inverse_jacobian);
+    }
 
     if (this->mAssembleMatrix)
     {
@@ -459,12 +672,6 @@ void AbstractContinuumMechanicsAssembler<DIM,CAN_ASSEMBLE_VECTOR,CAN_ASSEMBLE_MA
         rBElem.clear();
     }
 
-    // Allocate memory for the basis functions values and derivative values
-    static c_vector<double, NUM_VERTICES_PER_ELEMENT> linear_phi;
-    static c_vector<double, NUM_NODES_PER_ELEMENT> quad_phi;
-    static c_matrix<double, DIM, NUM_NODES_PER_ELEMENT> grad_quad_phi;
-    static c_matrix<double, DIM, NUM_VERTICES_PER_ELEMENT> grad_linear_phi;
-
     c_vector<double,DIM> body_force;
 
     // Loop over Gauss points
@@ -477,7 +684,10 @@ void AbstractContinuumMechanicsAssembler<DIM,CAN_ASSEMBLE_VECTOR,CAN_ASSEMBLE_MA
         LinearBasisFunction<DIM>::ComputeBasisFunctions(quadrature_point, linear_phi);
         QuadraticBasisFunction<DIM>::ComputeBasisFunctions(quadrature_point, quad_phi);
         QuadraticBasisFunction<DIM>::ComputeTransformedBasisFunctionDerivatives(quadrature_point, inverse_jacobian, grad_quad_phi);
-        LinearBasisFunction<DIM>::ComputeTransformedBasisFunctionDerivatives(quadrature_point, inverse_jacobian, grad_linear_phi);
+        if (!use_cache)
+        {
+            LinearBasisFunction<DIM>::ComputeTransformedBasisFunctionDerivatives(quadrature_point, inverse_jacobian, grad_linear_phi);
+        }
 
         // interpolate X (ie physical location of this quad point).
         c_vector<double,DIM> X = zero_vector<double>(DIM);
@@ -560,4 +770,7 @@ void AbstractContinuumMechanicsAssembler<DIM,CAN_ASSEMBLE_VECTOR,CAN_ASSEMBLE_MA
     }
 }
 
+template<unsigned DIM, bool CAN_ASSEMBLE_VECTOR, bool CAN_ASSEMBLE_MATRIX>
+const unsigned AbstractContinuumMechanicsAssembler<DIM,CAN_ASSEMBLE_VECTOR,CAN_ASSEMBLE_MATRIX>::ELEMENTS_PER_THREAD_BLOCK;
+
 #endif // ABSTRACTCONTINUUMMECHANICSASSEMBLER_HPP_
@@ -242,6 +242,16 @@ private:
     //        c_vector<double,DIM>& rX,
     //        Element<DIM,DIM>* pElement)
 
+    /**
+     * @return true, since the terms above only read the problem definition, so elements
+     * may be assembled concurrently. Note that this requires any body force function set
+     * on the problem definition to be safe to call from several threads.
+     */
+    bool CanAssembleElementsConcurrently()
+    {
+        return true;
+    }
+
 public:
     /**
      * Constructor
@@ -118,6 +118,15 @@ public:
      */
     void SetKspAbsoluteTolerance(double kspAbsoluteTolerance);
 
+    /**
+     * Set the number of threads used on each process to compute the volume integral
+     * contributions to the linear system and preconditioner (1 by default).
+     * Values greater than 1 require Chaste to be built with OpenMP support.
+     *
+     * @param numThreads the number of threads
+     */
+    void SetNumberOfAssemblyThreads(unsigned numThreads);
+
 
     /**
      * @return the flow.
@@ -321,6 +330,13 @@ void StokesFlowSolver<DIM>::SetKspAbsoluteTolerance(double kspAbsoluteTolerance)
     mKspAbsoluteTol = kspAbsoluteTolerance;
 }
 
+template<unsigned DIM>
+void StokesFlowSolver<DIM>::SetNumberOfAssemblyThreads(unsigned numThreads)
+{
+    mpStokesFlowAssembler->SetNumberOfAssemblyThreads(numThreads);
+    mpStokesFlowPreconditionerAssembler->SetNumberOfAssemblyThreads(numThreads);
+}
+
 template<unsigned DIM>
 std::vector<c_vector<double,DIM> >& StokesFlowSolver<DIM>::rGetSpatialSolution()
 {
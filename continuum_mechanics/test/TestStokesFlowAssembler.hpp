@@ -212,6 +212,50 @@ public:
         PetscTools::Destroy(vec2);
         PetscTools::Destroy(mat);
     }
+
+    void TestAssemblyWithThreads() throw(Exception)
+    {
+        QuadraticMesh<2> mesh(0.1, 1.0, 1.0);
+        StokesFlowProblemDefinition<2> problem_defn(mesh);
+        problem_defn.SetViscosity(2.0);
+        problem_defn.SetBodyForce(Create_c_vector(1.0, 2.0));
+
+        StokesFlowAssembler<2> assembler(&mesh, &problem_defn);
+        TS_ASSERT_THROWS_THIS(assembler.SetNumberOfAssemblyThreads(0u),
+                              "The number of assembly threads must be at least 1.");
+
+        unsigned size = 3*mesh.GetNumNodes();
+        Vec serial_vec = PetscTools::CreateVec(size);
+        Mat serial_mat;
+        PetscTools::SetupMat(serial_mat, size, size, 63);
+        assembler.SetVectorToAssemble(serial_vec, true);
+        assembler.SetMatrixToAssemble(serial_mat, true);
+        assembler.Assemble();
+        PetscMatTools::Finalise(serial_mat);
+
+        Vec threaded_vec = PetscTools::CreateVec(size);
+        Mat threaded_mat;
+        PetscTools::SetupMat(threaded_mat, size, size, 63);
+        assembler.SetNumberOfAssemblyThreads(3u);
+        assembler.SetVectorToAssemble(threaded_vec, true);
+        assembler.SetMatrixToAssemble(threaded_mat, true);
+        assembler.Assemble();
+        PetscMatTools::Finalise(threaded_mat);
+
+        // Contributions are added in element order, so the results should be identical (up to round-off)
+        TS_ASSERT(PetscMatTools::CheckEquality(serial_mat, threaded_mat, 1e-12));
+        ReplicatableVector serial_repl(serial_vec);
+        ReplicatableVector threaded_repl(threaded_vec);
+        for (unsigned i=0; i<size; i++)
+        {
+            TS_ASSERT_DELTA(threaded_repl[i], serial_repl[i], 1e-14);
+        }
+
+        PetscTools::Destroy(serial_vec);
+        PetscTools::Destroy(threaded_vec);
+        PetscTools::Destroy(serial_mat);
+        PetscTools::Destroy(threaded_mat);
+    }
 };
 
 #endif // TESTSTOKESFLOWASSEMBLER_HPP_
@@ -0,0 +1,99 @@
+/*
+
+Copyright (c) 2005-2017, University of Oxford.
+All rights reserved.
+
+University of Oxford means the Chancellor, Masters and Scholars of the
+University of Oxford, having an administrative office at Wellington
+Square, Oxford OX1 2JD, UK.
+
+This file is part of Chaste.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+ * Redistributions of source code must retain the above copyright notice,
+   this list of conditions and the following disclaimer.
+ * Redistributions in binary form must reproduce the above copyright notice,
+   this list of conditions and the following disclaimer in the documentation
+   and/or other materials provided with the distribution.
+ * Neither the name of the University of Oxford nor the names of its
+   contributors may be used to endorse or promote products derived from this
+   software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+*/
+
+
+#ifndef RANDOMNUMBERSTREAM_HPP_
+#define RANDOMNUMBERSTREAM_HPP_
+
+#include <boost/random.hpp>
+#include <boost/utility.hpp>
+
+/**
+ * An independent stream of random numbers.
+ *
+ * Unlike the RandomNumberGenerator singleton, any number of streams may exist,
+ * so that each thread of a parallel computation can draw from its own stream.
+ * Seeding each stream from the RandomNumberGenerator (see SeedFromGlobalGenerator())
+ * keeps a parallel computation reproducible for a given global seed, whichever
+ * thread ends up using each stream.
+ *
+ * Streams are not copyable, since the distribution adaptor refers to the generator.
+ */
+class RandomNumberStream : private boost::noncopyable
+{
+private:
+
+    /** The generator for this stream. */
+    boost::mt19937 mMersenneTwisterGenerator;
+
+    /** An adaptor to a unit interval distribution. */
+    boost::variate_generator<boost::mt19937& , boost::uniform_real<> > mGenerateUnitReal;
+
+public:
+
+    /**
+     * Constructor.
+     *
+     * @param seed  the initial seed of the stream (defaults to 0)
+     */
+    RandomNumberStream(unsigned seed=0u);
+
+    /**
+     * Reseed the stream.
+     *
+     * @param seed  the new seed
+     */
+    void Reseed(unsigned seed);
+
+    /**
+     * Reseed the stream with a seed drawn from the RandomNumberGenerator singleton.
+     */
+    void SeedFromGlobalGenerator();
+
+    /**
+     * @return Generate a uniform random number in (0,1], as RandomNumberGenerator::ranf().
+     */
+    double ranf();
+
+    /**
+     * @return Generate a random number modulo base (i.e. an integer
+     * within the range [0, base) == [0,1,..,base-1] ), as RandomNumberGenerator::randMod().
+     *
+     * @param base the base of the modulo
+     */
+    unsigned randMod(unsigned base);
+};
+
+#endif /*RANDOMNUMBERSTREAM_HPP_*/
@@ -330,6 +330,63 @@ void PetscTools::SetupMat(Mat& rMat, int numRows, int numColumns,
 #endif
 }
 
+void PetscTools::SetupMat(Mat& rMat, int numRows, int numColumns,
+                          const std::vector<PetscInt>& rDiagonalNonZeros,
+                          const std::vector<PetscInt>& rOffDiagonalNonZeros,
+                          int numLocalColumns,
+                          bool ignoreOffProcEntries,
+                          bool newAllocationError)
+{
+    assert(numRows > 0);
+    assert(numColumns > 0);
+    assert(rDiagonalNonZeros.size() == rOffDiagonalNonZeros.size());
+
+    int num_local_rows = rDiagonalNonZeros.size();
+    if (numLocalColumns == PETSC_DECIDE)
+    {
+        numLocalColumns = num_local_rows;
+    }
+
+#if (PETSC_VERSION_MAJOR == 2 && PETSC_VERSION_MINOR == 2) //PETSc 2.2
+    MatCreate(PETSC_COMM_WORLD,num_local_rows,numLocalColumns,numRows,numColumns,&rMat);
+#else //New API
+    MatCreate(PETSC_COMM_WORLD,&rMat);
+    MatSetSizes(rMat,num_local_rows,numLocalColumns,numRows,numColumns);
+#endif
+
+    // A process owning no rows still has to take part in the (collective) preallocation
+    PetscInt* p_diagonal = (num_local_rows > 0) ? const_cast<PetscInt*>(&rDiagonalNonZeros[0]) : PETSC_NULL;
+    PetscInt* p_off_diagonal = (num_local_rows > 0) ? const_cast<PetscInt*>(&rOffDiagonalNonZeros[0]) : PETSC_NULL;
+
+    if (PetscTools::IsSequential())
+    {
+        MatSetType(rMat, MATSEQAIJ);
+        MatSeqAIJSetPreallocation(rMat, 0, p_diagonal);
+    }
+    else
+    {
+        MatSetType(rMat, MATMPIAIJ);
+        MatMPIAIJSetPreallocation(rMat, 0, p_diagonal, 0, p_off_diagonal);
+    }
+
+    MatSetFromOptions(rMat);
+
+    if (ignoreOffProcEntries)
+    {
+#if (PETSC_VERSION_MAJOR == 3) //PETSc 3.x.x
+        MatSetOption(rMat, MAT_IGNORE_OFF_PROC_ENTRIES, PETSC_TRUE);
+#else
+        MatSetOption(rMat, MAT_IGNORE_OFF_PROC_ENTRIES);
+#endif
+    }
+#if (PETSC_VERSION_MAJOR == 3 && PETSC_VERSION_MINOR >= 3) //PETSc 3.3 or later
+    if (newAllocationError == false)
+    {
+        MatSetOption(rMat, MAT_NEW_NONZERO_ALLOCATION_ERR, PETSC_FALSE);
+    }
+#endif
+}
+
 void PetscTools::DumpPetscObject(const Mat& rMat, const std::string& rOutputFileFullPath)
 {
     PetscViewer view;
@@ -284,6 +284,28 @@ public:
                          bool ignoreOffProcEntries=true,
                          bool newAllocationError=true);
 
+    /**
+     * Set up a matrix with exact per-row preallocation, as given by the numbers of nonzero
+     * entries in the diagonal and off-diagonal blocks of each locally owned row (see
+     * AbstractTetrahedralMesh::CalculateLocalRowNonZeroCounts). SetFromOptions is called.
+     *
+     * @param rMat the matrix
+     * @param numRows the number of rows in the matrix
+     * @param numColumns the number of columns in the matrix
+     * @param rDiagonalNonZeros the number of nonzeros in the columns owned by this process, for each local row
+     * @param rOffDiagonalNonZeros the number of nonzeros in the columns owned by other processes, for each local row
+     * @param numLocalColumns the number of local columns (defaults to the number of local rows)
+     * @param ignoreOffProcEntries tells PETSc to drop off-processor entries
+     * @param newAllocationError tells PETSc whether to set the MAT_NEW_NONZERO_ALLOCATION_ERR.
+     *        ** currently only used in PETSc 3.3 and later **
+     */
+    static void SetupMat(Mat& rMat, int numRows, int numColumns,
+                         const std::vector<PetscInt>& rDiagonalNonZeros,
+                         const std::vector<PetscInt>& rOffDiagonalNonZeros,
+                         int numLocalColumns=PETSC_DECIDE,
+                         bool ignoreOffProcEntries=true,
+                         bool newAllocationError=true);
+
     /**
      * Boolean OR of flags between processes.
      *
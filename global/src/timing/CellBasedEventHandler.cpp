@@ -35,6 +35,80 @@ OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include "CellBasedEventHandler.hpp"
 
+#include <cstdio>
+#include <iostream>
+
 const char* CellBasedEventHandler::EventName[] = { "Setup", "Death", "Birth",
                                                 "Update_Pop", "Update_Sim", "Tessellate", "Force",
                                                 "Position", "Output", "Pde", "Total" };
+
+const char* CellBasedEventHandler::ObjectTypeName[] = { "Cell", "Cell_cycle", "Srn", "Cell_data" };
+
+unsigned long CellBasedEventHandler::mNumAllocations[] = { 0, 0, 0, 0 };
+unsigned long CellBasedEventHandler::mNumReusedAllocations[] = { 0, 0, 0, 0 };
+unsigned long CellBasedEventHandler::mNumDeallocations[] = { 0, 0, 0, 0 };
+
+void CellBasedEventHandler::CountAllocation(unsigned objectType, bool reused)
+{
+    assert(objectType < 4);
+    mNumAllocations[objectType]++;
+    if (reused)
+    {
+        mNumReusedAllocations[objectType]++;
+    }
+}
+
+void CellBasedEventHandler::CountDeallocation(unsigned objectType)
+{
+    assert(objectType < 4);
+    mNumDeallocations[objectType]++;
+}
+
+unsigned long CellBasedEventHandler::GetNumAllocations(unsigned objectType)
+{
+    assert(objectType < 4);
+    return mNumAllocations[objectType];
+}
+
+unsigned long CellBasedEventHandler::GetNumReusedAllocations(unsigned objectType)
+{
+    assert(objectType < 4);
+    return mNumReusedAllocations[objectType];
+}
+
+unsigned long CellBasedEventHandler::GetNumDeallocations(unsigned objectType)
+{
+    assert(objectType < 4);
+    return mNumDeallocations[objectType];
+}
+
+void CellBasedEventHandler::ResetAllocationCounts()
+{
+    for (unsigned type=0; type<4; type++)
+    {
+        mNumAllocations[type] = 0;
+        mNumReusedAllocations[type] = 0;
+        mNumDeallocations[type] = 0;
+    }
+}
+
+void CellBasedEventHandler::ReportAllocations()
+{
+    PetscTools::BeginRoundRobin();
+    {
+        std::cout.flush();
+        if (PetscTools::IsParallel())
+        {
+            // Report the process number at the beginning of the line
+            printf("%3u: ", PetscTools::GetMyRank()); //5 chars
+        }
+        for (unsigned type=0; type<4; type++)
+        {
+            printf("%s %lu (%lu reused, %lu freed)  ", ObjectTypeName[type], mNumAllocations[type],
+                   mNumReusedAllocations[type], mNumDeallocations[type]);
+        }
+        std::cout << "(allocations) \n";
+    }
+    PetscTools::EndRoundRobin();
+    std::cout.flush();
+}
@@ -63,6 +63,76 @@ public:
         PDE,
         EVERYTHING
     } CellBasedEventType;
+
+    /** Character array holding the names of the pooled object types. There are four pooled object types. */
+    static const char* ObjectTypeName[4];
+
+    /** Definition of the object types whose allocations are counted. */
+    typedef enum
+    {
+        CELL_OBJECTS=0,
+        CELL_CYCLE_MODEL_OBJECTS,
+        SRN_MODEL_OBJECTS,
+        CELL_DATA_OBJECTS
+    } CellBasedObjectType;
+
+    /**
+     * Record the allocation of an object.
+     *
+     * @param objectType the type of object allocated
+     * @param reused whether the memory was reused from a pool rather than newly obtained
+     */
+    static void CountAllocation(unsigned objectType, bool reused);
+
+    /**
+     * Record the deallocation of an object.
+     *
+     * @param objectType the type of object deallocated
+     */
+    static void CountDeallocation(unsigned objectType);
+
+    /**
+     * @return the number of objects of a given type allocated since the counts were last reset.
+     *
+     * @param objectType the type of object
+     */
+    static unsigned long GetNumAllocations(unsigned objectType);
+
+    /**
+     * @return the number of allocations of a given type that reused pooled memory
+     * since the counts were last reset.
+     *
+     * @param objectType the type of object
+     */
+    static unsigned long GetNumReusedAllocations(unsigned objectType);
+
+    /**
+     * @return the number of objects of a given type deallocated since the counts were last reset.
+     *
+     * @param objectType the type of object
+     */
+    static unsigned long GetNumDeallocations(unsigned objectType);
+
+    /**
+     * Set all allocation counts to zero.
+     */
+    static void ResetAllocationCounts();
+
+    /**
+     * Output the allocation counts of each process, one line per process.
+     */
+    static void ReportAllocations();
+
+private:
+
+    /** The number of objects of each type allocated. */
+    static unsigned long mNumAllocations[4];
+
+    /** The number of allocations of each type that reused pooled memory. */
+    static unsigned long mNumReusedAllocations[4];
+
+    /** The number of objects of each type deallocated. */
+    static unsigned long mNumDeallocations[4];
 };
 
 #endif /*CELLBASEDEVENTHANDLER_HPP_*/
@@ -35,8 +35,72 @@ OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include "HeartEventHandler.hpp"
 
+#include <iostream>
+#include "PetscTools.hpp"
+
 const char* HeartEventHandler::EventName[] =  { "InMesh", "Init", "AssSys", "Ode",
                                            "Comms", "AssRhs", "NeuBCs", "DirBCs",
                                            "Ksp", "Output", "DataConversion",
                                            "PostProc", "User1", "User2",
                                            "User3","Total" };
+
+unsigned HeartEventHandler::mNumActiveCellsLastStep = 0u;
+unsigned long HeartEventHandler::mTotalActiveCells = 0u;
+unsigned long HeartEventHandler::mTotalCells = 0u;
+unsigned HeartEventHandler::mNumStepsRecorded = 0u;
+
+void HeartEventHandler::RecordActiveCells(unsigned numActiveCells, unsigned numCells)
+{
+    assert(numActiveCells <= numCells);
+    mNumActiveCellsLastStep = numActiveCells;
+    mTotalActiveCells += numActiveCells;
+    mTotalCells += numCells;
+    mNumStepsRecorded++;
+}
+
+unsigned HeartEventHandler::GetNumActiveCellsLastStep()
+{
+    return mNumActiveCellsLastStep;
+}
+
+unsigned long HeartEventHandler::GetTotalActiveCells()
+{
+    return mTotalActiveCells;
+}
+
+unsigned long HeartEventHandler::GetTotalCells()
+{
+    return mTotalCells;
+}
+
+unsigned HeartEventHandler::GetNumStepsRecorded()
+{
+    return mNumStepsRecorded;
+}
+
+void HeartEventHandler::ResetActiveCellCounts()
+{
+    mNumActiveCellsLastStep = 0u;
+    mTotalActiveCells = 0u;
+    mTotalCells = 0u;
+    mNumStepsRecorded = 0u;
+}
+
+void HeartEventHandler::ReportActiveCells()
+{
+    for (unsigned proc=0; proc<PetscTools::GetNumProcs(); proc++)
+    {
+        if (proc == PetscTools::GetMyRank())
+        {
+            std::cout << proc << ": " << mNumStepsRecorded << " steps, ";
+            if (mNumStepsRecorded > 0u)
+            {
+                std::cout << (double)mTotalActiveCells/mNumStepsRecorded << " of "
+                          << (double)mTotalCells/mNumStepsRecorded << " cells active per step ("
+                          << (mTotalCells == 0u ? 0.0 : 100.0*mTotalActiveCells/mTotalCells) << "% of cell solves)";
+            }
+            std::cout << "\n" << std::flush;
+        }
+        PetscTools::Barrier("HeartEventHandler::ReportActiveCells");
+    }
+}
@@ -43,6 +43,10 @@ OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
  * simulations.
  *
  * It also contains events suitable to most generic PDE solvers too.
+ *
+ * As well as timings, it keeps counts of how many cell models were actually solved
+ * (i.e. were "active") on each PDE step, for use with adaptive cell solves
+ * (see HeartConfig::SetUseAdaptiveCellSolves).  These counts are local to each process.
  */
 class HeartEventHandler : public GenericEventHandler<16, HeartEventHandler>
 {
@@ -71,6 +75,48 @@ public:
         USER3,
         EVERYTHING
     } EventType;
+
+    /**
+     * Record how many of the local cell models were solved on a PDE step.
+     *
+     * @param numActiveCells  the number of cells solved
+     * @param numCells  the total number of local cells
+     */
+    static void RecordActiveCells(unsigned numActiveCells, unsigned numCells);
+
+    /** @return the number of cells solved on the most recent step recorded. */
+    static unsigned GetNumActiveCellsLastStep();
+
+    /** @return the total number of cell solves recorded, summed over steps. */
+    static unsigned long GetTotalActiveCells();
+
+    /** @return the total number of cells, summed over the steps recorded. */
+    static unsigned long GetTotalCells();
+
+    /** @return the number of steps recorded. */
+    static unsigned GetNumStepsRecorded();
+
+    /** Zero the active cell counts. */
+    static void ResetActiveCellCounts();
+
+    /**
+     * Print the active cell counts on each process, i.e. the average number of cells
+     * solved per step and the fraction of cell solves performed.
+     */
+    static void ReportActiveCells();
+
+private:
+    /** Number of cells solved on the most recent step recorded. */
+    static unsigned mNumActiveCellsLastStep;
+
+    /** Total number of cell solves recorded. */
+    static unsigned long mTotalActiveCells;
+
+    /** Total number of cells, summed over the steps recorded. */
+    static unsigned long mTotalCells;
+
+    /** Number of steps recorded. */
+    static unsigned mNumStepsRecorded;
 };
 
 #endif /*HEARTEVENTHANDLER_HPP_*/
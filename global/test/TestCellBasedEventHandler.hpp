@@ -92,6 +92,28 @@ public:
 
         CellBasedEventHandler::Report();
     }
+
+    void TestAllocationCounts() throw(Exception)
+    {
+        CellBasedEventHandler::ResetAllocationCounts();
+
+        CellBasedEventHandler::CountAllocation(CellBasedEventHandler::CELL_OBJECTS, false);
+        CellBasedEventHandler::CountAllocation(CellBasedEventHandler::CELL_OBJECTS, true);
+        CellBasedEventHandler::CountAllocation(CellBasedEventHandler::SRN_MODEL_OBJECTS, true);
+        CellBasedEventHandler::CountDeallocation(CellBasedEventHandler::CELL_OBJECTS);
+
+        TS_ASSERT_EQUALS(CellBasedEventHandler::GetNumAllocations(CellBasedEventHandler::CELL_OBJECTS), 2u);
+        TS_ASSERT_EQUALS(CellBasedEventHandler::GetNumReusedAllocations(CellBasedEventHandler::CELL_OBJECTS), 1u);
+        TS_ASSERT_EQUALS(CellBasedEventHandler::GetNumDeallocations(CellBasedEventHandler::CELL_OBJECTS), 1u);
+        TS_ASSERT_EQUALS(CellBasedEventHandler::GetNumAllocations(CellBasedEventHandler::CELL_CYCLE_MODEL_OBJECTS), 0u);
+        TS_ASSERT_EQUALS(CellBasedEventHandler::GetNumReusedAllocations(CellBasedEventHandler::SRN_MODEL_OBJECTS), 1u);
+        TS_ASSERT_EQUALS(CellBasedEventHandler::GetNumDeallocations(CellBasedEventHandler::CELL_DATA_OBJECTS), 0u);
+
+        CellBasedEventHandler::ReportAllocations();
+
+        CellBasedEventHandler::ResetAllocationCounts();
+        TS_ASSERT_EQUALS(CellBasedEventHandler::GetNumAllocations(CellBasedEventHandler::CELL_OBJECTS), 0u);
+    }
 };
 
 #endif /*TESTCELLBASEDEVENTHANDLER_HPP_*/
@@ -99,6 +99,27 @@ public:
 
     }
 
+    void TestActiveCellCounts() throw(Exception)
+    {
+        HeartEventHandler::ResetActiveCellCounts();
+        TS_ASSERT_EQUALS(HeartEventHandler::GetNumStepsRecorded(), 0u);
+        HeartEventHandler::ReportActiveCells();
+
+        HeartEventHandler::RecordActiveCells(3u, 10u);
+        TS_ASSERT_EQUALS(HeartEventHandler::GetNumActiveCellsLastStep(), 3u);
+        HeartEventHandler::RecordActiveCells(5u, 10u);
+        TS_ASSERT_EQUALS(HeartEventHandler::GetNumActiveCellsLastStep(), 5u);
+        TS_ASSERT_EQUALS(HeartEventHandler::GetTotalActiveCells(), 8u);
+        TS_ASSERT_EQUALS(HeartEventHandler::GetTotalCells(), 20u);
+        TS_ASSERT_EQUALS(HeartEventHandler::GetNumStepsRecorded(), 2u);
+        HeartEventHandler::ReportActiveCells();
+
+        HeartEventHandler::ResetActiveCellCounts();
+        TS_ASSERT_EQUALS(HeartEventHandler::GetNumActiveCellsLastStep(), 0u);
+        TS_ASSERT_EQUALS(HeartEventHandler::GetTotalActiveCells(), 0u);
+        TS_ASSERT_EQUALS(HeartEventHandler::GetTotalCells(), 0u);
+    }
+
     void TestEventExceptions() throw(Exception)
     {
         // Should not be able to end and event that has not yet begun
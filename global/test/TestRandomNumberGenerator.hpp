@@ -41,6 +41,7 @@ OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include "OutputFileHandler.hpp"
 #include "RandomNumberGenerator.hpp"
+#include "RandomNumberStream.hpp"
 
 //This test is always run sequentially (never in parallel)
 #include "FakePetscSetup.hpp"
@@ -510,6 +511,40 @@ public:
         TS_ASSERT_DELTA(p_gen->ExponentialRandomDeviate(3.0), 0.1137, 1e-4);
         TS_ASSERT_DELTA(p_gen->ExponentialRandomDeviate(4.0), 0.2847, 1e-4);
     }
+
+    void TestRandomNumberStreams()
+    {
+        RandomNumberGenerator::Destroy();
+        RandomNumberGenerator* p_gen = RandomNumberGenerator::Instance();
+        p_gen->Reseed(7);
+
+        // A stream with the same seed gives the same numbers as the global generator
+        RandomNumberStream stream(7);
+        for (unsigned i=0; i<10; i++)
+        {
+            TS_ASSERT_EQUALS(stream.randMod(100), p_gen->randMod(100));
+            TS_ASSERT_EQUALS(stream.ranf(), p_gen->ranf());
+        }
+
+        // Streams are independent of each other and of the global generator
+        RandomNumberStream other_stream(7);
+        stream.Reseed(7);
+        double first = stream.ranf();
+        p_gen->ranf();
+        TS_ASSERT_EQUALS(other_stream.ranf(), first);
+
+        // Seeding from the global generator is reproducible
+        p_gen->Reseed(3);
+        stream.SeedFromGlobalGenerator();
+        other_stream.SeedFromGlobalGenerator();
+        p_gen->Reseed(3);
+        RandomNumberStream third_stream;
+        third_stream.SeedFromGlobalGenerator();
+        double value = stream.ranf();
+        TS_ASSERT_EQUALS(third_stream.ranf(), value);
+        TS_ASSERT_DIFFERS(other_stream.ranf(), value);
+        TS_ASSERT_LESS_THAN(stream.randMod(5), 5u);
+    }
 };
 
 #endif /*TESTRANDOMNUMBERGENERATOR_HPP_*/
@@ -67,6 +67,60 @@ void AbstractCardiacCell::SetTimestep(double dt)
     mDt = dt;
 }
 
+double AbstractCardiacCell::GetTimestep() const
+{
+    return mDt;
+}
+
+bool AbstractCardiacCell::HasBatchKernels() const
+{
+    return false;
+}
+
+void AbstractCardiacCell::EvaluateYDerivativesBatch(double time,
+                                                    const std::vector<AbstractCardiacCell*>& rCells,
+                                                    const double* pStateVariables,
+                                                    double* pDerivatives)
+{
+    const unsigned num_cells = rCells.size();
+    const unsigned num_vars = GetNumberOfStateVariables();
+    std::vector<double> y(num_vars);
+    std::vector<double> dy(num_vars);
+
+    for (unsigned cell=0; cell<num_cells; cell++)
+    {
+        assert(rCells[cell]->GetNumberOfStateVariables() == num_vars);
+        for (unsigned i=0; i<num_vars; i++)
+        {
+            y[i] = pStateVariables[i*num_cells + cell];
+        }
+        rCells[cell]->EvaluateYDerivatives(time, y, dy);
+        for (unsigned i=0; i<num_vars; i++)
+        {
+            pDerivatives[i*num_cells + cell] = dy[i];
+        }
+    }
+}
+
+void AbstractCardiacCell::GetIIonicBatch(const std::vector<AbstractCardiacCell*>& rCells,
+                                         const double* pStateVariables,
+                                         double* pIIonic)
+{
+    const unsigned num_cells = rCells.size();
+    const unsigned num_vars = GetNumberOfStateVariables();
+    std::vector<double> y(num_vars);
+
+    for (unsigned cell=0; cell<num_cells; cell++)
+    {
+        assert(rCells[cell]->GetNumberOfStateVariables() == num_vars);
+        for (unsigned i=0; i<num_vars; i++)
+        {
+            y[i] = pStateVariables[i*num_cells + cell];
+        }
+        pIIonic[cell] = rCells[cell]->GetIIonic(&y);
+    }
+}
+
 void AbstractCardiacCell::SolveAndUpdateState(double tStart, double tEnd)
 {
     mpOdeSolver->SolveAndUpdateStateVariable(this, tStart, tEnd, mDt);
@@ -172,6 +172,53 @@ public:
      */
     void SetTimestep(double dt);
 
+    /**
+     * @return the timestep used for simulating this cell.
+     */
+    double GetTimestep() const;
+
+    /**
+     * @return whether this cell model provides its own EvaluateYDerivativesBatch and
+     * GetIIonicBatch kernels, and so is worth solving in a CardiacCellBatch.  False by
+     * default; models generated by PyCml with the --batched option return true.
+     */
+    virtual bool HasBatchKernels() const;
+
+    /**
+     * Evaluate the derivatives of a block of cells of the same concrete type as this
+     * one, whose state variables are held in structure-of-arrays layout by a
+     * CardiacCellBatch.  This method is called on the first cell of the block.
+     *
+     * The default implementation copies each cell's state into a scratch vector and
+     * calls EvaluateYDerivatives on it, and so is no faster than solving the cells one
+     * at a time.  Cell models which override it should also override HasBatchKernels.
+     *
+     * @param time  the current time
+     * @param rCells  the cells in the block
+     * @param pStateVariables  the state variables of the block; entry i*rCells.size()+c is variable i of cell c
+     * @param pDerivatives  filled in with the derivatives, in the same layout as pStateVariables
+     */
+    virtual void EvaluateYDerivativesBatch(double time,
+                                           const std::vector<AbstractCardiacCell*>& rCells,
+                                           const double* pStateVariables,
+                                           double* pDerivatives);
+
+    /**
+     * Compute the ionic currents of a block of cells of the same concrete type as this
+     * one, whose state variables are held in structure-of-arrays layout by a
+     * CardiacCellBatch.  This method is called on the first cell of the block.
+     *
+     * The default implementation copies each cell's state into a scratch vector and
+     * calls GetIIonic on it.
+     *
+     * @param rCells  the cells in the block
+     * @param pStateVariables  the state variables of the block; entry i*rCells.size()+c is variable i of cell c
+     * @param pIIonic  filled in with the ionic current of each cell
+     */
+    virtual void GetIIonicBatch(const std::vector<AbstractCardiacCell*>& rCells,
+                                const double* pStateVariables,
+                                double* pIIonic);
+
     /**
      * Simulate this cell's behaviour between the time interval [tStart, tEnd],
      * with timestemp #mDt, updating the internal state variable values.
@@ -35,11 +35,16 @@ OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include "AbstractLookupTableCollection.hpp"
 
+#include <cassert>
 #include <cmath>
+#include <iostream>
+
+#include "Exception.hpp"
 
 AbstractLookupTableCollection::AbstractLookupTableCollection()
     : mDt(0.0)
 {
+    rGetAllCollections().insert(this);
 }
 
 std::vector<std::string> AbstractLookupTableCollection::GetKeyingVariableNames() const
@@ -47,6 +52,11 @@ std::vector<std::string> AbstractLookupTableCollection::GetKeyingVariableNames()
     return mKeyingVariableNames;
 }
 
+unsigned AbstractLookupTableCollection::GetKeyingVariableIndex(const std::string& rKeyingVariableName) const
+{
+    return GetTableIndex(rKeyingVariableName);
+}
+
 unsigned AbstractLookupTableCollection::GetNumberOfTables(const std::string& rKeyingVariableName) const
 {
     return mNumberOfTables[GetTableIndex(rKeyingVariableName)];
@@ -107,8 +117,86 @@ unsigned AbstractLookupTableCollection::GetTableIndex(const std::string& rKeying
     return i;
 }
 
+void AbstractLookupTableCollection::IndexTablesBatch(unsigned keyingVariableIndex, const double* pKeys, unsigned numKeys, double* pRows)
+{
+    EXCEPTION("Batched lookups are not supported by this lookup table collection.");
+}
+
+void AbstractLookupTableCollection::GetTableStatistics(const std::string& rKeyingVariableName,
+                                                       unsigned long& rScalarLookups,
+                                                       unsigned long& rBatchedLookups,
+                                                       unsigned long& rOutOfRange) const
+{
+    unsigned i = GetTableIndex(rKeyingVariableName);
+    assert(i < mNumBatchedLookups.size()); // Subclass constructors must call ResetTableStatistics
+    rScalarLookups = mNumScalarLookups[i];
+    rBatchedLookups = mNumBatchedLookups[i];
+    rOutOfRange = mNumOutOfRange[i];
+}
+
+void AbstractLookupTableCollection::ResetTableStatistics()
+{
+    mNumScalarLookups.assign(mKeyingVariableNames.size(), 0u);
+    mNumBatchedLookups.assign(mKeyingVariableNames.size(), 0u);
+    mNumOutOfRange.assign(mKeyingVariableNames.size(), 0u);
+}
+
+void AbstractLookupTableCollection::RecordBatchedLookups(unsigned keyingVariableIndex, unsigned numLookups)
+{
+    assert(keyingVariableIndex < mNumBatchedLookups.size());
+    // Batches may be looked up concurrently by cell solve threads
+#ifdef CHASTE_OPENMP
+#pragma omp atomic
+#endif // CHASTE_OPENMP
+    mNumBatchedLookups[keyingVariableIndex] += numLookups;
+}
+
+void AbstractLookupTableCollection::RecordOutOfRange(unsigned keyingVariableIndex)
+{
+    assert(keyingVariableIndex < mNumOutOfRange.size());
+#ifdef CHASTE_OPENMP
+#pragma omp atomic
+#endif // CHASTE_OPENMP
+    mNumOutOfRange[keyingVariableIndex]++;
+}
+
+std::set<AbstractLookupTableCollection*>& AbstractLookupTableCollection::rGetAllCollections()
+{
+    static std::set<AbstractLookupTableCollection*> all_collections;
+    return all_collections;
+}
+
 AbstractLookupTableCollection::~AbstractLookupTableCollection()
 {
+    rGetAllCollections().erase(this);
 }
 
 const char* AbstractLookupTableCollection::EventHandler::EventName[] =  {"GenTables"};
+
+void AbstractLookupTableCollection::EventHandler::ReportTableStatistics()
+{
+    std::set<AbstractLookupTableCollection*>& r_collections = rGetAllCollections();
+    for (std::set<AbstractLookupTableCollection*>::iterator it = r_collections.begin(); it != r_collections.end(); ++it)
+    {
+        AbstractLookupTableCollection* p_collection = *it;
+        std::cout << "Lookup tables " << p_collection->mCollectionName << ":\n";
+        for (unsigned i=0; i<p_collection->mKeyingVariableNames.size(); i++)
+        {
+            unsigned long scalar_lookups, batched_lookups, out_of_range;
+            p_collection->GetTableStatistics(p_collection->mKeyingVariableNames[i], scalar_lookups, batched_lookups, out_of_range);
+            std::cout << "\t" << p_collection->mKeyingVariableNames[i] << " [" << p_collection->mTableMins[i]
+                      << ", " << p_collection->mTableMaxs[i] << "]: " << scalar_lookups << " scalar lookups, "
+                      << batched_lookups << " batched lookups, " << out_of_range << " out of range\n";
+        }
+    }
+    std::cout << std::flush;
+}
+
+void AbstractLookupTableCollection::EventHandler::ResetTableStatistics()
+{
+    std::set<AbstractLookupTableCollection*>& r_collections = rGetAllCollections();
+    for (std::set<AbstractLookupTableCollection*>::iterator it = r_collections.begin(); it != r_collections.end(); ++it)
+    {
+        (*it)->ResetTableStatistics();
+    }
+}
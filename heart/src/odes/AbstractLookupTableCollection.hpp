@@ -36,6 +36,8 @@ OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #ifndef ABSTRACTLOOKUPTABLECOLLECTION_HPP_
 #define ABSTRACTLOOKUPTABLECOLLECTION_HPP_
 
+#include <cassert>
+#include <set>
 #include <string>
 #include <vector>
 
@@ -44,7 +46,8 @@ OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 /**
  * Base class for lookup tables used in optimised cells generated by PyCml.
  * Contains methods to query and adjust table parameters (i.e. size and spacing),
- * and an event handler to time table generation.
+ * a batched lookup method for evaluating table rows for many keying values at once,
+ * and an event handler to time table generation and report usage statistics.
  */
 class AbstractLookupTableCollection
 {
@@ -59,6 +62,13 @@ public:
      */
     std::vector<std::string> GetKeyingVariableNames() const;
 
+    /**
+     * @return the index of the given variable within GetKeyingVariableNames().
+     *
+     * @param rKeyingVariableName  the table key name
+     */
+    unsigned GetKeyingVariableIndex(const std::string& rKeyingVariableName) const;
+
     /**
      * @return the number of lookup tables keyed by the given variable.
      *
@@ -111,11 +121,48 @@ public:
      */
     virtual void FreeMemory()=0;
 
+    /**
+     * Look up the values of all tables keyed by the given variable for a block of keying values,
+     * e.g. the voltages of a batch of cells.  Entry j*numKeys+k of the output is the (interpolated)
+     * value of table j for pKeys[k], so that each table's values are contiguous.  All the keys are
+     * checked against the table bounds before any values are computed.
+     *
+     * Subclasses generated by PyCml with the row lookup method implement this; the default
+     * implementation throws.
+     *
+     * @param keyingVariableIndex  the index of the table key (see GetKeyingVariableIndex)
+     * @param pKeys  the keying values
+     * @param numKeys  the number of keying values
+     * @param pRows  contiguous memory for numKeys*GetNumberOfTables() table values
+     */
+    virtual void IndexTablesBatch(unsigned keyingVariableIndex, const double* pKeys, unsigned numKeys, double* pRows);
+
+    /**
+     * Get usage statistics for the tables keyed by the given variable, accumulated since
+     * construction or the last call to ResetTableStatistics.  Out of range keys are counted
+     * for all lookups which check their table bounds.
+     *
+     * @param rKeyingVariableName  the table key name
+     * @param rScalarLookups  will be filled with the number of keys looked up one at a time by single cells
+     * @param rBatchedLookups  will be filled with the number of keys looked up by IndexTablesBatch
+     * @param rOutOfRange  will be filled with the number of keys outside the table bounds
+     */
+    void GetTableStatistics(const std::string& rKeyingVariableName,
+                            unsigned long& rScalarLookups,
+                            unsigned long& rBatchedLookups,
+                            unsigned long& rOutOfRange) const;
+
+    /**
+     * Zero the usage statistics for all tables.
+     */
+    void ResetTableStatistics();
+
     /** Virtual destructor since we have a virtual method. */
     virtual ~AbstractLookupTableCollection();
 
     /**
-     * A little event handler with one event, to time table generation.
+     * A little event handler with one event, to time table generation.  It can also report
+     * the usage statistics of every lookup table collection in existence, to help tune table bounds.
      */
     class EventHandler : public GenericEventHandler<1, EventHandler>
     {
@@ -128,6 +175,17 @@ public:
         {
             GENERATE_TABLES=0
         } EventType;
+
+        /**
+         * Print the usage statistics (see GetTableStatistics) of each keying variable of each
+         * existing lookup table collection to std::cout.
+         */
+        static void ReportTableStatistics();
+
+        /**
+         * Zero the usage statistics of all existing lookup table collections.
+         */
+        static void ResetTableStatistics();
     };
 
 protected:
@@ -138,6 +196,40 @@ protected:
      */
     unsigned GetTableIndex(const std::string& rKeyingVariableName) const;
 
+    /**
+     * Record a lookup of a single key.  Called by the subclass methods that index the tables for one cell.
+     * Defined here so that it can be inlined, since it is called on every lookup.
+     *
+     * @param keyingVariableIndex  the index of the table key
+     */
+    void RecordScalarLookup(unsigned keyingVariableIndex)
+    {
+        assert(keyingVariableIndex < mNumScalarLookups.size());
+        // Cells may be solved concurrently by cell solve threads
+#ifdef CHASTE_OPENMP
+#pragma omp atomic
+#endif // CHASTE_OPENMP
+        mNumScalarLookups[keyingVariableIndex]++;
+    }
+
+    /**
+     * Record a batched lookup.  Called by subclass implementations of IndexTablesBatch.
+     *
+     * @param keyingVariableIndex  the index of the table key
+     * @param numLookups  the number of keys looked up
+     */
+    void RecordBatchedLookups(unsigned keyingVariableIndex, unsigned numLookups);
+
+    /**
+     * Record that a key was outside the table bounds.  Called by subclasses when checking bounds.
+     *
+     * @param keyingVariableIndex  the index of the table key
+     */
+    void RecordOutOfRange(unsigned keyingVariableIndex);
+
+    /** Name of this collection, used when reporting statistics */
+    std::string mCollectionName;
+
     /** Names of variables used to index lookup tables */
     std::vector<std::string> mKeyingVariableNames;
 
@@ -161,6 +253,19 @@ protected:
 
     /** Timestep to use in lookup tables */
     double mDt;
+
+    /** Number of single-key lookups for tables indexed by each variable */
+    std::vector<unsigned long> mNumScalarLookups;
+
+    /** Number of batched lookups for tables indexed by each variable */
+    std::vector<unsigned long> mNumBatchedLookups;
+
+    /** Number of keys outside the table bounds, for tables indexed by each variable */
+    std::vector<unsigned long> mNumOutOfRange;
+
+private:
+    /** @return the set of all existing lookup table collections, for reporting statistics. */
+    static std::set<AbstractLookupTableCollection*>& rGetAllCollections();
 };
 
 #endif // ABSTRACTLOOKUPTABLECOLLECTION_HPP_
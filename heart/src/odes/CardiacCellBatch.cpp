@@ -0,0 +1,225 @@
+/*
+
+Copyright (c) 2005-2017, University of Oxford.
+All rights reserved.
+
+University of Oxford means the Chancellor, Masters and Scholars of the
+University of Oxford, having an administrative office at Wellington
+Square, Oxford OX1 2JD, UK.
+
+This file is part of Chaste.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+ * Redistributions of source code must retain the above copyright notice,
+   this list of conditions and the following disclaimer.
+ * Redistributions in binary form must reproduce the above copyright notice,
+   this list of conditions and the following disclaimer in the documentation
+   and/or other materials provided with the distribution.
+ * Neither the name of the University of Oxford nor the names of its
+   contributors may be used to endorse or promote products derived from this
+   software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+*/
+#include "CardiacCellBatch.hpp"
+
+#include <cassert>
+#include <typeinfo>
+
+#include "EulerIvpOdeSolver.hpp"
+#include "TimeStepper.hpp"
+
+CardiacCellBatch::CardiacCellBatch(AbstractCardiacCell* pFirstCell)
+    : mNumberOfStateVariables(pFirstCell->GetNumberOfStateVariables()),
+      mVoltageIndex(pFirstCell->GetVoltageIndex()),
+      mDt(pFirstCell->GetTimestep()),
+      mStateIsResident(false)
+{
+    assert(CanBatch(pFirstCell));
+    mCells.push_back(pFirstCell);
+}
+
+bool CardiacCellBatch::CanBatch(AbstractCardiacCellInterface* pCell)
+{
+    AbstractCardiacCell* p_cell = dynamic_cast<AbstractCardiacCell*>(pCell);
+    if (p_cell == NULL || p_cell->GetNumberOfStateVariables() == 0)
+    {
+        // Not an ODE-based cell (e.g. CVODE cells), or a FakeBathCell
+        return false;
+    }
+
+    // Cells evaluated one at a time would be no faster in a block
+    if (!p_cell->HasBatchKernels())
+    {
+        return false;
+    }
+
+    // Cells which provide their own solve (Rush-Larsen, backward Euler) have no ODE solver
+    AbstractIvpOdeSolver* p_solver = p_cell->GetSolver().get();
+    return (p_solver != NULL && typeid(*p_solver) == typeid(EulerIvpOdeSolver));
+}
+
+bool CardiacCellBatch::IsCompatible(AbstractCardiacCell* pCell) const
+{
+    return (typeid(*pCell) == typeid(*mCells[0])
+            && pCell->GetNumberOfStateVariables() == mNumberOfStateVariables
+            && pCell->GetTimestep() == mDt);
+}
+
+bool CardiacCellBatch::AreCellsCompatible() const
+{
+    for (unsigned cell=0; cell<mCells.size(); cell++)
+    {
+        if (!CanBatch(mCells[cell]) || !IsCompatible(mCells[cell]))
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+void CardiacCellBatch::AddCell(AbstractCardiacCell* pCell)
+{
+    assert(CanBatch(pCell));
+    assert(IsCompatible(pCell));
+    assert(!mStateIsResident);
+    mCells.push_back(pCell);
+}
+
+unsigned CardiacCellBatch::GetNumCells() const
+{
+    return mCells.size();
+}
+
+const std::vector<AbstractCardiacCell*>& CardiacCellBatch::rGetCells() const
+{
+    return mCells;
+}
+
+bool CardiacCellBatch::IsStateResident() const
+{
+    return mStateIsResident;
+}
+
+void CardiacCellBatch::GatherStateVariables()
+{
+    assert(!mStateIsResident);
+    const unsigned num_cells = mCells.size();
+    mStateVariables.resize(mNumberOfStateVariables*num_cells);
+    mDerivatives.resize(mNumberOfStateVariables*num_cells);
+    mIIonic.resize(num_cells);
+
+    for (unsigned cell=0; cell<num_cells; cell++)
+    {
+        const std::vector<double>& r_state = mCells[cell]->rGetStateVariables();
+        for (unsigned i=0; i<mNumberOfStateVariables; i++)
+        {
+            mStateVariables[i*num_cells + cell] = r_state[i];
+        }
+        // The batch never updates the voltage, so the kernels needn't compute its derivative
+        mCells[cell]->SetVoltageDerivativeToZero(true);
+    }
+    mStateIsResident = true;
+}
+
+void CardiacCellBatch::ScatterStateVariables()
+{
+    if (!mStateIsResident)
+    {
+        return;
+    }
+    const unsigned num_cells = mCells.size();
+    for (unsigned cell=0; cell<num_cells; cell++)
+    {
+        // The cells' own voltages are always current
+        std::vector<double>& r_state = mCells[cell]->rGetStateVariables();
+        for (unsigned i=0; i<mNumberOfStateVariables; i++)
+        {
+            if (i != mVoltageIndex)
+            {
+                r_state[i] = mStateVariables[i*num_cells + cell];
+            }
+        }
+        mCells[cell]->SetVoltageDerivativeToZero(false);
+#ifndef NDEBUG
+        mCells[cell]->VerifyStateVariables();
+#endif // NDEBUG
+    }
+    mStateIsResident = false;
+}
+
+std::vector<double> CardiacCellBatch::GetStateVariables(unsigned index) const
+{
+    assert(index < mCells.size());
+    if (!mStateIsResident)
+    {
+        return mCells[index]->GetStdVecStateVariables();
+    }
+    const unsigned num_cells = mCells.size();
+    std::vector<double> state(mNumberOfStateVariables);
+    for (unsigned i=0; i<mNumberOfStateVariables; i++)
+    {
+        state[i] = mStateVariables[i*num_cells + index];
+    }
+    return state;
+}
+
+double CardiacCellBatch::GetIIonic(unsigned index) const
+{
+    assert(index < mIIonic.size());
+    return mIIonic[index];
+}
+
+void CardiacCellBatch::ComputeExceptVoltage(double tStart, double tEnd)
+{
+    const unsigned num_cells = mCells.size();
+
+    if (!mStateIsResident)
+    {
+        GatherStateVariables();
+    }
+
+    // Only the voltages have changed since the last solve
+    double* p_voltages = &mStateVariables[mVoltageIndex*num_cells];
+    for (unsigned cell=0; cell<num_cells; cell++)
+    {
+        p_voltages[cell] = mCells[cell]->GetVoltage();
+    }
+
+    // Forward Euler over the whole block, using the same time steps as AbstractOneStepIvpOdeSolver.
+    // The voltages are held fixed, so their rows are skipped.
+    const unsigned voltage_begin = mVoltageIndex*num_cells;
+    const unsigned voltage_end = voltage_begin + num_cells;
+    const unsigned num_entries = mNumberOfStateVariables*num_cells;
+    TimeStepper stepper(tStart, tEnd, mDt);
+    while (!stepper.IsTimeAtEnd())
+    {
+        mCells[0]->EvaluateYDerivativesBatch(stepper.GetTime(), mCells, &mStateVariables[0], &mDerivatives[0]);
+
+        const double dt = stepper.GetNextTimeStep();
+        double* p_state = &mStateVariables[0];
+        const double* p_derivs = &mDerivatives[0];
+        for (unsigned i=0; i<voltage_begin; i++)
+        {
+            p_state[i] += dt*p_derivs[i];
+        }
+        for (unsigned i=voltage_end; i<num_entries; i++)
+        {
+            p_state[i] += dt*p_derivs[i];
+        }
+        stepper.AdvanceOneTimeStep();
+    }
+
+    mCells[0]->GetIIonicBatch(mCells, &mStateVariables[0], &mIIonic[0]);
+}
@@ -0,0 +1,186 @@
+/*
+
+Copyright (c) 2005-2017, University of Oxford.
+All rights reserved.
+
+University of Oxford means the Chancellor, Masters and Scholars of the
+University of Oxford, having an administrative office at Wellington
+Square, Oxford OX1 2JD, UK.
+
+This file is part of Chaste.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+ * Redistributions of source code must retain the above copyright notice,
+   this list of conditions and the following disclaimer.
+ * Redistributions in binary form must reproduce the above copyright notice,
+   this list of conditions and the following disclaimer in the documentation
+   and/or other materials provided with the distribution.
+ * Neither the name of the University of Oxford nor the names of its
+   contributors may be used to endorse or promote products derived from this
+   software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+*/
+#ifndef CARDIACCELLBATCH_HPP_
+#define CARDIACCELLBATCH_HPP_
+
+#include <vector>
+
+#include "AbstractCardiacCellInterface.hpp"
+#include "AbstractCardiacCell.hpp"
+
+/**
+ * A block of cardiac cells of the same concrete model type, all solved with
+ * forward Euler and the same ODE timestep, that are advanced together.
+ *
+ * The state variables of the block are held in structure-of-arrays layout, one
+ * contiguous array per state variable, and each Euler step updates the whole block
+ * in a single sweep.  The derivatives and ionic currents are obtained from
+ * AbstractCardiacCell::EvaluateYDerivativesBatch and AbstractCardiacCell::GetIIonicBatch,
+ * so only cell models which provide kernels working on the whole block (see
+ * AbstractCardiacCell::HasBatchKernels) can be batched.
+ *
+ * The state is gathered from the cells by the first solve and then stays resident in
+ * the block from one solve to the next: only the voltages, which are set on the cells
+ * by the tissue, are copied in at each solve.  While the state is resident the cell
+ * objects hold out-of-date values for everything except the voltage, so callers that
+ * want to look at the cells (GetAnyVariable, checkpointing, and the rest of the
+ * AbstractCardiacCellInterface) must first call ScatterStateVariables, which hands the
+ * state back to the cells.  The next solve then gathers it again.
+ *
+ * This class does not take ownership of the cells.
+ */
+class CardiacCellBatch
+{
+private:
+
+    /** The cells in this block. */
+    std::vector<AbstractCardiacCell*> mCells;
+
+    /** Number of state variables of each cell in the block. */
+    unsigned mNumberOfStateVariables;
+
+    /** Index of the voltage among the state variables of each cell. */
+    unsigned mVoltageIndex;
+
+    /** The ODE timestep shared by all the cells in the block. */
+    double mDt;
+
+    /**
+     * Whether #mStateVariables holds the current state of the cells, rather than the
+     * cells themselves.
+     */
+    bool mStateIsResident;
+
+    /**
+     * State variables of the block, variable-major: entry i*mCells.size()+c
+     * is variable i of cell c.
+     */
+    std::vector<double> mStateVariables;
+
+    /** Derivatives of the block, in the same layout as #mStateVariables. */
+    std::vector<double> mDerivatives;
+
+    /** The ionic current of each cell at the end of the last solve. */
+    std::vector<double> mIIonic;
+
+    /** Copy the state variables of each cell into #mStateVariables. */
+    void GatherStateVariables();
+
+public:
+
+    /**
+     * Constructor.
+     *
+     * @param pFirstCell  the first cell of the block, which determines its model type and timestep
+     */
+    CardiacCellBatch(AbstractCardiacCell* pFirstCell);
+
+    /**
+     * @return whether the given cell can be solved as part of a batch, i.e. whether it
+     * is an AbstractCardiacCell with state variables and batch kernels that uses an
+     * EulerIvpOdeSolver.
+     *
+     * @param pCell  the cell to test
+     */
+    static bool CanBatch(AbstractCardiacCellInterface* pCell);
+
+    /**
+     * @return whether the given cell is of the same model type, and uses the same
+     * timestep, as the cells already in this block.
+     *
+     * @param pCell  the cell to test
+     */
+    bool IsCompatible(AbstractCardiacCell* pCell) const;
+
+    /**
+     * @return whether every cell in the block can still be solved as part of it.  This
+     * is false if, while the cells held their own state, one of them was given a different
+     * timestep or ODE solver.
+     */
+    bool AreCellsCompatible() const;
+
+    /**
+     * Add a cell to the block.  Must be called before the first solve.
+     *
+     * @param pCell  the cell, which must be compatible with this block
+     */
+    void AddCell(AbstractCardiacCell* pCell);
+
+    /** @return the number of cells in the block. */
+    unsigned GetNumCells() const;
+
+    /** @return the cells in the block. */
+    const std::vector<AbstractCardiacCell*>& rGetCells() const;
+
+    /** @return whether the block, rather than the cells, currently holds the cells' state. */
+    bool IsStateResident() const;
+
+    /**
+     * Copy the state held by the block back into the cells, which hold it again until
+     * the next call of ComputeExceptVoltage.  Does nothing if the state is not resident.
+     */
+    void ScatterStateVariables();
+
+    /**
+     * @return the state variables of one cell in the block, wherever they are currently held.
+     *
+     * @param index  the position of the cell in the block
+     */
+    std::vector<double> GetStateVariables(unsigned index) const;
+
+    /**
+     * @return the ionic current of one cell in the block at the end of the last call of
+     * ComputeExceptVoltage.
+     *
+     * @param index  the position of the cell in the block
+     */
+    double GetIIonic(unsigned index) const;
+
+    /**
+     * Simulate all the cells in the block over the time interval [tStart, tEnd],
+     * without updating their voltages, and compute their ionic currents at tEnd.
+     * The result is the same as calling AbstractCardiacCell::ComputeExceptVoltage and
+     * then AbstractCardiacCell::GetIIonic on each cell in turn, except that the new
+     * state stays in the block (see ScatterStateVariables).
+     *
+     * The voltage of each cell must already have been set for this time step.
+     *
+     * @param tStart  beginning of the time interval to simulate
+     * @param tEnd  end of the time interval to simulate
+     */
+    void ComputeExceptVoltage(double tStart, double tEnd);
+};
+
+#endif /*CARDIACCELLBATCH_HPP_*/
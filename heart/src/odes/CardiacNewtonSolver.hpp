@@ -41,6 +41,11 @@ OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "AbstractBackwardEulerCardiacCell.hpp"
 #include "Warnings.hpp"
 
+#ifdef CHASTE_OPENMP
+#include <algorithm>
+#include <omp.h>
+#endif // CHASTE_OPENMP
+
 /**
  * Specialised Newton solver for solving the nonlinear systems arising when
  * simulating a cardiac cell using Backward Euler.
@@ -60,12 +65,22 @@ public:
     /**
      * Call this method to obtain a solver instance.
      *
+     * If Chaste is built with OpenMP support there is one instance per thread, since cells
+     * may be solved concurrently (see HeartConfig::SetNumberOfCellSolveThreads).
+     *
      * @return a single instance of the class
      */
     static CardiacNewtonSolver<SIZE, CELLTYPE>* Instance()
     {
+#ifdef CHASTE_OPENMP
+        // The constructors are protected, so the instances can't live in a std::vector
+        static CardiacNewtonSolver<SIZE, CELLTYPE>* p_instances
+            = new CardiacNewtonSolver<SIZE, CELLTYPE>[std::max(omp_get_max_threads(), omp_get_num_procs())];
+        return &p_instances[omp_get_thread_num()];
+#else
         static CardiacNewtonSolver<SIZE, CELLTYPE> inst;
         return &inst;
+#endif // CHASTE_OPENMP
     }
 
     /**
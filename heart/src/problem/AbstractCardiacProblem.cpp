@@ -663,7 +663,8 @@ void AbstractCardiacProblem<ELEMENT_DIM,SPACE_DIM,PROBLEM_DIM>::CloseFilesAndPos
                     HeartConfig::Instance()->GetOutputFilenamePrefix(),
                     mpMesh,
                     false,
-                    HeartConfig::Instance()->GetOutputUsingOriginalNodeOrdering());
+                    HeartConfig::Instance()->GetOutputUsingOriginalNodeOrdering(),
+                    HeartConfig::Instance()->GetVisualizeVtkOneFilePerTimeStep());
             std::string subdirectory_name = converter.GetSubdirectory();
             HeartConfig::Instance()->Write(false, subdirectory_name);
         }
@@ -675,7 +676,8 @@ void AbstractCardiacProblem<ELEMENT_DIM,SPACE_DIM,PROBLEM_DIM>::CloseFilesAndPos
                     HeartConfig::Instance()->GetOutputFilenamePrefix(),
                     mpMesh,
                     true,
-                    HeartConfig::Instance()->GetOutputUsingOriginalNodeOrdering());
+                    HeartConfig::Instance()->GetOutputUsingOriginalNodeOrdering(),
+                    HeartConfig::Instance()->GetVisualizeVtkOneFilePerTimeStep());
             std::string subdirectory_name = converter.GetSubdirectory();
             HeartConfig::Instance()->Write(false, subdirectory_name);
         }
@@ -858,6 +860,14 @@ bool AbstractCardiacProblem<ELEMENT_DIM,SPACE_DIM,PROBLEM_DIM>::InitialiseWriter
         mpWriter->SetAlignment(mHdf5DataWriterChunkSizeAndAlignment);
     }
 
+    // Storage options also only apply to new datasets (an extended dataset keeps its own)
+    if (!extend_file)
+    {
+        mpWriter->SetStoreAsFloat(HeartConfig::Instance()->GetHdf5OutputSinglePrecision());
+        mpWriter->SetCompressionLevel(HeartConfig::Instance()->GetHdf5OutputCompressionLevel());
+        mpWriter->SetQuantisationTolerance(HeartConfig::Instance()->GetHdf5OutputQuantisationTolerance());
+    }
+
     // Define columns, or get the variable IDs from the writer
     DefineWriterColumns(extend_file);
 
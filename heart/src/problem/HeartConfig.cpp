@@ -2922,6 +2922,152 @@ unsigned HeartConfig::GetEvaluateNumItsEveryNSolves()
     return mEvaluateNumItsEveryNSolves;
 }
 
+void HeartConfig::SetUseBatchedCellSolves(bool useBatchedCellSolves)
+{
+    mPerformanceOptions.UseBatchedCellSolves = useBatchedCellSolves;
+}
+
+bool HeartConfig::GetUseBatchedCellSolves()
+{
+    return mPerformanceOptions.UseBatchedCellSolves;
+}
+
+void HeartConfig::SetNumberOfCellSolveThreads(unsigned numThreads)
+{
+    if (numThreads == 0u)
+    {
+        EXCEPTION("The number of cell solve threads must be at least 1.");
+    }
+    mPerformanceOptions.NumberOfCellSolveThreads = numThreads;
+}
+
+unsigned HeartConfig::GetNumberOfCellSolveThreads()
+{
+    return mPerformanceOptions.NumberOfCellSolveThreads;
+}
+
+void HeartConfig::SetUseAdaptiveCellSolves(bool useAdaptiveCellSolves)
+{
+    mPerformanceOptions.UseAdaptiveCellSolves = useAdaptiveCellSolves;
+}
+
+void HeartConfig::SetAdaptiveCellSolveParameters(double voltageRateThreshold, double stateRateThreshold, double maxQuiescentInterval)
+{
+    if (voltageRateThreshold < 0.0 || stateRateThreshold < 0.0)
+    {
+        EXCEPTION("Adaptive cell solve thresholds must be non-negative.");
+    }
+    if (maxQuiescentInterval <= 0.0)
+    {
+        EXCEPTION("The maximum quiescent interval for adaptive cell solves must be positive.");
+    }
+    mPerformanceOptions.AdaptiveCellSolveVoltageRateThreshold = voltageRateThreshold;
+    mPerformanceOptions.AdaptiveCellSolveStateRateThreshold = stateRateThreshold;
+    mPerformanceOptions.AdaptiveCellSolveMaxQuiescentInterval = maxQuiescentInterval;
+}
+
+bool HeartConfig::GetUseAdaptiveCellSolves()
+{
+    return mPerformanceOptions.UseAdaptiveCellSolves;
+}
+
+double HeartConfig::GetAdaptiveCellSolveVoltageRateThreshold()
+{
+    return mPerformanceOptions.AdaptiveCellSolveVoltageRateThreshold;
+}
+
+double HeartConfig::GetAdaptiveCellSolveStateRateThreshold()
+{
+    return mPerformanceOptions.AdaptiveCellSolveStateRateThreshold;
+}
+
+double HeartConfig::GetAdaptiveCellSolveMaxQuiescentInterval()
+{
+    return mPerformanceOptions.AdaptiveCellSolveMaxQuiescentInterval;
+}
+
+void HeartConfig::SetHdf5OutputSinglePrecision(bool useSinglePrecision)
+{
+    mPerformanceOptions.Hdf5OutputSinglePrecision = useSinglePrecision;
+}
+
+bool HeartConfig::GetHdf5OutputSinglePrecision()
+{
+    return mPerformanceOptions.Hdf5OutputSinglePrecision;
+}
+
+void HeartConfig::SetHdf5OutputCompressionLevel(unsigned level)
+{
+    if (level > 9u)
+    {
+        EXCEPTION("The HDF5 output compression level must be between 0 and 9.");
+    }
+    mPerformanceOptions.Hdf5OutputCompressionLevel = level;
+}
+
+unsigned HeartConfig::GetHdf5OutputCompressionLevel()
+{
+    return mPerformanceOptions.Hdf5OutputCompressionLevel;
+}
+
+void HeartConfig::SetHdf5OutputQuantisationTolerance(double absTolerance)
+{
+    if (absTolerance < 0.0)
+    {
+        EXCEPTION("The HDF5 output quantisation tolerance must be non-negative.");
+    }
+    mPerformanceOptions.Hdf5OutputQuantisationTolerance = absTolerance;
+}
+
+double HeartConfig::GetHdf5OutputQuantisationTolerance()
+{
+    return mPerformanceOptions.Hdf5OutputQuantisationTolerance;
+}
+
+void HeartConfig::SetVisualizeVtkOneFilePerTimeStep(bool oneFilePerTimeStep)
+{
+    mPerformanceOptions.VisualizeVtkOneFilePerTimeStep = oneFilePerTimeStep;
+}
+
+bool HeartConfig::GetVisualizeVtkOneFilePerTimeStep()
+{
+    return mPerformanceOptions.VisualizeVtkOneFilePerTimeStep;
+}
+
+void HeartConfig::SetUseElementGeometryCache(bool useCache)
+{
+    mPerformanceOptions.UseElementGeometryCache = useCache;
+}
+
+bool HeartConfig::GetUseElementGeometryCache()
+{
+    return mPerformanceOptions.UseElementGeometryCache;
+}
+
+void HeartConfig::SetUseMatrixFreeRhs(bool useMatrixFree)
+{
+    mPerformanceOptions.UseMatrixFreeRhs = useMatrixFree;
+}
+
+bool HeartConfig::GetUseMatrixFreeRhs()
+{
+    return mPerformanceOptions.UseMatrixFreeRhs;
+}
+
+void HeartConfig::SetNumberOfAssemblyThreads(unsigned numThreads)
+{
+    if (numThreads == 0u)
+    {
+        EXCEPTION("The number of assembly threads must be at least 1.");
+    }
+    mPerformanceOptions.NumberOfAssemblyThreads = numThreads;
+}
+
+unsigned HeartConfig::GetNumberOfAssemblyThreads()
+{
+    return mPerformanceOptions.NumberOfAssemblyThreads;
+}
+
 //
 // Purkinje methods
 //
@@ -67,6 +67,72 @@ namespace cp = chaste::parameters::v3_4;
 // Forward declaration to avoid circular includes
 class HeartFileFinder;
 
+/**
+ * Helper structure holding the settings which change how fast a simulation runs, or how
+ * much it writes, rather than what it computes.  These do not appear in the XML, so
+ * HeartConfig archives them together.
+ */
+struct CardiacPerformanceOptions
+{
+    bool UseBatchedCellSolves; /**< Whether to solve cells of the same model type together in batches. */
+    unsigned NumberOfCellSolveThreads; /**< The number of threads used to solve the cell models on each process. */
+    bool UseAdaptiveCellSolves; /**< Whether cells at rest may skip their ODE solves. */
+    double AdaptiveCellSolveVoltageRateThreshold; /**< Rate of change of voltage (mV/ms) below which a cell may be considered quiescent. */
+    double AdaptiveCellSolveStateRateThreshold; /**< Relative rate of change of state variables (1/ms) below which a cell may be considered quiescent. */
+    double AdaptiveCellSolveMaxQuiescentInterval; /**< Longest time (ms) for which a quiescent cell may go without being solved. */
+    bool Hdf5OutputSinglePrecision; /**< Whether HDF5 results are stored as 32-bit floats. */
+    unsigned Hdf5OutputCompressionLevel; /**< Deflate level used to compress HDF5 results (0 for no compression). */
+    double Hdf5OutputQuantisationTolerance; /**< Absolute tolerance to which HDF5 results are rounded (0 for no rounding). */
+    bool VisualizeVtkOneFilePerTimeStep; /**< Whether VTK output is written as one file per time step. */
+    bool UseElementGeometryCache; /**< Whether the cardiac assemblers use the mesh's element geometry cache. */
+    bool UseMatrixFreeRhs; /**< Whether the monodomain and bidomain solvers compute the RHS mass matrix product matrix-free. */
+    unsigned NumberOfAssemblyThreads; /**< The number of threads used to assemble the cardiac matrices on each process. */
+
+    /**
+     * Constructor.  Every option defaults to the behaviour without it.
+     */
+    CardiacPerformanceOptions()
+        : UseBatchedCellSolves(false),
+          NumberOfCellSolveThreads(1u),
+          UseAdaptiveCellSolves(false),
+          AdaptiveCellSolveVoltageRateThreshold(0.01),
+          AdaptiveCellSolveStateRateThreshold(1e-4),
+          AdaptiveCellSolveMaxQuiescentInterval(1.0),
+          Hdf5OutputSinglePrecision(false),
+          Hdf5OutputCompressionLevel(0u),
+          Hdf5OutputQuantisationTolerance(0.0),
+          VisualizeVtkOneFilePerTimeStep(false),
+          UseElementGeometryCache(false),
+          UseMatrixFreeRhs(false),
+          NumberOfAssemblyThreads(1u)
+    {
+    }
+
+    /**
+     * Archive the options.
+     *
+     * @param archive the archive
+     * @param version the current version of this class
+     */
+    template<class Archive>
+    void serialize(Archive & archive, const unsigned int version)
+    {
+        archive & UseBatchedCellSolves;
+        archive & NumberOfCellSolveThreads;
+        archive & UseAdaptiveCellSolves;
+        archive & AdaptiveCellSolveVoltageRateThreshold;
+        archive & AdaptiveCellSolveStateRateThreshold;
+        archive & AdaptiveCellSolveMaxQuiescentInterval;
+        archive & Hdf5OutputSinglePrecision;
+        archive & Hdf5OutputCompressionLevel;
+        archive & Hdf5OutputQuantisationTolerance;
+        archive & VisualizeVtkOneFilePerTimeStep;
+        archive & UseElementGeometryCache;
+        archive & UseMatrixFreeRhs;
+        archive & NumberOfAssemblyThreads;
+    }
+};
+
 
 /**
  * A singleton class containing configuration parameters for heart simulations.
@@ -125,6 +191,10 @@ private:
             archive & mUseFixedNumberIterations;
             archive & mEvaluateNumItsEveryNSolves;
         }
+        if (version > 2)
+        {
+            archive & mPerformanceOptions;
+        }
 
         PetscTools::Barrier("HeartConfig::save");
     }
@@ -159,6 +229,10 @@ private:
             archive & mUseFixedNumberIterations;
             archive & mEvaluateNumItsEveryNSolves;
         }
+        if (version > 2)
+        {
+            archive & mPerformanceOptions;
+        }
     }
     BOOST_SERIALIZATION_SPLIT_MEMBER()
 
@@ -759,6 +833,73 @@ public:
      */
     unsigned GetEvaluateNumItsEveryNSolves();
 
+    /**
+     * @return whether cells of the same model type should be grouped into batches
+     * (see CardiacCellBatch) and solved together.
+     */
+    bool GetUseBatchedCellSolves();
+
+    /**
+     * @return the number of threads used to solve the cell models on each process.
+     */
+    unsigned GetNumberOfCellSolveThreads();
+
+    /**
+     * @return whether cells at rest may skip their ODE solves (see SetUseAdaptiveCellSolves).
+     */
+    bool GetUseAdaptiveCellSolves();
+
+    /**
+     * @return the rate of change of voltage (mV/ms) below which a cell may be considered quiescent.
+     */
+    double GetAdaptiveCellSolveVoltageRateThreshold();
+
+    /**
+     * @return the relative rate of change of state variables (1/ms) below which a cell may be considered quiescent.
+     */
+    double GetAdaptiveCellSolveStateRateThreshold();
+
+    /**
+     * @return the longest time (ms) for which a quiescent cell may go without being solved.
+     */
+    double GetAdaptiveCellSolveMaxQuiescentInterval();
+
+    /**
+     * @return whether HDF5 results are stored as 32-bit floats rather than doubles.
+     */
+    bool GetHdf5OutputSinglePrecision();
+
+    /**
+     * @return the deflate level used to compress HDF5 results (0 if they are not compressed).
+     */
+    unsigned GetHdf5OutputCompressionLevel();
+
+    /**
+     * @return the absolute tolerance to which HDF5 results are rounded (0 if they are not rounded).
+     */
+    double GetHdf5OutputQuantisationTolerance();
+
+    /**
+     * @return whether VTK output is written as one file per time step (see SetVisualizeVtkOneFilePerTimeStep).
+     */
+    bool GetVisualizeVtkOneFilePerTimeStep();
+
+    /**
+     * @return whether the cardiac assemblers use the mesh's element geometry cache (see SetUseElementGeometryCache).
+     */
+    bool GetUseElementGeometryCache();
+
+    /**
+     * @return whether the monodomain and bidomain solvers compute the RHS mass matrix product matrix-free (see SetUseMatrixFreeRhs).
+     */
+    bool GetUseMatrixFreeRhs();
+
+    /**
+     * @return the number of threads used to assemble the cardiac matrices on each process
+     * (see SetNumberOfAssemblyThreads).
+     */
+    unsigned GetNumberOfAssemblyThreads();
+
 
     ///////////////////////////////////////////////////////////////
     //
@@ -1189,6 +1330,114 @@ public:
      */
     void SetUseFixedNumberIterationsLinearSolver(bool useFixedNumberIterations = true, unsigned evaluateNumItsEveryNSolves=UINT_MAX);
 
+    /**
+     * Set whether the tissue should group cells of the same model type into batches
+     * that are solved together (see CardiacCellBatch).  Only cells solved with forward
+     * Euler whose models provide batch kernels (generated by PyCml with --batched) are
+     * batched; all other cells are solved individually as usual.
+     *
+     * @param useBatchedCellSolves Whether to use batched cell solves (defaults to true)
+     */
+    void SetUseBatchedCellSolves(bool useBatchedCellSolves = true);
+
+    /**
+     * Set the number of threads used to solve the cell models on each process.  Each thread
+     * solves a contiguous chunk of the local cells.  Threads are only used if Chaste is built
+     * with OpenMP (Chaste_USE_OPENMP).
+     *
+     * @param numThreads  the number of threads (defaults to 1)
+     */
+    void SetNumberOfCellSolveThreads(unsigned numThreads);
+
+    /**
+     * Set whether cells at rest may skip their ODE solves.  After each solve a cell is
+     * classified as quiescent if it is not stimulated, its voltage is changing slowly (both
+     * according to its ionic current and the PDE solution) and its other state variables are
+     * changing slowly relative to their size.  A quiescent cell's state is then held fixed,
+     * and its solves skipped, until it is stimulated, the PDE voltage moves away from the value
+     * it was last solved at, or the maximum quiescent interval passes, whereupon it is solved
+     * again and re-classified.  See SetAdaptiveCellSolveParameters for the thresholds.
+     *
+     * Only applies when the voltage is updated by the PDE (i.e. not with operator splitting),
+     * and cells solved in batches (see SetUseBatchedCellSolves) are always solved.
+     *
+     * @param useAdaptiveCellSolves  whether to use adaptive cell solves (defaults to true)
+     */
+    void SetUseAdaptiveCellSolves(bool useAdaptiveCellSolves = true);
+
+    /**
+     * Set the thresholds used to classify cells as quiescent (see SetUseAdaptiveCellSolves).
+     *
+     * @param voltageRateThreshold  the rate of change of voltage below which a cell may be quiescent (mV/ms)
+     * @param stateRateThreshold  the relative rate of change of the other state variables below which a cell may be quiescent (1/ms)
+     * @param maxQuiescentInterval  the longest time a quiescent cell may go without being solved (ms)
+     */
+    void SetAdaptiveCellSolveParameters(double voltageRateThreshold, double stateRateThreshold, double maxQuiescentInterval);
+
+    /**
+     * Set whether to store HDF5 results as 32-bit floats rather than doubles
+     * (see Hdf5DataWriter::SetStoreAsFloat).  Only applies to new results files.
+     *
+     * @param useSinglePrecision  whether to store floats (defaults to true)
+     */
+    void SetHdf5OutputSinglePrecision(bool useSinglePrecision=true);
+
+    /**
+     * Set the deflate level used to compress HDF5 results (see Hdf5DataWriter::SetCompressionLevel).
+     * Only applies to new results files.
+     *
+     * @param level  the deflate level, from 1 (fastest) to 9 (smallest), or 0 for no compression (the default)
+     */
+    void SetHdf5OutputCompressionLevel(unsigned level);
+
+    /**
+     * Set the absolute tolerance to which HDF5 results are rounded before writing, which
+     * makes them compress much better (see Hdf5DataWriter::SetQuantisationTolerance).
+     * Only applies to new results files.
+     *
+     * @param absTolerance  the tolerance, in the units of each output variable (0 for no rounding, the default)
+     */
+    void SetHdf5OutputQuantisationTolerance(double absTolerance);
+
+    /**
+     * Set whether the conversion to VTK (see SetVisualizeWithVtk and SetVisualizeWithParallelVtk)
+     * writes a separate file for each time step, listed in a .pvd collection file, rather than
+     * one file holding every time step.  This keeps the memory needed for conversion to that of
+     * a single time step.
+     *
+     * @param oneFilePerTimeStep  whether to write one file per time step (defaults to true)
+     */
+    void SetVisualizeVtkOneFilePerTimeStep(bool oneFilePerTimeStep=true);
+
+    /**
+     * Set whether the monodomain and bidomain assemblers take the Jacobian determinants and basis
+     * function gradients of each element from the mesh's element geometry cache, which is computed
+     * once, rather than recomputing them every time the system is assembled.  This trades memory
+     * (see AbstractTetrahedralMesh::GetElementGeometryCacheMemoryUsage) for assembly time.
+     *
+     * @param useCache  whether to use the cache (defaults to true)
+     */
+    void SetUseElementGeometryCache(bool useCache=true);
+
+    /**
+     * Set whether MonodomainSolver and BidomainSolver compute the mass matrix product on the
+     * right-hand side element by element (see MatrixFreeMassMatrixOperator), instead of assembling
+     * and storing a mass matrix and multiplying by it each time step.
+     *
+     * @param useMatrixFree  whether to use matrix-free RHS evaluation (defaults to true)
+     */
+    void SetUseMatrixFreeRhs(bool useMatrixFree=true);
+
+    /**
+     * Set the number of threads used on each process to compute element contributions when
+     * assembling the cardiac matrices.  Contributions are added to the matrices in element
+     * order, so results do not depend on the number of threads.  Threads are only used if
+     * Chaste is built with OpenMP (Chaste_USE_OPENMP).
+     *
+     * @param numThreads  the number of threads (defaults to 1)
+     */
+    void SetNumberOfAssemblyThreads(unsigned numThreads);
+
     /**
      * @return whether HeartConfig has a drug concentration and any IC50s set up
      */
@@ -1364,6 +1613,9 @@ private:
      */
     unsigned mEvaluateNumItsEveryNSolves;
 
+    /** Settings which only affect performance (see CardiacPerformanceOptions). */
+    CardiacPerformanceOptions mPerformanceOptions;
+
     /**
      * CheckSimulationIsDefined is a convenience method for checking if the "<"Simulation">" element
      * has been defined and therefore is safe to use the Simulation().get() pointer to access
@@ -1388,7 +1640,7 @@ private:
 };
 
 
-BOOST_CLASS_VERSION(HeartConfig, 2)
+BOOST_CLASS_VERSION(HeartConfig, 3)
 #include "SerializationExportWrapper.hpp"
 // Declare identifier for the serializer
 CHASTE_CLASS_EXPORT(HeartConfig)
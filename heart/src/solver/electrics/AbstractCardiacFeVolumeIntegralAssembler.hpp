@@ -55,6 +55,16 @@ protected:
     /** Local cache of the configuration singleton pointer*/
     HeartConfig* mpConfig;
 
+    /**
+     * @return true unless the tissue has a conductivity modifier, whose modified tensors
+     * are generally held in shared storage.  Subclasses with other state that changes
+     * during assembly must override this to return false.
+     */
+    virtual bool CanAssembleElementsConcurrently()
+    {
+        return !(mpCardiacTissue->HasConductivityModifier());
+    }
+
 public:
 
     /**
@@ -69,6 +79,8 @@ public:
           mpConfig(HeartConfig::Instance())
     {
         assert(pTissue);
+        this->SetUseElementGeometryCache(mpConfig->GetUseElementGeometryCache());
+        this->SetNumberOfAssemblyThreads(mpConfig->GetNumberOfAssemblyThreads());
     }
 };
 
@@ -86,6 +86,15 @@ protected:
      */
     bool ElementAssemblyCriterion(Element<ELEM_DIM,SPACE_DIM>& rElement);
 
+    /**
+     * @return false, since the interpolated quantities above are shared between elements,
+     * so correction terms are always assembled one element at a time.
+     */
+    bool CanAssembleElementsConcurrently()
+    {
+        return false;
+    }
+
 public:
 
     /**
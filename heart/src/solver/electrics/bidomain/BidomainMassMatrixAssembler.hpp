@@ -90,6 +90,15 @@ protected:
             c_matrix<double,2,DIM> &rGradU /* not used */,
             Element<DIM,DIM>* pElement);
 
+    /**
+     * @return true, since ComputeMatrixTerm() uses no member variables, so elements
+     * may be assembled concurrently.
+     */
+    bool CanAssembleElementsConcurrently()
+    {
+        return true;
+    }
+
 public:
 
     /**
@@ -0,0 +1,72 @@
+
+/*
+
+Copyright (c) 2005-2017, University of Oxford.
+All rights reserved.
+
+University of Oxford means the Chancellor, Masters and Scholars of the
+University of Oxford, having an administrative office at Wellington
+Square, Oxford OX1 2JD, UK.
+
+This file is part of Chaste.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+ * Redistributions of source code must retain the above copyright notice,
+   this list of conditions and the following disclaimer.
+ * Redistributions in binary form must reproduce the above copyright notice,
+   this list of conditions and the following disclaimer in the documentation
+   and/or other materials provided with the distribution.
+ * Neither the name of the University of Oxford nor the names of its
+   contributors may be used to endorse or promote products derived from this
+   software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+*/
+
+#ifndef BIDOMAINMATRIXFREEMASSMATRIXOPERATOR_HPP_
+#define BIDOMAINMATRIXFREEMASSMATRIXOPERATOR_HPP_
+
+#include "MatrixFreeMassMatrixOperator.hpp"
+
+/**
+ * Matrix-free version of BidomainMassMatrixAssembler: computes the product of the
+ * bidomain mass matrix with a vector.  The mass matrix acts on the transmembrane
+ * potential only, and bath elements contribute nothing.
+ */
+template<unsigned DIM>
+class BidomainMatrixFreeMassMatrixOperator : public MatrixFreeMassMatrixOperator<DIM,DIM,2>
+{
+protected:
+
+    /**
+     * @return false for bath elements, which have no mass matrix contribution
+     *
+     * @param rElement the element
+     */
+    bool ElementAssemblyCriterion(Element<DIM,DIM>& rElement);
+
+public:
+
+    /**
+     * Constructor
+     *
+     * @param pMesh pointer to the mesh
+     */
+    BidomainMatrixFreeMassMatrixOperator(AbstractTetrahedralMesh<DIM,DIM>* pMesh)
+        : MatrixFreeMassMatrixOperator<DIM,DIM,2>(pMesh, false, 1.0, 0)
+    {
+    }
+};
+
+#endif /*BIDOMAINMATRIXFREEMASSMATRIXOPERATOR_HPP_*/
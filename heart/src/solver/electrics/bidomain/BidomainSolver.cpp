@@ -52,13 +52,19 @@ void BidomainSolver<ELEMENT_DIM,SPACE_DIM>::InitialiseForSolve(Vec initialSoluti
     // system rhs as a template
     Vec& r_template = this->mpLinearSystem->rGetRhsVector();
     VecDuplicate(r_template, &mVecForConstructingRhs);
+    if (HeartConfig::Instance()->GetUseMatrixFreeRhs())
+    {
+        assert(SPACE_DIM==ELEMENT_DIM);
+        mpMatrixFreeMassOperator = new BidomainMatrixFreeMassMatrixOperator<SPACE_DIM>(this->mpMesh);
+        return;
+    }
     PetscInt ownership_range_lo;
     PetscInt ownership_range_hi;
     VecGetOwnershipRange(r_template, &ownership_range_lo, &ownership_range_hi);
     PetscInt local_size = ownership_range_hi - ownership_range_lo;
+    // The mass matrix is preallocated with the sparsity pattern of the linear system
     PetscTools::SetupMat(mMassMatrix, 2*this->mpMesh->GetNumNodes(), 2*this->mpMesh->GetNumNodes(),
-                         2*this->mpMesh->CalculateMaximumNodeConnectivityPerProcess(),
-                         local_size, local_size);
+                         this->mDiagonalNonZeros, this->mOffDiagonalNonZeros, local_size);
 }
 
 template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
@@ -79,15 +85,25 @@ void BidomainSolver<ELEMENT_DIM,SPACE_DIM>::SetupLinearSystem(
         mpBidomainAssembler->SetMatrixToAssemble(this->mpLinearSystem->rGetLhsMatrix());
         mpBidomainAssembler->AssembleMatrix();
 
-        // the BidomainMassMatrixAssembler deals with the mass matrix
-        // for both bath and nonbath problems
-        assert(SPACE_DIM==ELEMENT_DIM);
-        BidomainMassMatrixAssembler<SPACE_DIM> mass_matrix_assembler(this->mpMesh);
-        mass_matrix_assembler.SetMatrixToAssemble(mMassMatrix);
-        mass_matrix_assembler.Assemble();
-
-        this->mpLinearSystem->SwitchWriteModeLhsMatrix();
-        PetscMatTools::Finalise(mMassMatrix);
+        if (mpMatrixFreeMassOperator)
+        {
+            // Refresh the element data, as the assembled mass matrix would be
+            mpMatrixFreeMassOperator->SetUp();
+            this->mpLinearSystem->SwitchWriteModeLhsMatrix();
+        }
+        else
+        {
+            // the BidomainMassMatrixAssembler deals with the mass matrix
+            // for both bath and nonbath problems
+            assert(SPACE_DIM==ELEMENT_DIM);
+            BidomainMassMatrixAssembler<SPACE_DIM> mass_matrix_assembler(this->mpMesh);
+            mass_matrix_assembler.SetNumberOfAssemblyThreads(HeartConfig::Instance()->GetNumberOfAssemblyThreads());
+            mass_matrix_assembler.SetMatrixToAssemble(mMassMatrix);
+            mass_matrix_assembler.Assemble();
+
+            this->mpLinearSystem->SwitchWriteModeLhsMatrix();
+            PetscMatTools::Finalise(mMassMatrix);
+        }
     }
 
 
@@ -154,7 +170,14 @@ void BidomainSolver<ELEMENT_DIM,SPACE_DIM>::SetupLinearSystem(
     //////////////////////////////////////////
     // b = Mz
     //////////////////////////////////////////
-    MatMult(mMassMatrix, mVecForConstructingRhs, this->mpLinearSystem->rGetRhsVector());
+    if (mpMatrixFreeMassOperator)
+    {
+        mpMatrixFreeMassOperator->Apply(mVecForConstructingRhs, this->mpLinearSystem->rGetRhsVector());
+    }
+    else
+    {
+        MatMult(mMassMatrix, mVecForConstructingRhs, this->mpLinearSystem->rGetRhsVector());
+    }
 
     // assembling RHS is not finished yet, as Neumann bcs are added below, but
     // the event will be begun again inside mpBidomainAssembler->AssembleVector();
@@ -202,7 +225,8 @@ BidomainSolver<ELEMENT_DIM,SPACE_DIM>::BidomainSolver(
         AbstractTetrahedralMesh<ELEMENT_DIM,SPACE_DIM>* pMesh,
         BidomainTissue<SPACE_DIM>* pTissue,
         BoundaryConditionsContainer<ELEMENT_DIM,SPACE_DIM,2>* pBoundaryConditions)
-    : AbstractBidomainSolver<ELEMENT_DIM,SPACE_DIM>(bathSimulation,pMesh,pTissue,pBoundaryConditions)
+    : AbstractBidomainSolver<ELEMENT_DIM,SPACE_DIM>(bathSimulation,pMesh,pTissue,pBoundaryConditions),
+      mpMatrixFreeMassOperator(NULL)
 {
     // Tell tissue there's no need to replicate ionic caches
     pTissue->SetCacheReplication(false);
@@ -243,7 +267,14 @@ BidomainSolver<ELEMENT_DIM,SPACE_DIM>::~BidomainSolver()
     if (mVecForConstructingRhs)
     {
         PetscTools::Destroy(mVecForConstructingRhs);
-        PetscTools::Destroy(mMassMatrix);
+        if (mpMatrixFreeMassOperator)
+        {
+            delete mpMatrixFreeMassOperator;
+        }
+        else
+        {
+            PetscTools::Destroy(mMassMatrix);
+        }
     }
 
     if (mpBidomainCorrectionTermAssembler)
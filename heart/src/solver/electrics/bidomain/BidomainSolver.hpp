@@ -48,6 +48,7 @@ OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "HeartConfig.hpp"
 #include "BidomainAssembler.hpp"
 #include "BidomainMassMatrixAssembler.hpp"
+#include "BidomainMatrixFreeMassMatrixOperator.hpp"
 #include "BidomainCorrectionTermAssembler.hpp"
 #include "BidomainNeumannSurfaceTermAssembler.hpp"
 
@@ -75,6 +76,8 @@ OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
  *  case the vector [c_correction, 0] is added to the above, and another assembler is
  *  used to create the c_correction.
  *
+ *  If HeartConfig::GetUseMatrixFreeRhs() is set, M is not assembled, and the product with
+ *  it is instead computed element by element by a BidomainMatrixFreeMassMatrixOperator.
  */
 template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
 class BidomainSolver : public AbstractBidomainSolver<ELEMENT_DIM,SPACE_DIM>
@@ -85,6 +88,9 @@ private:
      */
     Mat mMassMatrix;
 
+    /** If using matrix-free RHS evaluation, computes the mass matrix product instead of mMassMatrix */
+    BidomainMatrixFreeMassMatrixOperator<SPACE_DIM>* mpMatrixFreeMassOperator;
+
     /**
      *  The vector multiplied by the mass matrix. Ie, if the linear system to
      *  be solved is Ax=b, this vector is z where b=Mz.
@@ -55,9 +55,9 @@ void ExtendedBidomainSolver<ELEMENT_DIM,SPACE_DIM>::InitialiseForSolve(Vec initi
     PetscInt ownership_range_hi;
     VecGetOwnershipRange(r_template, &ownership_range_lo, &ownership_range_hi);
     PetscInt local_size = ownership_range_hi - ownership_range_lo;
+    // The mass matrix is preallocated with the sparsity pattern of the linear system
     PetscTools::SetupMat(mMassMatrix, 3*this->mpMesh->GetNumNodes(), 3*this->mpMesh->GetNumNodes(),
-                         3*this->mpMesh->CalculateMaximumNodeConnectivityPerProcess(),
-                         local_size, local_size);
+                         this->mDiagonalNonZeros, this->mOffDiagonalNonZeros, local_size);
 }
 
 template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
@@ -193,9 +193,9 @@ void MonodomainPurkinjeSolver<ELEMENT_DIM,SPACE_DIM>::InitialiseForSolve(Vec ini
     PetscInt ownership_range_hi;
     VecGetOwnershipRange(initialSolution, &ownership_range_lo, &ownership_range_hi);
     PetscInt local_size = ownership_range_hi - ownership_range_lo;
+    // The mass matrix is preallocated with the sparsity pattern of the linear system
     PetscTools::SetupMat(mMassMatrix, 2*this->mpMesh->GetNumNodes(), 2*this->mpMesh->GetNumNodes(),
-                         2*this->mpMesh->CalculateMaximumNodeConnectivityPerProcess(),
-                         local_size, local_size);
+                         this->mDiagonalNonZeros, this->mOffDiagonalNonZeros, local_size);
 }
 
 
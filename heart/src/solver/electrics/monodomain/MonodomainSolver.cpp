@@ -53,12 +53,22 @@ void MonodomainSolver<ELEMENT_DIM,SPACE_DIM>::SetupLinearSystem(Vec currentSolut
         mpMonodomainAssembler->SetMatrixToAssemble(this->mpLinearSystem->rGetLhsMatrix());
         mpMonodomainAssembler->AssembleMatrix();
 
-        MassMatrixAssembler<ELEMENT_DIM,SPACE_DIM> mass_matrix_assembler(this->mpMesh, HeartConfig::Instance()->GetUseMassLumping());
-        mass_matrix_assembler.SetMatrixToAssemble(mMassMatrix);
-        mass_matrix_assembler.Assemble();
+        if (mpMatrixFreeMassOperator)
+        {
+            // Refresh the element data, as the assembled mass matrix would be
+            mpMatrixFreeMassOperator->SetUp();
+            this->mpLinearSystem->FinaliseLhsMatrix();
+        }
+        else
+        {
+            MassMatrixAssembler<ELEMENT_DIM,SPACE_DIM> mass_matrix_assembler(this->mpMesh, HeartConfig::Instance()->GetUseMassLumping());
+            mass_matrix_assembler.SetNumberOfAssemblyThreads(HeartConfig::Instance()->GetNumberOfAssemblyThreads());
+            mass_matrix_assembler.SetMatrixToAssemble(mMassMatrix);
+            mass_matrix_assembler.Assemble();
 
-        this->mpLinearSystem->FinaliseLhsMatrix();
-        PetscMatTools::Finalise(mMassMatrix);
+            this->mpLinearSystem->FinaliseLhsMatrix();
+            PetscMatTools::Finalise(mMassMatrix);
+        }
 
         if (HeartConfig::Instance()->GetUseMassLumpingForPrecond() && !HeartConfig::Instance()->GetUseMassLumping())
         {
@@ -104,7 +114,14 @@ void MonodomainSolver<ELEMENT_DIM,SPACE_DIM>::SetupLinearSystem(Vec currentSolut
     //////////////////////////////////////////
     // b = Mz
     //////////////////////////////////////////
-    MatMult(mMassMatrix, mVecForConstructingRhs, this->mpLinearSystem->rGetRhsVector());
+    if (mpMatrixFreeMassOperator)
+    {
+        mpMatrixFreeMassOperator->Apply(mVecForConstructingRhs, this->mpLinearSystem->rGetRhsVector());
+    }
+    else
+    {
+        MatMult(mMassMatrix, mVecForConstructingRhs, this->mpLinearSystem->rGetRhsVector());
+    }
 
     // assembling RHS is not finished yet, as Neumann bcs are added below, but
     // the event will be begun again inside mpMonodomainAssembler->AssembleVector();
@@ -160,13 +177,18 @@ void MonodomainSolver<ELEMENT_DIM,SPACE_DIM>::InitialiseForSolve(Vec initialSolu
     // system rhs as a template
     Vec& r_template = this->mpLinearSystem->rGetRhsVector();
     VecDuplicate(r_template, &mVecForConstructingRhs);
+    if (HeartConfig::Instance()->GetUseMatrixFreeRhs())
+    {
+        mpMatrixFreeMassOperator = new MatrixFreeMassMatrixOperator<ELEMENT_DIM,SPACE_DIM>(this->mpMesh, HeartConfig::Instance()->GetUseMassLumping());
+        return;
+    }
     PetscInt ownership_range_lo;
     PetscInt ownership_range_hi;
     VecGetOwnershipRange(r_template, &ownership_range_lo, &ownership_range_hi);
     PetscInt local_size = ownership_range_hi - ownership_range_lo;
+    // The mass matrix is preallocated with the sparsity pattern of the linear system
     PetscTools::SetupMat(mMassMatrix, this->mpMesh->GetNumNodes(), this->mpMesh->GetNumNodes(),
-                         this->mpMesh->CalculateMaximumNodeConnectivityPerProcess(),
-                         local_size, local_size);
+                         this->mDiagonalNonZeros, this->mOffDiagonalNonZeros, local_size);
 }
 
 template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
@@ -183,7 +205,8 @@ MonodomainSolver<ELEMENT_DIM,SPACE_DIM>::MonodomainSolver(
             BoundaryConditionsContainer<ELEMENT_DIM,SPACE_DIM,1>* pBoundaryConditions)
     : AbstractDynamicLinearPdeSolver<ELEMENT_DIM,SPACE_DIM,1>(pMesh),
       mpMonodomainTissue(pTissue),
-      mpBoundaryConditions(pBoundaryConditions)
+      mpBoundaryConditions(pBoundaryConditions),
+      mpMatrixFreeMassOperator(NULL)
 {
     assert(pTissue);
     assert(pBoundaryConditions);
@@ -219,7 +242,14 @@ MonodomainSolver<ELEMENT_DIM,SPACE_DIM>::~MonodomainSolver()
     if (mVecForConstructingRhs)
     {
         PetscTools::Destroy(mVecForConstructingRhs);
-        PetscTools::Destroy(mMassMatrix);
+        if (mpMatrixFreeMassOperator)
+        {
+            delete mpMatrixFreeMassOperator;
+        }
+        else
+        {
+            PetscTools::Destroy(mMassMatrix);
+        }
     }
 
     if (mpMonodomainCorrectionTermAssembler)
@@ -42,6 +42,7 @@ OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "MonodomainCorrectionTermAssembler.hpp"
 #include "MonodomainTissue.hpp"
 #include "MonodomainAssembler.hpp"
+#include "MatrixFreeMassMatrixOperator.hpp"
 
 /**
  *  A monodomain solver, which uses various assemblers to set up the
@@ -69,6 +70,9 @@ OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
  *  In this case the equation is
  *  ( (chi*C/dt) M  + K ) V^{n+1} = (chi*C/dt) M V^{n} + M F^{n} + c_surf + c_correction
  *  and another assembler is used to create the c_correction.
+ *
+ *  If HeartConfig::GetUseMatrixFreeRhs() is set, the mass matrix on the RHS is not
+ *  assembled, and M z is instead computed element by element by a MatrixFreeMassMatrixOperator.
  */
 template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
 class MonodomainSolver
@@ -94,9 +98,12 @@ private:
      */
     MonodomainCorrectionTermAssembler<ELEMENT_DIM,SPACE_DIM>* mpMonodomainCorrectionTermAssembler;
 
-    /** The mass matrix, used to computing the RHS vector */
+    /** The mass matrix, used to computing the RHS vector (unless mpMatrixFreeMassOperator is set) */
     Mat mMassMatrix;
 
+    /** If using matrix-free RHS evaluation, computes the mass matrix product instead of mMassMatrix */
+    MatrixFreeMassMatrixOperator<ELEMENT_DIM,SPACE_DIM>* mpMatrixFreeMassOperator;
+
     /** The vector multiplied by the mass matrix. Ie, if the linear system to
      *  be solved is Ax=b (excluding surface integrals), this vector is z where b=Mz.
      */
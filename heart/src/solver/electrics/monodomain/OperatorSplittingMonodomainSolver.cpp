@@ -158,9 +158,9 @@ void OperatorSplittingMonodomainSolver<ELEMENT_DIM,SPACE_DIM>::InitialiseForSolv
     PetscInt ownership_range_hi;
     VecGetOwnershipRange(r_template, &ownership_range_lo, &ownership_range_hi);
     PetscInt local_size = ownership_range_hi - ownership_range_lo;
+    // The mass matrix is preallocated with the sparsity pattern of the linear system
     PetscTools::SetupMat(mMassMatrix, this->mpMesh->GetNumNodes(), this->mpMesh->GetNumNodes(),
-                         this->mpMesh->CalculateMaximumNodeConnectivityPerProcess(),
-                         local_size, local_size);
+                         this->mDiagonalNonZeros, this->mOffDiagonalNonZeros, local_size);
 }
 
 template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
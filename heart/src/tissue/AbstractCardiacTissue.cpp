@@ -47,8 +47,16 @@ OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "PetscTools.hpp"
 #include "PetscVecTools.hpp"
 #include "AbstractCvodeCell.hpp"
+#include "EulerIvpOdeSolver.hpp"
 #include "Warnings.hpp"
 
+#include <cfloat>
+#include <cmath>
+#include <typeinfo>
+#ifdef CHASTE_OPENMP
+#include <omp.h>
+#endif // CHASTE_OPENMP
+
 template <unsigned ELEMENT_DIM,unsigned SPACE_DIM>
 AbstractCardiacTissue<ELEMENT_DIM,SPACE_DIM>::AbstractCardiacTissue(
             AbstractCardiacCellFactory<ELEMENT_DIM,SPACE_DIM>* pCellFactory,
@@ -59,7 +67,10 @@ AbstractCardiacTissue<ELEMENT_DIM,SPACE_DIM>::AbstractCardiacTissue(
       mHasPurkinje(false),
       mDoCacheReplication(true),
       mMeshUnarchived(false),
-      mExchangeHalos(exchangeHalos)
+      mExchangeHalos(exchangeHalos),
+      mCellBatchesSetUp(false),
+      mCellChunkStarts(1, 0u),
+      mQuiescentCapacitance(1.0)
 {
     //This constructor is called from the Initialise() method of the CardiacProblem class
     assert(pCellFactory != NULL);
@@ -184,7 +195,10 @@ AbstractCardiacTissue<ELEMENT_DIM,SPACE_DIM>::AbstractCardiacTissue(AbstractTetr
       mHasPurkinje(false),
       mDoCacheReplication(true),
       mMeshUnarchived(true),
-      mExchangeHalos(false)
+      mExchangeHalos(false),
+      mCellBatchesSetUp(false),
+      mCellChunkStarts(1, 0u),
+      mQuiescentCapacitance(1.0)
 {
     mIionicCacheReplicated.Resize(mpDistributedVectorFactory->GetProblemSize());
     mIntracellularStimulusCacheReplicated.Resize(mpDistributedVectorFactory->GetProblemSize());
@@ -386,6 +400,7 @@ AbstractCardiacCellInterface* AbstractCardiacTissue<ELEMENT_DIM,SPACE_DIM>::GetC
 {
     assert(mpDistributedVectorFactory->GetLow() <= globalIndex &&
            globalIndex < mpDistributedVectorFactory->GetHigh());
+    ReleaseCellBatchStates();
     return mCellsDistributed[globalIndex - mpDistributedVectorFactory->GetLow()];
 }
 
@@ -412,6 +427,7 @@ AbstractCardiacCellInterface* AbstractCardiacTissue<ELEMENT_DIM,SPACE_DIM>::GetC
     if (mpDistributedVectorFactory->IsGlobalIndexLocal(globalIndex))
     {
         // Found an owned node
+        ReleaseCellBatchStates();
         return mCellsDistributed[globalIndex - mpDistributedVectorFactory->GetLow()];
     }
     // Not here
@@ -461,84 +477,208 @@ void AbstractCardiacTissue<ELEMENT_DIM,SPACE_DIM>::SetUpHaloCells(AbstractCardia
 
 
 template <unsigned ELEMENT_DIM,unsigned SPACE_DIM>
-void AbstractCardiacTissue<ELEMENT_DIM,SPACE_DIM>::SolveCellSystems(Vec existingSolution, double time, double nextTime, bool updateVoltage)
+void AbstractCardiacTissue<ELEMENT_DIM,SPACE_DIM>::SetUpCellBatches()
 {
-    if (mHasPurkinje)
+    ReleaseCellBatchStates();
+    const unsigned num_chunks = mCellChunkStarts.size() - 1;
+    mCellBatches.clear();
+    mCellBatches.resize(num_chunks);
+    mCellBatchOfCell.assign(mCellsDistributed.size(), NULL);
+    mCellBatchPosition.assign(mCellsDistributed.size(), 0u);
+
+    for (unsigned chunk=0; chunk<num_chunks; chunk++)
     {
-        // can't do Purkinje and operator splitting
-        assert(!updateVoltage);
-        // The code below assumes Purkinje is are monodomain, so the vector has two stripes.
-        // The assert will fail the first time bidomain purkinje is coded - need to decide what
-        // ordering the three stripes (V, V_purk, phi_e) are in
-        assert(PetscVecTools::GetSize(existingSolution)==2*mpMesh->GetNumNodes());
+        std::vector<boost::shared_ptr<CardiacCellBatch> >& r_batches = mCellBatches[chunk];
+        for (unsigned local_index=mCellChunkStarts[chunk]; local_index<mCellChunkStarts[chunk+1]; local_index++)
+        {
+            if (!CardiacCellBatch::CanBatch(mCellsDistributed[local_index]))
+            {
+                continue;
+            }
+            AbstractCardiacCell* p_cell = dynamic_cast<AbstractCardiacCell*>(mCellsDistributed[local_index]);
+
+            // There are only ever a handful of different cell models in a tissue, so a linear search will do
+            CardiacCellBatch* p_batch = NULL;
+            for (unsigned batch=0; batch<r_batches.size() && !p_batch; batch++)
+            {
+                if (r_batches[batch]->IsCompatible(p_cell))
+                {
+                    p_batch = r_batches[batch].get();
+                    p_batch->AddCell(p_cell);
+                }
+            }
+            if (!p_batch)
+            {
+                r_batches.push_back(boost::shared_ptr<CardiacCellBatch>(new CardiacCellBatch(p_cell)));
+                p_batch = r_batches.back().get();
+            }
+            mCellBatchOfCell[local_index] = p_batch;
+            mCellBatchPosition[local_index] = p_batch->GetNumCells() - 1;
+        }
     }
+    mCellBatchesSetUp = true;
+}
 
-    HeartEventHandler::BeginEvent(HeartEventHandler::SOLVE_ODES);
+template <unsigned ELEMENT_DIM,unsigned SPACE_DIM>
+void AbstractCardiacTissue<ELEMENT_DIM,SPACE_DIM>::ReleaseCellBatchStates() const
+{
+    for (unsigned chunk=0; chunk<mCellBatches.size(); chunk++)
+    {
+        for (unsigned batch=0; batch<mCellBatches[chunk].size(); batch++)
+        {
+            mCellBatches[chunk][batch]->ScatterStateVariables();
+        }
+    }
+}
 
-    DistributedVector dist_solution = mpDistributedVectorFactory->CreateDistributedVector(existingSolution);
+template <unsigned ELEMENT_DIM,unsigned SPACE_DIM>
+void AbstractCardiacTissue<ELEMENT_DIM,SPACE_DIM>::SetUpCellSolveThreads(unsigned numThreads)
+{
+    assert(numThreads > 0);
+#ifdef CHASTE_OPENMP
+    if (numThreads > (unsigned)omp_get_num_procs())
+    {
+        EXCEPTION("Cannot use " << numThreads << " cell solve threads on a machine with " << omp_get_num_procs() << " processors.");
+    }
+#endif // CHASTE_OPENMP
 
-    /////////////////////////////////////////////////////////////
-    // Solve cell models (except purkinje cell models)
-    /////////////////////////////////////////////////////////////
-    DistributedVector::Stripe voltage(dist_solution, 0);
-    try
+    // Contiguous chunks of local cells, one per thread, so the split is deterministic
+    unsigned num_local_cells = mCellsDistributed.size();
+    mCellChunkStarts.resize(numThreads + 1);
+    for (unsigned chunk=0; chunk<=numThreads; chunk++)
     {
-        double voltage_before_update;
-        for (DistributedVector::Iterator index = dist_solution.Begin();
-             index != dist_solution.End();
-             ++index)
-        {
-            voltage_before_update = voltage[index];
-            mCellsDistributed[index.Local]->SetVoltage( voltage_before_update );
+        mCellChunkStarts[chunk] = (chunk*num_local_cells)/numThreads;
+    }
 
-            // Added a try-catch here to provide more output to screen when an error occurs.
-            /// \todo This may want to go to std::cerr ??
-            try
+    if (numThreads > 1)
+    {
+        // One-step ODE solvers keep working memory, so cells sharing a solver can't be solved
+        // concurrently.  Give each chunk its own forward Euler solver.  Cells with no solver
+        // (which solve themselves) and CVODE cells (which own their CVODE memory) are fine as they are.
+        for (unsigned chunk=0; chunk<numThreads; chunk++)
+        {
+            boost::shared_ptr<AbstractIvpOdeSolver> p_chunk_solver(new EulerIvpOdeSolver);
+            for (unsigned local_index=mCellChunkStarts[chunk]; local_index<mCellChunkStarts[chunk+1]; local_index++)
             {
-                if (!updateVoltage)
+                AbstractCardiacCellInterface* p_cell = mCellsDistributed[local_index];
+#ifdef CHASTE_CVODE
+                if (dynamic_cast<AbstractCvodeCell*>(p_cell))
+                {
+                    continue;
+                }
+#endif // CHASTE_CVODE
+                AbstractIvpOdeSolver* p_solver = p_cell->GetSolver().get();
+                if (p_solver == NULL)
+                {
+                    continue;
+                }
+                if (typeid(*p_solver) != typeid(EulerIvpOdeSolver))
                 {
-                    // solve ODE system at this node.
-                    // Note: Voltage is not being updated. The voltage is updated in the PDE solve.
+                    EXCEPTION("Solving cells with more than one thread is only supported for cells using forward Euler, "
+                              "CVODE, or their own solver (e.g. backward Euler or Rush-Larsen cells).");
+                }
+                p_cell->SetSolver(p_chunk_solver);
+            }
+        }
+    }
+
+    // Batches must not span chunks
+    ReleaseCellBatchStates();
+    mCellBatchesSetUp = false;
+}
+
+template <unsigned ELEMENT_DIM,unsigned SPACE_DIM>
+unsigned AbstractCardiacTissue<ELEMENT_DIM,SPACE_DIM>::SolveCellSystemsForChunk(unsigned chunk,
+                                                                                DistributedVector::Stripe& rVoltage,
+                                                                                double time,
+                                                                                double nextTime,
+                                                                                bool updateVoltage,
+                                                                                bool useBatches,
+                                                                                bool useAdaptive)
+{
+    const unsigned low = mpDistributedVectorFactory->GetLow();
+    unsigned num_cells_solved = 0u;
+    for (unsigned local_index=mCellChunkStarts[chunk]; local_index<mCellChunkStarts[chunk+1]; local_index++)
+    {
+        const unsigned global_index = low + local_index;
+        AbstractCardiacCellInterface* p_cell = mCellsDistributed[local_index];
+
+        double voltage_before_update = rVoltage[global_index];
+        p_cell->SetVoltage( voltage_before_update );
+
+        if (useBatches && mCellBatchOfCell[local_index] != NULL)
+        {
+            // This cell is solved along with the rest of its batch below
+            continue;
+        }
+
+        std::vector<double> state_before_solve;
+        if (useAdaptive)
+        {
+            if (CellRemainsQuiescent(local_index, voltage_before_update, time, nextTime))
+            {
+                // Its state and caches are as they were at its last solve
+                mCellQuiescentTimes[local_index] += nextTime - time;
+                continue;
+            }
+            state_before_solve = p_cell->GetStdVecStateVariables();
+        }
+
+        // Added a try-catch here to provide more output to screen when an error occurs.
+        /// \todo This may want to go to std::cerr ??
+        try
+        {
+            if (!updateVoltage)
+            {
+                // solve ODE system at this node.
+                // Note: Voltage is not being updated. The voltage is updated in the PDE solve.
 #ifndef CHASTE_CVODE
-                    mCellsDistributed[index.Local]->ComputeExceptVoltage(time, nextTime);
+                p_cell->ComputeExceptVoltage(time, nextTime);
 #else
-                    // If CVODE is enabled, and this is a CVODE cell
-                    // there's a chance we can recover this by doing a reset so put the above call in a try...catch.
-                    try
+                // If CVODE is enabled, and this is a CVODE cell
+                // there's a chance we can recover this by doing a reset so put the above call in a try...catch.
+                try
+                {
+                    p_cell->ComputeExceptVoltage(time, nextTime);
+                }
+                catch (Exception &e)
+                {
+                    // Try an 'emergency' reset if this is a CVODE cell.
+                    // See #2594 for why we think this may be necessary.
+                    if (dynamic_cast<AbstractCvodeCell*>(p_cell))
                     {
-                        mCellsDistributed[index.Local]->ComputeExceptVoltage(time, nextTime);
+                        // Reset the CVODE cell, this leads to a call to CVodeReInit.
+                        static_cast<AbstractCvodeCell*>(p_cell)->ResetSolver();
+                        p_cell->ComputeExceptVoltage(time, nextTime);
+#ifdef CHASTE_OPENMP
+#pragma omp critical(AbstractCardiacTissueOutput)
+#endif // CHASTE_OPENMP
+                        WARNING("Global node " << global_index << " had an ODE solving problem in t = [" << time <<
+                                ", " << nextTime << "] ms. This was fixed by a reset of CVODE, but may suggest PDE time"
+                                " step should be reduced, or CVODE tolerances relaxed.");
                     }
-                    catch (Exception &e)
+                    else
                     {
-                        // Try an 'emergency' reset if this is a CVODE cell.
-                        // See #2594 for why we think this may be necessary.
-                        if (dynamic_cast<AbstractCvodeCell*>(mCellsDistributed[index.Local]))
-                        {
-                            // Reset the CVODE cell, this leads to a call to CVodeReInit.
-                            static_cast<AbstractCvodeCell*>(mCellsDistributed[index.Local])->ResetSolver();
-                            mCellsDistributed[index.Local]->ComputeExceptVoltage(time, nextTime);
-                            WARNING("Global node " << index.Global << " had an ODE solving problem in t = [" << time <<
-                                    ", " << nextTime << "] ms. This was fixed by a reset of CVODE, but may suggest PDE time"
-                                    " step should be reduced, or CVODE tolerances relaxed.");
-                        }
-                        else
-                        {
-                            throw e;
-                        }
+                        throw e;
                     }
-#endif // CHASTE_CVODE
-                }
-                else
-                {
-                    // solve, including updating the voltage (for the operator-splitting implementation of the monodomain solver)
-                    mCellsDistributed[index.Local]->SolveAndUpdateState(time, nextTime);
-                    voltage[index] = mCellsDistributed[index.Local]->GetVoltage();
                 }
+#endif // CHASTE_CVODE
             }
-            catch (Exception &e)
+            else
+            {
+                // solve, including updating the voltage (for the operator-splitting implementation of the monodomain solver)
+                p_cell->SolveAndUpdateState(time, nextTime);
+                rVoltage[global_index] = p_cell->GetVoltage();
+            }
+        }
+        catch (Exception &e)
+        {
+#ifdef CHASTE_OPENMP
+#pragma omp critical(AbstractCardiacTissueOutput)
+#endif // CHASTE_OPENMP
             {
                 std::cout << std::setprecision(16);
-                std::cout << "Global node " << index.Global << " had problems with ODE solve between "
+                std::cout << "Global node " << global_index << " had problems with ODE solve between "
                         "t = " << time << " and " << nextTime << "ms.\n";
 
                 std::cout << "Voltage at this node before solve was " << voltage_before_update << "mV\n"
@@ -546,26 +686,232 @@ void AbstractCardiacTissue<ELEMENT_DIM,SPACE_DIM>::SolveCellSystems(Vec existing
                         "which can be ignored and stay at the initial condition - the voltage is dictated by PDE instead of state variable.)\n";
 
                 std::cout << "Stimulus current (NB converted to micro-Amps per cm^3) applied here is equal to:\n\t"
-                    << mCellsDistributed[index.Local]->GetIntracellularStimulus(time) << " at t = " << time     << "ms,\n\t"
-                    << mCellsDistributed[index.Local]->GetIntracellularStimulus(nextTime) << " at t = " << nextTime << "ms.\n";
+                    << p_cell->GetIntracellularStimulus(time) << " at t = " << time     << "ms,\n\t"
+                    << p_cell->GetIntracellularStimulus(nextTime) << " at t = " << nextTime << "ms.\n";
 
-                std::cout << "Cell model: " << dynamic_cast<AbstractUntemplatedParameterisedSystem*>(mCellsDistributed[index.Local])->GetSystemName() << "\n";
+                std::cout << "Cell model: " << dynamic_cast<AbstractUntemplatedParameterisedSystem*>(p_cell)->GetSystemName() << "\n";
 
                 std::cout << "All state variables are now:\n";
-                std::vector<double> state_vars = mCellsDistributed[index.Local]->GetStdVecStateVariables();
-                std::vector<std::string> state_var_names = mCellsDistributed[index.Local]->rGetStateVariableNames();
+                std::vector<double> state_vars = p_cell->GetStdVecStateVariables();
+                std::vector<std::string> state_var_names = p_cell->rGetStateVariableNames();
                 for (unsigned i=0; i<state_vars.size(); i++)
                 {
                     std::cout << "\t" << state_var_names[i] << "\t:\t" << state_vars[i] << "\n";
                 }
                 std::cout << std::flush;
+            }
+
+            throw e;
+        }
+        // update the Iionic and stimulus caches
+        UpdateCaches(global_index, local_index, nextTime);
+        num_cells_solved++;
+
+        if (useAdaptive)
+        {
+            ClassifyCellActivity(local_index, voltage_before_update, state_before_solve, time, nextTime);
+        }
+    }
 
+    if (useBatches)
+    {
+        for (unsigned batch=0; batch<mCellBatches[chunk].size(); batch++)
+        {
+            try
+            {
+                mCellBatches[chunk][batch]->ComputeExceptVoltage(time, nextTime);
+            }
+            catch (Exception &e)
+            {
+#ifdef CHASTE_OPENMP
+#pragma omp critical(AbstractCardiacTissueOutput)
+#endif // CHASTE_OPENMP
+                std::cout << "A batch of " << mCellBatches[chunk][batch]->GetNumCells() << " cells of model "
+                          << mCellBatches[chunk][batch]->rGetCells()[0]->GetSystemName()
+                          << " had problems with ODE solve between t = " << time << " and " << nextTime << "ms.\n" << std::flush;
                 throw e;
             }
-            // update the Iionic and stimulus caches
-            UpdateCaches(index.Global, index.Local, nextTime);
         }
 
+        // The batches computed the ionic currents while they had the state to hand
+        for (unsigned local_index=mCellChunkStarts[chunk]; local_index<mCellChunkStarts[chunk+1]; local_index++)
+        {
+            const CardiacCellBatch* p_batch = mCellBatchOfCell[local_index];
+            if (p_batch != NULL)
+            {
+                const unsigned global_index = low + local_index;
+                mIionicCacheReplicated[global_index] = p_batch->GetIIonic(mCellBatchPosition[local_index]);
+                mIntracellularStimulusCacheReplicated[global_index] = mCellsDistributed[local_index]->GetIntracellularStimulus(nextTime);
+                num_cells_solved++;
+            }
+        }
+    }
+    return num_cells_solved;
+}
+
+template <unsigned ELEMENT_DIM,unsigned SPACE_DIM>
+bool AbstractCardiacTissue<ELEMENT_DIM,SPACE_DIM>::CellRemainsQuiescent(unsigned localIndex, double voltage, double time, double nextTime)
+{
+    if (mCellQuiescentTimes[localIndex] < 0.0)
+    {
+        return false;
+    }
+    const double interval = mCellQuiescentTimes[localIndex] + (nextTime - time);
+    if (interval > HeartConfig::Instance()->GetAdaptiveCellSolveMaxQuiescentInterval())
+    {
+        return false;
+    }
+    if (fabs(voltage - mCellQuiescentVoltages[localIndex]) > HeartConfig::Instance()->GetAdaptiveCellSolveVoltageRateThreshold()*interval)
+    {
+        return false;
+    }
+    AbstractCardiacCellInterface* p_cell = mCellsDistributed[localIndex];
+    return (p_cell->GetIntracellularStimulus(time) == 0.0 && p_cell->GetIntracellularStimulus(nextTime) == 0.0);
+}
+
+template <unsigned ELEMENT_DIM,unsigned SPACE_DIM>
+void AbstractCardiacTissue<ELEMENT_DIM,SPACE_DIM>::ClassifyCellActivity(unsigned localIndex,
+                                                                        double voltage,
+                                                                        const std::vector<double>& rStateBeforeSolve,
+                                                                        double time,
+                                                                        double nextTime)
+{
+    AbstractCardiacCellInterface* p_cell = mCellsDistributed[localIndex];
+    const unsigned global_index = mpDistributedVectorFactory->GetLow() + localIndex;
+    const double dt = nextTime - time;
+    const double voltage_rate_threshold = HeartConfig::Instance()->GetAdaptiveCellSolveVoltageRateThreshold();
+    const double state_rate_threshold = HeartConfig::Instance()->GetAdaptiveCellSolveStateRateThreshold();
+
+    // Not stimulated, voltage steady according to the PDE, and dV/dt = -I_ionic/C_m small...
+    bool quiescent = (mIntracellularStimulusCacheReplicated[global_index] == 0.0)
+                     && (p_cell->GetIntracellularStimulus(time) == 0.0)
+                     && (fabs(voltage - mCellQuiescentVoltages[localIndex]) <= voltage_rate_threshold*dt)
+                     && (fabs(mIionicCacheReplicated[global_index]) <= voltage_rate_threshold*mQuiescentCapacitance);
+
+    // ...and the other state variables changing slowly relative to their size
+    if (quiescent)
+    {
+        std::vector<double> state_after_solve = p_cell->GetStdVecStateVariables();
+        const unsigned voltage_index = p_cell->GetVoltageIndex();
+        for (unsigned i=0; i<state_after_solve.size() && quiescent; i++)
+        {
+            if (i != voltage_index
+                && fabs(state_after_solve[i] - rStateBeforeSolve[i]) > state_rate_threshold*dt*fabs(rStateBeforeSolve[i]))
+            {
+                quiescent = false;
+            }
+        }
+    }
+
+    mCellQuiescentTimes[localIndex] = quiescent ? 0.0 : -1.0;
+    mCellQuiescentVoltages[localIndex] = voltage;
+}
+
+template <unsigned ELEMENT_DIM,unsigned SPACE_DIM>
+void AbstractCardiacTissue<ELEMENT_DIM,SPACE_DIM>::SolveCellSystems(Vec existingSolution, double time, double nextTime, bool updateVoltage)
+{
+    if (mHasPurkinje)
+    {
+        // can't do Purkinje and operator splitting
+        assert(!updateVoltage);
+        // The code below assumes Purkinje is are monodomain, so the vector has two stripes.
+        // The assert will fail the first time bidomain purkinje is coded - need to decide what
+        // ordering the three stripes (V, V_purk, phi_e) are in
+        assert(PetscVecTools::GetSize(existingSolution)==2*mpMesh->GetNumNodes());
+    }
+
+    HeartEventHandler::BeginEvent(HeartEventHandler::SOLVE_ODES);
+
+    DistributedVector dist_solution = mpDistributedVectorFactory->CreateDistributedVector(existingSolution);
+
+    /////////////////////////////////////////////////////////////
+    // Solve cell models (except purkinje cell models)
+    /////////////////////////////////////////////////////////////
+    DistributedVector::Stripe voltage(dist_solution, 0);
+
+    // Batched solves only apply when the voltage is not being updated by the cells
+    bool use_batches = HeartConfig::Instance()->GetUseBatchedCellSolves() && !updateVoltage;
+    // Likewise skipping the solves of quiescent cells
+    bool use_adaptive = HeartConfig::Instance()->GetUseAdaptiveCellSolves() && !updateVoltage;
+    unsigned num_threads = HeartConfig::Instance()->GetNumberOfCellSolveThreads();
+    try
+    {
+        if (num_threads + 1 != mCellChunkStarts.size())
+        {
+            SetUpCellSolveThreads(num_threads);
+        }
+        if (mCellBatchesSetUp && use_batches)
+        {
+            // Cells which have held their own state since the last solve may have been
+            // given a new timestep or ODE solver
+            for (unsigned chunk=0; chunk<mCellBatches.size() && mCellBatchesSetUp; chunk++)
+            {
+                for (unsigned batch=0; batch<mCellBatches[chunk].size() && mCellBatchesSetUp; batch++)
+                {
+                    const CardiacCellBatch& r_batch = *(mCellBatches[chunk][batch]);
+                    if (!r_batch.IsStateResident() && !r_batch.AreCellsCompatible())
+                    {
+                        mCellBatchesSetUp = false;
+                    }
+                }
+            }
+        }
+        else if (mCellBatchesSetUp)
+        {
+            // The cells are about to be solved individually
+            ReleaseCellBatchStates();
+            mCellBatchesSetUp = false;
+        }
+        if (use_batches && !mCellBatchesSetUp)
+        {
+            SetUpCellBatches();
+        }
+        if (use_adaptive)
+        {
+            if (mCellQuiescentTimes.size() != mCellsDistributed.size())
+            {
+                // All cells start off active
+                mCellQuiescentTimes.assign(mCellsDistributed.size(), -1.0);
+                mCellQuiescentVoltages.assign(mCellsDistributed.size(), DBL_MAX);
+            }
+            mQuiescentCapacitance = HeartConfig::Instance()->GetCapacitance();
+        }
+        else
+        {
+            mCellQuiescentTimes.clear();
+            mCellQuiescentVoltages.clear();
+        }
+
+        // Each thread solves one chunk of the local cells.  Exceptions can't propagate out of
+        // a parallel region, so they are captured per chunk and the first one re-thrown afterwards.
+        std::vector<boost::shared_ptr<Exception> > chunk_exceptions(num_threads);
+        std::vector<unsigned> chunk_num_cells_solved(num_threads, 0u);
+#ifdef CHASTE_OPENMP
+#pragma omp parallel for schedule(static, 1) num_threads(num_threads)
+#endif // CHASTE_OPENMP
+        for (int chunk=0; chunk<(int)num_threads; chunk++)
+        {
+            try
+            {
+                chunk_num_cells_solved[chunk] = SolveCellSystemsForChunk(chunk, voltage, time, nextTime,
+                                                                         updateVoltage, use_batches, use_adaptive);
+            }
+            catch (Exception &e)
+            {
+                chunk_exceptions[chunk].reset(new Exception(e));
+            }
+        }
+        unsigned num_cells_solved = 0u;
+        for (unsigned chunk=0; chunk<num_threads; chunk++)
+        {
+            if (chunk_exceptions[chunk])
+            {
+                throw *(chunk_exceptions[chunk]);
+            }
+            num_cells_solved += chunk_num_cells_solved[chunk];
+        }
+        HeartEventHandler::RecordActiveCells(num_cells_solved, mCellsDistributed.size());
+
         if (updateVoltage)
         {
             dist_solution.Restore();
@@ -644,8 +990,18 @@ void AbstractCardiacTissue<ELEMENT_DIM,SPACE_DIM>::SolveCellSystems(Vec existing
             for (unsigned cell = 0; cell < number_of_cells_to_send; cell++)
             {
                 unsigned global_cell_index = mNodesToSendPerProcess[send_to][cell];
-                AbstractCardiacCellInterface* p_cell = mCellsDistributed[global_cell_index - mpDistributedVectorFactory->GetLow()];
-                std::vector<double> cell_data = p_cell->GetStdVecStateVariables();
+                unsigned local_cell_index = global_cell_index - mpDistributedVectorFactory->GetLow();
+                AbstractCardiacCellInterface* p_cell = mCellsDistributed[local_cell_index];
+                std::vector<double> cell_data;
+                if (mCellBatchesSetUp && mCellBatchOfCell[local_cell_index] != NULL)
+                {
+                    // The state may still be held by the batch
+                    cell_data = mCellBatchOfCell[local_cell_index]->GetStateVariables(mCellBatchPosition[local_cell_index]);
+                }
+                else
+                {
+                    cell_data = p_cell->GetStdVecStateVariables();
+                }
                 const unsigned num_state_vars = p_cell->GetNumberOfStateVariables();
                 for (unsigned state_variable = 0; state_variable < num_state_vars; state_variable++)
                 {
@@ -761,6 +1117,7 @@ void AbstractCardiacTissue<ELEMENT_DIM,SPACE_DIM>::ReplicateCaches()
 template <unsigned ELEMENT_DIM,unsigned SPACE_DIM>
 const std::vector<AbstractCardiacCellInterface*>& AbstractCardiacTissue<ELEMENT_DIM,SPACE_DIM>::rGetCellsDistributed() const
 {
+    ReleaseCellBatchStates();
     return mCellsDistributed;
 }
 
@@ -786,6 +1143,12 @@ void AbstractCardiacTissue<ELEMENT_DIM,SPACE_DIM>::SetConductivityModifier(Abstr
     mpConductivityModifier = pModifier;
 }
 
+template <unsigned ELEMENT_DIM,unsigned SPACE_DIM>
+bool AbstractCardiacTissue<ELEMENT_DIM,SPACE_DIM>::HasConductivityModifier() const
+{
+    return (mpConductivityModifier != NULL);
+}
+
 // Explicit instantiation
 template class AbstractCardiacTissue<1,1>;
 template class AbstractCardiacTissue<1,2>;
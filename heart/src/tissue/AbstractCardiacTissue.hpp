@@ -61,6 +61,7 @@ OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "AbstractDynamicallyLoadableEntity.hpp"
 #include "DynamicModelLoaderRegistry.hpp"
 #include "AbstractConductivityModifier.hpp"
+#include "CardiacCellBatch.hpp"
 
 /**
  * Class containing "tissue-like" functionality used in monodomain and bidomain
@@ -335,6 +336,116 @@ protected:
      */
     std::vector<std::vector<unsigned> > mNodesToReceivePerProcess;
 
+    /**
+     * Batches of local cells of the same model type which are solved together, if
+     * HeartConfig::GetUseBatchedCellSolves() is set.  Not archived: these are rebuilt
+     * from #mCellsDistributed when first needed.  Indexed by chunk (see #mCellChunkStarts)
+     * then batch, so that no batch spans two threads.
+     *
+     * Between solves the batches hold the state of their cells; the accessors which give out
+     * the cells call ReleaseCellBatchStates first.
+     */
+    std::vector<std::vector<boost::shared_ptr<CardiacCellBatch> > > mCellBatches;
+
+    /** For each local cell, the batch in #mCellBatches it is solved in, or NULL. */
+    std::vector<CardiacCellBatch*> mCellBatchOfCell;
+
+    /** For each local cell in a batch, its position in that batch. */
+    std::vector<unsigned> mCellBatchPosition;
+
+    /** Whether #mCellBatches, #mCellBatchOfCell and #mCellBatchPosition have been set up. */
+    bool mCellBatchesSetUp;
+
+    /**
+     * Group the local cells into #mCellBatches.  Cells which cannot be batched
+     * (see CardiacCellBatch::CanBatch) are left to be solved individually.
+     */
+    void SetUpCellBatches();
+
+    /**
+     * Hand the state held by each of #mCellBatches back to its cells (see
+     * CardiacCellBatch::ScatterStateVariables), so that the cell objects are up to date.
+     * Cheap if this has already been done since the last solve.
+     */
+    void ReleaseCellBatchStates() const;
+
+    /**
+     * The local cells are split into contiguous chunks, one per cell solve thread
+     * (see HeartConfig::GetNumberOfCellSolveThreads()).  Chunk i covers local indices
+     * [mCellChunkStarts[i], mCellChunkStarts[i+1]).  Not archived.
+     */
+    std::vector<unsigned> mCellChunkStarts;
+
+    /**
+     * Split the local cells into chunks for the given number of threads, and give each
+     * chunk its own ODE solver where the cells share one.
+     *
+     * @param numThreads  the number of threads which will solve the cells
+     */
+    void SetUpCellSolveThreads(unsigned numThreads);
+
+    /**
+     * Solve the cells in one chunk of the local cells (see #mCellChunkStarts), including any
+     * batches in that chunk.  Called from SolveCellSystems, possibly concurrently for different chunks.
+     *
+     * @param chunk  the chunk to solve
+     * @param rVoltage  the voltage stripe of the existing solution
+     * @param time  the current time
+     * @param nextTime  the time to solve to
+     * @param updateVoltage  whether the cells should also update the voltage
+     * @param useBatches  whether cells in #mCellBatches should be solved as batches
+     * @param useAdaptive  whether quiescent cells may skip their solves (see HeartConfig::SetUseAdaptiveCellSolves)
+     * @return the number of cells solved
+     */
+    unsigned SolveCellSystemsForChunk(unsigned chunk,
+                                      DistributedVector::Stripe& rVoltage,
+                                      double time,
+                                      double nextTime,
+                                      bool updateVoltage,
+                                      bool useBatches,
+                                      bool useAdaptive);
+
+    /**
+     * For adaptive cell solves (see HeartConfig::SetUseAdaptiveCellSolves), for each local cell
+     * the time for which it has been quiescent (i.e. its solves have been skipped), or a
+     * negative value if it is active.  Not archived: all cells are active after loading.
+     */
+    std::vector<double> mCellQuiescentTimes;
+
+    /** For adaptive cell solves, the voltage at which each local cell was last solved. */
+    std::vector<double> mCellQuiescentVoltages;
+
+    /** For adaptive cell solves, the membrane capacitance used to convert ionic currents to dV/dt. */
+    double mQuiescentCapacitance;
+
+    /**
+     * @return whether a quiescent cell may skip its solve on this step, i.e. it is not stimulated,
+     * the voltage has not moved far from where it was last solved and the maximum quiescent
+     * interval has not been reached.
+     *
+     * @param localIndex  the local index of the cell
+     * @param voltage  the current voltage at the cell
+     * @param time  the current time
+     * @param nextTime  the time to solve to
+     */
+    bool CellRemainsQuiescent(unsigned localIndex, double voltage, double time, double nextTime);
+
+    /**
+     * Having solved a cell, decide whether it is quiescent, i.e. not stimulated, with its voltage
+     * and other state variables changing slowly (see HeartConfig::SetAdaptiveCellSolveParameters).
+     *
+     * @param localIndex  the local index of the cell
+     * @param voltage  the voltage at the cell for this solve
+     * @param rStateBeforeSolve  the cell's state variables before the solve
+     * @param time  the start time of the solve
+     * @param nextTime  the end time of the solve
+     */
+    void ClassifyCellActivity(unsigned localIndex,
+                              double voltage,
+                              const std::vector<double>& rStateBeforeSolve,
+                              double time,
+                              double nextTime);
+
     /**
      * If the mesh is a tetrahedral mesh then all elements and nodes are known.
      * The halo nodes to the ones which are actually used as cardiac cells
@@ -506,6 +617,12 @@ public:
      */
     void SetConductivityModifier(AbstractConductivityModifier<ELEMENT_DIM,SPACE_DIM>* pModifier);
 
+    /**
+     * @return whether a conductivity modifier has been set with SetConductivityModifier().
+     * Modifiers typically cache the modified tensor, so their use is not thread-safe.
+     */
+    bool HasConductivityModifier() const;
+
     /**
      * Save our tissue to an archive.
      *
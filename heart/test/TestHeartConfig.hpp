@@ -1254,6 +1254,76 @@ public:
         TS_ASSERT_EQUALS(HeartConfig::Instance()->GetEvaluateNumItsEveryNSolves(), 20u);
     }
 
+    void TestPerformanceOptions() throw (Exception)
+    {
+        HeartConfig::Reset();
+
+        TS_ASSERT_EQUALS(HeartConfig::Instance()->GetUseBatchedCellSolves(), false);
+        HeartConfig::Instance()->SetUseBatchedCellSolves();
+        TS_ASSERT_EQUALS(HeartConfig::Instance()->GetUseBatchedCellSolves(), true);
+        HeartConfig::Instance()->SetUseBatchedCellSolves(false);
+        TS_ASSERT_EQUALS(HeartConfig::Instance()->GetUseBatchedCellSolves(), false);
+
+        TS_ASSERT_EQUALS(HeartConfig::Instance()->GetNumberOfCellSolveThreads(), 1u);
+        HeartConfig::Instance()->SetNumberOfCellSolveThreads(1u);
+        TS_ASSERT_EQUALS(HeartConfig::Instance()->GetNumberOfCellSolveThreads(), 1u);
+
+        TS_ASSERT_EQUALS(HeartConfig::Instance()->GetUseAdaptiveCellSolves(), false);
+        HeartConfig::Instance()->SetUseAdaptiveCellSolves();
+        TS_ASSERT_EQUALS(HeartConfig::Instance()->GetUseAdaptiveCellSolves(), true);
+        HeartConfig::Instance()->SetUseAdaptiveCellSolves(false);
+        TS_ASSERT_EQUALS(HeartConfig::Instance()->GetUseAdaptiveCellSolves(), false);
+        TS_ASSERT_DELTA(HeartConfig::Instance()->GetAdaptiveCellSolveVoltageRateThreshold(), 0.01, 1e-12);
+        TS_ASSERT_DELTA(HeartConfig::Instance()->GetAdaptiveCellSolveStateRateThreshold(), 1e-4, 1e-12);
+        TS_ASSERT_DELTA(HeartConfig::Instance()->GetAdaptiveCellSolveMaxQuiescentInterval(), 1.0, 1e-12);
+        HeartConfig::Instance()->SetAdaptiveCellSolveParameters(0.1, 1e-3, 2.0);
+        TS_ASSERT_DELTA(HeartConfig::Instance()->GetAdaptiveCellSolveVoltageRateThreshold(), 0.1, 1e-12);
+        TS_ASSERT_DELTA(HeartConfig::Instance()->GetAdaptiveCellSolveStateRateThreshold(), 1e-3, 1e-12);
+        TS_ASSERT_DELTA(HeartConfig::Instance()->GetAdaptiveCellSolveMaxQuiescentInterval(), 2.0, 1e-12);
+        TS_ASSERT_THROWS_THIS(HeartConfig::Instance()->SetAdaptiveCellSolveParameters(-0.1, 1e-3, 2.0),
+                              "Adaptive cell solve thresholds must be non-negative.");
+        TS_ASSERT_THROWS_THIS(HeartConfig::Instance()->SetAdaptiveCellSolveParameters(0.1, 1e-3, 0.0),
+                              "The maximum quiescent interval for adaptive cell solves must be positive.");
+
+        TS_ASSERT_EQUALS(HeartConfig::Instance()->GetHdf5OutputSinglePrecision(), false);
+        HeartConfig::Instance()->SetHdf5OutputSinglePrecision();
+        TS_ASSERT_EQUALS(HeartConfig::Instance()->GetHdf5OutputSinglePrecision(), true);
+        HeartConfig::Instance()->SetHdf5OutputSinglePrecision(false);
+        TS_ASSERT_EQUALS(HeartConfig::Instance()->GetHdf5OutputCompressionLevel(), 0u);
+        HeartConfig::Instance()->SetHdf5OutputCompressionLevel(4u);
+        TS_ASSERT_EQUALS(HeartConfig::Instance()->GetHdf5OutputCompressionLevel(), 4u);
+        HeartConfig::Instance()->SetHdf5OutputCompressionLevel(0u);
+        TS_ASSERT_THROWS_THIS(HeartConfig::Instance()->SetHdf5OutputCompressionLevel(10u),
+                              "The HDF5 output compression level must be between 0 and 9.");
+        TS_ASSERT_EQUALS(HeartConfig::Instance()->GetHdf5OutputQuantisationTolerance(), 0.0);
+        HeartConfig::Instance()->SetHdf5OutputQuantisationTolerance(1e-2);
+        TS_ASSERT_DELTA(HeartConfig::Instance()->GetHdf5OutputQuantisationTolerance(), 1e-2, 1e-12);
+        HeartConfig::Instance()->SetHdf5OutputQuantisationTolerance(0.0);
+        TS_ASSERT_THROWS_THIS(HeartConfig::Instance()->SetHdf5OutputQuantisationTolerance(-1.0),
+                              "The HDF5 output quantisation tolerance must be non-negative.");
+
+        TS_ASSERT_EQUALS(HeartConfig::Instance()->GetVisualizeVtkOneFilePerTimeStep(), false);
+        HeartConfig::Instance()->SetVisualizeVtkOneFilePerTimeStep();
+        TS_ASSERT_EQUALS(HeartConfig::Instance()->GetVisualizeVtkOneFilePerTimeStep(), true);
+        HeartConfig::Instance()->SetVisualizeVtkOneFilePerTimeStep(false);
+
+        TS_ASSERT_EQUALS(HeartConfig::Instance()->GetUseElementGeometryCache(), false);
+        HeartConfig::Instance()->SetUseElementGeometryCache();
+        TS_ASSERT_EQUALS(HeartConfig::Instance()->GetUseElementGeometryCache(), true);
+        HeartConfig::Instance()->SetUseElementGeometryCache(false);
+
+        TS_ASSERT_EQUALS(HeartConfig::Instance()->GetUseMatrixFreeRhs(), false);
+        HeartConfig::Instance()->SetUseMatrixFreeRhs();
+        TS_ASSERT_EQUALS(HeartConfig::Instance()->GetUseMatrixFreeRhs(), true);
+        HeartConfig::Instance()->SetUseMatrixFreeRhs(false);
+
+        TS_ASSERT_EQUALS(HeartConfig::Instance()->GetNumberOfAssemblyThreads(), 1u);
+        HeartConfig::Instance()->SetNumberOfAssemblyThreads(1u);
+        TS_ASSERT_EQUALS(HeartConfig::Instance()->GetNumberOfAssemblyThreads(), 1u);
+        TS_ASSERT_THROWS_THIS(HeartConfig::Instance()->SetNumberOfAssemblyThreads(0u),
+                              "The number of assembly threads must be at least 1.");
+    }
+
     void TestPostProcessingFunctions() throw (Exception)
     {
         // Tests for set functions of postprocessing
@@ -1409,6 +1479,12 @@ public:
         TS_ASSERT( user_ionic == cp::ionic_models_available_type::FaberRudy2000 );
         TS_ASSERT_EQUALS(HeartConfig::Instance()->GetSimulationDuration(), 10.0);
 
+        // Performance options are archived too
+        HeartConfig::Instance()->SetUseAdaptiveCellSolves();
+        HeartConfig::Instance()->SetAdaptiveCellSolveParameters(0.1, 1e-3, 2.0);
+        HeartConfig::Instance()->SetHdf5OutputCompressionLevel(4u);
+        HeartConfig::Instance()->SetNumberOfAssemblyThreads(2u);
+
         std::ofstream ofs(archive_filename.c_str());
         boost::archive::text_oarchive output_arch(ofs);
         HeartConfig* const p_archive_heart_config = HeartConfig::Instance();
@@ -1420,6 +1496,8 @@ public:
 
         TS_ASSERT(HeartConfig::Instance()->GetDefaultIonicModel().Hardcoded().present());
         TS_ASSERT_EQUALS(HeartConfig::Instance()->GetDefaultIonicModel().Hardcoded().get(), cp::ionic_models_available_type::LuoRudyI);
+        TS_ASSERT_EQUALS(HeartConfig::Instance()->GetUseAdaptiveCellSolves(), false);
+        TS_ASSERT_EQUALS(HeartConfig::Instance()->GetNumberOfAssemblyThreads(), 1u);
 
         // We split the two load attempts into their own scopes to avoid a
         // memory leak (uninitialised value).
@@ -1463,6 +1541,13 @@ public:
             TS_ASSERT_EQUALS(apd_maps.size(), 1u);
             TS_ASSERT_DELTA(apd_maps[0].first, 70.0, 1e-12);
             TS_ASSERT_DELTA(apd_maps[0].second, -20.0, 1e-12);
+
+            TS_ASSERT_EQUALS(HeartConfig::Instance()->GetUseAdaptiveCellSolves(), true);
+            TS_ASSERT_DELTA(HeartConfig::Instance()->GetAdaptiveCellSolveVoltageRateThreshold(), 0.1, 1e-12);
+            TS_ASSERT_DELTA(HeartConfig::Instance()->GetAdaptiveCellSolveStateRateThreshold(), 1e-3, 1e-12);
+            TS_ASSERT_DELTA(HeartConfig::Instance()->GetAdaptiveCellSolveMaxQuiescentInterval(), 2.0, 1e-12);
+            TS_ASSERT_EQUALS(HeartConfig::Instance()->GetHdf5OutputCompressionLevel(), 4u);
+            TS_ASSERT_EQUALS(HeartConfig::Instance()->GetNumberOfAssemblyThreads(), 2u);
         }
 
         {
@@ -1478,6 +1563,8 @@ public:
             TS_ASSERT(!HeartConfig::Instance()->GetCheckpointSimulation());
             TS_ASSERT(!HeartConfig::Instance()->GetVisualizeWithMeshalyzer());
         }
+
+        HeartConfig::Reset();
     }
 
     void TestExceptions() throw (Exception)
@@ -1229,8 +1229,33 @@ public:
                                                 4e-4));
     }
 
-    /* Disabled this one for now as it passes in an ugly way */
-    void louieTestBidomainProblemWithWriterCacheExtraVarsException() throw (Exception)
+    void TestBidomainProblemWithMatrixFreeRhs() throw (Exception)
+    {
+        HeartConfig::Instance()->SetOdePdeAndPrintingTimeSteps(0.01, 0.01, 0.01);
+        HeartConfig::Instance()->SetMeshFileName("mesh/test/data/1D_0_to_1mm_10_elements");
+        HeartConfig::Instance()->SetOutputFilenamePrefix("BidomainLR91_1d_matrix_free_rhs");
+        HeartConfig::Instance()->SetSimulationDuration(1.0);
+
+        // Solve with the assembled mass matrix, then matrix-free
+        for (unsigned run=0; run<2; run++)
+        {
+            HeartConfig::Instance()->SetOutputDirectory(run==0 ? "BidomainWithAssembledRhs" : "BidomainWithMatrixFreeRhs");
+            HeartConfig::Instance()->SetUseMatrixFreeRhs(run==1);
+
+            PlaneStimulusCellFactory<CellLuoRudy1991FromCellML, 1> cell_factory;
+            BidomainProblem<1> bidomain_problem( &cell_factory );
+
+            bidomain_problem.Initialise();
+            bidomain_problem.Solve();
+        }
+
+        // The two only differ in the order the RHS contributions are summed
+        TS_ASSERT(CompareFilesViaHdf5DataReader("BidomainWithMatrixFreeRhs", "BidomainLR91_1d_matrix_free_rhs", true,
+                                                "BidomainWithAssembledRhs", "BidomainLR91_1d_matrix_free_rhs", true,
+                                                1e-6));
+    }
+
+    void TestBidomainProblemWithWriterCacheExtraVars() throw (Exception)
     {
         HeartConfig::Instance()->SetParametersFile("heart/test/data/xml/MultipleVariablesBidomain.xml");
 
@@ -1240,13 +1265,23 @@ public:
         output_variables.push_back("fast_sodium_current_j_gate__j");
         output_variables.push_back("ionic_concentrations__Ki");
         HeartConfig::Instance()->SetOutputVariables( output_variables );
+        HeartConfig::Instance()->SetOutputFilenamePrefix("BidomainFR2000_1d_extra_vars");
 
-        PlaneStimulusCellFactory<CellFaberRudy2000FromCellML, 1> cell_factory;
-        BidomainProblem<1> bidomain_problem( &cell_factory );
-        bidomain_problem.SetUseHdf5DataWriterCache();
+        // The extra variables are written one at a time, after V and Phi_e, with and without the cache
+        for (unsigned run=0; run<2; run++)
+        {
+            HeartConfig::Instance()->SetOutputDirectory(run==0 ? "BidomainWithoutWriterCacheExtraVars" : "BidomainWithWriterCacheExtraVars");
 
-        bidomain_problem.Initialise();
-        TS_ASSERT_THROWS_THIS(bidomain_problem.Solve(), "Cached writes must write all variables at once.");
+            PlaneStimulusCellFactory<CellFaberRudy2000FromCellML, 1> cell_factory;
+            BidomainProblem<1> bidomain_problem( &cell_factory );
+            bidomain_problem.SetUseHdf5DataWriterCache(run==1);
+
+            bidomain_problem.Initialise();
+            bidomain_problem.Solve();
+        }
+
+        TS_ASSERT(CompareFilesViaHdf5DataReader("BidomainWithWriterCacheExtraVars", "BidomainFR2000_1d_extra_vars", true,
+                                                "BidomainWithoutWriterCacheExtraVars", "BidomainFR2000_1d_extra_vars", true));
     }
 
     /**
@@ -50,6 +50,10 @@ OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "LuoRudy1991.hpp"
 #include "MonodomainTissue.hpp"
 #include "BidomainTissue.hpp"
+#include "MonodomainAssembler.hpp"
+#include "BidomainAssembler.hpp"
+#include "PdeSimulationTime.hpp"
+#include "PetscMatTools.hpp"
 #include "OdeSolution.hpp"
 #include "PetscSetupAndFinalize.hpp"
 #include "PlaneStimulusCellFactory.hpp"
@@ -130,6 +134,44 @@ public:
 };
 class TestBidomainTissue : public CxxTest::TestSuite
 {
+private:
+
+    /**
+     * Assemble the matrix of a cardiac assembler with one thread and with three threads
+     * and check that the results are the same.
+     */
+    template<class ASSEMBLER, class TISSUE>
+    void CheckThreadedAssemblyMatchesSerial(TetrahedralMesh<2,2>& rMesh, TISSUE& rTissue, unsigned problemDim)
+    {
+        unsigned size = problemDim*rMesh.GetNumNodes();
+        unsigned num_local_rows = problemDim*rMesh.GetDistributedVectorFactory()->GetLocalOwnership();
+        unsigned max_nonzeros = problemDim*rMesh.CalculateMaximumNodeConnectivityPerProcess();
+
+        Mat serial_mat;
+        PetscTools::SetupMat(serial_mat, size, size, max_nonzeros, num_local_rows, num_local_rows);
+        HeartConfig::Instance()->SetNumberOfAssemblyThreads(1u);
+        ASSEMBLER serial_assembler(&rMesh, &rTissue);
+        TS_ASSERT_EQUALS(serial_assembler.GetNumberOfAssemblyThreads(), 1u);
+        serial_assembler.SetMatrixToAssemble(serial_mat, true);
+        serial_assembler.Assemble();
+        PetscMatTools::Finalise(serial_mat);
+
+        Mat threaded_mat;
+        PetscTools::SetupMat(threaded_mat, size, size, max_nonzeros, num_local_rows, num_local_rows);
+        HeartConfig::Instance()->SetNumberOfAssemblyThreads(3u);
+        ASSEMBLER threaded_assembler(&rMesh, &rTissue);
+        TS_ASSERT_EQUALS(threaded_assembler.GetNumberOfAssemblyThreads(), 3u);
+        threaded_assembler.SetMatrixToAssemble(threaded_mat, true);
+        threaded_assembler.Assemble();
+        PetscMatTools::Finalise(threaded_mat);
+
+        // Contributions are added in element order, so the matrices should be identical (up to round-off)
+        TS_ASSERT(PetscMatTools::CheckEquality(serial_mat, threaded_mat, 1e-12));
+
+        PetscTools::Destroy(serial_mat);
+        PetscTools::Destroy(threaded_mat);
+    }
+
 public:
 
     void TestBidomainTissueSolveCellSystems( void )
@@ -309,6 +351,36 @@ public:
         TS_ASSERT_EQUALS(bidomain_tissue.rGetExtracellularConductivityTensor(3u)(0,0),7.0);
     }
 
+    void TestCardiacAssemblyWithThreads() throw (Exception)
+    {
+        HeartConfig::Instance()->Reset();
+
+        // The assembly requires 1/time-step
+        PdeSimulationTime::SetTime(0.0);
+        PdeSimulationTime::SetPdeTimeStepAndNextTime(0.01, 0.01);
+
+        TetrahedralMesh<2,2> mesh;
+        mesh.ConstructRegularSlabMesh(0.1, 1.0, 1.0);
+
+        PlaneStimulusCellFactory<CellLuoRudy1991FromCellML, 2> cell_factory;
+        cell_factory.SetMesh(&mesh);
+        MonodomainTissue<2> monodomain_tissue(&cell_factory);
+        BidomainTissue<2> bidomain_tissue(&cell_factory);
+
+        // Elements are assembled concurrently
+        CheckThreadedAssemblyMatchesSerial<MonodomainAssembler<2,2> >(mesh, monodomain_tissue, 1u);
+        CheckThreadedAssemblyMatchesSerial<BidomainAssembler<2,2> >(mesh, bidomain_tissue, 2u);
+
+        // A conductivity modifier may not be thread-safe, so elements are assembled one at a time
+        SimpleConductivityModifier conductivity_modifier;
+        monodomain_tissue.SetConductivityModifier(&conductivity_modifier);
+        bidomain_tissue.SetConductivityModifier(&conductivity_modifier);
+        CheckThreadedAssemblyMatchesSerial<MonodomainAssembler<2,2> >(mesh, monodomain_tissue, 1u);
+        CheckThreadedAssemblyMatchesSerial<BidomainAssembler<2,2> >(mesh, bidomain_tissue, 2u);
+
+        HeartConfig::Instance()->Reset();
+    }
+
     void TestBidomainTissueWithHeterogeneousConductivitiesEllipsoid() throw (Exception)
     {
         HeartConfig::Instance()->Reset();
@@ -0,0 +1,229 @@
+/*
+
+Copyright (c) 2005-2017, University of Oxford.
+All rights reserved.
+
+University of Oxford means the Chancellor, Masters and Scholars of the
+University of Oxford, having an administrative office at Wellington
+Square, Oxford OX1 2JD, UK.
+
+This file is part of Chaste.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+ * Redistributions of source code must retain the above copyright notice,
+   this list of conditions and the following disclaimer.
+ * Redistributions in binary form must reproduce the above copyright notice,
+   this list of conditions and the following disclaimer in the documentation
+   and/or other materials provided with the distribution.
+ * Neither the name of the University of Oxford nor the names of its
+   contributors may be used to endorse or promote products derived from this
+   software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+*/
+#ifndef TESTCARDIACCELLBATCH_HPP_
+#define TESTCARDIACCELLBATCH_HPP_
+
+#include <cxxtest/TestSuite.h>
+
+#include <vector>
+
+#include "CardiacCellBatch.hpp"
+#include "LuoRudy1991.hpp"
+#include "LuoRudy1991Opt.hpp"
+#include "TenTusscher2006Epi.hpp"
+#include "LuoRudy1991BackwardEuler.hpp"
+#include "FitzHughNagumo1961OdeSystem.hpp"
+#include "FakeBathCell.hpp"
+#include "SimpleStimulus.hpp"
+#include "ZeroStimulus.hpp"
+#include "EulerIvpOdeSolver.hpp"
+#include "RungeKutta4IvpOdeSolver.hpp"
+
+//This test is always run sequentially (never in parallel)
+#include "FakePetscSetup.hpp"
+
+class TestCardiacCellBatch : public CxxTest::TestSuite
+{
+public:
+
+    void TestCanBatch() throw (Exception)
+    {
+        boost::shared_ptr<AbstractIvpOdeSolver> p_euler(new EulerIvpOdeSolver);
+        boost::shared_ptr<AbstractIvpOdeSolver> p_rk4(new RungeKutta4IvpOdeSolver);
+        boost::shared_ptr<AbstractStimulusFunction> p_stimulus(new ZeroStimulus);
+
+        CellLuoRudy1991FromCellML lr91_euler(p_euler, p_stimulus);
+        CellLuoRudy1991FromCellML lr91_rk4(p_rk4, p_stimulus);
+        CellLuoRudy1991FromCellMLBackwardEuler lr91_backward(p_euler, p_stimulus);
+        FakeBathCell bath_cell(p_euler, p_stimulus);
+        FitzHughNagumo1961OdeSystem fhn(p_euler, p_stimulus);
+
+        TS_ASSERT(CardiacCellBatch::CanBatch(&lr91_euler));
+        TS_ASSERT(!CardiacCellBatch::CanBatch(&lr91_rk4));
+        TS_ASSERT(!CardiacCellBatch::CanBatch(&lr91_backward));
+        TS_ASSERT(!CardiacCellBatch::CanBatch(&bath_cell));
+        // Hand-coded models have no batch kernels
+        TS_ASSERT(!fhn.HasBatchKernels());
+        TS_ASSERT(!CardiacCellBatch::CanBatch(&fhn));
+
+        CardiacCellBatch batch(&lr91_euler);
+        TS_ASSERT(!batch.IsCompatible(&fhn));
+
+        CellLuoRudy1991FromCellML other_lr91(p_euler, p_stimulus);
+        TS_ASSERT(batch.IsCompatible(&other_lr91));
+        batch.AddCell(&other_lr91);
+        TS_ASSERT(batch.AreCellsCompatible());
+        other_lr91.SetTimestep(lr91_euler.GetTimestep()/2.0);
+        TS_ASSERT(!batch.IsCompatible(&other_lr91));
+        TS_ASSERT(!batch.AreCellsCompatible());
+    }
+
+    void TestGeneratedBatchKernels() throw (Exception)
+    {
+        // Bundled models are generated with --batched, so have their own EvaluateYDerivativesBatch
+        boost::shared_ptr<AbstractIvpOdeSolver> p_solver(new EulerIvpOdeSolver);
+        boost::shared_ptr<AbstractStimulusFunction> p_stimulus(new SimpleStimulus(-80.0, 0.5));
+
+        // More cells than fit in one tile of the kernels' loops
+        const unsigned num_cells = 67;
+        for (unsigned model=0; model<3; model++)
+        {
+            std::vector<AbstractCardiacCell*> cells;
+            for (unsigned i=0; i<num_cells; i++)
+            {
+                switch (model)
+                {
+                    case 0:
+                        cells.push_back(new CellLuoRudy1991FromCellML(p_solver, p_stimulus));
+                        break;
+                    case 1:
+                        cells.push_back(new CellLuoRudy1991FromCellMLOpt(p_solver, p_stimulus));
+                        break;
+                    default:
+                        cells.push_back(new CellTenTusscher2006EpiFromCellML(p_solver, p_stimulus));
+                }
+                cells[i]->SetVoltage(-80.0 + 0.5*i);
+                // The whole block follows the first cell's setting
+                cells[i]->SetVoltageDerivativeToZero(model == 1);
+            }
+
+            TS_ASSERT(cells[0]->HasBatchKernels());
+            const unsigned num_vars = cells[0]->GetNumberOfStateVariables();
+            std::vector<double> state(num_vars*num_cells);
+            std::vector<double> derivs(num_vars*num_cells);
+            for (unsigned c=0; c<num_cells; c++)
+            {
+                for (unsigned i=0; i<num_vars; i++)
+                {
+                    state[i*num_cells + c] = cells[c]->rGetStateVariables()[i];
+                }
+            }
+            cells[0]->EvaluateYDerivativesBatch(0.1, cells, &state[0], &derivs[0]);
+            std::vector<double> i_ionic(num_cells);
+            cells[0]->GetIIonicBatch(cells, &state[0], &i_ionic[0]);
+
+            for (unsigned c=0; c<num_cells; c++)
+            {
+                std::vector<double> dy(num_vars);
+                cells[c]->EvaluateYDerivatives(0.1, cells[c]->rGetStateVariables(), dy);
+                for (unsigned i=0; i<num_vars; i++)
+                {
+                    TS_ASSERT_DELTA(derivs[i*num_cells + c], dy[i], 1e-12);
+                }
+                TS_ASSERT_DELTA(i_ionic[c], cells[c]->GetIIonic(), 1e-12);
+                delete cells[c];
+            }
+        }
+    }
+
+    void TestBatchMatchesIndividualSolves() throw (Exception)
+    {
+        boost::shared_ptr<AbstractIvpOdeSolver> p_solver(new EulerIvpOdeSolver);
+        boost::shared_ptr<AbstractStimulusFunction> p_stimulus(new SimpleStimulus(-80.0, 0.5));
+        boost::shared_ptr<AbstractStimulusFunction> p_zero_stimulus(new ZeroStimulus);
+
+        const unsigned num_cells = 7;
+        std::vector<AbstractCardiacCell*> batched_cells;
+        std::vector<AbstractCardiacCell*> individual_cells;
+        for (unsigned i=0; i<num_cells; i++)
+        {
+            boost::shared_ptr<AbstractStimulusFunction> p_stim = (i%2 == 0) ? p_stimulus : p_zero_stimulus;
+            batched_cells.push_back(new CellLuoRudy1991FromCellML(p_solver, p_stim));
+            individual_cells.push_back(new CellLuoRudy1991FromCellML(p_solver, p_stim));
+        }
+
+        CardiacCellBatch batch(batched_cells[0]);
+        for (unsigned i=1; i<num_cells; i++)
+        {
+            batch.AddCell(batched_cells[i]);
+        }
+        TS_ASSERT_EQUALS(batch.GetNumCells(), num_cells);
+        TS_ASSERT_EQUALS(batch.rGetCells().size(), num_cells);
+
+        // Mimic a tissue: the voltage is clamped over each PDE step and then moved on
+        const double pde_dt = 0.1;
+        for (unsigned step=0; step<20; step++)
+        {
+            double start = step*pde_dt;
+            for (unsigned i=0; i<num_cells; i++)
+            {
+                double voltage = -83.853 + 2.0*step + i;
+                batched_cells[i]->SetVoltage(voltage);
+                individual_cells[i]->SetVoltage(voltage);
+                individual_cells[i]->ComputeExceptVoltage(start, start+pde_dt);
+            }
+            batch.ComputeExceptVoltage(start, start+pde_dt);
+            TS_ASSERT(batch.IsStateResident());
+            for (unsigned i=0; i<num_cells; i++)
+            {
+                TS_ASSERT_DELTA(batch.GetIIonic(i), individual_cells[i]->GetIIonic(), 1e-12);
+            }
+
+            if (step == 10)
+            {
+                // Looking at the cells part way through; the next solve picks up from them
+                std::vector<double> resident = batch.GetStateVariables(3);
+                batch.ScatterStateVariables();
+                TS_ASSERT(!batch.IsStateResident());
+                std::vector<double> scattered = batch.GetStateVariables(3);
+                TS_ASSERT_EQUALS(resident.size(), scattered.size());
+                for (unsigned j=0; j<resident.size(); j++)
+                {
+                    TS_ASSERT_DELTA(resident[j], scattered[j], 1e-12);
+                }
+            }
+        }
+
+        batch.ScatterStateVariables();
+        for (unsigned i=0; i<num_cells; i++)
+        {
+            std::vector<double> batched = batched_cells[i]->GetStdVecStateVariables();
+            std::vector<double> individual = individual_cells[i]->GetStdVecStateVariables();
+            TS_ASSERT_EQUALS(batched.size(), individual.size());
+            for (unsigned j=0; j<batched.size(); j++)
+            {
+                TS_ASSERT_DELTA(batched[j], individual[j], 1e-12);
+            }
+            TS_ASSERT_DELTA(batched_cells[i]->GetIIonic(), individual_cells[i]->GetIIonic(), 1e-12);
+            TS_ASSERT_DELTA(batched_cells[i]->GetAnyVariable("cytosolic_calcium_concentration"),
+                            individual_cells[i]->GetAnyVariable("cytosolic_calcium_concentration"), 1e-12);
+
+            delete batched_cells[i];
+            delete individual_cells[i];
+        }
+    }
+};
+
+#endif /*TESTCARDIACCELLBATCH_HPP_*/
@@ -233,6 +233,53 @@ public:
         TS_ASSERT_THROWS_CONTAINS(be.GetIIonic(), "cytosolic_calcium_concentration outside lookup table range");
         be.SetStateVariable(cai_index, cai);
 
+        // Table usage statistics for a single cell's lookups
+        AbstractLookupTableCollection::EventHandler::ResetTableStatistics();
+        unsigned long scalar_lookups, batched_lookups, out_of_range;
+        p_tables->GetTableStatistics("membrane_voltage", scalar_lookups, batched_lookups, out_of_range);
+        TS_ASSERT_EQUALS(scalar_lookups + batched_lookups + out_of_range, 0u);
+        opt.GetIIonic();
+        p_tables->GetTableStatistics("membrane_voltage", scalar_lookups, batched_lookups, out_of_range);
+        TS_ASSERT_LESS_THAN(0u, scalar_lookups);
+        TS_ASSERT_EQUALS(batched_lookups, 0u);
+        TS_ASSERT_EQUALS(out_of_range, 0u);
+        const unsigned long single_cell_lookups = scalar_lookups;
+
+        // Batched lookups
+        unsigned v_key = p_tables->GetKeyingVariableIndex("membrane_voltage");
+        TS_ASSERT_EQUALS(v_key, 0u);
+        const unsigned num_v_tables = p_tables->GetNumberOfTables("membrane_voltage");
+        std::vector<double> keys(3, -80.0);
+        keys[2] = 10.0;
+        std::vector<double> rows(keys.size()*num_v_tables);
+        p_tables->IndexTablesBatch(v_key, &keys[0], keys.size(), &rows[0]);
+        bool values_differ = false;
+        for (unsigned j=0; j<num_v_tables; j++)
+        {
+            // The values of each table are contiguous
+            TS_ASSERT_EQUALS(rows[j*keys.size()], rows[j*keys.size()+1]);
+            values_differ = values_differ || (rows[j*keys.size()] != rows[j*keys.size()+2]);
+        }
+        TS_ASSERT(values_differ);
+        p_tables->GetTableStatistics("membrane_voltage", scalar_lookups, batched_lookups, out_of_range);
+        TS_ASSERT_EQUALS(scalar_lookups, single_cell_lookups);
+        TS_ASSERT_EQUALS(batched_lookups, 3u);
+        TS_ASSERT_EQUALS(out_of_range, 0u);
+
+        // All keys are checked before any are looked up
+        keys[1] = -100000;
+        TS_ASSERT_THROWS_CONTAINS(p_tables->IndexTablesBatch(v_key, &keys[0], keys.size(), &rows[0]),
+                                  "membrane_voltage outside lookup table range at entry 1 of batch");
+        TS_ASSERT_THROWS_THIS(p_tables->IndexTablesBatch(2u, &keys[0], keys.size(), &rows[0]),
+                              "Lookup table keying variable index 2 does not exist.");
+        p_tables->GetTableStatistics("membrane_voltage", scalar_lookups, batched_lookups, out_of_range);
+        TS_ASSERT_EQUALS(batched_lookups, 3u);
+        TS_ASSERT_EQUALS(out_of_range, 1u);
+        AbstractLookupTableCollection::EventHandler::ReportTableStatistics();
+        p_tables->ResetTableStatistics();
+        p_tables->GetTableStatistics("membrane_voltage", scalar_lookups, batched_lookups, out_of_range);
+        TS_ASSERT_EQUALS(scalar_lookups + batched_lookups + out_of_range, 0u);
+
         // Single parameter
         CheckParameter(normal);
         CheckParameter(opt);
@@ -1609,6 +1609,32 @@ public:
                                                 2e-4));
     }
 
+    void TestMonodomainProblemWithMatrixFreeRhs() throw (Exception)
+    {
+        HeartConfig::Instance()->SetOdePdeAndPrintingTimeSteps(0.01, 0.01, 0.01);
+        HeartConfig::Instance()->SetSimulationDuration(1.0);
+        HeartConfig::Instance()->SetMeshFileName("mesh/test/data/1D_0_to_1mm_10_elements");
+        HeartConfig::Instance()->SetOutputFilenamePrefix("MonodomainLR91_1d_matrix_free_rhs");
+
+        // Solve with the assembled mass matrix, then matrix-free
+        for (unsigned run=0; run<2; run++)
+        {
+            HeartConfig::Instance()->SetOutputDirectory(run==0 ? "MonodomainWithAssembledRhs" : "MonodomainWithMatrixFreeRhs");
+            HeartConfig::Instance()->SetUseMatrixFreeRhs(run==1);
+
+            PlaneStimulusCellFactory<CellLuoRudy1991FromCellML, 1> cell_factory;
+            MonodomainProblem<1> monodomain_problem( &cell_factory );
+
+            monodomain_problem.Initialise();
+            monodomain_problem.Solve();
+        }
+
+        // The two only differ in the order the RHS contributions are summed
+        TS_ASSERT(CompareFilesViaHdf5DataReader("MonodomainWithMatrixFreeRhs", "MonodomainLR91_1d_matrix_free_rhs", true,
+                                                "MonodomainWithAssembledRhs", "MonodomainLR91_1d_matrix_free_rhs", true,
+                                                1e-6));
+    }
+
     void TestMonodomainProblemWithWriterCacheIncomplete() throw (Exception)
     {
         HeartConfig::Instance()->SetMeshFileName("mesh/test/data/1D_0_to_1mm_10_elements");
@@ -47,6 +47,7 @@ OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "SimpleStimulus.hpp"
 #include "EulerIvpOdeSolver.hpp"
 #include "LuoRudy1991.hpp"
+#include "LuoRudy1991Opt.hpp"
 #include "MonodomainTissue.hpp"
 #include "OdeSolution.hpp"
 #include "AbstractCardiacCellFactory.hpp"
@@ -59,6 +60,7 @@ OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "ArchiveOpener.hpp"
 #include "DiFrancescoNoble1985.hpp"
 #include "MonodomainProblem.hpp"
+#include "HeartEventHandler.hpp"
 
 #include "PetscSetupAndFinalize.hpp"
 
@@ -236,6 +238,152 @@ public:
         PetscTools::Destroy(voltage);
     }
 
+    void TestMonodomainTissueWithBatchedCellSolves() throw(Exception)
+    {
+        HeartConfig::Instance()->Reset();
+        TetrahedralMesh<1,1> mesh;
+        mesh.ConstructRegularSlabMesh(0.1, 1.0); // 11 nodes
+
+        MyCardiacCellFactory cell_factory;
+        cell_factory.SetMesh(&mesh);
+        MonodomainTissue<1> unbatched_tissue( &cell_factory );
+        MonodomainTissue<1> batched_tissue( &cell_factory );
+
+        // The setting is read at solve time
+        Vec voltage = PetscTools::CreateAndSetVec(mesh.GetNumNodes(), -83.853);
+        for (unsigned step=0; step<4; step++)
+        {
+            HeartConfig::Instance()->SetUseBatchedCellSolves(false);
+            unbatched_tissue.SolveCellSystems(voltage, 0.5*step, 0.5*(step+1));
+            HeartConfig::Instance()->SetUseBatchedCellSolves(true);
+            batched_tissue.SolveCellSystems(voltage, 0.5*step, 0.5*(step+1));
+        }
+
+        for (unsigned i=0; i<mesh.GetNumNodes(); i++)
+        {
+            TS_ASSERT_DELTA(batched_tissue.rGetIionicCacheReplicated()[i], unbatched_tissue.rGetIionicCacheReplicated()[i], 1e-12);
+            TS_ASSERT_DELTA(batched_tissue.rGetIntracellularStimulusCacheReplicated()[i],
+                            unbatched_tissue.rGetIntracellularStimulusCacheReplicated()[i], 1e-12);
+        }
+
+        PetscTools::Destroy(voltage);
+        HeartConfig::Instance()->Reset();
+    }
+
+    void TestMonodomainTissueWithThreadedCellSolves() throw(Exception)
+    {
+        HeartConfig::Instance()->Reset();
+        TS_ASSERT_EQUALS(HeartConfig::Instance()->GetNumberOfCellSolveThreads(), 1u);
+        TS_ASSERT_THROWS_THIS(HeartConfig::Instance()->SetNumberOfCellSolveThreads(0u),
+                              "The number of cell solve threads must be at least 1.");
+
+        TetrahedralMesh<1,1> mesh;
+        mesh.ConstructRegularSlabMesh(0.1, 1.0); // 11 nodes
+
+        MyCardiacCellFactory cell_factory;
+        cell_factory.SetMesh(&mesh);
+        MonodomainTissue<1> serial_tissue( &cell_factory );
+        MonodomainTissue<1> threaded_tissue( &cell_factory );
+        MonodomainTissue<1> threaded_batched_tissue( &cell_factory );
+
+        // The settings are read at solve time
+        Vec voltage = PetscTools::CreateAndSetVec(mesh.GetNumNodes(), -83.853);
+        for (unsigned step=0; step<4; step++)
+        {
+            HeartConfig::Instance()->SetNumberOfCellSolveThreads(1u);
+            serial_tissue.SolveCellSystems(voltage, 0.5*step, 0.5*(step+1));
+            HeartConfig::Instance()->SetNumberOfCellSolveThreads(2u);
+            threaded_tissue.SolveCellSystems(voltage, 0.5*step, 0.5*(step+1));
+            HeartConfig::Instance()->SetUseBatchedCellSolves(true);
+            threaded_batched_tissue.SolveCellSystems(voltage, 0.5*step, 0.5*(step+1));
+            HeartConfig::Instance()->SetUseBatchedCellSolves(false);
+        }
+
+        // Each cell sees exactly the same arithmetic however many threads there are
+        for (unsigned i=0; i<mesh.GetNumNodes(); i++)
+        {
+            TS_ASSERT_EQUALS(threaded_tissue.rGetIionicCacheReplicated()[i], serial_tissue.rGetIionicCacheReplicated()[i]);
+            TS_ASSERT_DELTA(threaded_batched_tissue.rGetIionicCacheReplicated()[i], serial_tissue.rGetIionicCacheReplicated()[i], 1e-12);
+        }
+
+        // Cells using lookup tables interpolate table rows into their own memory, so may share the tables between threads
+        PlaneStimulusCellFactory<CellLuoRudy1991FromCellMLOpt, 1> opt_cell_factory;
+        opt_cell_factory.SetMesh(&mesh);
+        MonodomainTissue<1> serial_opt_tissue( &opt_cell_factory );
+        MonodomainTissue<1> threaded_opt_tissue( &opt_cell_factory );
+        for (unsigned step=0; step<4; step++)
+        {
+            HeartConfig::Instance()->SetNumberOfCellSolveThreads(1u);
+            serial_opt_tissue.SolveCellSystems(voltage, 0.5*step, 0.5*(step+1));
+            HeartConfig::Instance()->SetNumberOfCellSolveThreads(2u);
+            threaded_opt_tissue.SolveCellSystems(voltage, 0.5*step, 0.5*(step+1));
+        }
+        for (unsigned i=0; i<mesh.GetNumNodes(); i++)
+        {
+            TS_ASSERT_EQUALS(threaded_opt_tissue.rGetIionicCacheReplicated()[i], serial_opt_tissue.rGetIionicCacheReplicated()[i]);
+        }
+
+        PetscTools::Destroy(voltage);
+        HeartConfig::Instance()->Reset();
+    }
+
+    void TestMonodomainTissueWithAdaptiveCellSolves() throw(Exception)
+    {
+        HeartConfig::Instance()->Reset();
+        TetrahedralMesh<1,1> mesh;
+        mesh.ConstructRegularSlabMesh(0.1, 1.0); // 11 nodes
+        const unsigned num_local_nodes = mesh.GetDistributedVectorFactory()->GetLocalOwnership();
+        const bool own_stimulated_node = mesh.GetDistributedVectorFactory()->IsGlobalIndexLocal(0);
+
+        MyCardiacCellFactory cell_factory; // Node 0 is stimulated for the first 0.5ms
+        cell_factory.SetMesh(&mesh);
+        MonodomainTissue<1> full_tissue( &cell_factory );
+        MonodomainTissue<1> adaptive_tissue( &cell_factory );
+
+        // Generous thresholds, so that the unstimulated cells (held at rest) are soon quiescent
+        HeartConfig::Instance()->SetAdaptiveCellSolveParameters(1.0, 1.0, 0.5);
+        HeartEventHandler::ResetActiveCellCounts();
+
+        // The settings are read at solve time
+        Vec voltage = PetscTools::CreateAndSetVec(mesh.GetNumNodes(), -83.853);
+        for (unsigned step=0; step<10; step++)
+        {
+            HeartConfig::Instance()->SetUseAdaptiveCellSolves(false);
+            full_tissue.SolveCellSystems(voltage, 0.1*step, 0.1*(step+1));
+            HeartConfig::Instance()->SetUseAdaptiveCellSolves(true);
+            unsigned num_steps_recorded = HeartEventHandler::GetNumStepsRecorded();
+            adaptive_tissue.SolveCellSystems(voltage, 0.1*step, 0.1*(step+1));
+            TS_ASSERT_EQUALS(HeartEventHandler::GetNumStepsRecorded(), num_steps_recorded + 1);
+
+            if (step == 0)
+            {
+                // All cells start off active
+                TS_ASSERT_EQUALS(HeartEventHandler::GetNumActiveCellsLastStep(), num_local_nodes);
+            }
+            else if (step >= 2 && step < 5 && own_stimulated_node && num_local_nodes > 1u)
+            {
+                // The stimulated cell is always solved, but the others are quiescent after their
+                // first two solves (which give a voltage history)
+                TS_ASSERT_LESS_THAN_EQUALS(1u, HeartEventHandler::GetNumActiveCellsLastStep());
+                TS_ASSERT_LESS_THAN(HeartEventHandler::GetNumActiveCellsLastStep(), num_local_nodes);
+            }
+        }
+        HeartEventHandler::ReportActiveCells();
+
+        // Quiescent cells are only approximated
+        for (unsigned i=0; i<mesh.GetNumNodes(); i++)
+        {
+            TS_ASSERT_DELTA(adaptive_tissue.rGetIionicCacheReplicated()[i], full_tissue.rGetIionicCacheReplicated()[i], 0.1);
+        }
+
+        // Operator splitting always solves every cell
+        adaptive_tissue.SolveCellSystems(voltage, 1.0, 1.1, true);
+        TS_ASSERT_EQUALS(HeartEventHandler::GetNumActiveCellsLastStep(), num_local_nodes);
+
+        PetscTools::Destroy(voltage);
+        HeartConfig::Instance()->Reset();
+    }
+
     void TestMonodomainTissueGetCardiacCell() throw(Exception)
     {
         if (PetscTools::GetNumProcs() > 2u)
@@ -0,0 +1,131 @@
+/*
+
+Copyright (c) 2005-2017, University of Oxford.
+All rights reserved.
+
+University of Oxford means the Chancellor, Masters and Scholars of the
+University of Oxford, having an administrative office at Wellington
+Square, Oxford OX1 2JD, UK.
+
+This file is part of Chaste.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+ * Redistributions of source code must retain the above copyright notice,
+   this list of conditions and the following disclaimer.
+ * Redistributions in binary form must reproduce the above copyright notice,
+   this list of conditions and the following disclaimer in the documentation
+   and/or other materials provided with the distribution.
+ * Neither the name of the University of Oxford nor the names of its
+   contributors may be used to endorse or promote products derived from this
+   software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+*/
+
+#ifndef TESTPERFORMANCEOFMATRIXFREERHS_HPP_
+#define TESTPERFORMANCEOFMATRIXFREERHS_HPP_
+
+#include <cxxtest/TestSuite.h>
+#include <sstream>
+
+#include "DistributedTetrahedralMesh.hpp"
+#include "MassMatrixAssembler.hpp"
+#include "MatrixFreeMassMatrixOperator.hpp"
+#include "PetscMatTools.hpp"
+#include "PetscVecTools.hpp"
+#include "Timer.hpp"
+#include "PetscSetupAndFinalize.hpp"
+
+/**
+ * Compare the cost of computing the RHS mass matrix product b = M z, as done in
+ * MonodomainSolver and BidomainSolver each time step, by multiplying by an assembled
+ * mass matrix and with a MatrixFreeMassMatrixOperator.
+ */
+class TestPerformanceOfMatrixFreeRhs : public CxxTest::TestSuite
+{
+public:
+
+    void TestMassMatrixProducts() throw(Exception)
+    {
+        const unsigned num_products = 100;
+
+        for (unsigned refinement=0; refinement<3; refinement++)
+        {
+            double h = 0.02/(1 << refinement);
+            DistributedTetrahedralMesh<3,3> mesh;
+            mesh.ConstructRegularSlabMesh(h, 0.2, 0.2, 0.2);
+            unsigned num_nodes = mesh.GetNumNodes();
+
+            Vec z = mesh.GetDistributedVectorFactory()->CreateVec();
+            PetscVecTools::Zero(z);
+            for (unsigned i=mesh.GetDistributedVectorFactory()->GetLow(); i<mesh.GetDistributedVectorFactory()->GetHigh(); i++)
+            {
+                PetscVecTools::SetElement(z, i, mesh.GetNode(i)->rGetLocation()[0]);
+            }
+            PetscVecTools::Finalise(z);
+            Vec b_assembled = mesh.GetDistributedVectorFactory()->CreateVec();
+            Vec b_matrix_free = mesh.GetDistributedVectorFactory()->CreateVec();
+
+            std::stringstream heading;
+            heading << "Mesh with " << num_nodes << " nodes and " << mesh.GetNumElements() << " elements, "
+                    << num_products << " products: ";
+
+            // Assembled: set-up is done once, then there is one MatMult per time step
+            Timer::Reset();
+            Mat mass_matrix;
+            PetscInt local_size = mesh.GetDistributedVectorFactory()->GetLocalOwnership();
+            PetscTools::SetupMat(mass_matrix, num_nodes, num_nodes,
+                                 mesh.CalculateMaximumNodeConnectivityPerProcess(), local_size, local_size);
+            MassMatrixAssembler<3,3> assembler(&mesh);
+            assembler.SetMatrixToAssemble(mass_matrix);
+            assembler.Assemble();
+            PetscMatTools::Finalise(mass_matrix);
+            Timer::PrintAndReset(heading.str() + "assembling mass matrix");
+            for (unsigned i=0; i<num_products; i++)
+            {
+                MatMult(mass_matrix, z, b_assembled);
+            }
+            Timer::PrintAndReset(heading.str() + "MatMult");
+
+            // Matrix-free: set-up gathers the element data once, then there is one Apply per time step
+            MatrixFreeMassMatrixOperator<3,3> mass_operator(&mesh);
+            mass_operator.SetUp();
+            Timer::PrintAndReset(heading.str() + "setting up matrix-free operator");
+            for (unsigned i=0; i<num_products; i++)
+            {
+                mass_operator.Apply(z, b_matrix_free);
+                PetscVecTools::Finalise(b_matrix_free);
+            }
+            Timer::PrintAndReset(heading.str() + "matrix-free products");
+
+            MatInfo info;
+            MatGetInfo(mass_matrix, MAT_GLOBAL_SUM, &info);
+            std::cout << heading.str() << "mass matrix uses " << info.memory << " bytes, operator uses "
+                      << mass_operator.GetMemoryUsage() << " bytes\n";
+
+            // Check the two agree
+            for (unsigned i=mesh.GetDistributedVectorFactory()->GetLow(); i<mesh.GetDistributedVectorFactory()->GetHigh(); i++)
+            {
+                TS_ASSERT_DELTA(PetscVecTools::GetElement(b_matrix_free, i), PetscVecTools::GetElement(b_assembled, i), 1e-12);
+            }
+
+            PetscTools::Destroy(mass_matrix);
+            PetscTools::Destroy(z);
+            PetscTools::Destroy(b_assembled);
+            PetscTools::Destroy(b_matrix_free);
+        }
+    }
+};
+
+#endif /*TESTPERFORMANCEOFMATRIXFREERHS_HPP_*/
@@ -47,7 +47,8 @@ Hdf5DataReader::Hdf5DataReader(const std::string& rDirectory,
                                std::string datasetName)
     : AbstractHdf5Access(rDirectory, rBaseName, datasetName, makeAbsolute),
       mNumberTimesteps(1),
-      mClosed(false)
+      mClosed(false),
+      mQuantisationTolerance(0.0)
 {
     CommonConstructor();
 }
@@ -57,7 +58,8 @@ Hdf5DataReader::Hdf5DataReader(const FileFinder& rDirectory,
                                std::string datasetName)
     : AbstractHdf5Access(rDirectory, rBaseName, datasetName),
       mNumberTimesteps(1),
-      mClosed(false)
+      mClosed(false),
+      mQuantisationTolerance(0.0)
 {
     CommonConstructor();
 }
@@ -168,6 +170,14 @@ void Hdf5DataReader::CommonConstructor()
     // Free allocated memory
     free(string_array);
 
+    // Find out if the data were rounded when written
+    if (H5Aexists(mVariablesDatasetId, "QuantisationTolerance") > 0)
+    {
+        attribute_id = H5Aopen_name(mVariablesDatasetId, "QuantisationTolerance");
+        H5Aread(attribute_id, H5T_NATIVE_DOUBLE, &mQuantisationTolerance);
+        H5Aclose(attribute_id);
+    }
+
     // Find out if it's incomplete data
     H5E_BEGIN_TRY //Supress HDF5 error if the IsDataComplete name isn't there
     {
@@ -420,6 +430,19 @@ std::vector<double> Hdf5DataReader::GetUnlimitedDimensionValues()
     return ret;
 }
 
+double Hdf5DataReader::GetQuantisationTolerance()
+{
+    return mQuantisationTolerance;
+}
+
+unsigned Hdf5DataReader::GetDataPrecision()
+{
+    hid_t data_type = H5Dget_type(mVariablesDatasetId);
+    unsigned precision = H5Tget_size(data_type);
+    H5Tclose(data_type);
+    return precision;
+}
+
 void Hdf5DataReader::Close()
 {
     if (!mClosed)
@@ -61,6 +61,8 @@ private:
 
     bool mClosed;                                           /**< Whether we've already closed the file. */
 
+    double mQuantisationTolerance;                          /**< Absolute tolerance to which the data were rounded when written (0 if not rounded). */
+
     /**
      * Contains functionality common to both constructors.
      */
@@ -127,6 +129,21 @@ public:
      */
     std::vector<double> GetUnlimitedDimensionValues();
 
+    /**
+     * Data stored as floats or compressed (see Hdf5DataWriter::SetStoreAsFloat and
+     * Hdf5DataWriter::SetCompressionLevel) are read back as doubles transparently, but
+     * data rounded by Hdf5DataWriter::SetQuantisationTolerance cannot be recovered exactly.
+     *
+     * @return the absolute tolerance to which the data were rounded when written (0 if they were not).
+     */
+    double GetQuantisationTolerance();
+
+    /**
+     * @return the number of bytes used to store each value in the file
+     * (8 for doubles, 4 if Hdf5DataWriter::SetStoreAsFloat was used).
+     */
+    unsigned GetDataPrecision();
+
     /**
      * @return the number of rows in the data file.
      */
@@ -37,6 +37,8 @@ OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
  * Implementation file for Hdf5DataWriter class.
  *
  */
+#include <algorithm>
+#include <cmath>
 #include <set>
 #include <cstring> //For strcmp etc. Needed in gcc-4.4
 #include <boost/scoped_array.hpp>
@@ -48,6 +50,7 @@ OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "PetscTools.hpp"
 #include "Version.hpp"
 #include "MathsCustomFunctions.hpp"
+#include "Warnings.hpp"
 
 Hdf5DataWriter::Hdf5DataWriter(DistributedVectorFactory& rVectorFactory,
                                const std::string& rDirectory,
@@ -81,7 +84,11 @@ Hdf5DataWriter::Hdf5DataWriter(DistributedVectorFactory& rVectorFactory,
       mChunkTargetSize(0x20000), // 128 K
       mAlignment(0), // No alignment
       mUseCache(useCache),
-      mCacheFirstTimeStep(0u)
+      mCacheFirstTimeStep(0u),
+      mCacheInterval(0u),
+      mStoreAsFloat(false),
+      mCompressionLevel(0u),
+      mQuantisationTolerance(0.0)
 {
     mChunkSize[0] = 0;
     mChunkSize[1] = 0;
@@ -214,6 +221,14 @@ Hdf5DataWriter::Hdf5DataWriter(DistributedVectorFactory& rVectorFactory,
                 H5Sclose(attribute_space);
                 H5Aclose(attribute_id);
             }
+
+            // Keep rounding data as before, if the file says so
+            if (H5Aexists(mVariablesDatasetId, "QuantisationTolerance") > 0)
+            {
+                attribute_id = H5Aopen_name(mVariablesDatasetId, "QuantisationTolerance");
+                H5Aread(attribute_id, H5T_NATIVE_DOUBLE, &mQuantisationTolerance);
+                H5Aclose(attribute_id);
+            }
             if (mIsDataComplete)
             {
                 mNumberOwned = mrVectorFactory.GetLocalOwnership();
@@ -258,8 +273,7 @@ Hdf5DataWriter::Hdf5DataWriter(DistributedVectorFactory& rVectorFactory,
             H5Pget_chunk(dcpl, DATASET_DIMS, mChunkSize );
             if (mUseCache)
             {
-                // Reserve space. Enough for one chunk in the time dimension.
-                mDataCache.reserve(mChunkSize[0]*mNumberOwned*mDatasetDims[2]);
+                ReserveCache();
             }
 
             // Done
@@ -612,15 +626,33 @@ void Hdf5DataWriter::EndDefineMode()
 
     if (mUseCache)
     {
-        // Reserve space. Enough for one chunk in the time dimension.
-        mDataCache.reserve(mChunkSize[0]*mNumberOwned*mDatasetDims[2]);
+        ReserveCache();
     }
 
     // Create chunked dataset and clean up
     hid_t cparms = H5Pcreate (H5P_DATASET_CREATE);
     H5Pset_chunk( cparms, DATASET_DIMS, mChunkSize);
+    if (mCompressionLevel > 0)
+    {
+        bool can_compress = (H5Zfilter_avail(H5Z_FILTER_DEFLATE) > 0);
+#if H5_VERS_MAJOR==1 && (H5_VERS_MINOR<10 || (H5_VERS_MINOR==10 && H5_VERS_RELEASE<2)) // Before HDF5 1.10.2
+        // Filters can only be used with parallel writes from HDF5 1.10.2
+        can_compress = can_compress && PetscTools::IsSequential();
+#endif
+        if (can_compress)
+        {
+            // Shuffling the bytes of each value first puts similar bytes together, which helps deflate
+            H5Pset_shuffle(cparms);
+            H5Pset_deflate(cparms, mCompressionLevel);
+        }
+        else
+        {
+            WARNING("This HDF5 library cannot compress data written by this run, so it will be written uncompressed.");
+        }
+    }
+    hid_t file_type = mStoreAsFloat ? H5T_NATIVE_FLOAT : H5T_NATIVE_DOUBLE;
     hid_t filespace = H5Screate_simple(DATASET_DIMS, mDatasetDims, dataset_max_dims);
-    mVariablesDatasetId = H5Dcreate(mFileId, mDatasetName.c_str(), H5T_NATIVE_DOUBLE, filespace,
+    mVariablesDatasetId = H5Dcreate(mFileId, mDatasetName.c_str(), file_type, filespace,
                                     H5P_DEFAULT, cparms, H5P_DEFAULT);
     SetMainDatasetRawChunkCache(); // Set large cache (even though parallel drivers don't currently use it!)
     H5Sclose(filespace);
@@ -685,6 +717,18 @@ void Hdf5DataWriter::EndDefineMode()
         H5Aclose(attr);
     }
 
+    if (mQuantisationTolerance > 0.0)
+    {
+        // Record the tolerance to which the data have been rounded
+        columns[0] = 1;
+        colspace = H5Screate_simple(1, columns, NULL);
+        attr = H5Acreate(mVariablesDatasetId, "QuantisationTolerance", H5T_NATIVE_DOUBLE, colspace,
+                         H5P_DEFAULT, H5P_DEFAULT);
+        H5Awrite(attr, H5T_NATIVE_DOUBLE, &mQuantisationTolerance);
+        H5Sclose(colspace);
+        H5Aclose(attr);
+    }
+
     /*
      * Create "Time" dataset
      */
@@ -784,18 +828,10 @@ void Hdf5DataWriter::PutVector(int variableID, Vec petscVector)
         EXCEPTION("Vector size doesn't match fixed dimension");
     }
 
-    if (mUseCache)
+    if (mUseCache && !mIsUnlimitedDimensionSet)
     {
-        if (mDatasetDims[2] != 1 )
-        {
-            //Covered by TestHdf5DataWriterMultipleColumnsCachedFails
-            EXCEPTION("Cached writes must write all variables at once.");
-        }
-        if (!mIsUnlimitedDimensionSet)
-        {
-            //Covered by TestHdf5DataWriterSingleColumnsCachedFails
-            EXCEPTION("Cached writes require an unlimited dimension.");
-        }
+        //Covered by TestHdf5DataWriterSingleColumnsCachedFails
+        EXCEPTION("Cached writes require an unlimited dimension.");
     }
 
     // Make sure that everything is actually extended to the correct dimension.
@@ -850,11 +886,11 @@ void Hdf5DataWriter::PutVector(int variableID, Vec petscVector)
         if (mUseCache)
         {
             //Covered by TestHdf5DataWriterSingleColumnCached
-            mDataCache.insert(mDataCache.end(), p_petsc_vector, p_petsc_vector+mNumberOwned);
+            CacheVariablesData(p_petsc_vector, variableID, 1);
         }
         else
         {
-            H5Dwrite(mVariablesDatasetId, H5T_NATIVE_DOUBLE, memspace, hyperslab_space, property_list_id, p_petsc_vector);
+            WriteVariablesData(memspace, hyperslab_space, property_list_id, p_petsc_vector, mNumberOwned);
         }
     }
     else
@@ -873,11 +909,11 @@ void Hdf5DataWriter::PutVector(int variableID, Vec petscVector)
             if (mUseCache)
             {
                 //Covered by TestHdf5DataWriterSingleIncompleteUsingMatrixCached
-                mDataCache.insert(mDataCache.end(), p_petsc_vector_incomplete, p_petsc_vector_incomplete+mNumberOwned);
+                CacheVariablesData(p_petsc_vector_incomplete, variableID, 1);
             }
             else
             {
-                H5Dwrite(mVariablesDatasetId, H5T_NATIVE_DOUBLE, memspace, hyperslab_space, property_list_id, p_petsc_vector_incomplete);
+                WriteVariablesData(memspace, hyperslab_space, property_list_id, p_petsc_vector_incomplete, mNumberOwned);
             }
         }
         else
@@ -892,11 +928,11 @@ void Hdf5DataWriter::PutVector(int variableID, Vec petscVector)
             if (mUseCache)
             {
                 //Covered by TestHdf5DataWriterFullFormatIncompleteCached
-                mDataCache.insert(mDataCache.end(), local_data.get(), local_data.get()+mNumberOwned);
+                CacheVariablesData(local_data.get(), variableID, 1);
             }
             else
             {
-                H5Dwrite(mVariablesDatasetId, H5T_NATIVE_DOUBLE, memspace, hyperslab_space, property_list_id, local_data.get());
+                WriteVariablesData(memspace, hyperslab_space, property_list_id, local_data.get(), mNumberOwned);
             }
         }
     }
@@ -928,18 +964,10 @@ void Hdf5DataWriter::PutStripedVector(std::vector<int> variableIDs, Vec petscVec
 
     const unsigned NUM_STRIPES=variableIDs.size();
 
-    if (mUseCache)
+    if (mUseCache && !mIsUnlimitedDimensionSet)
     {
-        if (NUM_STRIPES != mDatasetDims[2])
-        {
-            //Covered by TestHdf5DataWriterFullFormatStripedIncompleteCached
-            EXCEPTION("Cached writes must write all variables at once.");
-        }
-        if (!mIsUnlimitedDimensionSet)
-        {
-            //Covered by TestHdf5DataWriterStripedNoTimeCachedFails
-            EXCEPTION("Cached writes require an unlimited dimension.");
-        }
+        //Covered by TestHdf5DataWriterStripedNoTimeCachedFails
+        EXCEPTION("Cached writes require an unlimited dimension.");
     }
 
     int firstVariableID=variableIDs[0];
@@ -1014,11 +1042,11 @@ void Hdf5DataWriter::PutStripedVector(std::vector<int> variableIDs, Vec petscVec
         if (mUseCache)
         {
             // Covered by TestHdf5DataWriterStripedCached
-            mDataCache.insert(mDataCache.end(), p_petsc_vector, p_petsc_vector+mNumberOwned*NUM_STRIPES);
+            CacheVariablesData(p_petsc_vector, firstVariableID, NUM_STRIPES);
         }
         else
         {
-            H5Dwrite(mVariablesDatasetId, H5T_NATIVE_DOUBLE, memspace, hyperslab_space, property_list_id, p_petsc_vector);
+            WriteVariablesData(memspace, hyperslab_space, property_list_id, p_petsc_vector, mNumberOwned*NUM_STRIPES);
         }
     }
     else
@@ -1039,11 +1067,11 @@ void Hdf5DataWriter::PutStripedVector(std::vector<int> variableIDs, Vec petscVec
                 if (mUseCache)
                 {
                     //Covered by TestHdf5DataWriterFullFormatStripedIncompleteUsingMatrixCached
-                    mDataCache.insert(mDataCache.end(), p_petsc_vector_incomplete, p_petsc_vector_incomplete+2*mNumberOwned);
+                    CacheVariablesData(p_petsc_vector_incomplete, firstVariableID, 2);
                 }
                 else
                 {
-                    H5Dwrite(mVariablesDatasetId, H5T_NATIVE_DOUBLE, memspace, hyperslab_space, property_list_id, p_petsc_vector_incomplete);
+                    WriteVariablesData(memspace, hyperslab_space, property_list_id, p_petsc_vector_incomplete, 2*mNumberOwned);
                 }
             }
             else
@@ -1060,11 +1088,11 @@ void Hdf5DataWriter::PutStripedVector(std::vector<int> variableIDs, Vec petscVec
                 if (mUseCache)
                 {
                     //Covered by TestHdf5DataWriterFullFormatStripedIncompleteCached
-                    mDataCache.insert(mDataCache.end(), local_data.get(), local_data.get()+2*mNumberOwned);
+                    CacheVariablesData(local_data.get(), firstVariableID, 2);
                 }
                 else
                 {
-                    H5Dwrite(mVariablesDatasetId, H5T_NATIVE_DOUBLE, memspace, hyperslab_space, property_list_id, local_data.get());
+                    WriteVariablesData(memspace, hyperslab_space, property_list_id, local_data.get(), 2*mNumberOwned);
                 }
             }
         }
@@ -1111,15 +1139,34 @@ void Hdf5DataWriter::WriteCache()
     hid_t memspace, hyperslab_space;
     if (mNumberOwned != 0)
     {
-        hsize_t v_size[1] = {mDataCache.size()};
-        memspace = H5Screate_simple(1, v_size, NULL);
-
-        hsize_t start[DATASET_DIMS] = {mCacheFirstTimeStep, mOffset, 0};
         hsize_t count[DATASET_DIMS] = {mCurrentTimeStep-mCacheFirstTimeStep, mNumberOwned, mDatasetDims[2]};
         assert((mCurrentTimeStep-mCacheFirstTimeStep)*mNumberOwned*mDatasetDims[2] == mDataCache.size()); // Got size right?
-
+        memspace = H5Screate_simple(DATASET_DIMS, count, NULL);
         hyperslab_space = H5Dget_space(mVariablesDatasetId);
-        H5Sselect_hyperslab(hyperslab_space, H5S_SELECT_SET, start, NULL, count, NULL);
+
+        if (std::find(mCachedVariables.begin(), mCachedVariables.end(), false) == mCachedVariables.end())
+        {
+            // Every variable was written, so write the whole block
+            hsize_t start[DATASET_DIMS] = {mCacheFirstTimeStep, mOffset, 0};
+            H5Sselect_hyperslab(hyperslab_space, H5S_SELECT_SET, start, NULL, count, NULL);
+        }
+        else
+        {
+            // Only write the columns of the variables that were written, leaving the others in the file alone
+            H5Sselect_none(memspace);
+            H5Sselect_none(hyperslab_space);
+            count[2] = 1;
+            for (unsigned var=0; var<mCachedVariables.size(); var++)
+            {
+                if (mCachedVariables[var])
+                {
+                    hsize_t cache_start[DATASET_DIMS] = {0, 0, var};
+                    hsize_t start[DATASET_DIMS] = {mCacheFirstTimeStep, mOffset, var};
+                    H5Sselect_hyperslab(memspace, H5S_SELECT_OR, cache_start, NULL, count, NULL);
+                    H5Sselect_hyperslab(hyperslab_space, H5S_SELECT_OR, start, NULL, count, NULL);
+                }
+            }
+        }
     }
     else
     {
@@ -1132,7 +1179,7 @@ void Hdf5DataWriter::WriteCache()
     H5Pset_dxpl_mpio(property_list_id, H5FD_MPIO_COLLECTIVE);
 
     // Write!
-    H5Dwrite(mVariablesDatasetId, H5T_NATIVE_DOUBLE, memspace, hyperslab_space, property_list_id, &mDataCache[0]);
+    WriteVariablesData(memspace, hyperslab_space, property_list_id, &mDataCache[0], mDataCache.size());
 
     // Tidy up
     H5Sclose(memspace);
@@ -1141,6 +1188,129 @@ void Hdf5DataWriter::WriteCache()
 
     mCacheFirstTimeStep = mCurrentTimeStep; // Update where we got to
     mDataCache.clear(); // Clear out cache
+    mCachedVariables.clear();
+}
+
+void Hdf5DataWriter::CacheVariablesData(const double* pData, unsigned firstVariableId, unsigned numVariables)
+{
+    assert(mCurrentTimeStep >= mCacheFirstTimeStep);
+    const unsigned num_variables = mDatasetDims[2];
+    assert(firstVariableId + numVariables <= num_variables);
+    mCachedVariables.resize(num_variables, false);
+
+    // The cache is laid out as the block of the dataset it is written to: by time step, then node, then variable
+    const std::size_t row_size = mNumberOwned*num_variables;
+    const std::size_t row_start = (mCurrentTimeStep-mCacheFirstTimeStep)*row_size;
+    if (mDataCache.size() < row_start + row_size)
+    {
+        mDataCache.resize(row_start + row_size, 0.0);
+    }
+    for (unsigned i=0; i<mNumberOwned; i++)
+    {
+        for (unsigned var=0; var<numVariables; var++)
+        {
+            mDataCache[row_start + i*num_variables + firstVariableId + var] = pData[i*numVariables + var];
+        }
+    }
+    for (unsigned var=0; var<numVariables; var++)
+    {
+        mCachedVariables[firstVariableId + var] = true;
+    }
+}
+
+void Hdf5DataWriter::ReserveCache()
+{
+    // Reserve space. Enough for one chunk in the time dimension, or for the number of time steps between writes.
+    hsize_t num_time_steps = (mCacheInterval > 0) ? mCacheInterval : mChunkSize[0];
+    mDataCache.reserve(num_time_steps*mNumberOwned*mDatasetDims[2]);
+}
+
+void Hdf5DataWriter::SetCacheInterval(unsigned numTimeSteps)
+{
+    if (!mDataCache.empty())
+    {
+        EXCEPTION("Cannot change the cache interval while the cache holds data.");
+    }
+    mCacheInterval = numTimeSteps;
+    if (numTimeSteps > 0)
+    {
+        mUseCache = true;
+        if (!mIsInDefineMode)
+        {
+            ReserveCache();
+        }
+    }
+}
+
+unsigned Hdf5DataWriter::GetCacheInterval()
+{
+    return mCacheInterval;
+}
+
+void Hdf5DataWriter::SetStoreAsFloat(bool storeAsFloat)
+{
+    if (!mIsInDefineMode)
+    {
+        EXCEPTION("Cannot set the storage type when not in define mode.");
+    }
+    mStoreAsFloat = storeAsFloat;
+}
+
+void Hdf5DataWriter::SetCompressionLevel(unsigned level)
+{
+    if (!mIsInDefineMode)
+    {
+        EXCEPTION("Cannot set the compression level when not in define mode.");
+    }
+    if (level > 9u)
+    {
+        EXCEPTION("The compression level must be between 0 and 9.");
+    }
+    mCompressionLevel = level;
+}
+
+void Hdf5DataWriter::SetQuantisationTolerance(double absTolerance)
+{
+    if (!mIsInDefineMode)
+    {
+        EXCEPTION("Cannot set the quantisation tolerance when not in define mode.");
+    }
+    if (absTolerance < 0.0)
+    {
+        EXCEPTION("The quantisation tolerance must be non-negative.");
+    }
+    mQuantisationTolerance = absTolerance;
+}
+
+void Hdf5DataWriter::WriteVariablesData(hid_t memspace, hid_t hyperslabSpace, hid_t propertyListId,
+                                        const double* pData, unsigned numValues)
+{
+    if (mQuantisationTolerance > 0.0 && numValues > 0)
+    {
+        // Round to a power of two, so that the low-order mantissa bits of every value are zero
+        double step = pow(2.0, floor(log(2.0*mQuantisationTolerance)/log(2.0)));
+        mQuantisedData.resize(numValues);
+        for (unsigned i=0; i<numValues; i++)
+        {
+            mQuantisedData[i] = step*floor(pData[i]/step + 0.5);
+        }
+        pData = &mQuantisedData[0];
+    }
+    H5Dwrite(mVariablesDatasetId, H5T_NATIVE_DOUBLE, memspace, hyperslabSpace, propertyListId, pData);
+}
+
+void Hdf5DataWriter::Flush()
+{
+    if (mIsInDefineMode)
+    {
+        return; // Nothing to do...
+    }
+
+    if (mUseCache)
+    {
+        WriteCache();
+    }
+    H5Fflush(mFileId, H5F_SCOPE_GLOBAL);
 }
 
 void Hdf5DataWriter::PutUnlimitedVariable(double value)
@@ -1231,14 +1401,25 @@ void Hdf5DataWriter::AdvanceAlongUnlimitedDimension()
 
     mCurrentTimeStep++;
 
-    /*
-     * Write when stepping over a chunk boundary. Note: NOT the same as write
-     * out when the chunk size == the cache size, because we might have started
-     * part-way through a chunk.
-     */
-    if (mUseCache && (mCurrentTimeStep % mChunkSize[0] == 0))
+    if (mUseCache)
     {
-        WriteCache();
+        if (mCacheInterval > 0)
+        {
+            // Write when the cache holds the requested number of time steps
+            if (mCurrentTimeStep - mCacheFirstTimeStep >= mCacheInterval)
+            {
+                WriteCache();
+            }
+        }
+        /*
+         * Write when stepping over a chunk boundary. Note: NOT the same as write
+         * out when the chunk size == the cache size, because we might have started
+         * part-way through a chunk.
+         */
+        else if (mCurrentTimeStep % mChunkSize[0] == 0)
+        {
+            WriteCache();
+        }
     }
 
     /*
@@ -1406,7 +1587,7 @@ hsize_t Hdf5DataWriter::CalculateNumberOfChunks()
 void Hdf5DataWriter::CalculateChunkDims( unsigned targetSize, unsigned* pChunkSizeInBytes, bool* pAllOneChunk )
 {
     bool all_one_chunk = true;
-    unsigned chunk_size_in_bytes = 8u; // 8 bytes/double
+    unsigned chunk_size_in_bytes = mStoreAsFloat ? 4u : 8u; // 4 bytes/float, 8 bytes/double
     unsigned divisors[DATASET_DIMS];
     // Loop over dataset dimensions, dividing each dimension into the integer number of chunks that results
     // in the number of entries closest to the targetSize. This means the chunks will span the dataset with
@@ -90,6 +90,13 @@ private:
     bool mUseCache;                                 /**< Whether to use a cache */
     long unsigned mCacheFirstTimeStep;              /**< Coordinate to keep track of cache writes */
     std::vector<double> mDataCache;                 /**< Cache results here before writing */
+    std::vector<bool> mCachedVariables;             /**< Which variables have been written to the cache since it was last written out */
+    unsigned mCacheInterval;                        /**< Number of time steps to cache before writing them (0 to write the cache at chunk boundaries) */
+
+    bool mStoreAsFloat;                             /**< Whether to store the data as 32-bit floats rather than doubles */
+    unsigned mCompressionLevel;                     /**< Deflate compression level for the data (0 for no compression) */
+    double mQuantisationTolerance;                  /**< Absolute tolerance to which data are rounded before writing (0 for no rounding) */
+    std::vector<double> mQuantisedData;             /**< Workspace holding data rounded to #mQuantisationTolerance */
 
     /**
      * Check name of variable is allowed, i.e. contains only alphanumeric & _, and isn't blank.
@@ -143,6 +150,34 @@ private:
      */
     void SetChunkSize();
 
+    /**
+     * Reserve space in the cache for the number of time steps it holds before being written.
+     */
+    void ReserveCache();
+
+    /**
+     * Copy locally owned data for the current time step into the cache, at the place they
+     * will be written from.
+     *
+     * @param pData  the data, node by node, with numVariables values for each node
+     * @param firstVariableId  the ID of the first variable in pData
+     * @param numVariables  the number of consecutive variables in pData
+     */
+    void CacheVariablesData(const double* pData, unsigned firstVariableId, unsigned numVariables);
+
+    /**
+     * Write locally owned data to the variables dataset, first rounding it to
+     * #mQuantisationTolerance if lossy quantisation is in use.
+     *
+     * @param memspace  the memory dataspace
+     * @param hyperslabSpace  the file dataspace, with the hyperslab to write selected
+     * @param propertyListId  the transfer property list
+     * @param pData  the data to write
+     * @param numValues  the number of values in pData
+     */
+    void WriteVariablesData(hid_t memspace, hid_t hyperslabSpace, hid_t propertyListId,
+                            const double* pData, unsigned numValues);
+
 public:
 
     /**
@@ -270,6 +305,25 @@ public:
      */
     void WriteCache();
 
+    /**
+     * Write the cache every numTimeSteps time steps, rather than at each chunk boundary,
+     * turning the cache on if necessary.  The cache is also written on Flush() and Close().
+     *
+     * @param numTimeSteps  the number of time steps between writes (0 to write the cache at chunk boundaries, the default)
+     */
+    void SetCacheInterval(unsigned numTimeSteps);
+
+    /**
+     * @return the number of time steps between writes of the cache (0 if it is written at chunk boundaries).
+     */
+    unsigned GetCacheInterval();
+
+    /**
+     * Write any cached data to disk and flush the file.  This is collective, so must be
+     * called on all processes, between time steps.
+     */
+    void Flush();
+
     /**
      * Write a single value for the unlimited variable (e.g. time) to the dataset.
      *
@@ -410,6 +464,42 @@ public:
      * @param alignment Alignment (bytes)
      */
     void SetAlignment(hsize_t alignment);
+
+    /**
+     * Store the data as 32-bit floats rather than doubles, halving the size of the file.
+     * Data are still passed in, and read back by Hdf5DataReader, as doubles.
+     *
+     * This method only has an effect when creating a NEW DATASET. Must be
+     * called in define mode.
+     *
+     * @param storeAsFloat  whether to store the data as floats (defaults to true)
+     */
+    void SetStoreAsFloat(bool storeAsFloat=true);
+
+    /**
+     * Compress the data with the shuffle and deflate filters, which Hdf5DataReader
+     * undoes transparently.  Parallel writes to compressed datasets need HDF5 1.10.2
+     * or later; with older versions, parallel runs write uncompressed data with a warning.
+     *
+     * This method only has an effect when creating a NEW DATASET. Must be
+     * called in define mode.
+     *
+     * @param level  the deflate level, from 1 (fastest) to 9 (smallest), or 0 for no compression
+     */
+    void SetCompressionLevel(unsigned level);
+
+    /**
+     * Round the data to a multiple of the largest power of two no more than twice the
+     * given tolerance before writing, so that every value is within the tolerance of the
+     * value passed in.  The discarded low-order bits are all zero, so the data compress
+     * much better (see SetCompressionLevel).  The tolerance is stored in the file, and
+     * used again when extending it.
+     *
+     * Must be called in define mode.
+     *
+     * @param absTolerance  the absolute tolerance (0 for no rounding, the default)
+     */
+    void SetQuantisationTolerance(double absTolerance);
 };
 
 #endif /*HDF5DATAWRITER_HPP_*/
@@ -38,6 +38,7 @@ OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include <cxxtest/TestSuite.h>
 
+#include <cmath>
 #include <cstring> // For strcpy
 
 #include "Hdf5DataWriter.hpp"
@@ -358,43 +359,63 @@ public:
         PetscTools::Destroy(petsc_data_1);
     }
 
-    void TestHdf5DataWriterMultipleColumnsCachedFails() throw(Exception)
+    void TestHdf5DataWriterMultipleColumnsCached() throw(Exception)
     {
         int number_nodes = 100;
-
         DistributedVectorFactory factory(number_nodes);
 
-        Hdf5DataWriter writer(factory,
-                              "TestHdf5DataWriter",
-                              "hdf5_test_multi_column_cached_fails",
-                              false,
-                              false,
-                              "Data",
-                              true); // cache
-        writer.DefineFixedDimension(number_nodes);
+        Vec petsc_data = factory.CreateVec();
+        DistributedVector distributed_vector = factory.CreateDistributedVector(petsc_data);
 
-        // Define TWO variables
-        int node_id = writer.DefineVariable("Node","dimensionless");
-        writer.DefineVariable("I_K","milliamperes");
+        // Write the same data with and without the cache, one variable at a time
+        for (unsigned use_cache=0; use_cache<2; use_cache++)
+        {
+            Hdf5DataWriter writer(factory,
+                                  "TestHdf5DataWriter",
+                                  use_cache ? "hdf5_test_multi_column_cached" : "hdf5_test_multi_column_uncached",
+                                  false,
+                                  false,
+                                  "Data",
+                                  use_cache);
+            writer.DefineFixedDimension(number_nodes);
 
-        writer.EndDefineMode();
+            // Define THREE variables, but only write two of them
+            int node_id = writer.DefineVariable("Node","dimensionless");
+            int ik_id = writer.DefineVariable("I_K","milliamperes");
+            writer.DefineVariable("I_Na","milliamperes");
+            writer.DefineUnlimitedDimension("Time", "msec");
+            writer.EndDefineMode();
 
-        Vec petsc_data_1 = factory.CreateVec();
-        DistributedVector distributed_vector_1 = factory.CreateDistributedVector(petsc_data_1);
+            for (unsigned time_step=0; time_step<10; time_step++)
+            {
+                for (DistributedVector::Iterator index = distributed_vector.Begin();
+                     index!= distributed_vector.End();
+                     ++index)
+                {
+                    distributed_vector[index] = time_step*1000 + index.Global;
+                }
+                distributed_vector.Restore();
+                writer.PutVector(ik_id, petsc_data);
 
-        for (DistributedVector::Iterator index = distributed_vector_1.Begin();
-             index!= distributed_vector_1.End();
-             ++index)
-        {
-            distributed_vector_1[index] =  index.Global;
+                for (DistributedVector::Iterator index = distributed_vector.Begin();
+                     index!= distributed_vector.End();
+                     ++index)
+                {
+                    distributed_vector[index] = index.Global;
+                }
+                distributed_vector.Restore();
+                writer.PutVector(node_id, petsc_data);
+
+                writer.PutUnlimitedVariable(time_step);
+                writer.AdvanceAlongUnlimitedDimension();
+            }
+            writer.Close();
         }
-        distributed_vector_1.Restore();
 
-        // Try and write ONE -> exception
-        TS_ASSERT_THROWS_THIS(writer.PutVector(node_id, petsc_data_1),
-                              "Cached writes must write all variables at once.");
+        TS_ASSERT(CompareFilesViaHdf5DataReader("TestHdf5DataWriter", "hdf5_test_multi_column_cached", true,
+                                                "TestHdf5DataWriter", "hdf5_test_multi_column_uncached", true));
 
-        PetscTools::Destroy(petsc_data_1);
+        PetscTools::Destroy(petsc_data);
     }
 
     void TestHdf5DataWriterSingleColumnCached() throw(Exception)
@@ -482,6 +503,151 @@ public:
                                                 "io/test/data", filename + "_extended", false));
     }
 
+    void TestHdf5DataWriterCacheInterval() throw(Exception)
+    {
+        int number_nodes = 100;
+        DistributedVectorFactory factory(number_nodes);
+
+        Vec petsc_data = factory.CreateVec(2);
+        DistributedVector distributed_vector = factory.CreateDistributedVector(petsc_data);
+        DistributedVector::Stripe ik_stripe(distributed_vector, 0);
+        DistributedVector::Stripe ina_stripe(distributed_vector, 1);
+
+        // Write the same data with and without a cache interval
+        for (unsigned interval=0; interval<=3; interval+=3)
+        {
+            std::string file_name = (interval == 0) ? "hdf5_test_cache_interval_reference" : "hdf5_test_cache_interval";
+            Hdf5DataWriter writer(factory, "TestHdf5DataWriter", file_name, false);
+            writer.DefineFixedDimension(number_nodes);
+            int ik_id = writer.DefineVariable("I_K", "milliamperes");
+            int ina_id = writer.DefineVariable("I_Na", "milliamperes");
+            writer.DefineUnlimitedDimension("Time", "msec");
+
+            // The cache is written every interval time steps rather than at chunk boundaries
+            writer.SetCacheInterval(interval);
+            TS_ASSERT_EQUALS(writer.GetCacheInterval(), interval);
+            TS_ASSERT_EQUALS(writer.GetUsingCache(), interval > 0);
+            writer.EndDefineMode();
+
+            std::vector<int> striped_variable_IDs;
+            striped_variable_IDs.push_back(ik_id);
+            striped_variable_IDs.push_back(ina_id);
+
+            for (unsigned time_step=0; time_step<10; time_step++)
+            {
+                for (DistributedVector::Iterator index = distributed_vector.Begin();
+                     index!= distributed_vector.End();
+                     ++index)
+                {
+                    ik_stripe[index] = time_step*1000 + index.Global;
+                    ina_stripe[index] = time_step*1000 + 500 + index.Global;
+                }
+                distributed_vector.Restore();
+
+                writer.PutStripedVector(striped_variable_IDs, petsc_data);
+                writer.PutUnlimitedVariable(time_step);
+                writer.AdvanceAlongUnlimitedDimension();
+                if (time_step == 4)
+                {
+                    writer.Flush();
+                }
+
+                if (interval > 0)
+                {
+                    // The cache is written out whenever it fills (and the flush restarts it after time step 4)
+                    unsigned expected_num_cached = (time_step < 4) ? (time_step+1)%3 : (time_step-4)%3;
+                    TS_ASSERT_EQUALS(writer.mDataCache.size(), expected_num_cached*writer.mNumberOwned*2u);
+                    TS_ASSERT_EQUALS(writer.mCacheFirstTimeStep + expected_num_cached, writer.mCurrentTimeStep);
+                }
+            }
+
+            // The last time step is written here
+            writer.Close();
+        }
+
+        TS_ASSERT(CompareFilesViaHdf5DataReader("TestHdf5DataWriter", "hdf5_test_cache_interval", true,
+                                                "TestHdf5DataWriter", "hdf5_test_cache_interval_reference", true));
+
+        PetscTools::Destroy(petsc_data);
+    }
+
+    void TestHdf5DataWriterStorageOptions() throw(Exception)
+    {
+        int number_nodes = 100;
+        DistributedVectorFactory factory(number_nodes);
+
+        Vec petsc_data = factory.CreateVec(2);
+        DistributedVector distributed_vector = factory.CreateDistributedVector(petsc_data);
+        DistributedVector::Stripe vm_stripe(distributed_vector, 0);
+        DistributedVector::Stripe phi_e_stripe(distributed_vector, 1);
+
+        {
+            Hdf5DataWriter writer(factory, "TestHdf5DataWriter", "hdf5_test_storage_options", false);
+            writer.DefineFixedDimension(number_nodes);
+            int vm_id = writer.DefineVariable("V_m", "millivolts");
+            int phi_e_id = writer.DefineVariable("Phi_e", "millivolts");
+            writer.DefineUnlimitedDimension("Time", "msec");
+
+            TS_ASSERT_THROWS_THIS(writer.SetCompressionLevel(10u), "The compression level must be between 0 and 9.");
+            TS_ASSERT_THROWS_THIS(writer.SetQuantisationTolerance(-1.0), "The quantisation tolerance must be non-negative.");
+            writer.SetStoreAsFloat();
+            writer.SetCompressionLevel(6u);
+            writer.SetQuantisationTolerance(1e-3);
+            writer.EndDefineMode();
+
+            TS_ASSERT_THROWS_THIS(writer.SetStoreAsFloat(), "Cannot set the storage type when not in define mode.");
+            TS_ASSERT_THROWS_THIS(writer.SetCompressionLevel(1u), "Cannot set the compression level when not in define mode.");
+            TS_ASSERT_THROWS_THIS(writer.SetQuantisationTolerance(1.0), "Cannot set the quantisation tolerance when not in define mode.");
+
+            std::vector<int> striped_variable_IDs;
+            striped_variable_IDs.push_back(vm_id);
+            striped_variable_IDs.push_back(phi_e_id);
+
+            for (unsigned time_step=0; time_step<5; time_step++)
+            {
+                for (DistributedVector::Iterator index = distributed_vector.Begin();
+                     index!= distributed_vector.End();
+                     ++index)
+                {
+                    vm_stripe[index] = sin(0.1*index.Global + time_step);
+                    phi_e_stripe[index] = 10.0*cos(0.1*index.Global + time_step);
+                }
+                distributed_vector.Restore();
+
+                writer.PutStripedVector(striped_variable_IDs, petsc_data);
+                writer.PutUnlimitedVariable(time_step);
+                writer.AdvanceAlongUnlimitedDimension();
+            }
+            writer.Close();
+        }
+
+        // The reader converts the rounded floats back to doubles, which are within the tolerance of the originals
+        Hdf5DataReader reader("TestHdf5DataWriter", "hdf5_test_storage_options");
+        TS_ASSERT_DELTA(reader.GetQuantisationTolerance(), 1e-3, 1e-12);
+        TS_ASSERT_EQUALS(reader.GetUnlimitedDimensionValues().size(), 5u);
+
+        // Values are rounded to multiples of 2^-9, the largest power of two no more than twice the tolerance
+        double step = 1.0/512.0;
+        for (unsigned node_index=0; node_index<(unsigned)number_nodes; node_index++)
+        {
+            std::vector<double> vm = reader.GetVariableOverTime("V_m", node_index);
+            std::vector<double> phi_e = reader.GetVariableOverTime("Phi_e", node_index);
+            for (unsigned time_step=0; time_step<5; time_step++)
+            {
+                TS_ASSERT_DELTA(vm[time_step], sin(0.1*node_index + time_step), 1e-3);
+                TS_ASSERT_DELTA(phi_e[time_step], 10.0*cos(0.1*node_index + time_step), 1e-3);
+                TS_ASSERT_DELTA(vm[time_step]/step, floor(vm[time_step]/step + 0.5), 1e-9);
+            }
+        }
+        reader.Close();
+
+        Hdf5DataReader reader_unrounded("TestHdf5DataWriter", "hdf5_test_cache_interval");
+        TS_ASSERT_EQUALS(reader_unrounded.GetQuantisationTolerance(), 0.0);
+        reader_unrounded.Close();
+
+        PetscTools::Destroy(petsc_data);
+    }
+
     void TestHdf5DataWriterNonEvenRowDistribution() throw(Exception)
     {
         int number_nodes = 100;
@@ -1066,7 +1232,7 @@ public:
     {
         Hdf5DataWriterFullFormatStripedIncomplete(true,
                                                   "hdf5_test_full_format_striped_incomplete_cached",
-                                                  "Cached writes must write all variables at once.");
+                                                  "The PutStripedVector functionality for incomplete data is supported for only 2 stripes");
     }
 
     void TestNonImplementedFeatures()
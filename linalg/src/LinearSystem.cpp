@@ -68,6 +68,7 @@ LinearSystem::LinearSystem(PetscInt lhsVectorSize, unsigned rowPreallocation)
     mpBathNodes( boost::shared_ptr<std::vector<PetscInt> >() ),
     mPrecondMatrixIsNotLhs(false),
     mRowPreallocation(rowPreallocation),
+    mUseRowByRowPreallocation(false),
     mUseFixedNumberIterations(false),
     mEvaluateNumItsEveryNSolves(UINT_MAX),
     mpConvergenceTestContext(NULL),
@@ -122,6 +123,7 @@ LinearSystem::LinearSystem(PetscInt lhsVectorSize, Mat lhsMatrix, Vec rhsVector)
     mpTwoLevelsBlockDiagonalPC(NULL),
     mpBathNodes( boost::shared_ptr<std::vector<PetscInt> >() ),
     mPrecondMatrixIsNotLhs(false),
+    mUseRowByRowPreallocation(false),
     mUseFixedNumberIterations(false),
     mEvaluateNumItsEveryNSolves(UINT_MAX),
     mpConvergenceTestContext(NULL),
@@ -158,6 +160,7 @@ LinearSystem::LinearSystem(Vec templateVector, unsigned rowPreallocation, bool n
     mpBathNodes( boost::shared_ptr<std::vector<PetscInt> >() ),
     mPrecondMatrixIsNotLhs(false),
     mRowPreallocation(rowPreallocation),
+    mUseRowByRowPreallocation(false),
     mUseFixedNumberIterations(false),
     mEvaluateNumItsEveryNSolves(UINT_MAX),
     mpConvergenceTestContext(NULL),
@@ -184,6 +187,64 @@ LinearSystem::LinearSystem(Vec templateVector, unsigned rowPreallocation, bool n
 #endif
 }
 
+LinearSystem::LinearSystem(Vec templateVector,
+                           const std::vector<PetscInt>& rDiagonalNonZeros,
+                           const std::vector<PetscInt>& rOffDiagonalNonZeros,
+                           bool newAllocationError)
+   :mPrecondMatrix(NULL),
+    mMatNullSpace(NULL),
+    mDestroyMatAndVec(true),
+    mKspIsSetup(false),
+    mMatrixIsConstant(false),
+    mTolerance(1e-6),
+    mUseAbsoluteTolerance(false),
+    mDirichletBoundaryConditionsVector(NULL),
+    mpBlockDiagonalPC(NULL),
+    mpLDUFactorisationPC(NULL),
+    mpTwoLevelsBlockDiagonalPC(NULL),
+    mpBathNodes( boost::shared_ptr<std::vector<PetscInt> >() ),
+    mPrecondMatrixIsNotLhs(false),
+    mRowPreallocation(0u),
+    mUseRowByRowPreallocation(true),
+    mDiagonalNonZeros(rDiagonalNonZeros),
+    mOffDiagonalNonZeros(rOffDiagonalNonZeros),
+    mUseFixedNumberIterations(false),
+    mEvaluateNumItsEveryNSolves(UINT_MAX),
+    mpConvergenceTestContext(NULL),
+    mEigMin(DBL_MAX),
+    mEigMax(DBL_MIN),
+    mForceSpectrumReevaluation(false)
+{
+    VecDuplicate(templateVector, &mRhsVector);
+    VecGetSize(mRhsVector, &mSize);
+    VecGetOwnershipRange(mRhsVector, &mOwnershipRangeLo, &mOwnershipRangeHi);
+    PetscInt local_size = mOwnershipRangeHi - mOwnershipRangeLo;
+
+    if (mDiagonalNonZeros.size() != (unsigned)local_size || mOffDiagonalNonZeros.size() != (unsigned)local_size)
+    {
+        PetscTools::Destroy(mRhsVector);
+        EXCEPTION("Row preallocation given for " << mDiagonalNonZeros.size() << " rows, but this process owns "
+                  << local_size << " rows of the linear system.");
+    }
+
+    // Record the longest row, for anything which only needs a single preallocation figure
+    for (unsigned row=0; row<mDiagonalNonZeros.size(); row++)
+    {
+        mRowPreallocation = std::max(mRowPreallocation, (unsigned)(mDiagonalNonZeros[row] + mOffDiagonalNonZeros[row]));
+    }
+
+    PetscTools::SetupMat(mLhsMatrix, mSize, mSize, mDiagonalNonZeros, mOffDiagonalNonZeros, local_size, true, newAllocationError);
+
+    mKspType = "gmres";
+    mPcType = "jacobi";
+
+    mNumSolves = 0;
+#ifdef TRACE_KSP
+    mTotalNumIterations = 0;
+    mMaxNumIterations = 0;
+#endif
+}
+
 LinearSystem::LinearSystem(Vec residualVector, Mat jacobianMatrix)
    :mPrecondMatrix(NULL),
     mMatNullSpace(NULL),
@@ -199,6 +260,7 @@ LinearSystem::LinearSystem(Vec residualVector, Mat jacobianMatrix)
     mpBathNodes( boost::shared_ptr<std::vector<PetscInt> >() ),
     mPrecondMatrixIsNotLhs(false),
     mRowPreallocation(UINT_MAX),
+    mUseRowByRowPreallocation(false),
     mUseFixedNumberIterations(false),
     mEvaluateNumItsEveryNSolves(UINT_MAX),
     mpConvergenceTestContext(NULL),
@@ -1222,7 +1284,15 @@ void LinearSystem::SetPrecondMatrixIsDifferentFromLhs(bool precondIsDifferent)
         }
 
         PetscInt local_size = mOwnershipRangeHi - mOwnershipRangeLo;
-        PetscTools::SetupMat(mPrecondMatrix, mSize, mSize, mRowPreallocation, local_size, local_size);
+        if (!mUseRowByRowPreallocation)
+        {
+            PetscTools::SetupMat(mPrecondMatrix, mSize, mSize, mRowPreallocation, local_size, local_size);
+        }
+        else
+        {
+            // Reuse the exact preallocation of the LHS matrix
+            PetscTools::SetupMat(mPrecondMatrix, mSize, mSize, mDiagonalNonZeros, mOffDiagonalNonZeros, local_size);
+        }
     }
 }
 
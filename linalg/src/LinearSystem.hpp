@@ -55,6 +55,7 @@ OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <petscviewer.h>
 
 #include <string>
+#include <vector>
 #include <cassert>
 
 /**
@@ -121,6 +122,15 @@ private:
     /** The max number of nonzero entries expected on a LHS row */
     unsigned mRowPreallocation;
 
+    /** Whether the matrices are preallocated row by row, using #mDiagonalNonZeros and #mOffDiagonalNonZeros */
+    bool mUseRowByRowPreallocation;
+
+    /** The exact number of nonzeros in the diagonal block of each local LHS row (see #mUseRowByRowPreallocation). */
+    std::vector<PetscInt> mDiagonalNonZeros;
+
+    /** The exact number of nonzeros in the off-diagonal block of each local LHS row (see #mDiagonalNonZeros). */
+    std::vector<PetscInt> mOffDiagonalNonZeros;
+
     /** Whether to use fixed number of iterations */
     bool mUseFixedNumberIterations;
 
@@ -206,6 +216,25 @@ public:
      */
     LinearSystem(Vec templateVector, unsigned rowPreallocation, bool newAllocationError=true);
 
+    /**
+     * Alternative constructor.
+     *
+     * As above, but the LHS matrix (and any separate preconditioning matrix) is preallocated
+     * exactly, row by row, rather than with the same number of entries on every row.  The
+     * counts are typically calculated from mesh connectivity with
+     * AbstractTetrahedralMesh::CalculateLocalRowNonZeroCounts().  Since PETSc keeps the
+     * nonzero structure when the matrix is zeroed, reassembly then needs no further allocation.
+     *
+     * @param templateVector  a PETSc vec
+     * @param rDiagonalNonZeros  the number of nonzeros in the locally owned columns, for each local row
+     * @param rOffDiagonalNonZeros  the number of nonzeros in the columns owned by other processes, for each local row
+     * @param newAllocationError tells PETSc whether to set the MAT_NEW_NONZERO_ALLOCATION_ERR.
+     */
+    LinearSystem(Vec templateVector,
+                 const std::vector<PetscInt>& rDiagonalNonZeros,
+                 const std::vector<PetscInt>& rOffDiagonalNonZeros,
+                 bool newAllocationError=true);
+
     /**
      * Alternative constructor.
      *
@@ -42,6 +42,9 @@ OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <cmath>
 #include <iostream>
 #include <cstring>
+#include <sstream>
+#include <vector>
+#include <algorithm>
 
 #include "LinearSystem.hpp"
 #include "DistributedVector.hpp"
@@ -384,6 +387,77 @@ public:
         PetscTools::Destroy(test_vec);
     }
 
+    void TestCreateWithRowByRowPreallocation() throw (Exception)
+    {
+        // A tridiagonal system, preallocated exactly
+        const int SIZE = 10;
+        Vec test_vec = PetscTools::CreateVec(SIZE);
+        PetscInt lo, hi;
+        VecGetOwnershipRange(test_vec, &lo, &hi);
+
+        std::vector<PetscInt> diagonal_nonzeros;
+        std::vector<PetscInt> off_diagonal_nonzeros;
+        for (PetscInt row=lo; row<hi; row++)
+        {
+            PetscInt num_diagonal = 0;
+            PetscInt num_off_diagonal = 0;
+            for (PetscInt col=row-1; col<=row+1; col++)
+            {
+                if (col >= lo && col < hi)
+                {
+                    num_diagonal++;
+                }
+                else if (col >= 0 && col < SIZE)
+                {
+                    num_off_diagonal++;
+                }
+            }
+            diagonal_nonzeros.push_back(num_diagonal);
+            off_diagonal_nonzeros.push_back(num_off_diagonal);
+        }
+
+        // Counts must be given for each local row
+        std::vector<PetscInt> too_many(diagonal_nonzeros);
+        too_many.push_back(1);
+        std::stringstream message;
+        message << "Row preallocation given for " << too_many.size() << " rows, but this process owns "
+                << hi-lo << " rows of the linear system.";
+        TS_ASSERT_THROWS_THIS(LinearSystem bad_ls(test_vec, too_many, too_many), message.str());
+
+        LinearSystem ls(test_vec, diagonal_nonzeros, off_diagonal_nonzeros);
+        ls.SetPrecondMatrixIsDifferentFromLhs();
+        for (PetscInt row=lo; row<hi; row++)
+        {
+            for (PetscInt col=std::max(row-1, 0); col<=std::min(row+1, SIZE-1); col++)
+            {
+                ls.SetMatrixElement(row, col, (row == col) ? 2.0 : -1.0);
+                PetscMatTools::SetElement(ls.rGetPrecondMatrix(), row, col, (row == col) ? 2.0 : 0.0);
+            }
+        }
+        ls.AssembleFinalLinearSystem();
+        PetscMatTools::Finalise(ls.rGetPrecondMatrix());
+
+        // Every preallocated entry is used, and no further allocation was needed
+        MatInfo info;
+        MatGetInfo(ls.rGetLhsMatrix(), MAT_LOCAL, &info);
+        TS_ASSERT_EQUALS(info.mallocs, 0.0);
+        TS_ASSERT_EQUALS(info.nz_allocated, info.nz_used);
+        MatGetInfo(ls.rGetPrecondMatrix(), MAT_LOCAL, &info);
+        TS_ASSERT_EQUALS(info.mallocs, 0.0);
+
+        // Reassembly reuses the same nonzero structure
+        ls.ZeroLhsMatrix();
+        for (PetscInt row=lo; row<hi; row++)
+        {
+            ls.SetMatrixElement(row, row, 1.0);
+        }
+        ls.AssembleFinalLinearSystem();
+        MatGetInfo(ls.rGetLhsMatrix(), MAT_LOCAL, &info);
+        TS_ASSERT_EQUALS(info.mallocs, 0.0);
+
+        PetscTools::Destroy(test_vec);
+    }
+
     void TestLinearSystem2()
     {
         LinearSystem ls(2);
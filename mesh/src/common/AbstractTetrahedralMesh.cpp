@@ -64,7 +64,13 @@ void AbstractTetrahedralMesh<ELEMENT_DIM, SPACE_DIM>::SetElementOwnerships()
 
 template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
 AbstractTetrahedralMesh<ELEMENT_DIM, SPACE_DIM>::AbstractTetrahedralMesh()
-    : mMeshIsLinear(true)
+    : mMeshIsLinear(true),
+      mpElementBoundingBoxTree(NULL),
+      mpNodeBoundingBoxTree(NULL),
+      mNodeBoundingBoxTreeNumNodes(0),
+      mBoundingBoxTreesLocationGeneration(UNSIGNED_UNSET),
+      mpElementGeometryCache(NULL),
+      mElementGeometryCacheLocationGeneration(UNSIGNED_UNSET)
 {
 }
 
@@ -81,6 +87,8 @@ AbstractTetrahedralMesh<ELEMENT_DIM, SPACE_DIM>::~AbstractTetrahedralMesh()
     {
         delete mBoundaryElements[i];
     }
+    ClearBoundingBoxTrees();
+    ClearElementGeometryCache();
 }
 
 template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
@@ -825,6 +833,60 @@ unsigned AbstractTetrahedralMesh<ELEMENT_DIM, SPACE_DIM>::CalculateMaximumNodeCo
     return max_connectivity;
 }
 
+template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+void AbstractTetrahedralMesh<ELEMENT_DIM, SPACE_DIM>::AddConnectedNodeIndices(Node<SPACE_DIM>* pNode,
+                                                                               std::set<unsigned>& rConnectedNodes)
+{
+    rConnectedNodes.insert(pNode->GetIndex());
+    for (typename Node<SPACE_DIM>::ContainingElementIterator it = pNode->ContainingElementsBegin();
+         it != pNode->ContainingElementsEnd();
+         ++it)
+    {
+        Element<ELEMENT_DIM, SPACE_DIM>* p_elem = this->GetElement(*it);
+        for (unsigned i=0; i<p_elem->GetNumNodes(); i++)
+        {
+            rConnectedNodes.insert(p_elem->GetNodeGlobalIndex(i));
+        }
+    }
+}
+
+template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+void AbstractTetrahedralMesh<ELEMENT_DIM, SPACE_DIM>::CalculateLocalRowNonZeroCounts(unsigned problemDim,
+                                                                                      std::vector<PetscInt>& rDiagonalNonZeros,
+                                                                                      std::vector<PetscInt>& rOffDiagonalNonZeros)
+{
+    assert(problemDim > 0);
+    const unsigned lo = this->GetDistributedVectorFactory()->GetLow();
+    const unsigned hi = this->GetDistributedVectorFactory()->GetHigh();
+
+    rDiagonalNonZeros.assign(problemDim*(hi-lo), 0);
+    rOffDiagonalNonZeros.assign(problemDim*(hi-lo), 0);
+
+    std::set<unsigned> connected_nodes;
+    for (unsigned node_index=lo; node_index<hi; node_index++)
+    {
+        connected_nodes.clear();
+        AddConnectedNodeIndices(this->GetNode(node_index), connected_nodes);
+
+        PetscInt num_local = 0;
+        for (std::set<unsigned>::iterator it = connected_nodes.begin(); it != connected_nodes.end(); ++it)
+        {
+            if (*it >= lo && *it < hi)
+            {
+                num_local++;
+            }
+        }
+        PetscInt num_halo = connected_nodes.size() - num_local;
+
+        // Each of the node's rows couples to every unknown at each connected node
+        for (unsigned k=0; k<problemDim; k++)
+        {
+            rDiagonalNonZeros[problemDim*(node_index-lo) + k] = problemDim*num_local;
+            rOffDiagonalNonZeros[problemDim*(node_index-lo) + k] = problemDim*num_halo;
+        }
+    }
+}
+
 template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
 void AbstractTetrahedralMesh<ELEMENT_DIM, SPACE_DIM>::GetHaloNodeIndices(std::vector<unsigned>& rHaloIndices) const
 {
@@ -1006,6 +1068,14 @@ unsigned AbstractTetrahedralMesh<ELEMENT_DIM, SPACE_DIM>::GetContainingElementIn
 
     if (!onlyTryWithTestElements)
     {
+        unsigned element_index = GetContainingElementIndexUsingTree(rTestPoint, strict);
+        if (element_index != UNSIGNED_UNSET)
+        {
+            return element_index;
+        }
+
+        // The tree finds every element containing the point, so this only happens for points outside
+        // the mesh; check every element, as before the tree was introduced, to be sure
         for (unsigned i=0; i<this->mElements.size(); i++)
         {
             if (this->mElements[i]->IncludesPoint(rTestPoint, strict))
@@ -1067,6 +1137,321 @@ unsigned AbstractTetrahedralMesh<ELEMENT_DIM, SPACE_DIM>::GetNearestElementIndex
     return closest_index;
 }
 
+template <unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+std::vector<unsigned> AbstractTetrahedralMesh<ELEMENT_DIM, SPACE_DIM>::GetContainingElementIndexForEachPoint(const std::vector<ChastePoint<SPACE_DIM> >& rTestPoints,
+                                                                                                        bool strict)
+{
+    std::vector<unsigned> element_indices(rTestPoints.size());
+    for (unsigned i=0; i<rTestPoints.size(); i++)
+    {
+        element_indices[i] = GetContainingElementIndexUsingTree(rTestPoints[i], strict);
+    }
+    return element_indices;
+}
+
+template <unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+std::vector<unsigned> AbstractTetrahedralMesh<ELEMENT_DIM, SPACE_DIM>::GetNearestNodeIndexForEachPoint(const std::vector<ChastePoint<SPACE_DIM> >& rTestPoints)
+{
+    std::vector<unsigned> node_indices(rTestPoints.size(), UNSIGNED_UNSET);
+    for (unsigned i=0; i<rTestPoints.size(); i++)
+    {
+        unsigned local_index = GetNearestNodeLocalIndexUsingTree(rTestPoints[i]);
+        if (local_index != UNSIGNED_UNSET)
+        {
+            node_indices[i] = this->mNodes[local_index]->GetIndex();
+        }
+    }
+    return node_indices;
+}
+
+template <unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+unsigned AbstractTetrahedralMesh<ELEMENT_DIM, SPACE_DIM>::GetNearestNodeLocalIndexUsingTree(const ChastePoint<SPACE_DIM>& rTestPoint)
+{
+    unsigned box_index = rGetNodeBoundingBoxTree().GetNearestBox(rTestPoint.rGetLocation());
+    if (box_index != UNSIGNED_UNSET && this->mNodes[mNodeBoundingBoxTreeIndices[box_index]]->IsDeleted())
+    {
+        // The node has been deleted since the tree was built
+        delete mpNodeBoundingBoxTree;
+        mpNodeBoundingBoxTree = NULL;
+        box_index = rGetNodeBoundingBoxTree().GetNearestBox(rTestPoint.rGetLocation());
+    }
+
+    if (box_index == UNSIGNED_UNSET)
+    {
+        return UNSIGNED_UNSET;
+    }
+    return mNodeBoundingBoxTreeIndices[box_index];
+}
+
+template <unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+unsigned AbstractTetrahedralMesh<ELEMENT_DIM, SPACE_DIM>::GetContainingElementIndexUsingTree(const ChastePoint<SPACE_DIM>& rTestPoint,
+                                                                                             bool strict)
+{
+    std::vector<unsigned> candidates;
+    rGetElementBoundingBoxTree().GetBoxesContainingPoint(rTestPoint.rGetLocation(), candidates);
+
+    // The candidates are in increasing order, so we find the same element as a search through all elements
+    for (unsigned i=0; i<candidates.size(); i++)
+    {
+        Element<ELEMENT_DIM, SPACE_DIM>* p_element = this->mElements[candidates[i]];
+        if (!p_element->IsDeleted() && p_element->IncludesPoint(rTestPoint, strict))
+        {
+            return candidates[i];
+        }
+    }
+    return UNSIGNED_UNSET;
+}
+
+template <unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+void AbstractTetrahedralMesh<ELEMENT_DIM, SPACE_DIM>::CalculateElementBoundingBoxes(std::vector<c_vector<double, SPACE_DIM> >& rLowerCorners,
+                                                                                    std::vector<c_vector<double, SPACE_DIM> >& rUpperCorners)
+{
+    rLowerCorners.resize(this->mElements.size());
+    rUpperCorners.resize(this->mElements.size());
+
+    for (unsigned i=0; i<this->mElements.size(); i++)
+    {
+        Element<ELEMENT_DIM, SPACE_DIM>* p_element = this->mElements[i];
+        c_vector<double, SPACE_DIM>& r_lower = rLowerCorners[i];
+        c_vector<double, SPACE_DIM>& r_upper = rUpperCorners[i];
+
+        r_lower = p_element->GetNode(0)->rGetLocation();
+        r_upper = r_lower;
+        for (unsigned j=1; j<p_element->GetNumNodes(); j++)
+        {
+            const c_vector<double, SPACE_DIM>& r_location = p_element->GetNode(j)->rGetLocation();
+            for (unsigned d=0; d<SPACE_DIM; d++)
+            {
+                r_lower[d] = std::min(r_lower[d], r_location[d]);
+                r_upper[d] = std::max(r_upper[d], r_location[d]);
+            }
+        }
+
+        // Pad the box to allow for the tolerance and rounding error in Element::IncludesPoint()
+        double scale = 0.0;
+        for (unsigned d=0; d<SPACE_DIM; d++)
+        {
+            scale = std::max(scale, r_upper[d] - r_lower[d]);
+            scale = std::max(scale, std::max(fabs(r_lower[d]), fabs(r_upper[d])));
+        }
+        double padding = 1e-8*scale;
+        for (unsigned d=0; d<SPACE_DIM; d++)
+        {
+            r_lower[d] -= padding;
+            r_upper[d] += padding;
+        }
+    }
+}
+
+template <unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+void AbstractTetrahedralMesh<ELEMENT_DIM, SPACE_DIM>::CalculateNodeBoundingBoxes(std::vector<c_vector<double, SPACE_DIM> >& rLowerCorners,
+                                                                                 std::vector<c_vector<double, SPACE_DIM> >& rUpperCorners)
+{
+    rLowerCorners.resize(mNodeBoundingBoxTreeIndices.size());
+    for (unsigned i=0; i<mNodeBoundingBoxTreeIndices.size(); i++)
+    {
+        rLowerCorners[i] = this->mNodes[mNodeBoundingBoxTreeIndices[i]]->rGetLocation();
+    }
+    rUpperCorners = rLowerCorners;
+}
+
+template <unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+void AbstractTetrahedralMesh<ELEMENT_DIM, SPACE_DIM>::RefitBoundingBoxTreesIfNodesHaveMoved()
+{
+    if (Node<SPACE_DIM>::GetLocationGeneration() != mBoundingBoxTreesLocationGeneration)
+    {
+        RefitBoundingBoxTrees();
+    }
+}
+
+template <unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+BoundingBoxTree<SPACE_DIM>& AbstractTetrahedralMesh<ELEMENT_DIM, SPACE_DIM>::rGetElementBoundingBoxTree()
+{
+    RefitBoundingBoxTreesIfNodesHaveMoved();
+
+    if (mpElementBoundingBoxTree && mpElementBoundingBoxTree->GetNumBoxes() != this->mElements.size())
+    {
+        delete mpElementBoundingBoxTree;
+        mpElementBoundingBoxTree = NULL;
+    }
+
+    if (!mpElementBoundingBoxTree)
+    {
+        std::vector<c_vector<double, SPACE_DIM> > lower_corners;
+        std::vector<c_vector<double, SPACE_DIM> > upper_corners;
+        CalculateElementBoundingBoxes(lower_corners, upper_corners);
+
+        mpElementBoundingBoxTree = new BoundingBoxTree<SPACE_DIM>;
+        mpElementBoundingBoxTree->Build(lower_corners, upper_corners);
+    }
+
+    return *mpElementBoundingBoxTree;
+}
+
+template <unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+BoundingBoxTree<SPACE_DIM>& AbstractTetrahedralMesh<ELEMENT_DIM, SPACE_DIM>::rGetNodeBoundingBoxTree()
+{
+    RefitBoundingBoxTreesIfNodesHaveMoved();
+
+    if (mpNodeBoundingBoxTree && mNodeBoundingBoxTreeNumNodes != this->mNodes.size())
+    {
+        delete mpNodeBoundingBoxTree;
+        mpNodeBoundingBoxTree = NULL;
+    }
+
+    if (!mpNodeBoundingBoxTree)
+    {
+        mNodeBoundingBoxTreeIndices.clear();
+        for (unsigned i=0; i<this->mNodes.size(); i++)
+        {
+            if (!this->mNodes[i]->IsDeleted())
+            {
+                mNodeBoundingBoxTreeIndices.push_back(i);
+            }
+        }
+        mNodeBoundingBoxTreeNumNodes = this->mNodes.size();
+
+        std::vector<c_vector<double, SPACE_DIM> > lower_corners;
+        std::vector<c_vector<double, SPACE_DIM> > upper_corners;
+        CalculateNodeBoundingBoxes(lower_corners, upper_corners);
+
+        mpNodeBoundingBoxTree = new BoundingBoxTree<SPACE_DIM>;
+        mpNodeBoundingBoxTree->Build(lower_corners, upper_corners);
+    }
+
+    return *mpNodeBoundingBoxTree;
+}
+
+template <unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+void AbstractTetrahedralMesh<ELEMENT_DIM, SPACE_DIM>::RefitBoundingBoxTrees()
+{
+    std::vector<c_vector<double, SPACE_DIM> > lower_corners;
+    std::vector<c_vector<double, SPACE_DIM> > upper_corners;
+
+    if (mpElementBoundingBoxTree)
+    {
+        if (mpElementBoundingBoxTree->GetNumBoxes() == this->mElements.size())
+        {
+            CalculateElementBoundingBoxes(lower_corners, upper_corners);
+            mpElementBoundingBoxTree->Refit(lower_corners, upper_corners);
+        }
+        else
+        {
+            delete mpElementBoundingBoxTree;
+            mpElementBoundingBoxTree = NULL;
+        }
+    }
+
+    if (mpNodeBoundingBoxTree)
+    {
+        if (mNodeBoundingBoxTreeNumNodes == this->mNodes.size())
+        {
+            CalculateNodeBoundingBoxes(lower_corners, upper_corners);
+            mpNodeBoundingBoxTree->Refit(lower_corners, upper_corners);
+        }
+        else
+        {
+            delete mpNodeBoundingBoxTree;
+            mpNodeBoundingBoxTree = NULL;
+        }
+    }
+
+    // Trees built from now on also use the current node locations
+    mBoundingBoxTreesLocationGeneration = Node<SPACE_DIM>::GetLocationGeneration();
+}
+
+template <unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+void AbstractTetrahedralMesh<ELEMENT_DIM, SPACE_DIM>::ClearBoundingBoxTrees()
+{
+    delete mpElementBoundingBoxTree;
+    mpElementBoundingBoxTree = NULL;
+
+    delete mpNodeBoundingBoxTree;
+    mpNodeBoundingBoxTree = NULL;
+}
+
+template <unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+const ElementGeometryCache<ELEMENT_DIM, SPACE_DIM>& AbstractTetrahedralMesh<ELEMENT_DIM, SPACE_DIM>::rGetElementGeometryCache()
+{
+    unsigned location_generation = Node<SPACE_DIM>::GetLocationGeneration();
+    if (mpElementGeometryCache && mElementGeometryCacheLocationGeneration != location_generation)
+    {
+        ClearElementGeometryCache();
+    }
+
+    if (!mpElementGeometryCache)
+    {
+        unsigned num_elements = 0;
+        for (typename AbstractTetrahedralMesh<ELEMENT_DIM, SPACE_DIM>::ElementIterator iter = GetElementIteratorBegin();
+             iter != GetElementIteratorEnd();
+             ++iter)
+        {
+            num_elements++;
+        }
+
+        ElementGeometryCache<ELEMENT_DIM, SPACE_DIM>* p_cache = new ElementGeometryCache<ELEMENT_DIM, SPACE_DIM>(num_elements);
+
+        /*
+         * Compute the data from the node locations, rather than with GetInverseJacobianForElement(),
+         * since a mesh's own cached Jacobians are not updated when nodes are moved without a
+         * concrete move.  As in TetrahedralMesh::RefreshJacobianCachedData(), the determinant of
+         * an element of lower dimension than the space is the one given with its weighted direction.
+         */
+        c_matrix<double, SPACE_DIM, ELEMENT_DIM> jacobian;
+        c_matrix<double, ELEMENT_DIM, SPACE_DIM> inverse_jacobian;
+        c_vector<double, SPACE_DIM> weighted_direction;
+        double jacobian_determinant;
+        unsigned position = 0;
+        try
+        {
+            for (typename AbstractTetrahedralMesh<ELEMENT_DIM, SPACE_DIM>::ElementIterator iter = GetElementIteratorBegin();
+                 iter != GetElementIteratorEnd();
+                 ++iter, ++position)
+            {
+                iter->CalculateInverseJacobian(jacobian, jacobian_determinant, inverse_jacobian);
+                if (ELEMENT_DIM < SPACE_DIM)
+                {
+                    iter->CalculateWeightedDirection(weighted_direction, jacobian_determinant);
+                }
+                p_cache->SetElementData(position, iter->GetIndex(), jacobian_determinant, inverse_jacobian);
+            }
+        }
+        catch (Exception&)
+        {
+            // For example, an element with negative Jacobian determinant
+            delete p_cache;
+            throw;
+        }
+        mpElementGeometryCache = p_cache;
+        mElementGeometryCacheLocationGeneration = location_generation;
+    }
+    return *mpElementGeometryCache;
+}
+
+template <unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+void AbstractTetrahedralMesh<ELEMENT_DIM, SPACE_DIM>::ClearElementGeometryCache()
+{
+    delete mpElementGeometryCache;
+    mpElementGeometryCache = NULL;
+}
+
+template <unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+std::size_t AbstractTetrahedralMesh<ELEMENT_DIM, SPACE_DIM>::GetElementGeometryCacheMemoryUsage() const
+{
+    if (!mpElementGeometryCache)
+    {
+        return 0;
+    }
+    return mpElementGeometryCache->GetMemoryUsage();
+}
+
+template <unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+void AbstractTetrahedralMesh<ELEMENT_DIM, SPACE_DIM>::RefreshMesh()
+{
+    RefitBoundingBoxTrees();
+    ClearElementGeometryCache();
+}
+
 // Explicit instantiation
 template class AbstractTetrahedralMesh<1,1>;
 template class AbstractTetrahedralMesh<1,2>;
@@ -43,6 +43,7 @@ OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <boost/serialization/base_object.hpp>
 #include <boost/serialization/split_member.hpp>
 
+#include <set>
 #include <vector>
 #include <string>
 #include <cassert>
@@ -57,6 +58,8 @@ OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "TrianglesMeshWriter.hpp"
 #include "ArchiveLocationInfo.hpp"
 #include "FileFinder.hpp"
+#include "BoundingBoxTree.hpp"
+#include "ElementGeometryCache.hpp"
 
 
 /// Forward declaration which is going to be used for friendship
@@ -150,7 +153,9 @@ private:
             std::auto_ptr<AbstractMeshReader<ELEMENT_DIM, SPACE_DIM> > p_original_mesh_reader
                 = GenericMeshReader<ELEMENT_DIM, SPACE_DIM>(original_file, order_of_element, order_of_boundary_element);
 
-            if (p_original_mesh_reader->IsFileFormatBinary())
+            // Only binary Triangles files can be copied across, since the loader reads Triangles format
+            if (p_original_mesh_reader->IsFileFormatBinary()
+                && dynamic_cast<TrianglesMeshReader<ELEMENT_DIM, SPACE_DIM>*>(p_original_mesh_reader.get()) != NULL)
             {
                 // Mesh is in binary format, we can just copy the files across ignoring the mesh reader
                 if (PetscTools::AmMaster())
@@ -170,7 +175,7 @@ private:
             }
             else
             {
-                // Mesh in text format, use the mesh writer to "binarise" it
+                // Mesh in text (or mapped) format, use the mesh writer to "binarise" it
                 mesh_writer.WriteFilesUsingMeshReaderAndMesh(*p_original_mesh_reader,
                                                              *(const_cast<AbstractTetrahedralMesh<ELEMENT_DIM, SPACE_DIM>*>(this)));
             }
@@ -288,6 +293,93 @@ protected:  // Give access of these variables to subclasses
      */
     void SetElementOwnerships();
 
+    /**
+     * A bounding volume hierarchy over the bounding boxes of mElements, built on first use.
+     * Not archived.
+     */
+    BoundingBoxTree<SPACE_DIM>* mpElementBoundingBoxTree;
+
+    /**
+     * A bounding volume hierarchy over the locations of the nodes in mNodes which were
+     * not deleted when it was built, built on first use.  Not archived.
+     */
+    BoundingBoxTree<SPACE_DIM>* mpNodeBoundingBoxTree;
+
+    /** The position in mNodes of the node in each box of mpNodeBoundingBoxTree. */
+    std::vector<unsigned> mNodeBoundingBoxTreeIndices;
+
+    /** The size of mNodes when mpNodeBoundingBoxTree was built. */
+    unsigned mNodeBoundingBoxTreeNumNodes;
+
+    /**
+     * The value of Node::GetLocationGeneration() when the bounding box trees were last
+     * built or refitted.
+     */
+    unsigned mBoundingBoxTreesLocationGeneration;
+
+    /**
+     * Precomputed Jacobian data for the elements visited by the element iterator,
+     * built on first use and rebuilt whenever nodes have moved.  Not archived.
+     */
+    ElementGeometryCache<ELEMENT_DIM, SPACE_DIM>* mpElementGeometryCache;
+
+    /** The value of Node::GetLocationGeneration() when mpElementGeometryCache was built. */
+    unsigned mElementGeometryCacheLocationGeneration;
+
+    /**
+     * Calculate the bounding box of each element in mElements, padded slightly so
+     * that points which Element::IncludesPoint() accepts on its faces lie inside.
+     *
+     * @param rLowerCorners filled with the lower corner of each box
+     * @param rUpperCorners filled with the upper corner of each box
+     */
+    void CalculateElementBoundingBoxes(std::vector<c_vector<double, SPACE_DIM> >& rLowerCorners,
+                                       std::vector<c_vector<double, SPACE_DIM> >& rUpperCorners);
+
+    /**
+     * Calculate the (degenerate) bounding box of each node listed in mNodeBoundingBoxTreeIndices.
+     *
+     * @param rLowerCorners filled with the lower corner of each box
+     * @param rUpperCorners filled with the upper corner of each box
+     */
+    void CalculateNodeBoundingBoxes(std::vector<c_vector<double, SPACE_DIM> >& rLowerCorners,
+                                    std::vector<c_vector<double, SPACE_DIM> >& rUpperCorners);
+
+    /**
+     * Refit the bounding box trees if any node may have been moved (by any means) since
+     * they were last built or refitted.  Must not be called while nodes are being moved
+     * on other threads.
+     */
+    void RefitBoundingBoxTreesIfNodesHaveMoved();
+
+    /**
+     * Use the element bounding box tree to find the element with the lowest index that
+     * contains a test point.
+     *
+     * @param rTestPoint reference to the point
+     * @param strict whether the point must be in the interior of the element
+     * @return the element index, or UNSIGNED_UNSET if the tree finds no element containing the point.
+     */
+    unsigned GetContainingElementIndexUsingTree(const ChastePoint<SPACE_DIM>& rTestPoint, bool strict);
+
+    /**
+     * Use the node bounding box tree to find the nearest node to a test point.  If the
+     * node found has been deleted since the tree was built, the tree is rebuilt.
+     *
+     * @param rTestPoint reference to the point
+     * @return the position in mNodes of the nearest node, or UNSIGNED_UNSET if there are no nodes.
+     */
+    unsigned GetNearestNodeLocalIndexUsingTree(const ChastePoint<SPACE_DIM>& rTestPoint);
+
+    /**
+     * Add the global indices of the nodes which share an element with a given node (including
+     * the node itself) to a set.  These are the columns coupled to the node's rows in an FE matrix.
+     *
+     * @param pNode  a node owned by this process
+     * @param rConnectedNodes  set to which the node indices are added
+     */
+    virtual void AddConnectedNodeIndices(Node<SPACE_DIM>* pNode, std::set<unsigned>& rConnectedNodes);
+
 public:
 
     //////////////////////////////////////////////////////////////////////
@@ -562,6 +654,25 @@ public:
      */
     unsigned CalculateMaximumNodeConnectivityPerProcess() const;
 
+    /**
+     * Calculate the exact number of nonzero entries in each locally owned row of an FE matrix
+     * on this mesh, for PETSc preallocation (see PetscTools::SetupMat).  Unknowns are assumed
+     * to be interleaved, so that row problemDim*i+k holds unknown k at node i, and every unknown
+     * at a node to be coupled to every unknown at each connected node.  Entries are split into
+     * those in columns owned by this process (the diagonal block) and those in columns owned by
+     * other processes, i.e. at halo nodes (the off-diagonal block).
+     *
+     * Unlike CalculateMaximumNodeConnectivityPerProcess(), this does not over-allocate rows
+     * of nodes with few neighbours.
+     *
+     * @param problemDim  the number of unknowns per node
+     * @param rDiagonalNonZeros  filled with the number of diagonal block nonzeros, for each local row
+     * @param rOffDiagonalNonZeros  filled with the number of off-diagonal block nonzeros, for each local row
+     */
+    void CalculateLocalRowNonZeroCounts(unsigned problemDim,
+                                        std::vector<PetscInt>& rDiagonalNonZeros,
+                                        std::vector<PetscInt>& rOffDiagonalNonZeros);
+
     /**
      * Utility method to give the functionality of iterating through the halo nodes of a process. Will return an empty
      * std::vector (i.e. no halo nodes) unless overridden by distributed derived classes.
@@ -623,6 +734,89 @@ public:
      unsigned GetNearestElementIndexFromTestElements(const ChastePoint<SPACE_DIM>& rTestPoint,
                                                      std::set<unsigned> testElements);
 
+     /**
+      * As GetContainingElementIndex() with no test elements, for many points at once.
+      *
+      * @param rTestPoints the points
+      * @param strict  Should the element returned contain the point in the interior and
+      *      not on an edge/face/vertex (default = not strict)
+      * @return the index of the element containing each point, or UNSIGNED_UNSET for
+      *      points which are not in the mesh.
+      */
+     std::vector<unsigned> GetContainingElementIndexForEachPoint(const std::vector<ChastePoint<SPACE_DIM> >& rTestPoints,
+                                                                 bool strict=false);
+
+     /**
+      * Find the nearest node on this process to each of many points, using the node
+      * bounding box tree. Distances are Euclidean, even on periodic meshes.
+      *
+      * @param rTestPoints the points
+      * @return the global index of the nearest node to each point, or UNSIGNED_UNSET
+      *      if this process has no nodes.
+      */
+     std::vector<unsigned> GetNearestNodeIndexForEachPoint(const std::vector<ChastePoint<SPACE_DIM> >& rTestPoints);
+
+     /**
+      * @return the bounding volume hierarchy over the elements of the mesh, building it
+      * if necessary (for example after elements have been added).
+      *
+      * If any node has been moved since the trees were last built or refitted (by
+      * SetNode(), Node::SetPoint() or Node::rGetModifiableLocation()), they are refitted
+      * first; see Node::GetLocationGeneration().  This must therefore not be called while
+      * nodes are being moved on other threads.
+      */
+     BoundingBoxTree<SPACE_DIM>& rGetElementBoundingBoxTree();
+
+     /**
+      * @return the bounding volume hierarchy over the nodes of the mesh, building it
+      * if necessary (for example after nodes have been added).  Deleted nodes are left
+      * out, and box i holds the node at position mNodeBoundingBoxTreeIndices[i] in mNodes.
+      * Moved nodes are handled as in rGetElementBoundingBoxTree().
+      */
+     BoundingBoxTree<SPACE_DIM>& rGetNodeBoundingBoxTree();
+
+     /**
+      * Update the bounding box trees after nodes have moved, without rebuilding them.
+      * Trees which have not been built, or whose number of elements or nodes no longer
+      * matches the mesh, are discarded instead.  The trees are refitted automatically
+      * when used after nodes have moved, so this need not normally be called.
+      */
+     void RefitBoundingBoxTrees();
+
+     /**
+      * Discard the bounding box trees, so that they are rebuilt when next needed.
+      * Called when the connectivity of the mesh changes.
+      */
+     void ClearBoundingBoxTrees();
+
+     /**
+      * @return the precomputed Jacobian determinants, inverse Jacobians and linear basis function
+      * gradients of the elements of the mesh, building them if necessary.  Records are stored in
+      * the order in which the element iterator visits the elements.
+      *
+      * The data assume straight-sided elements, and are computed from the current node locations.
+      * If any node has been moved since the cache was built (by any means, see
+      * Node::GetLocationGeneration()) it is rebuilt, so this must not be called while nodes are
+      * being moved on other threads.  Any change of connectivity discards it.
+      */
+     const ElementGeometryCache<ELEMENT_DIM, SPACE_DIM>& rGetElementGeometryCache();
+
+     /**
+      * Discard the element geometry cache, so that it is rebuilt when next needed.
+      */
+     void ClearElementGeometryCache();
+
+     /**
+      * @return the memory used by the element geometry cache in bytes (zero if it has not been built)
+      */
+     std::size_t GetElementGeometryCacheMemoryUsage() const;
+
+     /**
+      * Overridden RefreshMesh() method, which refits the bounding box trees and discards the
+      * element geometry cache after nodes have moved.
+      */
+     virtual void RefreshMesh();
+
     //////////////////////////////////////////////////////////////////////
     //                         Nested classes                           //
     //////////////////////////////////////////////////////////////////////
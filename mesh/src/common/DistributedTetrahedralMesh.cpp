@@ -1641,8 +1641,13 @@ ChasteCuboid<SPACE_DIM> DistributedTetrahedralMesh<ELEMENT_DIM, SPACE_DIM>::Calc
 template <unsigned ELEMENT_DIM, unsigned SPACE_DIM>
 unsigned DistributedTetrahedralMesh<ELEMENT_DIM, SPACE_DIM>::GetNearestNodeIndex(const ChastePoint<SPACE_DIM>& rTestPoint)
 {
-    // Call base method to find closest on local processor
-    unsigned best_node_index = AbstractMesh<ELEMENT_DIM, SPACE_DIM>::GetNearestNodeIndex(rTestPoint);
+    // Find the closest node on this process, using the node bounding box tree
+    unsigned best_node_index = UINT_MAX;
+    unsigned local_index = this->GetNearestNodeLocalIndexUsingTree(rTestPoint);
+    if (local_index != UNSIGNED_UNSET)
+    {
+        best_node_index = this->mNodes[local_index]->GetIndex();
+    }
 
     // Recalculate the distance to the best node (if this process has one)
     double best_node_point_distance = DBL_MAX;
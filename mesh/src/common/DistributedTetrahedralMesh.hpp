@@ -301,10 +301,11 @@ public:
      */
     virtual ChasteCuboid<SPACE_DIM> CalculateBoundingBox() const;
 
-    /** GetNearestNodeIndex iterates through all nodes in the mesh and returns the global index
-      * with the smallest distance to the provided point.
+    /** GetNearestNodeIndex finds the node in the mesh with the smallest distance to the provided
+      * point, and returns its global index.
       *
-      * This method is overridden in the distributed case to return the global node index.
+      * This method is overridden in the distributed case to return the global node index. Each process
+      * searches its own nodes using the node bounding box tree.
       *
       * @param rTestPoint reference to the point
       * @return node index
@@ -198,6 +198,21 @@ typename MixedDimensionMesh<ELEMENT_DIM, SPACE_DIM>::CableRangeAtNode MixedDimen
     return mNodeToCablesMapping.equal_range(pNode);
 }
 
+template <unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+void MixedDimensionMesh<ELEMENT_DIM, SPACE_DIM>::AddConnectedNodeIndices(Node<SPACE_DIM>* pNode, std::set<unsigned>& rConnectedNodes)
+{
+    AbstractTetrahedralMesh<ELEMENT_DIM, SPACE_DIM>::AddConnectedNodeIndices(pNode, rConnectedNodes);
+
+    CableRangeAtNode cable_range = GetCablesAtNode(pNode);
+    for (NodeCableIterator it = cable_range.first; it != cable_range.second; ++it)
+    {
+        for (unsigned i=0; i<it->second->GetNumNodes(); i++)
+        {
+            rConnectedNodes.insert(it->second->GetNodeGlobalIndex(i));
+        }
+    }
+}
+
 
 template <unsigned ELEMENT_DIM, unsigned SPACE_DIM>
 typename MixedDimensionMesh<ELEMENT_DIM, SPACE_DIM>::CableElementIterator MixedDimensionMesh<ELEMENT_DIM, SPACE_DIM>::GetCableElementIteratorBegin() const
@@ -119,6 +119,16 @@ public:
       */
      CableRangeAtNode GetCablesAtNode(const Node<SPACE_DIM>* pNode);
 
+protected:
+    /**
+     * Overridden AddConnectedNodeIndices() method, which also adds the nodes connected
+     * to the given node by cable elements.
+     *
+     * @param pNode  a node owned by this process
+     * @param rConnectedNodes  set to which the node indices are added
+     */
+    void AddConnectedNodeIndices(Node<SPACE_DIM>* pNode, std::set<unsigned>& rConnectedNodes);
+
 private:
     /** The elements making up the 1D cables */
     std::vector<Element<1u, SPACE_DIM>*> mCableElements;
@@ -311,6 +311,9 @@ void MutableMesh<ELEMENT_DIM, SPACE_DIM>::MoveMergeNode(unsigned index,
         EXCEPTION("Trying to move a deleted node");
     }
 
+    this->ClearBoundingBoxTrees();
+    this->ClearElementGeometryCache();
+
     if (index == targetIndex)
     {
         EXCEPTION("Trying to merge a node with itself");
@@ -460,6 +463,9 @@ unsigned MutableMesh<ELEMENT_DIM, SPACE_DIM>::RefineElement(
     Element<ELEMENT_DIM,SPACE_DIM>* pElement,
     ChastePoint<SPACE_DIM> point)
 {
+    this->ClearBoundingBoxTrees();
+    this->ClearElementGeometryCache();
+
     //Check that the point is in the element
     if (pElement->IncludesPoint(point, true) == false)
     {
@@ -678,6 +684,9 @@ void MutableMesh<ELEMENT_DIM, SPACE_DIM>::ReMesh(NodeMap& map)
     // Make sure that we are in the correct dimension - this code will be eliminated at compile time
     assert( ELEMENT_DIM == SPACE_DIM ); // LCOV_EXCL_LINE
 
+    this->ClearBoundingBoxTrees();
+    this->ClearElementGeometryCache();
+
     // Avoid some triangle/tetgen errors: need at least four
     // nodes for tetgen, and at least three for triangle
     if (GetNumNodes() <= SPACE_DIM)
@@ -913,6 +922,9 @@ c_vector<unsigned, 3> MutableMesh<ELEMENT_DIM, SPACE_DIM>::SplitEdge(Node<SPACE_
 {
     c_vector<unsigned, 3> new_node_index_vector;
 
+    this->ClearBoundingBoxTrees();
+    this->ClearElementGeometryCache();
+
     std::set<unsigned> elements_of_node_a = pNodeA->rGetContainingElementIndices();
     std::set<unsigned> elements_of_node_b = pNodeB->rGetContainingElementIndices();
 
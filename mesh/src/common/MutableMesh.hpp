@@ -234,6 +234,12 @@ public:
      * Move the node with a particular index to a new point in space and
      * verifies that the signed areas of the supporting Elements are positive.
      *
+     * Without a concrete move this may be called for different nodes from several threads
+     * at once, so the cached Jacobians are not updated; call RefreshMesh() or ReMesh() once
+     * all nodes have been moved.  A concrete move updates the Jacobians of the elements
+     * containing the node.  In either case the bounding box trees are refitted, and the
+     * element geometry cache rebuilt, when next used.
+     *
      * @param index is the index of the node to be moved
      * @param point is the new target location of the node
      * @param concreteMove is set to false if we want to skip the signed area tests (defaults to true)
@@ -38,6 +38,12 @@ OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "Node.hpp"
 #include "Exception.hpp"
 
+template<unsigned SPACE_DIM>
+bool Node<SPACE_DIM>::msLocationsMayHaveChanged = true;
+
+template<unsigned SPACE_DIM>
+unsigned Node<SPACE_DIM>::msLocationGeneration = 0;
+
 //////////////////////////////////////////////////////////////////////////
 // Constructors
 //////////////////////////////////////////////////////////////////////////
@@ -50,6 +56,7 @@ void Node<SPACE_DIM>::CommonConstructor(unsigned index, bool isBoundaryNode)
     mIsInternal = false;
     mIsDeleted = false;
     mpNodeAttributes = NULL;
+    MarkLocationsChanged();
 }
 
 template<unsigned SPACE_DIM>
@@ -115,6 +122,7 @@ template<unsigned SPACE_DIM>
 void Node<SPACE_DIM>::SetPoint(ChastePoint<SPACE_DIM> point)
 {
     mLocation = point.rGetLocation();
+    MarkLocationsChanged();
 }
 
 template<unsigned SPACE_DIM>
@@ -151,9 +159,39 @@ template<unsigned SPACE_DIM>
 c_vector<double, SPACE_DIM>& Node<SPACE_DIM>::rGetModifiableLocation()
 {
     assert(!mIsDeleted);
+    MarkLocationsChanged();
     return mLocation;
 }
 
+template<unsigned SPACE_DIM>
+void Node<SPACE_DIM>::MarkLocationsChanged()
+{
+    // Read the flag first, so that once it is set the threads moving nodes do not keep writing to it
+    bool may_have_changed;
+#ifdef CHASTE_OPENMP
+#pragma omp atomic read
+#endif // CHASTE_OPENMP
+    may_have_changed = msLocationsMayHaveChanged;
+    if (!may_have_changed)
+    {
+#ifdef CHASTE_OPENMP
+#pragma omp atomic write
+#endif // CHASTE_OPENMP
+        msLocationsMayHaveChanged = true;
+    }
+}
+
+template<unsigned SPACE_DIM>
+unsigned Node<SPACE_DIM>::GetLocationGeneration()
+{
+    if (msLocationsMayHaveChanged)
+    {
+        msLocationGeneration++;
+        msLocationsMayHaveChanged = false;
+    }
+    return msLocationGeneration;
+}
+
 template<unsigned SPACE_DIM>
 unsigned Node<SPACE_DIM>::GetIndex() const
 {
@@ -86,6 +86,22 @@ private:
     /** Set of indices of boundary elements containing this node as a vertex. */
     std::set<unsigned> mBoundaryElementIndices;
 
+    /**
+     * Whether a node of this dimension may have been created or moved since
+     * msLocationGeneration was last updated (see GetLocationGeneration()).
+     */
+    static bool msLocationsMayHaveChanged;
+
+    /** Counts the updates of node locations seen by GetLocationGeneration(). */
+    static unsigned msLocationGeneration;
+
+    /**
+     * Record that a node of this dimension may have been created or moved.  This may be
+     * called from several threads at once (for example when a cell-based simulation moves
+     * nodes in parallel), so it only ever sets msLocationsMayHaveChanged.
+     */
+    static void MarkLocationsChanged();
+
     /** Needed for serialization. */
     friend class boost::serialization::access;
     friend class TestNode;
@@ -240,6 +256,16 @@ public:
      */
     c_vector<double, SPACE_DIM>& rGetModifiableLocation();
 
+    /**
+     * @return a number which changes whenever a node of this dimension may have been
+     * created or moved (by SetPoint() or rGetModifiableLocation()) since the previous
+     * call.  Meshes use this to tell when data derived from node locations, such as
+     * bounding box trees, must be recomputed.
+     *
+     * This must not be called while nodes are being moved on other threads.
+     */
+    static unsigned GetLocationGeneration();
+
     /**
      * @return the index of this node in the mesh.
      */
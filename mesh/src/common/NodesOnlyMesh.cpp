@@ -45,7 +45,9 @@ NodesOnlyMesh<SPACE_DIM>::NodesOnlyMesh()
           mMinimumNodeDomainBoundarySeparation(1.0),
           mMaxAddedNodeIndex(0u),
           mpBoxCollection(NULL),
-          mCalculateNodeNeighbours(true)
+          mCalculateNodeNeighbours(true),
+          mUseCellLists(false),
+          mVerletSkin(0.0)
 {
 }
 
@@ -214,6 +216,47 @@ void NodesOnlyMesh<SPACE_DIM>::SetCalculateNodeNeighbours(bool calculateNodeNeig
     mCalculateNodeNeighbours = calculateNodeNeighbours;
 }
 
+template<unsigned SPACE_DIM>
+void NodesOnlyMesh<SPACE_DIM>::SetUseCellLists(bool useCellLists)
+{
+    mUseCellLists = useCellLists;
+
+    if (mpBoxCollection)
+    {
+        mpBoxCollection->SetUseCellLists(mUseCellLists);
+    }
+}
+
+template<unsigned SPACE_DIM>
+void NodesOnlyMesh<SPACE_DIM>::SetVerletSkin(double verletSkin)
+{
+    if (verletSkin < 0.0)
+    {
+        EXCEPTION("The Verlet skin must be non-negative.");
+    }
+    if (mpBoxCollection && PetscTools::IsParallel())
+    {
+        EXCEPTION("The Verlet skin must be set before the nodes are distributed between processes.");
+    }
+
+    mVerletSkin = verletSkin;
+
+    if (mpBoxCollection)
+    {
+        // The boxes must be widened by the skin, so set up the box collection again on the same domain
+        c_vector<double, 2*SPACE_DIM> domain_size = mpBoxCollection->rGetDomainSize();
+        bool is_periodic = mpBoxCollection->GetIsPeriodicInX();
+        SetUpBoxCollection(mMaximumInteractionDistance, domain_size, PETSC_DECIDE, is_periodic);
+        UpdateBoxCollection();
+    }
+}
+
+template<unsigned SPACE_DIM>
+double NodesOnlyMesh<SPACE_DIM>::GetVerletSkin() const
+{
+    return mVerletSkin;
+}
+
 template<unsigned SPACE_DIM>
 void NodesOnlyMesh<SPACE_DIM>::CalculateInteriorNodePairs(std::vector<std::pair<Node<SPACE_DIM>*, Node<SPACE_DIM>*> >& rNodePairs)
 {
@@ -235,8 +278,17 @@ void NodesOnlyMesh<SPACE_DIM>::ReMesh(NodeMap& map)
 {
     map.ResetToIdentity();
 
+    // The node bounding box tree refers to nodes by their position in mNodes
+    this->ClearBoundingBoxTrees();
+
     RemoveDeletedNodes(map);
 
+    // The box collection may hold pointers to deleted nodes in its Verlet list
+    if (mpBoxCollection)
+    {
+        mpBoxCollection->ResetVerletList();
+    }
+
     this->mDeletedNodeIndices.clear();
     this->mAddedNodes = false;
 
@@ -354,6 +406,11 @@ void NodesOnlyMesh<SPACE_DIM>::AddNodeWithFixedIndex(Node<SPACE_DIM>* pNewNode)
     // Update mNodesMapping
     mNodesMapping[pNewNode->GetIndex()] = location_in_nodes_vector;
 
+    if (mpBoxCollection)
+    {
+        mpBoxCollection->ResetVerletList();
+    }
+
     // Then update cell radius to default.
     pNewNode->SetRadius(0.5);
 }
@@ -437,6 +494,11 @@ void NodesOnlyMesh<SPACE_DIM>::DeleteNode(unsigned index)
     this->mNodes[local_index]->MarkAsDeleted();
     this->mDeletedNodeIndices.push_back(local_index);
     mDeletedGlobalNodeIndices.push_back(index);
+
+    if (mpBoxCollection)
+    {
+        mpBoxCollection->ResetVerletList();
+    }
 }
 
 template<unsigned SPACE_DIM>
@@ -487,13 +549,15 @@ void NodesOnlyMesh<SPACE_DIM>::EnlargeBoxCollection()
     c_vector<double, 2*SPACE_DIM> current_domain_size = mpBoxCollection->rGetDomainSize();
     c_vector<double, 2*SPACE_DIM> new_domain_size = current_domain_size;
 
+    // Add one box (which is wider than the interaction distance when using a Verlet skin) to each side
+    double box_width = mpBoxCollection->GetBoxWidth();
     double fudge = 1e-14;
     // We don't enlarge the x direction if periodic
     unsigned d0 = ( mpBoxCollection->GetIsPeriodicInX() ) ? 1 : 0;
     for (unsigned d=d0; d < SPACE_DIM; d++)
     {
-        new_domain_size[2*d] = current_domain_size[2*d] - (mMaximumInteractionDistance - fudge);
-        new_domain_size[2*d+1] = current_domain_size[2*d+1] + (mMaximumInteractionDistance - fudge);
+        new_domain_size[2*d] = current_domain_size[2*d] - (box_width - fudge);
+        new_domain_size[2*d+1] = current_domain_size[2*d+1] + (box_width - fudge);
     }
     SetUpBoxCollection(mMaximumInteractionDistance, new_domain_size, new_local_rows);
 }
@@ -576,9 +640,12 @@ void NodesOnlyMesh<SPACE_DIM>::SetUpBoxCollection(double cutOffLength, c_vector<
 {
      ClearBoxCollection();
 
-     mpBoxCollection = new DistributedBoxCollection<SPACE_DIM>(cutOffLength, domainSize, isPeriodic, numLocalRows);
+     // Widen the boxes by the Verlet skin so that the Verlet lists hold every pair within the cut off length
+     mpBoxCollection = new DistributedBoxCollection<SPACE_DIM>(cutOffLength + mVerletSkin, domainSize, isPeriodic, numLocalRows);
      mpBoxCollection->SetupLocalBoxesHalfOnly();
      mpBoxCollection->SetCalculateNodeNeighbours(mCalculateNodeNeighbours);
+     mpBoxCollection->SetUseCellLists(mUseCellLists);
+     mpBoxCollection->SetVerletSkin(mVerletSkin, cutOffLength);
 }
 
 template<unsigned SPACE_DIM>
@@ -119,6 +119,12 @@ private:
     /** Whether to calculate node neighbours in the box collection. Switch off for efficiency */
     bool mCalculateNodeNeighbours;
 
+    /** Whether the box collection should calculate node pairs using cell lists. Not archived. */
+    bool mUseCellLists;
+
+    /** The Verlet skin passed to the box collection. Not archived. */
+    double mVerletSkin;
+
     /**
      * Calculate the next unique global index available on this
      * process. Uses a hashing function to ensure that a unique
@@ -181,7 +187,7 @@ protected:
     /**
      * Set up the box collection. Overridden in subclasses to implement periodicity.
      *
-     * @param cutOffLength the cut off length for node neighbours.
+     * @param cutOffLength the cut off length for node neighbours; the boxes are this plus the Verlet skin wide.
      * @param domainSize the size of the domain containing the nodes.
      * @param numLocalRows the number of rows that should be owned by this process.
      * @param isPeriodic whether the DistributedBoxCollection should be periodic.
@@ -305,6 +311,30 @@ public:
      */
     void SetCalculateNodeNeighbours(bool calculateNodeNeighbours);
 
+    /**
+     * Set whether the box collection calculates node pairs using contiguous cell lists.
+     * See DistributedBoxCollection::SetUseCellLists().
+     *
+     * @param useCellLists whether to use cell lists.
+     */
+    void SetUseCellLists(bool useCellLists);
+
+    /**
+     * Set the skin of the Verlet lists used by the box collection when cell lists are in use.
+     * The boxes are widened by the skin, so node pairs are still found up to the maximum
+     * interaction distance. If the box collection already exists it is set up again; in
+     * parallel the skin must therefore be set before ConstructNodesWithoutMesh().
+     * See DistributedBoxCollection::SetVerletSkin().
+     *
+     * @param verletSkin the skin; must be non-negative.
+     */
+    void SetVerletSkin(double verletSkin);
+
+    /**
+     * @return #mVerletSkin
+     */
+    double GetVerletSkin() const;
+
     /**
      * Calculate pairs of nodes from interior boxes using the BoxCollection.
      *
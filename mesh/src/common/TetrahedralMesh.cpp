@@ -420,8 +420,47 @@ template <unsigned ELEMENT_DIM, unsigned SPACE_DIM>
 unsigned TetrahedralMesh<ELEMENT_DIM, SPACE_DIM>::GetNearestElementIndex(const ChastePoint<SPACE_DIM>& rTestPoint)
 {
     EXCEPT_IF_NOT(ELEMENT_DIM == SPACE_DIM);  // LCOV_EXCL_LINE // CalculateInterpolationWeights hits an assertion otherwise
+
     double max_min_weight = -std::numeric_limits<double>::infinity();
     unsigned closest_index = 0;
+
+    /*
+     * Elements whose (padded) bounding boxes do not contain the point have a negative
+     * interpolation weight, so if one of the elements found by the bounding box tree has
+     * no negative weights it is the element that a search through all elements would
+     * choose: the first with the largest sum of negative weights.
+     */
+    std::vector<unsigned> candidates;
+    this->rGetElementBoundingBoxTree().GetBoxesContainingPoint(rTestPoint.rGetLocation(), candidates);
+    for (unsigned k=0; k<candidates.size(); k++)
+    {
+        unsigned i = candidates[k];
+        if (this->mElements[i]->IsDeleted())
+        {
+            continue;
+        }
+        c_vector<double, ELEMENT_DIM+1> weight = this->mElements[i]->CalculateInterpolationWeights(rTestPoint);
+        double neg_weight_sum = 0.0;
+        for (unsigned j=0; j<=ELEMENT_DIM; j++)
+        {
+            if (weight[j] < 0.0)
+            {
+                neg_weight_sum += weight[j];
+            }
+        }
+        if (neg_weight_sum > max_min_weight)
+        {
+            max_min_weight = neg_weight_sum;
+            closest_index = i;
+        }
+    }
+    if (max_min_weight == 0.0)
+    {
+        return closest_index;
+    }
+
+    max_min_weight = -std::numeric_limits<double>::infinity();
+    closest_index = 0;
     for (unsigned i=0; i<this->mElements.size(); i++)
     {
         c_vector<double, ELEMENT_DIM+1> weight = this->mElements[i]->CalculateInterpolationWeights(rTestPoint);
@@ -461,6 +500,9 @@ std::vector<unsigned> TetrahedralMesh<ELEMENT_DIM, SPACE_DIM>::GetContainingElem
 template <unsigned ELEMENT_DIM, unsigned SPACE_DIM>
 void TetrahedralMesh<ELEMENT_DIM, SPACE_DIM>::Clear()
 {
+    this->ClearBoundingBoxTrees();
+    this->ClearElementGeometryCache();
+
     // Three loops, just like the destructor. note we don't delete boundary nodes.
     for (unsigned i=0; i<this->mBoundaryElements.size(); i++)
     {
@@ -648,6 +690,7 @@ typename TetrahedralMesh<ELEMENT_DIM, SPACE_DIM>::EdgeIterator TetrahedralMesh<E
 template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
 void TetrahedralMesh<ELEMENT_DIM, SPACE_DIM>::RefreshMesh()
 {
+    AbstractTetrahedralMesh<ELEMENT_DIM, SPACE_DIM>::RefreshMesh();
     RefreshJacobianCachedData();
 }
 
@@ -45,12 +45,13 @@ Cylindrical2dNodesOnlyMesh::Cylindrical2dNodesOnlyMesh(double width)
 
 void Cylindrical2dNodesOnlyMesh::SetUpBoxCollection(double cutOffLength, c_vector<double, 2*2> domainSize, int numLocalRows, bool isPeriodic)
 {
-    // Ensure that the width is a multiple of cut-off length
-    if (fmod( mWidth,cutOffLength ) > 1e-14)
+    // Ensure that the width is a multiple of the box width, which includes any Verlet skin
+    double box_width = cutOffLength + GetVerletSkin();
+    if (fmod( mWidth,box_width ) > 1e-14)
     {
         EXCEPTION("The periodic width must be a multiple of cut off length.");
     }
-    else if (mWidth/cutOffLength == 2.0)
+    else if (mWidth/box_width == 2.0)
     {
         // A width of two boxes gives different simulation results as some connections are considered twice.
         EXCEPTION( "The periodic domain width cannot be 2*CutOffLength." );
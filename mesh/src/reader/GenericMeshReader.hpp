@@ -43,6 +43,7 @@ OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 // Possible mesh reader classes to create
 #include "TrianglesMeshReader.hpp"
+#include "MappedMeshReader.hpp"
 #include "MemfemMeshReader.hpp"
 #include "VtkMeshReader.hpp"
 
@@ -50,6 +51,7 @@ OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
  * This function creates a mesh reader of a suitable type to read the mesh file given.
  * It can use any of the following readers:
  *  - TrianglesMeshReader
+ *  - MappedMeshReader
  *  - MemfemMeshReader
  *  - VtkMeshReader
  *
@@ -87,29 +89,37 @@ std::auto_ptr<AbstractMeshReader<ELEMENT_DIM, SPACE_DIM> > GenericMeshReader(con
 
         try
         {
-            p_reader.reset(new MemfemMeshReader<ELEMENT_DIM, SPACE_DIM>(rPathBaseName));
+            p_reader.reset(new MappedMeshReader<ELEMENT_DIM, SPACE_DIM>(rPathBaseName));
         }
-        catch (const Exception& r_memfem_exception)
+        catch (const Exception& r_mapped_exception)
         {
-#ifdef CHASTE_VTK
             try
             {
-                p_reader.reset(new VtkMeshReader<ELEMENT_DIM, SPACE_DIM>(rPathBaseName));
+                p_reader.reset(new MemfemMeshReader<ELEMENT_DIM, SPACE_DIM>(rPathBaseName));
             }
-            catch (const Exception& r_vtk_exception)
+            catch (const Exception& r_memfem_exception)
             {
+#ifdef CHASTE_VTK
+                try
+                {
+                    p_reader.reset(new VtkMeshReader<ELEMENT_DIM, SPACE_DIM>(rPathBaseName));
+                }
+                catch (const Exception& r_vtk_exception)
+                {
 #endif // CHASTE_VTK
-                std::string eol("\n");
-                std::string combined_message = "Could not open appropriate mesh files for " + rPathBaseName + eol;
-                combined_message += "Triangle format: " + r_triangles_exception.GetShortMessage() + eol;
-                combined_message += "Memfem format: " + r_memfem_exception.GetShortMessage() + eol;
+                    std::string eol("\n");
+                    std::string combined_message = "Could not open appropriate mesh files for " + rPathBaseName + eol;
+                    combined_message += "Triangle format: " + r_triangles_exception.GetShortMessage() + eol;
+                    combined_message += "Mapped format: " + r_mapped_exception.GetShortMessage() + eol;
+                    combined_message += "Memfem format: " + r_memfem_exception.GetShortMessage() + eol;
 #ifdef CHASTE_VTK
-                combined_message += "Vtk format: " + r_vtk_exception.GetShortMessage() + eol;
+                    combined_message += "Vtk format: " + r_vtk_exception.GetShortMessage() + eol;
 #endif // CHASTE_VTK
-                EXCEPTION(combined_message);
+                    EXCEPTION(combined_message);
 #ifdef CHASTE_VTK
-            }
+                }
 #endif // CHASTE_VTK
+            }
         }
     }
     return p_reader;
@@ -0,0 +1,87 @@
+/*
+
+Copyright (c) 2005-2017, University of Oxford.
+All rights reserved.
+
+University of Oxford means the Chancellor, Masters and Scholars of the
+University of Oxford, having an administrative office at Wellington
+Square, Oxford OX1 2JD, UK.
+
+This file is part of Chaste.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+ * Redistributions of source code must retain the above copyright notice,
+   this list of conditions and the following disclaimer.
+ * Redistributions in binary form must reproduce the above copyright notice,
+   this list of conditions and the following disclaimer in the documentation
+   and/or other materials provided with the distribution.
+ * Neither the name of the University of Oxford nor the names of its
+   contributors may be used to endorse or promote products derived from this
+   software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+*/
+
+
+#ifndef MAPPEDMESHFORMAT_HPP_
+#define MAPPEDMESHFORMAT_HPP_
+
+#include <boost/cstdint.hpp>
+
+/**
+ * Layout of the indexed binary mesh container written by MappedMeshWriter
+ * and read by MappedMeshReader.
+ *
+ * The file holds this header followed by fixed-width sections, each starting at
+ * the byte offset recorded in the header:
+ *  - nodes: SPACE_DIM doubles per node;
+ *  - elements: NodesPerElement unsigned node indices and one double attribute per element;
+ *  - faces: NodesPerFace unsigned node indices and one double attribute per boundary element;
+ *  - node connectivity list (NCL): NumNodes+1 64-bit offsets into the following
+ *    array of unsigned containing-element indices, in compressed row format.
+ *
+ * Since every record has a fixed width (and the NCL is indexed) any node, element
+ * or connectivity row can be located without reading the rest of the file.
+ * Data are stored in native byte order; the Endianness field is checked on reading.
+ */
+struct MappedMeshHeader
+{
+    char Magic[8];                   /**< Identifies the file format (MAPPED_MESH_MAGIC). */
+    boost::uint32_t Version;         /**< Format version (MAPPED_MESH_VERSION). */
+    boost::uint32_t Endianness;      /**< Always 1 in the writer's byte order. */
+    boost::uint32_t ElementDim;      /**< Element dimension of the mesh. */
+    boost::uint32_t SpaceDim;        /**< Space dimension of the mesh. */
+    boost::uint32_t NumNodes;        /**< Number of node records. */
+    boost::uint32_t NumElements;     /**< Number of element records. */
+    boost::uint32_t NumFaces;        /**< Number of boundary element records. */
+    boost::uint32_t NodesPerElement; /**< Number of node indices in each element record. */
+    boost::uint32_t NodesPerFace;    /**< Number of node indices in each face record. */
+    boost::uint32_t Padding;         /**< Unused; keeps the offsets below 8-byte aligned. */
+    boost::uint64_t NodesOffset;     /**< Byte offset of the node section. */
+    boost::uint64_t ElementsOffset;  /**< Byte offset of the element section. */
+    boost::uint64_t FacesOffset;     /**< Byte offset of the face section. */
+    boost::uint64_t NclIndexOffset;  /**< Byte offset of the NCL row offsets. */
+    boost::uint64_t NclDataOffset;   /**< Byte offset of the NCL containing-element indices. */
+};
+
+/** Magic number at the start of every mapped mesh file. */
+static const char MAPPED_MESH_MAGIC[8] = {'C', 'H', 'M', 'E', 'S', 'H', 'M', 'M'};
+
+/** Version of the format written by MappedMeshWriter. */
+static const boost::uint32_t MAPPED_MESH_VERSION = 1u;
+
+/** File extension of mapped mesh files. */
+static const char* const MAPPED_MESH_FILE_EXTENSION = ".cmesh";
+
+#endif // MAPPEDMESHFORMAT_HPP_
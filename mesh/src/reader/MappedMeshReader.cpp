@@ -0,0 +1,319 @@
+/*
+
+Copyright (c) 2005-2017, University of Oxford.
+All rights reserved.
+
+University of Oxford means the Chancellor, Masters and Scholars of the
+University of Oxford, having an administrative office at Wellington
+Square, Oxford OX1 2JD, UK.
+
+This file is part of Chaste.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+ * Redistributions of source code must retain the above copyright notice,
+   this list of conditions and the following disclaimer.
+ * Redistributions in binary form must reproduce the above copyright notice,
+   this list of conditions and the following disclaimer in the documentation
+   and/or other materials provided with the distribution.
+ * Neither the name of the University of Oxford nor the names of its
+   contributors may be used to endorse or promote products derived from this
+   software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+*/
+
+
+#include "MappedMeshReader.hpp"
+
+#include <cassert>
+#include <cstring>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "Exception.hpp"
+
+template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+MappedMeshReader<ELEMENT_DIM, SPACE_DIM>::MappedMeshReader(const std::string& pathBaseName)
+    : mFilesBaseName(pathBaseName),
+      mpData(NULL),
+      mDataSize(0),
+      mNodeItemWidth(SPACE_DIM*sizeof(double)),
+      mElementItemWidth(0),
+      mFaceItemWidth(0),
+      mNclSize(0),
+      mNodesRead(0),
+      mElementsRead(0),
+      mFacesRead(0)
+{
+    std::string file_name = mFilesBaseName + MAPPED_MESH_FILE_EXTENSION;
+    int fd = open(file_name.c_str(), O_RDONLY);
+    if (fd == -1)
+    {
+        EXCEPTION("Could not open data file: " + file_name);
+    }
+
+    struct stat file_status;
+    if (fstat(fd, &file_status) != 0 || (std::size_t)file_status.st_size < sizeof(MappedMeshHeader))
+    {
+        close(fd);
+        EXCEPTION("Mapped mesh file " + file_name + " is too short to hold a header.");
+    }
+    mDataSize = file_status.st_size;
+
+    void* p_map = mmap(NULL, mDataSize, PROT_READ, MAP_SHARED, fd, 0);
+    close(fd); // The mapping stays valid without the descriptor
+    if (p_map == MAP_FAILED)
+    {
+        // LCOV_EXCL_START
+        EXCEPTION("Could not memory map mesh file " + file_name);
+        // LCOV_EXCL_STOP
+    }
+    mpData = static_cast<const char*>(p_map);
+
+    memcpy(&mHeader, mpData, sizeof(MappedMeshHeader));
+    try
+    {
+        if (memcmp(mHeader.Magic, MAPPED_MESH_MAGIC, sizeof(MAPPED_MESH_MAGIC)) != 0)
+        {
+            EXCEPTION("File " + file_name + " is not a mapped mesh file.");
+        }
+        if (mHeader.Endianness != 1u)
+        {
+            EXCEPTION("Mapped mesh file " + file_name + " was written with a different byte order.");
+        }
+        if (mHeader.Version != MAPPED_MESH_VERSION)
+        {
+            EXCEPTION("Mapped mesh file " << file_name << " has unsupported format version " << mHeader.Version << ".");
+        }
+        if (mHeader.ElementDim != ELEMENT_DIM || mHeader.SpaceDim != SPACE_DIM)
+        {
+            EXCEPTION("Mapped mesh file " << file_name << " holds a " << mHeader.ElementDim << "-in-" << mHeader.SpaceDim
+                      << " mesh, not a " << ELEMENT_DIM << "-in-" << SPACE_DIM << " mesh.");
+        }
+        if (mHeader.NodesPerElement != ELEMENT_DIM+1)
+        {
+            EXCEPTION("Mapped mesh files only support linear elements.");
+        }
+
+        mElementItemWidth = mHeader.NodesPerElement*sizeof(boost::uint32_t) + sizeof(double);
+        mFaceItemWidth = mHeader.NodesPerFace*sizeof(boost::uint32_t) + sizeof(double);
+
+        CheckSection(mHeader.NodesOffset, (boost::uint64_t)mHeader.NumNodes*mNodeItemWidth);
+        CheckSection(mHeader.ElementsOffset, (boost::uint64_t)mHeader.NumElements*mElementItemWidth);
+        CheckSection(mHeader.FacesOffset, (boost::uint64_t)mHeader.NumFaces*mFaceItemWidth);
+        CheckSection(mHeader.NclIndexOffset, ((boost::uint64_t)mHeader.NumNodes+1)*sizeof(boost::uint64_t));
+
+        memcpy(&mNclSize, mpData + mHeader.NclIndexOffset + mHeader.NumNodes*sizeof(boost::uint64_t), sizeof(boost::uint64_t));
+        CheckSection(mHeader.NclDataOffset, mNclSize*sizeof(boost::uint32_t));
+    }
+    catch (const Exception&)
+    {
+        munmap(const_cast<char*>(mpData), mDataSize);
+        throw;
+    }
+}
+
+template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+MappedMeshReader<ELEMENT_DIM, SPACE_DIM>::~MappedMeshReader()
+{
+    munmap(const_cast<char*>(mpData), mDataSize);
+}
+
+template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+void MappedMeshReader<ELEMENT_DIM, SPACE_DIM>::CheckSection(boost::uint64_t offset, boost::uint64_t size) const
+{
+    if (offset < sizeof(MappedMeshHeader) || offset > mDataSize || size > mDataSize - offset)
+    {
+        EXCEPTION("Mapped mesh file " + mFilesBaseName + MAPPED_MESH_FILE_EXTENSION + " is truncated or corrupt.");
+    }
+}
+
+template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+ElementData MappedMeshReader<ELEMENT_DIM, SPACE_DIM>::ReadItem(std::size_t offset, unsigned numNodes) const
+{
+    ElementData item;
+    item.NodeIndices.resize(numNodes);
+    const char* p_item = mpData + offset;
+    for (unsigned i=0; i<numNodes; i++)
+    {
+        boost::uint32_t node_index;
+        memcpy(&node_index, p_item + i*sizeof(boost::uint32_t), sizeof(boost::uint32_t));
+        item.NodeIndices[i] = node_index;
+    }
+    memcpy(&item.AttributeValue, p_item + numNodes*sizeof(boost::uint32_t), sizeof(double));
+    item.ContainingElement = 0;
+    return item;
+}
+
+template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+unsigned MappedMeshReader<ELEMENT_DIM, SPACE_DIM>::GetNumElements() const
+{
+    return mHeader.NumElements;
+}
+
+template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+unsigned MappedMeshReader<ELEMENT_DIM, SPACE_DIM>::GetNumNodes() const
+{
+    return mHeader.NumNodes;
+}
+
+template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+unsigned MappedMeshReader<ELEMENT_DIM, SPACE_DIM>::GetNumFaces() const
+{
+    return mHeader.NumFaces;
+}
+
+template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+unsigned MappedMeshReader<ELEMENT_DIM, SPACE_DIM>::GetNumElementAttributes() const
+{
+    return 1u;
+}
+
+template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+unsigned MappedMeshReader<ELEMENT_DIM, SPACE_DIM>::GetNumFaceAttributes() const
+{
+    return 1u;
+}
+
+template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+void MappedMeshReader<ELEMENT_DIM, SPACE_DIM>::Reset()
+{
+    mNodesRead = 0;
+    mElementsRead = 0;
+    mFacesRead = 0;
+}
+
+template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+std::vector<double> MappedMeshReader<ELEMENT_DIM, SPACE_DIM>::GetNextNode()
+{
+    if (mNodesRead >= mHeader.NumNodes)
+    {
+        EXCEPTION("Cannot get the next line from node file due to incomplete data");
+    }
+    std::vector<double> coords(SPACE_DIM);
+    memcpy(&coords[0], mpData + mHeader.NodesOffset + mNodesRead*mNodeItemWidth, mNodeItemWidth);
+    mNodesRead++;
+    return coords;
+}
+
+template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+ElementData MappedMeshReader<ELEMENT_DIM, SPACE_DIM>::GetNextElementData()
+{
+    if (mElementsRead >= mHeader.NumElements)
+    {
+        EXCEPTION("Cannot get the next line from element file due to incomplete data");
+    }
+    ElementData element = ReadItem(mHeader.ElementsOffset + mElementsRead*mElementItemWidth, mHeader.NodesPerElement);
+    mElementsRead++;
+    return element;
+}
+
+template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+ElementData MappedMeshReader<ELEMENT_DIM, SPACE_DIM>::GetNextFaceData()
+{
+    if (mFacesRead >= mHeader.NumFaces)
+    {
+        EXCEPTION("Cannot get the next line from face file due to incomplete data");
+    }
+    ElementData face = ReadItem(mHeader.FacesOffset + mFacesRead*mFaceItemWidth, mHeader.NodesPerFace);
+    mFacesRead++;
+    return face;
+}
+
+template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+std::vector<double> MappedMeshReader<ELEMENT_DIM, SPACE_DIM>::GetNode(unsigned index)
+{
+    if (index >= mHeader.NumNodes)
+    {
+        EXCEPTION("Node does not exist - not enough nodes.");
+    }
+    mNodesRead = index; // Allow GetNextNode() to continue from the item after this one
+    return GetNextNode();
+}
+
+template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+ElementData MappedMeshReader<ELEMENT_DIM, SPACE_DIM>::GetElementData(unsigned index)
+{
+    if (index >= mHeader.NumElements)
+    {
+        EXCEPTION("Element " << index << " does not exist - not enough elements (only " << mHeader.NumElements << ").");
+    }
+    mElementsRead = index; // Allow GetNextElementData() to continue from the item after this one
+    return GetNextElementData();
+}
+
+template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+ElementData MappedMeshReader<ELEMENT_DIM, SPACE_DIM>::GetFaceData(unsigned index)
+{
+    if (index >= mHeader.NumFaces)
+    {
+        EXCEPTION("Face does not exist - not enough faces.");
+    }
+    mFacesRead = index; // Allow GetNextFaceData() to continue from the item after this one
+    return GetNextFaceData();
+}
+
+template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+std::vector<unsigned> MappedMeshReader<ELEMENT_DIM, SPACE_DIM>::GetContainingElementIndices(unsigned index)
+{
+    if (index >= mHeader.NumNodes)
+    {
+        EXCEPTION("Connectivity list does not exist - not enough nodes.");
+    }
+    boost::uint64_t row[2];
+    memcpy(row, mpData + mHeader.NclIndexOffset + index*sizeof(boost::uint64_t), 2*sizeof(boost::uint64_t));
+    if (row[0] > row[1] || row[1] > mNclSize)
+    {
+        EXCEPTION("Connectivity list of node " << index << " in mapped mesh file " << mFilesBaseName
+                  << MAPPED_MESH_FILE_EXTENSION << " is corrupt.");
+    }
+
+    std::vector<unsigned> containing_element_indices(row[1] - row[0]);
+    const char* p_row = mpData + mHeader.NclDataOffset + row[0]*sizeof(boost::uint32_t);
+    for (unsigned i=0; i<containing_element_indices.size(); i++)
+    {
+        boost::uint32_t element_index;
+        memcpy(&element_index, p_row + i*sizeof(boost::uint32_t), sizeof(boost::uint32_t));
+        containing_element_indices[i] = element_index;
+    }
+    return containing_element_indices;
+}
+
+template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+std::string MappedMeshReader<ELEMENT_DIM, SPACE_DIM>::GetMeshFileBaseName()
+{
+    return mFilesBaseName;
+}
+
+template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+bool MappedMeshReader<ELEMENT_DIM, SPACE_DIM>::IsFileFormatBinary()
+{
+    return true;
+}
+
+template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+bool MappedMeshReader<ELEMENT_DIM, SPACE_DIM>::HasNclFile()
+{
+    return true;
+}
+
+// Explicit instantiation
+template class MappedMeshReader<1,1>;
+template class MappedMeshReader<1,2>;
+template class MappedMeshReader<1,3>;
+template class MappedMeshReader<2,2>;
+template class MappedMeshReader<2,3>;
+template class MappedMeshReader<3,3>;
@@ -0,0 +1,175 @@
+/*
+
+Copyright (c) 2005-2017, University of Oxford.
+All rights reserved.
+
+University of Oxford means the Chancellor, Masters and Scholars of the
+University of Oxford, having an administrative office at Wellington
+Square, Oxford OX1 2JD, UK.
+
+This file is part of Chaste.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+ * Redistributions of source code must retain the above copyright notice,
+   this list of conditions and the following disclaimer.
+ * Redistributions in binary form must reproduce the above copyright notice,
+   this list of conditions and the following disclaimer in the documentation
+   and/or other materials provided with the distribution.
+ * Neither the name of the University of Oxford nor the names of its
+   contributors may be used to endorse or promote products derived from this
+   software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+*/
+
+
+#ifndef MAPPEDMESHREADER_HPP_
+#define MAPPEDMESHREADER_HPP_
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+#include "AbstractMeshReader.hpp"
+#include "MappedMeshFormat.hpp"
+
+/**
+ * Reader for the indexed binary mesh container described in MappedMeshFormat.hpp
+ * (written by MappedMeshWriter).
+ *
+ * The whole file is memory mapped read-only, so reading a node, element or node
+ * connectivity row is a copy out of the mapping and only the pages holding the
+ * requested records are ever read from disk.  Since the reader reports binary
+ * data with an NCL, DistributedTetrahedralMesh loads just the rank-local nodes,
+ * halo nodes and elements through random access, and processes on the same
+ * machine share the pages in the operating system's cache.
+ *
+ * Only linear meshes are supported.
+ */
+template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+class MappedMeshReader : public AbstractMeshReader<ELEMENT_DIM, SPACE_DIM>
+{
+private:
+
+    std::string mFilesBaseName;  /**< The base name of the mesh file (without the extension). */
+
+    const char* mpData;          /**< Start of the memory-mapped file. */
+    std::size_t mDataSize;       /**< Size of the mapping in bytes. */
+
+    MappedMeshHeader mHeader;    /**< Copy of the file header. */
+
+    std::size_t mNodeItemWidth;    /**< The number of bytes in a node record. */
+    std::size_t mElementItemWidth; /**< The number of bytes in an element record. */
+    std::size_t mFaceItemWidth;    /**< The number of bytes in a face record. */
+
+    boost::uint64_t mNclSize;    /**< The number of containing-element indices in the NCL section. */
+
+    unsigned mNodesRead;         /**< Index of the node that GetNextNode() will return. */
+    unsigned mElementsRead;      /**< Index of the element that GetNextElementData() will return. */
+    unsigned mFacesRead;         /**< Index of the face that GetNextFaceData() will return. */
+
+    /**
+     * Decode an element or face record.
+     *
+     * @param offset  byte offset of the record within the file
+     * @param numNodes  the number of node indices in the record
+     * @return the node indices and attribute of the record
+     */
+    ElementData ReadItem(std::size_t offset, unsigned numNodes) const;
+
+    /**
+     * Check that a section of the given size fits inside the file.
+     *
+     * @param offset  byte offset of the start of the section
+     * @param size  the number of bytes in the section
+     */
+    void CheckSection(boost::uint64_t offset, boost::uint64_t size) const;
+
+public:
+
+    /**
+     * Constructor.  Opens and maps the file pathBaseName.cmesh.
+     *
+     * @param pathBaseName  the base name of the file from which to read the mesh data
+     *    (either absolute, or relative to the current directory)
+     */
+    MappedMeshReader(const std::string& pathBaseName);
+
+    /**
+     * Destructor.  Unmaps the file.
+     */
+    ~MappedMeshReader();
+
+    /** @return the number of elements in the mesh */
+    unsigned GetNumElements() const;
+
+    /** @return the number of nodes in the mesh */
+    unsigned GetNumNodes() const;
+
+    /** @return the number of faces in the mesh */
+    unsigned GetNumFaces() const;
+
+    /** @return the number of element attributes (always 1: the region attribute) */
+    unsigned GetNumElementAttributes() const;
+
+    /** @return the number of face attributes (always 1) */
+    unsigned GetNumFaceAttributes() const;
+
+    /** Resets pointers to beginning */
+    void Reset();
+
+    /** @return a vector of the coordinates of each node in turn */
+    std::vector<double> GetNextNode();
+
+    /** @return the node indices and attribute of each element in turn */
+    ElementData GetNextElementData();
+
+    /** @return the node indices and attribute of each face in turn */
+    ElementData GetNextFaceData();
+
+    /**
+     * @param index  The global node index
+     * @return a vector of the coordinates of the node
+     */
+    std::vector<double> GetNode(unsigned index);
+
+    /**
+     * @param index  The global element index
+     * @return the node indices and attribute of the element
+     */
+    ElementData GetElementData(unsigned index);
+
+    /**
+     * @param index  The global face index
+     * @return the node indices and attribute of the face
+     */
+    ElementData GetFaceData(unsigned index);
+
+    /**
+     * @param index  The global node index
+     * @return the indices of the elements containing the node, read from the stored NCL
+     */
+    std::vector<unsigned> GetContainingElementIndices(unsigned index);
+
+    /** @return #mFilesBaseName */
+    std::string GetMeshFileBaseName();
+
+    /** @return true: the data are binary and support random access */
+    bool IsFileFormatBinary();
+
+    /** @return true: the file always holds a node connectivity list */
+    bool HasNclFile();
+};
+
+#endif // MAPPEDMESHREADER_HPP_
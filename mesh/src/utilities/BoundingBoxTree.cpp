@@ -0,0 +1,361 @@
+/*
+
+Copyright (c) 2005-2017, University of Oxford.
+All rights reserved.
+
+University of Oxford means the Chancellor, Masters and Scholars of the
+University of Oxford, having an administrative office at Wellington
+Square, Oxford OX1 2JD, UK.
+
+This file is part of Chaste.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+ * Redistributions of source code must retain the above copyright notice,
+   this list of conditions and the following disclaimer.
+ * Redistributions in binary form must reproduce the above copyright notice,
+   this list of conditions and the following disclaimer in the documentation
+   and/or other materials provided with the distribution.
+ * Neither the name of the University of Oxford nor the names of its
+   contributors may be used to endorse or promote products derived from this
+   software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+*/
+
+#include "BoundingBoxTree.hpp"
+#include "Exception.hpp"
+
+#include <algorithm>
+#include <cfloat>
+
+/**
+ * Helper used to order boxes by the centre coordinate along one axis
+ * when splitting a tree node in BoundingBoxTree::BuildNode().
+ */
+template<unsigned DIM>
+class CompareBoxCentres
+{
+private:
+
+    /** The lower corners of the boxes. */
+    const std::vector<c_vector<double, DIM> >& mrLowerCorners;
+
+    /** The upper corners of the boxes. */
+    const std::vector<c_vector<double, DIM> >& mrUpperCorners;
+
+    /** The axis along which to compare. */
+    unsigned mAxis;
+
+public:
+
+    /**
+     * Constructor.
+     *
+     * @param rLowerCorners the lower corners of the boxes
+     * @param rUpperCorners the upper corners of the boxes
+     * @param axis the axis along which to compare
+     */
+    CompareBoxCentres(const std::vector<c_vector<double, DIM> >& rLowerCorners,
+                      const std::vector<c_vector<double, DIM> >& rUpperCorners,
+                      unsigned axis)
+        : mrLowerCorners(rLowerCorners),
+          mrUpperCorners(rUpperCorners),
+          mAxis(axis)
+    {
+    }
+
+    /**
+     * @param boxA the index of the first box
+     * @param boxB the index of the second box
+     * @return whether the centre of box A comes before that of box B, using the index to break ties.
+     */
+    bool operator()(unsigned boxA, unsigned boxB) const
+    {
+        double centre_a = mrLowerCorners[boxA][mAxis] + mrUpperCorners[boxA][mAxis];
+        double centre_b = mrLowerCorners[boxB][mAxis] + mrUpperCorners[boxB][mAxis];
+        if (centre_a != centre_b)
+        {
+            return centre_a < centre_b;
+        }
+        return boxA < boxB;
+    }
+};
+
+template<unsigned DIM>
+const unsigned BoundingBoxTree<DIM>::msMaxBoxesPerLeaf = 4;
+
+template<unsigned DIM>
+BoundingBoxTree<DIM>::BoundingBoxTree()
+{
+}
+
+template<unsigned DIM>
+void BoundingBoxTree<DIM>::Build(const std::vector<c_vector<double, DIM> >& rLowerCorners,
+                                 const std::vector<c_vector<double, DIM> >& rUpperCorners)
+{
+    assert(rLowerCorners.size() == rUpperCorners.size());
+
+    mBoxLowerCorners = rLowerCorners;
+    mBoxUpperCorners = rUpperCorners;
+
+    unsigned num_boxes = mBoxLowerCorners.size();
+    mBoxOrder.resize(num_boxes);
+    for (unsigned i=0; i<num_boxes; i++)
+    {
+        mBoxOrder[i] = i;
+    }
+
+    mNodeLowerCorners.clear();
+    mNodeUpperCorners.clear();
+    mNodeStarts.clear();
+    mNodeEnds.clear();
+    mNodeSecondChildren.clear();
+
+    if (num_boxes > 0)
+    {
+        // A binary tree with at least one box per leaf has fewer than twice as many nodes as boxes
+        mNodeStarts.reserve(2*num_boxes);
+        BuildNode(0, num_boxes);
+    }
+}
+
+template<unsigned DIM>
+unsigned BoundingBoxTree<DIM>::BuildNode(unsigned start, unsigned end)
+{
+    unsigned node_index = mNodeStarts.size();
+    mNodeStarts.push_back(start);
+    mNodeEnds.push_back(end);
+    mNodeSecondChildren.push_back(UNSIGNED_UNSET);
+    mNodeLowerCorners.push_back(zero_vector<double>(DIM));
+    mNodeUpperCorners.push_back(zero_vector<double>(DIM));
+
+    if (end - start > msMaxBoxesPerLeaf)
+    {
+        // Find the longest axis of the box centres
+        c_vector<double, DIM> min_centre = mBoxLowerCorners[mBoxOrder[start]] + mBoxUpperCorners[mBoxOrder[start]];
+        c_vector<double, DIM> max_centre = min_centre;
+        for (unsigned i=start+1; i<end; i++)
+        {
+            c_vector<double, DIM> centre = mBoxLowerCorners[mBoxOrder[i]] + mBoxUpperCorners[mBoxOrder[i]];
+            for (unsigned d=0; d<DIM; d++)
+            {
+                min_centre[d] = std::min(min_centre[d], centre[d]);
+                max_centre[d] = std::max(max_centre[d], centre[d]);
+            }
+        }
+        unsigned axis = 0;
+        for (unsigned d=1; d<DIM; d++)
+        {
+            if (max_centre[d] - min_centre[d] > max_centre[axis] - min_centre[axis])
+            {
+                axis = d;
+            }
+        }
+
+        // Split at the median
+        unsigned middle = start + (end - start)/2;
+        std::nth_element(mBoxOrder.begin() + start, mBoxOrder.begin() + middle, mBoxOrder.begin() + end,
+                         CompareBoxCentres<DIM>(mBoxLowerCorners, mBoxUpperCorners, axis));
+
+        BuildNode(start, middle);
+        unsigned second_child = BuildNode(middle, end);
+        mNodeSecondChildren[node_index] = second_child;
+    }
+
+    CalculateNodeBounds(node_index);
+
+    return node_index;
+}
+
+template<unsigned DIM>
+void BoundingBoxTree<DIM>::CalculateNodeBounds(unsigned nodeIndex)
+{
+    c_vector<double, DIM>& r_lower = mNodeLowerCorners[nodeIndex];
+    c_vector<double, DIM>& r_upper = mNodeUpperCorners[nodeIndex];
+
+    if (mNodeSecondChildren[nodeIndex] == UNSIGNED_UNSET)
+    {
+        r_lower = mBoxLowerCorners[mBoxOrder[mNodeStarts[nodeIndex]]];
+        r_upper = mBoxUpperCorners[mBoxOrder[mNodeStarts[nodeIndex]]];
+        for (unsigned i=mNodeStarts[nodeIndex]+1; i<mNodeEnds[nodeIndex]; i++)
+        {
+            for (unsigned d=0; d<DIM; d++)
+            {
+                r_lower[d] = std::min(r_lower[d], mBoxLowerCorners[mBoxOrder[i]][d]);
+                r_upper[d] = std::max(r_upper[d], mBoxUpperCorners[mBoxOrder[i]][d]);
+            }
+        }
+    }
+    else
+    {
+        unsigned first_child = nodeIndex + 1;
+        unsigned second_child = mNodeSecondChildren[nodeIndex];
+        for (unsigned d=0; d<DIM; d++)
+        {
+            r_lower[d] = std::min(mNodeLowerCorners[first_child][d], mNodeLowerCorners[second_child][d]);
+            r_upper[d] = std::max(mNodeUpperCorners[first_child][d], mNodeUpperCorners[second_child][d]);
+        }
+    }
+}
+
+template<unsigned DIM>
+void BoundingBoxTree<DIM>::Refit(const std::vector<c_vector<double, DIM> >& rLowerCorners,
+                                 const std::vector<c_vector<double, DIM> >& rUpperCorners)
+{
+    assert(rLowerCorners.size() == mBoxLowerCorners.size());
+    assert(rUpperCorners.size() == mBoxUpperCorners.size());
+
+    mBoxLowerCorners = rLowerCorners;
+    mBoxUpperCorners = rUpperCorners;
+
+    // Children always follow their parent, so work backwards through the nodes
+    for (unsigned i=mNodeStarts.size(); i>0; i--)
+    {
+        CalculateNodeBounds(i-1);
+    }
+}
+
+template<unsigned DIM>
+unsigned BoundingBoxTree<DIM>::GetNumBoxes() const
+{
+    return mBoxLowerCorners.size();
+}
+
+template<unsigned DIM>
+double BoundingBoxTree<DIM>::CalculateSquaredDistance(const c_vector<double, DIM>& rLower,
+                                                      const c_vector<double, DIM>& rUpper,
+                                                      const c_vector<double, DIM>& rPoint)
+{
+    double squared_distance = 0.0;
+    for (unsigned d=0; d<DIM; d++)
+    {
+        if (rPoint[d] < rLower[d])
+        {
+            squared_distance += (rLower[d] - rPoint[d])*(rLower[d] - rPoint[d]);
+        }
+        else if (rPoint[d] > rUpper[d])
+        {
+            squared_distance += (rPoint[d] - rUpper[d])*(rPoint[d] - rUpper[d]);
+        }
+    }
+    return squared_distance;
+}
+
+template<unsigned DIM>
+void BoundingBoxTree<DIM>::GetBoxesContainingPoint(const c_vector<double, DIM>& rPoint, std::vector<unsigned>& rBoxIndices) const
+{
+    rBoxIndices.clear();
+    if (mNodeStarts.empty())
+    {
+        return;
+    }
+
+    std::vector<unsigned> stack;
+    stack.push_back(0);
+    while (!stack.empty())
+    {
+        unsigned node_index = stack.back();
+        stack.pop_back();
+
+        if (CalculateSquaredDistance(mNodeLowerCorners[node_index], mNodeUpperCorners[node_index], rPoint) > 0.0)
+        {
+            continue;
+        }
+
+        if (mNodeSecondChildren[node_index] == UNSIGNED_UNSET)
+        {
+            for (unsigned i=mNodeStarts[node_index]; i<mNodeEnds[node_index]; i++)
+            {
+                unsigned box_index = mBoxOrder[i];
+                if (CalculateSquaredDistance(mBoxLowerCorners[box_index], mBoxUpperCorners[box_index], rPoint) == 0.0)
+                {
+                    rBoxIndices.push_back(box_index);
+                }
+            }
+        }
+        else
+        {
+            stack.push_back(mNodeSecondChildren[node_index]);
+            stack.push_back(node_index + 1);
+        }
+    }
+
+    std::sort(rBoxIndices.begin(), rBoxIndices.end());
+}
+
+template<unsigned DIM>
+unsigned BoundingBoxTree<DIM>::GetNearestBox(const c_vector<double, DIM>& rPoint) const
+{
+    if (mNodeStarts.empty())
+    {
+        return UNSIGNED_UNSET;
+    }
+
+    unsigned nearest_box = UNSIGNED_UNSET;
+    double nearest_squared_distance = DBL_MAX;
+
+    std::vector<unsigned> stack;
+    stack.push_back(0);
+    while (!stack.empty())
+    {
+        unsigned node_index = stack.back();
+        stack.pop_back();
+
+        if (CalculateSquaredDistance(mNodeLowerCorners[node_index], mNodeUpperCorners[node_index], rPoint) > nearest_squared_distance)
+        {
+            continue;
+        }
+
+        if (mNodeSecondChildren[node_index] == UNSIGNED_UNSET)
+        {
+            for (unsigned i=mNodeStarts[node_index]; i<mNodeEnds[node_index]; i++)
+            {
+                unsigned box_index = mBoxOrder[i];
+                double squared_distance = CalculateSquaredDistance(mBoxLowerCorners[box_index], mBoxUpperCorners[box_index], rPoint);
+                if (squared_distance < nearest_squared_distance
+                    || (squared_distance == nearest_squared_distance && box_index < nearest_box))
+                {
+                    nearest_squared_distance = squared_distance;
+                    nearest_box = box_index;
+                }
+            }
+        }
+        else
+        {
+            // Visit the nearer child first so that more of the tree can be pruned
+            unsigned first_child = node_index + 1;
+            unsigned second_child = mNodeSecondChildren[node_index];
+            double first_distance = CalculateSquaredDistance(mNodeLowerCorners[first_child], mNodeUpperCorners[first_child], rPoint);
+            double second_distance = CalculateSquaredDistance(mNodeLowerCorners[second_child], mNodeUpperCorners[second_child], rPoint);
+            if (first_distance < second_distance)
+            {
+                stack.push_back(second_child);
+                stack.push_back(first_child);
+            }
+            else
+            {
+                stack.push_back(first_child);
+                stack.push_back(second_child);
+            }
+        }
+    }
+
+    return nearest_box;
+}
+
+///////// Explicit instantiation///////
+
+template class BoundingBoxTree<1>;
+template class BoundingBoxTree<2>;
+template class BoundingBoxTree<3>;
@@ -0,0 +1,165 @@
+/*
+
+Copyright (c) 2005-2017, University of Oxford.
+All rights reserved.
+
+University of Oxford means the Chancellor, Masters and Scholars of the
+University of Oxford, having an administrative office at Wellington
+Square, Oxford OX1 2JD, UK.
+
+This file is part of Chaste.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+ * Redistributions of source code must retain the above copyright notice,
+   this list of conditions and the following disclaimer.
+ * Redistributions in binary form must reproduce the above copyright notice,
+   this list of conditions and the following disclaimer in the documentation
+   and/or other materials provided with the distribution.
+ * Neither the name of the University of Oxford nor the names of its
+   contributors may be used to endorse or promote products derived from this
+   software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+*/
+
+#ifndef BOUNDINGBOXTREE_HPP_
+#define BOUNDINGBOXTREE_HPP_
+
+#include <vector>
+#include <boost/utility.hpp>
+
+#include "UblasVectorInclude.hpp"
+
+/**
+ * A bounding volume hierarchy over a set of axis-aligned boxes (such as the
+ * bounding boxes of the elements or nodes of a mesh), used to find the boxes
+ * containing a point, or the box nearest to a point, in O(log N) time.
+ *
+ * The tree is built by recursively splitting the boxes at the median of their
+ * centres along the longest axis, and is stored as a flat array in depth-first
+ * order. If the boxes move without changing their number, Refit() recomputes the
+ * bounds of the existing tree rather than rebuilding it.
+ */
+template<unsigned DIM>
+class BoundingBoxTree : private boost::noncopyable
+{
+private:
+
+    /** The maximum number of boxes stored in each leaf. */
+    static const unsigned msMaxBoxesPerLeaf;
+
+    /** The lower corners of the boxes, indexed by box. */
+    std::vector<c_vector<double, DIM> > mBoxLowerCorners;
+
+    /** The upper corners of the boxes, indexed by box. */
+    std::vector<c_vector<double, DIM> > mBoxUpperCorners;
+
+    /** The box indices, reordered so that each tree node covers a contiguous range. */
+    std::vector<unsigned> mBoxOrder;
+
+    /** The lower corner of the bounds of each tree node. */
+    std::vector<c_vector<double, DIM> > mNodeLowerCorners;
+
+    /** The upper corner of the bounds of each tree node. */
+    std::vector<c_vector<double, DIM> > mNodeUpperCorners;
+
+    /** The start of each tree node's range in mBoxOrder. */
+    std::vector<unsigned> mNodeStarts;
+
+    /** The end (one past the last entry) of each tree node's range in mBoxOrder. */
+    std::vector<unsigned> mNodeEnds;
+
+    /**
+     * The index of the second child of each tree node, or UNSIGNED_UNSET for a leaf.
+     * The first child of an internal node always immediately follows it.
+     */
+    std::vector<unsigned> mNodeSecondChildren;
+
+    /**
+     * Recursively build the tree node covering a range of mBoxOrder.
+     *
+     * @param start the start of the range
+     * @param end one past the end of the range
+     * @return the index of the new tree node
+     */
+    unsigned BuildNode(unsigned start, unsigned end);
+
+    /**
+     * Set the bounds of a tree node from its boxes or children.
+     *
+     * @param nodeIndex the tree node
+     */
+    void CalculateNodeBounds(unsigned nodeIndex);
+
+    /**
+     * @param rLower the lower corner of a box
+     * @param rUpper the upper corner of a box
+     * @param rPoint the point
+     * @return the squared distance from the point to the box, which is zero if the box contains the point.
+     */
+    static double CalculateSquaredDistance(const c_vector<double, DIM>& rLower,
+                                           const c_vector<double, DIM>& rUpper,
+                                           const c_vector<double, DIM>& rPoint);
+
+public:
+
+    /**
+     * Default constructor. The tree is empty until Build() is called.
+     */
+    BoundingBoxTree();
+
+    /**
+     * Build the tree over a set of boxes.
+     *
+     * @param rLowerCorners the lower corner of each box
+     * @param rUpperCorners the upper corner of each box
+     */
+    void Build(const std::vector<c_vector<double, DIM> >& rLowerCorners,
+               const std::vector<c_vector<double, DIM> >& rUpperCorners);
+
+    /**
+     * Update the boxes and the bounds of the tree nodes without changing the
+     * structure of the tree. Queries stay correct, but become slower if the boxes
+     * have moved a long way since the tree was built.
+     *
+     * @param rLowerCorners the new lower corner of each box
+     * @param rUpperCorners the new upper corner of each box
+     */
+    void Refit(const std::vector<c_vector<double, DIM> >& rLowerCorners,
+               const std::vector<c_vector<double, DIM> >& rUpperCorners);
+
+    /**
+     * @return the number of boxes in the tree.
+     */
+    unsigned GetNumBoxes() const;
+
+    /**
+     * Find all the boxes containing a point.
+     *
+     * @param rPoint the point
+     * @param rBoxIndices filled with the indices of the boxes containing the point, in increasing order
+     */
+    void GetBoxesContainingPoint(const c_vector<double, DIM>& rPoint, std::vector<unsigned>& rBoxIndices) const;
+
+    /**
+     * Find the box nearest to a point, measuring the distance from the point to the
+     * nearest point of each box. Ties are broken in favour of the lowest index.
+     *
+     * @param rPoint the point
+     * @return the index of the nearest box, or UNSIGNED_UNSET if the tree is empty.
+     */
+    unsigned GetNearestBox(const c_vector<double, DIM>& rPoint) const;
+};
+
+#endif /*BOUNDINGBOXTREE_HPP_*/
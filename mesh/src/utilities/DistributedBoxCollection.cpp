@@ -37,16 +37,35 @@ OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "MathsCustomFunctions.hpp"
 #include "Warnings.hpp"
 
+#include <algorithm>
+
 // Static member for "fudge factor" is instantiated here
 template<unsigned DIM>
 const double DistributedBoxCollection<DIM>::msFudge = 5e-14;
 
+/**
+ * Helper used to sort the nodes of each box by index in DistributedBoxCollection::BuildCellLists().
+ *
+ * @param pNodeA the first node
+ * @param pNodeB the second node
+ * @return whether pNodeA has a smaller index than pNodeB.
+ */
+template<unsigned DIM>
+static bool CompareNodeIndices(Node<DIM>* pNodeA, Node<DIM>* pNodeB)
+{
+    return pNodeA->GetIndex() < pNodeB->GetIndex();
+}
+
 template<unsigned DIM>
 DistributedBoxCollection<DIM>::DistributedBoxCollection(double boxWidth, c_vector<double, 2*DIM> domainSize, bool isPeriodicInX, int localRows)
     : mBoxWidth(boxWidth),
       mIsPeriodicInX(isPeriodicInX),
       mAreLocalBoxesSet(false),
-      mCalculateNodeNeighbours(true)
+      mCalculateNodeNeighbours(true),
+      mUseCellLists(false),
+      mVerletSkin(0.0),
+      mVerletListRadius(boxWidth),
+      mIsVerletListValid(false)
 {
     // Periodicity only works in 2d
     if (isPeriodicInX)
@@ -1136,6 +1155,54 @@ void DistributedBoxCollection<DIM>::SetCalculateNodeNeighbours(bool calculateNod
     mCalculateNodeNeighbours = calculateNodeNeighbours;
 }
 
+template<unsigned DIM>
+void DistributedBoxCollection<DIM>::SetUseCellLists(bool useCellLists)
+{
+    mUseCellLists = useCellLists;
+    mIsVerletListValid = false;
+}
+
+template<unsigned DIM>
+bool DistributedBoxCollection<DIM>::GetUseCellLists() const
+{
+    return mUseCellLists;
+}
+
+template<unsigned DIM>
+void DistributedBoxCollection<DIM>::SetVerletSkin(double verletSkin, double interactionDistance)
+{
+    if (verletSkin < 0.0)
+    {
+        EXCEPTION("The Verlet skin must be non-negative.");
+    }
+    // Allow for rounding when the box width was computed as the interaction distance plus the skin
+    if (interactionDistance + verletSkin > mBoxWidth*(1.0 + 1e-12))
+    {
+        EXCEPTION("The interaction distance plus the Verlet skin must not exceed the box width.");
+    }
+    mVerletSkin = verletSkin;
+    mVerletListRadius = interactionDistance + verletSkin;
+    mIsVerletListValid = false;
+}
+
+template<unsigned DIM>
+double DistributedBoxCollection<DIM>::GetVerletSkin() const
+{
+    return mVerletSkin;
+}
+
+template<unsigned DIM>
+void DistributedBoxCollection<DIM>::ResetVerletList()
+{
+    mIsVerletListValid = false;
+}
+
+template<unsigned DIM>
+const std::vector<unsigned>& DistributedBoxCollection<DIM>::rGetNodePairIndices() const
+{
+    return mNodePairIndices;
+}
+
 template<unsigned DIM>
 void DistributedBoxCollection<DIM>::CalculateNodePairs(std::vector<Node<DIM>*>& rNodes, std::vector<std::pair<Node<DIM>*, Node<DIM>*> >& rNodePairs)
 {
@@ -1154,9 +1221,17 @@ void DistributedBoxCollection<DIM>::CalculateNodePairs(std::vector<Node<DIM>*>&
         }
     }
 
-    for (unsigned box_index=mMinBoxIndex; box_index<=mMaxBoxIndex; box_index++)
+    if (mUseCellLists)
+    {
+        mNodePairIndices.clear();
+        AddPairsUsingCellLists(true, true, rNodePairs);
+    }
+    else
     {
-        AddPairsFromBox(box_index, rNodePairs);
+        for (unsigned box_index=mMinBoxIndex; box_index<=mMaxBoxIndex; box_index++)
+        {
+            AddPairsFromBox(box_index, rNodePairs);
+        }
     }
 
     if (mCalculateNodeNeighbours)
@@ -1194,11 +1269,19 @@ void DistributedBoxCollection<DIM>::CalculateInteriorNodePairs(std::vector<Node<
         }
     }
 
-    for (unsigned box_index=mMinBoxIndex; box_index<=mMaxBoxIndex; box_index++)
+    if (mUseCellLists)
     {
-        if (IsInteriorBox(box_index))
+        mNodePairIndices.clear();
+        AddPairsUsingCellLists(true, false, rNodePairs);
+    }
+    else
+    {
+        for (unsigned box_index=mMinBoxIndex; box_index<=mMaxBoxIndex; box_index++)
         {
-            AddPairsFromBox(box_index, rNodePairs);
+            if (IsInteriorBox(box_index))
+            {
+                AddPairsFromBox(box_index, rNodePairs);
+            }
         }
     }
 
@@ -1222,11 +1305,22 @@ void DistributedBoxCollection<DIM>::CalculateInteriorNodePairs(std::vector<Node<
 template<unsigned DIM>
 void DistributedBoxCollection<DIM>::CalculateBoundaryNodePairs(std::vector<Node<DIM>*>& rNodes, std::vector<std::pair<Node<DIM>*, Node<DIM>*> >& rNodePairs)
 {
-    for (unsigned box_index=mMinBoxIndex; box_index<=mMaxBoxIndex; box_index++)
+    if (mUseCellLists)
     {
-        if (!IsInteriorBox(box_index))
+        // Without halo boxes every box is interior, so there are no further pairs to add
+        if (!mHaloBoxes.empty())
         {
-            AddPairsFromBox(box_index, rNodePairs);
+            AddPairsUsingCellLists(false, true, rNodePairs);
+        }
+    }
+    else
+    {
+        for (unsigned box_index=mMinBoxIndex; box_index<=mMaxBoxIndex; box_index++)
+        {
+            if (!IsInteriorBox(box_index))
+            {
+                AddPairsFromBox(box_index, rNodePairs);
+            }
         }
     }
 
@@ -1312,6 +1406,216 @@ void DistributedBoxCollection<DIM>::AddPairsFromBox(unsigned boxIndex,
     }
 }
 
+template<unsigned DIM>
+void DistributedBoxCollection<DIM>::BuildCellLists()
+{
+    unsigned num_owned_boxes = mBoxes.size();
+    unsigned num_boxes = num_owned_boxes + mHaloBoxes.size();
+
+    // Count the nodes in each box
+    mCellListStarts.assign(num_boxes + 1, 0);
+    for (unsigned i=0; i<num_owned_boxes; i++)
+    {
+        mCellListStarts[i+1] = mBoxes[i].rGetNodesContained().size();
+    }
+    for (unsigned i=0; i<mHaloBoxes.size(); i++)
+    {
+        mCellListStarts[num_owned_boxes + i + 1] = mHaloBoxes[i].rGetNodesContained().size();
+    }
+
+    // Convert the counts to offsets
+    for (unsigned i=0; i<num_boxes; i++)
+    {
+        mCellListStarts[i+1] += mCellListStarts[i];
+    }
+
+    // Scatter the nodes into their ranges
+    mCellListNodes.resize(mCellListStarts[num_boxes]);
+    for (unsigned i=0; i<num_boxes; i++)
+    {
+        Box<DIM>& r_box = (i < num_owned_boxes) ? mBoxes[i] : mHaloBoxes[i - num_owned_boxes];
+        std::copy(r_box.rGetNodesContained().begin(), r_box.rGetNodesContained().end(), mCellListNodes.begin() + mCellListStarts[i]);
+        std::sort(mCellListNodes.begin() + mCellListStarts[i], mCellListNodes.begin() + mCellListStarts[i+1], CompareNodeIndices<DIM>);
+    }
+}
+
+template<unsigned DIM>
+unsigned DistributedBoxCollection<DIM>::GetCellListSlot(unsigned globalIndex)
+{
+    if (IsBoxOwned(globalIndex))
+    {
+        return globalIndex - mMinBoxIndex;
+    }
+    else // Assume it is a halo.
+    {
+        return mBoxes.size() + mHaloBoxesMapping[globalIndex];
+    }
+}
+
+template<unsigned DIM>
+void DistributedBoxCollection<DIM>::AddPairsFromCellList(unsigned boxIndex,
+                                                         std::vector<std::pair<Node<DIM>*, Node<DIM>*> >& rNodePairs)
+{
+    unsigned slot = GetCellListSlot(boxIndex);
+
+    // When using Verlet lists we only keep pairs closer than the interaction distance plus the skin
+    bool use_verlet_lists = (mVerletSkin > 0.0);
+    double max_squared_distance = mVerletListRadius*mVerletListRadius;
+
+    // Get the local boxes to this box
+    const std::set<unsigned>& local_boxes_indices = rGetLocalBoxes(boxIndex);
+
+    for (unsigned i=mCellListStarts[slot]; i<mCellListStarts[slot+1]; i++)
+    {
+        Node<DIM>* p_node = mCellListNodes[i];
+        unsigned node_index = p_node->GetIndex();
+
+        for (std::set<unsigned>::const_iterator box_iter = local_boxes_indices.begin();
+             box_iter != local_boxes_indices.end();
+             ++box_iter)
+        {
+            unsigned neighbour_slot = GetCellListSlot(*box_iter);
+
+            // Nodes are sorted by index within a box, so in the same box we only look further along the range
+            unsigned start = (*box_iter == boxIndex) ? i+1 : mCellListStarts[neighbour_slot];
+
+            for (unsigned j=start; j<mCellListStarts[neighbour_slot+1]; j++)
+            {
+                Node<DIM>* p_neighbour_node = mCellListNodes[j];
+
+                if (use_verlet_lists)
+                {
+                    c_vector<double, DIM> displacement = CalculateDisplacement(p_node->rGetLocation(), p_neighbour_node->rGetLocation());
+                    if (inner_prod(displacement, displacement) > max_squared_distance)
+                    {
+                        continue;
+                    }
+                }
+
+                unsigned other_node_index = p_neighbour_node->GetIndex();
+
+                rNodePairs.push_back(std::pair<Node<DIM>*, Node<DIM>*>(p_node, p_neighbour_node));
+                mNodePairIndices.push_back(node_index);
+                mNodePairIndices.push_back(other_node_index);
+
+                if (mCalculateNodeNeighbours)
+                {
+                    p_node->AddNeighbour(other_node_index);
+                    p_neighbour_node->AddNeighbour(node_index);
+                }
+            }
+        }
+    }
+}
+
+template<unsigned DIM>
+void DistributedBoxCollection<DIM>::AddPairsUsingCellLists(bool interiorBoxes, bool boundaryBoxes,
+                                                           std::vector<std::pair<Node<DIM>*, Node<DIM>*> >& rNodePairs)
+{
+    // Verlet lists can only be reused without halo boxes, since halo nodes are replaced every time step
+    bool reuse_verlet_list = (mVerletSkin > 0.0) && interiorBoxes && mHaloBoxes.empty();
+
+    if (reuse_verlet_list && !IsVerletListRebuildNeeded())
+    {
+        for (unsigned i=0; i<mVerletPairs.size(); i++)
+        {
+            Node<DIM>* p_node = mVerletPairs[i].first;
+            Node<DIM>* p_neighbour_node = mVerletPairs[i].second;
+
+            rNodePairs.push_back(mVerletPairs[i]);
+            mNodePairIndices.push_back(p_node->GetIndex());
+            mNodePairIndices.push_back(p_neighbour_node->GetIndex());
+
+            if (mCalculateNodeNeighbours)
+            {
+                p_node->AddNeighbour(p_neighbour_node->GetIndex());
+                p_neighbour_node->AddNeighbour(p_node->GetIndex());
+            }
+        }
+        return;
+    }
+
+    BuildCellLists();
+
+    unsigned first_new_pair = rNodePairs.size();
+    for (unsigned box_index=mMinBoxIndex; box_index<=mMaxBoxIndex; box_index++)
+    {
+        bool is_interior = IsInteriorBox(box_index);
+        if ((is_interior && interiorBoxes) || (!is_interior && boundaryBoxes))
+        {
+            AddPairsFromCellList(box_index, rNodePairs);
+        }
+    }
+
+    if (reuse_verlet_list)
+    {
+        // Store the new pairs along with the current node locations
+        mVerletPairs.assign(rNodePairs.begin() + first_new_pair, rNodePairs.end());
+
+        mVerletNodes.assign(mCellListNodes.begin(), mCellListNodes.begin() + mCellListStarts[mBoxes.size()]);
+        mVerletReferenceLocations.resize(mVerletNodes.size());
+        for (unsigned i=0; i<mVerletNodes.size(); i++)
+        {
+            mVerletReferenceLocations[i] = mVerletNodes[i]->rGetLocation();
+        }
+        mIsVerletListValid = true;
+    }
+}
+
+template<unsigned DIM>
+bool DistributedBoxCollection<DIM>::IsVerletListRebuildNeeded()
+{
+    if (!mIsVerletListValid)
+    {
+        return true;
+    }
+
+    // Check that no nodes have been added to or removed from the boxes
+    unsigned num_nodes = 0;
+    for (unsigned i=0; i<mBoxes.size(); i++)
+    {
+        num_nodes += mBoxes[i].rGetNodesContained().size();
+    }
+    if (num_nodes != mVerletNodes.size())
+    {
+        return true;
+    }
+
+    // Check whether any node has moved more than half the skin
+    double max_squared_displacement = 0.25*mVerletSkin*mVerletSkin;
+    for (unsigned i=0; i<mVerletNodes.size(); i++)
+    {
+        c_vector<double, DIM> displacement = CalculateDisplacement(mVerletReferenceLocations[i], mVerletNodes[i]->rGetLocation());
+        if (inner_prod(displacement, displacement) > max_squared_displacement)
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+template<unsigned DIM>
+c_vector<double, DIM> DistributedBoxCollection<DIM>::CalculateDisplacement(const c_vector<double, DIM>& rLocationA,
+                                                                            const c_vector<double, DIM>& rLocationB) const
+{
+    c_vector<double, DIM> displacement = rLocationB - rLocationA;
+
+    if (mIsPeriodicInX)
+    {
+        double width = mDomainSize[1] - mDomainSize[0];
+        if (displacement[0] > 0.5*width)
+        {
+            displacement[0] -= width;
+        }
+        else if (displacement[0] < -0.5*width)
+        {
+            displacement[0] += width;
+        }
+    }
+
+    return displacement;
+}
+
 template<unsigned DIM>
 std::vector<int> DistributedBoxCollection<DIM>::CalculateNumberOfNodesInEachStrip()
 {
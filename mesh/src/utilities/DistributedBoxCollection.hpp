@@ -116,6 +116,51 @@ private:
     /** A flag that can be set to not save rNodeNeighbours in CalculateNodePairs - for efficiency */
     bool mCalculateNodeNeighbours;
 
+    /**
+     * Whether to calculate node pairs from contiguous cell lists (see BuildCellLists())
+     * rather than by walking the node sets of each box. Defaults to false. Not archived.
+     */
+    bool mUseCellLists;
+
+    /**
+     * The skin used for Verlet lists when cell lists are in use. A Verlet list holds every
+     * pair closer than #mVerletListRadius, and is only rebuilt once some node has moved more
+     * than half the skin, so it is guaranteed to contain all pairs closer than the interaction
+     * distance. Zero (the default) means Verlet lists are not used. Not archived.
+     */
+    double mVerletSkin;
+
+    /** The interaction distance plus #mVerletSkin; at most the box width. Not archived. */
+    double mVerletListRadius;
+
+    /**
+     * Offsets into mCellListNodes of the nodes of each box: owned boxes first, in order of
+     * global index, followed by the halo boxes in the order of mHaloBoxes. Has one more
+     * entry than there are boxes.
+     */
+    std::vector<unsigned> mCellListStarts;
+
+    /** The nodes of all owned and halo boxes, stored box by box and in order of node index within each box. */
+    std::vector<Node<DIM>*> mCellListNodes;
+
+    /**
+     * Compact array of the node pairs found by the most recent pair calculation using cell lists:
+     * entries 2k and 2k+1 are the global indices of the two nodes of the k-th pair.
+     */
+    std::vector<unsigned> mNodePairIndices;
+
+    /** The node pairs stored when the Verlet list was last built. */
+    std::vector<std::pair<Node<DIM>*, Node<DIM>*> > mVerletPairs;
+
+    /** The nodes owned by this process when the Verlet list was last built. */
+    std::vector<Node<DIM>*> mVerletNodes;
+
+    /** The locations of the nodes in mVerletNodes when the Verlet list was last built. */
+    std::vector<c_vector<double, DIM> > mVerletReferenceLocations;
+
+    /** Whether mVerletPairs may be reused, subject to the nodes not having moved too far. */
+    bool mIsVerletListValid;
+
     /**
      * Setup the halo box structure on this process.
      * (Private method since this is called as a helper method by the constructor.)
@@ -124,6 +169,56 @@ private:
      */
     void SetupHaloBoxes();
 
+    /**
+     * Rebuild mCellListStarts and mCellListNodes from the nodes currently in the owned and
+     * halo boxes. The nodes are counted per box, the counts are prefix-summed into offsets and
+     * the nodes are then scattered into place, so that each box's nodes occupy a contiguous
+     * range, sorted by node index to make the pair ordering independent of pointer values.
+     */
+    void BuildCellLists();
+
+    /**
+     * @param globalIndex the global index of an owned or halo box
+     * @return the position of the box's range in mCellListStarts.
+     */
+    unsigned GetCellListSlot(unsigned globalIndex);
+
+    /**
+     * The cell list equivalent of AddPairsFromBox(). Pairs are added in order of the nodes in
+     * the box, then of the local boxes, then of the nodes in each local box. When Verlet lists
+     * are in use only pairs closer than the box width are added.
+     *
+     * @param boxIndex the box to add neighbours to.
+     * @param rNodePairs the return value, a set of pairs of nodes
+     */
+    void AddPairsFromCellList(unsigned boxIndex, std::vector<std::pair<Node<DIM>*, Node<DIM>*> >& rNodePairs);
+
+    /**
+     * Add the pairs of nodes in owned boxes to rNodePairs using cell lists, reusing the
+     * Verlet list if possible.
+     *
+     * @param interiorBoxes whether to add pairs from interior boxes
+     * @param boundaryBoxes whether to add pairs from boxes that are not interior
+     * @param rNodePairs the return value, a set of pairs of nodes
+     */
+    void AddPairsUsingCellLists(bool interiorBoxes, bool boundaryBoxes, std::vector<std::pair<Node<DIM>*, Node<DIM>*> >& rNodePairs);
+
+    /**
+     * @return whether the Verlet list must be rebuilt, either because it has been reset,
+     * the number of nodes has changed or some node has moved more than half the skin.
+     */
+    bool IsVerletListRebuildNeeded();
+
+    /**
+     * Calculate the displacement between two locations, taking the shortest route across
+     * the domain if it is periodic in x.
+     *
+     * @param rLocationA the first location
+     * @param rLocationB the second location
+     * @return the vector from rLocationA to rLocationB.
+     */
+    c_vector<double, DIM> CalculateDisplacement(const c_vector<double, DIM>& rLocationA, const c_vector<double, DIM>& rLocationB) const;
+
     /** Needed for serialization **/
     friend class boost::serialization::access;
 
@@ -342,6 +437,50 @@ public:
      */
     void SetCalculateNodeNeighbours(bool calculateNodeNeighbours);
 
+    /**
+     * Set whether to calculate node pairs using contiguous cell lists rather than the node sets of each box.
+     * The same pairs are found, in an order that depends only on node indices, and their global node
+     * indices are also stored in a compact array (see rGetNodePairIndices()).
+     *
+     * @param useCellLists whether to use cell lists
+     */
+    void SetUseCellLists(bool useCellLists);
+
+    /**
+     * @return #mUseCellLists
+     */
+    bool GetUseCellLists() const;
+
+    /**
+     * Set the skin for Verlet lists, which are used when cell lists are in use and the skin is positive.
+     * Pairs are then only returned if they were closer than the interaction distance plus the skin when
+     * the list was last built, and the list is only rebuilt when a node has moved more than half the skin,
+     * so every pair closer than the interaction distance is always returned. Verlet lists are only reused
+     * on a process without halo boxes; otherwise they are rebuilt every time.
+     *
+     * @param verletSkin the skin; must be non-negative
+     * @param interactionDistance the largest distance at which pairs must be returned; the interaction
+     *     distance plus the skin must not exceed the box width
+     */
+    void SetVerletSkin(double verletSkin, double interactionDistance);
+
+    /**
+     * @return #mVerletSkin
+     */
+    double GetVerletSkin() const;
+
+    /**
+     * Force the Verlet list to be rebuilt on the next pair calculation. This must be called
+     * whenever nodes are added to or deleted from the collection.
+     */
+    void ResetVerletList();
+
+    /**
+     * @return #mNodePairIndices, the global node indices of the pairs from the most recent
+     * pair calculation using cell lists.
+     */
+    const std::vector<unsigned>& rGetNodePairIndices() const;
+
     /**
      *  Compute all the pairs of (potentially) connected nodes for cell_based simulations, ie nodes which are in a
      *  local box to the box containing the first node. **Note: the user still has to check that the node
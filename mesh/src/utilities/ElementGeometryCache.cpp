@@ -0,0 +1,183 @@
+/*
+
+Copyright (c) 2005-2017, University of Oxford.
+All rights reserved.
+
+University of Oxford means the Chancellor, Masters and Scholars of the
+University of Oxford, having an administrative office at Wellington
+Square, Oxford OX1 2JD, UK.
+
+This file is part of Chaste.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+ * Redistributions of source code must retain the above copyright notice,
+   this list of conditions and the following disclaimer.
+ * Redistributions in binary form must reproduce the above copyright notice,
+   this list of conditions and the following disclaimer in the documentation
+   and/or other materials provided with the distribution.
+ * Neither the name of the University of Oxford nor the names of its
+   contributors may be used to endorse or promote products derived from this
+   software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+*/
+
+
+#include "ElementGeometryCache.hpp"
+
+#include <cassert>
+
+template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+const unsigned ElementGeometryCache<ELEMENT_DIM, SPACE_DIM>::ALIGNMENT;
+
+template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+ElementGeometryCache<ELEMENT_DIM, SPACE_DIM>::ElementGeometryCache(unsigned numElements)
+    : mNumElements(numElements),
+      mAlignmentOffset(0),
+      mElementIndices(numElements)
+{
+    // Determinant, inverse Jacobian and basis gradients, padded to the alignment
+    unsigned record_size = 1 + ELEMENT_DIM*SPACE_DIM + SPACE_DIM*(ELEMENT_DIM+1);
+    mRecordSize = ALIGNMENT*((record_size + ALIGNMENT - 1)/ALIGNMENT);
+
+    mStorage.resize(mNumElements*mRecordSize + ALIGNMENT - 1, 0.0);
+    std::size_t alignment_bytes = ALIGNMENT*sizeof(double);
+    std::size_t misalignment = reinterpret_cast<std::size_t>(&mStorage[0]) % alignment_bytes;
+    if (misalignment != 0)
+    {
+        // std::vector storage is always at least aligned to a double
+        mAlignmentOffset = (alignment_bytes - misalignment)/sizeof(double);
+    }
+}
+
+template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+double* ElementGeometryCache<ELEMENT_DIM, SPACE_DIM>::GetRecord(unsigned position)
+{
+    assert(position < mNumElements);
+    return &mStorage[mAlignmentOffset + position*mRecordSize];
+}
+
+template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+const double* ElementGeometryCache<ELEMENT_DIM, SPACE_DIM>::GetRecord(unsigned position) const
+{
+    assert(position < mNumElements);
+    return &mStorage[mAlignmentOffset + position*mRecordSize];
+}
+
+template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+void ElementGeometryCache<ELEMENT_DIM, SPACE_DIM>::SetElementData(unsigned position,
+                                                                  unsigned elementIndex,
+                                                                  double jacobianDeterminant,
+                                                                  const c_matrix<double, ELEMENT_DIM, SPACE_DIM>& rInverseJacobian)
+{
+    mElementIndices[position] = elementIndex;
+
+    double* p_record = GetRecord(position);
+    p_record[0] = jacobianDeterminant;
+
+    double* p_inverse_jacobian = p_record + 1;
+    for (unsigned i=0; i<ELEMENT_DIM; i++)
+    {
+        for (unsigned j=0; j<SPACE_DIM; j++)
+        {
+            p_inverse_jacobian[i*SPACE_DIM + j] = rInverseJacobian(i,j);
+        }
+    }
+
+    /*
+     * The canonical gradients of the linear basis functions are -1 (for phi_0) and
+     * the unit vectors (for phi_1..phi_ELEMENT_DIM), so the transformed gradient of
+     * phi_{k+1} is row k of the inverse Jacobian, and that of phi_0 minus their sum.
+     */
+    double* p_grad_phi = p_inverse_jacobian + ELEMENT_DIM*SPACE_DIM;
+    for (unsigned i=0; i<SPACE_DIM; i++)
+    {
+        double sum = 0.0;
+        for (unsigned k=0; k<ELEMENT_DIM; k++)
+        {
+            p_grad_phi[i*(ELEMENT_DIM+1) + k+1] = rInverseJacobian(k,i);
+            sum += rInverseJacobian(k,i);
+        }
+        p_grad_phi[i*(ELEMENT_DIM+1)] = -sum;
+    }
+}
+
+template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+unsigned ElementGeometryCache<ELEMENT_DIM, SPACE_DIM>::GetNumElements() const
+{
+    return mNumElements;
+}
+
+template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+unsigned ElementGeometryCache<ELEMENT_DIM, SPACE_DIM>::GetElementIndex(unsigned position) const
+{
+    assert(position < mNumElements);
+    return mElementIndices[position];
+}
+
+template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+double ElementGeometryCache<ELEMENT_DIM, SPACE_DIM>::GetJacobianDeterminant(unsigned position) const
+{
+    return GetRecord(position)[0];
+}
+
+template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+void ElementGeometryCache<ELEMENT_DIM, SPACE_DIM>::GetInverseJacobian(unsigned position,
+                                                                      c_matrix<double, ELEMENT_DIM, SPACE_DIM>& rInverseJacobian) const
+{
+    const double* p_inverse_jacobian = GetRecord(position) + 1;
+    for (unsigned i=0; i<ELEMENT_DIM; i++)
+    {
+        for (unsigned j=0; j<SPACE_DIM; j++)
+        {
+            rInverseJacobian(i,j) = p_inverse_jacobian[i*SPACE_DIM + j];
+        }
+    }
+}
+
+template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+void ElementGeometryCache<ELEMENT_DIM, SPACE_DIM>::GetLinearBasisGradients(unsigned position,
+                                                                           c_matrix<double, SPACE_DIM, ELEMENT_DIM+1>& rGradPhi) const
+{
+    const double* p_grad_phi = GetRecord(position) + 1 + ELEMENT_DIM*SPACE_DIM;
+    for (unsigned i=0; i<SPACE_DIM; i++)
+    {
+        for (unsigned j=0; j<ELEMENT_DIM+1; j++)
+        {
+            rGradPhi(i,j) = p_grad_phi[i*(ELEMENT_DIM+1) + j];
+        }
+    }
+}
+
+template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+unsigned ElementGeometryCache<ELEMENT_DIM, SPACE_DIM>::GetRecordSize() const
+{
+    return mRecordSize;
+}
+
+template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+std::size_t ElementGeometryCache<ELEMENT_DIM, SPACE_DIM>::GetMemoryUsage() const
+{
+    return sizeof(*this)
+           + mStorage.capacity()*sizeof(double)
+           + mElementIndices.capacity()*sizeof(unsigned);
+}
+
+// Explicit instantiation
+template class ElementGeometryCache<1,1>;
+template class ElementGeometryCache<1,2>;
+template class ElementGeometryCache<1,3>;
+template class ElementGeometryCache<2,2>;
+template class ElementGeometryCache<2,3>;
+template class ElementGeometryCache<3,3>;
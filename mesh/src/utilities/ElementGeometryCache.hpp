@@ -0,0 +1,156 @@
+/*
+
+Copyright (c) 2005-2017, University of Oxford.
+All rights reserved.
+
+University of Oxford means the Chancellor, Masters and Scholars of the
+University of Oxford, having an administrative office at Wellington
+Square, Oxford OX1 2JD, UK.
+
+This file is part of Chaste.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+ * Redistributions of source code must retain the above copyright notice,
+   this list of conditions and the following disclaimer.
+ * Redistributions in binary form must reproduce the above copyright notice,
+   this list of conditions and the following disclaimer in the documentation
+   and/or other materials provided with the distribution.
+ * Neither the name of the University of Oxford nor the names of its
+   contributors may be used to endorse or promote products derived from this
+   software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+*/
+
+
+#ifndef ELEMENTGEOMETRYCACHE_HPP_
+#define ELEMENTGEOMETRYCACHE_HPP_
+
+#include <cstddef>
+#include <vector>
+#include <boost/utility.hpp>
+
+#include "UblasMatrixInclude.hpp"
+
+/**
+ * Per-element geometric data for linear simplices, precomputed so that finite element
+ * assemblers need not recompute Jacobians on every assembly.
+ *
+ * For each element the cache stores, in one fixed-size record, the Jacobian determinant,
+ * the inverse Jacobian (row major) and the gradients of the linear basis functions with
+ * respect to physical coordinates (row major, i.e. d(phi_j)/d(x_i) at [i*(ELEMENT_DIM+1)+j]).
+ * All of these are constant on a linear element.  Records are padded to a multiple of
+ * 32 bytes and the first record starts on a 32-byte boundary, so each record can be
+ * loaded with aligned SIMD instructions.
+ *
+ * Records are addressed by position, which is the order in which the mesh's element
+ * iterator visits the elements (see AbstractTetrahedralMesh::rGetElementGeometryCache()).
+ */
+template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+class ElementGeometryCache : private boost::noncopyable
+{
+private:
+
+    /** The alignment of each record, in doubles. */
+    static const unsigned ALIGNMENT = 4u;
+
+    /** The number of elements in the cache. */
+    unsigned mNumElements;
+
+    /** The number of doubles in each (padded) record. */
+    unsigned mRecordSize;
+
+    /** Storage for the records, with room to align the first one. */
+    std::vector<double> mStorage;
+
+    /** The offset into mStorage of the first (aligned) record. */
+    unsigned mAlignmentOffset;
+
+    /** The global index of the element stored at each position. */
+    std::vector<unsigned> mElementIndices;
+
+    /**
+     * @return the record at a given position
+     * @param position  the position of the element
+     */
+    double* GetRecord(unsigned position);
+
+public:
+
+    /**
+     * Constructor.  The records must then be filled with SetElementData().
+     *
+     * @param numElements  the number of elements to be cached
+     */
+    ElementGeometryCache(unsigned numElements);
+
+    /**
+     * Store the data for one element, computing its linear basis function gradients.
+     *
+     * @param position  the position of the element
+     * @param elementIndex  the global index of the element
+     * @param jacobianDeterminant  the determinant of the element's Jacobian
+     * @param rInverseJacobian  the (pseudo-)inverse of the element's Jacobian
+     */
+    void SetElementData(unsigned position,
+                        unsigned elementIndex,
+                        double jacobianDeterminant,
+                        const c_matrix<double, ELEMENT_DIM, SPACE_DIM>& rInverseJacobian);
+
+    /** @return the number of elements in the cache */
+    unsigned GetNumElements() const;
+
+    /**
+     * @return the global index of the element stored at a given position
+     * @param position  the position of the element
+     */
+    unsigned GetElementIndex(unsigned position) const;
+
+    /**
+     * @return the Jacobian determinant of the element at a given position
+     * @param position  the position of the element
+     */
+    double GetJacobianDeterminant(unsigned position) const;
+
+    /**
+     * Get the inverse Jacobian of the element at a given position.
+     *
+     * @param position  the position of the element
+     * @param rInverseJacobian  filled in with the inverse Jacobian
+     */
+    void GetInverseJacobian(unsigned position, c_matrix<double, ELEMENT_DIM, SPACE_DIM>& rInverseJacobian) const;
+
+    /**
+     * Get the gradients of the linear basis functions on the element at a given position,
+     * in the form returned by LinearBasisFunction::ComputeTransformedBasisFunctionDerivatives().
+     *
+     * @param position  the position of the element
+     * @param rGradPhi  filled in with the gradients, rGradPhi(i,j) = d(phi_j)/d(x_i)
+     */
+    void GetLinearBasisGradients(unsigned position, c_matrix<double, SPACE_DIM, ELEMENT_DIM+1>& rGradPhi) const;
+
+    /**
+     * @return the raw (32-byte aligned) record of the element at a given position, for vectorised kernels
+     * @param position  the position of the element
+     */
+    const double* GetRecord(unsigned position) const;
+
+    /** @return the number of doubles in each (padded) record */
+    unsigned GetRecordSize() const;
+
+    /** @return the memory used by the cache, in bytes */
+    std::size_t GetMemoryUsage() const;
+};
+
+#endif // ELEMENTGEOMETRYCACHE_HPP_
@@ -34,6 +34,7 @@ OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 */
 
 #include "MutableVertexMesh.hpp"
+#include "VertexElementGrid.hpp"
 #include "UblasCustomFunctions.hpp"
 #include "Warnings.hpp"
 #include "LogFile.hpp"
@@ -53,7 +54,8 @@ MutableVertexMesh<ELEMENT_DIM, SPACE_DIM>::MutableVertexMesh(std::vector<Node<SP
           mProtorosetteFormationProbability(protorosetteFormationProbability),
           mProtorosetteResolutionProbabilityPerTimestep(protorosetteResolutionProbabilityPerTimestep),
           mRosetteResolutionProbabilityPerTimestep(rosetteResolutionProbabilityPerTimestep),
-          mCheckForInternalIntersections(false)
+          mCheckForInternalIntersections(false),
+          mpElementGrid(NULL)
 {
     // Threshold parameters must be strictly positive
     assert(cellRearrangementThreshold > 0.0);
@@ -126,7 +128,8 @@ MutableVertexMesh<ELEMENT_DIM, SPACE_DIM>::MutableVertexMesh()
       mProtorosetteFormationProbability(0.0),
       mProtorosetteResolutionProbabilityPerTimestep(0.0),
       mRosetteResolutionProbabilityPerTimestep(0.0),
-      mCheckForInternalIntersections(false)
+      mCheckForInternalIntersections(false),
+      mpElementGrid(NULL)
 {
     // Note that the member variables initialised above will be overwritten as soon as archiving is complete
     this->mMeshChangesDuringSimulation = true;
@@ -262,6 +265,10 @@ void MutableVertexMesh<ELEMENT_DIM, SPACE_DIM>::Clear()
     mDeletedNodeIndices.clear();
     mDeletedElementIndices.clear();
 
+    // The grid refers to the elements being removed
+    delete mpElementGrid;
+    mpElementGrid = NULL;
+
     VertexMesh<ELEMENT_DIM, SPACE_DIM>::Clear();
 }
 
@@ -878,6 +885,7 @@ void MutableVertexMesh<ELEMENT_DIM, SPACE_DIM>::ReMesh(VertexElementMap& rElemen
         }
 
         // Check for element intersections
+        SetUpElementGrid();
         recheck_mesh = true;
         while (recheck_mesh == true)
         {
@@ -912,23 +920,34 @@ void MutableVertexMesh<ELEMENT_DIM, SPACE_DIM>::ReMesh()
 template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
 bool MutableVertexMesh<ELEMENT_DIM, SPACE_DIM>::CheckForSwapsFromShortEdges()
 {
+    /*
+     * A swap only changes the elements containing the two nodes involved and their neighbours,
+     * so rather than halting the search after the first swap we mark these elements as changed
+     * and carry on checking the others.  Elements added by a swap are left for the next pass.
+     */
+    bool swap_performed = false;
+    std::vector<bool> element_changed(this->GetNumAllElements(), false);
+    unsigned num_elements_to_check = this->GetNumAllElements();
+
     // Loop over elements to check for T1 swaps
-    for (typename VertexMesh<ELEMENT_DIM, SPACE_DIM>::VertexElementIterator elem_iter = this->GetElementIteratorBegin();
-         elem_iter != this->GetElementIteratorEnd();
-         ++elem_iter)
+    for (unsigned elem_index=0; elem_index<num_elements_to_check; elem_index++)
     {
-        ///\todo Could we search more efficiently by just iterating over edges? (see #2401)
+        VertexElement<ELEMENT_DIM, SPACE_DIM>* p_element = this->mElements[elem_index];
+        if (p_element->IsDeleted() || element_changed[elem_index])
+        {
+            continue;
+        }
 
-        unsigned num_nodes = elem_iter->GetNumNodes();
+        unsigned num_nodes = p_element->GetNumNodes();
         assert(num_nodes > 0);
 
         // Loop over the nodes contained in this element
         for (unsigned local_index=0; local_index<num_nodes; local_index++)
         {
             // Find locations of the current node and anticlockwise node
-            Node<SPACE_DIM>* p_current_node = elem_iter->GetNode(local_index);
+            Node<SPACE_DIM>* p_current_node = p_element->GetNode(local_index);
             unsigned local_index_plus_one = (local_index+1)%num_nodes;    ///\todo Use iterators to tidy this up (see #2401)
-            Node<SPACE_DIM>* p_anticlockwise_node = elem_iter->GetNode(local_index_plus_one);
+            Node<SPACE_DIM>* p_anticlockwise_node = p_element->GetNode(local_index_plus_one);
 
             // Find distance between nodes
             double distance_between_nodes = this->GetDistanceBetweenNodes(p_current_node->GetIndex(), p_anticlockwise_node->GetIndex());
@@ -957,17 +976,36 @@ bool MutableVertexMesh<ELEMENT_DIM, SPACE_DIM>::CheckForSwapsFromShortEdges()
                     }
                 }
 
-                // ...and if none are, then perform the required type of swap and halt the search, returning true
+                // ...and if none are, then perform the required type of swap and move on to the next element
                 if (!both_nodes_share_triangular_element)
                 {
+                    // Mark the elements around the two nodes as changed, before the swap alters them
+                    std::set<unsigned> nearby_elements = elements_of_node_a;
+                    nearby_elements.insert(elements_of_node_b.begin(), elements_of_node_b.end());
+                    std::set<unsigned> changed_elements = nearby_elements;
+                    for (std::set<unsigned>::iterator it = nearby_elements.begin(); it != nearby_elements.end(); ++it)
+                    {
+                        VertexElement<ELEMENT_DIM, SPACE_DIM>* p_nearby_element = this->GetElement(*it);
+                        for (unsigned i=0; i<p_nearby_element->GetNumNodes(); i++)
+                        {
+                            const std::set<unsigned>& r_elements = p_nearby_element->GetNode(i)->rGetContainingElementIndices();
+                            changed_elements.insert(r_elements.begin(), r_elements.end());
+                        }
+                    }
+                    for (std::set<unsigned>::iterator it = changed_elements.begin(); it != changed_elements.end(); ++it)
+                    {
+                        element_changed[*it] = true;
+                    }
+
                     IdentifySwapType(p_current_node, p_anticlockwise_node);
-                    return true;
+                    swap_performed = true;
+                    break;
                 }
             }
         }
     }
 
-    return false;
+    return swap_performed;
 }
 
 template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
@@ -998,28 +1036,39 @@ bool MutableVertexMesh<ELEMENT_DIM, SPACE_DIM>::CheckForT2Swaps(VertexElementMap
 template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
 bool MutableVertexMesh<ELEMENT_DIM, SPACE_DIM>::CheckForIntersections()
 {
+    /*
+     * Only the elements whose bounding boxes contain a node can contain it, so we use a grid
+     * over the element bounding boxes to find them.  The candidate elements are checked in
+     * index order, so the first intersection found is the same as if we checked every element.
+     */
+    if (mpElementGrid == NULL)
+    {
+        SetUpElementGrid();
+    }
+    std::vector<unsigned> candidate_elements;
+
     // If checking for internal intersections as well as on the boundary, then check that no nodes have overlapped any elements...
     if (mCheckForInternalIntersections)
     {
-        ///\todo Change to only loop over neighbouring elements (see #2401)
         for (typename AbstractMesh<ELEMENT_DIM,SPACE_DIM>::NodeIterator node_iter = this->GetNodeIteratorBegin();
              node_iter != this->GetNodeIteratorEnd();
              ++node_iter)
         {
             assert(!(node_iter->IsDeleted()));
 
-            for (typename VertexMesh<ELEMENT_DIM, SPACE_DIM>::VertexElementIterator elem_iter = this->GetElementIteratorBegin();
-                 elem_iter != this->GetElementIteratorEnd();
-                 ++elem_iter)
+            mpElementGrid->GetCandidateElements(node_iter->rGetLocation(), candidate_elements);
+            for (unsigned i=0; i<candidate_elements.size(); i++)
             {
-                unsigned elem_index = elem_iter->GetIndex();
+                unsigned elem_index = candidate_elements[i];
 
                 // Check that the node is not part of this element
                 if (node_iter->rGetContainingElementIndices().count(elem_index) == 0)
                 {
                     if (this->ElementIncludesPoint(node_iter->rGetLocation(), elem_index))
                     {
+                        std::set<unsigned> changed_elements = GetElementsNearIntersection(&(*node_iter), elem_index);
                         PerformIntersectionSwap(&(*node_iter), elem_index);
+                        UpdateElementGrid(changed_elements, &(*node_iter), elem_index);
                         return true;
                     }
                 }
@@ -1029,17 +1078,6 @@ bool MutableVertexMesh<ELEMENT_DIM, SPACE_DIM>::CheckForIntersections()
     else
     {
         // ...otherwise, just check that no boundary nodes have overlapped any boundary elements
-        std::set<unsigned> boundary_element_indices;
-        for (typename VertexMesh<ELEMENT_DIM, SPACE_DIM>::VertexElementIterator elem_iter = this->GetElementIteratorBegin();
-             elem_iter != this->GetElementIteratorEnd();
-             ++elem_iter)
-        {
-            if (elem_iter->IsElementOnBoundary())
-            {
-                boundary_element_indices.insert(elem_iter->GetIndex());
-            }
-        }
-
         for (typename AbstractMesh<ELEMENT_DIM,SPACE_DIM>::NodeIterator node_iter = this->GetNodeIteratorBegin();
              node_iter != this->GetNodeIteratorEnd();
              ++node_iter)
@@ -1048,16 +1086,20 @@ bool MutableVertexMesh<ELEMENT_DIM, SPACE_DIM>::CheckForIntersections()
             {
                 assert(!(node_iter->IsDeleted()));
 
-                for (std::set<unsigned>::iterator elem_iter = boundary_element_indices.begin();
-                     elem_iter != boundary_element_indices.end();
-                     ++elem_iter)
+                mpElementGrid->GetCandidateElements(node_iter->rGetLocation(), candidate_elements);
+                for (unsigned i=0; i<candidate_elements.size(); i++)
                 {
+                    unsigned elem_index = candidate_elements[i];
+
                     // Check that the node is not part of this element
-                    if (node_iter->rGetContainingElementIndices().count(*elem_iter) == 0)
+                    if (this->mElements[elem_index]->IsElementOnBoundary()
+                        && node_iter->rGetContainingElementIndices().count(elem_index) == 0)
                     {
-                        if (this->ElementIncludesPoint(node_iter->rGetLocation(), *elem_iter))
+                        if (this->ElementIncludesPoint(node_iter->rGetLocation(), elem_index))
                         {
-                            PerformT3Swap(&(*node_iter), *elem_iter);
+                            std::set<unsigned> changed_elements = GetElementsNearIntersection(&(*node_iter), elem_index);
+                            PerformT3Swap(&(*node_iter), elem_index);
+                            UpdateElementGrid(changed_elements, &(*node_iter), elem_index);
                             return true;
                         }
                     }
@@ -1069,6 +1111,52 @@ bool MutableVertexMesh<ELEMENT_DIM, SPACE_DIM>::CheckForIntersections()
     return false;
 }
 
+template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+void MutableVertexMesh<ELEMENT_DIM, SPACE_DIM>::SetUpElementGrid()
+{
+    if (mpElementGrid == NULL)
+    {
+        mpElementGrid = new VertexElementGrid<ELEMENT_DIM, SPACE_DIM>(*this);
+    }
+    else
+    {
+        mpElementGrid->SetUp();
+    }
+}
+
+template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+std::set<unsigned> MutableVertexMesh<ELEMENT_DIM, SPACE_DIM>::GetElementsNearIntersection(Node<SPACE_DIM>* pNode, unsigned elementIndex)
+{
+    std::set<unsigned> near_elements = pNode->rGetContainingElementIndices();
+    near_elements.insert(elementIndex);
+
+    // Swaps may also move the other nodes of these elements (see WidenEdgeOrCorrectIntersectionLocationIfNecessary())
+    std::set<unsigned> result = near_elements;
+    for (std::set<unsigned>::iterator elem_iter = near_elements.begin(); elem_iter != near_elements.end(); ++elem_iter)
+    {
+        VertexElement<ELEMENT_DIM, SPACE_DIM>* p_element = this->mElements[*elem_iter];
+        for (unsigned local_index=0; local_index<p_element->GetNumNodes(); local_index++)
+        {
+            const std::set<unsigned>& r_elements = p_element->GetNode(local_index)->rGetContainingElementIndices();
+            result.insert(r_elements.begin(), r_elements.end());
+        }
+    }
+    return result;
+}
+
+template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+void MutableVertexMesh<ELEMENT_DIM, SPACE_DIM>::UpdateElementGrid(const std::set<unsigned>& rChangedElements,
+                                                                  Node<SPACE_DIM>* pNode,
+                                                                  unsigned elementIndex)
+{
+    std::set<unsigned> changed_elements = GetElementsNearIntersection(pNode, elementIndex);
+    changed_elements.insert(rChangedElements.begin(), rChangedElements.end());
+    for (std::set<unsigned>::iterator elem_iter = changed_elements.begin(); elem_iter != changed_elements.end(); ++elem_iter)
+    {
+        mpElementGrid->UpdateElement(*elem_iter);
+    }
+}
+
 template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
 void MutableVertexMesh<ELEMENT_DIM, SPACE_DIM>::IdentifySwapType(Node<SPACE_DIM>* pNodeA, Node<SPACE_DIM>* pNodeB)
 {
@@ -38,6 +38,8 @@ OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 // Forward declaration prevents circular include chain
 template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
 class VertexMeshWriter;
+template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+class VertexElementGrid;
 
 #include <iostream>
 #include <map>
@@ -117,6 +119,12 @@ protected:
      */
     std::vector< c_vector<double, SPACE_DIM> > mLocationsOfT3Swaps;
 
+    /**
+     * Grid over the element bounding boxes, used by CheckForIntersections().  It is not
+     * archived, but set up afresh by each ReMesh() (see SetUpElementGrid()).
+     */
+    VertexElementGrid<ELEMENT_DIM, SPACE_DIM>* mpElementGrid;
+
     /**
      * Divide an element along the axis passing through two of its nodes.
      *
@@ -142,6 +150,10 @@ protected:
      * call IdentifySwapType(), which in turn implements the appropriate local remeshing operation
      * (a T1 swap, void removal, or node merge).
      *
+     * Several swaps may be performed in one call, provided that they are far enough apart not to
+     * affect each other: after a swap, the elements around the nodes involved are not checked again
+     * until the next call.
+     *
      * @return whether we need to check for, and implement, any further local remeshing operations
      *                   (true if any swaps are performed).
      */
@@ -153,10 +165,44 @@ protected:
      * Check if any elements have become intersected and correct this by implementing the appropriate
      * local remeshing operation (a T3 swap or node merge).
      *
+     * The element grid (see SetUpElementGrid()) is used so that each node is only tested against
+     * elements nearby, and is updated for the elements changed by any swap performed.
+     *
      * @return whether to recheck the mesh again
      */
     bool CheckForIntersections();
 
+    /**
+     * Helper method for ReMesh().
+     *
+     * Bin the elements in mpElementGrid according to the current node locations, creating
+     * the grid if necessary.  Nodes move between calls to ReMesh(), so this is done once per
+     * call, before CheckForIntersections() is first called.
+     */
+    void SetUpElementGrid();
+
+    /**
+     * Helper method for CheckForIntersections().
+     *
+     * @param pNode pointer to a node found to overlap an element
+     * @param elementIndex global index of that element
+     *
+     * @return the indices of the elements which a swap involving this node and element may
+     *     change: the element, those containing the node, and those sharing a node with any of these
+     */
+    std::set<unsigned> GetElementsNearIntersection(Node<SPACE_DIM>* pNode, unsigned elementIndex);
+
+    /**
+     * Helper method for CheckForIntersections().
+     *
+     * Update mpElementGrid after a swap involving the given node and element.
+     *
+     * @param rChangedElements the result of GetElementsNearIntersection() before the swap
+     * @param pNode pointer to the node
+     * @param elementIndex global index of the element
+     */
+    void UpdateElementGrid(const std::set<unsigned>& rChangedElements, Node<SPACE_DIM>* pNode, unsigned elementIndex);
+
     /**
      * Helper method for ReMesh(), called by CheckForSwapsFromShortEdges() when
      * neighbouring nodes in an element have been found to be closer than the mCellRearrangementThreshold
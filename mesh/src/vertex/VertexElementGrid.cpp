@@ -0,0 +1,294 @@
+/*
+
+Copyright (c) 2005-2017, University of Oxford.
+All rights reserved.
+
+University of Oxford means the Chancellor, Masters and Scholars of the
+University of Oxford, having an administrative office at Wellington
+Square, Oxford OX1 2JD, UK.
+
+This file is part of Chaste.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+ * Redistributions of source code must retain the above copyright notice,
+   this list of conditions and the following disclaimer.
+ * Redistributions in binary form must reproduce the above copyright notice,
+   this list of conditions and the following disclaimer in the documentation
+   and/or other materials provided with the distribution.
+ * Neither the name of the University of Oxford nor the names of its
+   contributors may be used to endorse or promote products derived from this
+   software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+*/
+
+
+#include <algorithm>
+#include <climits>
+#include <cmath>
+
+#include "VertexElementGrid.hpp"
+#include "VertexMesh.hpp"
+
+template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+VertexElementGrid<ELEMENT_DIM, SPACE_DIM>::VertexElementGrid(VertexMesh<ELEMENT_DIM, SPACE_DIM>& rMesh)
+    : mrMesh(rMesh),
+      mBoxWidth(1.0)
+{
+    SetUp();
+}
+
+template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+bool VertexElementGrid<ELEMENT_DIM, SPACE_DIM>::GetBoundingBox(unsigned elementIndex,
+                                                               c_vector<double, SPACE_DIM>& rMin,
+                                                               c_vector<double, SPACE_DIM>& rMax)
+{
+    VertexElement<ELEMENT_DIM, SPACE_DIM>* p_element = mrMesh.GetElement(elementIndex);
+    const c_vector<double, SPACE_DIM>& r_first_location = p_element->GetNode(0)->rGetLocation();
+
+    // Bounding box of the element unwrapped about its first node, and of the raw node locations
+    rMin = r_first_location;
+    rMax = r_first_location;
+    c_vector<double, SPACE_DIM> raw_min = r_first_location;
+    c_vector<double, SPACE_DIM> raw_max = r_first_location;
+    for (unsigned local_index=1; local_index<p_element->GetNumNodes(); local_index++)
+    {
+        const c_vector<double, SPACE_DIM>& r_location = p_element->GetNode(local_index)->rGetLocation();
+        c_vector<double, SPACE_DIM> unwrapped = r_first_location + mrMesh.GetVectorFromAtoB(r_first_location, r_location);
+        for (unsigned i=0; i<SPACE_DIM; i++)
+        {
+            rMin[i] = std::min(rMin[i], unwrapped[i]);
+            rMax[i] = std::max(rMax[i], unwrapped[i]);
+            raw_min[i] = std::min(raw_min[i], r_location[i]);
+            raw_max[i] = std::max(raw_max[i], r_location[i]);
+        }
+    }
+
+    bool wraps = false;
+    for (unsigned i=0; i<SPACE_DIM; i++)
+    {
+        double tolerance = 1e-10*(1.0 + raw_max[i] - raw_min[i]);
+        if (fabs(rMin[i] - raw_min[i]) > tolerance || fabs(rMax[i] - raw_max[i]) > tolerance)
+        {
+            wraps = true;
+        }
+
+        // Allow for points lying on the boundary of the element
+        rMin[i] -= tolerance;
+        rMax[i] += tolerance;
+    }
+    return wraps;
+}
+
+template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+void VertexElementGrid<ELEMENT_DIM, SPACE_DIM>::SetUp()
+{
+    unsigned num_elements = mrMesh.GetNumAllElements();
+    mElementBoxes.assign(num_elements, std::vector<unsigned>());
+    mElementIsGlobal.assign(num_elements, false);
+    mGlobalElements.clear();
+
+    // Find the extent of the non-wrapping elements and their mean size
+    std::vector<bool> wraps(num_elements, true);
+    double total_extent = 0.0;
+    unsigned num_boxed = 0;
+    c_vector<double, SPACE_DIM> overall_min = zero_vector<double>(SPACE_DIM);
+    c_vector<double, SPACE_DIM> overall_max = zero_vector<double>(SPACE_DIM);
+    for (unsigned elem_index=0; elem_index<num_elements; elem_index++)
+    {
+        VertexElement<ELEMENT_DIM, SPACE_DIM>* p_element = mrMesh.GetElement(elem_index);
+        if (!p_element->IsDeleted() && p_element->GetNumNodes() > 0)
+        {
+            c_vector<double, SPACE_DIM> min_corner;
+            c_vector<double, SPACE_DIM> max_corner;
+            wraps[elem_index] = GetBoundingBox(elem_index, min_corner, max_corner);
+            if (!wraps[elem_index])
+            {
+                for (unsigned i=0; i<SPACE_DIM; i++)
+                {
+                    overall_min[i] = (num_boxed == 0) ? min_corner[i] : std::min(overall_min[i], min_corner[i]);
+                    overall_max[i] = (num_boxed == 0) ? max_corner[i] : std::max(overall_max[i], max_corner[i]);
+                    total_extent += max_corner[i] - min_corner[i];
+                }
+                num_boxed++;
+            }
+        }
+    }
+
+    mMinCorner = overall_min;
+    mBoxWidth = (num_boxed > 0) ? total_extent/(num_boxed*SPACE_DIM) : 1.0;
+    if (mBoxWidth <= 0.0)
+    {
+        mBoxWidth = 1.0;
+    }
+
+    // Limit the number of boxes to a few per element, in case of very uneven element sizes
+    double max_num_boxes = 4.0*num_boxed + 1.0;
+    while (true)
+    {
+        double num_boxes = 1.0;
+        for (unsigned i=0; i<SPACE_DIM; i++)
+        {
+            mNumBoxes[i] = (unsigned)floor((overall_max[i] - overall_min[i])/mBoxWidth) + 1;
+            num_boxes *= mNumBoxes[i];
+        }
+        if (num_boxes <= max_num_boxes)
+        {
+            mBoxElements.assign((unsigned)num_boxes, std::vector<unsigned>());
+            break;
+        }
+        mBoxWidth *= 2.0;
+    }
+
+    for (unsigned elem_index=0; elem_index<num_elements; elem_index++)
+    {
+        InsertElement(elem_index);
+    }
+}
+
+template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+void VertexElementGrid<ELEMENT_DIM, SPACE_DIM>::InsertElement(unsigned elementIndex)
+{
+    VertexElement<ELEMENT_DIM, SPACE_DIM>* p_element = mrMesh.GetElement(elementIndex);
+    if (p_element->IsDeleted() || p_element->GetNumNodes() == 0)
+    {
+        return;
+    }
+
+    c_vector<double, SPACE_DIM> min_corner;
+    c_vector<double, SPACE_DIM> max_corner;
+    bool is_global = GetBoundingBox(elementIndex, min_corner, max_corner);
+
+    // Find the range of boxes overlapped by the bounding box
+    c_vector<unsigned, SPACE_DIM> lower;
+    c_vector<unsigned, SPACE_DIM> upper;
+    for (unsigned i=0; i<SPACE_DIM && !is_global; i++)
+    {
+        double lower_coord = floor((min_corner[i] - mMinCorner[i])/mBoxWidth);
+        double upper_coord = floor((max_corner[i] - mMinCorner[i])/mBoxWidth);
+        if (lower_coord < 0.0 || upper_coord >= mNumBoxes[i])
+        {
+            // The element has moved outside the grid
+            is_global = true;
+        }
+        else
+        {
+            lower[i] = (unsigned)lower_coord;
+            upper[i] = (unsigned)upper_coord;
+        }
+    }
+
+    if (is_global)
+    {
+        mGlobalElements.push_back(elementIndex);
+        mElementIsGlobal[elementIndex] = true;
+        return;
+    }
+
+    // Loop over the boxes in the range, in any dimension
+    c_vector<unsigned, SPACE_DIM> box = lower;
+    while (true)
+    {
+        unsigned box_index = 0;
+        unsigned stride = 1;
+        for (unsigned i=0; i<SPACE_DIM; i++)
+        {
+            box_index += box[i]*stride;
+            stride *= mNumBoxes[i];
+        }
+        mBoxElements[box_index].push_back(elementIndex);
+        mElementBoxes[elementIndex].push_back(box_index);
+
+        unsigned dim = 0;
+        while (dim < SPACE_DIM && box[dim] == upper[dim])
+        {
+            box[dim] = lower[dim];
+            dim++;
+        }
+        if (dim == SPACE_DIM)
+        {
+            break;
+        }
+        box[dim]++;
+    }
+}
+
+template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+void VertexElementGrid<ELEMENT_DIM, SPACE_DIM>::RemoveElement(unsigned elementIndex)
+{
+    for (unsigned i=0; i<mElementBoxes[elementIndex].size(); i++)
+    {
+        std::vector<unsigned>& r_box = mBoxElements[mElementBoxes[elementIndex][i]];
+        r_box.erase(std::find(r_box.begin(), r_box.end(), elementIndex));
+    }
+    mElementBoxes[elementIndex].clear();
+
+    if (mElementIsGlobal[elementIndex])
+    {
+        mGlobalElements.erase(std::find(mGlobalElements.begin(), mGlobalElements.end(), elementIndex));
+        mElementIsGlobal[elementIndex] = false;
+    }
+}
+
+template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+void VertexElementGrid<ELEMENT_DIM, SPACE_DIM>::UpdateElement(unsigned elementIndex)
+{
+    if (elementIndex >= mElementBoxes.size())
+    {
+        mElementBoxes.resize(elementIndex + 1);
+        mElementIsGlobal.resize(elementIndex + 1, false);
+    }
+    RemoveElement(elementIndex);
+    InsertElement(elementIndex);
+}
+
+template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+unsigned VertexElementGrid<ELEMENT_DIM, SPACE_DIM>::GetBoxIndex(const c_vector<double, SPACE_DIM>& rPoint) const
+{
+    unsigned box_index = 0;
+    unsigned stride = 1;
+    for (unsigned i=0; i<SPACE_DIM; i++)
+    {
+        double coord = floor((rPoint[i] - mMinCorner[i])/mBoxWidth);
+        if (coord < 0.0 || coord >= mNumBoxes[i])
+        {
+            return UINT_MAX;
+        }
+        box_index += ((unsigned)coord)*stride;
+        stride *= mNumBoxes[i];
+    }
+    return box_index;
+}
+
+template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+void VertexElementGrid<ELEMENT_DIM, SPACE_DIM>::GetCandidateElements(const c_vector<double, SPACE_DIM>& rPoint,
+                                                                     std::vector<unsigned>& rElementIndices) const
+{
+    rElementIndices = mGlobalElements;
+
+    unsigned box_index = GetBoxIndex(rPoint);
+    if (box_index != UINT_MAX)
+    {
+        rElementIndices.insert(rElementIndices.end(), mBoxElements[box_index].begin(), mBoxElements[box_index].end());
+    }
+    std::sort(rElementIndices.begin(), rElementIndices.end());
+}
+
+// Explicit instantiation
+template class VertexElementGrid<1,1>;
+template class VertexElementGrid<1,2>;
+template class VertexElementGrid<1,3>;
+template class VertexElementGrid<2,2>;
+template class VertexElementGrid<2,3>;
+template class VertexElementGrid<3,3>;
@@ -0,0 +1,150 @@
+/*
+
+Copyright (c) 2005-2017, University of Oxford.
+All rights reserved.
+
+University of Oxford means the Chancellor, Masters and Scholars of the
+University of Oxford, having an administrative office at Wellington
+Square, Oxford OX1 2JD, UK.
+
+This file is part of Chaste.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+ * Redistributions of source code must retain the above copyright notice,
+   this list of conditions and the following disclaimer.
+ * Redistributions in binary form must reproduce the above copyright notice,
+   this list of conditions and the following disclaimer in the documentation
+   and/or other materials provided with the distribution.
+ * Neither the name of the University of Oxford nor the names of its
+   contributors may be used to endorse or promote products derived from this
+   software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+*/
+
+
+#ifndef VERTEXELEMENTGRID_HPP_
+#define VERTEXELEMENTGRID_HPP_
+
+#include <vector>
+#include "UblasVectorInclude.hpp"
+
+template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+class VertexMesh;
+
+/**
+ * A uniform grid over the bounding boxes of the elements of a VertexMesh, used to
+ * find the elements that may contain a point without testing every element.
+ *
+ * Each element is recorded in every grid box that its bounding box overlaps.  The
+ * bounding box of an element is found using GetVectorFromAtoB() relative to its first
+ * node, so elements that wrap around a periodic boundary (e.g. in a Cylindrical2dVertexMesh)
+ * are recognised; these are kept in a separate list and returned as candidates for every
+ * point, as are elements that have moved outside the grid since it was set up.
+ */
+template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+class VertexElementGrid
+{
+private:
+
+    /** The mesh whose elements are indexed. */
+    VertexMesh<ELEMENT_DIM, SPACE_DIM>& mrMesh;
+
+    /** The lower corner of the grid. */
+    c_vector<double, SPACE_DIM> mMinCorner;
+
+    /** The width of each grid box. */
+    double mBoxWidth;
+
+    /** The number of grid boxes in each direction. */
+    c_vector<unsigned, SPACE_DIM> mNumBoxes;
+
+    /** The indices of the elements overlapping each grid box. */
+    std::vector<std::vector<unsigned> > mBoxElements;
+
+    /** The indices of elements that are candidates for every point. */
+    std::vector<unsigned> mGlobalElements;
+
+    /** For each element, the grid boxes it is recorded in (empty if deleted or global). */
+    std::vector<std::vector<unsigned> > mElementBoxes;
+
+    /** Whether each element is in mGlobalElements. */
+    std::vector<bool> mElementIsGlobal;
+
+    /**
+     * Compute the bounding box of an element.
+     *
+     * @param elementIndex  the element index
+     * @param rMin  filled with the lower corner of the bounding box
+     * @param rMax  filled with the upper corner of the bounding box
+     *
+     * @return whether the element wraps around a periodic boundary
+     */
+    bool GetBoundingBox(unsigned elementIndex, c_vector<double, SPACE_DIM>& rMin, c_vector<double, SPACE_DIM>& rMax);
+
+    /**
+     * Record an element in the grid boxes overlapping its bounding box,
+     * or in the global list if necessary.
+     *
+     * @param elementIndex  the element index
+     */
+    void InsertElement(unsigned elementIndex);
+
+    /**
+     * Remove an element from the grid boxes and global list.
+     *
+     * @param elementIndex  the element index
+     */
+    void RemoveElement(unsigned elementIndex);
+
+    /**
+     * @return the index of the grid box containing a point, or UINT_MAX if it lies outside the grid.
+     *
+     * @param rPoint  the point
+     */
+    unsigned GetBoxIndex(const c_vector<double, SPACE_DIM>& rPoint) const;
+
+public:
+
+    /**
+     * Constructor.  Calls SetUp().
+     *
+     * @param rMesh  the mesh whose elements are indexed
+     */
+    VertexElementGrid(VertexMesh<ELEMENT_DIM, SPACE_DIM>& rMesh);
+
+    /**
+     * (Re)build the grid from the current node locations.  The box width is the
+     * mean extent of the element bounding boxes, so each element overlaps a few boxes.
+     */
+    void SetUp();
+
+    /**
+     * Update the grid after the nodes of an element have moved, or the element has
+     * been added or deleted.
+     *
+     * @param elementIndex  the element index
+     */
+    void UpdateElement(unsigned elementIndex);
+
+    /**
+     * Find the elements whose bounding boxes may contain a point.
+     *
+     * @param rPoint  the point
+     * @param rElementIndices  filled with the candidate element indices, in increasing order
+     */
+    void GetCandidateElements(const c_vector<double, SPACE_DIM>& rPoint, std::vector<unsigned>& rElementIndices) const;
+};
+
+#endif /*VERTEXELEMENTGRID_HPP_*/
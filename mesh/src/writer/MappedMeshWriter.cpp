@@ -0,0 +1,204 @@
+/*
+
+Copyright (c) 2005-2017, University of Oxford.
+All rights reserved.
+
+University of Oxford means the Chancellor, Masters and Scholars of the
+University of Oxford, having an administrative office at Wellington
+Square, Oxford OX1 2JD, UK.
+
+This file is part of Chaste.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+ * Redistributions of source code must retain the above copyright notice,
+   this list of conditions and the following disclaimer.
+ * Redistributions in binary form must reproduce the above copyright notice,
+   this list of conditions and the following disclaimer in the documentation
+   and/or other materials provided with the distribution.
+ * Neither the name of the University of Oxford nor the names of its
+   contributors may be used to endorse or promote products derived from this
+   software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+*/
+
+
+#include "MappedMeshWriter.hpp"
+
+#include <cassert>
+#include <cstring>
+#include <vector>
+
+#include "Exception.hpp"
+#include "MappedMeshFormat.hpp"
+
+/**
+ * Write a value to a binary stream in native byte order.
+ *
+ * @param rFile  the stream to write to
+ * @param rValue  the value to write
+ * @param rPosition  the current byte offset in the file, advanced past the value
+ */
+template<typename T>
+static void WriteBinaryValue(std::ofstream& rFile, const T& rValue, boost::uint64_t& rPosition)
+{
+    rFile.write(reinterpret_cast<const char*>(&rValue), sizeof(T));
+    rPosition += sizeof(T);
+}
+
+/**
+ * Pad a binary stream with zeros up to the next multiple of 8 bytes, so that the
+ * next section starts on an aligned offset.
+ *
+ * @param rFile  the stream to write to
+ * @param rPosition  the current byte offset in the file, advanced past the padding
+ */
+static void AlignSection(std::ofstream& rFile, boost::uint64_t& rPosition)
+{
+    while (rPosition % 8 != 0)
+    {
+        WriteBinaryValue(rFile, '\0', rPosition);
+    }
+}
+
+template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+MappedMeshWriter<ELEMENT_DIM, SPACE_DIM>::MappedMeshWriter(const std::string& rDirectory,
+                                                           const std::string& rBaseName,
+                                                           const bool clearOutputDir)
+    : AbstractTetrahedralMeshWriter<ELEMENT_DIM, SPACE_DIM>(rDirectory, rBaseName, clearOutputDir)
+{
+}
+
+template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+MappedMeshWriter<ELEMENT_DIM, SPACE_DIM>::~MappedMeshWriter()
+{
+}
+
+template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+void MappedMeshWriter<ELEMENT_DIM, SPACE_DIM>::WriteFiles()
+{
+    std::string file_name = this->mBaseName + MAPPED_MESH_FILE_EXTENSION;
+    out_stream p_file = this->mpOutputFileHandler->OpenOutputFile(file_name, std::ios::binary | std::ios::trunc);
+
+    MappedMeshHeader header;
+    memset(&header, 0, sizeof(MappedMeshHeader));
+    memcpy(header.Magic, MAPPED_MESH_MAGIC, sizeof(MAPPED_MESH_MAGIC));
+    header.Version = MAPPED_MESH_VERSION;
+    header.Endianness = 1u;
+    header.ElementDim = ELEMENT_DIM;
+    header.SpaceDim = SPACE_DIM;
+    header.NumNodes = this->GetNumNodes();
+    header.NumElements = this->GetNumElements();
+    header.NumFaces = this->GetNumBoundaryFaces();
+    header.NodesPerElement = ELEMENT_DIM+1;
+    header.NodesPerFace = ELEMENT_DIM;
+
+    // The header is written again once the section offsets are known
+    boost::uint64_t position = 0;
+    WriteBinaryValue(*p_file, header, position);
+
+    // Nodes
+    header.NodesOffset = position;
+    for (unsigned item_num=0; item_num<header.NumNodes; item_num++)
+    {
+        std::vector<double> coords = this->GetNextNode();
+        assert(coords.size() == SPACE_DIM);
+        for (unsigned i=0; i<SPACE_DIM; i++)
+        {
+            WriteBinaryValue(*p_file, coords[i], position);
+        }
+    }
+
+    // Elements, keeping their node indices to build the connectivity list
+    AlignSection(*p_file, position);
+    header.ElementsOffset = position;
+    std::vector<boost::uint32_t> element_nodes;
+    element_nodes.reserve(header.NumElements*header.NodesPerElement);
+    for (unsigned item_num=0; item_num<header.NumElements; item_num++)
+    {
+        ElementData element_data = this->GetNextElement();
+        if (element_data.NodeIndices.size() != header.NodesPerElement)
+        {
+            EXCEPTION("Mapped mesh files only support linear elements.");
+        }
+        for (unsigned i=0; i<header.NodesPerElement; i++)
+        {
+            boost::uint32_t node_index = element_data.NodeIndices[i];
+            if (node_index >= header.NumNodes)
+            {
+                EXCEPTION("Element " << item_num << " refers to node " << node_index << " which does not exist.");
+            }
+            WriteBinaryValue(*p_file, node_index, position);
+            element_nodes.push_back(node_index);
+        }
+        WriteBinaryValue(*p_file, element_data.AttributeValue, position);
+    }
+
+    // Boundary elements
+    AlignSection(*p_file, position);
+    header.FacesOffset = position;
+    for (unsigned item_num=0; item_num<header.NumFaces; item_num++)
+    {
+        ElementData face_data = this->GetNextBoundaryElement();
+        assert(face_data.NodeIndices.size() == header.NodesPerFace);
+        for (unsigned i=0; i<header.NodesPerFace; i++)
+        {
+            boost::uint32_t node_index = face_data.NodeIndices[i];
+            WriteBinaryValue(*p_file, node_index, position);
+        }
+        WriteBinaryValue(*p_file, face_data.AttributeValue, position);
+    }
+
+    // Node connectivity list, in compressed row format
+    std::vector<boost::uint64_t> ncl_offsets(header.NumNodes+1, 0);
+    for (unsigned i=0; i<element_nodes.size(); i++)
+    {
+        ncl_offsets[element_nodes[i]+1]++;
+    }
+    for (unsigned node_index=0; node_index<header.NumNodes; node_index++)
+    {
+        ncl_offsets[node_index+1] += ncl_offsets[node_index];
+    }
+    std::vector<boost::uint32_t> ncl_data(element_nodes.size());
+    std::vector<boost::uint64_t> next_entry(ncl_offsets.begin(), ncl_offsets.end()-1);
+    for (unsigned i=0; i<element_nodes.size(); i++)
+    {
+        // Elements are visited in order, so each row comes out sorted
+        ncl_data[next_entry[element_nodes[i]]++] = i/header.NodesPerElement;
+    }
+
+    AlignSection(*p_file, position);
+    header.NclIndexOffset = position;
+    for (unsigned i=0; i<ncl_offsets.size(); i++)
+    {
+        WriteBinaryValue(*p_file, ncl_offsets[i], position);
+    }
+    header.NclDataOffset = position;
+    for (unsigned i=0; i<ncl_data.size(); i++)
+    {
+        WriteBinaryValue(*p_file, ncl_data[i], position);
+    }
+
+    p_file->seekp(0);
+    WriteBinaryValue(*p_file, header, position);
+    p_file->close();
+}
+
+// Explicit instantiation
+template class MappedMeshWriter<1,1>;
+template class MappedMeshWriter<1,2>;
+template class MappedMeshWriter<1,3>;
+template class MappedMeshWriter<2,2>;
+template class MappedMeshWriter<2,3>;
+template class MappedMeshWriter<3,3>;
@@ -935,6 +935,27 @@ public:
         }
     }
 
+    void TestNodeBoundingBoxTreeWithMovedAndDeletedNodes() throw (Exception)
+    {
+        MutableMesh<2,2> mesh;
+        mesh.ConstructRectangularMesh(2,3);
+
+        std::vector<ChastePoint<2> > points(1, ChastePoint<2>(0.1, 0.0));
+        TS_ASSERT_EQUALS(mesh.GetNearestNodeIndexForEachPoint(points)[0], 0u);
+
+        // A deleted node is never returned, even if it was deleted after the tree was built
+        mesh.DeleteNodePriorToReMesh(0);
+        TS_ASSERT_EQUALS(mesh.GetNearestNodeIndexForEachPoint(points)[0], 1u);
+        TS_ASSERT_EQUALS(mesh.rGetNodeBoundingBoxTree().GetNumBoxes(), 11u);
+
+        // Moving nodes, without a concrete move or through the node itself, is noticed when the tree is next used
+        mesh.SetNode(4, ChastePoint<2>(0.15, 0.05), false);
+        TS_ASSERT_EQUALS(mesh.GetNearestNodeIndexForEachPoint(points)[0], 4u);
+        mesh.GetNode(5)->rGetModifiableLocation()[0] = 0.1;
+        mesh.GetNode(5)->rGetModifiableLocation()[1] = 0.02;
+        TS_ASSERT_EQUALS(mesh.GetNearestNodeIndexForEachPoint(points)[0], 5u);
+    }
+
     void TestDeleteNodes() throw (Exception)
     {
         MutableMesh<2,2> mesh;
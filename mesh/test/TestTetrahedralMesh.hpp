@@ -41,6 +41,8 @@ OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <fstream>
 #include <cmath>
 #include <vector>
+#include <algorithm>
+#include <cfloat>
 #include <boost/scoped_array.hpp>
 #include "TetrahedralMesh.hpp"
 #include "TrianglesMeshReader.hpp"
@@ -1299,6 +1301,87 @@ public:
         TS_ASSERT_EQUALS(mesh.GetNearestElementIndexFromTestElements(point1, test_elements), 110u);
     }
 
+    void TestBoundingBoxTreeQueries() throw(Exception)
+    {
+        TrianglesMeshReader<2,2> mesh_reader("mesh/test/data/2D_0_to_1mm_200_elements");
+        TetrahedralMesh<2,2> mesh;
+        mesh.ConstructFromMeshReader(mesh_reader);
+
+        RandomNumberGenerator* p_gen = RandomNumberGenerator::Instance();
+        p_gen->Reseed(0);
+
+        for (unsigned translation=0; translation<2; translation++)
+        {
+            // Include some points outside the mesh, and the nodes themselves, which lie in several elements
+            std::vector<ChastePoint<2> > points;
+            for (unsigned i=0; i<200; i++)
+            {
+                points.push_back(ChastePoint<2>(0.12*p_gen->ranf() - 0.01 + 0.5*translation, 0.12*p_gen->ranf() - 0.01));
+            }
+            for (unsigned i=0; i<mesh.GetNumNodes(); i++)
+            {
+                points.push_back(ChastePoint<2>(mesh.GetNode(i)->rGetLocation()));
+            }
+
+            std::vector<unsigned> containing_elements = mesh.GetContainingElementIndexForEachPoint(points);
+            std::vector<unsigned> nearest_nodes = mesh.GetNearestNodeIndexForEachPoint(points);
+            TS_ASSERT_EQUALS(containing_elements.size(), points.size());
+            TS_ASSERT_EQUALS(nearest_nodes.size(), points.size());
+
+            for (unsigned i=0; i<points.size(); i++)
+            {
+                // Compare with searches through every element and node
+                std::vector<unsigned> all_containing_elements = mesh.GetContainingElementIndices(points[i]);
+                if (all_containing_elements.empty())
+                {
+                    TS_ASSERT_EQUALS(containing_elements[i], UNSIGNED_UNSET);
+                    TS_ASSERT_THROWS_CONTAINS(mesh.GetContainingElementIndex(points[i]), "is not in mesh");
+                }
+                else
+                {
+                    TS_ASSERT_EQUALS(containing_elements[i], all_containing_elements[0]);
+                    TS_ASSERT_EQUALS(mesh.GetContainingElementIndex(points[i]), all_containing_elements[0]);
+                }
+                TS_ASSERT_EQUALS(nearest_nodes[i], (mesh.AbstractMesh<2,2>::GetNearestNodeIndex(points[i])));
+
+                // The nearest element is the first with the largest sum of negative interpolation weights
+                double max_min_weight = -DBL_MAX;
+                unsigned nearest_element = UNSIGNED_UNSET;
+                for (unsigned j=0; j<mesh.GetNumElements(); j++)
+                {
+                    c_vector<double, 3> weight = mesh.GetElement(j)->CalculateInterpolationWeights(points[i]);
+                    double neg_weight_sum = std::min(weight[0], 0.0) + std::min(weight[1], 0.0) + std::min(weight[2], 0.0);
+                    if (neg_weight_sum > max_min_weight)
+                    {
+                        max_min_weight = neg_weight_sum;
+                        nearest_element = j;
+                    }
+                }
+                TS_ASSERT_EQUALS(mesh.GetNearestElementIndex(points[i]), nearest_element);
+            }
+
+            // Translating the mesh refits the trees
+            mesh.Translate(0.5, 0.0);
+        }
+
+        // The trees cover every node and element, and are rebuilt after being cleared
+        TS_ASSERT_EQUALS(mesh.rGetNodeBoundingBoxTree().GetNumBoxes(), mesh.GetNumNodes());
+        TS_ASSERT_EQUALS(mesh.rGetElementBoundingBoxTree().GetNumBoxes(), mesh.GetNumElements());
+        mesh.ClearBoundingBoxTrees();
+        TS_ASSERT_EQUALS(mesh.rGetElementBoundingBoxTree().GetNumBoxes(), mesh.GetNumElements());
+
+        // Moving the nodes directly, without refreshing the mesh, is noticed when the trees are next used
+        for (unsigned i=0; i<mesh.GetNumNodes(); i++)
+        {
+            mesh.GetNode(i)->rGetModifiableLocation() *= 2.0;
+        }
+        std::vector<ChastePoint<2> > moved_points(1, ChastePoint<2>(2.15, 0.15));
+        std::vector<unsigned> all_containing_elements = mesh.GetContainingElementIndices(moved_points[0]);
+        TS_ASSERT_EQUALS(all_containing_elements.empty(), false);
+        TS_ASSERT_EQUALS(mesh.GetContainingElementIndexForEachPoint(moved_points)[0], all_containing_elements[0]);
+        TS_ASSERT_EQUALS(mesh.GetNearestNodeIndexForEachPoint(moved_points)[0], (mesh.AbstractMesh<2,2>::GetNearestNodeIndex(moved_points[0])));
+    }
+
     void TestPointInElement3D() throw(Exception)
     {
         std::vector<Node<3>*> nodes3d;
@@ -1917,6 +2000,54 @@ public:
         }
     }
 
+    void TestCalculateLocalRowNonZeroCounts() throw (Exception)
+    {
+        TetrahedralMesh<1,1> mesh;
+        mesh.ConstructLinearMesh(10);
+        unsigned lo = mesh.GetDistributedVectorFactory()->GetLow();
+        unsigned hi = mesh.GetDistributedVectorFactory()->GetHigh();
+
+        std::vector<PetscInt> diagonal_nonzeros;
+        std::vector<PetscInt> off_diagonal_nonzeros;
+        mesh.CalculateLocalRowNonZeroCounts(2, diagonal_nonzeros, off_diagonal_nonzeros);
+        TS_ASSERT_EQUALS(diagonal_nonzeros.size(), 2*(hi-lo));
+        TS_ASSERT_EQUALS(off_diagonal_nonzeros.size(), 2*(hi-lo));
+
+        for (unsigned node_index=lo; node_index<hi; node_index++)
+        {
+            // End nodes have one neighbour, other nodes two
+            unsigned expected_connectivity = (node_index == 0 || node_index == 10) ? 2 : 3;
+            unsigned expected_halo = 0;
+            if (node_index > 0 && node_index == lo)
+            {
+                expected_halo++;
+            }
+            if (node_index < 10 && node_index == hi-1)
+            {
+                expected_halo++;
+            }
+
+            for (unsigned k=0; k<2; k++)
+            {
+                unsigned row = 2*(node_index-lo) + k;
+                TS_ASSERT_EQUALS(diagonal_nonzeros[row] + off_diagonal_nonzeros[row], (PetscInt)(2*expected_connectivity));
+                TS_ASSERT_EQUALS(off_diagonal_nonzeros[row], (PetscInt)(2*expected_halo));
+            }
+        }
+
+        // In 3d the row lengths are bounded by the maximum connectivity
+        TetrahedralMesh<3,3> mesh_3d;
+        mesh_3d.ConstructCuboid(3, 3, 3);
+        mesh_3d.CalculateLocalRowNonZeroCounts(1, diagonal_nonzeros, off_diagonal_nonzeros);
+        PetscInt max_row_length = 0;
+        for (unsigned row=0; row<diagonal_nonzeros.size(); row++)
+        {
+            max_row_length = std::max(max_row_length, diagonal_nonzeros[row] + off_diagonal_nonzeros[row]);
+        }
+        TS_ASSERT_LESS_THAN_EQUALS(max_row_length, (PetscInt) mesh_3d.CalculateMaximumNodeConnectivityPerProcess());
+        TS_ASSERT_LESS_THAN(0, max_row_length);
+    }
+
     void TestConstructSlabMeshWithDimensionSplit() throw (Exception)
     {
         double step = 1.0;
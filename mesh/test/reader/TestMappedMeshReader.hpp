@@ -0,0 +1,233 @@
+/*
+
+Copyright (c) 2005-2017, University of Oxford.
+All rights reserved.
+
+University of Oxford means the Chancellor, Masters and Scholars of the
+University of Oxford, having an administrative office at Wellington
+Square, Oxford OX1 2JD, UK.
+
+This file is part of Chaste.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+ * Redistributions of source code must retain the above copyright notice,
+   this list of conditions and the following disclaimer.
+ * Redistributions in binary form must reproduce the above copyright notice,
+   this list of conditions and the following disclaimer in the documentation
+   and/or other materials provided with the distribution.
+ * Neither the name of the University of Oxford nor the names of its
+   contributors may be used to endorse or promote products derived from this
+   software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+*/
+
+
+#ifndef TESTMAPPEDMESHREADER_HPP_
+#define TESTMAPPEDMESHREADER_HPP_
+
+#include <cxxtest/TestSuite.h>
+#include <algorithm>
+#include <fstream>
+
+#include "MappedMeshReader.hpp"
+#include "MappedMeshWriter.hpp"
+#include "TrianglesMeshReader.hpp"
+#include "GenericMeshReader.hpp"
+#include "TetrahedralMesh.hpp"
+#include "DistributedTetrahedralMesh.hpp"
+#include "OutputFileHandler.hpp"
+#include "PetscTools.hpp"
+#include "PetscSetupAndFinalize.hpp"
+
+typedef MappedMeshReader<2,2> MAPPED_READER_2D;
+typedef MappedMeshReader<3,3> MAPPED_READER_3D;
+
+class TestMappedMeshReader : public CxxTest::TestSuite
+{
+public:
+
+    void TestWriteFromReaderAndReadBack() throw(Exception)
+    {
+        TrianglesMeshReader<2,2> triangles_reader("mesh/test/data/disk_522_elements");
+        MappedMeshWriter<2,2> mesh_writer("TestMappedMeshReader", "disk");
+        mesh_writer.WriteFilesUsingMeshReader(triangles_reader);
+        PetscTools::Barrier("TestWriteFromReaderAndReadBack"); // Only the master writes
+
+        OutputFileHandler handler("TestMappedMeshReader", false);
+        MappedMeshReader<2,2> mapped_reader(handler.GetOutputDirectoryFullPath() + "disk");
+
+        TS_ASSERT_EQUALS(mapped_reader.GetNumNodes(), 312u);
+        TS_ASSERT_EQUALS(mapped_reader.GetNumElements(), 522u);
+        TS_ASSERT_EQUALS(mapped_reader.GetNumFaces(), triangles_reader.GetNumFaces());
+        TS_ASSERT_EQUALS(mapped_reader.GetNumElementAttributes(), 1u);
+        TS_ASSERT(mapped_reader.IsFileFormatBinary());
+        TS_ASSERT(mapped_reader.HasNclFile());
+        TS_ASSERT_EQUALS(mapped_reader.GetMeshFileBaseName(), handler.GetOutputDirectoryFullPath() + "disk");
+
+        // Sequential access matches the original files
+        triangles_reader.Reset();
+        for (unsigned i=0; i<312u; i++)
+        {
+            std::vector<double> expected = triangles_reader.GetNextNode();
+            std::vector<double> node = mapped_reader.GetNextNode();
+            TS_ASSERT_EQUALS(node.size(), 2u);
+            TS_ASSERT_DELTA(node[0], expected[0], 1e-15);
+            TS_ASSERT_DELTA(node[1], expected[1], 1e-15);
+        }
+        TS_ASSERT_THROWS_THIS(mapped_reader.GetNextNode(), "Cannot get the next line from node file due to incomplete data");
+
+        for (unsigned i=0; i<522u; i++)
+        {
+            ElementData expected = triangles_reader.GetNextElementData();
+            ElementData element = mapped_reader.GetNextElementData();
+            TS_ASSERT(element.NodeIndices == expected.NodeIndices);
+        }
+        for (unsigned i=0; i<triangles_reader.GetNumFaces(); i++)
+        {
+            ElementData expected = triangles_reader.GetNextFaceData();
+            ElementData face = mapped_reader.GetNextFaceData();
+            TS_ASSERT(face.NodeIndices == expected.NodeIndices);
+        }
+
+        // Random access, which also moves the sequential cursor
+        ElementData element = mapped_reader.GetElementData(400);
+        TS_ASSERT(mapped_reader.GetNextElementData().NodeIndices == mapped_reader.GetElementData(401).NodeIndices);
+        TS_ASSERT_THROWS_THIS(mapped_reader.GetElementData(522),
+                              "Element 522 does not exist - not enough elements (only 522).");
+        TS_ASSERT_THROWS_THIS(mapped_reader.GetNode(312), "Node does not exist - not enough nodes.");
+        TS_ASSERT_THROWS_THIS(mapped_reader.GetFaceData(mapped_reader.GetNumFaces()), "Face does not exist - not enough faces.");
+
+        // The stored connectivity list agrees with the mesh
+        triangles_reader.Reset();
+        TetrahedralMesh<2,2> mesh;
+        mesh.ConstructFromMeshReader(triangles_reader);
+        for (unsigned node_index=0; node_index<mesh.GetNumNodes(); node_index++)
+        {
+            std::set<unsigned>& r_expected = mesh.GetNode(node_index)->rGetContainingElementIndices();
+            std::vector<unsigned> containing = mapped_reader.GetContainingElementIndices(node_index);
+            TS_ASSERT_EQUALS(containing.size(), r_expected.size());
+            TS_ASSERT(std::equal(containing.begin(), containing.end(), r_expected.begin()));
+        }
+        TS_ASSERT_THROWS_THIS(mapped_reader.GetContainingElementIndices(312),
+                              "Connectivity list does not exist - not enough nodes.");
+
+        // The generic reader recognises the format
+        std::auto_ptr<AbstractMeshReader<2,2> > p_reader = GenericMeshReader<2,2>(handler.GetOutputDirectoryFullPath() + "disk");
+        TS_ASSERT(dynamic_cast<MAPPED_READER_2D*>(p_reader.get()) != NULL);
+        TS_ASSERT_EQUALS(p_reader->GetNumElements(), 522u);
+    }
+
+    void TestConstructDistributedMeshFromMappedFile() throw(Exception)
+    {
+        TrianglesMeshReader<3,3> triangles_reader("mesh/test/data/cube_2mm_1016_elements_with_bath");
+        TetrahedralMesh<3,3> mesh;
+        mesh.ConstructFromMeshReader(triangles_reader);
+
+        // Writing from a mesh is collective
+        MappedMeshWriter<3,3> mesh_writer("TestMappedMeshReader", "cube", false);
+        mesh_writer.WriteFilesUsingMesh(mesh);
+
+        OutputFileHandler handler("TestMappedMeshReader", false);
+        MappedMeshReader<3,3> mapped_reader(handler.GetOutputDirectoryFullPath() + "cube");
+        DistributedTetrahedralMesh<3,3> distributed_mesh(DistributedTetrahedralMeshPartitionType::DUMB);
+        distributed_mesh.ConstructFromMeshReader(mapped_reader);
+
+        TS_ASSERT_EQUALS(distributed_mesh.GetNumNodes(), mesh.GetNumNodes());
+        TS_ASSERT_EQUALS(distributed_mesh.GetNumElements(), mesh.GetNumElements());
+        TS_ASSERT_EQUALS(distributed_mesh.GetNumBoundaryElements(), mesh.GetNumBoundaryElements());
+
+        for (AbstractTetrahedralMesh<3,3>::NodeIterator it = distributed_mesh.GetNodeIteratorBegin();
+             it != distributed_mesh.GetNodeIteratorEnd();
+             ++it)
+        {
+            c_vector<double,3> expected = mesh.GetNode(it->GetIndex())->rGetLocation();
+            for (unsigned i=0; i<3; i++)
+            {
+                TS_ASSERT_DELTA(it->rGetLocation()[i], expected[i], 1e-15);
+            }
+        }
+
+        for (AbstractTetrahedralMesh<3,3>::ElementIterator it = distributed_mesh.GetElementIteratorBegin();
+             it != distributed_mesh.GetElementIteratorEnd();
+             ++it)
+        {
+            Element<3,3>* p_expected = mesh.GetElement(it->GetIndex());
+            TS_ASSERT_EQUALS(it->GetAttribute(), p_expected->GetAttribute());
+            for (unsigned i=0; i<4; i++)
+            {
+                TS_ASSERT_EQUALS(it->GetNodeGlobalIndex(i), p_expected->GetNodeGlobalIndex(i));
+            }
+        }
+    }
+
+    void TestExceptions() throw(Exception)
+    {
+        TS_ASSERT_THROWS_THIS(MAPPED_READER_3D reader("mesh/test/data/no_such_file"),
+                              "Could not open data file: mesh/test/data/no_such_file.cmesh");
+
+        OutputFileHandler handler("TestMappedMeshReader", false);
+        TS_ASSERT_THROWS_CONTAINS(MAPPED_READER_3D reader(handler.GetOutputDirectoryFullPath() + "disk"),
+                                  "holds a 2-in-2 mesh, not a 3-in-3 mesh.");
+
+        // A file that is not a mapped mesh
+        if (PetscTools::AmMaster())
+        {
+            out_stream p_file = handler.OpenOutputFile("not_a_mesh.cmesh");
+            for (unsigned i=0; i<100; i++)
+            {
+                *p_file << "Not a mesh. ";
+            }
+            p_file->close();
+        }
+        PetscTools::Barrier("TestExceptions");
+        TS_ASSERT_THROWS_CONTAINS(MAPPED_READER_3D reader(handler.GetOutputDirectoryFullPath() + "not_a_mesh"),
+                                  "is not a mapped mesh file.");
+
+        // A connectivity list row that runs past the end of the NCL section
+        std::string corrupt_file_name = handler.GetOutputDirectoryFullPath() + "corrupt_ncl.cmesh";
+        if (PetscTools::AmMaster())
+        {
+            std::ifstream original_file((handler.GetOutputDirectoryFullPath() + "disk.cmesh").c_str(), std::ios::binary);
+            std::ofstream corrupt_file(corrupt_file_name.c_str(), std::ios::binary);
+            corrupt_file << original_file.rdbuf();
+            original_file.close();
+
+            MappedMeshHeader header;
+            std::fstream file(corrupt_file_name.c_str(), std::ios::binary | std::ios::in | std::ios::out);
+            file.read(reinterpret_cast<char*>(&header), sizeof(MappedMeshHeader));
+            boost::uint64_t bad_row_end = 1000000u;
+            file.seekp(header.NclIndexOffset + sizeof(boost::uint64_t));
+            file.write(reinterpret_cast<const char*>(&bad_row_end), sizeof(boost::uint64_t));
+            file.close();
+        }
+        PetscTools::Barrier("TestExceptions corrupt NCL");
+        MAPPED_READER_2D corrupt_reader(handler.GetOutputDirectoryFullPath() + "corrupt_ncl");
+        TS_ASSERT_THROWS_CONTAINS(corrupt_reader.GetContainingElementIndices(0u),
+                                  "Connectivity list of node 0 in mapped mesh file");
+        TS_ASSERT_THROWS_CONTAINS(corrupt_reader.GetContainingElementIndices(1u),
+                                  "corrupt_ncl.cmesh is corrupt.");
+
+        // Quadratic elements cannot be written
+        TrianglesMeshReader<2,2> quadratic_reader("mesh/test/data/square_128_elements_fully_quadratic", 2, 2);
+        MappedMeshWriter<2,2> mesh_writer("TestMappedMeshReader", "quadratic", false);
+        if (PetscTools::AmMaster())
+        {
+            TS_ASSERT_THROWS_THIS(mesh_writer.WriteFilesUsingMeshReader(quadratic_reader),
+                                  "Mapped mesh files only support linear elements.");
+        }
+    }
+};
+
+#endif // TESTMAPPEDMESHREADER_HPP_
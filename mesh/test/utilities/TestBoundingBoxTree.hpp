@@ -0,0 +1,170 @@
+/*
+
+Copyright (c) 2005-2017, University of Oxford.
+All rights reserved.
+
+University of Oxford means the Chancellor, Masters and Scholars of the
+University of Oxford, having an administrative office at Wellington
+Square, Oxford OX1 2JD, UK.
+
+This file is part of Chaste.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+ * Redistributions of source code must retain the above copyright notice,
+   this list of conditions and the following disclaimer.
+ * Redistributions in binary form must reproduce the above copyright notice,
+   this list of conditions and the following disclaimer in the documentation
+   and/or other materials provided with the distribution.
+ * Neither the name of the University of Oxford nor the names of its
+   contributors may be used to endorse or promote products derived from this
+   software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+*/
+
+#ifndef TESTBOUNDINGBOXTREE_HPP_
+#define TESTBOUNDINGBOXTREE_HPP_
+
+#include <cxxtest/TestSuite.h>
+
+#include <cfloat>
+
+#include "BoundingBoxTree.hpp"
+#include "RandomNumberGenerator.hpp"
+#include "Exception.hpp"
+
+//This test is always run sequentially (never in parallel)
+#include "FakePetscSetup.hpp"
+
+class TestBoundingBoxTree : public CxxTest::TestSuite
+{
+private:
+
+    /**
+     * Compare the tree queries with a search through all the boxes, at some random points.
+     */
+    template<unsigned DIM>
+    void CheckQueries(BoundingBoxTree<DIM>& rTree,
+                      const std::vector<c_vector<double, DIM> >& rLowerCorners,
+                      const std::vector<c_vector<double, DIM> >& rUpperCorners)
+    {
+        RandomNumberGenerator* p_gen = RandomNumberGenerator::Instance();
+
+        for (unsigned point=0; point<100; point++)
+        {
+            c_vector<double, DIM> location;
+            for (unsigned d=0; d<DIM; d++)
+            {
+                location[d] = 1.2*p_gen->ranf() - 0.1;
+            }
+
+            std::vector<unsigned> expected_boxes;
+            unsigned expected_nearest_box = UNSIGNED_UNSET;
+            double nearest_squared_distance = DBL_MAX;
+            for (unsigned i=0; i<rLowerCorners.size(); i++)
+            {
+                double squared_distance = 0.0;
+                for (unsigned d=0; d<DIM; d++)
+                {
+                    double gap = std::max(rLowerCorners[i][d] - location[d], location[d] - rUpperCorners[i][d]);
+                    if (gap > 0.0)
+                    {
+                        squared_distance += gap*gap;
+                    }
+                }
+                if (squared_distance == 0.0)
+                {
+                    expected_boxes.push_back(i);
+                }
+                if (squared_distance < nearest_squared_distance)
+                {
+                    nearest_squared_distance = squared_distance;
+                    expected_nearest_box = i;
+                }
+            }
+
+            std::vector<unsigned> boxes;
+            rTree.GetBoxesContainingPoint(location, boxes);
+            TS_ASSERT_EQUALS(boxes, expected_boxes);
+            TS_ASSERT_EQUALS(rTree.GetNearestBox(location), expected_nearest_box);
+        }
+    }
+
+    /**
+     * Build a tree over some random boxes in the unit square/cube and check its queries,
+     * then move the boxes and check them again after refitting.
+     */
+    template<unsigned DIM>
+    void DoTestBoundingBoxTree()
+    {
+        RandomNumberGenerator* p_gen = RandomNumberGenerator::Instance();
+        p_gen->Reseed(0);
+
+        std::vector<c_vector<double, DIM> > lower_corners(500);
+        std::vector<c_vector<double, DIM> > upper_corners(500);
+        for (unsigned i=0; i<lower_corners.size(); i++)
+        {
+            for (unsigned d=0; d<DIM; d++)
+            {
+                lower_corners[i][d] = p_gen->ranf();
+                upper_corners[i][d] = lower_corners[i][d] + 0.1*p_gen->ranf();
+            }
+        }
+
+        BoundingBoxTree<DIM> tree;
+        tree.Build(lower_corners, upper_corners);
+        TS_ASSERT_EQUALS(tree.GetNumBoxes(), 500u);
+        CheckQueries<DIM>(tree, lower_corners, upper_corners);
+
+        for (unsigned i=0; i<lower_corners.size(); i++)
+        {
+            for (unsigned d=0; d<DIM; d++)
+            {
+                double shift = 0.2*p_gen->ranf() - 0.1;
+                lower_corners[i][d] += shift;
+                upper_corners[i][d] += shift;
+            }
+        }
+        tree.Refit(lower_corners, upper_corners);
+        TS_ASSERT_EQUALS(tree.GetNumBoxes(), 500u);
+        CheckQueries<DIM>(tree, lower_corners, upper_corners);
+    }
+
+public:
+
+    void TestBoundingBoxTree1d2d3d() throw (Exception)
+    {
+        DoTestBoundingBoxTree<1>();
+        DoTestBoundingBoxTree<2>();
+        DoTestBoundingBoxTree<3>();
+    }
+
+    void TestEmptyTree() throw (Exception)
+    {
+        std::vector<c_vector<double, 2> > corners;
+        BoundingBoxTree<2> tree;
+        TS_ASSERT_EQUALS(tree.GetNumBoxes(), 0u);
+
+        tree.Build(corners, corners);
+        TS_ASSERT_EQUALS(tree.GetNumBoxes(), 0u);
+
+        c_vector<double, 2> location = zero_vector<double>(2);
+        std::vector<unsigned> boxes(1, 0u);
+        tree.GetBoxesContainingPoint(location, boxes);
+        TS_ASSERT(boxes.empty());
+        TS_ASSERT_EQUALS(tree.GetNearestBox(location), UNSIGNED_UNSET);
+    }
+};
+
+#endif /*TESTBOUNDINGBOXTREE_HPP_*/
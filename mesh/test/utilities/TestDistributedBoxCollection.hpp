@@ -44,6 +44,7 @@ OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "TrianglesMeshReader.hpp"
 #include "ArchiveOpener.hpp"
 #include "Warnings.hpp"
+#include "RandomNumberGenerator.hpp"
 
 #include "PetscSetupAndFinalize.hpp"
 
@@ -1956,6 +1957,153 @@ public:
     }
 
 
+    void TestPairsReturnedUsingCellLists() throw (Exception)
+    {
+        EXIT_IF_PARALLEL;
+
+        // Scatter some nodes over a 5 by 5 domain
+        RandomNumberGenerator* p_gen = RandomNumberGenerator::Instance();
+        p_gen->Reseed(0);
+        std::vector<Node<2>* > nodes;
+        for (unsigned i=0; i<200; i++)
+        {
+            nodes.push_back(new Node<2>(i, false, 4.8*p_gen->ranf(), 4.8*p_gen->ranf()));
+        }
+
+        c_vector<double, 4> domain_size;
+        domain_size(0) = 0.0;
+        domain_size(1) = 5.0;
+        domain_size(2) = 0.0;
+        domain_size(3) = 5.0;
+
+        DistributedBoxCollection<2> box_collection(1.0, domain_size);
+        box_collection.SetupLocalBoxesHalfOnly();
+        TS_ASSERT_EQUALS(box_collection.GetUseCellLists(), false);
+        TS_ASSERT_DELTA(box_collection.GetVerletSkin(), 0.0, 1e-12);
+
+        for (unsigned i=0; i<nodes.size(); i++)
+        {
+            unsigned box_index = box_collection.CalculateContainingBox(nodes[i]);
+            box_collection.rGetBox(box_index).AddNode(nodes[i]);
+        }
+
+        // Calculate the pairs by walking the boxes
+        std::vector< std::pair<Node<2>*, Node<2>* > > pairs_returned_vector;
+        box_collection.CalculateNodePairs(nodes, pairs_returned_vector);
+
+        std::set< std::pair<unsigned, unsigned> > pairs_should_be;
+        for (unsigned i=0; i<pairs_returned_vector.size(); i++)
+        {
+            unsigned index_a = pairs_returned_vector[i].first->GetIndex();
+            unsigned index_b = pairs_returned_vector[i].second->GetIndex();
+            pairs_should_be.insert(std::pair<unsigned, unsigned>(std::min(index_a, index_b), std::max(index_a, index_b)));
+        }
+        std::vector<unsigned> neighbours_of_0 = nodes[0]->rGetNeighbours();
+
+        // The cell lists should give the same pairs and neighbours
+        box_collection.SetUseCellLists(true);
+        TS_ASSERT_EQUALS(box_collection.GetUseCellLists(), true);
+        box_collection.CalculateNodePairs(nodes, pairs_returned_vector);
+
+        TS_ASSERT_EQUALS(pairs_returned_vector.size(), pairs_should_be.size());
+        std::set< std::pair<unsigned, unsigned> > pairs_returned;
+        for (unsigned i=0; i<pairs_returned_vector.size(); i++)
+        {
+            unsigned index_a = pairs_returned_vector[i].first->GetIndex();
+            unsigned index_b = pairs_returned_vector[i].second->GetIndex();
+            pairs_returned.insert(std::pair<unsigned, unsigned>(std::min(index_a, index_b), std::max(index_a, index_b)));
+        }
+        TS_ASSERT(pairs_returned == pairs_should_be);
+        TS_ASSERT_EQUALS(nodes[0]->rGetNeighbours(), neighbours_of_0);
+
+        // The compact index array should match the pairs
+        const std::vector<unsigned>& r_indices = box_collection.rGetNodePairIndices();
+        TS_ASSERT_EQUALS(r_indices.size(), 2*pairs_returned_vector.size());
+        for (unsigned i=0; i<pairs_returned_vector.size(); i++)
+        {
+            TS_ASSERT_EQUALS(r_indices[2*i], pairs_returned_vector[i].first->GetIndex());
+            TS_ASSERT_EQUALS(r_indices[2*i+1], pairs_returned_vector[i].second->GetIndex());
+        }
+
+        // The ordering should be deterministic
+        std::vector<unsigned> indices_before = r_indices;
+        box_collection.CalculateNodePairs(nodes, pairs_returned_vector);
+        TS_ASSERT_EQUALS(box_collection.rGetNodePairIndices(), indices_before);
+
+        // Test Verlet lists
+        TS_ASSERT_THROWS_THIS(box_collection.SetVerletSkin(-0.1, 0.6), "The Verlet skin must be non-negative.");
+        TS_ASSERT_THROWS_THIS(box_collection.SetVerletSkin(0.4, 1.0),
+                              "The interaction distance plus the Verlet skin must not exceed the box width.");
+        box_collection.SetVerletSkin(0.4, 0.6);
+        TS_ASSERT_DELTA(box_collection.GetVerletSkin(), 0.4, 1e-12);
+        TS_ASSERT(box_collection.IsVerletListRebuildNeeded());
+
+        box_collection.CalculateNodePairs(nodes, pairs_returned_vector);
+        TS_ASSERT(!box_collection.IsVerletListRebuildNeeded());
+        std::vector<unsigned> verlet_indices = box_collection.rGetNodePairIndices();
+
+        // Only pairs closer than the interaction distance plus the skin (here the box width) are kept
+        unsigned num_close_pairs = 0;
+        for (std::set< std::pair<unsigned, unsigned> >::iterator iter = pairs_should_be.begin();
+             iter != pairs_should_be.end();
+             ++iter)
+        {
+            if (norm_2(nodes[iter->first]->rGetLocation() - nodes[iter->second]->rGetLocation()) < 1.0)
+            {
+                num_close_pairs++;
+            }
+        }
+        TS_ASSERT_EQUALS(pairs_returned_vector.size(), num_close_pairs);
+
+        // Moving the nodes less than half the skin reuses the list
+        for (unsigned i=0; i<nodes.size(); i++)
+        {
+            nodes[i]->rGetModifiableLocation()[0] += 0.1*p_gen->ranf();
+        }
+        box_collection.EmptyBoxes();
+        for (unsigned i=0; i<nodes.size(); i++)
+        {
+            unsigned box_index = box_collection.CalculateContainingBox(nodes[i]);
+            box_collection.rGetBox(box_index).AddNode(nodes[i]);
+        }
+        TS_ASSERT(!box_collection.IsVerletListRebuildNeeded());
+        box_collection.CalculateNodePairs(nodes, pairs_returned_vector);
+        TS_ASSERT_EQUALS(box_collection.rGetNodePairIndices(), verlet_indices);
+
+        // Every pair closer than the interaction distance is still present
+        pairs_returned.clear();
+        for (unsigned i=0; i<pairs_returned_vector.size(); i++)
+        {
+            unsigned index_a = pairs_returned_vector[i].first->GetIndex();
+            unsigned index_b = pairs_returned_vector[i].second->GetIndex();
+            pairs_returned.insert(std::pair<unsigned, unsigned>(std::min(index_a, index_b), std::max(index_a, index_b)));
+        }
+        for (unsigned i=0; i<nodes.size(); i++)
+        {
+            for (unsigned j=i+1; j<nodes.size(); j++)
+            {
+                if (norm_2(nodes[i]->rGetLocation() - nodes[j]->rGetLocation()) < 0.6)
+                {
+                    TS_ASSERT_EQUALS(pairs_returned.count(std::pair<unsigned, unsigned>(i, j)), 1u);
+                }
+            }
+        }
+
+        // Moving a node more than half the skin forces a rebuild, as does resetting the list
+        nodes[0]->rGetModifiableLocation()[1] += 0.25;
+        TS_ASSERT(box_collection.IsVerletListRebuildNeeded());
+        nodes[0]->rGetModifiableLocation()[1] -= 0.25;
+        TS_ASSERT(!box_collection.IsVerletListRebuildNeeded());
+        box_collection.ResetVerletList();
+        TS_ASSERT(box_collection.IsVerletListRebuildNeeded());
+
+        // Avoid memory leak
+        for (unsigned i=0; i<nodes.size(); i++)
+        {
+            delete nodes[i];
+        }
+    }
+
     void TestBoxGeneration3d() throw (Exception)
     {
         // Create a mesh
@@ -0,0 +1,238 @@
+/*
+
+Copyright (c) 2005-2017, University of Oxford.
+All rights reserved.
+
+University of Oxford means the Chancellor, Masters and Scholars of the
+University of Oxford, having an administrative office at Wellington
+Square, Oxford OX1 2JD, UK.
+
+This file is part of Chaste.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+ * Redistributions of source code must retain the above copyright notice,
+   this list of conditions and the following disclaimer.
+ * Redistributions in binary form must reproduce the above copyright notice,
+   this list of conditions and the following disclaimer in the documentation
+   and/or other materials provided with the distribution.
+ * Neither the name of the University of Oxford nor the names of its
+   contributors may be used to endorse or promote products derived from this
+   software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+*/
+
+#ifndef TESTELEMENTGEOMETRYCACHE_HPP_
+#define TESTELEMENTGEOMETRYCACHE_HPP_
+
+#include <cxxtest/TestSuite.h>
+
+#include "ElementGeometryCache.hpp"
+#include "TetrahedralMesh.hpp"
+#include "MutableMesh.hpp"
+#include "LinearBasisFunction.hpp"
+#include "TrianglesMeshReader.hpp"
+
+//This test is always run sequentially (never in parallel)
+#include "FakePetscSetup.hpp"
+
+class TestElementGeometryCache : public CxxTest::TestSuite
+{
+private:
+
+    /**
+     * Compare the cached data for every element of a mesh with those computed directly.
+     */
+    template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+    void CheckCacheAgainstMesh(AbstractTetrahedralMesh<ELEMENT_DIM, SPACE_DIM>& rMesh)
+    {
+        const ElementGeometryCache<ELEMENT_DIM, SPACE_DIM>& r_cache = rMesh.rGetElementGeometryCache();
+        TS_ASSERT_EQUALS(r_cache.GetNumElements(), rMesh.GetNumElements());
+
+        c_matrix<double, SPACE_DIM, ELEMENT_DIM> jacobian;
+        c_matrix<double, ELEMENT_DIM, SPACE_DIM> inverse_jacobian;
+        double jacobian_determinant;
+        c_matrix<double, ELEMENT_DIM, SPACE_DIM> cached_inverse_jacobian;
+        c_matrix<double, ELEMENT_DIM, ELEMENT_DIM+1> reference_grad_phi;
+        c_matrix<double, SPACE_DIM, ELEMENT_DIM+1> grad_phi;
+        c_matrix<double, SPACE_DIM, ELEMENT_DIM+1> cached_grad_phi;
+        ChastePoint<ELEMENT_DIM> centroid;
+        for (unsigned d=0; d<ELEMENT_DIM; d++)
+        {
+            centroid.rGetLocation()[d] = 1.0/(ELEMENT_DIM+1);
+        }
+
+        unsigned position = 0;
+        for (typename AbstractTetrahedralMesh<ELEMENT_DIM, SPACE_DIM>::ElementIterator iter = rMesh.GetElementIteratorBegin();
+             iter != rMesh.GetElementIteratorEnd();
+             ++iter, ++position)
+        {
+            TS_ASSERT_EQUALS(r_cache.GetElementIndex(position), iter->GetIndex());
+
+            rMesh.GetInverseJacobianForElement(iter->GetIndex(), jacobian, jacobian_determinant, inverse_jacobian);
+            // As in AbstractFeVolumeIntegralAssembler, which also handles elements of lower dimension than the space
+            LinearBasisFunction<ELEMENT_DIM>::ComputeBasisFunctionDerivatives(centroid, reference_grad_phi);
+            grad_phi = prod(trans(inverse_jacobian), reference_grad_phi);
+
+            TS_ASSERT_DELTA(r_cache.GetJacobianDeterminant(position), jacobian_determinant, 1e-12);
+            r_cache.GetInverseJacobian(position, cached_inverse_jacobian);
+            r_cache.GetLinearBasisGradients(position, cached_grad_phi);
+            for (unsigned i=0; i<SPACE_DIM; i++)
+            {
+                for (unsigned j=0; j<ELEMENT_DIM; j++)
+                {
+                    TS_ASSERT_DELTA(cached_inverse_jacobian(j,i), inverse_jacobian(j,i), 1e-12);
+                }
+                for (unsigned j=0; j<ELEMENT_DIM+1; j++)
+                {
+                    TS_ASSERT_DELTA(cached_grad_phi(i,j), grad_phi(i,j), 1e-12);
+                }
+            }
+
+            // Records are aligned for vectorised loads
+            TS_ASSERT_EQUALS(reinterpret_cast<std::size_t>(r_cache.GetRecord(position)) % (4*sizeof(double)), 0u);
+        }
+        TS_ASSERT_EQUALS(position, r_cache.GetNumElements());
+    }
+
+    /**
+     * Compare the cached data for every element of a mesh with those computed from its
+     * nodes, for use when the mesh's own Jacobians have not been refreshed.
+     */
+    template<unsigned DIM>
+    void CheckCacheAgainstNodes(AbstractTetrahedralMesh<DIM, DIM>& rMesh)
+    {
+        const ElementGeometryCache<DIM, DIM>& r_cache = rMesh.rGetElementGeometryCache();
+        TS_ASSERT_EQUALS(r_cache.GetNumElements(), rMesh.GetNumElements());
+
+        c_matrix<double, DIM, DIM> jacobian;
+        c_matrix<double, DIM, DIM> inverse_jacobian;
+        double jacobian_determinant;
+        c_matrix<double, DIM, DIM> cached_inverse_jacobian;
+
+        unsigned position = 0;
+        for (typename AbstractTetrahedralMesh<DIM, DIM>::ElementIterator iter = rMesh.GetElementIteratorBegin();
+             iter != rMesh.GetElementIteratorEnd();
+             ++iter, ++position)
+        {
+            iter->CalculateInverseJacobian(jacobian, jacobian_determinant, inverse_jacobian);
+            TS_ASSERT_DELTA(r_cache.GetJacobianDeterminant(position), jacobian_determinant, 1e-12);
+            r_cache.GetInverseJacobian(position, cached_inverse_jacobian);
+            for (unsigned i=0; i<DIM; i++)
+            {
+                for (unsigned j=0; j<DIM; j++)
+                {
+                    TS_ASSERT_DELTA(cached_inverse_jacobian(i,j), inverse_jacobian(i,j), 1e-12);
+                }
+            }
+        }
+    }
+
+public:
+
+    void TestCacheRecords()
+    {
+        ElementGeometryCache<2,2> cache(3);
+        TS_ASSERT_EQUALS(cache.GetNumElements(), 3u);
+        // 1 + 4 + 6 = 11 doubles, padded to 12
+        TS_ASSERT_EQUALS(cache.GetRecordSize(), 12u);
+        TS_ASSERT_LESS_THAN_EQUALS(3u*12u*sizeof(double), cache.GetMemoryUsage());
+
+        // The unit right-angled triangle scaled by 2 in x
+        c_matrix<double, 2, 2> inverse_jacobian = zero_matrix<double>(2,2);
+        inverse_jacobian(0,0) = 0.5;
+        inverse_jacobian(1,1) = 1.0;
+        cache.SetElementData(1, 7, 2.0, inverse_jacobian);
+
+        TS_ASSERT_EQUALS(cache.GetElementIndex(1), 7u);
+        TS_ASSERT_DELTA(cache.GetJacobianDeterminant(1), 2.0, 1e-12);
+
+        c_matrix<double, 2, 3> grad_phi;
+        cache.GetLinearBasisGradients(1, grad_phi);
+        TS_ASSERT_DELTA(grad_phi(0,0), -0.5, 1e-12);
+        TS_ASSERT_DELTA(grad_phi(1,0), -1.0, 1e-12);
+        TS_ASSERT_DELTA(grad_phi(0,1), 0.5, 1e-12);
+        TS_ASSERT_DELTA(grad_phi(1,1), 0.0, 1e-12);
+        TS_ASSERT_DELTA(grad_phi(0,2), 0.0, 1e-12);
+        TS_ASSERT_DELTA(grad_phi(1,2), 1.0, 1e-12);
+    }
+
+    void TestCacheOnMeshes()
+    {
+        TetrahedralMesh<1,1> mesh_1d;
+        mesh_1d.ConstructRegularSlabMesh(0.1, 1.0);
+        CheckCacheAgainstMesh(mesh_1d);
+
+        TetrahedralMesh<2,2> mesh_2d;
+        mesh_2d.ConstructRegularSlabMesh(0.25, 1.0, 0.5);
+        CheckCacheAgainstMesh(mesh_2d);
+
+        TetrahedralMesh<3,3> mesh_3d;
+        mesh_3d.ConstructRegularSlabMesh(0.5, 1.0, 1.0, 1.0);
+        CheckCacheAgainstMesh(mesh_3d);
+
+        TrianglesMeshReader<2,3> surface_reader("mesh/test/data/disk_in_3d");
+        TetrahedralMesh<2,3> surface_mesh;
+        surface_mesh.ConstructFromMeshReader(surface_reader);
+        CheckCacheAgainstMesh(surface_mesh);
+    }
+
+    void TestCacheIsDiscardedWhenMeshMoves()
+    {
+        TetrahedralMesh<2,2> mesh;
+        mesh.ConstructRegularSlabMesh(0.25, 1.0, 1.0);
+        TS_ASSERT_EQUALS(mesh.GetElementGeometryCacheMemoryUsage(), 0u);
+
+        double old_determinant = mesh.rGetElementGeometryCache().GetJacobianDeterminant(0);
+        TS_ASSERT_LESS_THAN(0u, mesh.GetElementGeometryCacheMemoryUsage());
+
+        // Scale() calls RefreshMesh(), which discards the cache
+        mesh.Scale(2.0, 3.0);
+        TS_ASSERT_EQUALS(mesh.GetElementGeometryCacheMemoryUsage(), 0u);
+        TS_ASSERT_DELTA(mesh.rGetElementGeometryCache().GetJacobianDeterminant(0), 6.0*old_determinant, 1e-12);
+        CheckCacheAgainstMesh(mesh);
+
+        mesh.ClearElementGeometryCache();
+        TS_ASSERT_EQUALS(mesh.GetElementGeometryCacheMemoryUsage(), 0u);
+    }
+
+    void TestCacheWhenMutableMeshNodesMove()
+    {
+        MutableMesh<2,2> mesh;
+        mesh.ConstructRegularSlabMesh(0.25, 1.0, 1.0);
+        mesh.rGetElementGeometryCache();
+
+        // Moves which aren't concrete (as made by cell-based simulations, possibly from several
+        // threads) leave the mesh's own Jacobians stale, but the cache is rebuilt from the nodes
+        ChastePoint<2> new_point(0.26, 0.24);
+        mesh.SetNode(6, new_point, false);
+        CheckCacheAgainstNodes(mesh);
+
+        // So are moves made through the node locations
+        mesh.GetNode(7)->rGetModifiableLocation()[1] = 0.26;
+        CheckCacheAgainstNodes(mesh);
+
+        mesh.RefreshMesh();
+        TS_ASSERT_EQUALS(mesh.GetElementGeometryCacheMemoryUsage(), 0u);
+        CheckCacheAgainstMesh(mesh);
+
+        // Concrete moves update the Jacobians too
+        new_point.SetCoordinate(0, 0.25);
+        mesh.SetNode(6, new_point);
+        CheckCacheAgainstMesh(mesh);
+        CheckCacheAgainstNodes(mesh);
+    }
+};
+
+#endif /*TESTELEMENTGEOMETRYCACHE_HPP_*/
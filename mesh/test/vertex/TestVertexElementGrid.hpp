@@ -0,0 +1,140 @@
+/*
+
+Copyright (c) 2005-2017, University of Oxford.
+All rights reserved.
+
+University of Oxford means the Chancellor, Masters and Scholars of the
+University of Oxford, having an administrative office at Wellington
+Square, Oxford OX1 2JD, UK.
+
+This file is part of Chaste.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+ * Redistributions of source code must retain the above copyright notice,
+   this list of conditions and the following disclaimer.
+ * Redistributions in binary form must reproduce the above copyright notice,
+   this list of conditions and the following disclaimer in the documentation
+   and/or other materials provided with the distribution.
+ * Neither the name of the University of Oxford nor the names of its
+   contributors may be used to endorse or promote products derived from this
+   software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+*/
+
+
+#ifndef TESTVERTEXELEMENTGRID_HPP_
+#define TESTVERTEXELEMENTGRID_HPP_
+
+#include <cxxtest/TestSuite.h>
+
+#include <algorithm>
+
+#include "VertexElementGrid.hpp"
+#include "HoneycombVertexMeshGenerator.hpp"
+#include "CylindricalHoneycombVertexMeshGenerator.hpp"
+#include "Cylindrical2dVertexMesh.hpp"
+
+//This test is always run sequentially (never in parallel)
+#include "FakePetscSetup.hpp"
+
+class TestVertexElementGrid : public CxxTest::TestSuite
+{
+private:
+
+    /**
+     * Check that the candidates for each node include every element containing it,
+     * and that the candidates for each element centroid include that element.
+     */
+    void CheckCandidates(VertexMesh<2,2>& rMesh, VertexElementGrid<2,2>& rGrid)
+    {
+        std::vector<unsigned> candidates;
+        for (unsigned node_index=0; node_index<rMesh.GetNumNodes(); node_index++)
+        {
+            rGrid.GetCandidateElements(rMesh.GetNode(node_index)->rGetLocation(), candidates);
+            for (unsigned i=1; i<candidates.size(); i++)
+            {
+                TS_ASSERT_LESS_THAN(candidates[i-1], candidates[i]);
+            }
+            std::set<unsigned> containing_elements = rMesh.GetNode(node_index)->rGetContainingElementIndices();
+            for (std::set<unsigned>::iterator iter = containing_elements.begin(); iter != containing_elements.end(); ++iter)
+            {
+                TS_ASSERT(std::binary_search(candidates.begin(), candidates.end(), *iter));
+            }
+        }
+        for (unsigned elem_index=0; elem_index<rMesh.GetNumElements(); elem_index++)
+        {
+            c_vector<double, 2> centroid = rMesh.GetCentroidOfElement(elem_index);
+            rGrid.GetCandidateElements(centroid, candidates);
+            TS_ASSERT(std::binary_search(candidates.begin(), candidates.end(), elem_index));
+        }
+    }
+
+public:
+
+    void TestCandidateElements()
+    {
+        HoneycombVertexMeshGenerator generator(10, 10);
+        MutableVertexMesh<2,2>* p_mesh = generator.GetMesh();
+
+        VertexElementGrid<2,2> grid(*p_mesh);
+        CheckCandidates(*p_mesh, grid);
+
+        // Each point only has a few candidates
+        std::vector<unsigned> candidates;
+        grid.GetCandidateElements(p_mesh->GetCentroidOfElement(45), candidates);
+        TS_ASSERT_LESS_THAN(candidates.size(), 10u);
+
+        // Points outside the mesh have no candidates
+        c_vector<double, 2> far_point;
+        far_point[0] = -100.0;
+        far_point[1] = -100.0;
+        grid.GetCandidateElements(far_point, candidates);
+        TS_ASSERT(candidates.empty());
+
+        // Move a node and update the elements containing it
+        c_vector<double, 2> new_location = p_mesh->GetNode(20)->rGetLocation();
+        new_location[0] += 0.3;
+        p_mesh->GetNode(20)->rGetModifiableLocation() = new_location;
+        std::set<unsigned> containing_elements = p_mesh->GetNode(20)->rGetContainingElementIndices();
+        for (std::set<unsigned>::iterator iter = containing_elements.begin(); iter != containing_elements.end(); ++iter)
+        {
+            grid.UpdateElement(*iter);
+        }
+        CheckCandidates(*p_mesh, grid);
+
+        // Moving an element off the grid makes it a candidate for every point
+        VertexElement<2,2>* p_element = p_mesh->GetElement(0);
+        for (unsigned local_index=0; local_index<p_element->GetNumNodes(); local_index++)
+        {
+            p_element->GetNode(local_index)->rGetModifiableLocation()[0] -= 50.0;
+        }
+        grid.UpdateElement(0);
+        grid.GetCandidateElements(far_point, candidates);
+        TS_ASSERT_EQUALS(candidates.size(), 1u);
+        TS_ASSERT_EQUALS(candidates[0], 0u);
+    }
+
+    void TestCandidateElementsOnCylinder()
+    {
+        CylindricalHoneycombVertexMeshGenerator generator(6, 6);
+        Cylindrical2dVertexMesh* p_mesh = generator.GetCylindricalMesh();
+
+        // Elements that wrap around the periodic boundary are still found
+        VertexElementGrid<2,2> grid(*p_mesh);
+        CheckCandidates(*p_mesh, grid);
+    }
+};
+
+#endif /*TESTVERTEXELEMENTGRID_HPP_*/
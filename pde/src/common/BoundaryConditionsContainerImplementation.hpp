@@ -456,6 +456,10 @@ void BoundaryConditionsContainer<ELEMENT_DIM,SPACE_DIM,PROBLEM_DIM>::ApplyPeriod
 
         rLinearSystem.ZeroMatrixRowsWithValueOnDiagonal(rows_to_zero, 1.0);
 
+        // The paired nodes need not share an element, so their entries may lie outside the
+        // preallocated sparsity pattern
+        PetscMatTools::TurnOffVariableAllocationError(rLinearSystem.rGetLhsMatrix());
+
         for (unsigned index_of_unknown=0; index_of_unknown<PROBLEM_DIM; index_of_unknown++)
         {
             for (typename std::map< const Node<SPACE_DIM> *, const Node<SPACE_DIM> * >::const_iterator iter = mpPeriodicBcMap[index_of_unknown]->begin();
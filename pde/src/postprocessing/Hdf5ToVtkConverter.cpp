@@ -50,7 +50,8 @@ Hdf5ToVtkConverter<ELEMENT_DIM, SPACE_DIM>::Hdf5ToVtkConverter(const FileFinder&
                                                                const std::string& rFileBaseName,
                                                                AbstractTetrahedralMesh<ELEMENT_DIM, SPACE_DIM>* pMesh,
                                                                bool parallelVtk,
-                                                               bool usingOriginalNodeOrdering)
+                                                               bool usingOriginalNodeOrdering,
+                                                               bool oneFilePerTimeStep)
     : AbstractHdf5Converter<ELEMENT_DIM,SPACE_DIM>(rInputDirectory, rFileBaseName, pMesh, "vtk_output",0u)
 {
 #ifdef CHASTE_VTK // Requires "sudo aptitude install libvtk5-dev" or similar
@@ -59,8 +60,6 @@ Hdf5ToVtkConverter<ELEMENT_DIM, SPACE_DIM>::Hdf5ToVtkConverter(const FileFinder&
     FileFinder test_output("", RelativeTo::ChasteTestOutput);
     std::string output_directory = rInputDirectory.GetRelativePath(test_output) + "/" + this->mRelativeSubdirectory;
 
-    VtkMeshWriter<ELEMENT_DIM,SPACE_DIM> vtk_writer(output_directory, rFileBaseName, false);
-
     DistributedVectorFactory* p_factory = pMesh->GetDistributedVectorFactory();
 
     // Make sure that we are never trying to write from an incomplete data HDF5 file
@@ -68,7 +67,6 @@ Hdf5ToVtkConverter<ELEMENT_DIM, SPACE_DIM>::Hdf5ToVtkConverter(const FileFinder&
 
     DistributedTetrahedralMesh<ELEMENT_DIM,SPACE_DIM>* p_distributed_mesh = dynamic_cast<DistributedTetrahedralMesh<ELEMENT_DIM,SPACE_DIM>*>(pMesh);
 
-    unsigned num_nodes = pMesh->GetNumNodes();
     if (parallelVtk)
     {
         // If it's not a distributed mesh, then we might want to give a warning and back-off
@@ -84,13 +82,22 @@ Hdf5ToVtkConverter<ELEMENT_DIM, SPACE_DIM>::Hdf5ToVtkConverter(const FileFinder&
             WARNING("Can't write parallel VTK (pvtu) files with original ordering - writing sequential VTK instead");
             parallelVtk = false;
         }
+    }
 
-        // Are we now committed to writing .pvtu?
-        if (parallelVtk)
-        {
-           vtk_writer.SetParallelFiles(*pMesh);
-           num_nodes = p_distributed_mesh->GetNumLocalNodes();
-        }
+    // Each time step gets its own writer, so there is no need to set one up here
+    if (oneFilePerTimeStep)
+    {
+        WriteOneFilePerTimeStep(output_directory, parallelVtk, usingOriginalNodeOrdering);
+        return;
+    }
+
+    VtkMeshWriter<ELEMENT_DIM,SPACE_DIM> vtk_writer(output_directory, rFileBaseName, false);
+
+    unsigned num_nodes = pMesh->GetNumNodes();
+    if (parallelVtk)
+    {
+        vtk_writer.SetParallelFiles(*pMesh);
+        num_nodes = p_distributed_mesh->GetNumLocalNodes();
     }
 
     Vec data = p_factory->CreateVec();
@@ -166,6 +173,138 @@ Hdf5ToVtkConverter<ELEMENT_DIM, SPACE_DIM>::Hdf5ToVtkConverter(const FileFinder&
 #endif //CHASTE_VTK
 }
 
+template <unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+void Hdf5ToVtkConverter<ELEMENT_DIM, SPACE_DIM>::WriteOneFilePerTimeStep(const std::string& rOutputDirectory,
+                                                                         bool parallelVtk,
+                                                                         bool usingOriginalNodeOrdering)
+{
+#ifdef CHASTE_VTK
+    DistributedVectorFactory* p_factory = this->mpMesh->GetDistributedVectorFactory();
+    Vec data = p_factory->CreateVec();
+    unsigned num_local_nodes = p_factory->GetLocalOwnership();
+
+    // Sequential VTK files are written by the master process alone, so only it needs the data
+    VecScatter to_master = NULL;
+    Vec concentrated_data = NULL;
+    if (!parallelVtk)
+    {
+        VecScatterCreateToZero(data, &to_master, &concentrated_data);
+    }
+
+    // The mesh is only read from file once, and rewound for each time step
+    std::auto_ptr<AbstractMeshReader<ELEMENT_DIM, SPACE_DIM> > p_original_mesh_reader;
+    if (usingOriginalNodeOrdering)
+    {
+        // Note that the next line will throw if the mesh has not been read from file
+        std::string original_file = this->mpMesh->GetMeshFileBaseName();
+        p_original_mesh_reader = GenericMeshReader<ELEMENT_DIM, SPACE_DIM>(original_file);
+    }
+
+    // Sequentially, VtkMeshWriter writes a plain .vtu file even when asked for parallel files
+    std::string extension = (parallelVtk && PetscTools::IsParallel()) ? ".pvtu" : ".vtu";
+
+    do // Loop over datasets via MoveOntoNextDataset method in the abstract class
+    {
+        // Make sure that we are never trying to write from an incomplete HDF5 dataset.
+        assert(this->mpReader->GetNumberOfRows() == this->mpMesh->GetNumNodes());
+
+        // Follow the naming used for the times.info files (see WriteInfoFile)
+        std::string dataset_name = this->mDatasetNames[this->mOpenDatasetIndex];
+        std::string base_name = (dataset_name == "Data") ? this->mFileBaseName : dataset_name;
+
+        std::vector<double> time_values = this->mpReader->GetUnlimitedDimensionValues();
+        std::vector<std::string> file_names;
+
+        for (unsigned time_step=0; time_step<time_values.size(); time_step++)
+        {
+            std::ostringstream time_step_base_name;
+            time_step_base_name << base_name << "_" << std::setw(6) << std::setfill('0') << time_step;
+            file_names.push_back(time_step_base_name.str() + extension);
+
+            VtkMeshWriter<ELEMENT_DIM,SPACE_DIM> vtk_writer(rOutputDirectory, time_step_base_name.str(), false);
+            if (parallelVtk)
+            {
+                vtk_writer.SetParallelFiles(*(this->mpMesh));
+            }
+
+            for (unsigned variable=0; variable<this->mNumVariables; variable++)
+            {
+                std::string variable_name = this->mpReader->GetVariableNames()[variable];
+
+                // Each process reads its own part of this time step
+                this->mpReader->GetVariableOverNodes(data, variable_name, time_step);
+
+                std::vector<double> data_for_vtk;
+                if (parallelVtk)
+                {
+                    double* p_data;
+                    VecGetArray(data, &p_data);
+                    data_for_vtk.assign(p_data, p_data + num_local_nodes);
+                    VecRestoreArray(data, &p_data);
+                }
+                else
+                {
+//PETSc-3.x.x or PETSc-2.3.3
+#if ((PETSC_VERSION_MAJOR == 3) || (PETSC_VERSION_MAJOR == 2 && PETSC_VERSION_MINOR == 3 && PETSC_VERSION_SUBMINOR == 3)) //2.3.3 or 3.x.x
+                    VecScatterBegin(to_master, data, concentrated_data, INSERT_VALUES, SCATTER_FORWARD);
+                    VecScatterEnd(to_master, data, concentrated_data, INSERT_VALUES, SCATTER_FORWARD);
+#else
+                    VecScatterBegin(data, concentrated_data, INSERT_VALUES, SCATTER_FORWARD, to_master);
+                    VecScatterEnd(data, concentrated_data, INSERT_VALUES, SCATTER_FORWARD, to_master);
+#endif
+                    // The other processes add empty data, since they don't write the file
+                    if (PetscTools::AmMaster())
+                    {
+                        int size;
+                        VecGetLocalSize(concentrated_data, &size);
+                        double* p_data;
+                        VecGetArray(concentrated_data, &p_data);
+                        data_for_vtk.assign(p_data, p_data + size);
+                        VecRestoreArray(concentrated_data, &p_data);
+                    }
+                }
+                vtk_writer.AddPointData(variable_name, data_for_vtk);
+            }
+
+            if (!usingOriginalNodeOrdering)
+            {
+                vtk_writer.WriteFilesUsingMesh(*(this->mpMesh));
+            }
+            else
+            {
+                p_original_mesh_reader->Reset();
+                vtk_writer.WriteFilesUsingMeshReader(*p_original_mesh_reader);
+            }
+        }
+
+        // A collection file lets visualizers load the files as a time series
+        if (PetscTools::AmMaster())
+        {
+            out_stream p_pvd_file = this->mpOutputFileHandler->OpenOutputFile(base_name + ".pvd");
+            *p_pvd_file << "<?xml version=\"1.0\"?>\n";
+            *p_pvd_file << "<VTKFile type=\"Collection\" version=\"0.1\">\n";
+            *p_pvd_file << "  <Collection>\n";
+            *p_pvd_file << std::setprecision(12);
+            for (unsigned time_step=0; time_step<time_values.size(); time_step++)
+            {
+                *p_pvd_file << "    <DataSet timestep=\"" << time_values[time_step] << "\" file=\"" << file_names[time_step] << "\"/>\n";
+            }
+            *p_pvd_file << "  </Collection>\n";
+            *p_pvd_file << "</VTKFile>\n";
+            p_pvd_file->close();
+        }
+    }
+    while ( this->MoveOntoNextDataset() );
+
+    if (concentrated_data != NULL)
+    {
+        VecScatterDestroy(PETSC_DESTROY_PARAM(to_master));
+        PetscTools::Destroy(concentrated_data);
+    }
+    PetscTools::Destroy(data);
+#endif //CHASTE_VTK
+}
+
 // Explicit instantiation
 template class Hdf5ToVtkConverter<1,1>;
 template class Hdf5ToVtkConverter<1,2>;
@@ -40,11 +40,28 @@ OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 /**
  * This class converts from Hdf5 format to Vtk format.
- * The output will be one .vtu file with separate vtkPointData for each time step.
+ * The output will be one .vtu file with separate vtkPointData for each time step,
+ * or optionally one .vtu (or .pvtu) file per time step listed in a .pvd collection file.
  */
 template <unsigned ELEMENT_DIM, unsigned SPACE_DIM>
 class Hdf5ToVtkConverter : public AbstractHdf5Converter<ELEMENT_DIM, SPACE_DIM>
 {
+private:
+    /**
+     * Write each time step of each dataset to its own file, named [basename]_[time step]
+     * (or [dataset name]_[time step] for datasets other than "Data"), together with a
+     * [basename].pvd collection file giving the time of each.  Only one time step is held
+     * in memory at once and, when writing parallel files, each process only reads and
+     * writes the nodes it owns.
+     *
+     * @param rOutputDirectory  The output directory, relative to CHASTE_TEST_OUTPUT
+     * @param parallelVtk  Whether to write .pvtu files and fragment meshes
+     * @param usingOriginalNodeOrdering  Whether HDF5 output was written using the original node ordering
+     */
+    void WriteOneFilePerTimeStep(const std::string& rOutputDirectory,
+                                 bool parallelVtk,
+                                 bool usingOriginalNodeOrdering);
+
 public:
     /**
      * Constructor, which does the conversion and writes the .vtu file.
@@ -56,12 +73,15 @@ public:
      * @param pMesh Pointer to the mesh.
      * @param parallelVtk When true, write with .pvtu and fragment meshes (only works for DistributedTetrahedralMesh)
      * @param usingOriginalNodeOrdering Whether HDF5 output was written using the original node ordering
+     * @param oneFilePerTimeStep Whether to write a separate file for each time step (see WriteOneFilePerTimeStep),
+     *                           rather than holding every time step in memory to write one file (the default)
      */
     Hdf5ToVtkConverter(const FileFinder& rInputDirectory,
                        const std::string& rFileBaseName,
                        AbstractTetrahedralMesh<ELEMENT_DIM,SPACE_DIM>* pMesh,
                        bool parallelVtk,
-                       bool usingOriginalNodeOrdering);
+                       bool usingOriginalNodeOrdering,
+                       bool oneFilePerTimeStep=false);
 };
 
 #endif /*HDF5TOVTKCONVERTER_HPP_*/
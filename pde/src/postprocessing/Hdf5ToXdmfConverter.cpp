@@ -122,7 +122,9 @@ void Hdf5ToXdmfConverter<ELEMENT_DIM, SPACE_DIM>::AddDataOnNodes(XERCES_CPP_NAME
         DOMElement* p_hdf_element =  pDomDocument->createElement(X("DataItem"));
         p_hdf_element->setAttribute(X("Format"), X("HDF"));
         p_hdf_element->setAttribute(X("NumberType"), X("Float"));
-        p_hdf_element->setAttribute(X("Precision"), X("8"));
+        std::stringstream precision_stream;
+        precision_stream << this->mpReader->GetDataPrecision(); // Results may be stored as floats
+        p_hdf_element->setAttribute(X("Precision"), X(precision_stream.str()));
         std::stringstream hdf_dims_stream;
         /* hdf_dims_stream << num_timesteps << " " << p_factory->GetHigh()-p_factory->GetLow() << " " << this->mNumVariables; */
         hdf_dims_stream << num_timesteps << " " << num_nodes << " " << this->mNumVariables;
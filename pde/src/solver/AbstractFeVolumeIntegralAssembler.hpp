@@ -36,11 +36,16 @@ OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #ifndef ABSTRACTFEVOLUMEINTEGRALASSEMBLER_HPP_
 #define ABSTRACTFEVOLUMEINTEGRALASSEMBLER_HPP_
 
+#include <algorithm>
+#include <vector>
+#include <boost/shared_ptr.hpp>
+
 #include "AbstractFeAssemblerCommon.hpp"
 #include "GaussianQuadratureRule.hpp"
 #include "BoundaryConditionsContainer.hpp"
 #include "PetscVecTools.hpp"
 #include "PetscMatTools.hpp"
+#include "Exception.hpp"
 
 /**
  *
@@ -73,6 +78,12 @@ OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
  *
  * This class inherits from AbstractFeAssemblerCommon which is where some member variables
  * (the matrix/vector to be created, for example) are defined.
+ *
+ * If the concrete class can compute the contributions of different elements concurrently
+ * (see CanAssembleElementsConcurrently()), the element loop can be run on several threads
+ * (see SetNumberOfAssemblyThreads()).  Each thread computes the contributions of part of
+ * a block of elements into a buffer, and the buffer is then added to the matrix and
+ * vector in element order, so the result is the same as with one thread.
  */
 template <unsigned ELEMENT_DIM, unsigned SPACE_DIM, unsigned PROBLEM_DIM, bool CAN_ASSEMBLE_VECTOR, bool CAN_ASSEMBLE_MATRIX, InterpolationLevel INTERPOLATION_LEVEL>
 class AbstractFeVolumeIntegralAssembler :
@@ -88,6 +99,21 @@ protected:
     /** Basis function for use with normal elements. */
     typedef LinearBasisFunction<ELEMENT_DIM> BasisFunction;
 
+    /** Whether to take element geometry from the mesh's element geometry cache.  False by default. */
+    bool mUseElementGeometryCache;
+
+    /** The mesh's element geometry cache, while it is being used in DoAssemble(), otherwise NULL. */
+    const ElementGeometryCache<ELEMENT_DIM, SPACE_DIM>* mpElementGeometryCache;
+
+    /** The position (in element iterator order) of the element currently being assembled in DoAssemble(). */
+    unsigned mElementGeometryCachePosition;
+
+    /** The number of threads used to compute element contributions in DoAssemble().  1 by default. */
+    unsigned mNumAssemblyThreads;
+
+    /** The number of elements per thread in each block of elements assembled concurrently. */
+    static const unsigned ELEMENTS_PER_THREAD_BLOCK = 256u;
+
     /**
      * Compute the derivatives of all basis functions at a point within an element.
      * This method will transform the results, for use within Gaussian quadrature
@@ -118,6 +144,26 @@ protected:
      */
     void DoAssemble();
 
+    /**
+     * The element loop of DoAssemble() when assembling with more than one thread.
+     */
+    void DoAssembleWithThreads();
+
+    /**
+     * Calculate the contribution of a single element to the linear system (see AssembleOnElement()).
+     * This uses no member variables that change during assembly, so may be called concurrently
+     * for different elements if CanAssembleElementsConcurrently() is true.
+     *
+     * @param rElement The element to assemble on.
+     * @param cachePosition The position of the element in the element geometry cache, if it is in use.
+     * @param rAElem The element's contribution to the LHS matrix.
+     * @param rBElem The element's contribution to the RHS vector.
+     */
+    void AssembleOnElementAtPosition(Element<ELEMENT_DIM,SPACE_DIM>& rElement,
+                                     unsigned cachePosition,
+                                     c_matrix<double, PROBLEM_DIM*(ELEMENT_DIM+1), PROBLEM_DIM*(ELEMENT_DIM+1) >& rAElem,
+                                     c_vector<double, PROBLEM_DIM*(ELEMENT_DIM+1)>& rBElem);
+
 protected:
 
     /**
@@ -221,6 +267,18 @@ protected:
         return true;
     }
 
+    /**
+     * @return true if the contributions of different elements may be computed concurrently,
+     * i.e. if ComputeMatrixTerm(), ComputeVectorTerm(), GetCurrentSolutionOrGuessValue() and
+     * the interpolation methods of the concrete class only read member variables, and
+     * AssembleOnElement() is not overridden.  Returns false here, so concrete classes must
+     * override this to allow assembly with more than one thread.
+     */
+    virtual bool CanAssembleElementsConcurrently()
+    {
+        return false;
+    }
+
 
 public:
 
@@ -231,6 +289,54 @@ public:
      */
     AbstractFeVolumeIntegralAssembler(AbstractTetrahedralMesh<ELEMENT_DIM,SPACE_DIM>* pMesh);
 
+    /**
+     * Set whether to use the mesh's element geometry cache (see
+     * AbstractTetrahedralMesh::rGetElementGeometryCache()) for the Jacobian
+     * determinants and basis function gradients, instead of computing them for
+     * each element on every assembly.  This uses more memory, and the cache is
+     * rebuilt whenever the mesh is refreshed.
+     *
+     * @param useCache  whether to use the cache
+     */
+    void SetUseElementGeometryCache(bool useCache=true)
+    {
+        mUseElementGeometryCache = useCache;
+    }
+
+    /**
+     * @return whether the mesh's element geometry cache is used
+     */
+    bool GetUseElementGeometryCache() const
+    {
+        return mUseElementGeometryCache;
+    }
+
+    /**
+     * Set the number of threads used to compute the element contributions on each process.
+     * This only has an effect if the concrete class allows it (see CanAssembleElementsConcurrently()),
+     * otherwise elements are assembled one at a time.  Threads are only used if Chaste is built
+     * with OpenMP (Chaste_USE_OPENMP); otherwise elements are assembled one at a time whatever
+     * this is set to.
+     *
+     * @param numThreads  the number of threads
+     */
+    void SetNumberOfAssemblyThreads(unsigned numThreads)
+    {
+        if (numThreads == 0u)
+        {
+            EXCEPTION("The number of assembly threads must be at least 1.");
+        }
+        mNumAssemblyThreads = numThreads;
+    }
+
+    /**
+     * @return the number of threads used to compute the element contributions on each process
+     */
+    unsigned GetNumberOfAssemblyThreads() const
+    {
+        return mNumAssemblyThreads;
+    }
+
     /**
      * Destructor.
      */
@@ -244,7 +350,11 @@ template <unsigned ELEMENT_DIM, unsigned SPACE_DIM, unsigned PROBLEM_DIM, bool C
 AbstractFeVolumeIntegralAssembler<ELEMENT_DIM, SPACE_DIM, PROBLEM_DIM, CAN_ASSEMBLE_VECTOR, CAN_ASSEMBLE_MATRIX, INTERPOLATION_LEVEL>::AbstractFeVolumeIntegralAssembler(
             AbstractTetrahedralMesh<ELEMENT_DIM,SPACE_DIM>* pMesh)
     : AbstractFeAssemblerCommon<ELEMENT_DIM, SPACE_DIM, PROBLEM_DIM, CAN_ASSEMBLE_VECTOR, CAN_ASSEMBLE_MATRIX, INTERPOLATION_LEVEL>(),
-      mpMesh(pMesh)
+      mpMesh(pMesh),
+      mUseElementGeometryCache(false),
+      mpElementGeometryCache(NULL),
+      mElementGeometryCachePosition(0),
+      mNumAssemblyThreads(1u)
 {
     assert(pMesh);
     // Default to 2nd order quadrature.  Our default basis functions are piecewise linear
@@ -293,10 +403,25 @@ void AbstractFeVolumeIntegralAssembler<ELEMENT_DIM, SPACE_DIM, PROBLEM_DIM, CAN_
     c_matrix<double, STENCIL_SIZE, STENCIL_SIZE> a_elem;
     c_vector<double, STENCIL_SIZE> b_elem;
 
+    mpElementGeometryCache = NULL;
+    if (mUseElementGeometryCache)
+    {
+        mpElementGeometryCache = &(mpMesh->rGetElementGeometryCache());
+    }
+    mElementGeometryCachePosition = 0;
+
+    if (mNumAssemblyThreads > 1u && CanAssembleElementsConcurrently())
+    {
+        DoAssembleWithThreads();
+        mpElementGeometryCache = NULL;
+        HeartEventHandler::EndEvent(assemble_event);
+        return;
+    }
+
     // Loop over elements
     for (typename AbstractTetrahedralMesh<ELEMENT_DIM, SPACE_DIM>::ElementIterator iter = mpMesh->GetElementIteratorBegin();
          iter != mpMesh->GetElementIteratorEnd();
-         ++iter)
+         ++iter, ++mElementGeometryCachePosition)
     {
         Element<ELEMENT_DIM, SPACE_DIM>& r_element = *iter;
 
@@ -319,11 +444,83 @@ void AbstractFeVolumeIntegralAssembler<ELEMENT_DIM, SPACE_DIM, PROBLEM_DIM, CAN_
             }
         }
     }
+    mpElementGeometryCache = NULL;
 
     HeartEventHandler::EndEvent(assemble_event);
 }
 
 
+template <unsigned ELEMENT_DIM, unsigned SPACE_DIM, unsigned PROBLEM_DIM, bool CAN_ASSEMBLE_VECTOR, bool CAN_ASSEMBLE_MATRIX, InterpolationLevel INTERPOLATION_LEVEL>
+void AbstractFeVolumeIntegralAssembler<ELEMENT_DIM, SPACE_DIM, PROBLEM_DIM, CAN_ASSEMBLE_VECTOR, CAN_ASSEMBLE_MATRIX, INTERPOLATION_LEVEL>::DoAssembleWithThreads()
+{
+    const size_t STENCIL_SIZE=PROBLEM_DIM*(ELEMENT_DIM+1);
+
+    // Gather the elements to be assembled first, since the criterion need not be thread-safe
+    std::vector<Element<ELEMENT_DIM, SPACE_DIM>*> elements;
+    std::vector<unsigned> cache_positions;
+    unsigned position = 0;
+    for (typename AbstractTetrahedralMesh<ELEMENT_DIM, SPACE_DIM>::ElementIterator iter = mpMesh->GetElementIteratorBegin();
+         iter != mpMesh->GetElementIteratorEnd();
+         ++iter, ++position)
+    {
+        Element<ELEMENT_DIM, SPACE_DIM>& r_element = *iter;
+        if (r_element.GetOwnership() == true && ElementAssemblyCriterion(r_element)==true)
+        {
+            elements.push_back(&r_element);
+            cache_positions.push_back(position);
+        }
+    }
+
+    const unsigned num_elements = elements.size();
+    const unsigned block_size = std::min(ELEMENTS_PER_THREAD_BLOCK*mNumAssemblyThreads, num_elements);
+    std::vector<c_matrix<double, STENCIL_SIZE, STENCIL_SIZE> > a_elems(block_size);
+    std::vector<c_vector<double, STENCIL_SIZE> > b_elems(block_size);
+    std::vector<boost::shared_ptr<Exception> > element_exceptions(block_size);
+
+    for (unsigned block_start=0; block_start<num_elements; block_start+=block_size)
+    {
+        const unsigned num_in_block = std::min(block_size, num_elements-block_start);
+
+        // Exceptions can't propagate out of a parallel region, so they are captured per element
+#ifdef CHASTE_OPENMP
+#pragma omp parallel for schedule(static) num_threads(mNumAssemblyThreads)
+#endif // CHASTE_OPENMP
+        for (int i=0; i<(int)num_in_block; i++)
+        {
+            try
+            {
+                AssembleOnElementAtPosition(*elements[block_start+i], cache_positions[block_start+i], a_elems[i], b_elems[i]);
+            }
+            catch (Exception& e)
+            {
+                element_exceptions[i].reset(new Exception(e));
+            }
+        }
+
+        // Add the contributions in element order, as in the serial loop
+        for (unsigned i=0; i<num_in_block; i++)
+        {
+            if (element_exceptions[i])
+            {
+                throw *(element_exceptions[i]);
+            }
+
+            unsigned p_indices[STENCIL_SIZE];
+            elements[block_start+i]->GetStiffnessMatrixGlobalIndices(PROBLEM_DIM, p_indices);
+
+            if (this->mAssembleMatrix)
+            {
+                PetscMatTools::AddMultipleValues<STENCIL_SIZE>(this->mMatrixToAssemble, p_indices, a_elems[i]);
+            }
+
+            if (this->mAssembleVector)
+            {
+                PetscVecTools::AddMultipleValues<STENCIL_SIZE>(this->mVectorToAssemble, p_indices, b_elems[i]);
+            }
+        }
+    }
+}
+
 ///////////////////////////////////////////////////////////////////////////////////
 // Implementation - AssembleOnElement and smaller
 ///////////////////////////////////////////////////////////////////////////////////
@@ -335,7 +532,7 @@ void AbstractFeVolumeIntegralAssembler<ELEMENT_DIM, SPACE_DIM, PROBLEM_DIM, CAN_
         c_matrix<double, SPACE_DIM, ELEMENT_DIM+1>& rReturnValue)
 {
     assert(ELEMENT_DIM < 4 && ELEMENT_DIM > 0);
-    static c_matrix<double, ELEMENT_DIM, ELEMENT_DIM+1> grad_phi;
+    c_matrix<double, ELEMENT_DIM, ELEMENT_DIM+1> grad_phi;
 
     LinearBasisFunction<ELEMENT_DIM>::ComputeBasisFunctionDerivatives(rPoint, grad_phi);
     rReturnValue = prod(trans(rInverseJacobian), grad_phi);
@@ -346,6 +543,16 @@ void AbstractFeVolumeIntegralAssembler<ELEMENT_DIM, SPACE_DIM, PROBLEM_DIM, CAN_
     Element<ELEMENT_DIM,SPACE_DIM>& rElement,
     c_matrix<double, PROBLEM_DIM*(ELEMENT_DIM+1), PROBLEM_DIM*(ELEMENT_DIM+1) >& rAElem,
     c_vector<double, PROBLEM_DIM*(ELEMENT_DIM+1)>& rBElem)
+{
+    AssembleOnElementAtPosition(rElement, mElementGeometryCachePosition, rAElem, rBElem);
+}
+
+template <unsigned ELEMENT_DIM, unsigned SPACE_DIM, unsigned PROBLEM_DIM, bool CAN_ASSEMBLE_VECTOR, bool CAN_ASSEMBLE_MATRIX, InterpolationLevel INTERPOLATION_LEVEL>
+void AbstractFeVolumeIntegralAssembler<ELEMENT_DIM, SPACE_DIM, PROBLEM_DIM, CAN_ASSEMBLE_VECTOR, CAN_ASSEMBLE_MATRIX, INTERPOLATION_LEVEL>::AssembleOnElementAtPosition(
+    Element<ELEMENT_DIM,SPACE_DIM>& rElement,
+    unsigned cachePosition,
+    c_matrix<double, PROBLEM_DIM*(ELEMENT_DIM+1), PROBLEM_DIM*(ELEMENT_DIM+1) >& rAElem,
+    c_vector<double, PROBLEM_DIM*(ELEMENT_DIM+1)>& rBElem)
 {
     /**
      * \todo #1320 This assumes that the Jacobian is constant on an element.
@@ -356,7 +563,23 @@ void AbstractFeVolumeIntegralAssembler<ELEMENT_DIM, SPACE_DIM, PROBLEM_DIM, CAN_
     c_matrix<double, ELEMENT_DIM, SPACE_DIM> inverse_jacobian;
     double jacobian_determinant;
 
-    mpMesh->GetInverseJacobianForElement(rElement.GetIndex(), jacobian, jacobian_determinant, inverse_jacobian);
+    // Allocate memory for the basis functions values and derivative values
+    c_vector<double, ELEMENT_DIM+1> phi;
+    c_matrix<double, SPACE_DIM, ELEMENT_DIM+1> grad_phi;
+
+    // The gradients of linear basis functions are constant on the element, so if they
+    // have been precomputed they need not be transformed at each Gauss point
+    bool use_cache = (mpElementGeometryCache != NULL);
+    if (use_cache)
+    {
+        assert(mpElementGeometryCache->GetElementIndex(cachePosition) == rElement.GetIndex());
+        jacobian_determinant = mpElementGeometryCache->GetJacobianDeterminant(cachePosition);
+        mpElementGeometryCache->GetLinearBasisGradients(cachePosition, grad_phi);
+    }
+    else
+    {
+        mpMesh->GetInverseJacobianForElement(rElement.GetIndex(), jacobian, jacobian_determinant, inverse_jacobian);
+    }
 
     if (this->mAssembleMatrix)
     {
@@ -370,10 +593,6 @@ void AbstractFeVolumeIntegralAssembler<ELEMENT_DIM, SPACE_DIM, PROBLEM_DIM, CAN_
 
     const unsigned num_nodes = rElement.GetNumNodes();
 
-    // Allocate memory for the basis functions values and derivative values
-    c_vector<double, ELEMENT_DIM+1> phi;
-    c_matrix<double, SPACE_DIM, ELEMENT_DIM+1> grad_phi;
-
     // Loop over Gauss points
     for (unsigned quad_index=0; quad_index < mpQuadRule->GetNumQuadPoints(); quad_index++)
     {
@@ -381,7 +600,7 @@ void AbstractFeVolumeIntegralAssembler<ELEMENT_DIM, SPACE_DIM, PROBLEM_DIM, CAN_
 
         BasisFunction::ComputeBasisFunctions(quad_point, phi);
 
-        if (this->mAssembleMatrix || INTERPOLATION_LEVEL==NONLINEAR)
+        if (!use_cache && (this->mAssembleMatrix || INTERPOLATION_LEVEL==NONLINEAR))
         {
             ComputeTransformedBasisFunctionDerivatives(quad_point, inverse_jacobian, grad_phi);
         }
@@ -459,4 +678,7 @@ void AbstractFeVolumeIntegralAssembler<ELEMENT_DIM, SPACE_DIM, PROBLEM_DIM, CAN_
 }
 
 
+template <unsigned ELEMENT_DIM, unsigned SPACE_DIM, unsigned PROBLEM_DIM, bool CAN_ASSEMBLE_VECTOR, bool CAN_ASSEMBLE_MATRIX, InterpolationLevel INTERPOLATION_LEVEL>
+const unsigned AbstractFeVolumeIntegralAssembler<ELEMENT_DIM, SPACE_DIM, PROBLEM_DIM, CAN_ASSEMBLE_VECTOR, CAN_ASSEMBLE_MATRIX, INTERPOLATION_LEVEL>::ELEMENTS_PER_THREAD_BLOCK;
+
 #endif /*ABSTRACTFEVOLUMEINTEGRALASSEMBLER_HPP_*/
@@ -56,6 +56,17 @@ protected:
     /** Pointer to the mesh. */
     AbstractTetrahedralMesh<ELEMENT_DIM,SPACE_DIM>* mpMesh;
 
+    /**
+     * The number of nonzeros in the diagonal block of each local row of the linear system,
+     * calculated from the mesh connectivity in InitialiseForSolve().  Kept so that other
+     * matrices with the same sparsity pattern (such as mass matrices) can be preallocated
+     * without recalculating it.
+     */
+    std::vector<PetscInt> mDiagonalNonZeros;
+
+    /** The number of nonzeros in the off-diagonal block of each local row (see #mDiagonalNonZeros). */
+    std::vector<PetscInt> mOffDiagonalNonZeros;
+
 public:
 
     /**
@@ -82,8 +93,8 @@ public:
     }
 
     /**
-     * Initialise method: sets up the linear system (using the mesh to
-     * determine the number of unknowns per row to preallocate) if it
+     * Initialise method: sets up the linear system (using the mesh connectivity to
+     * determine the exact number of nonzeros in each row to preallocate) if it
      * is not already set up. Can use an initial solution as PETSc template,
      * or base it on the mesh size.
      *
@@ -153,7 +164,7 @@ void AbstractLinearPdeSolver<ELEMENT_DIM, SPACE_DIM, PROBLEM_DIM>::InitialiseFor
 {
     if (this->mpLinearSystem == NULL)
     {
-        unsigned preallocation= PROBLEM_DIM * mpMesh->CalculateMaximumNodeConnectivityPerProcess();
+        mpMesh->CalculateLocalRowNonZeroCounts(PROBLEM_DIM, mDiagonalNonZeros, mOffDiagonalNonZeros);
 
         HeartEventHandler::BeginEvent(HeartEventHandler::COMMUNICATION);
         if (initialSolution == NULL)
@@ -164,7 +175,7 @@ void AbstractLinearPdeSolver<ELEMENT_DIM, SPACE_DIM, PROBLEM_DIM>::InitialiseFor
              */
             Vec template_vec = mpMesh->GetDistributedVectorFactory()->CreateVec(PROBLEM_DIM);
 
-            this->mpLinearSystem = new LinearSystem(template_vec, preallocation);
+            this->mpLinearSystem = new LinearSystem(template_vec, mDiagonalNonZeros, mOffDiagonalNonZeros);
 
             PetscTools::Destroy(template_vec);
         }
@@ -175,7 +186,7 @@ void AbstractLinearPdeSolver<ELEMENT_DIM, SPACE_DIM, PROBLEM_DIM>::InitialiseFor
              * as the template in the alternative constructor of
              * LinearSystem. This is to avoid problems with VecScatter.
              */
-            this->mpLinearSystem = new LinearSystem(initialSolution, preallocation);
+            this->mpLinearSystem = new LinearSystem(initialSolution, mDiagonalNonZeros, mOffDiagonalNonZeros);
         }
 
         HeartEventHandler::EndEvent(HeartEventHandler::COMMUNICATION);
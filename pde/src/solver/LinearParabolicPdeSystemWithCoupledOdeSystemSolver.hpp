@@ -340,20 +340,14 @@ void LinearParabolicPdeSystemWithCoupledOdeSystemSolver<ELEMENT_DIM, SPACE_DIM,
 {
     if (this->mpLinearSystem == NULL)
     {
-        unsigned preallocation = mpMesh->CalculateMaximumContainingElementsPerProcess() + ELEMENT_DIM;
-        if (ELEMENT_DIM > 1)
-        {
-            // Highest connectivity is closed
-            preallocation--;
-        }
-        preallocation *= PROBLEM_DIM;
+        mpMesh->CalculateLocalRowNonZeroCounts(PROBLEM_DIM, this->mDiagonalNonZeros, this->mOffDiagonalNonZeros);
 
         /*
          * Use the current solution (ie the initial solution) as the
          * template in the alternative constructor of LinearSystem.
          * This is to avoid problems with VecScatter.
          */
-        this->mpLinearSystem = new LinearSystem(initialSolution, preallocation);
+        this->mpLinearSystem = new LinearSystem(initialSolution, this->mDiagonalNonZeros, this->mOffDiagonalNonZeros);
     }
 
     assert(this->mpLinearSystem);
@@ -59,6 +59,17 @@ private:
     /** Whether to use mass lumping or not. */
     bool mUseMassLumping;
 
+protected:
+
+    /**
+     * @return true, since ComputeMatrixTerm() only reads member variables, so elements
+     * may be assembled concurrently.
+     */
+    bool CanAssembleElementsConcurrently()
+    {
+        return true;
+    }
+
 public:
 
     /**
@@ -0,0 +1,349 @@
+/*
+
+Copyright (c) 2005-2017, University of Oxford.
+All rights reserved.
+
+University of Oxford means the Chancellor, Masters and Scholars of the
+University of Oxford, having an administrative office at Wellington
+Square, Oxford OX1 2JD, UK.
+
+This file is part of Chaste.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+ * Redistributions of source code must retain the above copyright notice,
+   this list of conditions and the following disclaimer.
+ * Redistributions in binary form must reproduce the above copyright notice,
+   this list of conditions and the following disclaimer in the documentation
+   and/or other materials provided with the distribution.
+ * Neither the name of the University of Oxford nor the names of its
+   contributors may be used to endorse or promote products derived from this
+   software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+*/
+
+#ifndef MATRIXFREEMASSMATRIXOPERATOR_HPP_
+#define MATRIXFREEMASSMATRIXOPERATOR_HPP_
+
+#include <algorithm>
+#include <cstddef>
+#include <vector>
+#include <boost/utility.hpp>
+#include <petscvec.h>
+
+#include "AbstractTetrahedralMesh.hpp"
+#include "PetscTools.hpp"
+#include "PetscVecTools.hpp"
+
+/**
+ * Computes the product b = M z of the linear finite element mass matrix M with a
+ * vector z, element by element, without assembling M.
+ *
+ * On a straight-sided linear simplex the element mass matrix is known exactly,
+ *   M_ij = |J| (1 + delta_ij) / (ELEMENT_DIM+2)!,
+ * (or |J| (ELEMENT_DIM+2) delta_ij / (ELEMENT_DIM+2)! if lumped), so each element
+ * only needs one weight, proportional to its Jacobian determinant.  This is the same
+ * matrix as MassMatrixAssembler assembles with the default (second order) quadrature
+ * rule.  The node indices and weights of the elements are stored in flat arrays, and the
+ * elements are processed in fixed-size batches so that the compiler can vectorise the
+ * element kernel.
+ *
+ * The entries of z used by the locally owned elements (the owned entries and a halo) are
+ * gathered into a local sequential vector by a VecScatter which is built in SetUp(), so
+ * Apply() never replicates the whole of z.
+ *
+ * For PROBLEM_DIM > 1 the mass matrix acts on one component of the unknown only, with
+ * zero rows and columns for the others (as in BidomainMassMatrixAssembler).
+ */
+template<unsigned ELEMENT_DIM, unsigned SPACE_DIM, unsigned PROBLEM_DIM=1>
+class MatrixFreeMassMatrixOperator : private boost::noncopyable
+{
+private:
+
+    /** Number of nodes in each element. */
+    static const unsigned NUM_NODES = ELEMENT_DIM+1;
+
+    /** Number of elements processed together by the element kernel. */
+    static const unsigned BATCH_SIZE = 64;
+
+    /** The component of the unknown on which the mass matrix acts. */
+    unsigned mComponent;
+
+    /** Whether the operator has been set up since construction or the last mesh change. */
+    bool mIsSetUp;
+
+    /**
+     * Positions in mGatheredZ of the unknowns at the nodes of the elements, NUM_NODES
+     * per element.
+     */
+    std::vector<unsigned> mElementLocalIndices;
+
+    /** |J| * scale factor / (ELEMENT_DIM+2)! for each element. */
+    std::vector<double> mElementWeights;
+
+    /** Global indices in z of the entries of mGatheredZ, in increasing order. */
+    std::vector<PetscInt> mGatheredIndices;
+
+    /** Local copy of the entries of z used by the locally owned elements (valid if mIsSetUp). */
+    Vec mGatheredZ;
+
+    /** Scatter from z to mGatheredZ (valid if mIsSetUp). */
+    VecScatter mGatherScatter;
+
+    /**
+     * Free the gathered vector and the scatter, if they have been created.
+     */
+    void DestroyScatter()
+    {
+        if (mIsSetUp)
+        {
+            VecScatterDestroy(PETSC_DESTROY_PARAM(mGatherScatter));
+            PetscTools::Destroy(mGatheredZ);
+            mIsSetUp = false;
+        }
+    }
+
+protected:
+
+    /** Mesh to be solved on. */
+    AbstractTetrahedralMesh<ELEMENT_DIM, SPACE_DIM>* mpMesh;
+
+    /** Whether to lump the mass matrix. */
+    bool mUseMassLumping;
+
+    /** The factor with which to multiply the mass matrix. */
+    double mScaleFactor;
+
+    /**
+     * @return true if the mass matrix of the given element should be included (the
+     * analogue of AbstractFeVolumeIntegralAssembler::ElementAssemblyCriterion()).
+     * By default all elements are included.
+     *
+     * @param rElement the element
+     */
+    virtual bool ElementAssemblyCriterion(Element<ELEMENT_DIM, SPACE_DIM>& rElement)
+    {
+        return true;
+    }
+
+public:
+
+    /**
+     * Constructor.
+     *
+     * @param pMesh the mesh
+     * @param useMassLumping whether to use mass matrix lumping or not
+     * @param scaleFactor the factor with which to multiply the mass matrix. Defaults to 1.0
+     * @param component the component of the unknown on which the mass matrix acts. Defaults to 0
+     */
+    MatrixFreeMassMatrixOperator(AbstractTetrahedralMesh<ELEMENT_DIM, SPACE_DIM>* pMesh,
+                                 bool useMassLumping=false,
+                                 double scaleFactor=1.0,
+                                 unsigned component=0)
+        : mComponent(component),
+          mIsSetUp(false),
+          mpMesh(pMesh),
+          mUseMassLumping(useMassLumping),
+          mScaleFactor(scaleFactor)
+    {
+        assert(pMesh);
+        assert(component < PROBLEM_DIM);
+    }
+
+    /**
+     * Destructor.
+     */
+    virtual ~MatrixFreeMassMatrixOperator()
+    {
+        DestroyScatter();
+    }
+
+    /**
+     * Gather the node indices and weights of the locally owned elements, and build the
+     * scatter which fetches the entries of z they use.  This is done automatically by the
+     * first call to Apply(), and must be repeated if the mesh changes.  It is collective.
+     */
+    void SetUp()
+    {
+        DestroyScatter();
+
+        double factorial = 1.0;
+        for (unsigned k=2; k<=ELEMENT_DIM+2; k++)
+        {
+            factorial *= k;
+        }
+
+        c_matrix<double, SPACE_DIM, ELEMENT_DIM> jacobian;
+        c_matrix<double, ELEMENT_DIM, SPACE_DIM> inverse_jacobian;
+        double jacobian_determinant;
+
+        std::vector<PetscInt> element_indices;
+        mElementWeights.clear();
+        for (typename AbstractTetrahedralMesh<ELEMENT_DIM, SPACE_DIM>::ElementIterator iter = mpMesh->GetElementIteratorBegin();
+             iter != mpMesh->GetElementIteratorEnd();
+             ++iter)
+        {
+            Element<ELEMENT_DIM, SPACE_DIM>& r_element = *iter;
+            if (r_element.GetOwnership() == true && ElementAssemblyCriterion(r_element)==true)
+            {
+                for (unsigned i=0; i<NUM_NODES; i++)
+                {
+                    element_indices.push_back(PROBLEM_DIM*r_element.GetNodeGlobalIndex(i) + mComponent);
+                }
+                mpMesh->GetInverseJacobianForElement(r_element.GetIndex(), jacobian, jacobian_determinant, inverse_jacobian);
+                mElementWeights.push_back(mScaleFactor*jacobian_determinant/factorial);
+            }
+        }
+
+        // The distinct entries of z used by these elements, and where each element finds them
+        mGatheredIndices = element_indices;
+        std::sort(mGatheredIndices.begin(), mGatheredIndices.end());
+        mGatheredIndices.erase(std::unique(mGatheredIndices.begin(), mGatheredIndices.end()), mGatheredIndices.end());
+        mElementLocalIndices.resize(element_indices.size());
+        for (unsigned k=0; k<element_indices.size(); k++)
+        {
+            mElementLocalIndices[k] = std::lower_bound(mGatheredIndices.begin(), mGatheredIndices.end(), element_indices[k])
+                                      - mGatheredIndices.begin();
+        }
+
+        // Scatter from the (parallel) layout of z to a sequential vector of these entries
+        const PetscInt num_gathered = mGatheredIndices.size();
+        PetscInt* p_gathered_indices = mGatheredIndices.empty() ? NULL : &mGatheredIndices[0];
+        IS gathered_from;
+        IS gathered_to;
+#if (PETSC_VERSION_MAJOR == 3 && PETSC_VERSION_MINOR >= 2) //PETSc 3.2 or later
+        ISCreateGeneral(PETSC_COMM_SELF, num_gathered, p_gathered_indices, PETSC_COPY_VALUES, &gathered_from);
+#else
+        ISCreateGeneral(PETSC_COMM_SELF, num_gathered, p_gathered_indices, &gathered_from);
+#endif
+        ISCreateStride(PETSC_COMM_SELF, num_gathered, 0, 1, &gathered_to);
+        VecCreateSeq(PETSC_COMM_SELF, num_gathered, &mGatheredZ);
+
+        // Needed by VecScatterCreate in order to find out the parallel layout of z
+        Vec template_vec = mpMesh->GetDistributedVectorFactory()->CreateVec(PROBLEM_DIM);
+        VecScatterCreate(template_vec, gathered_from, mGatheredZ, gathered_to, &mGatherScatter);
+        PetscTools::Destroy(template_vec);
+        ISDestroy(PETSC_DESTROY_PARAM(gathered_from));
+        ISDestroy(PETSC_DESTROY_PARAM(gathered_to));
+
+        mIsSetUp = true;
+    }
+
+    /**
+     * Compute b = M z (or add M z to b).  Contributions are added with ADD_VALUES, so b
+     * must be finalised (e.g. with LinearSystem::FinaliseRhsVector()) before it is used.
+     * This is collective, as z is scattered.
+     *
+     * @param z the vector to multiply
+     * @param b the result
+     * @param zeroOutput whether to zero b first (defaults to true)
+     */
+    void Apply(Vec z, Vec b, bool zeroOutput=true)
+    {
+        if (!mIsSetUp)
+        {
+            SetUp();
+        }
+        if (zeroOutput)
+        {
+            PetscVecTools::Zero(b);
+        }
+
+        // Fetch the owned and halo entries of z used by the local elements
+#if ((PETSC_VERSION_MAJOR == 3) || (PETSC_VERSION_MAJOR == 2 && PETSC_VERSION_MINOR == 3 && PETSC_VERSION_SUBMINOR == 3)) //2.3.3 or 3.x.x
+        VecScatterBegin(mGatherScatter, z, mGatheredZ, INSERT_VALUES, SCATTER_FORWARD);
+        VecScatterEnd(mGatherScatter, z, mGatheredZ, INSERT_VALUES, SCATTER_FORWARD);
+#else
+        VecScatterBegin(z, mGatheredZ, INSERT_VALUES, SCATTER_FORWARD, mGatherScatter);
+        VecScatterEnd(z, mGatheredZ, INSERT_VALUES, SCATTER_FORWARD, mGatherScatter);
+#endif
+        double* p_gathered_z;
+        VecGetArray(mGatheredZ, &p_gathered_z);
+
+        const unsigned num_elements = mElementWeights.size();
+        const double lumped_factor = ELEMENT_DIM+2;
+
+        double z_elem[BATCH_SIZE*NUM_NODES];
+        double b_elem[BATCH_SIZE*NUM_NODES];
+        PetscInt indices[BATCH_SIZE*NUM_NODES];
+
+        for (unsigned start=0; start<num_elements; start+=BATCH_SIZE)
+        {
+            const unsigned batch_size = std::min(BATCH_SIZE, num_elements-start);
+            const unsigned* p_local = &mElementLocalIndices[start*NUM_NODES];
+            const double* p_weights = &mElementWeights[start];
+
+            // Gather
+            for (unsigned k=0; k<batch_size*NUM_NODES; k++)
+            {
+                indices[k] = mGatheredIndices[p_local[k]];
+                z_elem[k] = p_gathered_z[p_local[k]];
+            }
+
+            // Element kernel
+            if (mUseMassLumping)
+            {
+                for (unsigned e=0; e<batch_size; e++)
+                {
+                    const double weight = lumped_factor*p_weights[e];
+                    for (unsigned i=0; i<NUM_NODES; i++)
+                    {
+                        b_elem[e*NUM_NODES+i] = weight*z_elem[e*NUM_NODES+i];
+                    }
+                }
+            }
+            else
+            {
+                for (unsigned e=0; e<batch_size; e++)
+                {
+                    double sum = 0.0;
+                    for (unsigned i=0; i<NUM_NODES; i++)
+                    {
+                        sum += z_elem[e*NUM_NODES+i];
+                    }
+                    for (unsigned i=0; i<NUM_NODES; i++)
+                    {
+                        b_elem[e*NUM_NODES+i] = p_weights[e]*(z_elem[e*NUM_NODES+i] + sum);
+                    }
+                }
+            }
+
+            // Scatter
+            VecSetValues(b, batch_size*NUM_NODES, indices, b_elem, ADD_VALUES);
+        }
+
+        VecRestoreArray(mGatheredZ, &p_gathered_z);
+    }
+
+    /**
+     * @return the memory used by the operator's element data and gathered vector in bytes
+     * (PETSc's internal storage for the scatter is not included)
+     */
+    std::size_t GetMemoryUsage() const
+    {
+        return sizeof(*this)
+               + mElementLocalIndices.capacity()*sizeof(unsigned)
+               + mElementWeights.capacity()*sizeof(double)
+               + mGatheredIndices.capacity()*sizeof(PetscInt)
+               + mGatheredIndices.size()*sizeof(double);
+    }
+};
+
+template<unsigned ELEMENT_DIM, unsigned SPACE_DIM, unsigned PROBLEM_DIM>
+const unsigned MatrixFreeMassMatrixOperator<ELEMENT_DIM, SPACE_DIM, PROBLEM_DIM>::NUM_NODES;
+
+template<unsigned ELEMENT_DIM, unsigned SPACE_DIM, unsigned PROBLEM_DIM>
+const unsigned MatrixFreeMassMatrixOperator<ELEMENT_DIM, SPACE_DIM, PROBLEM_DIM>::BATCH_SIZE;
+
+#endif // MATRIXFREEMASSMATRIXOPERATOR_HPP_
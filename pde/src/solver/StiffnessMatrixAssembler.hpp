@@ -49,6 +49,17 @@ template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
 class StiffnessMatrixAssembler
     : public AbstractFeVolumeIntegralAssembler<ELEMENT_DIM, SPACE_DIM, 1, false /*no vectors*/, true/*assembles matrices*/, NORMAL>
 {
+protected:
+
+    /**
+     * @return true, since ComputeMatrixTerm() uses no member variables, so elements
+     * may be assembled concurrently.
+     */
+    bool CanAssembleElementsConcurrently()
+    {
+        return true;
+    }
+
 public:
 
     /**
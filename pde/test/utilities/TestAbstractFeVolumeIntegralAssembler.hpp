@@ -39,10 +39,12 @@ OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "AbstractFeVolumeIntegralAssembler.hpp"
 #include "TetrahedralMesh.hpp"
 #include "MassMatrixAssembler.hpp"
+#include "MatrixFreeMassMatrixOperator.hpp"
 #include "StiffnessMatrixAssembler.hpp"
 #include "TrianglesMeshReader.hpp"
 #include "PetscSetupAndFinalize.hpp"
 #include "PetscMatTools.hpp"
+#include "PetscVecTools.hpp"
 
 
 // Note: PROBLEM_DIM>1 is not tested here, so only in coupled PDE solves
@@ -507,6 +509,123 @@ public:
         PetscTools::Destroy(mat);
     }
 
+    void TestMatrixFreeMassMatrixOperator() throw(Exception)
+    {
+        TetrahedralMesh<3,3> mesh;
+        mesh.ConstructRegularSlabMesh(0.25, 1.0, 0.5, 0.75);
+        unsigned num_nodes = mesh.GetNumNodes();
+
+        // z_i = 1 + x_i + 2 y_i z_i, so that the product is not a multiple of the row sums
+        Vec z = mesh.GetDistributedVectorFactory()->CreateVec();
+        Vec b_assembled = mesh.GetDistributedVectorFactory()->CreateVec();
+        Vec b_matrix_free = mesh.GetDistributedVectorFactory()->CreateVec();
+        for (unsigned i=mesh.GetDistributedVectorFactory()->GetLow(); i<mesh.GetDistributedVectorFactory()->GetHigh(); i++)
+        {
+            const c_vector<double, 3>& r_location = mesh.GetNode(i)->rGetLocation();
+            PetscVecTools::SetElement(z, i, 1.0 + r_location[0] + 2.0*r_location[1]*r_location[2]);
+        }
+        PetscVecTools::Finalise(z);
+
+        double scale_factor = 1.7;
+        for (unsigned lumped=0; lumped<2; lumped++)
+        {
+            Mat mat;
+            PetscTools::SetupMat(mat, num_nodes, num_nodes, mesh.CalculateMaximumNodeConnectivityPerProcess());
+            MassMatrixAssembler<3,3> assembler(&mesh, (lumped==1), scale_factor);
+            assembler.SetMatrixToAssemble(mat);
+            assembler.Assemble();
+            PetscMatTools::Finalise(mat);
+            MatMult(mat, z, b_assembled);
+
+            MatrixFreeMassMatrixOperator<3,3> mass_operator(&mesh, (lumped==1), scale_factor);
+            mass_operator.Apply(z, b_matrix_free);
+            PetscVecTools::Finalise(b_matrix_free);
+            TS_ASSERT_LESS_THAN(0u, mass_operator.GetMemoryUsage());
+
+            for (unsigned i=mesh.GetDistributedVectorFactory()->GetLow(); i<mesh.GetDistributedVectorFactory()->GetHigh(); i++)
+            {
+                TS_ASSERT_DELTA(PetscVecTools::GetElement(b_matrix_free, i), PetscVecTools::GetElement(b_assembled, i), 1e-12);
+            }
+
+            // Adding to a vector rather than overwriting it
+            mass_operator.Apply(z, b_matrix_free, false);
+            PetscVecTools::Finalise(b_matrix_free);
+            for (unsigned i=mesh.GetDistributedVectorFactory()->GetLow(); i<mesh.GetDistributedVectorFactory()->GetHigh(); i++)
+            {
+                TS_ASSERT_DELTA(PetscVecTools::GetElement(b_matrix_free, i), 2.0*PetscVecTools::GetElement(b_assembled, i), 1e-12);
+            }
+
+            PetscTools::Destroy(mat);
+        }
+
+        PetscTools::Destroy(z);
+        PetscTools::Destroy(b_assembled);
+        PetscTools::Destroy(b_matrix_free);
+    }
+
+    void TestAssemblyWithExactPreallocation() throw(Exception)
+    {
+        TetrahedralMesh<3,3> mesh;
+        mesh.ConstructRegularSlabMesh(0.1, 1.0, 0.5, 0.6);
+        unsigned num_nodes = mesh.GetNumNodes();
+
+        std::vector<PetscInt> diagonal_nonzeros;
+        std::vector<PetscInt> off_diagonal_nonzeros;
+        mesh.CalculateLocalRowNonZeroCounts(1, diagonal_nonzeros, off_diagonal_nonzeros);
+
+        Mat mat;
+        PetscTools::SetupMat(mat, num_nodes, num_nodes, diagonal_nonzeros, off_diagonal_nonzeros);
+
+        StiffnessMatrixAssembler<3,3> assembler(&mesh);
+        assembler.SetMatrixToAssemble(mat);
+        assembler.Assemble();
+        PetscMatTools::Finalise(mat);
+
+        // Allocation is exact: no mallocs during assembly, and no unused entries
+        MatInfo info;
+        MatGetInfo(mat, MAT_LOCAL, &info);
+        TS_ASSERT_EQUALS(info.mallocs, 0.0);
+        TS_ASSERT_EQUALS(info.nz_allocated, info.nz_used);
+
+        // The uniform preallocation over-allocates most rows
+        unsigned max_connectivity = mesh.CalculateMaximumNodeConnectivityPerProcess();
+        TS_ASSERT_LESS_THAN(info.nz_allocated, (double)(max_connectivity*diagonal_nonzeros.size()));
+
+        PetscTools::Destroy(mat);
+    }
+
+    void TestAssemblyWithThreads() throw(Exception)
+    {
+        TetrahedralMesh<3,3> mesh;
+        mesh.ConstructRegularSlabMesh(0.1, 1.0, 0.5, 0.6);
+        unsigned num_nodes = mesh.GetNumNodes();
+
+        StiffnessMatrixAssembler<3,3> assembler(&mesh);
+        TS_ASSERT_EQUALS(assembler.GetNumberOfAssemblyThreads(), 1u);
+        TS_ASSERT_THROWS_THIS(assembler.SetNumberOfAssemblyThreads(0u),
+                              "The number of assembly threads must be at least 1.");
+
+        // Contributions are added in element order, so the matrices should be identical (up to round-off)
+        Mat serial_mat;
+        PetscTools::SetupMat(serial_mat, num_nodes, num_nodes, mesh.CalculateMaximumNodeConnectivityPerProcess());
+        assembler.SetMatrixToAssemble(serial_mat);
+        assembler.Assemble();
+        PetscMatTools::Finalise(serial_mat);
+
+        Mat threaded_mat;
+        PetscTools::SetupMat(threaded_mat, num_nodes, num_nodes, mesh.CalculateMaximumNodeConnectivityPerProcess());
+        assembler.SetNumberOfAssemblyThreads(3u);
+        TS_ASSERT_EQUALS(assembler.GetNumberOfAssemblyThreads(), 3u);
+        assembler.SetMatrixToAssemble(threaded_mat);
+        assembler.Assemble();
+        PetscMatTools::Finalise(threaded_mat);
+
+        TS_ASSERT(PetscMatTools::CheckEquality(serial_mat, threaded_mat, 1e-14));
+
+        PetscTools::Destroy(serial_mat);
+        PetscTools::Destroy(threaded_mat);
+    }
+
     void TestStiffnessMatrixAssembler1d() throw(Exception)
     {
         TetrahedralMesh<1,1> mesh;
@@ -255,6 +255,49 @@ public:
 #endif //CHASTE_VTK
     }
 
+    void TestMonodomainVtkConversionOneFilePerTimeStep() throw(Exception)
+    {
+#ifdef CHASTE_VTK // Requires  "sudo aptitude install libvtk5-dev" or similar
+        std::string working_directory = "TestHdf5ToVtkConverter_one_file_per_step";
+
+        CopyToTestOutputDirectory("pde/test/data/2D_0_to_1mm_400_elements.h5",
+                                  working_directory);
+
+        TrianglesMeshReader<2,2> mesh_reader("mesh/test/data/2D_0_to_1mm_400_elements");
+        TetrahedralMesh<2,2> mesh;
+        mesh.ConstructFromMeshReader(mesh_reader);
+
+        // Convert, writing one file per time step
+        Hdf5ToVtkConverter<2,2> converter(FileFinder(working_directory, RelativeTo::ChasteTestOutput),
+                                          "2D_0_to_1mm_400_elements", &mesh, false, false, true);
+
+        // VTK is not thread-safe, see above
+        PetscTools::Barrier();
+
+        FileFinder vtk_dir(working_directory + "/vtk_output", RelativeTo::ChasteTestOutput);
+        TS_ASSERT(FileFinder("2D_0_to_1mm_400_elements.pvd", vtk_dir).Exists());
+        TS_ASSERT(FileFinder("2D_0_to_1mm_400_elements_000000.vtu", vtk_dir).Exists());
+        TS_ASSERT(FileFinder("2D_0_to_1mm_400_elements_000020.vtu", vtk_dir).Exists());
+
+        // The all-time-steps file is not written in this mode
+        TS_ASSERT(!FileFinder("2D_0_to_1mm_400_elements.vtu", vtk_dir).Exists());
+
+        // Each file holds one time step, so the point data is not suffixed with the step number
+        VtkMeshReader<2,2> vtk_mesh_reader(vtk_dir.GetAbsolutePath() + "2D_0_to_1mm_400_elements_000020.vtu");
+        TS_ASSERT_EQUALS(vtk_mesh_reader.GetNumNodes(), 221u);
+        TS_ASSERT_EQUALS(vtk_mesh_reader.GetNumElements(), 400u);
+
+        std::vector<double> v_at_last;
+        vtk_mesh_reader.GetPointData("V", v_at_last);
+        TS_ASSERT_DELTA(v_at_last[0],   -83.8534, 1e-3);
+        TS_ASSERT_DELTA(v_at_last[110], -83.8534, 1e-3);
+        TS_ASSERT_DELTA(v_at_last[220], -83.8530, 1e-3);
+#else
+        std::cout << "This test was not run, as VTK is not enabled." << std::endl;
+        std::cout << "If required please install and alter your hostconfig settings to switch on chaste VTK support." << std::endl;
+#endif //CHASTE_VTK
+    }
+
     /**
      * This tests the HDF5 to .txt converter using a 3D example
      * taken from a bidomain simulation.
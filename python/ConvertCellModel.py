@@ -107,6 +107,10 @@ parser.add_option('--grl1', action='store_true', default=False,
 parser.add_option('--grl2', action='store_true', default=False,
                   help="generate a version of the cell model that can be"
                   " solved using the GRL2 method.")           
+parser.add_option('--batched', action='store_true', default=False,
+                  help="add batch kernels (EvaluateYDerivativesBatch and GetIIonicBatch) to the"
+                  " --normal and --opt versions of the cell model, for use with"
+                  " CardiacCellBatch")
 parser.add_option('--output-dir', action='store',
                   help="directory to place output files in")
 parser.add_option('--show-outputs', action='store_true', default=False,
@@ -312,15 +316,19 @@ def convert(model, output_dir):
         output_dir = model_dir
 
     command_base = [os.path.join(pycml_dir, 'translate.py'), model] + pycml_options
+    if options.batched:
+        batched_options = ['--batched']
+    else:
+        batched_options = []
 
     if options.normal:
         # Basic class
-        cmd, outputs = add_out_opts(command_base, output_dir, class_name, model_base)
+        cmd, outputs = add_out_opts(command_base + batched_options, output_dir, class_name, model_base)
         do_cmd(cmd, outputs)
 
     if options.opt and (options.normal or number_of_options == 1):
         # Normal with optimisation
-        cmd, outputs = add_out_opts(command_base + ['-p', '-l'], output_dir,
+        cmd, outputs = add_out_opts(command_base + batched_options + ['-p', '-l'], output_dir,
                                     class_name + 'Opt', model_base, 'Opt')
         do_cmd(cmd, outputs)
     
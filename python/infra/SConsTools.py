@@ -787,7 +787,7 @@ def CreatePyCmlBuilder(build, buildenv):
             # the -y flag.
             args.append('-y')
         else:
-            args.extend(['--normal', '--opt', '--cvode'])
+            args.extend(['--normal', '--opt', '--cvode', '--batched'])
 # Won't work until SCons' C scanner can understand #ifdef
 #            if 'CHASTE_CVODE' not in env['CPPDEFINES']:
 #                args.remove('--cvode')
@@ -1164,14 +1164,21 @@ class CellMLTranslator(object):
     def output_lut_row_lookup_methods(self):
         """Write methods that return a whole row of a lookup table.
 
+        When the tables live in a separate (singleton) class, the row is written into
+        memory supplied by the caller, so that cells may be solved concurrently.
+
         Note: assumes that table names are numbered sequentially from 0.
         """
         self.output_comment('Row lookup methods')
         self.output_comment('using ', self.config.options.lookup_type)
         for key, idx in self.doc.lookup_table_indexes.iteritems():
             num_tables = unicode(self.doc.lookup_tables_num_per_index[idx])
+            if getattr(self, 'separate_lut_class', False):
+                row_memory = ', double* const _lookup_table_%s_row' % idx
+            else:
+                row_memory = ''
             self.writeln('double* _lookup_', idx, '_row(unsigned i',
-                         self.lut_factor('', include_type=True, include_comma=True), ')')
+                         self.lut_factor('', include_type=True, include_comma=True), row_memory, ')')
             self.open_block()
             self.writeln('for (unsigned j=0; j<', num_tables, '; j++)')
             self.open_block()
@@ -1280,8 +1287,12 @@ class CellMLTranslator(object):
         self.writeln()
         return nodes_used
         
-    def output_table_index_checking(self, key, idx):
-        """Check whether a table index is out of bounds."""
+    def output_table_index_checking(self, key, idx, record_out_of_range=False):
+        """Check whether a table index is out of bounds.
+        
+        If record_out_of_range is set, out of bounds keys are also counted in the
+        lookup table collection's statistics.
+        """
         if self.config.options.check_lt_bounds:
             var = key[-1]
             min, max, _, _ = self.lut_parameters(key)
@@ -1290,6 +1301,8 @@ class CellMLTranslator(object):
             self.writeln('if (', varname, '>', max, ' || ', varname, '<', min, ')')
             self.open_block()
             self.writeln('// LCOV_EXCL_START', indent=False)
+            if record_out_of_range:
+                self.writeln('RecordOutOfRange(', idx, ');')
             if self.constrain_table_indices:
                 self.writeln('if (', varname, '>', max, ') ', varname, self.EQ_ASSIGN, max, self.STMT_END)
                 self.writeln('else ', varname, self.EQ_ASSIGN, min, self.STMT_END)
@@ -1326,8 +1339,12 @@ class CellMLTranslator(object):
             if factor:
                 self.writeln(factor_type, factor, ' = ', offset_over_step, ' - ', idx_var, self.STMT_END)
         if self.row_lookup_method:
+            if getattr(self, 'separate_lut_class', False):
+                row_memory = ', _lt_%s_row_memory' % idx
+            else:
+                row_memory = ''
             self.writeln(row_type, '_lt_', idx, '_row = ', self.lookup_method_prefix, '_lookup_', idx,
-                         '_row(', idx_var, self.lut_factor(idx, include_comma=True), ');')
+                         '_row(', idx_var, self.lut_factor(idx, include_comma=True), row_memory, ');')
 
 class CellMLToChasteTranslator(CellMLTranslator):
     """
@@ -1367,6 +1384,8 @@ class CellMLToChasteTranslator(CellMLTranslator):
         # Some other default settings
         self.use_backward_euler = False
         self.include_serialization = False
+        # Variables with a single value for a whole block of cells (see output_batch_kernels)
+        self.batch_scalars = None
         # Last method's access specification
         self._last_method_access = 'private'
         return super(CellMLToChasteTranslator, self).translate(*args, **kwargs)
@@ -1700,7 +1719,18 @@ class CellMLToChasteTranslator(CellMLTranslator):
         Return the full name of var in a form suitable for inclusion in a source file.
         
         Overrides the base class version to access mParameters for parameters.
-        """
+        
+        Within the batch kernels (see output_batch_kernels) it instead returns the element for
+        the current cell of the array holding var, unless var is the same for the whole block.
+        """
+        if self.batch_scalars is not None:
+            if var is getattr(self.model, u'_cml_Chaste_Cm', None):
+                return '_capacitance'
+            name = super(CellMLToChasteTranslator, self).code_name(var, *args, **kwargs)
+            ode = kwargs.get('ode', args and args[0])
+            if not ode and (var in self.batch_scalars or var.get_type() == VarTypes.Free):
+                return name
+            return name + '[_c]'
         if hasattr(var, '_cml_param_index') and not (self.use_modifiers and getattr(var, '_cml_has_modifier', False)):
             return self.vector_index('mParameters', var._cml_param_index)
         elif var is getattr(self.model, u'_cml_Chaste_Cm', None):
@@ -1863,6 +1893,9 @@ class CellMLToChasteTranslator(CellMLTranslator):
                          self.var_display_name(self.v_variable), '");')
         if self.config.options.include_dt_in_tables:
             self.writeln(self.lt_class_name, '::Instance()->SetTimestep(mDt);')
+        elif self.use_lookup_tables and self.separate_lut_class:
+            self.output_comment('Create the tables now, not on first use, which may be on several cell solve threads at once')
+            self.writeln(self.lt_class_name, '::Instance();')
         self.writeln('Init();\n')
         
         #1861 - Rush-Larsen
@@ -2138,13 +2171,14 @@ class CellMLToChasteTranslator(CellMLTranslator):
             void IndexTable0(double index_var, unsigned& index, double& factor);
         otherwise, with
             bool CheckIndex0(double& index_var);
-        for checking the bounds.
+        for checking the bounds.  Each call to an indexing method is counted in the table
+        usage statistics (see AbstractLookupTableCollection::GetTableStatistics).
         """
         for key, idx in self.doc.lookup_table_indexes.iteritems():
             varname = self.code_name(key[-1])
             method_name = 'IndexTable' + str(idx)
             if self.row_lookup_method:
-                method = 'const double * %s(double %s)' % (method_name, varname)
+                method = 'const double * %s(double %s, double* const _lt_%s_row_memory)' % (method_name, varname, idx)
             else:
                 factor = self.lut_factor(idx)
                 idx_var = '_table_index_' + str(idx)
@@ -2153,6 +2187,7 @@ class CellMLToChasteTranslator(CellMLTranslator):
                 method = 'void %s(double %s, unsigned& %s%s)' % (method_name, varname, idx_var, factor)
             self.writeln(method)
             self.open_block()
+            self.writeln('RecordScalarLookup(', idx, ');')
             self.output_table_index_generation_code(key, idx, call_method=False)
             if self.row_lookup_method:
                 self.writeln('return _lt_', idx, '_row;')
@@ -2162,12 +2197,100 @@ class CellMLToChasteTranslator(CellMLTranslator):
                 self.writeln('// LCOV_EXCL_START', indent=False)
                 self.writeln('bool CheckIndex', idx, '(double& ', varname, ')')
                 self.open_block()
-                self.output_table_index_checking(key, idx, call_method=False)
+                self.output_table_index_checking(key, idx, call_method=False, record_out_of_range=True)
                 self.writeln('return _oob_', idx, self.STMT_END)
                 self.close_block(blank_line=False)
                 self.writeln('// LCOV_EXCL_STOP\n', indent=False)
-    
-    def output_table_index_checking(self, key, idx, call_method=True):
+
+    def output_lut_batch_methods(self):
+        """Output methods in the LT class for looking up table values for a batch of keys.
+        
+        For each table index there is a method like
+            void IndexTable0Batch(const double* pKeys, unsigned numKeys, double* pRows);
+        which checks all the keys against the table bounds, then fills pRows with the values of
+        each table in turn for all the keys, in a loop over the keys marked for SIMD vectorisation.
+        There is also an override of AbstractLookupTableCollection::IndexTablesBatch dispatching to these.
+        Requires self.row_lookup_method.
+        """
+        for key, idx in self.doc.lookup_table_indexes.iteritems():
+            varname = self.code_name(key[-1])
+            min, max, _, step_inverse = self.lut_parameters(key)
+            num_tables = unicode(self.doc.lookup_tables_num_per_index[idx])
+            self.writeln('void IndexTable', idx, 'Batch(const double* pKeys, unsigned numKeys, double* pRows)')
+            self.open_block()
+            if self.config.options.check_lt_bounds:
+                self.writeln('for (unsigned k=0; k<numKeys; k++)')
+                self.open_block()
+                self.writeln(self.TYPE_DOUBLE, varname, ' = pKeys[k];')
+                self.writeln('// LCOV_EXCL_START', indent=False)
+                self.writeln('if (CheckIndex', idx, '(', varname, '))')
+                self.open_block()
+                self.writeln('EXCEPTION("', self.var_display_name(key[-1]),
+                             ' outside lookup table range at entry " << k << " of batch: " << pKeys[k]);')
+                self.close_block(blank_line=False)
+                self.writeln('// LCOV_EXCL_STOP', indent=False)
+                self.close_block(blank_line=False)
+            self.writeln('const double table_min = ', min, self.STMT_END)
+            if self.constrain_table_indices:
+                self.writeln('const double table_max = ', max, self.STMT_END)
+            self.writeln('const double table_step_inverse = ', step_inverse, self.STMT_END)
+            self.writeln('const double* const p_table = _lookup_table_', idx, '[0];')
+            self.writeln('for (unsigned j=0; j<', num_tables, '; j++)')
+            self.open_block()
+            self.writeln('double* const p_values = pRows + j*numKeys;')
+            self.writeln('#ifdef CHASTE_OPENMP', indent=False)
+            self.writeln('#pragma omp simd', indent=False)
+            self.writeln('#endif // CHASTE_OPENMP', indent=False)
+            self.writeln('for (unsigned k=0; k<numKeys; k++)')
+            self.open_block()
+            if self.constrain_table_indices:
+                self.writeln('const double key = pKeys[k] > table_max ? table_max : (pKeys[k] < table_min ? table_min : pKeys[k]);')
+            else:
+                self.writeln('const double key = pKeys[k];')
+            self.writeln('const double offset_over_step = (key - table_min) * table_step_inverse;')
+            # A signed index converts to and from double in SIMD registers more readily
+            if self.config.options.lookup_type == 'nearest-neighbour':
+                if self.lt_index_uses_floor:
+                    self.writeln('const int i = (int) round(offset_over_step);')
+                else:
+                    self.writeln('const int i = (int) (offset_over_step+0.5);')
+                self.writeln('p_values[k] = p_table[i*', num_tables, ' + j];')
+            else:
+                if self.lt_index_uses_floor:
+                    self.writeln('const int i = (int) floor(offset_over_step);')
+                else:
+                    self.writeln('const int i = (int)(offset_over_step);')
+                self.writeln('const double factor = offset_over_step - i;')
+                self.writeln('const double y1 = p_table[i*', num_tables, ' + j];')
+                self.writeln('const double y2 = p_table[(i+1)*', num_tables, ' + j];')
+                self.writeln('p_values[k] = y1 + (y2-y1)*factor;')
+            self.close_block(blank_line=False)
+            self.close_block(blank_line=False)
+            self.writeln('RecordBatchedLookups(', idx, ', numKeys);')
+            self.close_block()
+        self.writeln('void IndexTablesBatch(unsigned keyingVariableIndex, const double* pKeys, unsigned numKeys, double* pRows)')
+        self.open_block()
+        self.writeln('switch (keyingVariableIndex)')
+        self.open_block()
+        for idx in sorted(self.doc.lookup_table_indexes.itervalues()):
+            self.writeln('case ', idx, ':')
+            self.writeln('IndexTable', idx, 'Batch(pKeys, numKeys, pRows);', indent_offset=1)
+            self.writeln('break;', indent_offset=1)
+        self.writeln('default:')
+        self.writeln('EXCEPTION("Lookup table keying variable index " << keyingVariableIndex << " does not exist.");',
+                     indent_offset=1)
+        self.close_block(blank_line=False)
+        self.close_block()
+
+    def output_table_lookup(self, expr, paren):
+        """Override base class method to read from the values looked up for a tile of cells in the batch kernels."""
+        if self.batch_scalars is not None:
+            i = expr.table_index
+            self.write('_lt_', i, '_rows[', expr.table_name, '*_n + _c]')
+        else:
+            super(CellMLToChasteTranslator, self).output_table_lookup(expr, paren)
+
+    def output_table_index_checking(self, key, idx, call_method=True, record_out_of_range=False):
         """Override base class method to call the methods on the lookup table class if needed."""
         if self.separate_lut_class and call_method:
             if self.config.options.check_lt_bounds:
@@ -2176,7 +2299,7 @@ class CellMLToChasteTranslator(CellMLTranslator):
                 self.writeln('const bool _oob_', idx, self.EQ_ASSIGN, self.lt_class_name,
                              '::Instance()->CheckIndex', idx, '(', varname, ')', self.STMT_END)
         else:
-            super(CellMLToChasteTranslator, self).output_table_index_checking(key, idx)
+            super(CellMLToChasteTranslator, self).output_table_index_checking(key, idx, record_out_of_range)
     
     def output_table_index_generation_code(self, key, idx, call_method=True):
         """Override base class method to call the methods on the lookup table class if needed."""
@@ -2185,7 +2308,10 @@ class CellMLToChasteTranslator(CellMLTranslator):
             varname = self.code_name(var)
             method_name = self.lt_class_name + '::Instance()->IndexTable' + str(idx)
             if self.row_lookup_method:
-                self.writeln('const double* const _lt_', idx, '_row = ', method_name, '(', varname, ');')
+                num_tables = unicode(self.doc.lookup_tables_num_per_index[idx])
+                self.writeln('double _lt_', idx, '_row_memory[', num_tables, '];')
+                self.writeln('const double* const _lt_', idx, '_row = ', method_name, '(', varname,
+                             ', _lt_', idx, '_row_memory);')
             else:
                 factor = self.lut_factor(idx, include_comma=True)
                 idx_var = '_table_index_' + str(idx)
@@ -2220,6 +2346,8 @@ class CellMLToChasteTranslator(CellMLTranslator):
         # Table lookup methods
         self.output_lut_methods()
         self.output_lut_indexing_methods()
+        if self.row_lookup_method:
+            self.output_lut_batch_methods()
         # Destructor
         self.writeln('~', self.lt_class_name, '()')
         self.open_block()
@@ -2233,6 +2361,7 @@ class CellMLToChasteTranslator(CellMLTranslator):
         self.writeln(self.lt_class_name, '()')
         self.open_block()
         self.writeln('assert(mpInstance.get() == NULL);')
+        self.writeln('mCollectionName = "', self.lt_class_name, '";')
         if self.config.options.include_dt_in_tables:
             self.writeln('mDt = HeartConfig::Instance()->GetOdeTimeStep();')
             self.writeln('assert(mDt > 0.0);')
@@ -2255,6 +2384,7 @@ class CellMLToChasteTranslator(CellMLTranslator):
             self.writeln('mTableMaxs[', idx, '] = ', max, self.STMT_END)
             self.writeln('mNeedsRegeneration[', idx, '] = true;')
             self.writeln('_lookup_table_', idx, self.EQ_ASSIGN, 'NULL', self.STMT_END)
+        self.writeln('ResetTableStatistics();')
         self.writeln(self.lt_class_name, '::RegenerateTables();')
         self.close_block()
         # Table (re-)generation
@@ -2280,8 +2410,6 @@ class CellMLToChasteTranslator(CellMLTranslator):
         self.writeln('private:', indent_level=0)
         self.writeln('/** The single instance of the class */')
         self.writeln('static std::auto_ptr<', self.lt_class_name, '> mpInstance;\n')
-        if self.row_lookup_method:
-            self.output_lut_row_lookup_memory()
         self.output_lut_declarations()
         # Close the class
         self.set_indent(0)
@@ -2524,6 +2652,10 @@ class CellMLToChasteTranslator(CellMLTranslator):
         For other solvers, only 2 methods are needed:
          * EvaluateYDerivatives computes the RHS of the ODE system
          * GetIIonic is as above
+        If the --batched option is given, we also generate (where possible)
+         * EvaluateYDerivativesBatch  computes the RHS for a block of cells held in
+           structure-of-arrays layout (see CardiacCellBatch)
+         * GetIIonicBatch  computes the ionic currents of such a block
         
         Where derived-quantity annotations are present, we also generate a
         ComputeDerivedQuantities method.
@@ -2539,6 +2671,8 @@ class CellMLToChasteTranslator(CellMLTranslator):
             self.output_grl2_mathematics()
         else:
             self.output_evaluate_y_derivatives()
+            if self.options.batched and self.can_output_batch_kernels():
+                self.output_batch_kernels()
         self.output_derived_quantities()
     
     def calculate_lookup_table_indices(self, nodeset, time_name=None):
@@ -2623,6 +2757,293 @@ class CellMLToChasteTranslator(CellMLTranslator):
             self.writeln(self.vector_index('rDY', i), self.EQ_ASSIGN, self.code_name(var, True), self.STMT_END)
         self.close_block()
         
+    # Number of cells processed by each loop of the batch kernels (see output_batch_kernels)
+    BATCH_TILE_SIZE = 64
+
+    def can_output_batch_kernels(self):
+        """Whether the batch kernels (see output_batch_kernels) can be generated for this model.
+        
+        They cannot apply per-cell modifiers, protocol bounds or data clamps, and need lookup
+        tables that can be indexed for many keys at once without altering the keys.
+        """
+        if (not self.state_vars or self.use_modifiers or self.options.protocol or self.use_data_clamp
+                or getattr(self.model, '_cml_interp_exprs', [])):
+            return False
+        if self.use_lookup_tables:
+            return self.separate_lut_class and self.row_lookup_method and not self.constrain_table_indices
+        return True
+
+    def output_batch_kernels(self):
+        """Output the HasBatchKernels, EvaluateYDerivativesBatch and GetIIonicBatch methods.
+        
+        The kernels work on a block of cells of this model whose state variables are held in
+        structure-of-arrays layout by a CardiacCellBatch, so that entry i*num_cells+c is state
+        variable i of cell c.  The block is processed in tiles of BATCH_TILE_SIZE cells.  Within
+        a tile each equation becomes its own loop over the cells, marked with '#pragma omp simd',
+        reading and writing contiguous arrays: the rows of the block's state and derivatives for
+        state variables, and arrays on the stack for everything else.  Lookup tables are
+        interpolated for the whole tile at once (see IndexTable<N>Batch in the lookup table
+        class) before the equations that use them.
+        
+        Equations which only involve quantities that are the same for every cell (the time,
+        constants, the capacitance) are evaluated once per tile as in EvaluateYDerivatives.
+        Parameters and the stimulus current are gathered from the cells into arrays.  The
+        voltage is always read from the block's state, and the whole block follows the
+        mSetVoltageDerivativeToZero setting of the cell the kernels are called on.
+        """
+        self.set_access('public')
+        self.writeln_hpp('bool HasBatchKernels() const', self.STMT_END)
+        self.writeln('bool ', self.class_name, '::HasBatchKernels() const')
+        self.open_block()
+        self.writeln('return true;')
+        self.close_block()
+        self.output_evaluate_y_derivatives_batch()
+        if hasattr(self.model, u'solver_info') and hasattr(self.model.solver_info, u'ionic_current'):
+            self.output_get_i_ionic_batch()
+
+    def initial_batch_scalars(self):
+        """Return the set of variables known to be the same for every cell before a batch kernel's equations."""
+        scalars = set()
+        if getattr(self.model, u'_cml_Chaste_Cm', None) is not None:
+            scalars.add(self.model._cml_Chaste_Cm)
+        return scalars
+
+    def output_batch_method_start(self):
+        """Output the code common to the start of both batch kernels, up to the loop over tiles."""
+        self.writeln('const unsigned num_cells = rCells.size();')
+        self.writeln('const unsigned _tile_size = ', self.BATCH_TILE_SIZE, 'u;')
+
+    def output_batch_tile(self, body, derivative_pointers=False):
+        """Output the loop over tiles of cells in a batch kernel.
+        
+        body is the captured code computing the kernel's outputs for one tile.  We precede it by
+        declarations of the pointers into the block's state (and derivatives, if requested) for
+        this tile, and before the loop declare anything else the body needs.
+        """
+        def used(name):
+            return re.search(r'\b' + re.escape(name) + r'\b', body)
+        if used('_capacitance'):
+            self.writeln('const double _capacitance = HeartConfig::Instance()->GetCapacitance();')
+        if self.cell_parameters and used('mParameters'):
+            self.writeln('for (unsigned c=0; c<num_cells; c++)')
+            self.open_block()
+            self.writeln('assert(dynamic_cast<', self.class_name, '*>(rCells[c]) != NULL);')
+            self.close_block(blank_line=False)
+        self.writeln('for (unsigned _tile_start=0; _tile_start<num_cells; _tile_start+=_tile_size)')
+        self.open_block()
+        self.writeln('const unsigned _n = (num_cells - _tile_start < _tile_size) ? num_cells - _tile_start : _tile_size;')
+        for i, var in enumerate(self.state_vars):
+            name = CellMLTranslator.code_name(self, var)
+            if used(name):
+                self.writeln('const double* const ', name, ' = pStateVariables + ', i, '*num_cells + _tile_start;')
+        if derivative_pointers:
+            for i, var in enumerate(self.state_vars):
+                self.writeln('double* const ', CellMLTranslator.code_name(self, var, ode=True),
+                             ' = pDerivatives + ', i, '*num_cells + _tile_start;')
+        self.out.write(body)
+        self.close_block()
+
+    def open_batch_loop(self, simd=True):
+        """Open a loop over the cells of the current tile in a batch kernel."""
+        if simd:
+            self.writeln('#ifdef CHASTE_OPENMP', indent=False)
+            self.writeln('#pragma omp simd', indent=False)
+            self.writeln('#endif // CHASTE_OPENMP', indent=False)
+        self.writeln('for (unsigned _c=0; _c<_n; _c++)')
+        self.open_block()
+
+    def output_batch_table_lookups(self, nodeset):
+        """Look up the values of the tables used by nodeset for the current tile of cells in a batch kernel.
+        
+        As for output_table_index_generation, returns the equations used to calculate any computed keys.
+        """
+        tables_to_index = set()
+        for node in nodeset:
+            tables_to_index.update(self.contained_table_indices(node))
+        nodes_used = set()
+        if tables_to_index:
+            self.output_comment('Lookup table values for the whole tile')
+        for key, idx in sorted(self.doc.lookup_table_indexes.iteritems(), key=lambda item: item[1]):
+            if idx in tables_to_index:
+                var = key[-1]
+                if var.get_type() is VarTypes.Computed:
+                    var_nodes = self.calculate_extended_dependencies([var]) & nodeset
+                    self.output_batch_equations(var_nodes - nodes_used)
+                    nodes_used.update(var_nodes)
+                num_tables = unicode(self.doc.lookup_tables_num_per_index[idx])
+                self.writeln('double _lt_', idx, '_rows[', num_tables, '*_tile_size];')
+                self.writeln(self.lt_class_name, '::Instance()->IndexTable', idx, 'Batch(',
+                             CellMLTranslator.code_name(self, var), ', _n, _lt_', idx, '_rows);')
+        if tables_to_index:
+            self.writeln()
+        return nodes_used
+
+    def output_batch_equations(self, nodeset, zero_stimulus=False):
+        """Output the mathematics described by nodeset within a batch kernel.
+        
+        This is the batch equivalent of output_equations: each assignment becomes a loop over the
+        cells of the current tile writing to an array, unless it only involves quantities in
+        self.batch_scalars, in which case it is computed once and added to them.
+        """
+        i_stim = self.doc._cml_config.i_stim_var
+        special_stimulus = self.use_chaste_stimulus or zero_stimulus
+        for expr in (e for e in self.model.get_assignments() if e in nodeset):
+            if isinstance(expr, cellml_variable):
+                t = expr.get_type()
+                name = CellMLTranslator.code_name(self, expr)
+                if special_stimulus and expr is i_stim:
+                    if zero_stimulus:
+                        self.batch_scalars.add(expr)
+                        self.writeln(self.TYPE_CONST_DOUBLE, name, self.EQ_ASSIGN, '0.0', self.STMT_END)
+                    else:
+                        self.writeln(self.TYPE_DOUBLE, name, '[_tile_size];')
+                        self.output_comment('Not SIMD: each cell has its own stimulus object')
+                        self.open_batch_loop(simd=False)
+                        get_stim = 'rCells[_tile_start + _c]->GetIntracellularAreaStimulus(%s)' % self.code_name(self.free_vars[0])
+                        if self.doc._cml_config.i_stim_negated:
+                            get_stim = '-' + get_stim
+                        self.writeln(name, '[_c]', self.EQ_ASSIGN, get_stim, self.STMT_END)
+                        self.close_block(blank_line=False)
+                elif expr in self.cell_parameters:
+                    self.writeln(self.TYPE_DOUBLE, name, '[_tile_size];')
+                    self.open_batch_loop()
+                    self.writeln(name, '[_c]', self.EQ_ASSIGN, 'static_cast<', self.class_name, '*>(rCells[_tile_start + _c])->',
+                                 'mParameters[', expr._cml_param_index, ']', self.STMT_END)
+                    self.close_block(blank_line=False)
+                elif t == VarTypes.Constant:
+                    self.batch_scalars.add(expr)
+                    super(CellMLToChasteTranslator, self).output_assignment(expr)
+                elif t == VarTypes.Mapped:
+                    source = expr.get_source_variable()
+                    if source in self.batch_scalars or source.get_type() == VarTypes.Free:
+                        self.batch_scalars.add(expr)
+                        super(CellMLToChasteTranslator, self).output_assignment(expr)
+                    else:
+                        self.writeln('const double* const ', name, self.EQ_ASSIGN,
+                                     CellMLTranslator.code_name(self, source), self.STMT_END, nl=False)
+                        self.output_comment(expr.units, indent=False, pad=True)
+            else:
+                lhs = expr.eq.lhs
+                if lhs.localName == 'ci':
+                    assigned_var = lhs.variable
+                    if assigned_var in self.cell_parameters or (special_stimulus and assigned_var is i_stim):
+                        continue
+                    rhs_vars = self._vars_in(expr.eq.rhs)
+                    if all(isinstance(v, cellml_variable) and (v in self.batch_scalars or v.get_type() == VarTypes.Free)
+                           for v in rhs_vars):
+                        self.batch_scalars.add(assigned_var)
+                        super(CellMLToChasteTranslator, self).output_assignment(expr)
+                        continue
+                    self.writeln(self.TYPE_DOUBLE, CellMLTranslator.code_name(self, assigned_var), '[_tile_size];')
+                elif not self.batch_derivative_pointers:
+                    dep_var = lhs.diff.dependent_variable
+                    self.writeln(self.TYPE_DOUBLE, CellMLTranslator.code_name(self, dep_var, ode=True), '[_tile_size];')
+                self.open_batch_loop()
+                self.writeln('', nl=False)
+                self.output_lhs(lhs)
+                self.write(self.EQ_ASSIGN)
+                self.output_expr(expr.eq.rhs, False)
+                self.writeln(self.STMT_END, indent=False, nl=False)
+                self.output_comment(expr._get_element_units(lhs, return_set=False).description(),
+                                   indent=False, pad=True)
+                self.close_block(blank_line=False)
+
+    def output_evaluate_y_derivatives_batch(self):
+        """Output the EvaluateYDerivativesBatch method (see output_batch_kernels)."""
+        time_name = self.code_name(self.free_vars[0])
+        self.output_method_start('EvaluateYDerivativesBatch',
+                                 [self.TYPE_DOUBLE + time_name,
+                                  'const std::vector<AbstractCardiacCell*>& rCells',
+                                  'const double* pStateVariables',
+                                  'double* pDerivatives'],
+                                 'void', access='public')
+        self.open_block()
+        self.output_comment('Time units: ', self.free_vars[0].units)
+        self.output_batch_method_start()
+        # Work out what equations are needed, as for output_derivative_calculations
+        derivs = set(map(lambda v: (v, self.free_vars[0]), self.state_vars))
+        if self.v_variable in self.state_vars:
+            dvdt = (self.v_variable, self.free_vars[0])
+            derivs.remove(dvdt)
+        else:
+            dvdt = None
+        if self.use_chaste_stimulus:
+            i_stim = [self.doc._cml_config.i_stim_var]
+        else:
+            i_stim = []
+        nonv_nodeset = self.calculate_extended_dependencies(derivs, prune_deps=i_stim)
+        if dvdt:
+            v_nodeset = self.calculate_extended_dependencies([dvdt], prune=nonv_nodeset, prune_deps=i_stim)
+        else:
+            v_nodeset = set()
+        # The mathematics for one tile of cells
+        self.batch_scalars = self.initial_batch_scalars()
+        self.batch_derivative_pointers = True
+        self.capture_output()
+        self.set_indent(offset=1)
+        table_index_nodes_used = self.output_batch_table_lookups(nonv_nodeset|v_nodeset)
+        self.output_batch_equations(nonv_nodeset - table_index_nodes_used)
+        if dvdt:
+            self.writeln()
+            self.writeln('if (mSetVoltageDerivativeToZero)')
+            self.open_block()
+            self.open_batch_loop()
+            self.writeln(self.code_name(self.v_variable, ode=True), self.EQ_ASSIGN, '0.0', self.STMT_END)
+            self.close_block(blank_line=False)
+            self.close_block(blank_line=False)
+            self.writeln('else')
+            self.open_block()
+            self.output_batch_equations(v_nodeset - table_index_nodes_used)
+            self.close_block(blank_line=False)
+        self.set_indent(offset=-1)
+        body = self.get_captured_output()
+        self.batch_scalars = None
+        self.output_batch_tile(body, derivative_pointers=True)
+        self.close_block()
+
+    def output_get_i_ionic_batch(self):
+        """Output the GetIIonicBatch method (see output_batch_kernels)."""
+        self.output_method_start('GetIIonicBatch',
+                                 ['const std::vector<AbstractCardiacCell*>& rCells',
+                                  'const double* pStateVariables',
+                                  'double* pIIonic'],
+                                 'void', access='public')
+        self.open_block()
+        self.output_batch_method_start()
+        # The same equations as GetIIonic
+        nodes = map(lambda elt: self.varobj(unicode(elt)), self.model.solver_info.ionic_current.var)
+        nodeset = self.calculate_extended_dependencies(nodes, prune_deps=[self.doc._cml_config.i_stim_var])
+        # The mathematics for one tile of cells
+        self.batch_scalars = self.initial_batch_scalars()
+        self.batch_derivative_pointers = False
+        self.capture_output()
+        self.set_indent(offset=1)
+        table_index_nodes_used = self.output_batch_table_lookups(nodeset)
+        self.output_batch_equations(nodeset - table_index_nodes_used, zero_stimulus=True)
+        self.writeln()
+        self.open_batch_loop()
+        self.writeln('pIIonic[_tile_start + _c]', self.EQ_ASSIGN, nl=False)
+        if self.doc._cml_config.i_ionic_negated:
+            self.write('-(')
+        plus = False
+        for varelt in self.model.solver_info.ionic_current.var:
+            if plus: self.write('+')
+            else: plus = True
+            self.output_variable(varelt)
+        if self.doc._cml_config.i_ionic_negated:
+            self.write(')')
+        self.writeln(self.STMT_END, indent=False)
+        self.close_block(blank_line=False)
+        self.writeln('for (unsigned _c=0; _c<_n; _c++)')
+        self.open_block()
+        self.writeln('EXCEPT_IF_NOT(!std::isnan(pIIonic[_tile_start + _c]));')
+        self.close_block(blank_line=False)
+        self.set_indent(offset=-1)
+        body = self.get_captured_output()
+        self.batch_scalars = None
+        self.output_batch_tile(body)
+        self.close_block()
+
     def output_derivative_calculations(self, state_vars, assign_rY=False, extra_nodes=set(),
                                        extra_table_nodes=set()):
         """
@@ -6566,6 +6987,12 @@ def get_options(args, default_options=None):
     group.add_option('--no-timestamp',
                      action='store_true', default=False,
                      help="don't add a timestamp comment to generated files")
+    group.add_option('--batched',
+                     action='store_true', default=False,
+                     help="also generate EvaluateYDerivativesBatch and GetIIonicBatch methods, which"
+                     " loop over blocks of cells of this model in SIMD-friendly form, so that they can be"
+                     " solved together by a CardiacCellBatch.  Only used for -t Chaste without"
+                     " --backward-euler, --rush-larsen, --grl*, modifiers, protocols or data clamps.")
     parser.add_option_group(group)
     # Options specific to Maple output
     group = optparse.OptionGroup(parser, 'Maple options', "Options specific to Maple code output")